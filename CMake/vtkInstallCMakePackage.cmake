@@ -78,6 +78,7 @@ set(vtk_cmake_module_files
   FindPEGTL.cmake
   FindSDL2.cmake
   FindTBB.cmake
+  FindZSTD.cmake
   FindTHEORA.cmake
   Findutf8cpp.cmake
   FindCGNS.cmake
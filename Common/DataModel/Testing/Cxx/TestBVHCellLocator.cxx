@@ -0,0 +1,292 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestBVHCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test vtkBVHCellLocator against brute force queries, and the batched
+// IntersectWithLines() against IntersectWithLine(), for a built tree and for
+// trees refitted to deformed meshes.
+
+#include "vtkBVHCellLocator.h"
+#include "vtkCellArray.h"
+#include "vtkCommand.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestErrorObserver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+// A triangulated, bumpy sphere with resolution*(2*resolution) quads.
+void MakeSphere(int resolution, vtkPolyData* pd)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> polys;
+  const int numTheta = 2 * resolution;
+  for (int j = 0; j <= resolution; ++j)
+  {
+    double phi = vtkMath::Pi() * j / resolution;
+    for (int i = 0; i < numTheta; ++i)
+    {
+      double theta = 2.0 * vtkMath::Pi() * i / numTheta;
+      double r = 1.0 + 0.1 * std::sin(5.0 * theta) * std::sin(3.0 * phi);
+      points->InsertNextPoint(r * std::sin(phi) * std::cos(theta),
+        r * std::sin(phi) * std::sin(theta), r * std::cos(phi));
+    }
+  }
+  for (int j = 0; j < resolution; ++j)
+  {
+    for (int i = 0; i < numTheta; ++i)
+    {
+      vtkIdType p0 = j * numTheta + i;
+      vtkIdType p1 = j * numTheta + (i + 1) % numTheta;
+      vtkIdType tri0[3] = { p0, p1, p1 + numTheta };
+      vtkIdType tri1[3] = { p0, p1 + numTheta, p0 + numTheta };
+      polys->InsertNextCell(3, tri0);
+      polys->InsertNextCell(3, tri1);
+    }
+  }
+  pd->SetPoints(points);
+  pd->SetPolys(polys);
+}
+
+// Closest intersection of a line with all cells, by brute force.
+int IntersectAllCells(
+  vtkPolyData* pd, const double p1[3], const double p2[3], double& tMin, vtkIdType& cellId)
+{
+  vtkNew<vtkGenericCell> cell;
+  double t, x[3], pcoords[3];
+  int subId;
+  tMin = VTK_DOUBLE_MAX;
+  cellId = -1;
+  for (vtkIdType i = 0; i < pd->GetNumberOfCells(); ++i)
+  {
+    pd->GetCell(i, cell);
+    if (cell->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId) && t < tMin)
+    {
+      tMin = t;
+      cellId = i;
+    }
+  }
+  return (cellId >= 0 ? 1 : 0);
+}
+
+// Squared distance to the closest cell, by brute force.
+double ClosestPointAllCells(vtkPolyData* pd, const double x[3])
+{
+  vtkNew<vtkGenericCell> cell;
+  double closest[3], pcoords[3], weights[3], dist2, minDist2 = VTK_DOUBLE_MAX;
+  int subId;
+  for (vtkIdType i = 0; i < pd->GetNumberOfCells(); ++i)
+  {
+    pd->GetCell(i, cell);
+    if (cell->EvaluatePosition(x, closest, subId, pcoords, dist2, weights) != -1)
+    {
+      minDist2 = std::min(minDist2, dist2);
+    }
+  }
+  return minDist2;
+}
+
+void RandomPoint(vtkMinimalStandardRandomSequence* random, double range, double x[3])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    x[i] = random->GetRangeValue(-range, range);
+    random->Next();
+  }
+}
+
+// Check the queries of the locator against brute force.
+int CheckLocator(
+  vtkBVHCellLocator* bvh, vtkPolyData* sphere, vtkMinimalStandardRandomSequence* random)
+{
+  vtkNew<vtkGenericCell> cell;
+
+  // Rays between random points, some of which miss the sphere, and rays
+  // parallel to the z axis in the plane x=0 (which contains mesh edges).
+  vtkNew<vtkPoints> p1s, p2s;
+  p1s->SetDataTypeToDouble();
+  p2s->SetDataTypeToDouble();
+  for (int i = 0; i < 101; ++i)
+  {
+    double p1[3], p2[3];
+    RandomPoint(random, 2.0, p1);
+    RandomPoint(random, 2.0, p2);
+    p1s->InsertNextPoint(p1);
+    p2s->InsertNextPoint(p2);
+  }
+  for (int i = 0; i < 20; ++i)
+  {
+    p1s->InsertNextPoint(0.0, -0.95 + 0.1 * i, 2.0);
+    p2s->InsertNextPoint(0.0, -0.95 + 0.1 * i, -2.0);
+  }
+  const vtkIdType numRays = p1s->GetNumberOfPoints();
+
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> ts;
+  vtkNew<vtkPoints> xs;
+  xs->SetDataTypeToDouble();
+  bvh->IntersectWithLines(p1s, p2s, 0.0, cellIds, ts, xs);
+
+  int numHits = 0;
+  for (vtkIdType i = 0; i < numRays; ++i)
+  {
+    double p1[3], p2[3], t, refT, x[3], pcoords[3];
+    int subId;
+    vtkIdType cellId, refCellId;
+    p1s->GetPoint(i, p1);
+    p2s->GetPoint(i, p2);
+    int hit = bvh->IntersectWithLine(p1, p2, 0.0, t, x, pcoords, subId, cellId, cell);
+    int refHit = IntersectAllCells(sphere, p1, p2, refT, refCellId);
+    if (hit != refHit || (hit && std::abs(t - refT) > 1.0e-9))
+    {
+      std::cerr << "Ray " << i << ": hit " << hit << " (t=" << t << "), expected " << refHit
+                << " (t=" << refT << ")" << std::endl;
+      return 0;
+    }
+    if ((hit ? cellId : -1) != cellIds->GetId(i) ||
+      (hit && (t != ts->GetValue(i) || x[0] != xs->GetPoint(i)[0])))
+    {
+      std::cerr << "Ray " << i << ": batched intersection differs" << std::endl;
+      return 0;
+    }
+    numHits += hit;
+  }
+  if (numHits == 0 || numHits == numRays)
+  {
+    std::cerr << "Unexpected number of hits: " << numHits << std::endl;
+    return 0;
+  }
+
+  // Closest points
+  for (int i = 0; i < 20; ++i)
+  {
+    double x[3], closest[3], dist2, refDist2;
+    vtkIdType cellId;
+    int subId;
+    RandomPoint(random, 2.0, x);
+    bvh->FindClosestPoint(x, closest, cell, cellId, subId, dist2);
+    refDist2 = ClosestPointAllCells(sphere, x);
+    if (std::abs(dist2 - refDist2) > 1.0e-12)
+    {
+      std::cerr << "Closest point distance " << dist2 << ", expected " << refDist2 << std::endl;
+      return 0;
+    }
+  }
+
+  // Cells within bounds
+  double bbox[6] = { -0.3, 0.5, 0.0, 1.2, -1.2, 0.2 };
+  vtkNew<vtkIdList> cells;
+  bvh->FindCellsWithinBounds(bbox, cells);
+  vtkIdType numInBounds = 0;
+  for (vtkIdType cellId = 0; cellId < sphere->GetNumberOfCells(); ++cellId)
+  {
+    double b[6];
+    sphere->GetCellBounds(cellId, b);
+    if (b[0] <= bbox[1] && bbox[0] <= b[1] && b[2] <= bbox[3] && bbox[2] <= b[3] &&
+      b[4] <= bbox[5] && bbox[4] <= b[5])
+    {
+      numInBounds++;
+    }
+  }
+  if (cells->GetNumberOfIds() != numInBounds || numInBounds == 0)
+  {
+    std::cerr << "Found " << cells->GetNumberOfIds() << " cells within bounds, expected "
+              << numInBounds << std::endl;
+    return 0;
+  }
+
+  return 1;
+}
+}
+
+int TestBVHCellLocator(int, char*[])
+{
+  vtkNew<vtkPolyData> sphere;
+  MakeSphere(120, sphere); // more cells than a single subtree
+
+  vtkNew<vtkBVHCellLocator> bvh;
+  bvh->SetDataSet(sphere);
+  bvh->BuildLocator();
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(8775);
+  if (!CheckLocator(bvh, sphere, random))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Twist and stretch the sphere: the tree is refitted.
+  bvh->RefitOnModifiedOn();
+  bvh->SetRebuildThreshold(VTK_DOUBLE_MAX);
+  const vtkIdType numNodes = bvh->GetNumberOfNodes();
+  vtkPoints* points = sphere->GetPoints();
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    double angle = 0.5 * x[2];
+    points->SetPoint(i, 1.5 * (std::cos(angle) * x[0] - std::sin(angle) * x[1]),
+      std::sin(angle) * x[0] + std::cos(angle) * x[1], x[2]);
+  }
+  points->Modified();
+  if (!CheckLocator(bvh, sphere, random) || bvh->GetNumberOfNodes() != numNodes)
+  {
+    std::cerr << "Failed for the refitted tree" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Scramble the points, which degrades the refitted tree: it is rebuilt.
+  bvh->SetRebuildThreshold(1.0);
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    RandomPoint(random, 1.0, x);
+    points->SetPoint(i, x);
+  }
+  points->Modified();
+  if (!CheckLocator(bvh, sphere, random))
+  {
+    std::cerr << "Failed for the rebuilt tree" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // An empty dataset is valid input: the queries find nothing, quietly.
+  vtkNew<vtkPolyData> empty;
+  vtkNew<vtkBVHCellLocator> emptyBVH;
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  emptyBVH->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  emptyBVH->SetDataSet(empty);
+  emptyBVH->BuildLocator();
+  double x[3] = { 0.0, 0.0, 0.0 };
+  double closestPoint[3], dist2;
+  vtkIdType cellId = -1;
+  int subId;
+  emptyBVH->FindClosestPoint(x, closestPoint, cellId, subId, dist2);
+  if (emptyBVH->FindCell(x) != -1 || cellId != -1 || errorObserver->GetError())
+  {
+    std::cerr << "Failed for an empty dataset" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,221 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImplicitFunctionsBatch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that the batch evaluation of the implicit functions (for arrays of
+// points, and for the points of data sets) gives exactly the same values as
+// the single point evaluation, including for a subclass overriding only
+// the single point evaluation.
+
+#include "vtkBox.h"
+#include "vtkCone.h"
+#include "vtkCylinder.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkImageData.h"
+#include "vtkImplicitBoolean.h"
+#include "vtkImplicitFunctionCollection.h"
+#include "vtkImplicitSum.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPlane.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkQuadric.h"
+#include "vtkSphere.h"
+#include "vtkTransform.h"
+
+#include <iostream>
+
+namespace
+{
+// A sphere shifted by overriding the single point evaluation only.
+class ShiftedSphere : public vtkSphere
+{
+public:
+  static ShiftedSphere* New();
+  vtkTypeMacro(ShiftedSphere, vtkSphere);
+
+  using vtkSphere::EvaluateFunction;
+  double EvaluateFunction(double x[3]) override
+  {
+    const double shifted[3] = { x[0] - 0.5, x[1], x[2] };
+    return this->Superclass::EvaluateFunction(const_cast<double*>(shifted));
+  }
+};
+vtkStandardNewMacro(ShiftedSphere);
+
+// Compare the batch evaluation of input to the single point evaluation,
+// for float and double values.
+int CheckArray(vtkImplicitFunction* function, vtkDataArray* input)
+{
+  vtkNew<vtkDoubleArray> dValues;
+  vtkNew<vtkFloatArray> fValues;
+  function->FunctionValue(input, dValues);
+  function->FunctionValue(input, fValues);
+  if (dValues->GetNumberOfTuples() != input->GetNumberOfTuples() ||
+    fValues->GetNumberOfTuples() != input->GetNumberOfTuples())
+  {
+    std::cerr << function->GetClassName() << ": wrong number of values" << std::endl;
+    return 0;
+  }
+  for (vtkIdType i = 0; i < input->GetNumberOfTuples(); ++i)
+  {
+    double x[3];
+    input->GetTuple(i, x);
+    double value = function->FunctionValue(x);
+    if (dValues->GetValue(i) != value || fValues->GetValue(i) != static_cast<float>(value))
+    {
+      std::cerr << function->GetClassName() << ": point " << i << " evaluates to "
+                << dValues->GetValue(i) << ", expected " << value << std::endl;
+      return 0;
+    }
+  }
+  return 1;
+}
+
+int CheckFunction(vtkImplicitFunction* function, vtkDataArray* fPoints, vtkDataArray* dPoints,
+  vtkImageData* image)
+{
+  if (!CheckArray(function, fPoints) || !CheckArray(function, dPoints))
+  {
+    return 0;
+  }
+
+  // The points of a data set without explicit points.
+  vtkNew<vtkFloatArray> values;
+  function->FunctionValue(image, values);
+  for (vtkIdType i = 0; i < image->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    image->GetPoint(i, x);
+    if (values->GetValue(i) != static_cast<float>(function->FunctionValue(x)))
+    {
+      std::cerr << function->GetClassName() << ": wrong value at image point " << i << std::endl;
+      return 0;
+    }
+  }
+  return 1;
+}
+}
+
+int TestImplicitFunctionsBatch(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1234);
+  vtkNew<vtkFloatArray> fPoints;
+  vtkNew<vtkDoubleArray> dPoints;
+  fPoints->SetNumberOfComponents(3);
+  dPoints->SetNumberOfComponents(3);
+  for (int i = 0; i < 1000; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetRangeValue(-2.0, 2.0);
+      random->Next();
+    }
+    fPoints->InsertNextTuple(x);
+    dPoints->InsertNextTuple(x);
+  }
+
+  // More points than a block of FunctionValue(vtkDataSet*, vtkDataArray*)
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(50, 40, 40);
+  image->SetOrigin(-1.5, -1.5, -1.5);
+  image->SetSpacing(0.07, 0.08, 0.09);
+
+  vtkNew<vtkPlane> plane;
+  plane->SetOrigin(0.1, 0.2, 0.3);
+  plane->SetNormal(1.0, -2.0, 0.5);
+  vtkNew<vtkSphere> sphere;
+  sphere->SetCenter(0.5, -0.25, 0.0);
+  sphere->SetRadius(1.2);
+  vtkNew<vtkBox> box;
+  box->SetBounds(-0.5, 1.0, -1.0, 0.25, 0.0, 0.0); // flat along z
+  vtkNew<vtkCylinder> cylinder;
+  cylinder->SetCenter(0.0, 0.5, 0.0);
+  cylinder->SetAxis(1.0, 1.0, 0.0);
+  cylinder->SetRadius(0.75);
+  vtkNew<vtkQuadric> quadric;
+  quadric->SetCoefficients(1.0, 2.0, -1.0, 0.5, 0.25, -0.5, 1.0, 0.0, -1.0, 0.1);
+  vtkNew<vtkCone> cone; // no batch evaluation
+  cone->SetAngle(30.0);
+
+  vtkNew<vtkTransform> transform;
+  transform->RotateZ(30.0);
+  transform->Translate(0.5, 0.0, -0.25);
+  vtkNew<vtkSphere> transformedSphere;
+  transformedSphere->SetRadius(0.8);
+  transformedSphere->SetTransform(transform);
+
+  vtkNew<ShiftedSphere> shiftedSphere;
+  shiftedSphere->SetRadius(0.8);
+
+  vtkImplicitFunction* functions[] = { plane, sphere, box, cylinder, quadric, cone,
+    transformedSphere, shiftedSphere };
+  for (vtkImplicitFunction* function : functions)
+  {
+    if (!CheckFunction(function, fPoints, dPoints, image))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  vtkNew<vtkImplicitBoolean> boolean;
+  boolean->AddFunction(sphere);
+  boolean->AddFunction(box);
+  boolean->AddFunction(cone);
+  boolean->AddFunction(transformedSphere);
+  boolean->AddFunction(shiftedSphere);
+  for (int op = vtkImplicitBoolean::VTK_UNION; op <= vtkImplicitBoolean::VTK_UNION_OF_MAGNITUDES;
+       ++op)
+  {
+    boolean->SetOperationType(op);
+    if (!CheckFunction(boolean, fPoints, dPoints, image))
+    {
+      std::cerr << "Failed for operation " << boolean->GetOperationTypeAsString() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // The first function may appear again in the list, through the collection.
+  vtkNew<vtkImplicitBoolean> difference;
+  difference->SetOperationTypeToDifference();
+  difference->AddFunction(sphere);
+  difference->AddFunction(box);
+  difference->GetFunction()->AddItem(sphere);
+  if (!CheckFunction(difference, fPoints, dPoints, image))
+  {
+    std::cerr << "Failed for a difference repeating its first function" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkImplicitSum> sum;
+  sum->AddFunction(plane, 2.0);
+  sum->AddFunction(quadric, -0.5);
+  sum->AddFunction(cylinder, 0.0);
+  sum->AddFunction(boolean, 1.5);
+  sum->SetTransform(transform);
+  for (int normalize = 0; normalize < 2; ++normalize)
+  {
+    sum->SetNormalizeByWeight(normalize);
+    if (!CheckFunction(sum, fPoints, dPoints, image))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
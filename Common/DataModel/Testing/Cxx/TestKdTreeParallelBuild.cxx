@@ -0,0 +1,192 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestKdTreeParallelBuild.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Build a vtkKdTree in parallel and with the serial recursive division, and
+// check that the regions, the order of their points and the results of the
+// point queries are the same, and that the closest points are correct.
+
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkKdTree.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+// A k-d tree whose regions are divided recursively in the calling thread.
+class SerialKdTree : public vtkKdTree
+{
+public:
+  static SerialKdTree* New();
+  vtkTypeMacro(SerialKdTree, vtkKdTree);
+
+protected:
+  SerialKdTree() = default;
+  ~SerialKdTree() override = default;
+
+  int DivideRegion(vtkKdNode* kd, float* c1, int* ids, int nlevels) override
+  {
+    this->_DivideRegion(kd, c1, ids, nlevels);
+    return 0;
+  }
+
+private:
+  SerialKdTree(const SerialKdTree&) = delete;
+  void operator=(const SerialKdTree&) = delete;
+};
+vtkStandardNewMacro(SerialKdTree);
+
+bool SameIds(vtkIdList* a, vtkIdList* b)
+{
+  if (a->GetNumberOfIds() != b->GetNumberOfIds())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfIds(); ++i)
+  {
+    if (a->GetId(i) != b->GetId(i))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompareRegions(vtkKdTree* tree, vtkKdTree* serial)
+{
+  if (tree->GetNumberOfRegions() != serial->GetNumberOfRegions() ||
+    tree->GetNumberOfRegions() < 2)
+  {
+    std::cerr << "Wrong number of regions " << tree->GetNumberOfRegions() << std::endl;
+    return false;
+  }
+  for (int region = 0; region < tree->GetNumberOfRegions(); ++region)
+  {
+    double bounds[6], serialBounds[6], dataBounds[6], serialDataBounds[6];
+    tree->GetRegionBounds(region, bounds);
+    serial->GetRegionBounds(region, serialBounds);
+    tree->GetRegionDataBounds(region, dataBounds);
+    serial->GetRegionDataBounds(region, serialDataBounds);
+    for (int i = 0; i < 6; ++i)
+    {
+      if (bounds[i] != serialBounds[i] || dataBounds[i] != serialDataBounds[i])
+      {
+        std::cerr << "The bounds of region " << region << " differ" << std::endl;
+        return false;
+      }
+    }
+    vtkIdTypeArray* ids = tree->GetPointsInRegion(region);
+    vtkIdTypeArray* serialIds = serial->GetPointsInRegion(region);
+    if (!ids || !serialIds || ids->GetNumberOfTuples() != serialIds->GetNumberOfTuples())
+    {
+      std::cerr << "The points of region " << region << " differ" << std::endl;
+      return false;
+    }
+    for (vtkIdType i = 0; i < ids->GetNumberOfTuples(); ++i)
+    {
+      if (ids->GetValue(i) != serialIds->GetValue(i))
+      {
+        std::cerr << "The points of region " << region << " differ" << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestKdTreeParallelBuild(int, char*[])
+{
+  // More points than a region divided by a single task, with duplicates.
+  const vtkIdType numPts = 40000;
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(8775);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetRangeValue(-1.0, 1.0) * (j == 1 ? 3.0 : 1.0);
+      random->Next();
+    }
+    points->SetPoint(i, x);
+  }
+  for (vtkIdType i = 0; i < numPts; i += 97)
+  {
+    points->SetPoint(i + 1, points->GetPoint(i));
+  }
+
+  vtkNew<vtkKdTree> tree;
+  vtkNew<SerialKdTree> serial;
+  tree->BuildLocatorFromPoints(points);
+  serial->BuildLocatorFromPoints(points);
+  if (!CompareRegions(tree, serial))
+  {
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkIdList> ids;
+  vtkNew<vtkIdList> serialIds;
+  for (int q = 0; q < 200; ++q)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetRangeValue(-1.2, 1.2) * (j == 1 ? 3.0 : 1.0);
+      random->Next();
+    }
+
+    double dist2, serialDist2;
+    const vtkIdType closest = tree->FindClosestPoint(x, dist2);
+    const vtkIdType serialClosest = serial->FindClosestPoint(x, serialDist2);
+    double minDist2 = VTK_DOUBLE_MAX;
+    for (vtkIdType i = 0; i < numPts; ++i)
+    {
+      minDist2 = std::min(minDist2, vtkMath::Distance2BetweenPoints(x, points->GetPoint(i)));
+    }
+    if (closest != serialClosest || dist2 != serialDist2 ||
+      vtkMath::Distance2BetweenPoints(x, points->GetPoint(closest)) != minDist2)
+    {
+      std::cerr << "Wrong closest point " << closest << " of query " << q << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    tree->FindClosestNPoints(10, x, ids);
+    serial->FindClosestNPoints(10, x, serialIds);
+    if (ids->GetNumberOfIds() != 10 || !SameIds(ids, serialIds))
+    {
+      std::cerr << "The closest points of query " << q << " differ" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    tree->FindPointsWithinRadius(0.2, x, ids);
+    serial->FindPointsWithinRadius(0.2, x, serialIds);
+    if (!SameIds(ids, serialIds))
+    {
+      std::cerr << "The points within the radius of query " << q << " differ" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
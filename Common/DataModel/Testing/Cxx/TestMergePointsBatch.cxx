@@ -0,0 +1,109 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestMergePointsBatch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkMergePoints::InsertUniquePoints() gives the same result as
+// inserting the points one at a time with InsertUniquePoint().
+
+#include "vtkMergePoints.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// Random points, many of which are duplicated.
+void RandomPoints(vtkMinimalStandardRandomSequence* random, vtkIdType numPts, vtkPoints* points)
+{
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = 0.05 * static_cast<int>(random->GetRangeValue(0.0, 20.0)) + 1.0e-9 * (i % 2);
+      random->Next();
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+int CheckInsertion(int dataType, vtkMinimalStandardRandomSequence* random)
+{
+  const double bounds[6] = { 0.0, 1.0, 0.0, 1.0, 0.0, 1.0 };
+  vtkNew<vtkPoints> serialPts, batchPts;
+  serialPts->SetDataType(dataType);
+  batchPts->SetDataType(dataType);
+  vtkNew<vtkMergePoints> serial, batch;
+  serial->InitPointInsertion(serialPts, bounds);
+  batch->InitPointInsertion(batchPts, bounds);
+
+  // Insert two batches, the second one into a non-empty locator.
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    vtkNew<vtkPoints> points;
+    RandomPoints(random, 20000, points);
+    std::vector<vtkIdType> serialIds(points->GetNumberOfPoints());
+    std::vector<vtkIdType> batchIds(points->GetNumberOfPoints());
+    vtkIdType numInserted = 0;
+    for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+    {
+      numInserted += serial->InsertUniquePoint(points->GetPoint(i), serialIds[i]);
+    }
+    if (batch->InsertUniquePoints(points, batchIds.data()) != numInserted ||
+      batchIds != serialIds)
+    {
+      std::cerr << "Batch insertion differs for data type " << dataType << std::endl;
+      return 0;
+    }
+    if (numInserted == 0 || numInserted == points->GetNumberOfPoints())
+    {
+      std::cerr << "Unexpected number of inserted points: " << numInserted << std::endl;
+      return 0;
+    }
+  }
+
+  if (batchPts->GetNumberOfPoints() != serialPts->GetNumberOfPoints())
+  {
+    std::cerr << "Different number of points for data type " << dataType << std::endl;
+    return 0;
+  }
+  for (vtkIdType i = 0; i < serialPts->GetNumberOfPoints(); ++i)
+  {
+    double x[3], y[3];
+    serialPts->GetPoint(i, x);
+    batchPts->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Point " << i << " differs for data type " << dataType << std::endl;
+      return 0;
+    }
+  }
+  return 1;
+}
+}
+
+int TestMergePointsBatch(int, char*[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(5171);
+  if (!CheckInsertion(VTK_FLOAT, random) || !CheckInsertion(VTK_DOUBLE, random) ||
+    !CheckInsertion(VTK_INT, random))
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
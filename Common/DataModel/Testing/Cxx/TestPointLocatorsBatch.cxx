@@ -0,0 +1,162 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPointLocatorsBatch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the batched queries of the point locators against the single point
+// queries.
+
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkKdTreePointLocator.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkOctreePointLocator.h"
+#include "vtkPointLocator.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkStaticPointLocator.h"
+
+#include <iostream>
+
+namespace
+{
+void RandomPoints(vtkMinimalStandardRandomSequence* random, vtkIdType numPts, vtkPoints* points)
+{
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetRangeValue(-1.0, 1.0);
+      random->Next();
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+// Compare the ids ptIds[offsets[i]:offsets[i+1]] with the ids of result, and
+// the squared distances with the ones of the points of result.
+int CheckIds(vtkPoints* points, const double x[3], vtkIdList* result, vtkIdTypeArray* offsets,
+  vtkIdType i, vtkIdList* ptIds, vtkDoubleArray* dist2)
+{
+  const vtkIdType begin = (offsets ? offsets->GetValue(i) : i);
+  const vtkIdType end = (offsets ? offsets->GetValue(i + 1) : i + 1);
+  if (end - begin != result->GetNumberOfIds())
+  {
+    std::cerr << "Query " << i << ": found " << end - begin << " points, expected "
+              << result->GetNumberOfIds() << std::endl;
+    return 0;
+  }
+  for (vtkIdType j = begin; j < end; ++j)
+  {
+    const vtkIdType ptId = result->GetId(j - begin);
+    if (ptIds->GetId(j) != ptId ||
+      dist2->GetValue(j) != vtkMath::Distance2BetweenPoints(x, points->GetPoint(ptId)))
+    {
+      std::cerr << "Query " << i << ": batched result differs" << std::endl;
+      return 0;
+    }
+  }
+  return 1;
+}
+
+int CheckLocator(vtkAbstractPointLocator* locator, vtkPolyData* pd, vtkPoints* queries)
+{
+  locator->SetDataSet(pd);
+  locator->BuildLocator();
+
+  vtkNew<vtkIdTypeArray> offsets;
+  vtkNew<vtkIdList> ptIds, result;
+  vtkNew<vtkDoubleArray> dist2;
+  double x[3];
+  const vtkIdType numQueries = queries->GetNumberOfPoints();
+
+  locator->FindClosestPointBatch(queries, ptIds, dist2);
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    queries->GetPoint(i, x);
+    result->SetNumberOfIds(1);
+    result->SetId(0, locator->FindClosestPoint(x));
+    if (!CheckIds(pd->GetPoints(), x, result, nullptr, i, ptIds, dist2))
+    {
+      return 0;
+    }
+  }
+
+  locator->FindClosestNPointsBatch(10, queries, offsets, ptIds, dist2);
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    queries->GetPoint(i, x);
+    locator->FindClosestNPoints(10, x, result);
+    if (!CheckIds(pd->GetPoints(), x, result, offsets, i, ptIds, dist2))
+    {
+      return 0;
+    }
+  }
+
+  locator->FindPointsWithinRadiusBatch(0.1, queries, offsets, ptIds, dist2);
+  vtkIdType numFound = 0;
+  for (vtkIdType i = 0; i < numQueries; ++i)
+  {
+    queries->GetPoint(i, x);
+    locator->FindPointsWithinRadius(0.1, x, result);
+    numFound += result->GetNumberOfIds();
+    if (!CheckIds(pd->GetPoints(), x, result, offsets, i, ptIds, dist2))
+    {
+      return 0;
+    }
+  }
+  if (numFound == 0 || offsets->GetNumberOfValues() != numQueries + 1)
+  {
+    std::cerr << "Unexpected results of FindPointsWithinRadiusBatch()" << std::endl;
+    return 0;
+  }
+
+  return 1;
+}
+}
+
+int TestPointLocatorsBatch(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(3117);
+
+  vtkNew<vtkPoints> points;
+  RandomPoints(random, 5000, points);
+  vtkNew<vtkPolyData> pd;
+  pd->SetPoints(points);
+
+  vtkNew<vtkPoints> queries;
+  RandomPoints(random, 1000, queries);
+
+  vtkNew<vtkStaticPointLocator> staticLocator;
+  vtkNew<vtkKdTreePointLocator> kdTreeLocator;
+  vtkNew<vtkOctreePointLocator> octreeLocator;
+  vtkNew<vtkPointLocator> pointLocator;
+  vtkAbstractPointLocator* locators[4] = { staticLocator, kdTreeLocator, octreeLocator,
+    pointLocator };
+  for (vtkAbstractPointLocator* locator : locators)
+  {
+    if (!CheckLocator(locator, pd, queries))
+    {
+      std::cerr << "Failed for " << locator->GetClassName() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
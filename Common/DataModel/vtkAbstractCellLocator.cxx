@@ -22,6 +22,7 @@
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 vtkAbstractCellLocator::vtkAbstractCellLocator()
@@ -48,13 +49,43 @@ bool vtkAbstractCellLocator::StoreCellBounds()
     return false;
   if (!this->DataSet)
     return false;
-  // Allocate space for cell bounds storage, then fill
+  // Allocate space for cell bounds storage, then fill in parallel when the
+  // dataset computes the bounds of a cell without going through a shared
+  // cell (vtkDataSet::GetCellBounds() uses GetCell()). The first call causes
+  // non-thread safe initialization to occur due to side effects from
+  // GetCellBounds().
   vtkIdType numCells = this->DataSet->GetNumberOfCells();
   this->CellBounds = new double[numCells][6];
-  for (vtkIdType j = 0; j < numCells; j++)
+  if (numCells < 1)
   {
-    this->DataSet->GetCellBounds(j, CellBounds[j]);
+    return true;
   }
+  vtkDataSet* ds = this->DataSet;
+  double(*cellBounds)[6] = this->CellBounds;
+  ds->GetCellBounds(0, cellBounds[0]);
+  switch (ds->GetDataObjectType())
+  {
+    case VTK_POLY_DATA:
+    case VTK_UNSTRUCTURED_GRID:
+    case VTK_IMAGE_DATA:
+    case VTK_STRUCTURED_POINTS:
+    case VTK_UNIFORM_GRID:
+    case VTK_RECTILINEAR_GRID:
+    case VTK_STRUCTURED_GRID:
+      break;
+    default:
+      for (vtkIdType cellId = 1; cellId < numCells; ++cellId)
+      {
+        ds->GetCellBounds(cellId, cellBounds[cellId]);
+      }
+      return true;
+  }
+  vtkSMPTools::For(1, numCells, [ds, cellBounds](vtkIdType cellId, vtkIdType endCellId) {
+    for (; cellId < endCellId; ++cellId)
+    {
+      ds->GetCellBounds(cellId, cellBounds[cellId]);
+    }
+  });
   return true;
 }
 //------------------------------------------------------------------------------
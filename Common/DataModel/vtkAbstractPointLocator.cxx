@@ -15,7 +15,157 @@
 #include "vtkAbstractPointLocator.h"
 
 #include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <vector>
+
+namespace
+{
+//------------------------------------------------------------------------------
+// Perform a query returning a list of point ids for each query point, and
+// gather the results in compressed row form. Each thread appends the results
+// of its ranges of query points to its own buffers, which are copied to their
+// final location once the offsets are known.
+template <typename TQuery>
+struct BatchQuery
+{
+  struct Range
+  {
+    vtkIdType Begin;
+    std::vector<vtkIdType> Ids;
+  };
+
+  vtkPoints* Queries;
+  TQuery Query;
+  vtkIdType* Offsets;
+  vtkSMPThreadLocalObject<vtkIdList> Result;
+  vtkSMPThreadLocal<std::vector<Range>> Ranges;
+
+  BatchQuery(vtkPoints* queries, TQuery query, vtkIdType* offsets)
+    : Queries(queries)
+    , Query(query)
+    , Offsets(offsets)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType queryId, vtkIdType endQueryId)
+  {
+    vtkIdList* result = this->Result.Local();
+    std::vector<Range>& ranges = this->Ranges.Local();
+    ranges.emplace_back();
+    Range& range = ranges.back();
+    range.Begin = queryId;
+    double x[3];
+    for (; queryId < endQueryId; ++queryId)
+    {
+      this->Queries->GetPoint(queryId, x);
+      this->Query(x, result);
+      const vtkIdType numIds = result->GetNumberOfIds();
+      this->Offsets[queryId + 1] = numIds;
+      range.Ids.insert(range.Ids.end(), result->GetPointer(0), result->GetPointer(0) + numIds);
+    }
+  }
+
+  void Reduce() {}
+
+  // Perform the queries and fill offsets and ptIds.
+  void Execute(bool threaded, vtkIdList* ptIds)
+  {
+    const vtkIdType numQueries = this->Queries->GetNumberOfPoints();
+    this->Offsets[0] = 0;
+    if (numQueries > 0)
+    {
+      // The first query is performed serially, in case it causes the
+      // locator to be built.
+      (*this)(0, 1);
+      if (threaded)
+      {
+        vtkSMPTools::For(1, numQueries, *this);
+      }
+      else
+      {
+        (*this)(1, numQueries);
+      }
+    }
+
+    for (vtkIdType queryId = 0; queryId < numQueries; ++queryId)
+    {
+      this->Offsets[queryId + 1] += this->Offsets[queryId];
+    }
+
+    std::vector<const Range*> ranges;
+    for (auto iter = this->Ranges.begin(); iter != this->Ranges.end(); ++iter)
+    {
+      for (const Range& range : *iter)
+      {
+        ranges.push_back(&range);
+      }
+    }
+    ptIds->SetNumberOfIds(this->Offsets[numQueries]);
+    vtkIdType* ids = ptIds->GetPointer(0);
+    const vtkIdType* offsets = this->Offsets;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(ranges.size()),
+      [&ranges, ids, offsets](vtkIdType rangeId, vtkIdType endRangeId) {
+        for (; rangeId < endRangeId; ++rangeId)
+        {
+          const Range* range = ranges[rangeId];
+          std::copy(range->Ids.begin(), range->Ids.end(), ids + offsets[range->Begin]);
+        }
+      });
+  }
+};
+
+template <typename TQuery>
+void ExecuteBatchQuery(bool threaded, vtkPoints* queries, TQuery query, vtkIdTypeArray* offsets,
+  vtkIdList* ptIds)
+{
+  offsets->SetNumberOfComponents(1);
+  offsets->SetNumberOfTuples(queries->GetNumberOfPoints() + 1);
+  BatchQuery<TQuery> batch(queries, query, offsets->GetPointer(0));
+  batch.Execute(threaded, ptIds);
+}
+
+//------------------------------------------------------------------------------
+// Compute the squared distances between the query points and the points found
+// for them.
+void ComputeDistances(vtkDataSet* ds, vtkPoints* queries, const vtkIdType* offsets,
+  vtkIdList* ptIds, vtkDoubleArray* dist2)
+{
+  const vtkIdType numQueries = queries->GetNumberOfPoints();
+  dist2->SetNumberOfComponents(1);
+  dist2->SetNumberOfTuples(ptIds->GetNumberOfIds());
+  const vtkIdType* ids = ptIds->GetPointer(0);
+  double* d2 = dist2->GetPointer(0);
+  vtkSMPTools::For(0, numQueries, [=](vtkIdType queryId, vtkIdType endQueryId) {
+    double x[3], y[3];
+    for (; queryId < endQueryId; ++queryId)
+    {
+      queries->GetPoint(queryId, x);
+      const vtkIdType begin = (offsets ? offsets[queryId] : queryId);
+      const vtkIdType end = (offsets ? offsets[queryId + 1] : queryId + 1);
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        if (ids[i] < 0)
+        {
+          d2[i] = VTK_DOUBLE_MAX;
+          continue;
+        }
+        ds->GetPoint(ids[i], y);
+        d2[i] = vtkMath::Distance2BetweenPoints(x, y);
+      }
+    }
+  });
+}
+} // anonymous namespace
 
 //------------------------------------------------------------------------------
 vtkAbstractPointLocator::vtkAbstractPointLocator()
@@ -64,6 +214,74 @@ void vtkAbstractPointLocator::FindPointsWithinRadius(
   this->FindPointsWithinRadius(R, p, result);
 }
 
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestPointBatch(
+  vtkPoints* queries, vtkIdList* ptIds, vtkDoubleArray* dist2)
+{
+  const vtkIdType numQueries = queries->GetNumberOfPoints();
+  ptIds->SetNumberOfIds(numQueries);
+  if (numQueries < 1)
+  {
+    if (dist2)
+    {
+      dist2->SetNumberOfTuples(0);
+    }
+    return;
+  }
+
+  // The first query is performed serially, in case it causes the locator
+  // to be built.
+  vtkIdType* ids = ptIds->GetPointer(0);
+  auto query = [this, queries, ids](vtkIdType queryId, vtkIdType endQueryId) {
+    double x[3];
+    for (; queryId < endQueryId; ++queryId)
+    {
+      queries->GetPoint(queryId, x);
+      ids[queryId] = this->FindClosestPoint(x);
+    }
+  };
+  query(0, 1);
+  if (this->SupportsConcurrentQueries())
+  {
+    vtkSMPTools::For(1, numQueries, query);
+  }
+  else
+  {
+    query(1, numQueries);
+  }
+
+  if (dist2)
+  {
+    ComputeDistances(this->DataSet, queries, nullptr, ptIds, dist2);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindClosestNPointsBatch(int N, vtkPoints* queries,
+  vtkIdTypeArray* offsets, vtkIdList* ptIds, vtkDoubleArray* dist2)
+{
+  ExecuteBatchQuery(this->SupportsConcurrentQueries(), queries,
+    [this, N](const double x[3], vtkIdList* result) { this->FindClosestNPoints(N, x, result); },
+    offsets, ptIds);
+  if (dist2)
+  {
+    ComputeDistances(this->DataSet, queries, offsets->GetPointer(0), ptIds, dist2);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkAbstractPointLocator::FindPointsWithinRadiusBatch(double R, vtkPoints* queries,
+  vtkIdTypeArray* offsets, vtkIdList* ptIds, vtkDoubleArray* dist2)
+{
+  ExecuteBatchQuery(this->SupportsConcurrentQueries(), queries,
+    [this, R](const double x[3], vtkIdList* result) { this->FindPointsWithinRadius(R, x, result); },
+    offsets, ptIds);
+  if (dist2)
+  {
+    ComputeDistances(this->DataSet, queries, offsets->GetPointer(0), ptIds, dist2);
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkAbstractPointLocator::GetBounds(double* bnds)
 {
@@ -33,7 +33,10 @@
 #include "vtkCommonDataModelModule.h" // For export macro
 #include "vtkLocator.h"
 
+class vtkDoubleArray;
 class vtkIdList;
+class vtkIdTypeArray;
+class vtkPoints;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkAbstractPointLocator : public vtkLocator
 {
@@ -89,6 +92,36 @@ public:
   void FindPointsWithinRadius(double R, double x, double y, double z, vtkIdList* result);
   //@}
 
+  //@{
+  /**
+   * Batched versions of the queries above, which process all of the points
+   * of queries at once. FindClosestPointBatch() returns in ptIds the id of
+   * the closest point to each query point. FindClosestNPointsBatch() and
+   * FindPointsWithinRadiusBatch() return their results in compressed row
+   * form: the ids of the points found for query point i are the entries
+   * offsets[i] <= j < offsets[i+1] of ptIds (offsets has one more value than
+   * there are query points). If dist2 is non-null, it returns the squared
+   * distances from the query points to the points of ptIds. The results are
+   * the same as the ones of the single point queries. The query points are
+   * processed in parallel when the single point queries are thread safe (see
+   * SupportsConcurrentQueries()).
+   */
+  virtual void FindClosestPointBatch(
+    vtkPoints* queries, vtkIdList* ptIds, vtkDoubleArray* dist2 = nullptr);
+  virtual void FindClosestNPointsBatch(int N, vtkPoints* queries, vtkIdTypeArray* offsets,
+    vtkIdList* ptIds, vtkDoubleArray* dist2 = nullptr);
+  virtual void FindPointsWithinRadiusBatch(double R, vtkPoints* queries,
+    vtkIdTypeArray* offsets, vtkIdList* ptIds, vtkDoubleArray* dist2 = nullptr);
+  //@}
+
+  /**
+   * Return true if FindClosestPoint(), FindClosestNPoints() and
+   * FindPointsWithinRadius() may be invoked concurrently once the locator is
+   * built, in which case the batched queries run in parallel. The default
+   * is false.
+   */
+  virtual bool SupportsConcurrentQueries() { return false; }
+
   //@{
   /**
    * Provide an accessor to the bounds. Valid after the locator is built.
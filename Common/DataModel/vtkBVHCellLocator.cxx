@@ -0,0 +1,1336 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBVHCellLocator.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBVHCellLocator.h"
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+vtkStandardNewMacro(vtkBVHCellLocator);
+
+// Nodes with more cells than this are split using threaded binning, and the
+// subtrees with fewer cells are built concurrently (each one serially).
+#define VTK_BVH_SUBTREE_SIZE 16384
+
+// The maximum depth of the tree. Deeper nodes are made leaves; this bounds
+// the size of the traversal stacks.
+#define VTK_BVH_MAX_DEPTH 64
+
+// The number of rays traversing the tree together in IntersectWithLines().
+#define VTK_BVH_PACKET_SIZE 8
+
+// Parametric slack of the ray/box tests, so that the boxes are conservative
+// with respect to round-off.
+#define VTK_BVH_T_TOLERANCE 1.0e-9
+
+//------------------------------------------------------------------------------
+// Helper classes to support efficient computing, and threaded execution.
+//
+// The tree is built top-down. The centroids of the cell bounds are binned
+// along each axis, and the node is split at the bin boundary minimizing the
+// surface area heuristic (SAH), i.e., the sum over both children of their
+// surface area times their number of cells. Nodes are split until they hold
+// at most NumberOfCellsPerNode cells.
+//
+// The build is done in two phases. First the large nodes near the root are
+// split, with the bounds and bins computed in parallel over the cells of the
+// node. This produces a skeleton tree whose leaves are ranges of fewer than
+// VTK_BVH_SUBTREE_SIZE cells. Then the subtrees of these ranges are built in
+// parallel, and everything is spliced together into a single array of nodes
+// in depth-first order. Since the splits only depend on the cells, the tree
+// is the same whatever the number of threads.
+namespace
+{
+
+// A bin of cell centroids along an axis.
+struct vtkBVHBin
+{
+  vtkIdType Count;
+  double Bounds[6];
+};
+
+inline void InitializeBounds(double bounds[6])
+{
+  bounds[0] = bounds[2] = bounds[4] = VTK_DOUBLE_MAX;
+  bounds[1] = bounds[3] = bounds[5] = -VTK_DOUBLE_MAX;
+}
+
+inline void AddBounds(double bounds[6], const double b[6])
+{
+  bounds[0] = std::min(bounds[0], b[0]);
+  bounds[1] = std::max(bounds[1], b[1]);
+  bounds[2] = std::min(bounds[2], b[2]);
+  bounds[3] = std::max(bounds[3], b[3]);
+  bounds[4] = std::min(bounds[4], b[4]);
+  bounds[5] = std::max(bounds[5], b[5]);
+}
+
+// Half of the surface area of a box.
+inline double HalfArea(const double b[6])
+{
+  double dx = b[1] - b[0];
+  double dy = b[3] - b[2];
+  double dz = b[5] - b[4];
+  return (dx * dy + dy * dz + dz * dx);
+}
+
+// Squared distance from a point to a box (zero inside).
+inline double Distance2ToBounds(const double x[3], const double b[6])
+{
+  double d2 = 0.0, d;
+  for (int i = 0; i < 3; ++i)
+  {
+    d = (x[i] < b[2 * i] ? b[2 * i] - x[i] : (x[i] > b[2 * i + 1] ? x[i] - b[2 * i + 1] : 0.0));
+    d2 += d * d;
+  }
+  return d2;
+}
+
+// The cost of a tree according to the surface area heuristic: the areas of
+// the interior nodes plus the areas of the leaves times their number of
+// cells, relative to the area of the root.
+double TreeCost(const std::vector<vtkBVHNode>& nodes)
+{
+  const double rootArea = HalfArea(nodes[0].Bounds);
+  if (rootArea <= 0.0)
+  {
+    return 0.0;
+  }
+  double cost = 0.0;
+  for (const vtkBVHNode& node : nodes)
+  {
+    cost += HalfArea(node.Bounds) * (node.NumberOfCells > 0 ? node.NumberOfCells : 1);
+  }
+  return cost / rootArea;
+}
+
+// Do the boxes overlap?
+inline bool BoundsOverlap(const double a[6], const double b[6])
+{
+  return (a[0] <= b[1] && b[0] <= a[1] && a[2] <= b[3] && b[2] <= a[3] && a[4] <= b[5] &&
+    b[4] <= a[5]);
+}
+
+// The inverse of the direction of a ray. Null components are marked by a
+// zero inverse (see SlabInterval()).
+inline void InverseDirection(const double dir[3], double invDir[3])
+{
+  for (int i = 0; i < 3; ++i)
+  {
+    invDir[i] = (dir[i] != 0.0 ? 1.0 / dir[i] : 0.0);
+  }
+}
+
+// The interval of t where the ray o+t*dir is between the planes b0 and b1
+// along an axis. When the ray is parallel to the planes, the interval is
+// either everything or nothing.
+inline void SlabInterval(double b0, double b1, double o, double inv, double& tA, double& tB)
+{
+  if (inv != 0.0)
+  {
+    tA = (b0 - o) * inv;
+    tB = (b1 - o) * inv;
+  }
+  else
+  {
+    tA = (o >= b0 && o <= b1 ? -VTK_DOUBLE_MAX : VTK_DOUBLE_MAX);
+    tB = VTK_DOUBLE_MAX;
+  }
+}
+
+// Slab test of the ray o+t*dir, 0<=t<=tMax, against a box (optionally
+// enlarged by tol). Returns whether the box is hit, and the entry t.
+inline bool IntersectRayBox(const double b[6], const double o[3], const double invDir[3],
+  double tMax, double tol, double& tNear)
+{
+  double t0 = 0.0, t1 = tMax, tA, tB;
+  for (int i = 0; i < 3; ++i)
+  {
+    SlabInterval(b[2 * i] - tol, b[2 * i + 1] + tol, o[i], invDir[i], tA, tB);
+    t0 = std::max(t0, std::min(tA, tB));
+    t1 = std::min(t1, std::max(tA, tB));
+  }
+  tNear = t0;
+  return (t0 <= t1 + VTK_BVH_T_TOLERANCE);
+}
+
+// Intersect a cell with a line, keeping track of the closest intersection.
+// Equally close intersections are resolved using the cell ids, so that the
+// result does not depend on the traversal order.
+inline void IntersectCell(vtkDataSet* ds, const double* cellBounds, vtkIdType cellId,
+  const double a0[3], const double a1[3], const double invDir[3], double tol,
+  vtkGenericCell* cell, double& tMin, vtkIdType& bestCellId)
+{
+  double tNear, t, x[3], pcoords[3];
+  int subId;
+  if (IntersectRayBox(cellBounds + 6 * cellId, a0, invDir, tMin, 0.0, tNear))
+  {
+    ds->GetCell(cellId, cell);
+    if (cell->IntersectWithLine(a0, a1, tol, t, x, pcoords, subId) &&
+      (t < tMin || (t == tMin && (bestCellId < 0 || cellId < bestCellId))))
+    {
+      tMin = t;
+      bestCellId = cellId;
+    }
+  }
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+// PIMPLd class which builds the tree.
+struct vtkBVHBuilder
+{
+  vtkBVHCellLocator* Locator;
+  const double* CellBounds;
+  std::vector<double> Centroids;
+  vtkIdType* CellIds;
+  int NumberOfBins;
+  vtkIdType MaxCellsPerLeaf;
+
+  vtkBVHBuilder(vtkBVHCellLocator* loc)
+    : Locator(loc)
+    , CellBounds(&loc->CellBounds[0][0])
+    , CellIds(loc->CellIds.data())
+    , NumberOfBins(loc->NumberOfBins)
+    , MaxCellsPerLeaf(loc->NumberOfCellsPerNode)
+  {
+    const vtkIdType numCells = static_cast<vtkIdType>(loc->CellIds.size());
+    this->Centroids.resize(3 * numCells);
+    double* centroids = this->Centroids.data();
+    const double* cellBounds = this->CellBounds;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      for (; cellId < endCellId; ++cellId)
+      {
+        const double* b = cellBounds + 6 * cellId;
+        centroids[3 * cellId] = 0.5 * (b[0] + b[1]);
+        centroids[3 * cellId + 1] = 0.5 * (b[2] + b[3]);
+        centroids[3 * cellId + 2] = 0.5 * (b[4] + b[5]);
+      }
+    });
+  }
+
+  // The bin of a centroid coordinate along an axis.
+  int GetBin(double c, double cmin, double scale) const
+  {
+    int bin = static_cast<int>((c - cmin) * scale);
+    return (bin < 0 ? 0 : (bin >= this->NumberOfBins ? this->NumberOfBins - 1 : bin));
+  }
+
+  // Compute the bounds of the cells, and of their centroids, over a range of
+  // the (ordered) cell ids.
+  void AccumulateBounds(vtkIdType begin, vtkIdType end, double bounds[6], double cbounds[6]) const
+  {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkIdType cellId = this->CellIds[i];
+      const double* c = this->Centroids.data() + 3 * cellId;
+      AddBounds(bounds, this->CellBounds + 6 * cellId);
+      const double cb[6] = { c[0], c[0], c[1], c[1], c[2], c[2] };
+      AddBounds(cbounds, cb);
+    }
+  }
+
+  // Bin the cells along the three axes over a range of the cell ids.
+  void AccumulateBins(vtkIdType begin, vtkIdType end, const double cbounds[6],
+    const double scale[3], vtkBVHBin* bins) const
+  {
+    const int numBins = this->NumberOfBins;
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      const vtkIdType cellId = this->CellIds[i];
+      const double* c = this->Centroids.data() + 3 * cellId;
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        int binId = this->GetBin(c[axis], cbounds[2 * axis], scale[axis]);
+        vtkBVHBin& bin = bins[axis * numBins + binId];
+        bin.Count++;
+        AddBounds(bin.Bounds, this->CellBounds + 6 * cellId);
+      }
+    }
+  }
+
+  // Threaded computation of the bounds of a range of cells.
+  struct BoundsWorker
+  {
+    const vtkBVHBuilder* Builder;
+    vtkSMPThreadLocal<std::vector<double>> TLBounds;
+    double Bounds[6];
+    double CBounds[6];
+
+    BoundsWorker(const vtkBVHBuilder* builder)
+      : Builder(builder)
+    {
+    }
+
+    void Initialize()
+    {
+      std::vector<double>& b = this->TLBounds.Local();
+      b.resize(12);
+      InitializeBounds(b.data());
+      InitializeBounds(b.data() + 6);
+    }
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      std::vector<double>& b = this->TLBounds.Local();
+      this->Builder->AccumulateBounds(begin, end, b.data(), b.data() + 6);
+    }
+
+    void Reduce()
+    {
+      InitializeBounds(this->Bounds);
+      InitializeBounds(this->CBounds);
+      for (auto& b : this->TLBounds)
+      {
+        AddBounds(this->Bounds, b.data());
+        AddBounds(this->CBounds, b.data() + 6);
+      }
+    }
+  };
+
+  // Threaded binning of a range of cells.
+  struct BinsWorker
+  {
+    const vtkBVHBuilder* Builder;
+    const double* CBounds;
+    const double* Scale;
+    vtkSMPThreadLocal<std::vector<vtkBVHBin>> TLBins;
+    std::vector<vtkBVHBin> Bins;
+
+    BinsWorker(const vtkBVHBuilder* builder, const double* cbounds, const double* scale)
+      : Builder(builder)
+      , CBounds(cbounds)
+      , Scale(scale)
+    {
+    }
+
+    void Initialize()
+    {
+      std::vector<vtkBVHBin>& bins = this->TLBins.Local();
+      bins.resize(3 * this->Builder->NumberOfBins);
+      for (auto& bin : bins)
+      {
+        bin.Count = 0;
+        InitializeBounds(bin.Bounds);
+      }
+    }
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      this->Builder->AccumulateBins(
+        begin, end, this->CBounds, this->Scale, this->TLBins.Local().data());
+    }
+
+    void Reduce()
+    {
+      this->Bins.resize(3 * this->Builder->NumberOfBins);
+      for (auto& bin : this->Bins)
+      {
+        bin.Count = 0;
+        InitializeBounds(bin.Bounds);
+      }
+      for (auto& bins : this->TLBins)
+      {
+        for (size_t i = 0; i < bins.size(); ++i)
+        {
+          this->Bins[i].Count += bins[i].Count;
+          AddBounds(this->Bins[i].Bounds, bins[i].Bounds);
+        }
+      }
+    }
+  };
+
+  // Define a node over a range of cell ids, and decide how to split it. The
+  // cell ids are partitioned so that the cells of the first child are in
+  // [begin,mid). Returns false if the node is a leaf.
+  bool MakeNode(vtkIdType begin, vtkIdType end, int depth, bool threaded, vtkBVHNode& node,
+    vtkIdType& mid, std::vector<vtkBVHBin>& bins) const
+  {
+    double cbounds[6];
+    if (threaded)
+    {
+      BoundsWorker worker(this);
+      vtkSMPTools::For(begin, end, worker);
+      std::copy(worker.Bounds, worker.Bounds + 6, node.Bounds);
+      std::copy(worker.CBounds, worker.CBounds + 6, cbounds);
+    }
+    else
+    {
+      InitializeBounds(node.Bounds);
+      InitializeBounds(cbounds);
+      this->AccumulateBounds(begin, end, node.Bounds, cbounds);
+    }
+
+    const vtkIdType numCells = end - begin;
+    if (numCells <= this->MaxCellsPerLeaf || depth >= VTK_BVH_MAX_DEPTH)
+    {
+      node.Offset = begin;
+      node.NumberOfCells = numCells;
+      return false;
+    }
+    node.Offset = -1;
+    node.NumberOfCells = 0;
+
+    // Bin the centroids along the axes where they are not degenerate.
+    const int numBins = this->NumberOfBins;
+    double scale[3];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      double width = cbounds[2 * axis + 1] - cbounds[2 * axis];
+      scale[axis] = (width > 0.0 ? numBins / width : 0.0);
+    }
+    if (threaded)
+    {
+      BinsWorker worker(this, cbounds, scale);
+      vtkSMPTools::For(begin, end, worker);
+      bins.swap(worker.Bins);
+    }
+    else
+    {
+      bins.resize(3 * numBins);
+      for (auto& bin : bins)
+      {
+        bin.Count = 0;
+        InitializeBounds(bin.Bounds);
+      }
+      this->AccumulateBins(begin, end, cbounds, scale, bins.data());
+    }
+
+    // Evaluate the SAH for the split after each bin.
+    int bestAxis = -1, bestBin = 0;
+    double bestCost = VTK_DOUBLE_MAX;
+    std::vector<double> rightCost(numBins);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      if (scale[axis] <= 0.0)
+      {
+        continue;
+      }
+      const vtkBVHBin* axisBins = bins.data() + axis * numBins;
+      double b[6];
+      InitializeBounds(b);
+      vtkIdType count = 0;
+      for (int i = numBins - 1; i > 0; --i)
+      {
+        count += axisBins[i].Count;
+        if (axisBins[i].Count > 0)
+        {
+          AddBounds(b, axisBins[i].Bounds);
+        }
+        rightCost[i] = (count > 0 ? count * HalfArea(b) : -1.0);
+      }
+      InitializeBounds(b);
+      count = 0;
+      for (int i = 1; i < numBins; ++i)
+      {
+        count += axisBins[i - 1].Count;
+        if (axisBins[i - 1].Count > 0)
+        {
+          AddBounds(b, axisBins[i - 1].Bounds);
+        }
+        if (count > 0 && rightCost[i] >= 0.0)
+        {
+          double cost = count * HalfArea(b) + rightCost[i];
+          if (cost < bestCost)
+          {
+            bestCost = cost;
+            bestAxis = axis;
+            bestBin = i;
+          }
+        }
+      }
+    }
+
+    if (bestAxis < 0)
+    {
+      // All centroids coincide, split the cells in two halves.
+      mid = begin + numCells / 2;
+      return true;
+    }
+
+    const double* centroids = this->Centroids.data();
+    const double cmin = cbounds[2 * bestAxis];
+    const double s = scale[bestAxis];
+    vtkIdType* splitIt = std::partition(
+      this->CellIds + begin, this->CellIds + end, [&](vtkIdType cellId) {
+        return this->GetBin(centroids[3 * cellId + bestAxis], cmin, s) < bestBin;
+      });
+    mid = static_cast<vtkIdType>(splitIt - this->CellIds);
+    return true;
+  }
+
+  // A range of cells to be made a node. The parent is set when the node is
+  // the second child of its parent, which then needs to know its index.
+  struct Task
+  {
+    vtkIdType Begin;
+    vtkIdType End;
+    int Depth;
+    vtkIdType Parent;
+  };
+
+  // Serially build the subtree of a range of cells, in depth-first order.
+  // The child offsets are local to the subtree.
+  void BuildSubtree(
+    vtkIdType begin, vtkIdType end, int depth, std::vector<vtkBVHNode>& nodes) const
+  {
+    std::vector<vtkBVHBin> bins;
+    std::vector<Task> stack;
+    stack.push_back(Task{ begin, end, depth, -1 });
+    while (!stack.empty())
+    {
+      Task task = stack.back();
+      stack.pop_back();
+      const vtkIdType nodeId = static_cast<vtkIdType>(nodes.size());
+      if (task.Parent >= 0)
+      {
+        nodes[task.Parent].Offset = nodeId;
+      }
+      vtkBVHNode node;
+      vtkIdType mid;
+      bool split = this->MakeNode(task.Begin, task.End, task.Depth, false, node, mid, bins);
+      nodes.push_back(node);
+      if (split)
+      {
+        stack.push_back(Task{ mid, task.End, task.Depth + 1, nodeId });
+        stack.push_back(Task{ task.Begin, mid, task.Depth + 1, -1 });
+      }
+    }
+  }
+
+  // Build the whole tree into the locator.
+  void Build()
+  {
+    // First split the large nodes. The skeleton nodes refer to subtrees
+    // (when SubtreeIds>=0) or are interior nodes whose offset is the
+    // skeleton index of their second child.
+    const vtkIdType numCells = static_cast<vtkIdType>(this->Locator->CellIds.size());
+    std::vector<vtkBVHNode> skeleton;
+    std::vector<vtkIdType> subtreeIds;
+    std::vector<Task> subtrees;
+    std::vector<vtkBVHBin> bins;
+    std::vector<Task> stack;
+    stack.push_back(Task{ 0, numCells, 0, -1 });
+    while (!stack.empty())
+    {
+      Task task = stack.back();
+      stack.pop_back();
+      const vtkIdType nodeId = static_cast<vtkIdType>(skeleton.size());
+      if (task.Parent >= 0)
+      {
+        skeleton[task.Parent].Offset = nodeId;
+      }
+      vtkBVHNode node;
+      node.Offset = -1;
+      node.NumberOfCells = 0;
+      vtkIdType mid;
+      if (task.End - task.Begin <= VTK_BVH_SUBTREE_SIZE ||
+        task.End - task.Begin <= this->MaxCellsPerLeaf || task.Depth >= VTK_BVH_MAX_DEPTH)
+      {
+        skeleton.push_back(node);
+        subtreeIds.push_back(static_cast<vtkIdType>(subtrees.size()));
+        subtrees.push_back(task);
+      }
+      else
+      {
+        this->MakeNode(task.Begin, task.End, task.Depth, true, node, mid, bins);
+        skeleton.push_back(node);
+        subtreeIds.push_back(-1);
+        stack.push_back(Task{ mid, task.End, task.Depth + 1, nodeId });
+        stack.push_back(Task{ task.Begin, mid, task.Depth + 1, -1 });
+      }
+    }
+
+    // Now build the subtrees in parallel.
+    const vtkIdType numSubtrees = static_cast<vtkIdType>(subtrees.size());
+    std::vector<std::vector<vtkBVHNode>> subtreeNodes(numSubtrees);
+    vtkSMPTools::For(0, numSubtrees, [&](vtkIdType subtreeId, vtkIdType endSubtreeId) {
+      for (; subtreeId < endSubtreeId; ++subtreeId)
+      {
+        const Task& task = subtrees[subtreeId];
+        this->BuildSubtree(task.Begin, task.End, task.Depth, subtreeNodes[subtreeId]);
+      }
+    });
+
+    // Finally splice the skeleton and the subtrees together.
+    const vtkIdType numSkeletonNodes = static_cast<vtkIdType>(skeleton.size());
+    std::vector<vtkIdType> nodeIds(numSkeletonNodes);
+    vtkIdType numNodes = 0;
+    for (vtkIdType i = 0; i < numSkeletonNodes; ++i)
+    {
+      nodeIds[i] = numNodes;
+      numNodes += (subtreeIds[i] < 0 ? 1
+                                     : static_cast<vtkIdType>(subtreeNodes[subtreeIds[i]].size()));
+    }
+    std::vector<vtkBVHNode>& nodes = this->Locator->Nodes;
+    nodes.resize(numNodes);
+    vtkSMPTools::For(0, numSkeletonNodes, [&](vtkIdType i, vtkIdType endI) {
+      for (; i < endI; ++i)
+      {
+        if (subtreeIds[i] < 0)
+        {
+          nodes[nodeIds[i]] = skeleton[i];
+          nodes[nodeIds[i]].Offset = nodeIds[skeleton[i].Offset];
+        }
+        else
+        {
+          const std::vector<vtkBVHNode>& subtree = subtreeNodes[subtreeIds[i]];
+          for (size_t j = 0; j < subtree.size(); ++j)
+          {
+            vtkBVHNode& node = nodes[nodeIds[i] + j];
+            node = subtree[j];
+            if (node.NumberOfCells == 0)
+            {
+              node.Offset += nodeIds[i];
+            }
+          }
+        }
+      }
+    });
+  }
+};
+
+//------------------------------------------------------------------------------
+// PIMPLd class which casts packets of rays (IntersectWithLines()).
+struct vtkBVHRayCaster
+{
+  vtkBVHCellLocator* Locator;
+  vtkPoints* P1s;
+  vtkPoints* P2s;
+  double Tolerance;
+  vtkIdType NumberOfRays;
+  vtkIdType* CellIds;
+  double* Ts;
+  double* Xs;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+
+  vtkBVHRayCaster(vtkBVHCellLocator* loc, vtkPoints* p1s, vtkPoints* p2s, double tol,
+    vtkIdType* cellIds, double* ts, double* xs)
+    : Locator(loc)
+    , P1s(p1s)
+    , P2s(p2s)
+    , Tolerance(tol)
+    , NumberOfRays(p1s->GetNumberOfPoints())
+    , CellIds(cellIds)
+    , Ts(ts)
+    , Xs(xs)
+  {
+  }
+
+  void Initialize() {}
+
+  // Process a range of packets.
+  void operator()(vtkIdType packetId, vtkIdType endPacketId)
+  {
+    const int P = VTK_BVH_PACKET_SIZE;
+    vtkGenericCell* cell = this->Cell.Local();
+    vtkDataSet* ds = this->Locator->DataSet;
+    const double* cellBounds = &this->Locator->CellBounds[0][0];
+    const vtkBVHNode* nodes = this->Locator->Nodes.data();
+    const vtkIdType* cellIds = this->Locator->CellIds.data();
+
+    // The rays of a packet are stored by component so that the box tests
+    // over the packet can be vectorized.
+    double a0[P][3], a1[P][3], invDir[P][3];
+    double o[3][P], inv[3][P], tMin[P];
+    vtkIdType bestCellId[P];
+    unsigned char hit[P];
+    vtkIdType stack[VTK_BVH_MAX_DEPTH + 2];
+
+    for (; packetId < endPacketId; ++packetId)
+    {
+      const vtkIdType firstRay = packetId * P;
+      const int numRays = static_cast<int>(std::min<vtkIdType>(P, this->NumberOfRays - firstRay));
+      for (int l = 0; l < P; ++l)
+      {
+        double dir[3];
+        if (l < numRays)
+        {
+          this->P1s->GetPoint(firstRay + l, a0[l]);
+          this->P2s->GetPoint(firstRay + l, a1[l]);
+          tMin[l] = 1.0;
+        }
+        else
+        {
+          // Inactive lanes never hit anything.
+          a0[l][0] = a0[l][1] = a0[l][2] = 0.0;
+          a1[l][0] = a1[l][1] = a1[l][2] = 0.0;
+          tMin[l] = -1.0;
+        }
+        vtkMath::Subtract(a1[l], a0[l], dir);
+        InverseDirection(dir, invDir[l]);
+        for (int i = 0; i < 3; ++i)
+        {
+          o[i][l] = a0[l][i];
+          inv[i][l] = invDir[l][i];
+        }
+        bestCellId[l] = -1;
+      }
+
+      int top = 0;
+      stack[top++] = 0;
+      while (top > 0)
+      {
+        const vtkBVHNode& node = nodes[stack[--top]];
+        const double* b = node.Bounds;
+
+        // Test the box against all the rays of the packet.
+        int anyHit = 0;
+        for (int l = 0; l < P; ++l)
+        {
+          double t0 = 0.0, t1 = tMin[l];
+          for (int i = 0; i < 3; ++i)
+          {
+            double tA, tB;
+            SlabInterval(b[2 * i], b[2 * i + 1], o[i][l], inv[i][l], tA, tB);
+            t0 = std::max(t0, std::min(tA, tB));
+            t1 = std::min(t1, std::max(tA, tB));
+          }
+          hit[l] = (t0 <= t1 + VTK_BVH_T_TOLERANCE ? 1 : 0);
+          anyHit |= hit[l];
+        }
+        if (!anyHit)
+        {
+          continue;
+        }
+
+        if (node.NumberOfCells > 0)
+        {
+          const vtkIdType* leafCellIds = cellIds + node.Offset;
+          for (int l = 0; l < numRays; ++l)
+          {
+            if (hit[l])
+            {
+              for (vtkIdType i = 0; i < node.NumberOfCells; ++i)
+              {
+                IntersectCell(ds, cellBounds, leafCellIds[i], a0[l], a1[l], invDir[l],
+                  this->Tolerance, cell, tMin[l], bestCellId[l]);
+              }
+            }
+          }
+        }
+        else
+        {
+          // Visit first the child closest to the origin of the first ray.
+          const vtkIdType child0 = (&node - nodes) + 1;
+          const vtkIdType child1 = node.Offset;
+          if (Distance2ToBounds(a0[0], nodes[child0].Bounds) <=
+            Distance2ToBounds(a0[0], nodes[child1].Bounds))
+          {
+            stack[top++] = child1;
+            stack[top++] = child0;
+          }
+          else
+          {
+            stack[top++] = child0;
+            stack[top++] = child1;
+          }
+        }
+      }
+
+      // Recover the intersection information of the closest cells.
+      for (int l = 0; l < numRays; ++l)
+      {
+        const vtkIdType rayId = firstRay + l;
+        this->CellIds[rayId] = bestCellId[l];
+        double t = 0.0, x[3] = { 0.0, 0.0, 0.0 }, pcoords[3];
+        int subId;
+        if (bestCellId[l] >= 0 && (this->Ts || this->Xs))
+        {
+          ds->GetCell(bestCellId[l], cell);
+          cell->IntersectWithLine(a0[l], a1[l], this->Tolerance, t, x, pcoords, subId);
+        }
+        if (this->Ts)
+        {
+          this->Ts[rayId] = (bestCellId[l] >= 0 ? t : VTK_DOUBLE_MAX);
+        }
+        if (this->Xs)
+        {
+          std::copy(x, x + 3, this->Xs + 3 * rayId);
+        }
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+// Here is the VTK class proper.
+
+//------------------------------------------------------------------------------
+vtkBVHCellLocator::vtkBVHCellLocator()
+{
+  this->CacheCellBounds = 1; // always cached
+  this->NumberOfCellsPerNode = 8;
+  this->NumberOfBins = 16;
+  this->RefitOnModified = 0;
+  this->RebuildThreshold = 2.0;
+  this->BuildCost = 0.0;
+}
+
+//------------------------------------------------------------------------------
+vtkBVHCellLocator::~vtkBVHCellLocator()
+{
+  this->FreeSearchStructure();
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FreeSearchStructure()
+{
+  this->FreeCellBounds();
+  std::vector<vtkBVHNode>().swap(this->Nodes);
+  std::vector<vtkIdType>().swap(this->CellIds);
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::BuildLocator()
+{
+  // Do we need to build?
+  if (!this->Nodes.empty() && (this->BuildTime > this->MTime) &&
+    (this->BuildTime > this->DataSet->GetMTime()))
+  {
+    return;
+  }
+
+  vtkDebugMacro(<< "Building BVH cell locator");
+
+  vtkIdType numCells;
+  if (!this->DataSet || (numCells = this->DataSet->GetNumberOfCells()) < 1)
+  {
+    // An empty dataset is valid input: the queries find nothing.
+    vtkDebugMacro(<< "No cells to build");
+    this->FreeSearchStructure();
+    return;
+  }
+
+  // Deforming data sets: try to refit the tree first.
+  if (this->RefitOnModified && this->RefitLocator())
+  {
+    if (TreeCost(this->Nodes) <= this->RebuildThreshold * this->BuildCost)
+    {
+      return;
+    }
+    vtkDebugMacro(<< "Refit tree degraded, rebuilding");
+  }
+
+  this->FreeSearchStructure();
+
+  // The cell bounds are computed in parallel.
+  this->StoreCellBounds();
+
+  this->CellIds.resize(numCells);
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    this->CellIds[cellId] = cellId;
+  }
+
+  vtkBVHBuilder builder(this);
+  builder.Build();
+  this->BuildCost = TreeCost(this->Nodes);
+
+  this->BuildTime.Modified();
+}
+
+//------------------------------------------------------------------------------
+bool vtkBVHCellLocator::RefitLocator()
+{
+  if (this->Nodes.empty() || !this->DataSet ||
+    this->DataSet->GetNumberOfCells() != static_cast<vtkIdType>(this->CellIds.size()))
+  {
+    return false;
+  }
+
+  vtkDebugMacro(<< "Refitting BVH cell locator");
+
+  // The cell bounds, and the bounds of the leaves, are computed in parallel.
+  this->FreeCellBounds();
+  this->StoreCellBounds();
+  vtkBVHNode* nodes = this->Nodes.data();
+  const vtkIdType* cellIds = this->CellIds.data();
+  const double(*cellBounds)[6] = this->CellBounds;
+  const vtkIdType numNodes = static_cast<vtkIdType>(this->Nodes.size());
+  vtkSMPTools::For(
+    0, numNodes, [nodes, cellIds, cellBounds](vtkIdType nodeId, vtkIdType endNodeId) {
+      for (; nodeId < endNodeId; ++nodeId)
+      {
+        vtkBVHNode& node = nodes[nodeId];
+        if (node.NumberOfCells > 0)
+        {
+          InitializeBounds(node.Bounds);
+          for (vtkIdType i = 0; i < node.NumberOfCells; ++i)
+          {
+            AddBounds(node.Bounds, cellBounds[cellIds[node.Offset + i]]);
+          }
+        }
+      }
+    });
+
+  // The children of a node follow it in the array, so the interior nodes
+  // are updated bottom-up by a backward sweep (which is cheap compared to
+  // the leaves).
+  for (vtkIdType nodeId = numNodes - 1; nodeId >= 0; --nodeId)
+  {
+    vtkBVHNode& node = nodes[nodeId];
+    if (node.NumberOfCells == 0)
+    {
+      std::copy(nodes[nodeId + 1].Bounds, nodes[nodeId + 1].Bounds + 6, node.Bounds);
+      AddBounds(node.Bounds, nodes[node.Offset].Bounds);
+    }
+  }
+
+  this->BuildTime.Modified();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+vtkIdType vtkBVHCellLocator::FindCell(
+  double pos[3], double, vtkGenericCell* cell, double pcoords[3], double* weights)
+{
+  this->BuildLocator();
+  if (this->Nodes.empty())
+  {
+    return -1;
+  }
+
+  const double tol = this->Tolerance;
+  double dist2, delta[3] = { tol, tol, tol };
+  int subId;
+  vtkIdType stack[VTK_BVH_MAX_DEPTH + 2];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+  {
+    const vtkBVHNode& node = this->Nodes[stack[--top]];
+    if (!vtkMath::PointIsWithinBounds(pos, const_cast<double*>(node.Bounds), delta))
+    {
+      continue;
+    }
+    if (node.NumberOfCells > 0)
+    {
+      for (vtkIdType i = 0; i < node.NumberOfCells; ++i)
+      {
+        vtkIdType cellId = this->CellIds[node.Offset + i];
+        if (vtkMath::PointIsWithinBounds(pos, this->CellBounds[cellId], delta))
+        {
+          this->DataSet->GetCell(cellId, cell);
+          if (cell->EvaluatePosition(pos, nullptr, subId, pcoords, dist2, weights) == 1)
+          {
+            return cellId;
+          }
+        }
+      }
+    }
+    else
+    {
+      stack[top++] = node.Offset;
+      stack[top++] = (&node - this->Nodes.data()) + 1;
+    }
+  }
+
+  return -1;
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FindClosestPoint(const double x[3], double closestPoint[3],
+  vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2)
+{
+  int inside;
+  double radius = vtkMath::Inf();
+  double point[3] = { x[0], x[1], x[2] };
+  this->FindClosestPointWithinRadius(
+    point, radius, closestPoint, cell, cellId, subId, dist2, inside);
+}
+
+//------------------------------------------------------------------------------
+// Best-first traversal of the tree: the nodes are visited by increasing
+// distance to their bounds, until the closest one is further than the
+// closest point found so far.
+vtkIdType vtkBVHCellLocator::FindClosestPointWithinRadius(double x[3], double radius,
+  double closestPoint[3], vtkGenericCell* cell, vtkIdType& closestCellId, int& closestSubId,
+  double& minDist2, int& inside)
+{
+  this->BuildLocator();
+  if (this->Nodes.empty())
+  {
+    return 0;
+  }
+
+  std::vector<double> weights(6);
+  double pcoords[3], point[3], dist2;
+  int subId;
+  vtkIdType retVal = 0;
+
+  using node = std::pair<double, vtkIdType>;
+  std::priority_queue<node, std::vector<node>, std::greater<node>> queue;
+  queue.push(std::make_pair(Distance2ToBounds(x, this->Nodes[0].Bounds), 0));
+
+  // distance to closest point
+  minDist2 = radius * radius;
+
+  while (!queue.empty())
+  {
+    vtkIdType nodeId = queue.top().second;
+    double nodeDist2 = queue.top().first;
+    queue.pop();
+
+    // stop if bounding box is further away than current closest point
+    if (nodeDist2 > minDist2)
+    {
+      break;
+    }
+
+    const vtkBVHNode& bvhNode = this->Nodes[nodeId];
+    if (bvhNode.NumberOfCells == 0)
+    {
+      vtkIdType children[2] = { nodeId + 1, bvhNode.Offset };
+      for (int i = 0; i < 2; ++i)
+      {
+        double d2 = Distance2ToBounds(x, this->Nodes[children[i]].Bounds);
+        if (d2 <= minDist2)
+        {
+          queue.push(std::make_pair(d2, children[i]));
+        }
+      }
+      continue;
+    }
+
+    for (vtkIdType i = 0; i < bvhNode.NumberOfCells; ++i)
+    {
+      vtkIdType cellId = this->CellIds[bvhNode.Offset + i];
+
+      // compute distance to cell only if distance to bounding box smaller than minDist2
+      if (Distance2ToBounds(x, this->CellBounds[cellId]) < minDist2)
+      {
+        this->DataSet->GetCell(cellId, cell);
+
+        // make sure we have enough storage space for the weights
+        unsigned nPoints = static_cast<unsigned>(cell->GetPointIds()->GetNumberOfIds());
+        if (nPoints > weights.size())
+        {
+          weights.resize(2 * nPoints);
+        }
+
+        // evaluate the position to find the closest point
+        int stat = cell->EvaluatePosition(x, point, subId, pcoords, dist2, weights.data());
+        if (stat != -1 && dist2 < minDist2)
+        {
+          retVal = 1;
+          inside = stat;
+          minDist2 = dist2;
+          closestCellId = cellId;
+          closestSubId = subId;
+          closestPoint[0] = point[0];
+          closestPoint[1] = point[1];
+          closestPoint[2] = point[2];
+        }
+      }
+    }
+  }
+
+  return retVal;
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCellsWithinBounds(double* bbox, vtkIdList* cells)
+{
+  cells->Reset();
+  this->BuildLocator();
+  if (this->Nodes.empty())
+  {
+    return;
+  }
+
+  vtkIdType stack[VTK_BVH_MAX_DEPTH + 2];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+  {
+    const vtkBVHNode& node = this->Nodes[stack[--top]];
+    if (!BoundsOverlap(node.Bounds, bbox))
+    {
+      continue;
+    }
+    if (node.NumberOfCells > 0)
+    {
+      for (vtkIdType i = 0; i < node.NumberOfCells; ++i)
+      {
+        vtkIdType cellId = this->CellIds[node.Offset + i];
+        if (BoundsOverlap(this->CellBounds[cellId], bbox))
+        {
+          cells->InsertNextId(cellId);
+        }
+      }
+    }
+    else
+    {
+      stack[top++] = node.Offset;
+      stack[top++] = (&node - this->Nodes.data()) + 1;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::FindCellsAlongLine(
+  const double p1[3], const double p2[3], double tol, vtkIdList* cells)
+{
+  cells->Reset();
+  this->BuildLocator();
+  if (this->Nodes.empty())
+  {
+    return;
+  }
+
+  double dir[3], invDir[3], tNear;
+  vtkMath::Subtract(p2, p1, dir);
+  InverseDirection(dir, invDir);
+
+  vtkIdType stack[VTK_BVH_MAX_DEPTH + 2];
+  int top = 0;
+  stack[top++] = 0;
+  while (top > 0)
+  {
+    const vtkBVHNode& node = this->Nodes[stack[--top]];
+    if (!IntersectRayBox(node.Bounds, p1, invDir, 1.0, tol, tNear))
+    {
+      continue;
+    }
+    if (node.NumberOfCells > 0)
+    {
+      for (vtkIdType i = 0; i < node.NumberOfCells; ++i)
+      {
+        vtkIdType cellId = this->CellIds[node.Offset + i];
+        if (IntersectRayBox(this->CellBounds[cellId], p1, invDir, 1.0, tol, tNear))
+        {
+          cells->InsertNextId(cellId);
+        }
+      }
+    }
+    else
+    {
+      stack[top++] = node.Offset;
+      stack[top++] = (&node - this->Nodes.data()) + 1;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// The tree is traversed front to back: the children of a node are visited by
+// increasing entry parameter t, and the nodes whose entry t is further than
+// the closest intersection found so far are skipped.
+int vtkBVHCellLocator::IntersectWithLine(const double a0[3], const double a1[3], double tol,
+  double& t, double x[3], double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell)
+{
+  cellId = (-1);
+  subId = 0;
+  this->BuildLocator();
+  if (this->Nodes.empty())
+  {
+    return 0;
+  }
+
+  const double* cellBounds = &this->CellBounds[0][0];
+  const vtkBVHNode* nodes = this->Nodes.data();
+  double dir[3], invDir[3], tNear, tMin = 1.0;
+  vtkMath::Subtract(a1, a0, dir);
+  InverseDirection(dir, invDir);
+  vtkIdType bestCellId = (-1);
+
+  vtkIdType stack[VTK_BVH_MAX_DEPTH + 2];
+  int top = 0;
+  if (IntersectRayBox(nodes[0].Bounds, a0, invDir, tMin, 0.0, tNear))
+  {
+    stack[top++] = 0;
+  }
+  while (top > 0)
+  {
+    const vtkIdType nodeId = stack[--top];
+    const vtkBVHNode& node = nodes[nodeId];
+    if (node.NumberOfCells > 0)
+    {
+      for (vtkIdType i = 0; i < node.NumberOfCells; ++i)
+      {
+        IntersectCell(this->DataSet, cellBounds, this->CellIds[node.Offset + i], a0, a1, invDir,
+          tol, cell, tMin, bestCellId);
+      }
+      continue;
+    }
+
+    double t0, t1;
+    bool hit0 = IntersectRayBox(nodes[nodeId + 1].Bounds, a0, invDir, tMin, 0.0, t0);
+    bool hit1 = IntersectRayBox(nodes[node.Offset].Bounds, a0, invDir, tMin, 0.0, t1);
+    if (hit0 && hit1)
+    {
+      // push the farthest child first
+      if (t0 <= t1)
+      {
+        stack[top++] = node.Offset;
+        stack[top++] = nodeId + 1;
+      }
+      else
+      {
+        stack[top++] = nodeId + 1;
+        stack[top++] = node.Offset;
+      }
+    }
+    else if (hit0)
+    {
+      stack[top++] = nodeId + 1;
+    }
+    else if (hit1)
+    {
+      stack[top++] = node.Offset;
+    }
+  }
+
+  // If a cell has been intersected, recover the information and return.
+  if (bestCellId >= 0)
+  {
+    this->DataSet->GetCell(bestCellId, cell);
+    cell->IntersectWithLine(a0, a1, tol, t, x, pcoords, subId);
+    cellId = bestCellId;
+    return 1;
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::IntersectWithLines(vtkPoints* p1s, vtkPoints* p2s, double tol,
+  vtkIdList* cellIds, vtkDoubleArray* ts, vtkPoints* xs)
+{
+  const vtkIdType numRays = p1s->GetNumberOfPoints();
+  if (p2s->GetNumberOfPoints() != numRays)
+  {
+    vtkErrorMacro(<< "The number of start and end points differ");
+    return;
+  }
+  cellIds->SetNumberOfIds(numRays);
+  if (ts)
+  {
+    ts->SetNumberOfComponents(1);
+    ts->SetNumberOfTuples(numRays);
+  }
+  std::vector<double> xVec(xs ? 3 * numRays : 0);
+
+  this->BuildLocator();
+  if (this->Nodes.empty())
+  {
+    std::fill_n(cellIds->GetPointer(0), numRays, -1);
+    if (ts)
+    {
+      ts->Fill(VTK_DOUBLE_MAX);
+    }
+    if (xs)
+    {
+      xs->SetNumberOfPoints(0);
+    }
+    return;
+  }
+
+  // Dummy call required before multithreaded calls
+  vtkNew<vtkGenericCell> cell;
+  this->DataSet->GetCell(0, cell);
+
+  vtkBVHRayCaster caster(this, p1s, p2s, tol, cellIds->GetPointer(0),
+    ts ? ts->GetPointer(0) : nullptr, xs ? xVec.data() : nullptr);
+  const vtkIdType numPackets = (numRays + VTK_BVH_PACKET_SIZE - 1) / VTK_BVH_PACKET_SIZE;
+  vtkSMPTools::For(0, numPackets, caster);
+
+  if (xs)
+  {
+    xs->SetNumberOfPoints(numRays);
+    for (vtkIdType i = 0; i < numRays; ++i)
+    {
+      xs->SetPoint(i, xVec.data() + 3 * i);
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Produce a polygonal representation of the locator: the boxes of the nodes
+// at the given level (or of the leaves if level < 0, or of the leaves above
+// the given level).
+void vtkBVHCellLocator::GenerateRepresentation(int level, vtkPolyData* pd)
+{
+  this->BuildLocator();
+  if (this->Nodes.empty())
+  {
+    return;
+  }
+
+  vtkNew<vtkPoints> pts;
+  pts->SetDataTypeToFloat();
+  vtkNew<vtkCellArray> polys;
+  pd->SetPoints(pts);
+  pd->SetPolys(polys);
+
+  static const vtkIdType faces[6][4] = { { 0, 2, 3, 1 }, { 4, 5, 7, 6 }, { 0, 1, 5, 4 },
+    { 2, 6, 7, 3 }, { 0, 4, 6, 2 }, { 1, 3, 7, 5 } };
+  std::vector<std::pair<vtkIdType, int>> stack;
+  stack.push_back(std::make_pair(0, 0));
+  while (!stack.empty())
+  {
+    vtkIdType nodeId = stack.back().first;
+    int depth = stack.back().second;
+    stack.pop_back();
+    const vtkBVHNode& node = this->Nodes[nodeId];
+    if ((level >= 0 && depth == level) || node.NumberOfCells > 0)
+    {
+      const double* b = node.Bounds;
+      vtkIdType ptIds[8];
+      for (int i = 0; i < 8; ++i)
+      {
+        ptIds[i] = pts->InsertNextPoint(b[i & 1], b[2 + ((i >> 1) & 1)], b[4 + ((i >> 2) & 1)]);
+      }
+      for (int i = 0; i < 6; ++i)
+      {
+        vtkIdType quad[4] = { ptIds[faces[i][0]], ptIds[faces[i][1]], ptIds[faces[i][2]],
+          ptIds[faces[i][3]] };
+        polys->InsertNextCell(4, quad);
+      }
+      continue;
+    }
+    stack.push_back(std::make_pair(node.Offset, depth + 1));
+    stack.push_back(std::make_pair(nodeId + 1, depth + 1));
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkBVHCellLocator::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number of Bins: " << this->NumberOfBins << "\n";
+  os << indent << "Refit On Modified: " << (this->RefitOnModified ? "On\n" : "Off\n");
+  os << indent << "Rebuild Threshold: " << this->RebuildThreshold << "\n";
+  os << indent << "Number of Nodes: " << this->Nodes.size() << "\n";
+}
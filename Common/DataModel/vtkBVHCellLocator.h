@@ -0,0 +1,288 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkBVHCellLocator.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkBVHCellLocator
+ * @brief   cell locator based on a bounding volume hierarchy
+ *
+ * vtkBVHCellLocator is a type of vtkAbstractCellLocator which organizes the
+ * cells of a dataset into a bounding volume hierarchy (BVH), i.e., a binary
+ * tree of axis-aligned bounding boxes. The tree is built top-down with the
+ * surface area heuristic (SAH): at each node the cells are split along the
+ * axis, and at the position (among a number of bins of cell centroids),
+ * which minimizes the expected cost of a ray traversal. This produces trees
+ * that are well suited to ray casting queries (IntersectWithLine()), also on
+ * meshes with strongly varying cell sizes.
+ *
+ * The build is threaded (via vtkSMPTools): the cell bounds are computed in
+ * parallel, the binning of the large nodes near the root is done in
+ * parallel, and the subtrees below them are then built concurrently. The
+ * nodes are stored in a single flat array in depth-first order (the first
+ * child of a node immediately follows it), so the resulting tree does not
+ * depend on the number of threads.
+ *
+ * In addition to the vtkAbstractCellLocator API, IntersectWithLines() casts
+ * many rays at once. The rays are processed in parallel, by packets of
+ * consecutive rays which traverse the tree together: a node is visited once
+ * for all of the rays of a packet, and the box tests of a packet are
+ * written as loops over the rays which the compiler can vectorize. Packets
+ * are most effective when consecutive rays are coherent (e.g., the rays of
+ * neighboring pixels, or of nearby points in the same direction).
+ *
+ * For deforming meshes, whose points move while their cells stay the same,
+ * the tree can be refitted instead of rebuilt (RefitLocator()): the bounds
+ * of the nodes are recomputed in parallel from the new cell bounds, keeping
+ * the structure of the tree. With RefitOnModified enabled, BuildLocator()
+ * does so automatically, and only rebuilds the tree from scratch when the
+ * refit tree has degraded too much (see RebuildThreshold). This makes it
+ * cheap to reuse the same locator across the time steps of a simulation,
+ * e.g., as the locator of a vtkCellLocatorStrategy in vtkProbeFilter, or as
+ * the cell locator prototype of vtkCellLocatorInterpolatedVelocityField.
+ *
+ * @warning
+ * This class *always* caches cell bounds. Incremental cell insertion is not
+ * supported.
+ *
+ * @warning
+ * The query methods are thread safe once the locator has been built (pass a
+ * different vtkGenericCell to each thread).
+ *
+ * @sa
+ * vtkLocator vtkAbstractCellLocator vtkStaticCellLocator vtkCellLocator
+ * vtkCellTreeLocator vtkModifiedBSPTree vtkOBBTree
+ */
+
+#ifndef vtkBVHCellLocator_h
+#define vtkBVHCellLocator_h
+
+#include "vtkAbstractCellLocator.h"
+#include "vtkCommonDataModelModule.h" // For export macro
+
+#include <vector> // For std::vector
+
+class vtkDoubleArray;
+
+// A node of the tree: the bounds of its cells and, for a leaf, the range of
+// its cells in the locator's cell ids or, for an interior node, the index of
+// its second child (the first child is the next node).
+struct vtkBVHNode
+{
+  double Bounds[6];
+  vtkIdType Offset;
+  vtkIdType NumberOfCells; // 0 for interior nodes
+};
+
+// Forward declarations for PIMPL
+struct vtkBVHBuilder;
+struct vtkBVHRayCaster;
+
+class VTKCOMMONDATAMODEL_EXPORT vtkBVHCellLocator : public vtkAbstractCellLocator
+{
+  friend struct vtkBVHBuilder;
+  friend struct vtkBVHRayCaster;
+
+public:
+  //@{
+  /**
+   * Standard methods to instantiate, print and obtain type-related information.
+   */
+  static vtkBVHCellLocator* New();
+  vtkTypeMacro(vtkBVHCellLocator, vtkAbstractCellLocator);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  //@{
+  /**
+   * Specify the number of bins used to evaluate the surface area heuristic
+   * along each axis when splitting a node. More bins produce slightly better
+   * trees at a higher build cost. Default is 16.
+   */
+  vtkSetClampMacro(NumberOfBins, int, 2, 256);
+  vtkGetMacro(NumberOfBins, int);
+  //@}
+
+  //@{
+  /**
+   * When enabled, BuildLocator() refits the existing tree (see
+   * RefitLocator()) instead of rebuilding it when the data set or the
+   * locator has been modified, as long as the number of cells has not
+   * changed. The cells are then assumed to be the same as when the tree was
+   * built, only their points may have moved. Changes to NumberOfBins or
+   * NumberOfCellsPerNode are ignored until the tree is rebuilt. Default is
+   * off.
+   */
+  vtkSetMacro(RefitOnModified, vtkTypeBool);
+  vtkGetMacro(RefitOnModified, vtkTypeBool);
+  vtkBooleanMacro(RefitOnModified, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * When RefitOnModified is enabled, the tree is rebuilt from scratch if,
+   * after a refit, its cost (the surface area heuristic of the tree,
+   * relative to the area of its root) exceeds RebuildThreshold times its
+   * cost when it was built. Default is 2.
+   */
+  vtkSetClampMacro(RebuildThreshold, double, 1.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(RebuildThreshold, double);
+  //@}
+
+  /**
+   * Recompute the cell bounds and the bounds of the nodes of the tree from
+   * the current points of the data set, in parallel, keeping the structure
+   * of the tree. The cells of the data set must be the ones the tree was
+   * built with. Returns false (and does nothing) if the tree has not been
+   * built or if the number of cells has changed. Note that the tree is
+   * never rebuilt by this method, whatever its quality.
+   */
+  bool RefitLocator();
+
+  using vtkAbstractCellLocator::FindClosestPoint;
+  using vtkAbstractCellLocator::FindClosestPointWithinRadius;
+
+  /**
+   * Test a point to find if it is inside a cell. Returns the cellId if inside
+   * or -1 if not.
+   */
+  vtkIdType FindCell(double pos[3], double tol2, vtkGenericCell* cell, double pcoords[3],
+    double* weights) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  vtkIdType FindCell(double x[3]) override { return this->Superclass::FindCell(x); }
+
+  /**
+   * Return a list of unique cell ids whose bounds intersect the given
+   * bounding box. The user must provide the vtkIdList to populate.
+   */
+  void FindCellsWithinBounds(double* bbox, vtkIdList* cells) override;
+
+  /**
+   * Given a finite line defined by the two points (p1,p2), return the list
+   * of unique cell ids whose bounds (enlarged by the tolerance) are
+   * intersected by the line. The user must provide the vtkIdList cell list
+   * to populate.
+   */
+  void FindCellsAlongLine(
+    const double p1[3], const double p2[3], double tolerance, vtkIdList* cells) override;
+
+  /**
+   * Return the closest point and the cell which is closest to the point x.
+   * The closest point is somewhere on a cell, it need not be one of the
+   * vertices of the cell. If a cell is found, "cell" contains the points
+   * and ptIds for the cell "cellId" upon exit.
+   */
+  void FindClosestPoint(const double x[3], double closestPoint[3], vtkGenericCell* cell,
+    vtkIdType& cellId, int& subId, double& dist2) override;
+
+  /**
+   * Return the closest point within a specified radius and the cell which is
+   * closest to the point x. The closest point is somewhere on a cell, it
+   * need not be one of the vertices of the cell. This method returns 1 if a
+   * point is found within the specified radius. If there are no cells within
+   * the specified radius, the method returns 0 and the values of
+   * closestPoint, cellId, subId, and dist2 are undefined. If a closest point
+   * is found, inside returns the return value of the EvaluatePosition call
+   * to the closest cell; inside(=1) or outside(=0).
+   */
+  vtkIdType FindClosestPointWithinRadius(double x[3], double radius, double closestPoint[3],
+    vtkGenericCell* cell, vtkIdType& cellId, int& subId, double& dist2, int& inside) override;
+
+  /**
+   * Return intersection point (if any) AND the cell which was intersected by
+   * the finite line. The cell is returned as a cell id and as a generic cell.
+   * The intersection closest to a0 is returned.
+   */
+  int IntersectWithLine(const double a0[3], const double a1[3], double tol, double& t, double x[3],
+    double pcoords[3], int& subId, vtkIdType& cellId, vtkGenericCell* cell) override;
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int& subId) override
+  {
+    return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords, subId);
+  }
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  int IntersectWithLine(const double p1[3], const double p2[3], double tol, double& t, double x[3],
+    double pcoords[3], int& subId, vtkIdType& cellId) override
+  {
+    return this->Superclass::IntersectWithLine(p1, p2, tol, t, x, pcoords, subId, cellId);
+  }
+
+  /**
+   * Reimplemented from vtkAbstractCellLocator to support bad compilers.
+   */
+  int IntersectWithLine(
+    const double p1[3], const double p2[3], vtkPoints* points, vtkIdList* cellIds) override
+  {
+    return this->Superclass::IntersectWithLine(p1, p2, points, cellIds);
+  }
+
+  /**
+   * Intersect many finite lines (p1s[i],p2s[i]) with the cells, in
+   * parallel. For each line, the id of the closest intersected cell (or -1
+   * if the line does not intersect any cell) is returned in cellIds. The
+   * parametric coordinate along the line and the intersection point are
+   * returned in ts and xs when they are non-null. The results are the same as
+   * the ones obtained by calling IntersectWithLine() for each line.
+   */
+  void IntersectWithLines(vtkPoints* p1s, vtkPoints* p2s, double tol, vtkIdList* cellIds,
+    vtkDoubleArray* ts = nullptr, vtkPoints* xs = nullptr);
+
+  //@{
+  /**
+   * Satisfy vtkLocator abstract interface. GenerateRepresentation() produces
+   * the boxes of the nodes of the given level of the tree (or of the leaves
+   * if level < 0).
+   */
+  void GenerateRepresentation(int level, vtkPolyData* pd) override;
+  void FreeSearchStructure() override;
+  void BuildLocator() override;
+  //@}
+
+  /**
+   * Return the number of nodes of the tree. This only has meaning after the
+   * locator has been built.
+   */
+  vtkIdType GetNumberOfNodes() { return static_cast<vtkIdType>(this->Nodes.size()); }
+
+protected:
+  vtkBVHCellLocator();
+  ~vtkBVHCellLocator() override;
+
+  int NumberOfBins;
+  vtkTypeBool RefitOnModified;
+  double RebuildThreshold;
+
+  // The cost of the tree when it was last built from scratch.
+  double BuildCost;
+
+  // The flattened tree. Node 0 is the root.
+  std::vector<vtkBVHNode> Nodes;
+
+  // The cell ids, ordered such that the cells of each leaf are contiguous.
+  std::vector<vtkIdType> CellIds;
+
+private:
+  vtkBVHCellLocator(const vtkBVHCellLocator&) = delete;
+  void operator=(const vtkBVHCellLocator&) = delete;
+};
+
+#endif
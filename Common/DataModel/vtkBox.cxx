@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkBox.h"
 #include "vtkBoundingBox.h"
+#include "vtkImplicitFunctionBatch.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
@@ -25,6 +26,86 @@
 
 vtkStandardNewMacro(vtkBox);
 
+namespace
+{
+// The box equation, shared by the single point and the batch evaluations.
+struct BoxEvaluator
+{
+  double MinPoint[3];
+  double MaxPoint[3];
+
+  BoxEvaluator(const vtkBoundingBox* bbox)
+  {
+    bbox->GetMinPoint(this->MinPoint);
+    bbox->GetMaxPoint(this->MaxPoint);
+  }
+
+  double operator()(const double x[3]) const
+  {
+    double diff, dist, minDistance = (-VTK_DOUBLE_MAX), t, distance = 0.0;
+    int inside = 1;
+    const double* minP = this->MinPoint;
+    const double* maxP = this->MaxPoint;
+
+    for (int i = 0; i < 3; i++)
+    {
+      diff = maxP[i] - minP[i];
+      if (diff != 0.0)
+      {
+        t = (x[i] - minP[i]) / diff;
+        if (t < 0.0)
+        {
+          inside = 0;
+          dist = minP[i] - x[i];
+        }
+        else if (t > 1.0)
+        {
+          inside = 0;
+          dist = x[i] - maxP[i];
+        }
+        else
+        { // want negative distance, we are inside
+          if (t <= 0.5)
+          {
+            dist = minP[i] - x[i];
+          }
+          else
+          {
+            dist = x[i] - maxP[i];
+          }
+          if (dist > minDistance) // remember, it's negative
+          {
+            minDistance = dist;
+          }
+        } // if inside
+      }
+      else
+      {
+        dist = fabs(x[i] - minP[i]);
+        if (dist > 0.0)
+        {
+          inside = 0;
+        }
+      }
+      if (dist > 0.0)
+      {
+        distance += dist * dist;
+      }
+    } // for all coordinate directions
+
+    distance = sqrt(distance);
+    if (inside)
+    {
+      return minDistance;
+    }
+    else
+    {
+      return distance;
+    }
+  }
+};
+} // anonymous namespace
+
 // Construct the box centered at the origin and each side length 1.0.
 //------------------------------------------------------------------------------
 vtkBox::vtkBox()
@@ -125,66 +206,21 @@ void vtkBox::AddBounds(const double bounds[6])
 // (with six planes) because of the "rounded" nature of the corners.
 double vtkBox::EvaluateFunction(double x[3])
 {
-  double diff, dist, minDistance = (-VTK_DOUBLE_MAX), t, distance = 0.0;
-  int inside = 1;
-  const double* minP = this->BBox->GetMinPoint();
-  const double* maxP = this->BBox->GetMaxPoint();
-
-  for (int i = 0; i < 3; i++)
-  {
-    diff = this->BBox->GetLength(i);
-    if (diff != 0.0)
-    {
-      t = (x[i] - minP[i]) / diff;
-      if (t < 0.0)
-      {
-        inside = 0;
-        dist = minP[i] - x[i];
-      }
-      else if (t > 1.0)
-      {
-        inside = 0;
-        dist = x[i] - maxP[i];
-      }
-      else
-      { // want negative distance, we are inside
-        if (t <= 0.5)
-        {
-          dist = minP[i] - x[i];
-        }
-        else
-        {
-          dist = x[i] - maxP[i];
-        }
-        if (dist > minDistance) // remember, it's negative
-        {
-          minDistance = dist;
-        }
-      } // if inside
-    }
-    else
-    {
-      dist = fabs(x[i] - minP[i]);
-      if (dist > 0.0)
-      {
-        inside = 0;
-      }
-    }
-    if (dist > 0.0)
-    {
-      distance += dist * dist;
-    }
-  } // for all coordinate directions
+  const BoxEvaluator eval(this->BBox);
+  return eval(x);
+}
 
-  distance = sqrt(distance);
-  if (inside)
-  {
-    return minDistance;
-  }
-  else
+//------------------------------------------------------------------------------
+// Evaluate the box equation for an array of points, in parallel.
+void vtkBox::EvaluateFunction(vtkDataArray* input, vtkDataArray* output)
+{
+  if (!vtkImplicitFunctionBatch::IsExactly(this))
   {
-    return distance;
+    this->Superclass::EvaluateFunction(input, output);
+    return;
   }
+  const BoxEvaluator eval(this->BBox);
+  vtkImplicitFunctionBatch::Evaluate(eval, input, output);
 }
 
 //------------------------------------------------------------------------------
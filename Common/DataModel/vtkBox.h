@@ -46,11 +46,14 @@ public:
    */
   static vtkBox* New();
 
+  //@{
   /**
    * Evaluate box defined by the two points (pMin,pMax).
    */
   using vtkImplicitFunction::EvaluateFunction;
+  void EvaluateFunction(vtkDataArray* input, vtkDataArray* output) override;
   double EvaluateFunction(double x[3]) override;
+  //@}
 
   /**
    * Evaluate the gradient of the box.
@@ -112,6 +112,25 @@ int vtkCellLocatorStrategy::Initialize(vtkPointSet* ps)
   return 1;
 }
 
+//------------------------------------------------------------------------------
+void vtkCellLocatorStrategy::CopyParameters(vtkFindCellStrategy* from)
+{
+  this->Superclass::CopyParameters(from);
+
+  vtkCellLocatorStrategy* strategy = vtkCellLocatorStrategy::SafeDownCast(from);
+  if (strategy != nullptr)
+  {
+    if (this->CellLocator != nullptr && this->OwnsLocator)
+    {
+      this->CellLocator->Delete();
+    }
+    // The locator is borrowed from the other strategy, which is initialized.
+    this->CellLocator = strategy->CellLocator;
+    this->OwnsLocator = false;
+    this->InitializeTime.Modified();
+  }
+}
+
 //------------------------------------------------------------------------------
 vtkIdType vtkCellLocatorStrategy::FindCell(double x[3], vtkCell* cell, vtkGenericCell* gencell,
   vtkIdType cellId, double tol2, int& subId, double pcoords[3], double* weights)
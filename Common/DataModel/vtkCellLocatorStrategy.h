@@ -61,6 +61,12 @@ public:
   vtkIdType FindCell(double x[3], vtkCell* cell, vtkGenericCell* gencell, vtkIdType cellId,
     double tol2, int& subId, double pcoords[3], double* weights) override;
 
+  /**
+   * Share the cell locator of another vtkCellLocatorStrategy (see superclass
+   * for more information).
+   */
+  void CopyParameters(vtkFindCellStrategy* from) override;
+
   //@{
   /**
    * Set / get an instance of vtkAbstractCellLocator which is used to
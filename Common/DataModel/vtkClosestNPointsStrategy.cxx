@@ -36,6 +36,18 @@ vtkClosestNPointsStrategy::vtkClosestNPointsStrategy()
 //------------------------------------------------------------------------------
 vtkClosestNPointsStrategy::~vtkClosestNPointsStrategy() = default;
 
+//------------------------------------------------------------------------------
+void vtkClosestNPointsStrategy::CopyParameters(vtkFindCellStrategy* from)
+{
+  vtkClosestNPointsStrategy* strategy = vtkClosestNPointsStrategy::SafeDownCast(from);
+  if (strategy != nullptr)
+  {
+    this->ClosestNPoints = strategy->ClosestNPoints;
+  }
+
+  this->Superclass::CopyParameters(from);
+}
+
 //------------------------------------------------------------------------------
 vtkIdType vtkClosestNPointsStrategy::FindCell(double x[3], vtkCell* cell, vtkGenericCell* gencell,
   vtkIdType cellId, double tol2, int& subId, double pcoords[3], double* weights)
@@ -57,6 +57,12 @@ public:
   vtkIdType FindCell(double x[3], vtkCell* cell, vtkGenericCell* gencell, vtkIdType cellId,
     double tol2, int& subId, double pcoords[3], double* weights) override;
 
+  /**
+   * Copy the number of closest points, and share the point locator, of
+   * another strategy (see superclass for more information).
+   */
+  void CopyParameters(vtkFindCellStrategy* from) override;
+
   //@{
   /**
    * Set / get the value for the N closest points.
@@ -202,6 +202,25 @@ vtkIdType FindCellWalk(vtkClosestPointStrategy* self, vtkPointSet* ps, double x[
 
 } // anonymous namespace
 
+//------------------------------------------------------------------------------
+void vtkClosestPointStrategy::CopyParameters(vtkFindCellStrategy* from)
+{
+  this->Superclass::CopyParameters(from);
+
+  vtkClosestPointStrategy* strategy = vtkClosestPointStrategy::SafeDownCast(from);
+  if (strategy != nullptr)
+  {
+    if (this->PointLocator != nullptr && this->OwnsLocator)
+    {
+      this->PointLocator->Delete();
+    }
+    // The locator is borrowed from the other strategy, which is initialized.
+    this->PointLocator = strategy->PointLocator;
+    this->OwnsLocator = false;
+    this->InitializeTime.Modified();
+  }
+}
+
 //------------------------------------------------------------------------------
 vtkIdType vtkClosestPointStrategy::FindCell(double x[3], vtkCell* cell, vtkGenericCell* gencell,
   vtkIdType cellId, double tol2, int& subId, double pcoords[3], double* weights)
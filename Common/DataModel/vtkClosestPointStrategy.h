@@ -74,6 +74,12 @@ public:
   vtkIdType FindCell(double x[3], vtkCell* cell, vtkGenericCell* gencell, vtkIdType cellId,
     double tol2, int& subId, double pcoords[3], double* weights) override;
 
+  /**
+   * Share the point locator of another vtkClosestPointStrategy (see
+   * superclass for more information).
+   */
+  void CopyParameters(vtkFindCellStrategy* from) override;
+
   //@{
   /**
    * Set / get an instance of vtkAbstractPointLocator which is used to
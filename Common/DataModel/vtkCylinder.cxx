@@ -13,11 +13,39 @@
 
 =========================================================================*/
 #include "vtkCylinder.h"
+#include "vtkImplicitFunctionBatch.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 
 vtkStandardNewMacro(vtkCylinder);
 
+namespace
+{
+// The cylinder equation, shared by the single point and the batch evaluations.
+struct CylinderEvaluator
+{
+  double Center[3];
+  double Axis[3];
+  double Radius;
+
+  double operator()(const double x[3]) const
+  {
+    // Determine distance^2 of point to axis. Note that cylinder Axis is
+    // always normalized and always non-zero.
+    double x2C[3];
+    x2C[0] = x[0] - this->Center[0];
+    x2C[1] = x[1] - this->Center[1];
+    x2C[2] = x[2] - this->Center[2];
+
+    // projection onto cylinder axis
+    double proj = vtkMath::Dot(this->Axis, x2C);
+
+    // return distance^2 - R^2
+    return ((vtkMath::Dot(x2C, x2C) - proj * proj) - this->Radius * this->Radius);
+  }
+};
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 // Construct cylinder radius of 0.5.
 vtkCylinder::vtkCylinder()
@@ -34,18 +62,23 @@ vtkCylinder::vtkCylinder()
 // basically a distance to line computation, compared to the cylinder radius.
 double vtkCylinder::EvaluateFunction(double x[3])
 {
-  // Determine distance^2 of point to axis. Note that cylinder Axis is
-  // always normalized and always non-zero.
-  double x2C[3];
-  x2C[0] = x[0] - this->Center[0];
-  x2C[1] = x[1] - this->Center[1];
-  x2C[2] = x[2] - this->Center[2];
-
-  // projection onto cylinder axis
-  double proj = vtkMath::Dot(this->Axis, x2C);
-
-  // return distance^2 - R^2
-  return ((vtkMath::Dot(x2C, x2C) - proj * proj) - this->Radius * this->Radius);
+  const CylinderEvaluator eval = { { this->Center[0], this->Center[1], this->Center[2] },
+    { this->Axis[0], this->Axis[1], this->Axis[2] }, this->Radius };
+  return eval(x);
+}
+
+//------------------------------------------------------------------------------
+// Evaluate the cylinder equation for an array of points, in parallel.
+void vtkCylinder::EvaluateFunction(vtkDataArray* input, vtkDataArray* output)
+{
+  if (!vtkImplicitFunctionBatch::IsExactly(this))
+  {
+    this->Superclass::EvaluateFunction(input, output);
+    return;
+  }
+  const CylinderEvaluator eval = { { this->Center[0], this->Center[1], this->Center[2] },
+    { this->Axis[0], this->Axis[1], this->Axis[2] }, this->Radius };
+  vtkImplicitFunctionBatch::Evaluate(eval, input, output);
 }
 
 //------------------------------------------------------------------------------
@@ -17,6 +17,8 @@
 #include "vtkLogger.h"
 #include "vtkPointSet.h"
 
+#include <algorithm>
+
 //------------------------------------------------------------------------------
 vtkFindCellStrategy::vtkFindCellStrategy()
 {
@@ -51,6 +53,13 @@ int vtkFindCellStrategy::Initialize(vtkPointSet* ps)
   }
 }
 
+//------------------------------------------------------------------------------
+void vtkFindCellStrategy::CopyParameters(vtkFindCellStrategy* from)
+{
+  this->PointSet = from->PointSet;
+  std::copy(from->Bounds, from->Bounds + 6, this->Bounds);
+}
+
 //------------------------------------------------------------------------------
 void vtkFindCellStrategy::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -74,6 +74,17 @@ public:
   virtual vtkIdType FindCell(double x[3], vtkCell* cell, vtkGenericCell* gencell, vtkIdType cellId,
     double tol2, int& subId, double pcoords[3], double* weights) = 0;
 
+  /**
+   * Copy the parameters of another, already initialized strategy (typically
+   * of the same type) so that this strategy can be used in its place. The
+   * locators set up by the other strategy are shared, not rebuilt, so the
+   * other strategy must outlive this one. This is used to give each thread
+   * its own strategy instance, since FindCell() may use internal scratch
+   * storage. Subclasses with parameters or locators of their own must
+   * extend this method.
+   */
+  virtual void CopyParameters(vtkFindCellStrategy* from);
+
 protected:
   vtkFindCellStrategy();
   ~vtkFindCellStrategy() override;
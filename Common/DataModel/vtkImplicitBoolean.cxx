@@ -14,10 +14,15 @@
 =========================================================================*/
 #include "vtkImplicitBoolean.h"
 
+#include "vtkDoubleArray.h"
+#include "vtkImplicitFunctionBatch.h"
 #include "vtkImplicitFunctionCollection.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkImplicitBoolean);
 
@@ -146,6 +151,81 @@ double vtkImplicitBoolean::EvaluateFunction(double x[3])
   return value;
 }
 
+// Evaluate boolean combinations of implicit function for an array of points.
+// Each function is evaluated for all of the points (with its own batch
+// evaluation), and its values are combined, in parallel, with the values of
+// the previous functions. The combinations are done in the same order as in
+// EvaluateFunction(x), which gives the same results.
+void vtkImplicitBoolean::EvaluateFunction(vtkDataArray* input, vtkDataArray* output)
+{
+  if (!vtkImplicitFunctionBatch::IsExactly(this))
+  {
+    this->Superclass::EvaluateFunction(input, output);
+    return;
+  }
+  const vtkIdType numPts = input->GetNumberOfTuples();
+  const int opType = this->OperationType;
+  std::vector<double> values(numPts, 0.0);
+  double* value = values.data();
+
+  if (this->FunctionList->GetNumberOfItems() > 0)
+  {
+    const double init = (opType == VTK_INTERSECTION ? -VTK_DOUBLE_MAX : VTK_DOUBLE_MAX);
+    std::fill(values.begin(), values.end(), init);
+  }
+
+  vtkNew<vtkDoubleArray> fValues;
+  fValues->SetNumberOfTuples(numPts);
+  vtkImplicitFunction* f;
+  vtkImplicitFunction* firstF = nullptr;
+  vtkCollectionSimpleIterator sit;
+  bool first = true;
+  for (this->FunctionList->InitTraversal(sit);
+       (f = this->FunctionList->GetNextImplicitFunction(sit)); first = false)
+  {
+    if (first)
+    {
+      firstF = f;
+    }
+    else if (opType == VTK_DIFFERENCE && f == firstF)
+    { // the first function is not subtracted from itself
+      continue;
+    }
+    f->FunctionValue(input, fValues);
+    const double* v = fValues->GetPointer(0);
+    vtkSMPTools::For(0, numPts, [value, v, opType, first](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        double fv = v[ptId];
+        if (opType == VTK_UNION)
+        { // take minimum value
+          value[ptId] = (fv < value[ptId] ? fv : value[ptId]);
+        }
+        else if (opType == VTK_INTERSECTION)
+        { // take maximum value
+          value[ptId] = (fv > value[ptId] ? fv : value[ptId]);
+        }
+        else if (opType == VTK_UNION_OF_MAGNITUDES)
+        { // take minimum absolute value
+          fv = fabs(fv);
+          value[ptId] = (fv < value[ptId] ? fv : value[ptId]);
+        }
+        else if (first)
+        { // difference: start with the first function
+          value[ptId] = fv;
+        }
+        else
+        { // difference: subtract the other ones
+          fv = (-1.0) * fv;
+          value[ptId] = (fv > value[ptId] ? fv : value[ptId]);
+        }
+      }
+    });
+  }
+
+  vtkImplicitFunctionBatch::Store(value, numPts, output);
+}
+
 // Evaluate gradient of boolean combination.
 void vtkImplicitBoolean::EvaluateGradient(double x[3], double g[3])
 {
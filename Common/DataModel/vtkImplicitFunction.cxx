@@ -17,13 +17,24 @@
 #include "vtkAbstractTransform.h"
 #include "vtkArrayDispatch.h"
 #include "vtkDataArrayRange.h"
+#include "vtkDataSet.h"
+#include "vtkDoubleArray.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPointSet.h"
+#include "vtkPoints.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkTransform.h"
 
 #include <algorithm>
 
 vtkCxxSetObjectMacro(vtkImplicitFunction, Transform, vtkAbstractTransform);
 
+// The number of points of a data set without explicit points which are
+// evaluated at once by FunctionValue(vtkDataSet*, vtkDataArray*).
+#define VTK_IMPLICIT_FUNCTION_BLOCK_SIZE 65536
+
 vtkImplicitFunction::vtkImplicitFunction()
 {
   this->Transform = nullptr;
@@ -83,25 +94,6 @@ private:
   vtkImplicitFunction* Function;
 };
 
-class TransformFunction
-{
-public:
-  TransformFunction(vtkImplicitFunction* function, vtkAbstractTransform* transform)
-    : Function(function)
-    , Transform(transform)
-  {
-  }
-  double operator()(double in[3])
-  {
-    Transform->TransformPoint(in, in);
-    return this->Function->EvaluateFunction(in);
-  }
-
-private:
-  vtkImplicitFunction* Function;
-  vtkAbstractTransform* Transform;
-};
-
 } // end anon namespace
 
 void vtkImplicitFunction::FunctionValue(vtkDataArray* input, vtkDataArray* output)
@@ -110,16 +102,17 @@ void vtkImplicitFunction::FunctionValue(vtkDataArray* input, vtkDataArray* outpu
   {
     this->EvaluateFunction(input, output);
   }
-  else // pass point through transform
+  else // pass points through transform
   {
-    FunctionWorker<TransformFunction> worker(TransformFunction(this, this->Transform));
-    typedef vtkTypeList::Create<float, double> InputTypes;
-    typedef vtkTypeList::Create<float, double> OutputTypes;
-    typedef vtkArrayDispatch::Dispatch2ByValueType<InputTypes, OutputTypes> MyDispatch;
-    if (!MyDispatch::Execute(input, output, worker))
-    {
-      worker(input, output); // Use vtkDataArray API if dispatch fails.
-    }
+    // The points are transformed all at once (in parallel for linear
+    // transforms), so that the batch evaluation of the subclasses is used
+    // for the transformed points as well.
+    vtkNew<vtkPoints> inPts;
+    inPts->SetData(input);
+    vtkNew<vtkPoints> outPts;
+    outPts->SetDataTypeToDouble();
+    this->Transform->TransformPoints(inPts, outPts);
+    this->EvaluateFunction(outPts->GetData(), output);
   }
 }
 
@@ -140,6 +133,47 @@ void vtkImplicitFunction::EvaluateFunction(vtkDataArray* input, vtkDataArray* ou
   }
 }
 
+// Evaluate function at the points of a data set.
+void vtkImplicitFunction::FunctionValue(vtkDataSet* input, vtkDataArray* output)
+{
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  output->SetNumberOfComponents(1);
+  output->SetNumberOfTuples(numPts);
+  vtkPointSet* pointSet = vtkPointSet::SafeDownCast(input);
+  if (pointSet && pointSet->GetPoints())
+  {
+    this->FunctionValue(pointSet->GetPoints()->GetData(), output);
+    return;
+  }
+  if (numPts < 1)
+  {
+    return;
+  }
+
+  // The points are generated (in parallel) by blocks, to bound the memory
+  // used by their coordinates.
+  double x[3];
+  input->GetPoint(0, x); // thread safety: initialize the data set
+  vtkNew<vtkDoubleArray> blockPts;
+  blockPts->SetNumberOfComponents(3);
+  vtkSmartPointer<vtkDataArray> blockValues = vtk::TakeSmartPointer(output->NewInstance());
+  for (vtkIdType begin = 0; begin < numPts; begin += VTK_IMPLICIT_FUNCTION_BLOCK_SIZE)
+  {
+    const vtkIdType end = std::min(begin + VTK_IMPLICIT_FUNCTION_BLOCK_SIZE, numPts);
+    blockPts->SetNumberOfTuples(end - begin);
+    double* pts = blockPts->GetPointer(0);
+    vtkSMPTools::For(begin, end, [input, pts, begin](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        input->GetPoint(ptId, pts + 3 * (ptId - begin));
+      }
+    });
+    blockValues->SetNumberOfTuples(end - begin);
+    this->FunctionValue(blockPts, blockValues);
+    output->InsertTuples(begin, end - begin, 0, blockValues);
+  }
+}
+
 // Evaluate function at position x-y-z and return value. Point x[3] is
 // transformed through transform (if provided).
 double vtkImplicitFunction::FunctionValue(const double x[3])
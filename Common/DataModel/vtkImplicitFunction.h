@@ -54,6 +54,7 @@
 #include "vtkObject.h"
 
 class vtkDataArray;
+class vtkDataSet;
 
 class vtkAbstractTransform;
 
@@ -72,7 +73,10 @@ public:
   //@{
   /**
    * Evaluate function at position x-y-z and return value. Point x[3] is
-   * transformed through transform (if provided).
+   * transformed through transform (if provided). The array version
+   * evaluates the function for each tuple of input (which must have three
+   * components), and should be preferred when evaluating many points: see
+   * EvaluateFunction().
    */
   virtual void FunctionValue(vtkDataArray* input, vtkDataArray* output);
   double FunctionValue(const double x[3]);
@@ -83,6 +87,15 @@ public:
   }
   //@}
 
+  /**
+   * Evaluate the function at each point of a data set, and store the values
+   * in output (which is resized to a single component and as many tuples as
+   * there are points). For a vtkPointSet the points array is evaluated with
+   * FunctionValue(input, output); the points of other data sets (e.g.,
+   * vtkImageData) are evaluated by blocks.
+   */
+  void FunctionValue(vtkDataSet* input, vtkDataArray* output);
+
   //@{
   /**
    * Evaluate function gradient at position x-y-z and pass back vector. Point
@@ -116,7 +129,13 @@ public:
    * Evaluate function at position x-y-z and return value.  You should
    * generally not call this method directly, you should use
    * FunctionValue() instead.  This method must be implemented by
-   * any derived class.
+   * any derived class. The array version calls EvaluateFunction(x) for
+   * each point; derived classes may override it with a faster evaluation
+   * (vtkPlane, vtkSphere, vtkBox, vtkCylinder, vtkQuadric, vtkImplicitBoolean
+   * and vtkImplicitSum evaluate the points in parallel, without a virtual
+   * call per point). Subclasses of these classes which do not override the
+   * array version get the per point evaluation of vtkImplicitFunction, so
+   * that their EvaluateFunction(x) is honored.
    */
   virtual double EvaluateFunction(double x[3]) = 0;
   virtual void EvaluateFunction(vtkDataArray* input, vtkDataArray* output);
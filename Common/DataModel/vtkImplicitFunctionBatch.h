@@ -0,0 +1,150 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkImplicitFunctionBatch.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkImplicitFunctionBatch
+ * @brief   helpers to evaluate implicit functions over arrays of points
+ *
+ * This private header provides the threaded loop used by the implicit
+ * functions which override vtkImplicitFunction::EvaluateFunction(vtkDataArray*
+ * input, vtkDataArray* output). The function is described by a small
+ * evaluator object holding a copy of its parameters, with a
+ * double operator()(const double x[3]) const which must compute exactly the
+ * same value as the EvaluateFunction(double x[3]) method of the function.
+ * Since the evaluator is inlined in a loop over the values of the arrays,
+ * without virtual calls, the compiler is able to vectorize it.
+ *
+ * The evaluator bypasses EvaluateFunction(double x[3]), so it is only used
+ * for the exact classes which define it: a subclass may override the single
+ * point method alone, and its points are then evaluated one at a time by
+ * vtkImplicitFunction.
+ */
+
+#ifndef vtkImplicitFunctionBatch_h
+#define vtkImplicitFunctionBatch_h
+
+#include "vtkArrayDispatch.h"
+#include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkSMPTools.h"
+
+#include <algorithm> // For std::transform
+#include <typeinfo>  // For typeid
+
+namespace vtkImplicitFunctionBatch
+{
+
+/**
+ * Whether function is an instance of FunctionType itself rather than of a
+ * subclass, whose EvaluateFunction(double x[3]) may differ from the
+ * evaluator of FunctionType.
+ */
+template <typename FunctionType>
+bool IsExactly(FunctionType* function)
+{
+  return typeid(*function) == typeid(FunctionType);
+}
+
+template <typename Evaluator>
+struct EvaluateWorker
+{
+  const Evaluator& Eval;
+
+  EvaluateWorker(const Evaluator& eval)
+    : Eval(eval)
+  {
+  }
+
+  template <typename InputArrayType, typename OutputArrayType>
+  void operator()(InputArrayType* input, OutputArrayType* output)
+  {
+    const vtkIdType numTuples = input->GetNumberOfTuples();
+    output->SetNumberOfComponents(1);
+    output->SetNumberOfTuples(numTuples);
+    const Evaluator& eval = this->Eval;
+
+    vtkSMPTools::For(0, numTuples, [&eval, input, output](vtkIdType begin, vtkIdType end) {
+      const auto srcTuples = vtk::DataArrayTupleRange<3>(input, begin, end);
+      auto dstValues = vtk::DataArrayValueRange<1>(output, begin, end);
+      using DstValueT = typename decltype(dstValues)::ValueType;
+
+      auto dst = dstValues.begin();
+      for (auto tuple = srcTuples.cbegin(); tuple != srcTuples.cend(); ++tuple, ++dst)
+      {
+        const double x[3] = { static_cast<double>((*tuple)[0]),
+          static_cast<double>((*tuple)[1]), static_cast<double>((*tuple)[2]) };
+        *dst = static_cast<DstValueT>(eval(x));
+      }
+    });
+  }
+};
+
+/**
+ * Evaluate the function described by eval for each tuple of input (which
+ * must have three components) in parallel, and store the values in output.
+ */
+template <typename Evaluator>
+void Evaluate(const Evaluator& eval, vtkDataArray* input, vtkDataArray* output)
+{
+  EvaluateWorker<Evaluator> worker(eval);
+  typedef vtkTypeList::Create<float, double> InputTypes;
+  typedef vtkTypeList::Create<float, double> OutputTypes;
+  typedef vtkArrayDispatch::Dispatch2ByValueType<InputTypes, OutputTypes> MyDispatch;
+  if (!MyDispatch::Execute(input, output, worker))
+  {
+    worker(input, output); // Use vtkDataArray API if dispatch fails.
+  }
+}
+
+template <typename ValueType>
+struct StoreWorker
+{
+  const ValueType* Values;
+
+  template <typename OutputArrayType>
+  void operator()(OutputArrayType* output)
+  {
+    const ValueType* values = this->Values;
+    const vtkIdType numValues = output->GetNumberOfTuples();
+    vtkSMPTools::For(0, numValues, [values, output](vtkIdType begin, vtkIdType end) {
+      auto dstValues = vtk::DataArrayValueRange<1>(output, begin, end);
+      using DstValueT = typename decltype(dstValues)::ValueType;
+      std::transform(values + begin, values + end, dstValues.begin(),
+        [](ValueType v) -> DstValueT { return static_cast<DstValueT>(v); });
+    });
+  }
+};
+
+/**
+ * Store numValues values into output, in parallel. This is used by the
+ * composite functions, which combine the values of their functions before
+ * storing them.
+ */
+template <typename ValueType>
+void Store(const ValueType* values, vtkIdType numValues, vtkDataArray* output)
+{
+  output->SetNumberOfComponents(1);
+  output->SetNumberOfTuples(numValues);
+  StoreWorker<ValueType> worker{ values };
+  typedef vtkTypeList::Create<float, double> OutputTypes;
+  if (!vtkArrayDispatch::DispatchByValueType<OutputTypes>::Execute(output, worker))
+  {
+    worker(output); // Use vtkDataArray API if dispatch fails.
+  }
+}
+
+} // end namespace vtkImplicitFunctionBatch
+
+#endif
+// VTK-HeaderTest-Exclude: vtkImplicitFunctionBatch.h
@@ -15,10 +15,14 @@
 #include "vtkImplicitSum.h"
 
 #include "vtkDoubleArray.h"
+#include "vtkImplicitFunctionBatch.h"
 #include "vtkImplicitFunctionCollection.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 
 #include <cmath>
+#include <vector>
 
 vtkStandardNewMacro(vtkImplicitSum);
 
@@ -142,6 +146,57 @@ double vtkImplicitSum::EvaluateFunction(double x[3])
   return sum;
 }
 
+//------------------------------------------------------------------------------
+// Evaluate the sum for an array of points. Each function is evaluated for all
+// of the points (with its own batch evaluation), and its weighted values are
+// added, in parallel, in the same order as in EvaluateFunction(x).
+void vtkImplicitSum::EvaluateFunction(vtkDataArray* input, vtkDataArray* output)
+{
+  if (!vtkImplicitFunctionBatch::IsExactly(this))
+  {
+    this->Superclass::EvaluateFunction(input, output);
+    return;
+  }
+  const vtkIdType numPts = input->GetNumberOfTuples();
+  std::vector<double> sums(numPts, 0.0);
+  double* sum = sums.data();
+  const double* weights = this->Weights->GetPointer(0);
+
+  vtkNew<vtkDoubleArray> fValues;
+  fValues->SetNumberOfTuples(numPts);
+  vtkImplicitFunction* f;
+  vtkCollectionSimpleIterator sit;
+  int i;
+  for (i = 0, this->FunctionList->InitTraversal(sit);
+       (f = this->FunctionList->GetNextImplicitFunction(sit)); i++)
+  {
+    const double c = weights[i];
+    if (c != 0.0)
+    {
+      f->FunctionValue(input, fValues);
+      const double* v = fValues->GetPointer(0);
+      vtkSMPTools::For(0, numPts, [sum, v, c](vtkIdType ptId, vtkIdType endPtId) {
+        for (; ptId < endPtId; ++ptId)
+        {
+          sum[ptId] += v[ptId] * c;
+        }
+      });
+    }
+  }
+  if (this->NormalizeByWeight && this->TotalWeight != 0.0)
+  {
+    const double totalWeight = this->TotalWeight;
+    vtkSMPTools::For(0, numPts, [sum, totalWeight](vtkIdType ptId, vtkIdType endPtId) {
+      for (; ptId < endPtId; ++ptId)
+      {
+        sum[ptId] /= totalWeight;
+      }
+    });
+  }
+
+  vtkImplicitFunctionBatch::Store(sum, numPts, output);
+}
+
 //------------------------------------------------------------------------------
 // Evaluate gradient of sum of functions (valid only if linear)
 void vtkImplicitSum::EvaluateGradient(double x[3], double g[3])
@@ -45,6 +45,7 @@ public:
    * Evaluate implicit function using current functions and weights.
    */
   using vtkImplicitFunction::EvaluateFunction;
+  void EvaluateFunction(vtkDataArray* input, vtkDataArray* output) override;
   double EvaluateFunction(double x[3]) override;
   //@}
 
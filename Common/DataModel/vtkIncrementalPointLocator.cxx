@@ -15,11 +15,25 @@
 
 #include "vtkIncrementalPointLocator.h"
 #include "vtkObjectFactory.h"
+#include "vtkPoints.h"
 
 vtkIncrementalPointLocator::vtkIncrementalPointLocator() = default;
 
 vtkIncrementalPointLocator::~vtkIncrementalPointLocator() = default;
 
+vtkIdType vtkIncrementalPointLocator::InsertUniquePoints(vtkPoints* points, vtkIdType* ptIds)
+{
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  vtkIdType numInserted = 0;
+  double x[3];
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    points->GetPoint(i, x);
+    numInserted += this->InsertUniquePoint(x, ptIds[i]);
+  }
+  return numInserted;
+}
+
 void vtkIncrementalPointLocator::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
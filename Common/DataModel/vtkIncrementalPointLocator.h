@@ -110,6 +110,18 @@ public:
    */
   virtual int InsertUniquePoint(const double x[3], vtkIdType& ptId) = 0;
 
+  /**
+   * Insert the points of a vtkPoints object, unless there has been a
+   * duplicate in the search structure, and store the id of each point (newly
+   * inserted or not) in ptIds, which must have room for
+   * points->GetNumberOfPoints() ids. Return the number of points actually
+   * inserted. The result is the same as calling InsertUniquePoint() for each
+   * point in order, which is what this implementation does; subclasses may
+   * override it to insert the points in parallel. InitPointInsertion()
+   * should have been called in advance.
+   */
+  virtual vtkIdType InsertUniquePoints(vtkPoints* points, vtkIdType* ptIds);
+
   /**
    * Insert a given point with a specified point index ptId. InitPointInsertion()
    * should have been called prior to this function. Also, IsInsertedPoint()
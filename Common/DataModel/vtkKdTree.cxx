@@ -29,17 +29,22 @@
 #include "vtkDataSetCollection.h"
 #include "vtkFloatArray.h"
 #include "vtkGarbageCollector.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkIntArray.h"
 #include "vtkKdNode.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTimerLog.h"
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
@@ -49,6 +54,7 @@
 #include <map>
 #include <queue>
 #include <set>
+#include <vector>
 
 namespace
 {
@@ -117,6 +123,15 @@ static void LastInputDeletedCallback(vtkObject* vtkNotUsed(caller), unsigned lon
 // helper class for ordering the points in vtkKdTree::FindClosestNPoints()
 namespace
 {
+// A region which remains to be divided, with its range of the point array
+struct KdDivideTask
+{
+  vtkKdNode* Node;
+  float* Points;
+  int* Ids;
+  int Level;
+};
+
 class OrderPoints
 {
 public:
@@ -188,6 +203,110 @@ private:
 };
 }
 
+//------------------------------------------------------------------------------
+// A node of the copy of the k-d tree used by the point queries. The nodes
+// are stored in a single array in depth-first order: the left child of an
+// interior node is the next node, and Right is the index of its right child.
+struct vtkKdTreeFlatNode
+{
+  double Min[3];    // spatial region
+  double Max[3];
+  double MinVal[3]; // bounds of the points in the region
+  double MaxVal[3];
+  int Right;        // -1 for a leaf
+  int ID;           // region id of a leaf, -1 for an interior node
+  int MinID;        // id of the first region of the subtree
+  int NumberOfPoints;
+
+  bool ContainsPoint(const double x[3]) const
+  {
+    return !((this->Min[0] > x[0]) || (this->Max[0] < x[0]) || (this->Min[1] > x[1]) ||
+      (this->Max[1] < x[1]) || (this->Min[2] > x[2]) || (this->Max[2] < x[2]));
+  }
+
+  bool DataContainsPoint(const double x[3]) const
+  {
+    return !((this->MinVal[0] > x[0]) || (this->MaxVal[0] < x[0]) || (this->MinVal[1] > x[1]) ||
+      (this->MaxVal[1] < x[1]) || (this->MinVal[2] > x[2]) || (this->MaxVal[2] < x[2]));
+  }
+
+  // Same as vtkKdNode::GetDistance2ToBoundary(x, y, z, 1)
+  double GetDistance2ToDataBoundary(const double x[3]) const
+  {
+    const double* min = this->MinVal;
+    const double* max = this->MaxVal;
+    bool less[3], more[3], within[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      less[i] = (x[i] < min[i]);
+      more[i] = (x[i] > max[i]);
+      within[i] = !less[i] && !more[i];
+    }
+
+    double minDistance;
+    if (within[0] && within[1] && within[2]) // point is inside the box
+    {
+      minDistance = x[0] - min[0];
+      for (int i = 0; i < 3; ++i)
+      {
+        minDistance = std::min(minDistance, x[i] - min[i]);
+        minDistance = std::min(minDistance, max[i] - x[i]);
+      }
+      if (minDistance != VTK_FLOAT_MAX)
+      {
+        minDistance *= minDistance;
+      }
+    }
+    else if ((within[0] + within[1] + within[2]) == 2) // closest to a face
+    {
+      int dim = (!within[0] ? 0 : (!within[1] ? 1 : 2));
+      minDistance = (less[dim] ? min[dim] - x[dim] : x[dim] - max[dim]);
+      minDistance *= minDistance;
+    }
+    else // closest to an edge or a corner
+    {
+      double pt[3];
+      for (int i = 0; i < 3; ++i)
+      {
+        pt[i] = (within[i] ? x[i] : (less[i] ? min[i] : max[i]));
+      }
+      minDistance = vtkMath::Distance2BetweenPoints(x, pt);
+    }
+    return minDistance;
+  }
+};
+
+namespace
+{
+// Copy the subtree of kd to nodes, starting at index. Returns the index
+// following the subtree.
+int FlattenKdTree(vtkKdNode* kd, vtkKdTreeFlatNode* nodes, int index)
+{
+  vtkKdTreeFlatNode* node = nodes + index;
+  for (int i = 0; i < 3; ++i)
+  {
+    node->Min[i] = kd->GetMinBounds()[i];
+    node->Max[i] = kd->GetMaxBounds()[i];
+    node->MinVal[i] = kd->GetMinDataBounds()[i];
+    node->MaxVal[i] = kd->GetMaxDataBounds()[i];
+  }
+  node->ID = kd->GetID();
+  node->MinID = kd->GetMinID();
+  node->NumberOfPoints = kd->GetNumberOfPoints();
+
+  if (kd->GetLeft() == nullptr)
+  {
+    node->Right = -1;
+    return index + 1;
+  }
+  node->Right = FlattenKdTree(kd->GetLeft(), nodes, index + 1);
+  return FlattenKdTree(kd->GetRight(), nodes, node->Right);
+}
+}
+
+// Regions with fewer points are divided in a single task
+#define VTK_KD_SUBTREE_SIZE 8192
+
 vtkStandardNewMacro(vtkKdTree);
 
 //------------------------------------------------------------------------------
@@ -224,6 +343,7 @@ vtkKdTree::vtkKdTree()
   this->LocatorPoints = nullptr;
   this->LocatorIds = nullptr;
   this->LocatorRegionLocation = nullptr;
+  this->FlatNodes = nullptr;
 
   this->LastDataCacheSize = 0;
   this->LastNumDataSets = 0;
@@ -645,52 +765,58 @@ float* vtkKdTree::ComputeCellCenters(vtkDataSet* set)
     }
   }
 
-  double* weights = new double[maxCellSize];
+  // The centers are computed in parallel, with a vtkGenericCell and
+  // weights per thread.
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  std::vector<double> weightsExemplar(maxCellSize);
+  vtkSMPThreadLocal<std::vector<double>> tlWeights(weightsExemplar);
+  auto computeCenters = [this, &tlCell, &tlWeights](vtkDataSet* iset, float* cptr) {
+    vtkIdType nCells = iset->GetNumberOfCells();
+    if (nCells < 1)
+    {
+      return;
+    }
+    // Make sure the data set is ready for threaded GetCell() calls
+    vtkNew<vtkGenericCell> cell;
+    iset->GetCell(0, cell);
 
-  float* cptr = center;
-  double dcenter[3];
+    vtkSMPTools::For(
+      0, nCells, [this, iset, cptr, &tlCell, &tlWeights](vtkIdType j, vtkIdType endJ) {
+        vtkGenericCell* genericCell = tlCell.Local();
+        double* weights = tlWeights.Local().data();
+        double dcenter[3];
+        for (; j < endJ; j++)
+        {
+          iset->GetCell(j, genericCell);
+          this->ComputeCellCenter(genericCell, dcenter, weights);
+          cptr[3 * j] = static_cast<float>(dcenter[0]);
+          cptr[3 * j + 1] = static_cast<float>(dcenter[1]);
+          cptr[3 * j + 2] = static_cast<float>(dcenter[2]);
+        }
+      });
+  };
 
   if (set)
   {
-    for (int j = 0; j < totalCells; j++)
-    {
-      this->ComputeCellCenter(set->GetCell(j), dcenter, weights);
-      cptr[0] = static_cast<float>(dcenter[0]);
-      cptr[1] = static_cast<float>(dcenter[1]);
-      cptr[2] = static_cast<float>(dcenter[2]);
-      cptr += 3;
-      if (j % 1000 == 0)
-      {
-        this->UpdateSubOperationProgress(static_cast<double>(j) / totalCells);
-      }
-    }
+    computeCenters(set, center);
   }
   else
   {
+    float* cptr = center;
+    int cellCount = 0;
     vtkCollectionSimpleIterator cookie;
     this->DataSets->InitTraversal(cookie);
     for (vtkDataSet* iset = this->DataSets->GetNextDataSet(cookie); iset != nullptr;
          iset = this->DataSets->GetNextDataSet(cookie))
     {
       int nCells = iset->GetNumberOfCells();
-
-      for (int j = 0; j < nCells; j++)
-      {
-        this->ComputeCellCenter(iset->GetCell(j), dcenter, weights);
-        cptr[0] = static_cast<float>(dcenter[0]);
-        cptr[1] = static_cast<float>(dcenter[1]);
-        cptr[2] = static_cast<float>(dcenter[2]);
-        cptr += 3;
-        if (j % 1000 == 0)
-        {
-          this->UpdateSubOperationProgress(static_cast<double>(j) / totalCells);
-        }
-      }
+      computeCenters(iset, cptr);
+      cptr += 3 * nCells;
+      cellCount += nCells;
+      this->UpdateSubOperationProgress(static_cast<double>(cellCount) / totalCells);
     }
   }
 
-  delete[] weights;
-
   this->UpdateSubOperationProgress(1.0);
   return center;
 }
@@ -1034,6 +1160,11 @@ void vtkKdTree::SetNewBounds(double* bounds)
       fixDimRight[cutDim] = 0;
       vtkKdTree::_SetNewBounds(kd->GetRight(), bounds, fixDimRight);
     }
+
+    if (this->FlatNodes)
+    {
+      this->BuildFlatNodes();
+    }
   }
 }
 //------------------------------------------------------------------------------
@@ -1228,7 +1359,67 @@ int vtkKdTree::DivideTest(int size, int level)
   return 1;
 }
 //------------------------------------------------------------------------------
+// The regions are divided level by level. The regions of a level are
+// independent (each one reorders its own range of the point array), so they
+// are divided concurrently. A region with few points is divided recursively
+// in a single task. The resulting tree does not depend on the number of
+// threads.
 int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
+{
+  std::vector<KdDivideTask> tasks(1);
+  tasks[0].Node = kd;
+  tasks[0].Points = c1;
+  tasks[0].Ids = ids;
+  tasks[0].Level = level;
+
+  std::vector<KdDivideTask> children;
+  while (!tasks.empty())
+  {
+    children.resize(2 * tasks.size());
+    vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()),
+      [this, &tasks, &children](vtkIdType taskId, vtkIdType endTaskId) {
+        for (; taskId < endTaskId; ++taskId)
+        {
+          const KdDivideTask& task = tasks[taskId];
+          KdDivideTask* left = &children[2 * taskId];
+          KdDivideTask* right = left + 1;
+          left->Node = right->Node = nullptr;
+
+          if (task.Node->GetNumberOfPoints() <= VTK_KD_SUBTREE_SIZE)
+          {
+            this->_DivideRegion(task.Node, task.Points, task.Ids, task.Level);
+          }
+          else if (this->SplitRegion(task.Node, task.Points, task.Ids, task.Level))
+          {
+            int nleft = task.Node->GetLeft()->GetNumberOfPoints();
+            left->Node = task.Node->GetLeft();
+            left->Points = task.Points;
+            left->Ids = task.Ids;
+            left->Level = task.Level + 1;
+            right->Node = task.Node->GetRight();
+            right->Points = task.Points + nleft * 3;
+            right->Ids = task.Ids ? task.Ids + nleft : nullptr;
+            right->Level = task.Level + 1;
+          }
+        }
+      });
+
+    tasks.clear();
+    for (const KdDivideTask& child : children)
+    {
+      if (child.Node)
+      {
+        tasks.push_back(child);
+      }
+    }
+  }
+
+  return 0;
+}
+
+//------------------------------------------------------------------------------
+// Divide one region in two, returns 1 if the region was divided.
+int vtkKdTree::SplitRegion(vtkKdNode* kd, float* c1, int* ids, int level)
 {
   int ok = this->DivideTest(kd->GetNumberOfPoints(), level);
 
@@ -1283,9 +1474,15 @@ int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
 
   this->DoMedianFind(kd, c1, ids, dim1, dim2, dim3);
 
-  if (kd->GetLeft() == nullptr)
+  return (kd->GetLeft() != nullptr);
+}
+
+//------------------------------------------------------------------------------
+void vtkKdTree::_DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
+{
+  if (!this->SplitRegion(kd, c1, ids, level))
   {
-    return 0; // unable to divide region further
+    return; // unable to divide region further
   }
 
   int nleft = kd->GetLeft()->GetNumberOfPoints();
@@ -1293,11 +1490,9 @@ int vtkKdTree::DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level)
   int* leftIds = ids;
   int* rightIds = ids ? ids + nleft : nullptr;
 
-  this->DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
-
-  this->DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
+  this->_DivideRegion(kd->GetLeft(), c1, leftIds, level + 1);
 
-  return 0;
+  this->_DivideRegion(kd->GetRight(), c1 + nleft * 3, rightIds, level + 1);
 }
 
 //------------------------------------------------------------------------------
@@ -1641,6 +1836,14 @@ int vtkKdTree::SelfOrder(int startId, vtkKdNode* kd)
   return nextId;
 }
 
+//------------------------------------------------------------------------------
+void vtkKdTree::BuildFlatNodes()
+{
+  delete[] this->FlatNodes;
+  this->FlatNodes = new vtkKdTreeFlatNode[2 * this->NumberOfRegions - 1];
+  FlattenKdTree(this->Top, this->FlatNodes, 0);
+}
+
 void vtkKdTree::BuildRegionList()
 {
   SCOPETIMER("BuildRegionList");
@@ -1821,16 +2024,21 @@ void vtkKdTree::BuildLocatorFromPoints(vtkPoints** ptArrays, int numPtArrays)
     else
     {
       // Hopefully point arrays are usually floats.  This conversion will
-      // really slow things down.
-
-      for (vtkIdType ii = 0; ii < npoints; ii++)
-      {
-        double* pt = ptArrays[i]->GetPoint(ii);
+      // really slow things down, so it is threaded.
 
-        points[ptId++] = static_cast<float>(pt[0]);
-        points[ptId++] = static_cast<float>(pt[1]);
-        points[ptId++] = static_cast<float>(pt[2]);
-      }
+      vtkPoints* ptArray = ptArrays[i];
+      float* fpoints = points + ptId;
+      vtkSMPTools::For(0, npoints, [ptArray, fpoints](vtkIdType ii, vtkIdType endII) {
+        double pt[3];
+        for (; ii < endII; ii++)
+        {
+          ptArray->GetPoint(ii, pt);
+          fpoints[3 * ii] = static_cast<float>(pt[0]);
+          fpoints[3 * ii + 1] = static_cast<float>(pt[1]);
+          fpoints[3 * ii + 2] = static_cast<float>(pt[2]);
+        }
+      });
+      ptId += nvals;
     }
   }
 
@@ -1868,6 +2076,8 @@ void vtkKdTree::BuildLocatorFromPoints(vtkPoints** ptArrays, int numPtArrays)
 
   this->SetCalculator(this->Top);
 
+  this->BuildFlatNodes();
+
   TIMERDONE("Build tree");
 }
 
@@ -2352,30 +2562,39 @@ int vtkKdTree::FindClosestPointInSphere(
     vtkErrorMacro(<< "vtkKdTree::FindClosestPointInSphere - must build locator first");
     return -1;
   }
-  int* regionIds = new int[this->NumberOfRegions];
-
-  this->BSPCalculator->ComputeIntersectionsUsingDataBoundsOn();
-
-  int nRegions = this->BSPCalculator->IntersectsSphere2(
-    regionIds, this->NumberOfRegions, x, y, z, radius * radius);
-
-  this->BSPCalculator->ComputeIntersectionsUsingDataBoundsOff();
+  double pt[3] = { x, y, z };
+  double radius2 = radius * radius;
 
   double minDistance2 = 4 * this->MaxWidth * this->MaxWidth;
   int localCloseId = -1;
 
+  // Visit the regions whose data bounds intersect the sphere, in the order
+  // of vtkBSPIntersections::IntersectsSphere2()
+  std::vector<int> stack(1, 0);
   bool recheck = false; // used to flag that we should recheck the distance
-  for (int reg = 0; reg < nRegions; reg++)
+  while (!stack.empty())
   {
-    if (regionIds[reg] == skipRegion)
+    const vtkKdTreeFlatNode* node = this->FlatNodes + stack.back();
+    stack.pop_back();
+    if (!node->DataContainsPoint(pt) && !(node->GetDistance2ToDataBoundary(pt) < radius2))
+    {
+      continue;
+    }
+    if (node->Right >= 0)
+    {
+      stack.push_back(node->Right);
+      stack.push_back(static_cast<int>(node - this->FlatNodes) + 1);
+      continue;
+    }
+    if (node->ID == skipRegion)
     {
       continue;
     }
 
-    int neighbor = regionIds[reg];
+    int neighbor = node->ID;
 
     // recheck that the bin is closer than the current minimum distance
-    if (!recheck || this->RegionList[neighbor]->GetDistance2ToBoundary(x, y, z, 1) < minDistance2)
+    if (!recheck || node->GetDistance2ToDataBoundary(pt) < minDistance2)
     {
       double newDistance2;
       int newLocalCloseId = this->_FindClosestPointInRegion(neighbor, x, y, z, newDistance2);
@@ -2389,8 +2608,6 @@ int vtkKdTree::FindClosestPointInSphere(
     }
   }
 
-  delete[] regionIds;
-
   dist2 = minDistance2;
   return localCloseId;
 }
@@ -2399,8 +2616,86 @@ int vtkKdTree::FindClosestPointInSphere(
 void vtkKdTree::FindPointsWithinRadius(double R, const double x[3], vtkIdList* result)
 {
   result->Reset();
+  if (!this->LocatorPoints)
+  {
+    vtkErrorMacro(<< "vtkKdTree::FindPointsWithinRadius - must build locator first");
+    return;
+  }
+
   // don't forget to square the radius
-  this->FindPointsWithinRadius(this->Top, R * R, x, result);
+  double R2 = R * R;
+
+  // Same traversal as the recursive FindPointsWithinRadius(), on the flat
+  // copy of the tree
+  std::vector<int> stack(1, 0);
+  while (!stack.empty())
+  {
+    const vtkKdTreeFlatNode* node = this->FlatNodes + stack.back();
+    stack.pop_back();
+
+    // distances to the closest and furthest vertices of the region
+    double mindist2 = 0;
+    double maxdist2 = 0;
+    for (int i = 0; i < 3; i++)
+    {
+      double bmin = node->Min[i];
+      double bmax = node->Max[i];
+      if (x[i] < bmin)
+      {
+        mindist2 += (bmin - x[i]) * (bmin - x[i]);
+        maxdist2 += (bmax - x[i]) * (bmax - x[i]);
+      }
+      else if (x[i] > bmax)
+      {
+        mindist2 += (bmax - x[i]) * (bmax - x[i]);
+        maxdist2 += (bmin - x[i]) * (bmin - x[i]);
+      }
+      else if ((bmax - x[i]) > (x[i] - bmin))
+      {
+        maxdist2 += (bmax - x[i]) * (bmax - x[i]);
+      }
+      else
+      {
+        maxdist2 += (bmin - x[i]) * (bmin - x[i]);
+      }
+    }
+
+    if (mindist2 > R2)
+    {
+      // non-intersecting
+      continue;
+    }
+
+    int regionLoc = this->LocatorRegionLocation[node->MinID];
+    if (maxdist2 <= R2)
+    {
+      // sphere contains BB
+      for (int i = 0; i < node->NumberOfPoints; i++)
+      {
+        result->InsertNextId(static_cast<vtkIdType>(this->LocatorIds[regionLoc + i]));
+      }
+    }
+    else if (node->Right < 0)
+    {
+      // partial intersection of sphere & BB
+      float* pt = this->LocatorPoints + (regionLoc * 3);
+      for (int i = 0; i < node->NumberOfPoints; i++)
+      {
+        double dist2 = (pt[0] - x[0]) * (pt[0] - x[0]) + (pt[1] - x[1]) * (pt[1] - x[1]) +
+          (pt[2] - x[2]) * (pt[2] - x[2]);
+        if (dist2 <= R2)
+        {
+          result->InsertNextId(static_cast<vtkIdType>(this->LocatorIds[regionLoc + i]));
+        }
+        pt += 3;
+      }
+    }
+    else
+    {
+      stack.push_back(node->Right);
+      stack.push_back(static_cast<int>(node - this->FlatNodes) + 1);
+    }
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -2541,85 +2836,40 @@ void vtkKdTree::FindClosestNPoints(int N, const double x[3], vtkIdList* result)
   // now we want to go about finding a region that contains at least N points
   // but not many more -- hopefully the region contains X as well but we
   // can't depend on that
-  vtkKdNode* node = this->Top;
-  vtkKdNode* startingNode = nullptr;
-  if (!node->ContainsPoint(x[0], x[1], x[2], 0))
+  const vtkKdTreeFlatNode* nodes = this->FlatNodes;
+  const vtkKdTreeFlatNode* node = nodes;
+  const vtkKdTreeFlatNode* startingNode = nullptr;
+  int numPoints = node->NumberOfPoints;
+  const vtkKdTreeFlatNode* prevNode = node;
+  if (!node->ContainsPoint(x))
   {
     // point is not in the region
-    int numPoints = node->GetNumberOfPoints();
-    vtkKdNode* prevNode = node;
-    while (node->GetLeft() && numPoints > N)
+    while (node->Right >= 0 && numPoints > N)
     {
       prevNode = node;
-      double leftDist2 = node->GetLeft()->GetDistance2ToBoundary(x[0], x[1], x[2], 1);
-      double rightDist2 = node->GetRight()->GetDistance2ToBoundary(x[0], x[1], x[2], 1);
-      if (leftDist2 < rightDist2)
-      {
-        node = node->GetLeft();
-      }
-      else
-      {
-        node = node->GetRight();
-      }
-      numPoints = node->GetNumberOfPoints();
-    }
-    if (numPoints < N)
-    {
-      startingNode = prevNode;
-    }
-    else
-    {
-      startingNode = node;
+      const vtkKdTreeFlatNode* left = node + 1;
+      const vtkKdTreeFlatNode* right = nodes + node->Right;
+      double leftDist2 = left->GetDistance2ToDataBoundary(x);
+      double rightDist2 = right->GetDistance2ToDataBoundary(x);
+      node = (leftDist2 < rightDist2 ? left : right);
+      numPoints = node->NumberOfPoints;
     }
   }
   else
   {
-    int numPoints = node->GetNumberOfPoints();
-    vtkKdNode* prevNode = node;
-    while (node->GetLeft() && numPoints > N)
+    while (node->Right >= 0 && numPoints > N)
     {
       prevNode = node;
-      if (node->GetLeft()->ContainsPoint(x[0], x[1], x[2], 0))
-      {
-        node = node->GetLeft();
-      }
-      else
-      {
-        node = node->GetRight();
-      }
-      numPoints = node->GetNumberOfPoints();
-    }
-    if (numPoints < N)
-    {
-      startingNode = prevNode;
-    }
-    else
-    {
-      startingNode = node;
+      node = ((node + 1)->ContainsPoint(x) ? node + 1 : nodes + node->Right);
+      numPoints = node->NumberOfPoints;
     }
   }
+  startingNode = (numPoints < N ? prevNode : node);
 
   // now that we have a starting region, go through its points
   // and order them
-  int regionId = startingNode->GetID();
-  int numPoints = startingNode->GetNumberOfPoints();
-  int where;
-  if (regionId >= 0)
-  {
-    where = this->LocatorRegionLocation[regionId];
-  }
-  else
-  {
-    vtkKdNode* left = startingNode->GetLeft();
-    vtkKdNode* next = left->GetLeft();
-    while (next)
-    {
-      left = next;
-      next = next->GetLeft();
-    }
-    int leftRegionId = left->GetID();
-    where = this->LocatorRegionLocation[leftRegionId];
-  }
+  numPoints = startingNode->NumberOfPoints;
+  int where = this->LocatorRegionLocation[startingNode->MinID];
   int* ids = this->LocatorIds + where;
   float* pt = this->LocatorPoints + (where * 3);
   float xfloat[3] = { static_cast<float>(x[0]), static_cast<float>(x[1]),
@@ -2635,11 +2885,8 @@ void vtkKdTree::FindClosestNPoints(int N, const double x[3], vtkIdList* result)
   // to finish up we have to check other regions for
   // closer points
   float LargestDist2 = orderedPoints.GetLargestDist2();
-  double delta[3] = { 0, 0, 0 };
-  double bounds[6];
-  node = this->Top;
-  std::queue<vtkKdNode*> nodesToBeSearched;
-  nodesToBeSearched.push(node);
+  std::queue<const vtkKdTreeFlatNode*> nodesToBeSearched;
+  nodesToBeSearched.push(nodes);
   while (!nodesToBeSearched.empty())
   {
     node = nodesToBeSearched.front();
@@ -2648,27 +2895,23 @@ void vtkKdTree::FindClosestNPoints(int N, const double x[3], vtkIdList* result)
     {
       continue;
     }
-    vtkKdNode* left = node->GetLeft();
-    if (left)
+    if (node->Right >= 0)
     {
-      left->GetDataBounds(bounds);
-      if (vtkMath::PointIsWithinBounds(const_cast<double*>(x), bounds, delta) == 1 ||
-        left->GetDistance2ToBoundary(x[0], x[1], x[2], 1) < LargestDist2)
+      const vtkKdTreeFlatNode* left = node + 1;
+      const vtkKdTreeFlatNode* right = nodes + node->Right;
+      if (left->DataContainsPoint(x) || left->GetDistance2ToDataBoundary(x) < LargestDist2)
       {
         nodesToBeSearched.push(left);
       }
-      node->GetRight()->GetDataBounds(bounds);
-      if (vtkMath::PointIsWithinBounds(const_cast<double*>(x), bounds, delta) == 1 ||
-        node->GetRight()->GetDistance2ToBoundary(x[0], x[1], x[2], 1) < LargestDist2)
+      if (right->DataContainsPoint(x) || right->GetDistance2ToDataBoundary(x) < LargestDist2)
       {
-        nodesToBeSearched.push(node->GetRight());
+        nodesToBeSearched.push(right);
       }
     }
-    else if (node->GetDistance2ToBoundary(x[0], x[1], x[2], 1) < LargestDist2)
+    else if (node->GetDistance2ToDataBoundary(x) < LargestDist2)
     {
-      regionId = node->GetID();
-      numPoints = node->GetNumberOfPoints();
-      where = this->LocatorRegionLocation[regionId];
+      numPoints = node->NumberOfPoints;
+      where = this->LocatorRegionLocation[node->ID];
       ids = this->LocatorIds + where;
       pt = this->LocatorPoints + (where * 3);
       for (int i = 0; i < numPoints; i++)
@@ -3106,6 +3349,9 @@ void vtkKdTree::FreeSearchStructure()
 
   delete[] this->LocatorRegionLocation;
   this->LocatorRegionLocation = nullptr;
+
+  delete[] this->FlatNodes;
+  this->FlatNodes = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -4184,7 +4430,30 @@ int* vtkKdTree::AllGetRegionContainingCell()
 //------------------------------------------------------------------------------
 int vtkKdTree::GetRegionContainingPoint(double x, double y, double z)
 {
-  return vtkKdTree::findRegion(this->Top, x, y, z);
+  if (!this->FlatNodes)
+  {
+    return vtkKdTree::findRegion(this->Top, x, y, z);
+  }
+
+  // Same traversal as findRegion()
+  double pt[3] = { x, y, z };
+  std::vector<int> stack(1, 0);
+  while (!stack.empty())
+  {
+    const vtkKdTreeFlatNode* node = this->FlatNodes + stack.back();
+    stack.pop_back();
+    if (!node->ContainsPoint(pt))
+    {
+      continue;
+    }
+    if (node->Right < 0)
+    {
+      return node->ID;
+    }
+    stack.push_back(node->Right);
+    stack.push_back(static_cast<int>(node - this->FlatNodes) + 1);
+  }
+  return -1;
 }
 //------------------------------------------------------------------------------
 int vtkKdTree::MinimalNumberOfConvexSubRegions(vtkIntArray* regionIdList, double** convexSubRegions)
@@ -49,6 +49,18 @@
  *     tolerance, or you can use FindPoint and FindClosestPoint to
  *     locate points in the original set that the tree was built from.
  *
+ *     The tree is built in parallel (via vtkSMPTools): the regions of
+ *     each level are divided concurrently, and the small regions are
+ *     then divided recursively by separate threads. The resulting tree
+ *     does not depend on the number of threads. After
+ *     BuildLocatorFromPoints, the point queries traverse a copy of the
+ *     tree stored in a flat array, and can be called concurrently. This
+ *     copy is kept in addition to the vtkKdNode tree, on which vtkPKdTree
+ *     and vtkBSPCuts rely, and is not freed until the tree is rebuilt or
+ *     freed: both the peak and the resident memory of a tree built from
+ *     points grow by about 112 bytes per node (two nodes per region).
+ *     BuildLocator() does not build the copy.
+ *
  * @sa
  *      vtkLocator vtkCellLocator vtkPKdTree
  */
@@ -71,6 +83,7 @@ class vtkKdNode;
 class vtkBSPCuts;
 class vtkBSPIntersections;
 class vtkDataSetCollection;
+struct vtkKdTreeFlatNode;
 
 class VTKCOMMONDATAMODEL_EXPORT vtkKdTree : public vtkLocator
 {
@@ -774,7 +787,18 @@ protected:
   // Recursive helper for public FindPointsInArea
   void AddAllPointsInRegion(vtkKdNode* node, vtkIdTypeArray* ids);
 
-  int DivideRegion(vtkKdNode* kd, float* c1, int* ids, int nlevels);
+  // Divide a region, level by level in parallel. A subclass may divide it
+  // recursively in the calling thread instead with _DivideRegion, which
+  // gives the same tree.
+  virtual int DivideRegion(vtkKdNode* kd, float* c1, int* ids, int nlevels);
+
+  // Helpers for DivideRegion: divide one region in two, or divide a region
+  // recursively in the calling thread.
+  int SplitRegion(vtkKdNode* kd, float* c1, int* ids, int level);
+  void _DivideRegion(vtkKdNode* kd, float* c1, int* ids, int level);
+
+  // Copy the tree to FlatNodes
+  void BuildFlatNodes();
 
   void DoMedianFind(vtkKdNode* kd, float* c1, int* ids, int d1, int d2, int d3);
 
@@ -884,6 +908,10 @@ protected:
   int* LocatorIds;
   int* LocatorRegionLocation;
 
+  // A copy of the tree in a flat array, used by the point queries. It is
+  // built along with the locator points.
+  vtkKdTreeFlatNode* FlatNodes;
+
   float MaxWidth;
 
   // These Last* values are here to save state so we can
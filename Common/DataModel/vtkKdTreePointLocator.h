@@ -18,6 +18,9 @@
  *
  * vtkKdTreePointLocator is a wrapper class that derives from
  * vtkAbstractPointLocator and calls the search functions in vtkKdTree.
+ * The queries run on the flat copy of the tree built by
+ * vtkKdTree::BuildLocatorFromPoints(), which uses more memory than the
+ * vtkKdNode tree alone (see vtkKdTree).
  *
  * @sa
  * vtkKdTree
@@ -72,6 +75,12 @@ public:
    */
   void FindPointsWithinRadius(double R, const double x[3], vtkIdList* result) override;
 
+  /**
+   * The query methods are thread safe, so the batched queries (e.g.,
+   * FindClosestNPointsBatch()) run in parallel.
+   */
+  bool SupportsConcurrentQueries() override { return true; }
+
   //@{
   /**
    * See vtkLocator interface documentation.
@@ -15,13 +15,131 @@
 #include "vtkMergePoints.h"
 
 #include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
 #include "vtkObjectFactory.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
+
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkMergePoints);
 
+//------------------------------------------------------------------------------
+// Classes support threading.
+namespace
+{
+
+// Pairs of (bucket index, point id) sorted by bucket, then by point id.
+typedef std::pair<vtkIdType, vtkIdType> BucketPoint;
+
+// For each group of points falling into the same bucket, find the previously
+// inserted point with the same coordinates, or else the first point of the
+// group with the same coordinates. T is the type of the coordinates of the
+// locator points.
+template <typename T>
+struct FindDuplicates
+{
+  vtkPoints* Points;
+  const BucketPoint* Order;
+  const vtkIdType* Groups;
+  vtkIdList** HashTable;
+  const T* Inserted;
+  vtkIdType* PtIds;
+  vtkIdType* FirstIds;
+
+  void operator()(vtkIdType group, vtkIdType endGroup)
+  {
+    std::vector<vtkIdType> newIds;
+    std::vector<T> newCoords;
+    double x[3];
+
+    for (; group < endGroup; ++group)
+    {
+      vtkIdList* bucket = this->HashTable[this->Order[this->Groups[group]].first];
+      const vtkIdType nbOfIds = (bucket ? bucket->GetNumberOfIds() : 0);
+      const vtkIdType* idArray = (bucket ? bucket->GetPointer(0) : nullptr);
+      newIds.clear();
+      newCoords.clear();
+
+      for (vtkIdType i = this->Groups[group]; i < this->Groups[group + 1]; ++i)
+      {
+        const vtkIdType ptId = this->Order[i].second;
+        this->Points->GetPoint(ptId, x);
+        const T f[3] = { static_cast<T>(x[0]), static_cast<T>(x[1]), static_cast<T>(x[2]) };
+
+        // Check the list of points in that bucket.
+        vtkIdType j = 0;
+        for (; j < nbOfIds; ++j)
+        {
+          const T* pt = this->Inserted + 3 * idArray[j];
+          if (f[0] == pt[0] && f[1] == pt[1] && f[2] == pt[2])
+          {
+            break;
+          }
+        }
+        if (j < nbOfIds)
+        {
+          this->PtIds[ptId] = idArray[j];
+          this->FirstIds[ptId] = -1;
+          continue;
+        }
+
+        // Then the points of the group which are to be inserted.
+        size_t k = 0;
+        for (; k < newIds.size(); ++k)
+        {
+          const T* pt = newCoords.data() + 3 * k;
+          if (f[0] == pt[0] && f[1] == pt[1] && f[2] == pt[2])
+          {
+            break;
+          }
+        }
+        if (k < newIds.size())
+        {
+          this->FirstIds[ptId] = newIds[k];
+        }
+        else
+        {
+          this->FirstIds[ptId] = ptId;
+          newIds.push_back(ptId);
+          newCoords.insert(newCoords.end(), f, f + 3);
+        }
+      }
+    }
+  }
+};
+
+// Copy the coordinates of the new points into the locator points.
+template <typename T>
+struct StoreNewPoints
+{
+  vtkPoints* Points;
+  const vtkIdType* PtIds;
+  const vtkIdType* FirstIds;
+  T* Inserted;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    double x[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      if (this->FirstIds[ptId] == ptId)
+      {
+        this->Points->GetPoint(ptId, x);
+        T* pt = this->Inserted + 3 * this->PtIds[ptId];
+        pt[0] = static_cast<T>(x[0]);
+        pt[1] = static_cast<T>(x[1]);
+        pt[2] = static_cast<T>(x[2]);
+      }
+    }
+  }
+};
+
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 // Determine whether point given by x[3] has been inserted into points list.
 // Return id of previously inserted point if this is true, otherwise return
@@ -165,6 +283,128 @@ int vtkMergePoints::InsertUniquePoint(const double x[3], vtkIdType& id)
   return 1;
 }
 
+//------------------------------------------------------------------------------
+vtkIdType vtkMergePoints::InsertUniquePoints(vtkPoints* points, vtkIdType* ptIds)
+{
+  vtkDataArray* dataArray = this->Points->GetData();
+  vtkFloatArray* floatArray = vtkFloatArray::FastDownCast(dataArray);
+  vtkDoubleArray* doubleArray = vtkDoubleArray::FastDownCast(dataArray);
+  if (!floatArray && !doubleArray)
+  {
+    return this->Superclass::InsertUniquePoints(points, ptIds);
+  }
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  if (numPts < 1)
+  {
+    return 0;
+  }
+
+  // Sort the points by bucket, keeping the order of the points in each
+  // bucket, and find the groups of points falling into the same bucket.
+  std::vector<BucketPoint> order(numPts);
+  vtkSMPTools::For(0, numPts, [this, points, &order](vtkIdType ptId, vtkIdType endPtId) {
+    double x[3];
+    for (; ptId < endPtId; ++ptId)
+    {
+      points->GetPoint(ptId, x);
+      order[ptId] = BucketPoint(this->GetBucketIndex(x), ptId);
+    }
+  });
+  vtkSMPTools::Sort(order.begin(), order.end());
+  std::vector<vtkIdType> groups(1, 0);
+  for (vtkIdType i = 1; i < numPts; ++i)
+  {
+    if (order[i].first != order[i - 1].first)
+    {
+      groups.push_back(i);
+    }
+  }
+  groups.push_back(numPts);
+  const vtkIdType numGroups = static_cast<vtkIdType>(groups.size()) - 1;
+
+  // Look for the duplicates of each point, in parallel over the buckets.
+  // FirstIds is -1 for the points already inserted (whose ids are set),
+  // otherwise the id of the first point with the same coordinates.
+  std::vector<vtkIdType> firstIds(numPts);
+  if (floatArray)
+  {
+    FindDuplicates<float> find = { points, order.data(), groups.data(), this->HashTable,
+      floatArray->GetPointer(0), ptIds, firstIds.data() };
+    vtkSMPTools::For(0, numGroups, find);
+  }
+  else
+  {
+    FindDuplicates<double> find = { points, order.data(), groups.data(), this->HashTable,
+      doubleArray->GetPointer(0), ptIds, firstIds.data() };
+    vtkSMPTools::For(0, numGroups, find);
+  }
+
+  // Number the new points in order, as InsertUniquePoint() would.
+  vtkIdType lastNewPtId = -1;
+  const vtkIdType firstNewId = this->InsertionPointId;
+  for (vtkIdType ptId = 0; ptId < numPts; ++ptId)
+  {
+    if (firstIds[ptId] == ptId)
+    {
+      ptIds[ptId] = this->InsertionPointId++;
+      lastNewPtId = ptId;
+    }
+    else if (firstIds[ptId] >= 0)
+    {
+      ptIds[ptId] = ptIds[firstIds[ptId]];
+    }
+  }
+  if (lastNewPtId < 0)
+  {
+    return 0;
+  }
+
+  // Store the new points, after allocating them all at once.
+  this->Points->InsertPoint(this->InsertionPointId - 1, points->GetPoint(lastNewPtId));
+  if (floatArray)
+  {
+    StoreNewPoints<float> store = { points, ptIds, firstIds.data(), floatArray->GetPointer(0) };
+    vtkSMPTools::For(0, numPts, store);
+  }
+  else
+  {
+    StoreNewPoints<double> store = { points, ptIds, firstIds.data(), doubleArray->GetPointer(0) };
+    vtkSMPTools::For(0, numPts, store);
+  }
+
+  // Add the new points to their buckets, in parallel over the buckets. Each
+  // bucket is extended in increasing point ids, as in InsertUniquePoint().
+  const BucketPoint* orderPtr = order.data();
+  const vtkIdType* groupsPtr = groups.data();
+  const vtkIdType* firstIdsPtr = firstIds.data();
+  vtkSMPTools::For(0, numGroups,
+    [this, orderPtr, groupsPtr, firstIdsPtr, ptIds](vtkIdType group, vtkIdType endGroup) {
+      for (; group < endGroup; ++group)
+      {
+        const vtkIdType idx = orderPtr[groupsPtr[group]].first;
+        for (vtkIdType i = groupsPtr[group]; i < groupsPtr[group + 1]; ++i)
+        {
+          const vtkIdType ptId = orderPtr[i].second;
+          if (firstIdsPtr[ptId] != ptId)
+          {
+            continue;
+          }
+          vtkIdList* bucket = this->HashTable[idx];
+          if (!bucket)
+          {
+            // create a bucket point list
+            bucket = vtkIdList::New();
+            bucket->Allocate(this->NumberOfPointsPerBucket / 2, this->NumberOfPointsPerBucket / 3);
+            this->HashTable[idx] = bucket;
+          }
+          bucket->InsertNextId(ptIds[ptId]);
+        }
+      }
+    });
+
+  return this->InsertionPointId - firstNewId;
+}
+
 //------------------------------------------------------------------------------
 void vtkMergePoints::PrintSelf(ostream& os, vtkIndent indent)
 {
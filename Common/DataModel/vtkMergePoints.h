@@ -60,6 +60,17 @@ public:
    */
   int InsertUniquePoint(const double x[3], vtkIdType& ptId) override;
 
+  /**
+   * Insert the points of a vtkPoints object in parallel, with the same result
+   * as calling InsertUniquePoint() for each point in order, whatever the
+   * scheduling of the threads. The points are sorted by bucket, and each
+   * bucket is searched and extended by a single thread. The ids of the new
+   * points are then assigned in the order of the points. This requires the
+   * points of the locator to be stored in a vtkFloatArray or a
+   * vtkDoubleArray; otherwise the points are inserted serially.
+   */
+  vtkIdType InsertUniquePoints(vtkPoints* points, vtkIdType* ptIds) override;
+
 protected:
   vtkMergePoints() = default;
   ~vtkMergePoints() override = default;
@@ -161,6 +161,12 @@ public:
    */
   void FindClosestNPoints(int N, const double x[3], vtkIdList* result) override;
 
+  /**
+   * The query methods are thread safe, so the batched queries (e.g.,
+   * FindClosestNPointsBatch()) run in parallel.
+   */
+  bool SupportsConcurrentQueries() override { return true; }
+
   /**
    * Get a list of the original IDs of all points in a leaf node.
    */
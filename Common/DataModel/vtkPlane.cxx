@@ -16,16 +16,28 @@
 
 #include <vtkPoints.h>
 
-#include "vtkArrayDispatch.h"
-#include "vtkDataArrayRange.h"
+#include "vtkImplicitFunctionBatch.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
-#include "vtkSMPTools.h"
-
-#include <algorithm>
 
 vtkStandardNewMacro(vtkPlane);
 
+namespace
+{
+// The plane equation, shared by the single point and the batch evaluations.
+struct PlaneEvaluator
+{
+  double Normal[3];
+  double Origin[3];
+
+  double operator()(const double x[3]) const
+  {
+    return (this->Normal[0] * (x[0] - this->Origin[0]) +
+      this->Normal[1] * (x[1] - this->Origin[1]) + this->Normal[2] * (x[2] - this->Origin[2]));
+  }
+};
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 // Construct plane passing through origin and normal to z-axis.
 vtkPlane::vtkPlane()
@@ -145,8 +157,9 @@ void vtkPlane::GeneralizedProjectPoint(const double x[3], double xproj[3])
 // Evaluate plane equation for point x[3].
 double vtkPlane::EvaluateFunction(double x[3])
 {
-  return (this->Normal[0] * (x[0] - this->Origin[0]) + this->Normal[1] * (x[1] - this->Origin[1]) +
-    this->Normal[2] * (x[2] - this->Origin[2]));
+  const PlaneEvaluator eval = { { this->Normal[0], this->Normal[1], this->Normal[2] },
+    { this->Origin[0], this->Origin[1], this->Origin[2] } };
+  return eval(x);
 }
 
 //------------------------------------------------------------------------------
@@ -229,75 +242,18 @@ int vtkPlane::IntersectWithLine(
   }
 }
 
-// Accelerate plane cutting operation
-namespace
-{
-template <typename InputArrayType, typename OutputArrayType>
-struct CutWorker
-{
-  using InputValueType = vtk::GetAPIType<InputArrayType>;
-  using OutputValueType = vtk::GetAPIType<OutputArrayType>;
-
-  InputArrayType* Input;
-  OutputArrayType* Output;
-  OutputValueType Normal[3];
-  OutputValueType Origin[3];
-
-  CutWorker(InputArrayType* in, OutputArrayType* out)
-    : Input(in)
-    , Output(out)
-  {
-  }
-  void operator()(vtkIdType begin, vtkIdType end)
-  {
-    const auto srcTuples = vtk::DataArrayTupleRange<3>(this->Input, begin, end);
-    auto dstValues = vtk::DataArrayValueRange<1>(this->Output, begin, end);
-
-    using DstTupleCRefType = typename decltype(srcTuples)::ConstTupleReferenceType;
-
-    std::transform(srcTuples.cbegin(), srcTuples.cend(), dstValues.begin(),
-      [&](DstTupleCRefType tuple) -> OutputValueType {
-        return this->Normal[0] * (static_cast<OutputValueType>(tuple[0]) - this->Origin[0]) +
-          this->Normal[1] * (static_cast<OutputValueType>(tuple[1]) - this->Origin[1]) +
-          this->Normal[2] * (static_cast<OutputValueType>(tuple[2]) - this->Origin[2]);
-      });
-  }
-};
-
-struct CutFunctionWorker
-{
-  double Normal[3];
-  double Origin[3];
-  CutFunctionWorker(double n[3], double o[3])
-  {
-    std::copy_n(n, 3, this->Normal);
-    std::copy_n(o, 3, this->Origin);
-  }
-  template <typename InputArrayType, typename OutputArrayType>
-  void operator()(InputArrayType* input, OutputArrayType* output)
-  {
-    VTK_ASSUME(input->GetNumberOfComponents() == 3);
-    VTK_ASSUME(output->GetNumberOfComponents() == 1);
-    vtkIdType numTuples = input->GetNumberOfTuples();
-    CutWorker<InputArrayType, OutputArrayType> cut(input, output);
-    std::copy_n(Normal, 3, cut.Normal);
-    std::copy_n(Origin, 3, cut.Origin);
-    vtkSMPTools::For(0, numTuples, cut);
-  }
-};
-} // end anon namespace
-
 //------------------------------------------------------------------------------
+// Evaluate the plane equation for an array of points, in parallel.
 void vtkPlane::EvaluateFunction(vtkDataArray* input, vtkDataArray* output)
 {
-  CutFunctionWorker worker(this->Normal, this->Origin);
-  typedef vtkTypeList::Create<float, double> InputTypes;
-  typedef vtkTypeList::Create<float, double> OutputTypes;
-  typedef vtkArrayDispatch::Dispatch2ByValueType<InputTypes, OutputTypes> MyDispatch;
-  if (!MyDispatch::Execute(input, output, worker))
+  if (!vtkImplicitFunctionBatch::IsExactly(this))
   {
-    worker(input, output); // Use vtkDataArray API if dispatch fails.
+    this->Superclass::EvaluateFunction(input, output);
+    return;
   }
+  const PlaneEvaluator eval = { { this->Normal[0], this->Normal[1], this->Normal[2] },
+    { this->Origin[0], this->Origin[1], this->Origin[2] } };
+  vtkImplicitFunctionBatch::Evaluate(eval, input, output);
 }
 
 //------------------------------------------------------------------------------
@@ -13,10 +13,29 @@
 
 =========================================================================*/
 #include "vtkQuadric.h"
+#include "vtkImplicitFunctionBatch.h"
 #include "vtkObjectFactory.h"
 
+#include <algorithm>
+
 vtkStandardNewMacro(vtkQuadric);
 
+namespace
+{
+// The quadric equation, shared by the single point and the batch evaluations.
+struct QuadricEvaluator
+{
+  double Coefficients[10];
+
+  double operator()(const double x[3]) const
+  {
+    const double* a = this->Coefficients;
+    return (a[0] * x[0] * x[0] + a[1] * x[1] * x[1] + a[2] * x[2] * x[2] + a[3] * x[0] * x[1] +
+      a[4] * x[1] * x[2] + a[5] * x[0] * x[2] + a[6] * x[0] + a[7] * x[1] + a[8] * x[2] + a[9]);
+  }
+};
+} // anonymous namespace
+
 // Construct quadric with all coefficients = 1.
 vtkQuadric::vtkQuadric()
 {
@@ -71,9 +90,22 @@ void vtkQuadric::SetCoefficients(double a0, double a1, double a2, double a3, dou
 // Evaluate quadric equation.
 double vtkQuadric::EvaluateFunction(double x[3])
 {
-  double* a = this->Coefficients;
-  return (a[0] * x[0] * x[0] + a[1] * x[1] * x[1] + a[2] * x[2] * x[2] + a[3] * x[0] * x[1] +
-    a[4] * x[1] * x[2] + a[5] * x[0] * x[2] + a[6] * x[0] + a[7] * x[1] + a[8] * x[2] + a[9]);
+  QuadricEvaluator eval;
+  std::copy(this->Coefficients, this->Coefficients + 10, eval.Coefficients);
+  return eval(x);
+}
+
+// Evaluate the quadric equation for an array of points, in parallel.
+void vtkQuadric::EvaluateFunction(vtkDataArray* input, vtkDataArray* output)
+{
+  if (!vtkImplicitFunctionBatch::IsExactly(this))
+  {
+    this->Superclass::EvaluateFunction(input, output);
+    return;
+  }
+  QuadricEvaluator eval;
+  std::copy(this->Coefficients, this->Coefficients + 10, eval.Coefficients);
+  vtkImplicitFunctionBatch::Evaluate(eval, input, output);
 }
 
 // Evaluate the gradient to the quadric equation.
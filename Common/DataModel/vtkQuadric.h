@@ -43,6 +43,7 @@ public:
    * Evaluate quadric equation.
    */
   using vtkImplicitFunction::EvaluateFunction;
+  void EvaluateFunction(vtkDataArray* input, vtkDataArray* output) override;
   double EvaluateFunction(double x[3]) override;
   //@}
 
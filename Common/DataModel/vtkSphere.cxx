@@ -13,6 +13,7 @@
 
 =========================================================================*/
 #include "vtkSphere.h"
+#include "vtkImplicitFunctionBatch.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 
@@ -31,14 +32,45 @@ vtkSphere::vtkSphere()
   this->Center[2] = 0.0;
 }
 
+namespace
+{
+// The sphere equation, shared by the single point and the batch evaluations.
+struct SphereEvaluator
+{
+  double Center[3];
+  double Radius;
+
+  double operator()(const double x[3]) const
+  {
+    return (((x[0] - this->Center[0]) * (x[0] - this->Center[0]) +
+              (x[1] - this->Center[1]) * (x[1] - this->Center[1]) +
+              (x[2] - this->Center[2]) * (x[2] - this->Center[2])) -
+      this->Radius * this->Radius);
+  }
+};
+} // anonymous namespace
+
 //------------------------------------------------------------------------------
 // Evaluate sphere equation ((x-x0)^2 + (y-y0)^2 + (z-z0)^2) - R^2.
 double vtkSphere::EvaluateFunction(double x[3])
 {
-  return (((x[0] - this->Center[0]) * (x[0] - this->Center[0]) +
-            (x[1] - this->Center[1]) * (x[1] - this->Center[1]) +
-            (x[2] - this->Center[2]) * (x[2] - this->Center[2])) -
-    this->Radius * this->Radius);
+  const SphereEvaluator eval = { { this->Center[0], this->Center[1], this->Center[2] },
+    this->Radius };
+  return eval(x);
+}
+
+//------------------------------------------------------------------------------
+// Evaluate the sphere equation for an array of points, in parallel.
+void vtkSphere::EvaluateFunction(vtkDataArray* input, vtkDataArray* output)
+{
+  if (!vtkImplicitFunctionBatch::IsExactly(this))
+  {
+    this->Superclass::EvaluateFunction(input, output);
+    return;
+  }
+  const SphereEvaluator eval = { { this->Center[0], this->Center[1], this->Center[2] },
+    this->Radius };
+  vtkImplicitFunctionBatch::Evaluate(eval, input, output);
 }
 
 //------------------------------------------------------------------------------
@@ -140,6 +140,12 @@ public:
    */
   void FindPointsWithinRadius(double R, const double x[3], vtkIdList* result) override;
 
+  /**
+   * The query methods are thread safe, so the batched queries (e.g.,
+   * FindClosestNPointsBatch()) run in parallel.
+   */
+  bool SupportsConcurrentQueries() override { return true; }
+
   /**
    * Intersect the points contained in the locator with the line defined by
    * (a0,a1). Return the point within the tolerance tol that is closest to a0
@@ -0,0 +1,104 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelaunay2DHilbertOrder.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Verify that inserting the points in Hilbert order produces the same
+// triangulation as inserting them in input order (the points are in general
+// position so the Delaunay triangulation is unique).
+
+#include "vtkCellArray.h"
+#include "vtkDelaunay2D.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <set>
+
+namespace
+{
+using TriangleSet = std::set<std::array<vtkIdType, 3>>;
+
+TriangleSet GetTriangles(vtkPolyData* pd)
+{
+  TriangleSet tris;
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkCellArray* polys = pd->GetPolys();
+  for (polys->InitTraversal(); polys->GetNextCell(npts, pts);)
+  {
+    std::array<vtkIdType, 3> tri = { { pts[0], pts[1], pts[2] } };
+    std::sort(tri.begin(), tri.end());
+    tris.insert(tri);
+  }
+  return tris;
+}
+
+bool CompareOrders(vtkPolyData* input, double alpha)
+{
+  vtkNew<vtkDelaunay2D> inputOrder;
+  inputOrder->SetInputData(input);
+  inputOrder->SetAlpha(alpha);
+  inputOrder->SetPointInsertionOrderToInputOrder();
+  inputOrder->Update();
+
+  vtkNew<vtkDelaunay2D> hilbertOrder;
+  hilbertOrder->SetInputData(input);
+  hilbertOrder->SetAlpha(alpha);
+  hilbertOrder->SetPointInsertionOrderToHilbertOrder();
+  hilbertOrder->Update();
+
+  TriangleSet tris0 = GetTriangles(inputOrder->GetOutput());
+  TriangleSet tris1 = GetTriangles(hilbertOrder->GetOutput());
+  if (tris0.empty() || tris0 != tris1)
+  {
+    std::cerr << "Triangulations differ (alpha=" << alpha << "): " << tris0.size() << " vs "
+              << tris1.size() << " triangles" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestDelaunay2DHilbertOrder(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  const vtkIdType numPts = 5000;
+
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1177);
+
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x = random->GetRangeValue(-10.0, 10.0);
+    random->Next();
+    double y = random->GetRangeValue(-5.0, 5.0);
+    random->Next();
+    points->SetPoint(i, x, y, 0.0);
+  }
+
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(points);
+
+  if (!CompareOrders(input, 0.0) || !CompareOrders(input, 0.5))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
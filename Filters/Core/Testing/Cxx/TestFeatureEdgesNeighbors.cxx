@@ -0,0 +1,146 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestFeatureEdgesNeighbors.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Verify the boundary, non-manifold, feature and manifold edges extracted by
+// vtkFeatureEdges against a classification of the edges obtained with
+// vtkPolyData::GetCellEdgeNeighbors().
+
+#include "vtkCellArray.h"
+#include "vtkFeatureEdges.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkNew.h"
+#include "vtkPlaneSource.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkPolygon.h"
+#include "vtkTriangleFilter.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace
+{
+// Count the edges of each kind, the way vtkFeatureEdges used to.
+void ClassifyEdges(vtkPolyData* mesh, double featureAngle, vtkIdType counts[4])
+{
+  counts[0] = counts[1] = counts[2] = counts[3] = 0;
+  const double cosAngle = cos(vtkMath::RadiansFromDegrees(featureAngle));
+  mesh->BuildLinks();
+  vtkNew<vtkIdList> neighbors;
+  vtkIdType npts, neiNpts;
+  const vtkIdType *pts, *neiPts;
+  double n[3], neiN[3];
+  for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); ++cellId)
+  {
+    mesh->GetCellPoints(cellId, npts, pts);
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      mesh->GetCellEdgeNeighbors(cellId, pts[i], pts[(i + 1) % npts], neighbors);
+      const vtkIdType numNei = neighbors->GetNumberOfIds();
+      vtkIdType minNei = VTK_ID_MAX;
+      for (vtkIdType j = 0; j < numNei; ++j)
+      {
+        minNei = std::min(minNei, neighbors->GetId(j));
+      }
+      if (numNei < 1)
+      {
+        counts[0]++;
+      }
+      else if (numNei > 1 && minNei > cellId)
+      {
+        counts[1]++;
+      }
+      else if (numNei == 1 && minNei > cellId)
+      {
+        vtkPolygon::ComputeNormal(mesh->GetPoints(), npts, pts, n);
+        mesh->GetCellPoints(minNei, neiNpts, neiPts);
+        vtkPolygon::ComputeNormal(mesh->GetPoints(), neiNpts, neiPts, neiN);
+        // manifold edges are extracted whether or not they are feature edges
+        counts[2] += (vtkMath::Dot(n, neiN) <= cosAngle ? 1 : 0);
+        counts[3]++;
+      }
+    }
+  }
+}
+
+vtkIdType CountEdges(vtkPolyData* mesh, int type, double featureAngle)
+{
+  vtkNew<vtkFeatureEdges> edges;
+  edges->SetInputData(mesh);
+  edges->SetBoundaryEdges(type == 0);
+  edges->SetNonManifoldEdges(type == 1);
+  edges->SetFeatureEdges(type == 2);
+  edges->SetManifoldEdges(type == 3);
+  edges->SetFeatureAngle(featureAngle);
+  edges->Update();
+  return edges->GetOutput()->GetNumberOfLines();
+}
+}
+
+int TestFeatureEdgesNeighbors(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  // A triangulated, crumpled plane with two extra triangles sharing interior
+  // edges (to create non-manifold edges).
+  vtkNew<vtkPlaneSource> plane;
+  plane->SetResolution(12, 9);
+  vtkNew<vtkTriangleFilter> triangles;
+  triangles->SetInputConnection(plane->GetOutputPort());
+  triangles->Update();
+
+  vtkNew<vtkPoints> points;
+  points->DeepCopy(triangles->GetOutput()->GetPoints());
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    points->GetPoint(i, x);
+    x[2] = ((i * 7) % 5) * 0.02;
+    points->SetPoint(i, x);
+  }
+  vtkIdType apex = points->InsertNextPoint(0.0, 0.0, 1.0);
+
+  vtkNew<vtkCellArray> polys;
+  polys->DeepCopy(triangles->GetOutput()->GetPolys());
+  vtkIdType npts;
+  const vtkIdType* pts;
+  for (vtkIdType cellId : { 10, 57 })
+  {
+    polys->GetCellAtId(cellId, npts, pts);
+    vtkIdType tri[3] = { pts[0], pts[1], apex };
+    polys->InsertNextCell(3, tri);
+  }
+
+  vtkNew<vtkPolyData> mesh;
+  mesh->SetPoints(points);
+  mesh->SetPolys(polys);
+
+  const double featureAngle = 10.0;
+  vtkIdType expected[4];
+  ClassifyEdges(mesh, featureAngle, expected);
+
+  int status = EXIT_SUCCESS;
+  const char* names[4] = { "boundary", "non-manifold", "feature", "manifold" };
+  for (int type = 0; type < 4; ++type)
+  {
+    vtkIdType count = CountEdges(mesh, type, featureAngle);
+    if (count != expected[type] || expected[type] == 0)
+    {
+      std::cerr << "Expected " << expected[type] << " " << names[type] << " edges, got " << count
+                << std::endl;
+      status = EXIT_FAILURE;
+    }
+  }
+
+  return status;
+}
@@ -0,0 +1,144 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestImplicitPolyDataDistanceBatch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the batch evaluation of vtkImplicitPolyDataDistance against the
+// evaluation of single points.
+
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIdList.h"
+#include "vtkImplicitPolyDataDistance.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+
+#include <iostream>
+
+namespace
+{
+// Shifts the distance; the batch evaluation must not bypass the override.
+class vtkShiftedPolyDataDistance : public vtkImplicitPolyDataDistance
+{
+public:
+  static vtkShiftedPolyDataDistance* New();
+  vtkTypeMacro(vtkShiftedPolyDataDistance, vtkImplicitPolyDataDistance);
+
+  using Superclass::EvaluateFunction;
+  double EvaluateFunction(double x[3]) override
+  {
+    return this->Superclass::EvaluateFunction(x) + 1.0;
+  }
+
+protected:
+  vtkShiftedPolyDataDistance() = default;
+};
+vtkStandardNewMacro(vtkShiftedPolyDataDistance);
+}
+
+int TestImplicitPolyDataDistanceBatch(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(1.0);
+  sphere->SetThetaResolution(40);
+  sphere->SetPhiResolution(30);
+  sphere->Update();
+  vtkPolyData* surface = sphere->GetOutput();
+
+  vtkNew<vtkImplicitPolyDataDistance> distance;
+  distance->SetInput(surface);
+
+  // Random points inside and outside of the sphere, and the points of the
+  // sphere themselves (the vertex case).
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(5113);
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  for (int i = 0; i < 5000; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetRangeValue(-1.0, 1.0);
+      random->Next();
+    }
+    points->InsertNextPoint(x);
+  }
+  for (vtkIdType i = 0; i < surface->GetNumberOfPoints(); ++i)
+  {
+    points->InsertNextPoint(surface->GetPoint(i));
+  }
+
+  vtkNew<vtkDoubleArray> distances;
+  vtkNew<vtkPoints> closestPoints;
+  closestPoints->SetDataTypeToDouble();
+  vtkNew<vtkIdList> cellIds;
+  distance->EvaluateFunctionAndGetClosestPoints(points, distances, closestPoints, cellIds);
+
+  vtkNew<vtkFloatArray> values;
+  distance->FunctionValue(points->GetData(), values);
+
+  int numInside = 0;
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    double x[3], closestPoint[3];
+    points->GetPoint(i, x);
+    double value = distance->EvaluateFunctionAndGetClosestPoint(x, closestPoint);
+    double* batchPoint = closestPoints->GetPoint(i);
+    if (value != distances->GetValue(i) || closestPoint[0] != batchPoint[0] ||
+      closestPoint[1] != batchPoint[1] || closestPoint[2] != batchPoint[2])
+    {
+      std::cerr << "Point " << i << ": batch distance " << distances->GetValue(i) << ", expected "
+                << value << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (values->GetValue(i) != static_cast<float>(value))
+    {
+      std::cerr << "Point " << i << ": function value " << values->GetValue(i) << ", expected "
+                << value << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (cellIds->GetId(i) < 0 || cellIds->GetId(i) >= surface->GetNumberOfCells())
+    {
+      std::cerr << "Point " << i << ": bad closest cell " << cellIds->GetId(i) << std::endl;
+      return EXIT_FAILURE;
+    }
+    numInside += (value < 0.0 ? 1 : 0);
+  }
+
+  vtkNew<vtkShiftedPolyDataDistance> shifted;
+  shifted->SetInput(surface);
+  vtkNew<vtkDoubleArray> shiftedValues;
+  shifted->EvaluateFunction(points->GetData(), shiftedValues);
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    if (shiftedValues->GetValue(i) != distances->GetValue(i) + 1.0)
+    {
+      std::cerr << "Point " << i << ": overridden value " << shiftedValues->GetValue(i)
+                << ", expected " << distances->GetValue(i) + 1.0 << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // About half of the random points lie in the unit sphere.
+  if (numInside < 2000 || numInside > 3000)
+  {
+    std::cerr << "Unexpected number of points inside the sphere: " << numInside << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,207 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestProbeFilterFindCells.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test the batched vtkProbeFilter::FindCells() against vtkDataSet::FindCell(),
+// and probing of an unstructured grid with a linear field (which must be
+// reproduced exactly at the probed points).
+
+#include "vtkCellLocatorStrategy.h"
+#include "vtkCharArray.h"
+#include "vtkDelaunay3D.h"
+#include "vtkDoubleArray.h"
+#include "vtkIdList.h"
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkProbeFilter.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+double LinearField(const double x[3])
+{
+  return 1.0 + 2.0 * x[0] - 3.0 * x[1] + 0.5 * x[2];
+}
+
+void RandomPoints(vtkMinimalStandardRandomSequence* random, vtkIdType numPts, double range,
+  vtkPoints* points)
+{
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetRangeValue(-range, range);
+      random->Next();
+    }
+    points->SetPoint(i, x);
+  }
+}
+
+int CheckFindCells(vtkUnstructuredGrid* source, vtkPoints* queries, vtkProbeFilter* probe)
+{
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> pcoords;
+  vtkNew<vtkDoubleArray> weights;
+  probe->FindCells(source, queries, cellIds, pcoords, weights);
+  if (cellIds->GetNumberOfIds() != queries->GetNumberOfPoints() ||
+    weights->GetNumberOfComponents() != source->GetMaxCellSize())
+  {
+    std::cerr << "Unexpected size of FindCells() results" << std::endl;
+    return 0;
+  }
+
+  vtkIdType numFound = 0;
+  for (vtkIdType i = 0; i < queries->GetNumberOfPoints(); ++i)
+  {
+    double x[3], pc[3], w[4];
+    int subId;
+    queries->GetPoint(i, x);
+    vtkIdType cellId = source->FindCell(x, nullptr, -1, 0.0, subId, pc, w);
+    if ((cellId >= 0) != (cellIds->GetId(i) >= 0))
+    {
+      std::cerr << "Point " << i << ": found cell " << cellIds->GetId(i) << ", expected "
+                << cellId << std::endl;
+      return 0;
+    }
+    if (cellId >= 0)
+    {
+      ++numFound;
+      // Interpolating the cell points with the weights must give back x
+      double y[3] = { 0.0, 0.0, 0.0 };
+      vtkIdType npts;
+      const vtkIdType* pts;
+      source->GetCellPoints(cellIds->GetId(i), npts, pts);
+      for (vtkIdType j = 0; j < npts; ++j)
+      {
+        double p[3];
+        source->GetPoint(pts[j], p);
+        for (int k = 0; k < 3; ++k)
+        {
+          y[k] += weights->GetComponent(i, j) * p[k];
+        }
+      }
+      if (vtkMath::Distance2BetweenPoints(x, y) > 1e-12)
+      {
+        std::cerr << "Point " << i << ": wrong interpolation weights" << std::endl;
+        return 0;
+      }
+    }
+  }
+  if (numFound == 0)
+  {
+    std::cerr << "No query point found in the source" << std::endl;
+    return 0;
+  }
+  return 1;
+}
+
+int CheckProbe(vtkUnstructuredGrid* source, vtkPoints* queries, vtkProbeFilter* probe)
+{
+  vtkNew<vtkPolyData> input;
+  input->SetPoints(queries);
+  probe->SetInputData(input);
+  probe->SetSourceData(source);
+  probe->Update();
+
+  vtkDataSet* output = probe->GetOutput();
+  vtkDataArray* values = output->GetPointData()->GetArray("Linear");
+  vtkCharArray* mask = vtkArrayDownCast<vtkCharArray>(
+    output->GetPointData()->GetArray(probe->GetValidPointMaskArrayName()));
+  if (!values || !mask)
+  {
+    std::cerr << "Missing probed arrays" << std::endl;
+    return 0;
+  }
+
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkDoubleArray> pcoords;
+  vtkNew<vtkDoubleArray> weights;
+  probe->FindCells(source, queries, cellIds, pcoords, weights);
+  for (vtkIdType i = 0; i < queries->GetNumberOfPoints(); ++i)
+  {
+    if ((mask->GetValue(i) == 1) != (cellIds->GetId(i) >= 0))
+    {
+      std::cerr << "Point " << i << ": wrong valid point mask" << std::endl;
+      return 0;
+    }
+    double x[3];
+    queries->GetPoint(i, x);
+    if (mask->GetValue(i) == 1 && std::abs(values->GetTuple1(i) - LinearField(x)) > 1e-6)
+    {
+      std::cerr << "Point " << i << ": probed " << values->GetTuple1(i) << ", expected "
+                << LinearField(x) << std::endl;
+      return 0;
+    }
+  }
+  return 1;
+}
+}
+
+int TestProbeFilterFindCells(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(5511);
+
+  // A tetrahedral mesh with a linear field
+  vtkNew<vtkPoints> meshPoints;
+  RandomPoints(random, 2000, 1.0, meshPoints);
+  vtkNew<vtkDoubleArray> linear;
+  linear->SetName("Linear");
+  linear->SetNumberOfTuples(meshPoints->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < meshPoints->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    meshPoints->GetPoint(i, x);
+    linear->SetValue(i, LinearField(x));
+  }
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(meshPoints);
+  cloud->GetPointData()->AddArray(linear);
+
+  vtkNew<vtkDelaunay3D> delaunay;
+  delaunay->SetInputData(cloud);
+  delaunay->Update();
+  vtkUnstructuredGrid* source = delaunay->GetOutput();
+
+  // Query points, some of which are outside of the mesh
+  vtkNew<vtkPoints> queries;
+  RandomPoints(random, 5000, 1.1, queries);
+
+  vtkNew<vtkProbeFilter> probe;
+  probe->SetComputeTolerance(false);
+  probe->SetTolerance(0.0);
+  if (!CheckFindCells(source, queries, probe) || !CheckProbe(source, queries, probe))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // Same with a cell locator
+  vtkNew<vtkCellLocatorStrategy> strategy;
+  probe->SetFindCellStrategy(strategy);
+  if (!CheckProbe(source, queries, probe))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSmoothPolyDataFilterParallel.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Smooth a noisy sphere, with and without a source, moving the points in
+// place and with ParallelIterations on, and check that both schemes smooth
+// the sphere about the same way.
+
+#include "vtkMath.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmoothPolyDataFilter.h"
+#include "vtkSphereSource.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+// Return the largest distance between the points of the two datasets.
+double MaxDistance(vtkPolyData* pd1, vtkPolyData* pd2)
+{
+  double maxDist = 0.0;
+  for (vtkIdType i = 0; i < pd1->GetNumberOfPoints(); ++i)
+  {
+    double x1[3], x2[3];
+    pd1->GetPoint(i, x1);
+    pd2->GetPoint(i, x2);
+    maxDist = std::max(maxDist, std::sqrt(vtkMath::Distance2BetweenPoints(x1, x2)));
+  }
+  return maxDist;
+}
+}
+
+int TestSmoothPolyDataFilterParallel(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(60);
+  sphere->SetPhiResolution(40);
+  sphere->Update();
+
+  vtkNew<vtkPolyData> noisy;
+  noisy->DeepCopy(sphere->GetOutput());
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(1);
+  for (vtkIdType i = 0; i < noisy->GetNumberOfPoints(); ++i)
+  {
+    double x[3];
+    noisy->GetPoint(i, x);
+    for (int k = 0; k < 3; ++k)
+    {
+      x[k] += random->GetRangeValue(-0.02, 0.02);
+      random->Next();
+    }
+    noisy->GetPoints()->SetPoint(i, x);
+  }
+
+  for (int constrained = 0; constrained < 2; ++constrained)
+  {
+    vtkNew<vtkSmoothPolyDataFilter> smooth[2];
+    for (int parallel = 0; parallel < 2; ++parallel)
+    {
+      smooth[parallel]->SetInputData(noisy);
+      if (constrained)
+      {
+        smooth[parallel]->SetSourceData(sphere->GetOutput());
+      }
+      smooth[parallel]->SetNumberOfIterations(50);
+      smooth[parallel]->SetRelaxationFactor(0.1);
+      smooth[parallel]->FeatureEdgeSmoothingOn();
+      smooth[parallel]->SetParallelIterations(parallel);
+      smooth[parallel]->Update();
+    }
+
+    const double moved = MaxDistance(noisy, smooth[0]->GetOutput());
+    const double difference = MaxDistance(smooth[0]->GetOutput(), smooth[1]->GetOutput());
+    if (moved < 1e-3 || difference > 1e-3)
+    {
+      std::cerr << "Wrong parallel smoothing" << (constrained ? " on the source" : "")
+                << ": points moved by " << moved << ", " << difference
+                << " from the in place smoothing" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
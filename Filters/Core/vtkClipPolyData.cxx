@@ -155,11 +155,7 @@ int vtkClipPolyData::RequestData(vtkInformation* vtkNotUsed(request),
     {
       inPD->SetScalars(tmpScalars);
     }
-    for (i = 0; i < numPts; i++)
-    {
-      s = this->ClipFunction->FunctionValue(inPts->GetPoint(i));
-      tmpScalars->SetComponent(i, 0, s);
-    }
+    this->ClipFunction->FunctionValue(inPts->GetData(), tmpScalars);
     clipScalars = tmpScalars;
   }
   else // using input scalars
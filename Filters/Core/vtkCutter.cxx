@@ -150,14 +150,7 @@ void vtkCutter::StructuredPointsCutter(vtkDataSet* dataSetInput, vtkPolyData* th
     contourData->GetPointData()->AddArray(cutScalars);
   }
 
-  double scalar;
-  double x[3];
-  for (vtkIdType i = 0; i < numPts; i++)
-  {
-    input->GetPoint(i, x);
-    scalar = this->CutFunction->FunctionValue(x);
-    cutScalars->SetComponent(i, 0, scalar);
-  }
+  this->CutFunction->FunctionValue(input, cutScalars);
 
   this->SynchronizedTemplates3D->SetInputData(contourData);
   this->SynchronizedTemplates3D->SetInputArrayToProcess(
@@ -265,13 +258,7 @@ void vtkCutter::RectilinearGridCutter(vtkDataSet* dataSetInput, vtkPolyData* thi
     contourData->GetPointData()->AddArray(cutScalars);
   }
 
-  for (vtkIdType i = 0; i < numPts; i++)
-  {
-    double x[3];
-    input->GetPoint(i, x);
-    double scalar = this->CutFunction->FunctionValue(x);
-    cutScalars->SetComponent(i, 0, scalar);
-  }
+  this->CutFunction->FunctionValue(input, cutScalars);
   vtkIdType numContours = this->GetNumberOfContours();
 
   this->RectilinearSynchronizedTemplates->SetInputData(contourData);
@@ -555,15 +542,9 @@ void vtkCutter::DataSetCutter(vtkDataSet* input, vtkPolyData* output)
   }
   this->Locator->InitPointInsertion(newPoints, input->GetBounds());
 
-  // Loop over all points evaluating scalar function at each point
+  // Evaluate the scalar function at all points
   //
-  for (vtkIdType i = 0; i < numPts; ++i)
-  {
-    double x[3];
-    input->GetPoint(i, x);
-    double s = this->CutFunction->FunctionValue(x);
-    cutScalars->SetComponent(i, 0, s);
-  }
+  this->CutFunction->FunctionValue(input, cutScalars);
 
   // Compute some information for progress methods
   //
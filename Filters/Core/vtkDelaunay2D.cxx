@@ -25,14 +25,112 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTransform.h"
 #include "vtkTriangle.h"
 
 #include <set>
+#include <utility>
 #include <vector>
 
 vtkStandardNewMacro(vtkDelaunay2D);
+
+namespace
+{
+
+// Number of bits per axis used to quantize points onto the Hilbert curve.
+constexpr int HilbertOrder = 16;
+
+// Map a point quantized onto the 2^16 x 2^16 lattice to its distance along a
+// 2D Hilbert curve.
+vtkTypeUInt64 HilbertIndex(vtkTypeUInt32 x, vtkTypeUInt32 y)
+{
+  const vtkTypeUInt32 n = 1u << HilbertOrder;
+  vtkTypeUInt64 d = 0;
+  for (vtkTypeUInt32 s = n / 2; s > 0; s /= 2)
+  {
+    vtkTypeUInt32 rx = (x & s) > 0 ? 1 : 0;
+    vtkTypeUInt32 ry = (y & s) > 0 ? 1 : 0;
+    d += static_cast<vtkTypeUInt64>(s) * s * ((3 * rx) ^ ry);
+
+    // Rotate the quadrant so the sub-curve has the proper orientation
+    if (ry == 0)
+    {
+      if (rx == 1)
+      {
+        x = n - 1 - x;
+        y = n - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return d;
+}
+
+// Compute the (Hilbert key, point id) pairs used to spatially sort the points
+// prior to insertion. Only the x-y coordinates are used since the
+// triangulation is performed in the x-y plane.
+struct ComputeHilbertKeys
+{
+  const double* Points;
+  std::pair<vtkTypeUInt64, vtkIdType>* Keys;
+  double Origin[2];
+  double Scale[2];
+
+  ComputeHilbertKeys(
+    const double* pts, const double bounds[6], std::pair<vtkTypeUInt64, vtkIdType>* keys)
+    : Points(pts)
+    , Keys(keys)
+  {
+    const double maxLattice = static_cast<double>((1u << HilbertOrder) - 1);
+    for (int i = 0; i < 2; ++i)
+    {
+      const double length = bounds[2 * i + 1] - bounds[2 * i];
+      this->Origin[i] = bounds[2 * i];
+      this->Scale[i] = (length > 0.0 ? maxLattice / length : 0.0);
+    }
+  }
+
+  vtkTypeUInt32 Quantize(double x, int axis) const
+  {
+    const double t = (x - this->Origin[axis]) * this->Scale[axis];
+    const double maxLattice = static_cast<double>((1u << HilbertOrder) - 1);
+    return static_cast<vtkTypeUInt32>(t < 0.0 ? 0.0 : (t > maxLattice ? maxLattice : t));
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    const double* x = this->Points + 3 * ptId;
+    for (; ptId < endPtId; ++ptId, x += 3)
+    {
+      this->Keys[ptId].first = HilbertIndex(this->Quantize(x[0], 0), this->Quantize(x[1], 1));
+      this->Keys[ptId].second = ptId;
+    }
+  }
+};
+
+// Produce a permutation of the point ids [0,numPts) ordered along a Hilbert
+// curve. Ties are broken by point id so that the ordering is deterministic
+// regardless of the number of threads used.
+void SpatiallySortPoints(
+  const double* pts, vtkIdType numPts, const double bounds[6], std::vector<vtkIdType>& order)
+{
+  std::vector<std::pair<vtkTypeUInt64, vtkIdType>> keys(numPts);
+  ComputeHilbertKeys computeKeys(pts, bounds, keys.data());
+  vtkSMPTools::For(0, numPts, computeKeys);
+  vtkSMPTools::Sort(keys.begin(), keys.end());
+
+  order.resize(numPts);
+  vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      order[ptId] = keys[ptId].second;
+    }
+  });
+}
+
+} // anonymous namespace
 vtkCxxSetObjectMacro(vtkDelaunay2D, Transform, vtkAbstractTransform);
 
 // Construct object with Alpha = 0.0; Tolerance = 0.00001; Offset = 1.25;
@@ -45,6 +143,7 @@ vtkDelaunay2D::vtkDelaunay2D()
   this->Offset = 1.0;
   this->Transform = nullptr;
   this->ProjectionPlaneMode = VTK_DELAUNAY_XY_PLANE;
+  this->PointInsertionOrder = INPUT_ORDER;
 
   // optional 2nd input
   this->SetNumberOfInputPorts(2);
@@ -321,6 +420,7 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   double center[3], radius, tol, x[3];
   double n1[3], n2[3];
   int* triUse = nullptr;
+  std::vector<vtkIdType> insertionOrder;
 
   vtkDebugMacro(<< "Generating 2D Delaunay triangulation");
 
@@ -406,7 +506,8 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
     tPoints = nullptr;
   }
 
-  const double* bounds = points->GetBounds();
+  double bounds[6];
+  points->GetBounds(bounds);
   center[0] = (bounds[0] + bounds[1]) / 2.0;
   center[1] = (bounds[2] + bounds[3]) / 2.0;
   center[2] = (bounds[4] + bounds[5]) / 2.0;
@@ -424,6 +525,13 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   // We do this for speed accessing points
   this->Points = static_cast<vtkDoubleArray*>(points->GetData())->GetPointer(0);
 
+  // Optionally sort the points spatially so that successive point insertions
+  // only walk a short distance through the mesh.
+  if (this->PointInsertionOrder == HILBERT_ORDER)
+  {
+    SpatiallySortPoints(this->Points, numPoints, bounds, insertionOrder);
+  }
+
   triangles = vtkCellArray::New();
   triangles->AllocateEstimate(2 * numPoints, 3);
 
@@ -463,8 +571,9 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
   // satisfy criterion have their edges swapped. This continues recursively
   // until all triangles have been shown to be Delaunay.
   //
-  for (ptId = 0; ptId < numPoints; ptId++)
+  for (vtkIdType ptNum = 0; ptNum < numPoints; ptNum++)
   {
+    ptId = (insertionOrder.empty() ? ptNum : insertionOrder[ptNum]);
     this->GetPoint(ptId, x);
     nei[0] = (-1); // where we are coming from...nowhere initially
 
@@ -559,10 +668,10 @@ int vtkDelaunay2D::RequestData(vtkInformation* vtkNotUsed(request),
       tri[0] = 0; // no triangle found
     }
 
-    if (!(ptId % 1000))
+    if (!(ptNum % 1000))
     {
-      vtkDebugMacro(<< "point #" << ptId);
-      this->UpdateProgress(static_cast<double>(ptId) / numPoints);
+      vtkDebugMacro(<< "point #" << ptNum);
+      this->UpdateProgress(static_cast<double>(ptNum) / numPoints);
       if (this->GetAbortExecute())
       {
         break;
@@ -1608,4 +1717,6 @@ void vtkDelaunay2D::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Tolerance: " << this->Tolerance << "\n";
   os << indent << "Offset: " << this->Offset << "\n";
   os << indent << "Bounding Triangulation: " << (this->BoundingTriangulation ? "On\n" : "Off\n");
+  os << indent << "Point Insertion Order: "
+     << (this->PointInsertionOrder == HILBERT_ORDER ? "Hilbert Order\n" : "Input Order\n");
 }
@@ -245,6 +245,37 @@ public:
   vtkGetMacro(ProjectionPlaneMode, int);
   //@}
 
+  /**
+   * Control the order in which the input points are inserted into the
+   * triangulation. Each point is located by walking through the mesh from
+   * the triangle found for the previously inserted point, so scattered
+   * input point orderings (e.g., survey data) lead to long walks and
+   * quadratic-like run times. With HILBERT_ORDER the points are first
+   * sorted (in parallel) along a 2D Hilbert curve covering the
+   * triangulation plane, so successive points are spatially close and the
+   * walk is short. The output point ids are not changed, and constraints
+   * (the Source input), Alpha and Tolerance are processed as before. Note
+   * however that degenerate configurations (e.g., points on a regular
+   * lattice) may be triangulated differently, and that which of several
+   * coincident points is retained may differ, since both depend on the
+   * insertion order. By default INPUT_ORDER is used.
+   */
+  enum PointInsertionOrderType
+  {
+    INPUT_ORDER = 0,
+    HILBERT_ORDER = 1
+  };
+
+  //@{
+  /**
+   * Specify the point insertion order (see PointInsertionOrderType).
+   */
+  vtkSetClampMacro(PointInsertionOrder, int, INPUT_ORDER, HILBERT_ORDER);
+  vtkGetMacro(PointInsertionOrder, int);
+  void SetPointInsertionOrderToInputOrder() { this->SetPointInsertionOrder(INPUT_ORDER); }
+  void SetPointInsertionOrderToHilbertOrder() { this->SetPointInsertionOrder(HILBERT_ORDER); }
+  //@}
+
   /**
    * This method computes the best fit plane to a set of points represented
    * by a vtkPointSet. The method constructs a transform and returns it on
@@ -269,6 +300,8 @@ protected:
   int ProjectionPlaneMode; // selects the plane in 3D where the Delaunay triangulation will be
                            // computed.
 
+  int PointInsertionOrder; // selects the order in which points are inserted
+
 private:
   vtkPolyData* Mesh; // the created mesh
   double* Points;    // the raw points in double precision
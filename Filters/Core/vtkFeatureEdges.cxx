@@ -26,6 +26,9 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkPolygonEdgeNeighborsInternal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleStrip.h"
 #include "vtkUnsignedCharArray.h"
@@ -74,11 +77,10 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
   vtkPoints* newPts;
   vtkFloatArray* newScalars = nullptr;
   vtkCellArray* newLines;
-  vtkPolyData* Mesh;
   int i;
-  vtkIdType j, numNei, cellId;
+  vtkIdType numNei, cellId;
   vtkIdType numBEdges, numNonManifoldEdges, numFedges, numManifoldEdges;
-  double scalar, n[3], x1[3], x2[3];
+  double scalar, x1[3], x2[3];
   double cosAngle = 0;
   vtkIdType lineIds[2];
   vtkIdType npts = 0;
@@ -86,7 +88,6 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
   vtkCellArray *inPolys, *inStrips, *newPolys;
   vtkFloatArray* polyNormals = nullptr;
   vtkIdType numPts, numCells, numPolys, numStrips, nei;
-  vtkIdList* neighbors;
   vtkIdType p1, p2, newId;
   vtkPointData *pd = input->GetPointData(), *outPD = output->GetPointData();
   vtkCellData *cd = input->GetCellData(), *outCD = output->GetCellData();
@@ -126,8 +127,6 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
   }
 
   // Build cell structure.  Might have to triangulate the strips.
-  Mesh = vtkPolyData::New();
-  Mesh->SetPoints(inPts);
   inPolys = input->GetPolys();
   if (numStrips > 0)
   {
@@ -145,15 +144,17 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
     {
       vtkTriangleStrip::DecomposeStrip(npts, pts, newPolys);
     }
-    Mesh->SetPolys(newPolys);
-    newPolys->Delete();
   }
   else
   {
     newPolys = inPolys;
-    Mesh->SetPolys(newPolys);
+    newPolys->Register(this);
   }
-  Mesh->BuildLinks();
+
+  // Determine the cells sharing each polygon edge. This is done once, in
+  // parallel, rather than querying the neighbors of each edge one at a time.
+  PolygonEdgeNeighbors edgeNeighbors;
+  edgeNeighbors.Build(newPolys);
 
   // Allocate storage for lines/points (arbitrary allocation sizes)
   //
@@ -201,20 +202,24 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
   {
     polyNormals = vtkFloatArray::New();
     polyNormals->SetNumberOfComponents(3);
-    polyNormals->Allocate(3 * newPolys->GetNumberOfCells());
+    polyNormals->SetNumberOfTuples(newPolys->GetNumberOfCells());
 
-    for (cellId = 0, newPolys->InitTraversal(); newPolys->GetNextCell(npts, pts); cellId++)
-    {
-      vtkPolygon::ComputeNormal(inPts, npts, pts, n);
-      polyNormals->InsertTuple(cellId, n);
-    }
+    vtkSMPThreadLocalObject<vtkIdList> cellPts;
+    vtkSMPTools::For(0, newPolys->GetNumberOfCells(), [&](vtkIdType polyId, vtkIdType endPolyId) {
+      vtkIdList* polyPts = cellPts.Local();
+      double normal[3];
+      for (; polyId < endPolyId; ++polyId)
+      {
+        newPolys->GetCellAtId(polyId, polyPts);
+        vtkPolygon::ComputeNormal(
+          inPts, polyPts->GetNumberOfIds(), polyPts->GetPointer(0), normal);
+        polyNormals->SetTuple(polyId, normal);
+      }
+    });
 
     cosAngle = cos(vtkMath::RadiansFromDegrees(this->FeatureAngle));
   }
 
-  neighbors = vtkIdList::New();
-  neighbors->Allocate(VTK_CELL_SIZE);
-
   int abort = 0;
   vtkIdType progressInterval = numCells / 20 + 1;
 
@@ -232,8 +237,8 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
       p1 = pts[i];
       p2 = pts[(i + 1) % npts];
 
-      Mesh->GetCellEdgeNeighbors(cellId, p1, p2, neighbors);
-      numNei = neighbors->GetNumberOfIds();
+      numNei = edgeNeighbors.GetNumberOfNeighbors(cellId, i);
+      nei = edgeNeighbors.GetNeighbor(cellId, i);
 
       if (this->BoundaryEdges && numNei < 1)
       {
@@ -251,14 +256,7 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
       else if (this->NonManifoldEdges && numNei > 1)
       {
         // check to make sure that this edge hasn't been created before
-        for (j = 0; j < numNei; j++)
-        {
-          if (neighbors->GetId(j) < cellId)
-          {
-            break;
-          }
-        }
-        if (j >= numNei)
+        if (nei > cellId)
         {
           if (ghosts && ghosts[cellId] & vtkDataSetAttributes::DUPLICATECELL)
           {
@@ -275,7 +273,7 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
           continue;
         }
       }
-      else if (this->FeatureEdges && numNei == 1 && (nei = neighbors->GetId(0)) > cellId)
+      else if (this->FeatureEdges && numNei == 1 && nei > cellId)
       {
         double neiTuple[3];
         double cellTuple[3];
@@ -298,7 +296,7 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
           continue;
         }
       }
-      else if (this->ManifoldEdges && numNei == 1 && neighbors->GetId(0) > cellId)
+      else if (this->ManifoldEdges && numNei == 1 && nei > cellId)
       {
         if (ghosts && ghosts[cellId] & vtkDataSetAttributes::DUPLICATECELL)
         {
@@ -316,8 +314,8 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
       }
 
       // Add edge to output
-      Mesh->GetPoint(p1, x1);
-      Mesh->GetPoint(p2, x2);
+      inPts->GetPoint(p1, x1);
+      inPts->GetPoint(p2, x2);
 
       if (this->Locator->InsertUniquePoint(x1, lineIds[0]))
       {
@@ -349,11 +347,10 @@ int vtkFeatureEdges::RequestData(vtkInformation* vtkNotUsed(request),
     polyNormals->Delete();
   }
 
-  Mesh->Delete();
+  newPolys->UnRegister(this);
 
   output->SetPoints(newPts);
   newPts->Delete();
-  neighbors->Delete();
 
   output->SetLines(newLines);
   newLines->Delete();
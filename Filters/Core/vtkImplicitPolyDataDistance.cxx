@@ -14,16 +14,24 @@
 =========================================================================*/
 #include "vtkImplicitPolyDataDistance.h"
 
-#include "vtkCellData.h"
+#include "vtkBVHCellLocator.h"
 #include "vtkCellLocator.h"
+#include "vtkCellData.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkTriangleFilter.h"
 
+#include <typeinfo>
+
 vtkStandardNewMacro(vtkImplicitPolyDataDistance);
 
 //------------------------------------------------------------------------------
@@ -40,7 +48,10 @@ vtkImplicitPolyDataDistance::vtkImplicitPolyDataDistance()
   this->NoValue = 0.0;
 
   this->Input = nullptr;
+#if !defined(VTK_LEGACY_REMOVE)
   this->Locator = nullptr;
+#endif
+  this->BVHLocator = nullptr;
   this->Tolerance = 1e-12;
 }
 
@@ -65,12 +76,16 @@ void vtkImplicitPolyDataDistance::SetInput(vtkPolyData* input)
     this->NoValue = this->Input->GetLength();
 
     this->CreateDefaultLocator();
-    this->Locator->SetDataSet(this->Input);
-    this->Locator->SetTolerance(this->Tolerance);
-    this->Locator->SetNumberOfCellsPerBucket(10);
-    this->Locator->CacheCellBoundsOn();
-    this->Locator->AutomaticOn();
-    this->Locator->BuildLocator();
+    this->BVHLocator->SetDataSet(this->Input);
+    this->BVHLocator->SetTolerance(this->Tolerance);
+    this->BVHLocator->BuildLocator();
+#if !defined(VTK_LEGACY_REMOVE)
+    if (this->Locator)
+    {
+      // built again over the new input by GetLocator(), if it is called
+      this->Locator->SetDataSet(nullptr);
+    }
+#endif
   }
 }
 
@@ -92,21 +107,52 @@ vtkMTimeType vtkImplicitPolyDataDistance::GetMTime()
 //------------------------------------------------------------------------------
 vtkImplicitPolyDataDistance::~vtkImplicitPolyDataDistance()
 {
+  if (this->BVHLocator)
+  {
+    this->BVHLocator->UnRegister(this);
+    this->BVHLocator = nullptr;
+  }
+#if !defined(VTK_LEGACY_REMOVE)
   if (this->Locator)
   {
     this->Locator->UnRegister(this);
     this->Locator = nullptr;
   }
+#endif
 }
 
 //------------------------------------------------------------------------------
 void vtkImplicitPolyDataDistance::CreateDefaultLocator()
 {
+  if (this->BVHLocator == nullptr)
+  {
+    this->BVHLocator = vtkBVHCellLocator::New();
+  }
+}
+
+//------------------------------------------------------------------------------
+#if !defined(VTK_LEGACY_REMOVE)
+vtkCellLocator* vtkImplicitPolyDataDistance::GetLocator()
+{
+  VTK_LEGACY_REPLACED_BODY(
+    vtkImplicitPolyDataDistance::GetLocator, "VTK 9.0", vtkImplicitPolyDataDistance::BVHLocator);
+
   if (this->Locator == nullptr)
   {
     this->Locator = vtkCellLocator::New();
   }
+  if (this->Input && this->Locator->GetDataSet() != this->Input)
+  {
+    this->Locator->SetDataSet(this->Input);
+    this->Locator->SetTolerance(this->Tolerance);
+    this->Locator->SetNumberOfCellsPerBucket(10);
+    this->Locator->CacheCellBoundsOn();
+    this->Locator->AutomaticOn();
+    this->Locator->BuildLocator();
+  }
+  return this->Locator;
 }
+#endif
 
 //------------------------------------------------------------------------------
 double vtkImplicitPolyDataDistance::EvaluateFunction(double x[3])
@@ -136,6 +182,24 @@ void vtkImplicitPolyDataDistance::EvaluateGradient(double x[3], double g[3])
 
 //------------------------------------------------------------------------------
 double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], double closestPoint[3])
+{
+  // See if data set with polygons has been specified
+  if (this->Input == nullptr || Input->GetNumberOfCells() == 0)
+  {
+    vtkErrorMacro(<< "No polygons to evaluate function!");
+  }
+
+  vtkIdType cellId;
+  vtkNew<vtkGenericCell> cell;
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkIdList> ptIds;
+  return this->SharedEvaluate(x, g, closestPoint, cellId, cell, cellIds, ptIds);
+}
+
+//------------------------------------------------------------------------------
+double vtkImplicitPolyDataDistance::SharedEvaluate(const double x[3], double g[3],
+  double closestPoint[3], vtkIdType& closestCellId, vtkGenericCell* cell, vtkIdList* idList,
+  vtkIdList* ptIds)
 {
   // Set defaults
   double ret = this->NoValue;
@@ -150,15 +214,14 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
     closestPoint[i] = this->NoClosestPoint[i];
   }
 
-  // See if data set with polygons has been specified
+  closestCellId = -1;
   if (this->Input == nullptr || Input->GetNumberOfCells() == 0)
   {
-    vtkErrorMacro(<< "No polygons to evaluate function!");
     return ret;
   }
 
   double p[3];
-  vtkIdType cellId;
+  vtkIdType cellId = -1;
   int subId;
   double vlen2;
 
@@ -169,11 +232,12 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
   }
 
   // Get point id of closest point in data set.
-  vtkSmartPointer<vtkGenericCell> cell = vtkSmartPointer<vtkGenericCell>::New();
-  this->Locator->FindClosestPoint(x, p, cell, cellId, subId, vlen2);
+  this->BVHLocator->FindClosestPoint(x, p, cell, cellId, subId, vlen2);
 
   if (cellId != -1) // point located
   {
+    closestCellId = cellId;
+
     // dist = | point - x |
     ret = sqrt(vlen2);
     // grad = (point - x) / dist
@@ -185,7 +249,6 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
     double dist2, weights[3], pcoords[3], awnorm[3] = { 0, 0, 0 };
     cell->EvaluatePosition(p, closestPoint, subId, pcoords, dist2, weights);
 
-    vtkIdList* idList = vtkIdList::New();
     int count = 0;
     for (int i = 0; i < 3; i++)
     {
@@ -238,7 +301,9 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
         }
         else
         {
-          vtkPolygon::ComputeNormal(this->Input->GetCell(idList->GetId(i))->GetPoints(), norm);
+          this->Input->GetCellPoints(idList->GetId(i), ptIds);
+          vtkPolygon::ComputeNormal(
+            this->Input->GetPoints(), ptIds->GetNumberOfIds(), ptIds->GetPointer(0), norm);
         }
         awnorm[0] += norm[0];
         awnorm[1] += norm[1];
@@ -273,25 +338,27 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
       for (int i = 0; i < idList->GetNumberOfIds(); i++)
       {
         double norm[3];
+        this->Input->GetCellPoints(idList->GetId(i), ptIds);
         if (cnorms)
         {
           cnorms->GetTuple(idList->GetId(i), norm);
         }
         else
         {
-          vtkPolygon::ComputeNormal(this->Input->GetCell(idList->GetId(i))->GetPoints(), norm);
+          vtkPolygon::ComputeNormal(
+            this->Input->GetPoints(), ptIds->GetNumberOfIds(), ptIds->GetPointer(0), norm);
         }
 
         // Compute angle at point a
-        int b = this->Input->GetCell(idList->GetId(i))->GetPointId(0);
-        int c = this->Input->GetCell(idList->GetId(i))->GetPointId(1);
+        int b = ptIds->GetId(0);
+        int c = ptIds->GetId(1);
         if (a == b)
         {
-          b = this->Input->GetCell(idList->GetId(i))->GetPointId(2);
+          b = ptIds->GetId(2);
         }
         else if (a == c)
         {
-          c = this->Input->GetCell(idList->GetId(i))->GetPointId(2);
+          c = ptIds->GetId(2);
         }
         double pa[3], pb[3], pc[3];
         this->Input->GetPoint(a, pa);
@@ -311,7 +378,6 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
       }
       vtkMath::Normalize(awnorm);
     }
-    idList->Delete();
 
     // sign(dist) = dot(grad, cell normal)
     if (ret == 0)
@@ -335,6 +401,105 @@ double vtkImplicitPolyDataDistance::SharedEvaluate(double x[3], double g[3], dou
   return ret;
 }
 
+//------------------------------------------------------------------------------
+// Evaluate the distance of a range of points, with thread local scratch
+// objects.
+struct vtkImplicitPolyDataDistanceWorker
+{
+  vtkImplicitPolyDataDistance* Self;
+  vtkPoints* Points;
+  vtkDataArray* Distances;
+  vtkPoints* ClosestPoints;
+  vtkIdList* CellIds;
+
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocalObject<vtkIdList> IdList;
+  vtkSMPThreadLocalObject<vtkIdList> PtIds;
+
+  vtkImplicitPolyDataDistanceWorker(vtkImplicitPolyDataDistance* self, vtkPoints* points,
+    vtkDataArray* distances, vtkPoints* closestPoints, vtkIdList* cellIds)
+    : Self(self)
+    , Points(points)
+    , Distances(distances)
+    , ClosestPoints(closestPoints)
+    , CellIds(cellIds)
+  {
+  }
+
+  void Initialize() {}
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    vtkIdList* idList = this->IdList.Local();
+    vtkIdList* ptIds = this->PtIds.Local();
+    double x[3], g[3], closestPoint[3];
+    vtkIdType cellId;
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      this->Points->GetPoint(ptId, x);
+      double dist = this->Self->SharedEvaluate(x, g, closestPoint, cellId, cell, idList, ptIds);
+      this->Distances->SetTuple1(ptId, dist);
+      if (this->ClosestPoints)
+      {
+        this->ClosestPoints->SetPoint(ptId, closestPoint);
+      }
+      if (this->CellIds)
+      {
+        this->CellIds->SetId(ptId, cellId);
+      }
+    }
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+void vtkImplicitPolyDataDistance::EvaluateFunctionAndGetClosestPoints(
+  vtkPoints* points, vtkDataArray* distances, vtkPoints* closestPoints, vtkIdList* cellIds)
+{
+  const vtkIdType numPts = points->GetNumberOfPoints();
+  distances->SetNumberOfComponents(1);
+  distances->SetNumberOfTuples(numPts);
+  if (closestPoints)
+  {
+    closestPoints->SetNumberOfPoints(numPts);
+  }
+  if (cellIds)
+  {
+    cellIds->SetNumberOfIds(numPts);
+  }
+
+  if (this->Input == nullptr || Input->GetNumberOfCells() == 0)
+  {
+    vtkErrorMacro(<< "No polygons to evaluate function!");
+  }
+  else
+  {
+    // Make sure the locator is up to date before the threaded evaluation.
+    this->BVHLocator->BuildLocator();
+  }
+
+  vtkImplicitPolyDataDistanceWorker worker(this, points, distances, closestPoints, cellIds);
+  vtkSMPTools::For(0, numPts, worker);
+}
+
+//------------------------------------------------------------------------------
+void vtkImplicitPolyDataDistance::EvaluateFunction(vtkDataArray* input, vtkDataArray* output)
+{
+  // A subclass may override EvaluateFunction(double x[3]), which the batched
+  // evaluation below would ignore.
+  if (typeid(*this) != typeid(vtkImplicitPolyDataDistance))
+  {
+    this->Superclass::EvaluateFunction(input, output);
+    return;
+  }
+  vtkNew<vtkPoints> points;
+  points->SetData(input);
+  this->EvaluateFunctionAndGetClosestPoints(points, output);
+}
+
 //------------------------------------------------------------------------------
 void vtkImplicitPolyDataDistance::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -26,6 +26,12 @@
  * vtkPolyData have a distance of zero. The gradient of the function
  * is the angle-weighted pseudonormal at the nearest point.
  *
+ * The nearest point is found with a vtkBVHCellLocator, which is built in
+ * parallel. Once the input has been set, the evaluation methods are thread
+ * safe, and EvaluateFunction(vtkDataArray*, vtkDataArray*) and
+ * EvaluateFunctionAndGetClosestPoints() evaluate many points at once in
+ * parallel (via vtkSMPTools).
+ *
  * Baerentzen, J. A. and Aanaes, H. (2005). Signed distance
  * computation using the angle weighted pseudonormal. IEEE
  * Transactions on Visualization and Computer Graphics, 11:243-253.
@@ -43,11 +49,20 @@
 #include "vtkFiltersCoreModule.h" // For export macro
 #include "vtkImplicitFunction.h"
 
+class vtkBVHCellLocator;
 class vtkCellLocator;
+class vtkGenericCell;
+class vtkIdList;
+class vtkPoints;
 class vtkPolyData;
 
+// Forward declaration for PIMPL
+struct vtkImplicitPolyDataDistanceWorker;
+
 class VTKFILTERSCORE_EXPORT vtkImplicitPolyDataDistance : public vtkImplicitFunction
 {
+  friend struct vtkImplicitPolyDataDistanceWorker;
+
 public:
   static vtkImplicitPolyDataDistance* New();
   vtkTypeMacro(vtkImplicitPolyDataDistance, vtkImplicitFunction);
@@ -64,6 +79,12 @@ public:
   using vtkImplicitFunction::EvaluateFunction;
   double EvaluateFunction(double x[3]) override;
 
+  /**
+   * Evaluate the function for each point (tuple) of input, in parallel. The
+   * values are the same as the ones of EvaluateFunction(x).
+   */
+  void EvaluateFunction(vtkDataArray* input, vtkDataArray* output) override;
+
   /**
    * Evaluate function gradient of nearest triangle to point x[3].
    */
@@ -75,6 +96,17 @@ public:
    */
   double EvaluateFunctionAndGetClosestPoint(double x[3], double closestPoint[3]);
 
+  /**
+   * Evaluate the function for all of the points, in parallel, and store the
+   * values in distances (resized to one component per point). The closest
+   * points on the input vtkPolyData and the ids of the closest cells (-1 if
+   * none) are returned in closestPoints and cellIds when they are non-null.
+   * The closest cell ids refer to the triangles of the internal,
+   * triangulated copy of the input vtkPolyData.
+   */
+  void EvaluateFunctionAndGetClosestPoints(vtkPoints* points, vtkDataArray* distances,
+    vtkPoints* closestPoints = nullptr, vtkIdList* cellIds = nullptr);
+
   /**
    * Set the input vtkPolyData used for the implicit function
    * evaluation.  Passes input through an internal instance of
@@ -127,15 +159,37 @@ protected:
    */
   void CreateDefaultLocator(void);
 
+  /**
+   * @deprecated Return the vtkCellLocator formerly used to find the closest
+   * points, built over the input on first use. Use BVHLocator instead.
+   */
+  VTK_LEGACY(vtkCellLocator* GetLocator());
+
   double SharedEvaluate(double x[3], double g[3], double closestPoint[3]);
 
+  /**
+   * Thread safe version of SharedEvaluate(), which also returns the id of
+   * the closest cell. The cell and the id lists are used as scratch space.
+   */
+  double SharedEvaluate(const double x[3], double g[3], double closestPoint[3],
+    vtkIdType& closestCellId, vtkGenericCell* cell, vtkIdList* cellIds, vtkIdList* ptIds);
+
   double NoGradient[3];
   double NoClosestPoint[3];
   double NoValue;
   double Tolerance;
 
   vtkPolyData* Input;
+  vtkBVHCellLocator* BVHLocator;
+
+#if !defined(VTK_LEGACY_REMOVE)
+  /**
+   * @deprecated The closest points are now found with BVHLocator. This
+   * locator is only built over the input by GetLocator(), for the subclasses
+   * which still use it, and will be removed in a future release.
+   */
   vtkCellLocator* Locator;
+#endif
 
 private:
   vtkImplicitPolyDataDistance(const vtkImplicitPolyDataDistance&) = delete;
@@ -0,0 +1,215 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkPolygonEdgeNeighborsInternal.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkPolygonEdgeNeighborsInternal
+ * @brief   threaded edge neighborhood of polygonal meshes
+ *
+ * vtkPolygonEdgeNeighborsInternal provides, for every edge of every cell of
+ * a vtkCellArray, the number of other cells sharing that edge and the
+ * smallest id of those cells. This is the information many polygonal filters
+ * obtain by calling vtkPolyData::GetCellEdgeNeighbors() once per edge, which
+ * is slow: it requires the point-to-cell links, and each call intersects two
+ * link lists. Here the edges of all cells are instead gathered in parallel
+ * into an edge table which is sorted with vtkStaticEdgeLocatorTemplate, so
+ * that identical edges end up adjacent to each other; the neighborhood of
+ * each edge is then computed in parallel. Once built, queries are O(1) and
+ * may be made concurrently from several threads.
+ *
+ * The edge i of a cell with npts points is (pts[i],pts[(i+1)%npts]), and the
+ * neighbors of an edge are the other cells that have the same edge (in
+ * either direction). For triangle meshes, and for polygonal meshes where
+ * cells only touch along edges, this is the same result as
+ * vtkPolyData::GetCellEdgeNeighbors(). Note that only the cells of the given
+ * cell array are considered, e.g., the lines of a vtkPolyData are not
+ * neighbors of its polygons.
+ *
+ * @warning
+ * This file is meant as a private include file to avoid code duplication. At
+ * this time it is not meant to define a public API (the API is likely to change
+ * in the future). If you write code that depends on this include, be prepared to
+ * change it in the future (without complaint).
+ *
+ * @sa
+ * vtkStaticEdgeLocatorTemplate vtkFeatureEdges vtkSmoothPolyDataFilter
+ */
+
+#ifndef vtkPolygonEdgeNeighborsInternal_h
+#define vtkPolygonEdgeNeighborsInternal_h
+
+#include "vtkCellArray.h"
+#include "vtkDataArrayRange.h"
+#include "vtkSMPTools.h"
+#include "vtkStaticEdgeLocatorTemplate.h"
+
+#include <vector>
+
+namespace
+{ // anonymous namespace
+
+// The data carried along with each edge in the edge table: the cell using
+// the edge, and the (global) index of the edge use.
+struct PolygonEdgeUse
+{
+  vtkIdType CellId;
+  vtkIdType UseId;
+};
+
+using PolygonEdgeTuple = EdgeTuple<vtkIdType, PolygonEdgeUse>;
+
+// Visit functor: copy the cell offsets out of the cell array.
+struct GetPolygonOffsets
+{
+  template <typename CellStateT>
+  void operator()(
+    CellStateT& state, vtkIdType* offsets, const vtkIdType beginCellId, const vtkIdType endCellId)
+  {
+    for (vtkIdType cellId = beginCellId; cellId < endCellId; ++cellId)
+    {
+      offsets[cellId] = state.GetBeginOffset(cellId);
+    }
+  }
+};
+
+// Visit functor: generate the edge tuples of a range of cells. Edge uses are
+// numbered by the position of their first point in the connectivity array.
+struct GeneratePolygonEdges
+{
+  template <typename CellStateT>
+  void operator()(CellStateT& state, PolygonEdgeTuple* edges, const vtkIdType beginCellId,
+    const vtkIdType endCellId)
+  {
+    for (vtkIdType cellId = beginCellId; cellId < endCellId; ++cellId)
+    {
+      const vtkIdType offset = state.GetBeginOffset(cellId);
+      const auto cell = state.GetCellRange(cellId);
+      const vtkIdType npts = cell.size();
+      for (vtkIdType i = 0; i < npts; ++i)
+      {
+        PolygonEdgeTuple& edge = edges[offset + i];
+        edge.Define(static_cast<vtkIdType>(cell[i]), static_cast<vtkIdType>(cell[(i + 1) % npts]));
+        edge.Data.CellId = cellId;
+        edge.Data.UseId = offset + i;
+      }
+    }
+  }
+};
+
+class PolygonEdgeNeighbors
+{
+public:
+  /**
+   * Build the edge neighborhood of the cells of the given cell array. The
+   * cell ids used in queries, and returned as neighbors, are the indices of
+   * the cells in the cell array.
+   */
+  void Build(vtkCellArray* cells)
+  {
+    const vtkIdType numCells = cells->GetNumberOfCells();
+    const vtkIdType numUses = cells->GetNumberOfConnectivityIds();
+
+    this->Offsets.resize(numCells + 1);
+    this->Offsets[numCells] = numUses;
+    vtkIdType* offsets = this->Offsets.data();
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      cells->Visit(GetPolygonOffsets{}, offsets, cellId, endCellId);
+    });
+
+    // Gather all of the edge uses, then sort them so that the uses of the
+    // same edge are contiguous.
+    std::vector<PolygonEdgeTuple> edges(numUses);
+    PolygonEdgeTuple* edgeArray = edges.data();
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      cells->Visit(GeneratePolygonEdges{}, edgeArray, cellId, endCellId);
+    });
+
+    vtkStaticEdgeLocatorTemplate<vtkIdType, PolygonEdgeUse> locator;
+    vtkIdType numEdges;
+    const vtkIdType* groups = locator.MergeEdges(numUses, edgeArray, numEdges);
+
+    // Now for each edge use, determine the other cells using the same edge.
+    this->NumberOfNeighbors.resize(numUses);
+    this->Neighbors.resize(numUses);
+    vtkIdType* numNeighbors = this->NumberOfNeighbors.data();
+    vtkIdType* neighbors = this->Neighbors.data();
+    vtkSMPTools::For(0, numEdges, [&](vtkIdType edgeId, vtkIdType endEdgeId) {
+      for (; edgeId < endEdgeId; ++edgeId)
+      {
+        const vtkIdType begin = groups[edgeId];
+        const vtkIdType end = groups[edgeId + 1];
+        for (vtkIdType i = begin; i < end; ++i)
+        {
+          const vtkIdType cellId = edgeArray[i].Data.CellId;
+          vtkIdType num = 0;
+          vtkIdType minNei = -1;
+          for (vtkIdType j = begin; j < end; ++j)
+          {
+            const vtkIdType neiId = edgeArray[j].Data.CellId;
+            if (neiId == cellId)
+            {
+              continue;
+            }
+            // A cell using the edge more than once is only counted once
+            bool seen = false;
+            for (vtkIdType k = begin; k < j && !seen; ++k)
+            {
+              seen = (edgeArray[k].Data.CellId == neiId);
+            }
+            if (!seen)
+            {
+              ++num;
+              minNei = (minNei < 0 || neiId < minNei ? neiId : minNei);
+            }
+          }
+          numNeighbors[edgeArray[i].Data.UseId] = num;
+          neighbors[edgeArray[i].Data.UseId] = minNei;
+        }
+      }
+    });
+  }
+
+  /**
+   * Return the index of the edge i of cell cellId among all edge uses of the
+   * cell array, i.e., the position of its first point in the connectivity.
+   */
+  vtkIdType GetEdgeUseId(vtkIdType cellId, vtkIdType i) const { return this->Offsets[cellId] + i; }
+
+  /**
+   * Return the number of cells (other than cellId) sharing the edge i of
+   * cell cellId.
+   */
+  vtkIdType GetNumberOfNeighbors(vtkIdType cellId, vtkIdType i) const
+  {
+    return this->NumberOfNeighbors[this->Offsets[cellId] + i];
+  }
+
+  /**
+   * Return the smallest id of the cells (other than cellId) sharing the edge
+   * i of cell cellId, or -1 if the edge is not shared.
+   */
+  vtkIdType GetNeighbor(vtkIdType cellId, vtkIdType i) const
+  {
+    return this->Neighbors[this->Offsets[cellId] + i];
+  }
+
+private:
+  std::vector<vtkIdType> Offsets;
+  std::vector<vtkIdType> NumberOfNeighbors;
+  std::vector<vtkIdType> Neighbors;
+};
+
+} // anonymous namespace
+
+#endif
+// VTK-HeaderTest-Exclude: vtkPolygonEdgeNeighborsInternal.h
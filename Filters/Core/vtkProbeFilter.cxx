@@ -20,22 +20,29 @@
 #include "vtkCellData.h"
 #include "vtkCellLocatorStrategy.h"
 #include "vtkCharArray.h"
+#include "vtkClosestPointStrategy.h"
+#include "vtkDoubleArray.h"
 #include "vtkFindCellStrategy.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
+#include "vtkPoints.h"
 #include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
 #include <algorithm>
+#include <utility>
 #include <vector>
 
 vtkStandardNewMacro(vtkProbeFilter);
@@ -44,6 +51,9 @@ vtkCxxSetObjectMacro(vtkProbeFilter, FindCellStrategy, vtkFindCellStrategy);
 
 #define CELL_TOLERANCE_FACTOR_SQR 1e-6
 
+// Number of input points whose containing cells are searched at once
+#define VTK_PROBE_BATCH_SIZE 65536
+
 static inline bool IsBlankedCell(vtkUnsignedCharArray* gcells, vtkIdType cellId)
 {
   if (gcells)
@@ -377,42 +387,14 @@ void vtkProbeFilter::Probe(vtkDataSet* input, vtkDataSet* source, vtkDataSet* ou
 }
 
 //------------------------------------------------------------------------------
-void vtkProbeFilter::ProbeEmptyPoints(
-  vtkDataSet* input, int srcIdx, vtkDataSet* source, vtkDataSet* output)
+namespace
 {
-  vtkIdType ptId, numPts;
-  double x[3], tol2;
-  vtkPointData *pd, *outPD;
-  vtkCellData* cd;
-  int subId;
-  double pcoords[3], *weights;
-  double fastweights[256];
-
-  vtkDebugMacro(<< "Probing data");
-
-  pd = source->GetPointData();
-  cd = source->GetCellData();
-
-  auto sourceGhostFlags =
-    vtkUnsignedCharArray::SafeDownCast(cd->GetArray(vtkDataSetAttributes::GhostArrayName()));
 
-  // lets use a stack allocated array if possible for performance reasons
-  int mcs = source->GetMaxCellSize();
-  if (mcs <= 256)
-  {
-    weights = fastweights;
-  }
-  else
-  {
-    weights = new double[mcs];
-  }
-
-  numPts = input->GetNumberOfPoints();
-  outPD = output->GetPointData();
-
-  char* maskArray = this->MaskPoints->GetPointer(0);
-
-  if (this->ComputeTolerance)
+// Compute the (squared) tolerance used to decide whether a point is in a cell
+// of the source.
+double GetSourceTolerance2(vtkDataSet* source, bool computeTolerance, double tolerance)
+{
+  if (computeTolerance)
   {
     // to compute a reasonable starting tolerance we use
     // a fraction of the largest cell length we come across
@@ -430,117 +412,323 @@ void vtkProbeFilter::ProbeEmptyPoints(
       }
     }
     // use 1% of the diagonal (1% has to be squared)
-    tol2 = sLength2 * CELL_TOLERANCE_FACTOR_SQR;
+    return sLength2 * CELL_TOLERANCE_FACTOR_SQR;
   }
-  else
+  return tolerance * tolerance;
+}
+
+// vtkPointSet based datasets do not have an implicit structure to their
+// points. A locator is needed to accelerate the search for cells, i.e.,
+// perform the FindCell() operation. Because of backward legacy there are
+// multiple ways to do this. A vtkFindCellStrategy is preferred, but users
+// can also directly specify a cell locator (via the cell locator
+// prototype). If neither of these is specified, then the strategy used by
+// vtkPointSet::FindCell() is used. A nullptr strategy means that
+// vtkDataSet::FindCell() is to be called. The strategy returned is the one
+// the per-thread strategies are copied from.
+vtkFindCellStrategy* SetUpFindCellStrategy(vtkDataSet* source, vtkFindCellStrategy* userStrategy,
+  vtkAbstractCellLocator* locatorPrototype, vtkSmartPointer<vtkFindCellStrategy>& ownedStrategy)
+{
+  vtkPointSet* ps = vtkPointSet::SafeDownCast(source);
+  if (ps == nullptr)
   {
-    tol2 = (this->Tolerance * this->Tolerance);
+    return nullptr;
   }
 
-  // vtkPointSet based datasets do not have an implicit structure to their
-  // points. A locator is needed to accelerate the search for cells, i.e.,
-  // perform the FindCell() operation. Because of backward legacy there are
-  // multiple ways to do this. A vtkFindCellStrategy is preferred, but users
-  // can also directly specify a cell locator (via the cell locator
-  // prototype). If neither of these is specified, then
-  // vtkDataSet::FindCell() is used to accelerate the search.
-  vtkFindCellStrategy* strategy = nullptr;
-  vtkNew<vtkCellLocatorStrategy> cellLocStrategy;
-  vtkPointSet* ps;
-  if ((ps = vtkPointSet::SafeDownCast(source)) != nullptr)
+  if (userStrategy != nullptr)
   {
-    if (this->FindCellStrategy != nullptr)
+    userStrategy->Initialize(ps);
+    return userStrategy;
+  }
+  else if (locatorPrototype != nullptr)
+  {
+    vtkNew<vtkCellLocatorStrategy> cellLocStrategy;
+    cellLocStrategy->SetCellLocator(locatorPrototype->NewInstance());
+    cellLocStrategy->GetCellLocator()->SetDataSet(source);
+    cellLocStrategy->GetCellLocator()->Update();
+    cellLocStrategy->GetCellLocator()->UnRegister(nullptr); // strategy took ownership
+    ownedStrategy = cellLocStrategy.GetPointer();
+    return ownedStrategy;
+  }
+
+  vtkNew<vtkClosestPointStrategy> closestPointStrategy;
+  if (closestPointStrategy->Initialize(ps) == 0)
+  {
+    return nullptr;
+  }
+  ownedStrategy = closestPointStrategy.GetPointer();
+  return ownedStrategy;
+}
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+// Find the source cells containing a batch of query points. The queries are
+// either the points of a vtkDataSet (possibly masked) or a vtkPoints. Each
+// thread uses its own copy of the find cell strategy (strategies keep
+// scratch storage, so they cannot be shared) and its own generic cell; these
+// are kept from one batch to the next.
+class vtkProbeFilter::FindCellsWorklet
+{
+public:
+  FindCellsWorklet(vtkDataSet* source, vtkFindCellStrategy* strategy, double tol2,
+    bool computeTolerance, int weightsStride)
+    : Source(source)
+    , Strategy(strategy)
+    , Tol2(tol2)
+    , ComputeTolerance(computeTolerance)
+    , WeightsStride(weightsStride)
+    , Input(nullptr)
+    , Points(nullptr)
+    , Mask(nullptr)
+    , Offset(0)
+    , CellIds(nullptr)
+    , PCoords(nullptr)
+    , Weights(nullptr)
+  {
+    this->GhostFlags = vtkUnsignedCharArray::SafeDownCast(
+      source->GetCellData()->GetArray(vtkDataSetAttributes::GhostArrayName()));
+
+    // dummy calls required before multithreaded calls
+    if (source->GetNumberOfCells() > 0)
     {
-      this->FindCellStrategy->Initialize(ps);
-      strategy = this->FindCellStrategy;
+      static_cast<void>(source->GetCellType(0));
     }
-    else if (this->CellLocatorPrototype != nullptr)
+    if (vtkClosestPointStrategy::SafeDownCast(strategy) != nullptr &&
+      source->GetNumberOfPoints() > 0)
     {
-      cellLocStrategy->SetCellLocator(this->CellLocatorPrototype->NewInstance());
-      cellLocStrategy->GetCellLocator()->SetDataSet(source);
-      cellLocStrategy->GetCellLocator()->Update();
-      strategy = static_cast<vtkFindCellStrategy*>(cellLocStrategy.GetPointer());
-      cellLocStrategy->GetCellLocator()->UnRegister(this); // strategy took ownership
+      vtkNew<vtkIdList> cellIds;
+      source->GetPointCells(0, cellIds);
+    }
+    else if (strategy == nullptr)
+    {
+      double x[3], pcoords[3];
+      int subId;
+      std::vector<double> weights(this->WeightsStride);
+      source->GetCenter(x);
+      source->FindCell(x, nullptr, this->Cell.Local(), -1, tol2, subId, pcoords, weights.data());
     }
   }
 
-  // Find the cell that contains xyz and get it
-  if (strategy == nullptr)
-  {
-    vtkDebugMacro(<< "Using vtkDataSet::FindCell()");
-  }
-  else
+  // Set the queries [offset,offset+n) of the next batch, and where to put the
+  // results (which are indexed from 0). Either input or points is specified.
+  void SetBatch(vtkDataSet* input, vtkPoints* points, const char* mask, vtkIdType offset,
+    vtkIdType* cellIds, double* pcoords, double* weights)
   {
-    vtkDebugMacro(<< "Using strategy: " << strategy->GetClassName());
+    this->Input = input;
+    this->Points = points;
+    this->Mask = mask;
+    this->Offset = offset;
+    this->CellIds = cellIds;
+    this->PCoords = pcoords;
+    this->Weights = weights;
   }
 
-  // Loop over all input points, interpolating source data
-  //
-  vtkNew<vtkGenericCell> gcell;
-  int abort = 0;
-  vtkIdType progressInterval = numPts / 20 + 1;
-  for (ptId = 0; ptId < numPts && !abort; ptId++)
+  void operator()(vtkIdType begin, vtkIdType end)
   {
-    if (!(ptId % progressInterval))
+    vtkGenericCell* cell = this->Cell.Local();
+    vtkFindCellStrategy* strategy = nullptr;
+    if (this->Strategy != nullptr)
     {
-      this->UpdateProgress(static_cast<double>(ptId) / numPts);
-      abort = GetAbortExecute();
+      vtkSmartPointer<vtkFindCellStrategy>& localStrategy = this->Strategies.Local();
+      if (localStrategy == nullptr)
+      {
+        localStrategy.TakeReference(this->Strategy->NewInstance());
+        localStrategy->CopyParameters(this->Strategy);
+      }
+      strategy = localStrategy;
     }
 
-    if (maskArray[ptId] == static_cast<char>(1))
+    double x[3], closestPoint[3], dist2;
+    int subId;
+    for (vtkIdType i = begin; i < end; ++i)
     {
-      // skip points which have already been probed with success.
-      // This is helpful for multiblock dataset probing.
-      continue;
-    }
+      const vtkIdType ptId = this->Offset + i;
+      vtkIdType& cellId = this->CellIds[i];
+      double* pcoords = this->PCoords + 3 * i;
+      double* weights = this->Weights + this->WeightsStride * i;
+      if (this->Mask != nullptr && this->Mask[ptId] == static_cast<char>(1))
+      {
+        // skip points which have already been probed with success.
+        // This is helpful for multiblock dataset probing.
+        cellId = -1;
+        continue;
+      }
 
-    // Get the xyz coordinate of the point in the input dataset
-    input->GetPoint(ptId, x);
+      // Get the xyz coordinate of the query point
+      if (this->Points != nullptr)
+      {
+        this->Points->GetPoint(ptId, x);
+      }
+      else
+      {
+        this->Input->GetPoint(ptId, x);
+      }
 
-    vtkIdType cellId = (strategy != nullptr)
-      ? strategy->FindCell(x, nullptr, gcell.GetPointer(), -1, tol2, subId, pcoords, weights)
-      : source->FindCell(x, nullptr, -1, tol2, subId, pcoords, weights);
+      cellId = (strategy != nullptr)
+        ? strategy->FindCell(x, nullptr, cell, -1, this->Tol2, subId, pcoords, weights)
+        : this->Source->FindCell(x, nullptr, cell, -1, this->Tol2, subId, pcoords, weights);
 
-    vtkCell* cell = nullptr;
-    if (cellId >= 0 && !::IsBlankedCell(sourceGhostFlags, cellId))
-    {
-      cell = source->GetCell(cellId);
-      if (this->ComputeTolerance)
+      if (cellId >= 0 && ::IsBlankedCell(this->GhostFlags, cellId))
+      {
+        cellId = -1;
+      }
+      else if (cellId >= 0 && this->ComputeTolerance)
       {
         // If ComputeTolerance is set, compute a tolerance proportional to the
         // cell length.
-        double dist2;
-        double closestPoint[3];
+        this->Source->GetCell(cellId, cell);
         cell->EvaluatePosition(x, closestPoint, subId, pcoords, dist2, weights);
         if (dist2 > (cell->GetLength2() * CELL_TOLERANCE_FACTOR_SQR))
         {
-          continue;
+          cellId = -1;
         }
       }
     }
+  }
+
+private:
+  vtkDataSet* Source;
+  vtkFindCellStrategy* Strategy;
+  double Tol2;
+  bool ComputeTolerance;
+  int WeightsStride;
+  vtkUnsignedCharArray* GhostFlags;
 
-    if (cell)
+  vtkDataSet* Input;
+  vtkPoints* Points;
+  const char* Mask;
+  vtkIdType Offset;
+  vtkIdType* CellIds;
+  double* PCoords;
+  double* Weights;
+
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkFindCellStrategy>> Strategies;
+};
+
+//------------------------------------------------------------------------------
+void vtkProbeFilter::FindCells(vtkDataSet* source, vtkPoints* points, vtkIdList* cellIds,
+  vtkDoubleArray* pcoords, vtkDoubleArray* weights)
+{
+  const vtkIdType numPts = (points != nullptr ? points->GetNumberOfPoints() : 0);
+  const int weightsStride = std::max(source->GetMaxCellSize(), 1);
+
+  cellIds->SetNumberOfIds(numPts);
+  pcoords->SetNumberOfComponents(3);
+  pcoords->SetNumberOfTuples(numPts);
+  weights->SetNumberOfComponents(weightsStride);
+  weights->SetNumberOfTuples(numPts);
+  if (numPts == 0)
+  {
+    return;
+  }
+  if (source->GetNumberOfCells() == 0)
+  {
+    std::fill_n(cellIds->GetPointer(0), numPts, -1);
+    return;
+  }
+
+  vtkSmartPointer<vtkFindCellStrategy> ownedStrategy;
+  vtkFindCellStrategy* strategy = ::SetUpFindCellStrategy(
+    source, this->FindCellStrategy, this->CellLocatorPrototype, ownedStrategy);
+  FindCellsWorklet finder(source, strategy,
+    ::GetSourceTolerance2(source, this->ComputeTolerance, this->Tolerance),
+    this->ComputeTolerance, weightsStride);
+  finder.SetBatch(nullptr, points, nullptr, 0, cellIds->GetPointer(0), pcoords->GetPointer(0),
+    weights->GetPointer(0));
+  vtkSMPTools::For(0, numPts, finder);
+}
+
+//------------------------------------------------------------------------------
+void vtkProbeFilter::ProbeEmptyPoints(
+  vtkDataSet* input, int srcIdx, vtkDataSet* source, vtkDataSet* output)
+{
+  vtkDebugMacro(<< "Probing data");
+
+  vtkPointData* pd = source->GetPointData();
+  vtkCellData* cd = source->GetCellData();
+  vtkPointData* outPD = output->GetPointData();
+  char* maskArray = this->MaskPoints->GetPointer(0);
+  const vtkIdType numPts = input->GetNumberOfPoints();
+  if (numPts < 1 || source->GetNumberOfCells() < 1)
+  {
+    return;
+  }
+
+  vtkSmartPointer<vtkFindCellStrategy> ownedStrategy;
+  vtkFindCellStrategy* strategy = ::SetUpFindCellStrategy(
+    source, this->FindCellStrategy, this->CellLocatorPrototype, ownedStrategy);
+
+  // Find the cell that contains xyz and get it
+  if (strategy == nullptr)
+  {
+    vtkDebugMacro(<< "Using vtkDataSet::FindCell()");
+  }
+  else
+  {
+    vtkDebugMacro(<< "Using strategy: " << strategy->GetClassName());
+  }
+
+  // The cell data arrays to copy
+  std::vector<std::pair<vtkDataArray*, vtkDataArray*>> cellArrays;
+  for (vtkDataArray* outArray : *this->CellArrays)
+  {
+    vtkDataArray* inArray = cd->GetArray(outArray->GetName());
+    if (inArray)
     {
-      // Interpolate the point data
-      outPD->InterpolatePoint((*this->PointList), pd, srcIdx, ptId, cell->PointIds, weights);
-      vtkVectorOfArrays::iterator iter;
-      for (iter = this->CellArrays->begin(); iter != this->CellArrays->end(); ++iter)
+      cellArrays.emplace_back(inArray, outArray);
+    }
+  }
+
+  // The input points are processed in batches: the containing cells of a
+  // batch are found in parallel, then the source data is interpolated in
+  // parallel. Batching bounds the memory used for the interpolation weights.
+  const int weightsStride = std::max(source->GetMaxCellSize(), 1);
+  const vtkIdType batchSize = std::min(numPts, static_cast<vtkIdType>(VTK_PROBE_BATCH_SIZE));
+  std::vector<vtkIdType> cellIds(batchSize);
+  std::vector<double> pcoords(3 * batchSize);
+  std::vector<double> weights(weightsStride * batchSize);
+
+  FindCellsWorklet finder(source, strategy,
+    ::GetSourceTolerance2(source, this->ComputeTolerance, this->Tolerance),
+    this->ComputeTolerance, weightsStride);
+  vtkSMPThreadLocalObject<vtkIdList> cellPointIds;
+
+  for (vtkIdType batchStart = 0; batchStart < numPts && !this->GetAbortExecute();
+       batchStart += batchSize)
+  {
+    this->UpdateProgress(static_cast<double>(batchStart) / numPts);
+
+    const vtkIdType batchEnd = std::min(batchStart + batchSize, numPts);
+    finder.SetBatch(
+      input, nullptr, maskArray, batchStart, cellIds.data(), pcoords.data(), weights.data());
+    vtkSMPTools::For(0, batchEnd - batchStart, finder);
+
+    // Interpolate the point data, copy the cell data
+    vtkSMPTools::For(0, batchEnd - batchStart, [&](vtkIdType begin, vtkIdType end) {
+      vtkIdList* ptIds = cellPointIds.Local();
+      for (vtkIdType i = begin; i < end; ++i)
       {
-        vtkDataArray* inArray = cd->GetArray((*iter)->GetName());
-        if (inArray)
+        const vtkIdType cellId = cellIds[i];
+        if (cellId < 0)
         {
-          outPD->CopyTuple(inArray, *iter, cellId, ptId);
+          continue;
+        }
+        const vtkIdType ptId = batchStart + i;
+        source->GetCellPoints(cellId, ptIds);
+        outPD->InterpolatePoint(
+          (*this->PointList), pd, srcIdx, ptId, ptIds, &weights[weightsStride * i]);
+        for (const auto& arrays : cellArrays)
+        {
+          outPD->CopyTuple(arrays.first, arrays.second, cellId, ptId);
         }
+        maskArray[ptId] = static_cast<char>(1);
       }
-      maskArray[ptId] = static_cast<char>(1);
-    }
+    });
   }
 
   this->MaskPoints->Modified();
-  if (mcs > 256)
-  {
-    delete[] weights;
-  }
 }
 
 //------------------------------------------------------------------------------
@@ -72,9 +72,12 @@
 class vtkAbstractCellLocator;
 class vtkCell;
 class vtkCharArray;
+class vtkDoubleArray;
+class vtkIdList;
 class vtkIdTypeArray;
 class vtkImageData;
 class vtkPointData;
+class vtkPoints;
 class vtkFindCellStrategy;
 
 class VTKFILTERSCORE_EXPORT vtkProbeFilter : public vtkDataSetAlgorithm
@@ -222,6 +225,20 @@ public:
   vtkGetObjectMacro(CellLocatorPrototype, vtkAbstractCellLocator);
   //@}
 
+  /**
+   * Batched cell search: for each of the given points, find the cell of the
+   * source containing it. The search is configured as for probing (find
+   * cell strategy, cell locator prototype, tolerance) and is performed in
+   * parallel, each thread using its own strategy and cell. On return
+   * cellIds has one entry per point (-1 if the point is not inside a
+   * visible source cell), pcoords the parametric coordinates of the points
+   * (3 components), and weights their interpolation weights
+   * (source->GetMaxCellSize() components, of which the first
+   * "number of cell points" are meaningful).
+   */
+  void FindCells(vtkDataSet* source, vtkPoints* points, vtkIdList* cellIds,
+    vtkDoubleArray* pcoords, vtkDoubleArray* weights);
+
 protected:
   vtkProbeFilter();
   ~vtkProbeFilter() override;
@@ -289,6 +306,8 @@ private:
   // array.
   void ProbeEmptyPoints(vtkDataSet* input, int srcIdx, vtkDataSet* source, vtkDataSet* output);
 
+  class FindCellsWorklet;
+
   // A faster implementation for vtkImageData input.
   void ProbePointsImageData(
     vtkImageData* input, int srcIdx, vtkDataSet* source, vtkImageData* output);
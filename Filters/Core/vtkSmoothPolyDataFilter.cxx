@@ -14,10 +14,12 @@
 =========================================================================*/
 #include "vtkSmoothPolyDataFilter.h"
 
+#include "vtkBVHCellLocator.h"
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCellLocator.h"
 #include "vtkFloatArray.h"
+#include "vtkGenericCell.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
@@ -25,10 +27,15 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkPolygonEdgeNeighborsInternal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangleFilter.h"
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 vtkStandardNewMacro(vtkSmoothPolyDataFilter);
 
@@ -125,6 +132,8 @@ vtkSmoothPolyDataFilter::vtkSmoothPolyDataFilter()
   this->GenerateErrorScalars = 0;
   this->GenerateErrorVectors = 0;
 
+  this->ParallelIterations = 0;
+
   this->OutputPointsPrecision = vtkAlgorithm::DEFAULT_PRECISION;
 
   this->SmoothPoints = nullptr;
@@ -180,9 +189,11 @@ struct vtkSPDF_InternalParams
   vtkPolyData* source;
   vtkSmoothPoints* SmoothPoints;
   double* w;
-  vtkCellLocator* cellLocator;
+  vtkAbstractCellLocator* cellLocator;
 };
 
+// Move the points in place, one after the other: each point sees the moves
+// of the points before it.
 template <typename T>
 void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
 {
@@ -276,6 +287,166 @@ void vtkSPDF_MovePoints(vtkSPDF_InternalParams<T>& params)
   vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
 }
 
+// Perform one smoothing iteration on a range of points: each point is moved
+// from its position after the previous iteration (read from Input) and the
+// result is written into Output, so that the points may be processed in
+// parallel.
+template <typename T>
+struct vtkSPDF_MovePointsWorker
+{
+  vtkSPDF_InternalParams<T>& Params;
+  const T* Input;
+  T* Output;
+  int MaxCellSize;
+  vtkSMPThreadLocal<T> MaxDist;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double>> Weights;
+
+  vtkSPDF_MovePointsWorker(vtkSPDF_InternalParams<T>& params, int maxCellSize)
+    : Params(params)
+    , Input(nullptr)
+    , Output(nullptr)
+    , MaxCellSize(maxCellSize)
+  {
+  }
+
+  void Initialize()
+  {
+    this->MaxDist.Local() = 0.0;
+    this->Weights.Local().resize(this->MaxCellSize);
+  }
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  {
+    T& maxDist = this->MaxDist.Local();
+    vtkGenericCell* cell = this->Cell.Local();
+    double* w = this->Weights.Local().data();
+    vtkIdType npts;
+    T dist, deltaX[3];
+    double dist2, xNew[3], closestPt[3];
+
+    for (; ptId < endPtId; ++ptId)
+    {
+      const vtkMeshVertex& vert = this->Params.vertexPtr[ptId];
+      const T* x = this->Input + 3 * ptId;
+      T* y = this->Output + 3 * ptId;
+
+      // For each non-fixed vertex of the mesh, move the point toward the mean
+      // position of its connected neighbors using the relaxation factor.
+      if (vert.type != VTK_FIXED_VERTEX && vert.edges != nullptr &&
+        (npts = vert.edges->GetNumberOfIds()) > 0)
+      {
+        deltaX[0] = deltaX[1] = deltaX[2] = 0.0;
+        const vtkIdType* edgeIdPtr = vert.edges->GetPointer(0);
+        // Compute the mean (cumulated) direction vector
+        for (vtkIdType j = 0; j < npts; ++j)
+        {
+          for (unsigned short k = 0; k < 3; ++k)
+          {
+            deltaX[k] += this->Input[3 * edgeIdPtr[j] + k];
+          }
+        } // for all connected points
+
+        // Move the point
+        for (int k = 0; k < 3; ++k)
+        {
+          y[k] = x[k] + this->Params.factor * (deltaX[k] / npts - x[k]);
+          xNew[k] = y[k];
+        }
+
+        // Constrain point to surface
+        if (this->Params.source)
+        {
+          vtkSmoothPoint* sPtr = this->Params.SmoothPoints->GetSmoothPoint(ptId);
+          bool inCell = false;
+
+          if (sPtr->cellId >= 0) // in cell
+          {
+            this->Params.source->GetCell(sPtr->cellId, cell);
+            inCell = cell->EvaluatePosition(xNew, closestPt, sPtr->subId, sPtr->p, dist2, w) != 0;
+          }
+
+          if (!inCell)
+          { // not in cell anymore
+            this->Params.cellLocator->FindClosestPoint(
+              xNew, closestPt, cell, sPtr->cellId, sPtr->subId, dist2);
+          }
+          for (int k = 0; k < 3; ++k)
+          {
+            y[k] = static_cast<T>(closestPt[k]);
+          }
+        }
+
+        if ((dist = vtkMath::Norm(deltaX)) > maxDist)
+        {
+          maxDist = dist;
+        }
+      } // if can move point
+      else
+      {
+        y[0] = x[0];
+        y[1] = x[1];
+        y[2] = x[2];
+      }
+    } // for all points
+  }
+
+  void Reduce() {}
+};
+
+// Move all of the points of an iteration concurrently.
+template <typename T>
+void vtkSPDF_MovePointsInParallel(vtkSPDF_InternalParams<T>& params)
+{
+  // The points are moved from their positions after the previous iteration,
+  // so two buffers are used in turn: the output points and a scratch array.
+  T* coords = static_cast<T*>(params.newPts->GetVoidPointer(0));
+  std::vector<T> scratch(3 * params.numPts);
+  T* input = coords;
+  T* output = scratch.data();
+
+  const int maxCellSize = (params.source ? params.source->GetMaxCellSize() : 0);
+  vtkSPDF_MovePointsWorker<T> worker(params, maxCellSize);
+
+  int iterationNumber = 0;
+  for (T maxDist = std::numeric_limits<T>::max();
+       maxDist > params.conv && iterationNumber < params.numberOfIterations; ++iterationNumber)
+  {
+    if (iterationNumber && !(iterationNumber % 5))
+    {
+      params.spdf->UpdateProgress(0.5 + 0.5 * iterationNumber / params.numberOfIterations);
+      if (params.spdf->GetAbortExecute())
+      {
+        break;
+      }
+    }
+
+    // Threads which get no points in this iteration must not report the
+    // maximum of a previous one.
+    for (T& threadMaxDist : worker.MaxDist)
+    {
+      threadMaxDist = 0.0;
+    }
+    worker.Input = input;
+    worker.Output = output;
+    vtkSMPTools::For(0, params.numPts, worker);
+
+    maxDist = 0.0;
+    for (T threadMaxDist : worker.MaxDist)
+    {
+      maxDist = (threadMaxDist > maxDist ? threadMaxDist : maxDist);
+    }
+    std::swap(input, output);
+  } // for not converged or within iteration count
+
+  if (input != coords)
+  {
+    std::copy(input, input + 3 * params.numPts, coords);
+  }
+
+  vtkDebugWithObjectMacro(params.spdf, << "Performed " << iterationNumber << " smoothing passes");
+}
+
 } // namespace
 
 int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
@@ -312,7 +483,7 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkCellArray *inVerts, *inLines, *inPolys, *inStrips;
   vtkPoints* newPts;
   vtkMeshVertexPtr Verts;
-  vtkCellLocator* cellLocator = nullptr;
+  vtkAbstractCellLocator* cellLocator = nullptr;
 
   // Check input
   //
@@ -416,14 +587,8 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   { // build cell structure
     vtkCellArray* polys;
     vtkIdType cellId;
-    int numNei, nei, edge;
-    vtkIdType numNeiPts;
-    const vtkIdType* neiPts;
-    double normal[3], neiNormal[3];
-    vtkIdList* neighbors;
-
-    neighbors = vtkIdList::New();
-    neighbors->Allocate(VTK_CELL_SIZE);
+    vtkIdType numNei, nei;
+    int edge;
 
     inMesh = vtkPolyData::New();
     inMesh->SetPoints(inPts);
@@ -439,8 +604,28 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
       Mesh = toTris->GetOutput();
     }
 
-    Mesh->BuildLinks(); // to do neighborhood searching
+    // Determine the cells sharing each edge (neighborhood searching), and
+    // if needed the polygon normals. Both are computed in parallel.
     polys = Mesh->GetPolys();
+    PolygonEdgeNeighbors edgeNeighbors;
+    edgeNeighbors.Build(polys);
+
+    std::vector<double> polyNormals;
+    if (this->FeatureEdgeSmoothing)
+    {
+      polyNormals.resize(3 * polys->GetNumberOfCells());
+      double* normals = polyNormals.data();
+      vtkSMPThreadLocalObject<vtkIdList> cellPts;
+      vtkSMPTools::For(0, polys->GetNumberOfCells(), [&](vtkIdType polyId, vtkIdType endPolyId) {
+        vtkIdList* polyPts = cellPts.Local();
+        for (; polyId < endPolyId; ++polyId)
+        {
+          polys->GetCellAtId(polyId, polyPts);
+          vtkPolygon::ComputeNormal(
+            inPts, polyPts->GetNumberOfIds(), polyPts->GetPointer(0), normals + 3 * polyId);
+        }
+      });
+    }
     this->UpdateProgress(0.375);
 
     for (cellId = 0, polys->InitTraversal(); polys->GetNextCell(npts, pts); cellId++)
@@ -461,8 +646,8 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
           Verts[p2].edges->Allocate(16, 6);
         }
 
-        Mesh->GetCellEdgeNeighbors(cellId, p1, p2, neighbors);
-        numNei = neighbors->GetNumberOfIds();
+        numNei = edgeNeighbors.GetNumberOfNeighbors(cellId, i);
+        nei = edgeNeighbors.GetNeighbor(cellId, i);
 
         edge = VTK_SIMPLE_VERTEX;
         if (numNei == 0)
@@ -473,28 +658,17 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
         else if (numNei >= 2)
         {
           // check to make sure that this edge hasn't been marked already
-          for (j = 0; j < numNei; j++)
-          {
-            if (neighbors->GetId(j) < cellId)
-            {
-              break;
-            }
-          }
-          if (j >= numNei)
+          if (nei > cellId)
           {
             edge = VTK_FEATURE_EDGE_VERTEX;
           }
         }
 
-        else if (numNei == 1 && (nei = neighbors->GetId(0)) > cellId)
+        else if (numNei == 1 && nei > cellId)
         {
           if (this->FeatureEdgeSmoothing)
           {
-            vtkPolygon::ComputeNormal(inPts, npts, pts, normal);
-            Mesh->GetCellPoints(nei, numNeiPts, neiPts);
-            vtkPolygon::ComputeNormal(inPts, numNeiPts, neiPts, neiNormal);
-
-            if (vtkMath::Dot(normal, neiNormal) <= CosFeatureAngle)
+            if (vtkMath::Dot(&polyNormals[3 * cellId], &polyNormals[3 * nei]) <= CosFeatureAngle)
             {
               edge = VTK_FEATURE_EDGE_VERTEX;
             }
@@ -546,8 +720,6 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
     {
       toTris->Delete();
     }
-
-    neighbors->Delete();
   } // if strips or polys
 
   this->UpdateProgress(0.50);
@@ -644,18 +816,51 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
   {
     this->SmoothPoints = new vtkSmoothPoints;
     vtkSmoothPoint* sPtr;
-    cellLocator = vtkCellLocator::New();
-    w = new double[source->GetMaxCellSize()];
+    if (this->ParallelIterations)
+    {
+      cellLocator = vtkBVHCellLocator::New();
+    }
+    else
+    {
+      cellLocator = vtkCellLocator::New();
+      w = new double[source->GetMaxCellSize()];
+    }
 
     cellLocator->SetDataSet(source);
     cellLocator->BuildLocator();
 
-    for (i = 0; i < numPts; i++)
+    if (this->ParallelIterations)
     {
-      sPtr = this->SmoothPoints->InsertSmoothPoint(i);
-      cellLocator->FindClosestPoint(
-        inPts->GetPoint(i), closestPt, sPtr->cellId, sPtr->subId, dist2);
-      newPts->SetPoint(i, closestPt);
+      // Make the cells of the source available to concurrent GetCell() calls
+      if (source->NeedToBuildCells())
+      {
+        source->BuildCells();
+      }
+
+      this->SmoothPoints->InsertSmoothPoint(numPts - 1);
+      vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+      vtkSmoothPoints* smoothPoints = this->SmoothPoints;
+      vtkSMPTools::For(0, numPts, [&](vtkIdType ptId, vtkIdType endPtId) {
+        vtkGenericCell* cell = tlCell.Local();
+        double x[3], closest[3], d2;
+        for (; ptId < endPtId; ++ptId)
+        {
+          vtkSmoothPoint* ptr = smoothPoints->GetSmoothPoint(ptId);
+          inPts->GetPoint(ptId, x);
+          cellLocator->FindClosestPoint(x, closest, cell, ptr->cellId, ptr->subId, d2);
+          newPts->SetPoint(ptId, closest);
+        }
+      });
+    }
+    else
+    {
+      for (i = 0; i < numPts; i++)
+      {
+        sPtr = this->SmoothPoints->InsertSmoothPoint(i);
+        cellLocator->FindClosestPoint(
+          inPts->GetPoint(i), closestPt, sPtr->cellId, sPtr->subId, dist2);
+        newPts->SetPoint(i, closestPt);
+      }
     }
   }
   else // smooth normally
@@ -671,7 +876,14 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
     vtkSPDF_InternalParams<double> params = { this, this->NumberOfIterations, newPts,
       this->RelaxationFactor, conv, numPts, Verts, source, this->SmoothPoints, w, cellLocator };
 
-    vtkSPDF_MovePoints(params);
+    if (this->ParallelIterations)
+    {
+      vtkSPDF_MovePointsInParallel(params);
+    }
+    else
+    {
+      vtkSPDF_MovePoints(params);
+    }
   }
   else
   {
@@ -679,7 +891,14 @@ int vtkSmoothPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(request),
       static_cast<float>(this->RelaxationFactor), static_cast<float>(conv), numPts, Verts, source,
       this->SmoothPoints, w, cellLocator };
 
-    vtkSPDF_MovePoints(params);
+    if (this->ParallelIterations)
+    {
+      vtkSPDF_MovePointsInParallel(params);
+    }
+    else
+    {
+      vtkSPDF_MovePoints(params);
+    }
   }
 
   if (source)
@@ -777,6 +996,7 @@ void vtkSmoothPolyDataFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Boundary Smoothing: " << (this->BoundarySmoothing ? "On\n" : "Off\n");
   os << indent << "Generate Error Scalars: " << (this->GenerateErrorScalars ? "On\n" : "Off\n");
   os << indent << "Generate Error Vectors: " << (this->GenerateErrorVectors ? "On\n" : "Off\n");
+  os << indent << "Parallel Iterations: " << (this->ParallelIterations ? "On\n" : "Off\n");
   if (this->GetSource())
   {
     os << indent << "Source: " << static_cast<void*>(this->GetSource()) << "\n";
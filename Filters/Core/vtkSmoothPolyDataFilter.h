@@ -32,7 +32,10 @@
  * relaxation factor is available to control the amount of displacement of
  * v).  The process repeats for each vertex. This pass over the list of
  * vertices is a single iteration. Many iterations (generally around 20 or
- * so) are repeated until the desired result is obtained.
+ * so) are repeated until the desired result is obtained. By default the
+ * vertices are moved in place, one after the other, so that each vertex
+ * sees the moves of the vertices before it; see ParallelIterations for an
+ * alternative.
  *
  * There are some special instance variables used to control the execution
  * of this filter. (These ivars basically control what vertices can be
@@ -195,6 +198,20 @@ public:
   vtkBooleanMacro(GenerateErrorVectors, vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Turn on/off moving all the vertices of an iteration concurrently. When
+   * on, each vertex is moved from the positions its connected vertices had
+   * after the previous iteration, and a vtkBVHCellLocator constrains the
+   * vertices to the Source. The result then does not depend on the order of
+   * the vertices, but differs slightly from the default in place update.
+   * The default is off.
+   */
+  vtkSetMacro(ParallelIterations, vtkTypeBool);
+  vtkGetMacro(ParallelIterations, vtkTypeBool);
+  vtkBooleanMacro(ParallelIterations, vtkTypeBool);
+  //@}
+
   //@{
   /**
    * Specify the source object which is used to constrain smoothing. The
@@ -231,6 +248,7 @@ protected:
   vtkTypeBool BoundarySmoothing;
   vtkTypeBool GenerateErrorScalars;
   vtkTypeBool GenerateErrorVectors;
+  vtkTypeBool ParallelIterations;
   int OutputPointsPrecision;
 
   vtkSmoothPoints* SmoothPoints;
@@ -18,6 +18,7 @@
 #include "vtkCell.h"
 #include "vtkCellData.h"
 #include "vtkCellIterator.h"
+#include "vtkDoubleArray.h"
 #include "vtkEventForwarderCommand.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
@@ -164,13 +165,18 @@ int vtkExtractGeometry::RequestData(
   outputCD->CopyAllocate(cd);
   vtkFloatArray* newScalars = nullptr;
 
+  // Evaluate the implicit function at all points
+  vtkNew<vtkDoubleArray> values;
+  this->ImplicitFunction->FunctionValue(input, values);
+  const double* value = values->GetPointer(0);
+
   if (!this->ExtractBoundaryCells)
   {
     for (ptId = 0; ptId < numPts; ptId++)
     {
-      input->GetPoint(ptId, x);
-      if ((this->ImplicitFunction->FunctionValue(x) * multiplier) < 0.0)
+      if ((value[ptId] * multiplier) < 0.0)
       {
+        input->GetPoint(ptId, x);
         newId = newPts->InsertNextPoint(x);
         pointMap[ptId] = newId;
         outputPD->CopyData(pd, ptId, newId);
@@ -186,8 +192,7 @@ int vtkExtractGeometry::RequestData(
 
     for (ptId = 0; ptId < numPts; ptId++)
     {
-      input->GetPoint(ptId, x);
-      val = this->ImplicitFunction->FunctionValue(x) * multiplier;
+      val = value[ptId] * multiplier;
       newScalars->SetValue(ptId, val);
     }
   }
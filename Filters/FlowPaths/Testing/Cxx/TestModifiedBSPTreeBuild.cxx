@@ -0,0 +1,146 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestModifiedBSPTreeBuild.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the construction of vtkModifiedBSPTree
+// .SECTION Description
+// Build the tree of a sphere twice with different states of rand() and check
+// that the trees are the same, and that the cells found along lines and at
+// points are those found by testing every cell.
+
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkModifiedBSPTree.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+
+#include <cmath>
+#include <cstdlib>
+
+namespace
+{
+bool SamePolyData(vtkPolyData* a, vtkPolyData* b)
+{
+  if (a->GetNumberOfPoints() != b->GetNumberOfPoints() ||
+    a->GetNumberOfCells() != b->GetNumberOfCells())
+  {
+    return false;
+  }
+  for (vtkIdType i = 0; i < a->GetNumberOfPoints(); ++i)
+  {
+    double pa[3], pb[3];
+    a->GetPoint(i, pa);
+    b->GetPoint(i, pb);
+    if (pa[0] != pb[0] || pa[1] != pb[1] || pa[2] != pb[2])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestModifiedBSPTreeBuild(int, char*[])
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(60);
+  sphere->SetPhiResolution(60);
+  sphere->Update();
+  vtkPolyData* mesh = sphere->GetOutput();
+
+  vtkNew<vtkModifiedBSPTree> trees[2];
+  vtkNew<vtkPolyData> representations[2];
+  for (int i = 0; i < 2; ++i)
+  {
+    srand(i + 1);
+    trees[i]->SetDataSet(mesh);
+    trees[i]->SetNumberOfCellsPerNode(8);
+    trees[i]->BuildLocator();
+    trees[i]->GenerateRepresentation(-1, representations[i]);
+  }
+  if (representations[0]->GetNumberOfCells() == 0 ||
+    !SamePolyData(representations[0], representations[1]))
+  {
+    cerr << "The trees differ from one build to the next" << endl;
+    return EXIT_FAILURE;
+  }
+  vtkModifiedBSPTree* tree = trees[0];
+
+  // lines through the center hit the sphere twice, at the cells containing
+  // the intersection points
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkIdList> cellIds;
+  vtkNew<vtkGenericCell> cell;
+  for (int i = 0; i < 50; ++i)
+  {
+    const double theta = 0.37 * i, phi = 0.11 + 0.059 * i;
+    const double d[3] = { std::sin(phi) * std::cos(theta), std::sin(phi) * std::sin(theta),
+      std::cos(phi) };
+    const double p1[3] = { -d[0], -d[1], -d[2] };
+    const double p2[3] = { d[0], d[1], d[2] };
+    tree->IntersectWithLine(p1, p2, 1e-6, points, cellIds);
+    if (points->GetNumberOfPoints() != 2)
+    {
+      cerr << "Line " << i << " hits the sphere " << points->GetNumberOfPoints() << " times"
+           << endl;
+      return EXIT_FAILURE;
+    }
+    for (vtkIdType j = 0; j < 2; ++j)
+    {
+      double x[3], closest[3], pcoords[3], weights[3], dist2;
+      int subId;
+      points->GetPoint(j, x);
+      mesh->GetCell(cellIds->GetId(j), cell);
+      if (cell->EvaluatePosition(x, closest, subId, pcoords, dist2, weights) != 1 ||
+        dist2 > 1e-10)
+      {
+        cerr << "Line " << i << " hits cell " << cellIds->GetId(j) << " outside of it" << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // FindCell returns a cell containing each cell center, as testing every
+  // cell does
+  double weights[3], pcoords[3];
+  int subId;
+  for (vtkIdType cellId = 0; cellId < mesh->GetNumberOfCells(); cellId += 7)
+  {
+    double center[3];
+    mesh->GetCell(cellId, cell);
+    cell->GetParametricCenter(pcoords);
+    cell->EvaluateLocation(subId, pcoords, center, weights);
+    const vtkIdType found = tree->FindCell(center, 1e-6, cell, pcoords, weights);
+    const vtkIdType expected = mesh->FindCell(center, nullptr, -1, 1e-6, subId, pcoords, weights);
+    if (found < 0 || expected < 0)
+    {
+      cerr << "No cell found at the center of cell " << cellId << endl;
+      return EXIT_FAILURE;
+    }
+    if (found != cellId && found != expected)
+    {
+      double closest[3], dist2;
+      mesh->GetCell(found, cell);
+      if (cell->EvaluatePosition(center, closest, subId, pcoords, dist2, weights) != 1 ||
+        dist2 > 1e-10)
+      {
+        cerr << "Wrong cell " << found << " found at the center of cell " << cellId << endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -18,6 +18,7 @@
 #include "vtkIdListCollection.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 
 #include <algorithm>
 #include <functional>
@@ -43,6 +44,9 @@ enum
 };
 //
 const double Epsilon_ = 1E-8;
+//
+// Nodes with fewer cells than this are subdivided concurrently
+#define BSP_SUBTREE_SIZE 4096
 
 //////////////////////////////////////////////////////////////////////////////
 // Main management and support for tree
@@ -84,8 +88,6 @@ public:
 
 typedef cell_extents* cell_extents_List;
 
-static int global_list_count = 0;
-
 class Sorted_cell_extents_Lists
 {
 public:
@@ -99,7 +101,6 @@ public:
       Mins[i] = new cell_extents[nCells]; // max num <= nCells/2 ?
       Maxs[i] = new cell_extents[nCells];
     }
-    global_list_count += 1;
   };
   ~Sorted_cell_extents_Lists()
   {
@@ -108,37 +109,89 @@ public:
       delete[](Mins[i]);
       delete[](Maxs[i]);
     }
-    global_list_count -= 1;
   }
 };
 
-extern "C" int _compareMin(const void* pA, const void* B)
+// The extents are sorted in increasing min / decreasing max order, ties being
+// broken by cell id, so that the tree does not depend on the sort algorithm.
+struct _compareMin
 {
-  const cell_extents* tA = static_cast<const cell_extents*>(pA);
-  const cell_extents* tB = static_cast<const cell_extents*>(B);
-  if (tA->min == tB->min)
+  bool operator()(const cell_extents& tA, const cell_extents& tB) const
   {
-    return 0;
+    return tA.min < tB.min || (tA.min == tB.min && tA.cell_ID < tB.cell_ID);
   }
-  else
+};
+
+struct _compareMax
+{
+  bool operator()(const cell_extents& tA, const cell_extents& tB) const
   {
-    return tA->min < tB->min ? -1 : 1;
+    return tA.max > tB.max || (tA.max == tB.max && tA.cell_ID < tB.cell_ID);
   }
-}
+};
 
-extern "C" int _compareMax(const void* pA, const void* B)
+// Statistics of the subdivision, the inconsistencies found (reported once the
+// subdivision is done, as it may run on several threads), and the nodes whose
+// subdivision is deferred to be done concurrently (each one owns its lists).
+struct vtkBSPBuildState
 {
-  const cell_extents* tA = static_cast<const cell_extents*>(pA);
-  const cell_extents* tB = static_cast<const cell_extents*>(B);
-  if (tA->max == tB->max)
+  struct Task
+  {
+    BSPNode* Node;
+    Sorted_cell_extents_Lists* Lists;
+    vtkIdType NumberOfCells;
+    int Depth;
+  };
+
+  int npn;
+  int nln;
+  int tot_depth;
+  int MaxDepth;
+  int MinListErrors;
+  int MaxListErrors;
+  int EmptyChildren;
+  std::vector<Task>* Tasks;
+
+  vtkBSPBuildState()
+    : npn(0)
+    , nln(0)
+    , tot_depth(0)
+    , MaxDepth(0)
+    , MinListErrors(0)
+    , MaxListErrors(0)
+    , EmptyChildren(0)
+    , Tasks(nullptr)
   {
-    return 0;
   }
-  else
+
+  void Add(const vtkBSPBuildState& other)
   {
-    return tA->max > tB->max ? -1 : 1;
+    npn += other.npn;
+    nln += other.nln;
+    tot_depth += other.tot_depth;
+    MaxDepth = std::max(MaxDepth, other.MaxDepth);
+    MinListErrors += other.MinListErrors;
+    MaxListErrors += other.MaxListErrors;
+    EmptyChildren += other.EmptyChildren;
   }
-}
+
+  void ReportErrors(vtkModifiedBSPTree* self) const
+  {
+    if (MinListErrors)
+    {
+      vtkWarningWithObjectMacro(self, << "Error count in min lists (" << MinListErrors << ")");
+    }
+    if (MaxListErrors)
+    {
+      vtkWarningWithObjectMacro(self, << "Error count in max lists (" << MaxListErrors << ")");
+    }
+    if (EmptyChildren)
+    {
+      vtkWarningWithObjectMacro(
+        self, << EmptyChildren << " empty child nodes ! - this shouldn't happen");
+    }
+  }
+};
 
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
@@ -202,7 +255,7 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
 
   // create the root node
   this->mRoot = new BSPNode();
-  this->mRoot->mAxis = rand() % 3;
+  this->mRoot->mAxis = 0;
   this->mRoot->depth = 0;
   //
   if (numCells == 0)
@@ -214,35 +267,63 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
   //
   // sort the cells into 6 lists using structure for subdividing tests
   Sorted_cell_extents_Lists* lists = new Sorted_cell_extents_Lists(numCells);
-  for (int i = 0; i < 3; i++)
-  { // loop over each axis
-    for (vtkIdType j = 0; j < numCells; j++)
-    {                                                   // loop over each cell
-      lists->Mins[i][j].min = CellBounds[j][i * 2];     // i=0 xmin, i=1 ymin, i=2 zmin
-      lists->Mins[i][j].max = CellBounds[j][i * 2 + 1]; // i=0 xmax, i=1 ymax, i=2 zmax
-      lists->Mins[i][j].cell_ID = j;
-      //
-      lists->Maxs[i][j].min = CellBounds[j][i * 2];
-      lists->Maxs[i][j].max = CellBounds[j][i * 2 + 1];
-      lists->Maxs[i][j].cell_ID = j;
+  double(*cellBounds)[6] = this->CellBounds;
+  vtkSMPTools::For(0, numCells, [lists, cellBounds](vtkIdType j, vtkIdType end) {
+    for (; j < end; j++)
+    { // loop over each cell
+      for (int i = 0; i < 3; i++)
+      {                                                   // loop over each axis
+        lists->Mins[i][j].min = cellBounds[j][i * 2];     // i=0 xmin, i=1 ymin, i=2 zmin
+        lists->Mins[i][j].max = cellBounds[j][i * 2 + 1]; // i=0 xmax, i=1 ymax, i=2 zmax
+        lists->Mins[i][j].cell_ID = j;
+        //
+        lists->Maxs[i][j] = lists->Mins[i][j];
+      }
     }
+  });
+  for (int i = 0; i < 3; i++)
+  {
     // Sort
-    qsort(lists->Mins[i], numCells, sizeof(cell_extents), _compareMin);
-    qsort(lists->Maxs[i], numCells, sizeof(cell_extents), _compareMax);
+    vtkSMPTools::Sort(lists->Mins[i], lists->Mins[i] + numCells, _compareMin());
+    vtkSMPTools::Sort(lists->Maxs[i], lists->Maxs[i] + numCells, _compareMax());
   }
   //
-  // call the recursive subdivision routine
+  // call the recursive subdivision routine. The nodes near the root are
+  // subdivided first, then the subtrees below them are built concurrently.
+  // The subdivision of a node only depends on its own cells, so the tree is
+  // the same as the one of a serial build.
   //
   vtkDebugMacro(<< "Beginning Subdivision");
   //
-  if (numCells > 0)
-  {
-    Subdivide(this->mRoot, lists, this->DataSet, numCells, 0, this->MaxLevel,
-      this->NumberOfCellsPerNode, this->Level);
-  }
+  std::vector<vtkBSPBuildState::Task> tasks;
+  vtkBSPBuildState state;
+  state.Tasks = &tasks;
+  this->Subdivide(
+    this->mRoot, lists, numCells, 0, this->MaxLevel, this->NumberOfCellsPerNode, state);
   delete lists;
   // Child nodes are responsible for freeing the temporary sorted lists
   //
+  std::vector<vtkBSPBuildState> taskStates(tasks.size());
+  vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()),
+    [this, &tasks, &taskStates](vtkIdType taskId, vtkIdType endTaskId) {
+      for (; taskId < endTaskId; ++taskId)
+      {
+        const vtkBSPBuildState::Task& task = tasks[taskId];
+        this->Subdivide(task.Node, task.Lists, task.NumberOfCells, task.Depth, this->MaxLevel,
+          this->NumberOfCellsPerNode, taskStates[taskId]);
+        delete task.Lists;
+      }
+    });
+  for (const vtkBSPBuildState& taskState : taskStates)
+  {
+    state.Add(taskState);
+  }
+  state.ReportErrors(this);
+  this->npn = state.npn;
+  this->nln = state.nln;
+  this->tot_depth = state.tot_depth;
+  this->Level = state.MaxDepth;
+  //
   this->BuildTime.Modified();
   //
   double av_depth = (double)tot_depth / nln;
@@ -258,16 +339,31 @@ void vtkModifiedBSPTree::BuildLocatorInternal()
 // a small part of this, the rest is just bookkeeping - it looks worse than it is.
 //
 void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lists,
-  vtkDataSet* dataset, vtkIdType nCells, int depth, int maxlevel, vtkIdType maxCells, int& MaxDepth)
+  vtkDataSet* vtkNotUsed(dataset), vtkIdType nCells, int depth, int maxlevel, vtkIdType maxCells,
+  int& MaxDepth)
+{
+  vtkBSPBuildState state;
+  state.MaxDepth = MaxDepth;
+  this->Subdivide(node, lists, nCells, depth, maxlevel, maxCells, state);
+  state.ReportErrors(this);
+  this->npn += state.npn;
+  this->nln += state.nln;
+  this->tot_depth += state.tot_depth;
+  MaxDepth = state.MaxDepth;
+}
+
+//------------------------------------------------------------------------------
+void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lists,
+  vtkIdType nCells, int depth, int maxlevel, vtkIdType maxCells, vtkBSPBuildState& state)
 {
   //
   // We've got lists sorted on the axes, so we can easily get BBox
   node->setMin(lists->Mins[0][0].min, lists->Mins[1][0].min, lists->Mins[2][0].min);
   node->setMax(lists->Maxs[0][0].max, lists->Maxs[1][0].max, lists->Maxs[2][0].max);
   // Update depth info
-  if (node->depth > MaxDepth)
+  if (node->depth > state.MaxDepth)
   {
-    MaxDepth = depth;
+    state.MaxDepth = depth;
   }
   //
   // Make sure child nodes are clear to start with
@@ -319,7 +415,7 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
       {
         node->mChild[i] = new BSPNode();
         node->mChild[i]->depth = node->depth + 1;
-        node->mChild[i]->mAxis = rand() % 3;
+        node->mChild[i]->mAxis = (node->mAxis + 1) % 3;
       }
       Daxis = node->mAxis;
       Sorted_cell_extents_Lists* left = new Sorted_cell_extents_Lists(nCells);
@@ -410,27 +506,27 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
       // this is overkill but for now I want a FULL DEBUG!
       if ((Cmin_l[0] + Cmin_r[0] + Cmin_m[0]) != nCells)
       {
-        vtkWarningMacro("Error count in min lists");
+        state.MinListErrors++;
       }
       if ((Cmin_l[1] + Cmin_r[1] + Cmin_m[1]) != nCells)
       {
-        vtkWarningMacro("Error count in min lists");
+        state.MinListErrors++;
       }
       if ((Cmin_l[2] + Cmin_r[2] + Cmin_m[2]) != nCells)
       {
-        vtkWarningMacro("Error count in min lists");
+        state.MinListErrors++;
       }
       if ((Cmax_l[0] + Cmax_r[0] + Cmax_m[0]) != nCells)
       {
-        vtkWarningMacro("Error count in max lists");
+        state.MaxListErrors++;
       }
       if ((Cmax_l[1] + Cmax_r[1] + Cmax_m[1]) != nCells)
       {
-        vtkWarningMacro("Error count in max lists");
+        state.MaxListErrors++;
       }
       if ((Cmax_l[2] + Cmax_r[2] + Cmax_m[2]) != nCells)
       {
-        vtkWarningMacro("Error count in max lists");
+        state.MaxListErrors++;
       }
       //
       // Bug : Can sometimes get unbalanced leaves
@@ -456,41 +552,53 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
         //
         // And of course, we really ought to subdivide again - Hoorah!
         // NB: it is possible for a node to be empty now, so check and delete if necessary
+        // Small children are deferred to be subdivided concurrently, the
+        // task then owns the lists.
+        auto subdivideChild = [&](BSPNode* child, Sorted_cell_extents_Lists* childLists,
+                                vtkIdType childCells) {
+          if (state.Tasks && childCells <= BSP_SUBTREE_SIZE)
+          {
+            vtkBSPBuildState::Task task = { child, childLists, childCells, depth + 1 };
+            state.Tasks->push_back(task);
+          }
+          else
+          {
+            this->Subdivide(child, childLists, childCells, depth + 1, maxlevel, maxCells, state);
+            delete childLists;
+          }
+        };
         if (Cmin_l[0])
         {
-          Subdivide(
-            node->mChild[0], left, dataset, Cmin_l[0], depth + 1, maxlevel, maxCells, MaxDepth);
+          subdivideChild(node->mChild[0], left, Cmin_l[0]);
         }
         else
         {
-          vtkWarningMacro(<< "Child 0 Empty ! - this shouldn't happen");
+          state.EmptyChildren++;
+          delete left;
         }
-        delete left;
 
         if (Cmin_m[0])
         {
-          Subdivide(
-            node->mChild[1], mid, dataset, Cmin_m[0], depth + 1, maxlevel, maxCells, MaxDepth);
+          subdivideChild(node->mChild[1], mid, Cmin_m[0]);
         }
         else
         {
           delete node->mChild[1];
           node->mChild[1] = nullptr;
+          delete mid;
         }
-        delete mid;
 
         if (Cmin_r[0])
         {
-          Subdivide(
-            node->mChild[2], right, dataset, Cmin_r[0], depth + 1, maxlevel, maxCells, MaxDepth);
+          subdivideChild(node->mChild[2], right, Cmin_r[0]);
         }
         else
         {
-          vtkWarningMacro(<< "Child 2 Empty ! - this shouldn't happen");
+          state.EmptyChildren++;
+          delete right;
         }
-        delete right;
         //
-        npn += 1; // Parent node
+        state.npn += 1; // Parent node
         //
         // we've done all we were asked to do
         //
@@ -503,8 +611,8 @@ void vtkModifiedBSPTree::Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lis
   //
   // Copy the cell IDs into the actual node structure for proper use
   node->num_cells = nCells;
-  nln += 1; // Leaf node
-  tot_depth += node->depth;
+  state.nln += 1; // Leaf node
+  state.tot_depth += node->depth;
   for (int i = 0; i < 6; i++)
   {
     node->sorted_cell_lists[i] = new vtkIdType[nCells];
@@ -95,6 +95,17 @@
  * segments the lists and passes them down to the new child nodes whilst
  * maintaining sorted order. This makes for an efficient subdivision strategy.
  *
+ * The subtrees of the nodes near the root are built concurrently with
+ * vtkSMPTools, so the build must not depend on the order in which nodes are
+ * subdivided. The split search of the root starts on the x axis and the one
+ * of a child node on the axis following its parent's, rather than on a
+ * random axis, and cells with equal extents are sorted by cell id. The tree
+ * is therefore the same from one build to the next, whatever the number of
+ * threads. It differs from the trees of older versions, which depended on
+ * rand() and on the qsort() implementation, but queries return the same
+ * cells, except for the choice among several cells sharing a face or a
+ * point.
+ *
  * NB. The following reference has been sent to me
  *   @Article{formella-1995-ray,
  *     author =     "Arno Formella and Christian Gill",
@@ -149,6 +160,7 @@
 
 class Sorted_cell_extents_Lists;
 class BSPNode;
+struct vtkBSPBuildState;
 class vtkGenericCell;
 class vtkIdList;
 class vtkIdListCollection;
@@ -248,6 +260,13 @@ protected:
   void Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lists, vtkDataSet* dataSet,
     vtkIdType nCells, int depth, int maxlevel, vtkIdType maxCells, int& MaxDepth);
 
+  //
+  // The subdivision routine used by BuildLocatorInternal(): the statistics
+  // are gathered in state, and if state has a task list, the small nodes are
+  // added to it rather than subdivided (to be subdivided concurrently).
+  void Subdivide(BSPNode* node, Sorted_cell_extents_Lists* lists, vtkIdType nCells, int depth,
+    int maxlevel, vtkIdType maxCells, vtkBSPBuildState& state);
+
   // We provide a function which does the cell/ray test so that
   // it can be overridden by subclasses to perform special treatment
   // (Example : Particles stored in tree, have no dimension, so we must
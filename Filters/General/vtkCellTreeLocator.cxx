@@ -21,6 +21,8 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include <algorithm>
 #include <cassert>
@@ -45,6 +47,9 @@ enum
   NEG_Z
 };
 #define CELLTREE_MAX_DEPTH 32
+// Nodes with fewer cells than this are split into subtrees concurrently, and
+// nodes with more cells than this are binned in parallel.
+#define CELLTREE_SUBTREE_SIZE 8192
 }
 
 //------------------------------------------------------------------------------
@@ -270,7 +275,7 @@ private:
 
   // -------------------------------------------------------------------------
 
-  void FindMinMax(const PerCell* begin, const PerCell* end, float* min, float* max)
+  static void FindMinMax(const PerCell* begin, const PerCell* end, float* min, float* max)
   {
     if (begin == end)
     {
@@ -295,29 +300,73 @@ private:
     }
   }
 
-  // -------------------------------------------------------------------------
-
-  void Split(unsigned int index, float min[3], float max[3])
+  // Threaded FindMinMax() for large ranges. The minima and maxima do not
+  // depend on the order in which the cells are visited.
+  struct MinMaxWorker
   {
-    unsigned int start = this->m_nodes[index].Start();
-    unsigned int size = this->m_nodes[index].Size();
+    const PerCell* Cells;
+    vtkSMPThreadLocal<std::vector<float>> LocalMinMax;
+    float Min[3];
+    float Max[3];
 
-    if (size < this->m_leafsize)
+    void Initialize()
     {
-      return;
+      std::vector<float>& minMax = this->LocalMinMax.Local();
+      minMax.assign(6, std::numeric_limits<float>::max());
+      minMax[3] = minMax[4] = minMax[5] = -std::numeric_limits<float>::max();
     }
 
-    PerCell* begin = &(this->m_pc[start]);
-    PerCell* end = &(this->m_pc[0]) + start + size;
-    PerCell* mid = begin;
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      std::vector<float>& minMax = this->LocalMinMax.Local();
+      float min[3], max[3];
+      FindMinMax(this->Cells + begin, this->Cells + end, min, max);
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        minMax[d] = std::min(minMax[d], min[d]);
+        minMax[3 + d] = std::max(minMax[3 + d], max[d]);
+      }
+    }
 
-    const int nbuckets = 6;
+    void Reduce()
+    {
+      for (unsigned int d = 0; d < 3; ++d)
+      {
+        this->Min[d] = std::numeric_limits<float>::max();
+        this->Max[d] = -std::numeric_limits<float>::max();
+      }
+      for (auto iter = this->LocalMinMax.begin(); iter != this->LocalMinMax.end(); ++iter)
+      {
+        for (unsigned int d = 0; d < 3; ++d)
+        {
+          this->Min[d] = std::min(this->Min[d], (*iter)[d]);
+          this->Max[d] = std::max(this->Max[d], (*iter)[3 + d]);
+        }
+      }
+    }
+  };
 
-    const float ext[3] = { max[0] - min[0], max[1] - min[1], max[2] - min[2] };
-    const float iext[3] = { nbuckets / ext[0], nbuckets / ext[1], nbuckets / ext[2] };
+  static void FindMinMaxParallel(const PerCell* begin, const PerCell* end, float* min, float* max)
+  {
+    if (end - begin <= CELLTREE_SUBTREE_SIZE)
+    {
+      FindMinMax(begin, end, min, max);
+      return;
+    }
+    MinMaxWorker worker;
+    worker.Cells = begin;
+    vtkSMPTools::For(0, end - begin, worker);
+    std::copy(worker.Min, worker.Min + 3, min);
+    std::copy(worker.Max, worker.Max + 3, max);
+  }
 
-    Bucket b[3][nbuckets];
+  // -------------------------------------------------------------------------
 
+  static const int NumberOfBuckets = 6;
+
+  static void FillBuckets(const PerCell* begin, const PerCell* end, const float min[3],
+    const float iext[3], Bucket b[3][NumberOfBuckets])
+  {
     for (const PerCell* pc = begin; pc != end; ++pc)
     {
       for (unsigned int d = 0; d < 3; ++d)
@@ -330,14 +379,115 @@ private:
           ind = 0;
         }
 
-        if (ind >= nbuckets)
+        if (ind >= NumberOfBuckets)
         {
-          ind = nbuckets - 1;
+          ind = NumberOfBuckets - 1;
         }
 
         b[d][ind].Add(pc->Min[d], pc->Max[d]);
       }
     }
+  }
+
+  // Threaded FillBuckets() for large ranges. The counts, minima and maxima of
+  // the buckets do not depend on the order in which the cells are visited.
+  struct BucketWorker
+  {
+    const PerCell* Cells;
+    const float* Min;
+    const float* IExt;
+    vtkSMPThreadLocal<std::vector<Bucket>> LocalBuckets;
+    Bucket (*Buckets)[NumberOfBuckets];
+
+    void Initialize() { this->LocalBuckets.Local().assign(3 * NumberOfBuckets, Bucket()); }
+
+    void operator()(vtkIdType begin, vtkIdType end)
+    {
+      Bucket(*b)[NumberOfBuckets] =
+        reinterpret_cast<Bucket(*)[NumberOfBuckets]>(this->LocalBuckets.Local().data());
+      FillBuckets(this->Cells + begin, this->Cells + end, this->Min, this->IExt, b);
+    }
+
+    void Reduce()
+    {
+      for (auto iter = this->LocalBuckets.begin(); iter != this->LocalBuckets.end(); ++iter)
+      {
+        for (unsigned int d = 0; d < 3; ++d)
+        {
+          for (int n = 0; n < NumberOfBuckets; ++n)
+          {
+            const Bucket& local = (*iter)[d * NumberOfBuckets + n];
+            Bucket& bucket = this->Buckets[d][n];
+            bucket.Cnt += local.Cnt;
+            bucket.Min = std::min(bucket.Min, local.Min);
+            bucket.Max = std::max(bucket.Max, local.Max);
+          }
+        }
+      }
+    }
+  };
+
+  // A node whose subtree is built concurrently with the other ones.
+  struct Subtree
+  {
+    unsigned int Index;
+    float Min[3];
+    float Max[3];
+    std::vector<vtkCellTreeLocator::vtkCellTreeNode> Nodes;
+  };
+
+  // -------------------------------------------------------------------------
+
+  // Split the node index of nodes recursively. If subtrees is non-null,
+  // the nodes with at most CELLTREE_SUBTREE_SIZE cells are not split but
+  // added to subtrees, to be built later by BuildSubtrees(). Splitting a node
+  // only reorders the cells of the node, so the tree does not depend on the
+  // order in which the nodes are split.
+  void Split(std::vector<vtkCellTreeLocator::vtkCellTreeNode>& nodes, unsigned int index,
+    float min[3], float max[3], std::vector<Subtree>* subtrees)
+  {
+    unsigned int start = nodes[index].Start();
+    unsigned int size = nodes[index].Size();
+
+    if (size < this->m_leafsize)
+    {
+      return;
+    }
+
+    if (subtrees && size <= CELLTREE_SUBTREE_SIZE)
+    {
+      Subtree subtree;
+      subtree.Index = index;
+      std::copy(min, min + 3, subtree.Min);
+      std::copy(max, max + 3, subtree.Max);
+      subtrees->push_back(subtree);
+      return;
+    }
+
+    PerCell* begin = &(this->m_pc[start]);
+    PerCell* end = &(this->m_pc[0]) + start + size;
+    PerCell* mid = begin;
+
+    const int nbuckets = NumberOfBuckets;
+
+    const float ext[3] = { max[0] - min[0], max[1] - min[1], max[2] - min[2] };
+    const float iext[3] = { nbuckets / ext[0], nbuckets / ext[1], nbuckets / ext[2] };
+
+    Bucket b[3][nbuckets];
+
+    if (size > CELLTREE_SUBTREE_SIZE)
+    {
+      BucketWorker worker;
+      worker.Cells = begin;
+      worker.Min = min;
+      worker.IExt = iext;
+      worker.Buckets = b;
+      vtkSMPTools::For(0, size, worker);
+    }
+    else
+    {
+      FillBuckets(begin, end, min, iext, b);
+    }
 
     float cost = std::numeric_limits<float>::max();
     float plane = VTK_FLOAT_MIN;    // bad value in case it doesn't get setx
@@ -407,8 +557,8 @@ private:
 
     float lmin[3], lmax[3], rmin[3], rmax[3];
 
-    FindMinMax(begin, mid, lmin, lmax);
-    FindMinMax(mid, end, rmin, rmax);
+    FindMinMaxParallel(begin, mid, lmin, lmax);
+    FindMinMaxParallel(mid, end, rmin, rmax);
 
     float clip[2] = { lmax[dim], rmin[dim] };
 
@@ -416,11 +566,43 @@ private:
     child[0].MakeLeaf(begin - &(this->m_pc[0]), mid - begin);
     child[1].MakeLeaf(mid - &(this->m_pc[0]), end - mid);
 
-    this->m_nodes[index].MakeNode((int)m_nodes.size(), dim, clip);
-    this->m_nodes.insert(m_nodes.end(), child, child + 2);
+    nodes[index].MakeNode((int)nodes.size(), dim, clip);
+    nodes.insert(nodes.end(), child, child + 2);
 
-    Split(this->m_nodes[index].GetLeftChildIndex(), lmin, lmax);
-    Split(this->m_nodes[index].GetRightChildIndex(), rmin, rmax);
+    Split(nodes, nodes[index].GetLeftChildIndex(), lmin, lmax, subtrees);
+    Split(nodes, nodes[index].GetRightChildIndex(), rmin, rmax, subtrees);
+  }
+
+  // Build the subtrees concurrently, each one into its own array of nodes,
+  // then append them to m_nodes.
+  void BuildSubtrees(std::vector<Subtree>& subtrees)
+  {
+    vtkSMPTools::For(0, static_cast<vtkIdType>(subtrees.size()),
+      [this, &subtrees](vtkIdType subtreeId, vtkIdType endSubtreeId) {
+        for (; subtreeId < endSubtreeId; ++subtreeId)
+        {
+          Subtree& subtree = subtrees[subtreeId];
+          subtree.Nodes.push_back(this->m_nodes[subtree.Index]);
+          this->Split(subtree.Nodes, 0, subtree.Min, subtree.Max, nullptr);
+        }
+      });
+
+    for (Subtree& subtree : subtrees)
+    {
+      // Node j > 0 of the subtree goes to offset + j - 1, its root replaces
+      // the node it was built from.
+      const unsigned int offset = static_cast<unsigned int>(this->m_nodes.size());
+      for (auto& node : subtree.Nodes)
+      {
+        if (!node.IsLeaf())
+        {
+          node.SetChildren(offset + node.GetLeftChildIndex() - 1);
+        }
+      }
+      this->m_nodes[subtree.Index] = subtree.Nodes[0];
+      this->m_nodes.insert(this->m_nodes.end(), subtree.Nodes.begin() + 1, subtree.Nodes.end());
+      std::vector<vtkCellTreeLocator::vtkCellTreeNode>().swap(subtree.Nodes);
+    }
   }
 
 public:
@@ -433,48 +615,42 @@ public:
   void Build(vtkCellTreeLocator* ctl, vtkCellTreeLocator::vtkCellTree& ct, vtkDataSet* ds)
   {
     const vtkIdType size = ds->GetNumberOfCells();
-    double cellBounds[6];
     this->m_pc.resize(size);
 
-    float min[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
-      std::numeric_limits<float>::max() };
-
-    float max[3] = {
-      -std::numeric_limits<float>::max(),
-      -std::numeric_limits<float>::max(),
-      -std::numeric_limits<float>::max(),
-    };
-
-    for (vtkIdType i = 0; i < size; ++i)
+    // Gather the cell bounds in parallel. The first call causes non-thread
+    // safe initialization to occur due to side effects from GetCellBounds().
+    double(*cachedBounds)[6] = ctl->CellBounds;
+    if (!cachedBounds)
     {
-      this->m_pc[i].Ind = i;
-
-      double* boundsPtr = cellBounds;
-      if (ctl->CellBounds)
-      {
-        boundsPtr = ctl->CellBounds[i];
-      }
-      else
-      {
-        ds->GetCellBounds(i, boundsPtr);
-      }
-
-      for (int d = 0; d < 3; ++d)
+      double cellBounds[6];
+      ds->GetCellBounds(0, cellBounds);
+    }
+    vtkSMPTools::For(0, size, [this, ds, cachedBounds](vtkIdType i, vtkIdType end) {
+      double cellBounds[6];
+      for (; i < end; ++i)
       {
-        this->m_pc[i].Min[d] = boundsPtr[2 * d + 0];
-        this->m_pc[i].Max[d] = boundsPtr[2 * d + 1];
+        this->m_pc[i].Ind = i;
 
-        if (this->m_pc[i].Min[d] < min[d])
+        double* boundsPtr = cellBounds;
+        if (cachedBounds)
         {
-          min[d] = this->m_pc[i].Min[d];
+          boundsPtr = cachedBounds[i];
+        }
+        else
+        {
+          ds->GetCellBounds(i, boundsPtr);
         }
 
-        if (this->m_pc[i].Max[d] > max[d]) /// This can be m_pc[i].max[d] instead of min
+        for (int d = 0; d < 3; ++d)
         {
-          max[d] = this->m_pc[i].Max[d];
+          this->m_pc[i].Min[d] = boundsPtr[2 * d + 0];
+          this->m_pc[i].Max[d] = boundsPtr[2 * d + 1];
         }
       }
-    }
+    });
+
+    float min[3], max[3];
+    FindMinMaxParallel(this->m_pc.data(), this->m_pc.data() + size, min, max);
 
     ct.DataBBox[0] = min[0];
     ct.DataBBox[1] = max[0];
@@ -487,7 +663,10 @@ public:
     root.MakeLeaf(0, size);
     this->m_nodes.push_back(root);
 
-    Split(0, min, max);
+    // Split the large nodes, then build the subtrees below them concurrently.
+    std::vector<Subtree> subtrees;
+    Split(this->m_nodes, 0, min, max, &subtrees);
+    this->BuildSubtrees(subtrees);
 
     ct.Nodes.resize(this->m_nodes.size());
     ct.Nodes[0] = this->m_nodes[0];
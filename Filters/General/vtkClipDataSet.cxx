@@ -309,11 +309,7 @@ int vtkClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
     {
       inPD->SetScalars(tmpScalars);
     }
-    for (i = 0; i < numPts; i++)
-    {
-      s = this->ClipFunction->FunctionValue(input->GetPoint(i));
-      tmpScalars->SetTuple1(i, s);
-    }
+    this->ClipFunction->FunctionValue(input, tmpScalars);
     clipScalars = tmpScalars;
   }
   else // using input scalars
@@ -28,11 +28,14 @@
 #include "vtkPolyData.h"
 #include "vtkPolyDataNormals.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkTriangle.h"
 #include "vtkTriangleFilter.h"
 #include "vtkTriangleStrip.h"
 
 #include <memory> // For unique_ptr
+#include <vector>
 
 vtkStandardNewMacro(vtkCurvatures);
 
@@ -76,9 +79,6 @@ void vtkCurvatures::GetMeanCurvature(vtkPolyData* mesh)
   int numPts = polyData->GetNumberOfPoints();
 
   //     create-allocate
-  const vtkNew<vtkIdList> vertices;
-  const vtkNew<vtkIdList> vertices_n;
-  const vtkNew<vtkIdList> neighbours;
   const vtkNew<vtkDoubleArray> meanCurvature;
   meanCurvature->SetName("Mean_Curvature");
   meanCurvature->SetNumberOfComponents(1);
@@ -86,21 +86,12 @@ void vtkCurvatures::GetMeanCurvature(vtkPolyData* mesh)
   // Get the array so we can write to it directly
   double* meanCurvatureData = meanCurvature->GetPointer(0);
 
-  //     create-allocate
-  double n_f[3]; // normal of facet (could be stored for later?)
-  double n_n[3]; // normal of edge
-  double t[3];   // to store the cross product of n_f n_n
-  double ore[3]; // origin of e
-  double end[3]; // end of e
-  double oth[3]; //     third vertex necessary for comp of n
-  double vn0[3];
-  double vn1[3]; // vertices for computation of neighbour's n
-  double vn2[3];
-  double e[3]; // edge (oriented)
-
+  // The links and cells are built first, so that the cell points and edge
+  // neighbors may then be queried concurrently.
   polyData->BuildLinks();
   // data init
-  const int F = polyData->GetNumberOfCells();
+  vtkPoints* points = polyData->GetPoints();
+  const vtkIdType F = polyData->GetNumberOfCells();
   // init, preallocate the mean curvature
   const std::unique_ptr<int[]> num_neighb(new int[numPts]);
   for (int v = 0; v < numPts; v++)
@@ -109,77 +100,129 @@ void vtkCurvatures::GetMeanCurvature(vtkPolyData* mesh)
     num_neighb[v] = 0;
   }
 
+  // The edge uses of each cell start at its offset.
+  vtkIdType npts;
+  const vtkIdType* pts;
+  std::vector<vtkIdType> offsets(F + 1);
+  offsets[0] = 0;
+  for (vtkIdType f = 0; f < F; ++f)
+  {
+    polyData->GetCellPoints(f, npts, pts);
+    offsets[f + 1] = offsets[f] + npts;
+  }
+
   //     main loop
   vtkDebugMacro(<< "Main loop: loop over facets such that id > id of neighb");
   vtkDebugMacro(<< "so that every edge comes only once");
 
-  for (vtkIdType f = 0; f < F; ++f)
-  {
-    polyData->GetCellPoints(f, vertices);
-    const vtkIdType nv = vertices->GetNumberOfIds();
-
-    for (vtkIdType v = 0; v < nv; v++)
+  // The contribution of each edge is computed in parallel and stored per
+  // edge use; the contributions are then accumulated serially, in facet
+  // order, so that the result does not depend on the number of threads.
+  std::vector<double> edgeHf(offsets[F]);
+  std::vector<unsigned char> edgeUsed(offsets[F], 0);
+  vtkSMPThreadLocalObject<vtkIdList> tlVertices;
+  vtkSMPThreadLocalObject<vtkIdList> tlVerticesN;
+  vtkSMPThreadLocalObject<vtkIdList> tlNeighbours;
+  vtkSMPTools::For(0, F, [&](vtkIdType f, vtkIdType endF) {
+    vtkIdList* vertices = tlVertices.Local();
+    vtkIdList* vertices_n = tlVerticesN.Local();
+    vtkIdList* neighbours = tlNeighbours.Local();
+
+    double n_f[3]; // normal of facet (could be stored for later?)
+    double n_n[3]; // normal of edge
+    double t[3];   // to store the cross product of n_f n_n
+    double ore[3]; // origin of e
+    double end[3]; // end of e
+    double oth[3]; //     third vertex necessary for comp of n
+    double vn0[3];
+    double vn1[3]; // vertices for computation of neighbour's n
+    double vn2[3];
+    double e[3]; // edge (oriented)
+
+    for (; f < endF; ++f)
     {
-      // get neighbour
-      const vtkIdType v_l = vertices->GetId(v);
-      const vtkIdType v_r = vertices->GetId((v + 1) % nv);
-      const vtkIdType v_o = vertices->GetId((v + 2) % nv);
-      polyData->GetCellEdgeNeighbors(f, v_l, v_r, neighbours);
-
-      vtkIdType n; // n short for neighbor
-
-      // compute only if there is really ONE neighbour
-      // AND meanCurvature has not been computed yet!
-      // (ensured by n > f)
-      if (neighbours->GetNumberOfIds() == 1 && (n = neighbours->GetId(0)) > f)
+      polyData->GetCellPoints(f, vertices);
+      const vtkIdType nv = vertices->GetNumberOfIds();
+
+      for (vtkIdType v = 0; v < nv; v++)
       {
-        double Hf; // temporary store
-
-        // find 3 corners of f: in order!
-        polyData->GetPoint(v_l, ore);
-        polyData->GetPoint(v_r, end);
-        polyData->GetPoint(v_o, oth);
-        // compute normal of f
-        vtkTriangle::ComputeNormal(ore, end, oth, n_f);
-        // compute common edge
-        e[0] = end[0];
-        e[1] = end[1];
-        e[2] = end[2];
-        e[0] -= ore[0];
-        e[1] -= ore[1];
-        e[2] -= ore[2];
-        const double length = vtkMath::Normalize(e);
-        double Af = vtkTriangle::TriangleArea(ore, end, oth);
-        // find 3 corners of n: in order!
-        polyData->GetCellPoints(n, vertices_n);
-        polyData->GetPoint(vertices_n->GetId(0), vn0);
-        polyData->GetPoint(vertices_n->GetId(1), vn1);
-        polyData->GetPoint(vertices_n->GetId(2), vn2);
-        Af += double(vtkTriangle::TriangleArea(vn0, vn1, vn2));
-        // compute normal of n
-        vtkTriangle::ComputeNormal(vn0, vn1, vn2, n_n);
-        // the cosine is n_f * n_n
-        const double cs = vtkMath::Dot(n_f, n_n);
-        // the sin is (n_f x n_n) * e
-        vtkMath::Cross(n_f, n_n, t);
-        const double sn = vtkMath::Dot(t, e);
-        // signed angle in [-pi,pi]
-        if (sn != 0.0 || cs != 0.0)
-        {
-          const double angle = atan2(sn, cs);
-          Hf = length * angle;
-        }
-        else
+        // get neighbour
+        const vtkIdType v_l = vertices->GetId(v);
+        const vtkIdType v_r = vertices->GetId((v + 1) % nv);
+        const vtkIdType v_o = vertices->GetId((v + 2) % nv);
+        polyData->GetCellEdgeNeighbors(f, v_l, v_r, neighbours);
+
+        vtkIdType n; // n short for neighbor
+
+        // compute only if there is really ONE neighbour
+        // AND meanCurvature has not been computed yet!
+        // (ensured by n > f)
+        if (neighbours->GetNumberOfIds() == 1 && (n = neighbours->GetId(0)) > f)
         {
-          Hf = 0.0;
+          double Hf; // temporary store
+
+          // find 3 corners of f: in order!
+          points->GetPoint(v_l, ore);
+          points->GetPoint(v_r, end);
+          points->GetPoint(v_o, oth);
+          // compute normal of f
+          vtkTriangle::ComputeNormal(ore, end, oth, n_f);
+          // compute common edge
+          e[0] = end[0];
+          e[1] = end[1];
+          e[2] = end[2];
+          e[0] -= ore[0];
+          e[1] -= ore[1];
+          e[2] -= ore[2];
+          const double length = vtkMath::Normalize(e);
+          double Af = vtkTriangle::TriangleArea(ore, end, oth);
+          // find 3 corners of n: in order!
+          polyData->GetCellPoints(n, vertices_n);
+          points->GetPoint(vertices_n->GetId(0), vn0);
+          points->GetPoint(vertices_n->GetId(1), vn1);
+          points->GetPoint(vertices_n->GetId(2), vn2);
+          Af += double(vtkTriangle::TriangleArea(vn0, vn1, vn2));
+          // compute normal of n
+          vtkTriangle::ComputeNormal(vn0, vn1, vn2, n_n);
+          // the cosine is n_f * n_n
+          const double cs = vtkMath::Dot(n_f, n_n);
+          // the sin is (n_f x n_n) * e
+          vtkMath::Cross(n_f, n_n, t);
+          const double sn = vtkMath::Dot(t, e);
+          // signed angle in [-pi,pi]
+          if (sn != 0.0 || cs != 0.0)
+          {
+            const double angle = atan2(sn, cs);
+            Hf = length * angle;
+          }
+          else
+          {
+            Hf = 0.0;
+          }
+          // weighted Hf, added to scalar at v_l and v_r below
+          if (Af != 0.0)
+          {
+            (Hf /= Af) *= 3.0;
+          }
+          edgeHf[offsets[f] + v] = Hf;
+          edgeUsed[offsets[f] + v] = 1;
         }
-        // add weighted Hf to scalar at v_l and v_r
-        if (Af != 0.0)
-        {
-          (Hf /= Af) *= 3.0;
-        }
-        meanCurvatureData[v_l] += Hf;
-        meanCurvatureData[v_r] += Hf;
+      }
+    }
+  });
+
+  for (vtkIdType f = 0; f < F; ++f)
+  {
+    polyData->GetCellPoints(f, npts, pts);
+    const vtkIdType offset = offsets[f];
+    for (vtkIdType v = 0; v < npts; v++)
+    {
+      if (edgeUsed[offset + v])
+      {
+        const vtkIdType v_l = pts[v];
+        const vtkIdType v_r = pts[(v + 1) % npts];
+        meanCurvatureData[v_l] += edgeHf[offset + v];
+        meanCurvatureData[v_r] += edgeHf[offset + v];
         num_neighb[v_l] += 1;
         num_neighb[v_r] += 1;
       }
@@ -264,15 +307,10 @@ void vtkCurvatures::GetGaussCurvature(vtkPolyData* output)
 void vtkCurvatures::ComputeGaussCurvature(
   vtkCellArray* facets, vtkPolyData* output, double* gaussCurvatureData)
 {
-  double v0[3], v1[3], v2[3], e0[3], e1[3], e2[3];
-
-  double A, alpha0, alpha1, alpha2;
-
-  vtkIdType f;
-  const vtkIdType* vert = nullptr;
-
   // other data
   vtkIdType Nv = output->GetNumberOfPoints();
+  vtkPoints* points = output->GetPoints();
+  const vtkIdType numFacets = facets->GetNumberOfCells();
 
   const std::unique_ptr<double[]> K(new double[Nv]);
   const std::unique_ptr<double[]> dA(new double[Nv]);
@@ -283,50 +321,68 @@ void vtkCurvatures::ComputeGaussCurvature(
     dA[k] = 0.0;
   }
 
-  facets->InitTraversal();
-  while (facets->GetNextCell(f, vert))
+  // The area and angles of each facet are computed in parallel, then
+  // accumulated serially in facet order (so the sums are always the same).
+  std::vector<double> facetData(4 * numFacets);
+  vtkSMPThreadLocalObject<vtkIdList> tlVert;
+  vtkSMPTools::For(0, numFacets, [&](vtkIdType f, vtkIdType endF) {
+    vtkIdList* vert = tlVert.Local();
+    double v0[3], v1[3], v2[3], e0[3], e1[3], e2[3];
+    for (; f < endF; ++f)
+    {
+      facets->GetCellAtId(f, vert);
+      points->GetPoint(vert->GetId(0), v0);
+      points->GetPoint(vert->GetId(1), v1);
+      points->GetPoint(vert->GetId(2), v2);
+      // edges
+      e0[0] = v1[0];
+      e0[1] = v1[1];
+      e0[2] = v1[2];
+      e0[0] -= v0[0];
+      e0[1] -= v0[1];
+      e0[2] -= v0[2];
+
+      e1[0] = v2[0];
+      e1[1] = v2[1];
+      e1[2] = v2[2];
+      e1[0] -= v1[0];
+      e1[1] -= v1[1];
+      e1[2] -= v1[2];
+
+      e2[0] = v0[0];
+      e2[1] = v0[1];
+      e2[2] = v0[2];
+      e2[0] -= v2[0];
+      e2[1] -= v2[1];
+      e2[2] -= v2[2];
+
+      // normalise
+      vtkMath::Normalize(e0);
+      vtkMath::Normalize(e1);
+      vtkMath::Normalize(e2);
+      // angles
+      // I get lots of acos domain errors so clamp the value to +/-1 as the
+      // normalize function can return 1.000000001 etc (I think)
+      double ac1 = vtkMath::Dot(e1, e2);
+      double ac2 = vtkMath::Dot(e2, e0);
+      double ac3 = vtkMath::Dot(e0, e1);
+      double* data = facetData.data() + 4 * f;
+      data[0] = acos(-CLAMP_MACRO(ac1));
+      data[1] = acos(-CLAMP_MACRO(ac2));
+      data[2] = acos(-CLAMP_MACRO(ac3));
+
+      // surf. area
+      data[3] = double(vtkTriangle::TriangleArea(v0, v1, v2));
+    }
+  });
+
+  vtkIdType npts;
+  const vtkIdType* vert = nullptr;
+  vtkIdType f = 0;
+  for (facets->InitTraversal(); facets->GetNextCell(npts, vert); ++f)
   {
-    output->GetPoint(vert[0], v0);
-    output->GetPoint(vert[1], v1);
-    output->GetPoint(vert[2], v2);
-    // edges
-    e0[0] = v1[0];
-    e0[1] = v1[1];
-    e0[2] = v1[2];
-    e0[0] -= v0[0];
-    e0[1] -= v0[1];
-    e0[2] -= v0[2];
-
-    e1[0] = v2[0];
-    e1[1] = v2[1];
-    e1[2] = v2[2];
-    e1[0] -= v1[0];
-    e1[1] -= v1[1];
-    e1[2] -= v1[2];
-
-    e2[0] = v0[0];
-    e2[1] = v0[1];
-    e2[2] = v0[2];
-    e2[0] -= v2[0];
-    e2[1] -= v2[1];
-    e2[2] -= v2[2];
-
-    // normalise
-    vtkMath::Normalize(e0);
-    vtkMath::Normalize(e1);
-    vtkMath::Normalize(e2);
-    // angles
-    // I get lots of acos domain errors so clamp the value to +/-1 as the
-    // normalize function can return 1.000000001 etc (I think)
-    double ac1 = vtkMath::Dot(e1, e2);
-    double ac2 = vtkMath::Dot(e2, e0);
-    double ac3 = vtkMath::Dot(e0, e1);
-    alpha0 = acos(-CLAMP_MACRO(ac1));
-    alpha1 = acos(-CLAMP_MACRO(ac2));
-    alpha2 = acos(-CLAMP_MACRO(ac3));
-
-    // surf. area
-    A = double(vtkTriangle::TriangleArea(v0, v1, v2));
+    const double* data = facetData.data() + 4 * f;
+    const double alpha0 = data[0], alpha1 = data[1], alpha2 = data[2], A = data[3];
     // UPDATE
     dA[vert[0]] += A;
     dA[vert[1]] += A;
@@ -16,11 +16,16 @@
 
 #include "vtkCellData.h"
 #include "vtkDoubleArray.h"
+#include "vtkGenericCell.h"
 #include "vtkImplicitPolyDataDistance.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTriangle.h"
 
@@ -92,22 +97,11 @@ void vtkDistancePolyDataFilter::GetPolyDataDistance(vtkPolyData* mesh, vtkPolyDa
   vtkImplicitPolyDataDistance* imp = vtkImplicitPolyDataDistance::New();
   imp->SetInput(src);
 
-  // Calculate distance from points.
-  int numPts = mesh->GetNumberOfPoints();
-
+  // Calculate distance from points, in parallel.
   vtkDoubleArray* pointArray = vtkDoubleArray::New();
   pointArray->SetName("Distance");
-  pointArray->SetNumberOfComponents(1);
-  pointArray->SetNumberOfTuples(numPts);
-
-  for (vtkIdType ptId = 0; ptId < numPts; ptId++)
-  {
-    double pt[3];
-    mesh->GetPoint(ptId, pt);
-    double val = imp->EvaluateFunction(pt);
-    double dist = SignedDistance ? (NegateDistance ? -val : val) : fabs(val);
-    pointArray->SetValue(ptId, dist);
-  }
+  imp->EvaluateFunctionAndGetClosestPoints(mesh->GetPoints(), pointArray);
+  this->ApplyDistanceSign(pointArray);
 
   mesh->GetPointData()->AddArray(pointArray);
   pointArray->Delete();
@@ -116,26 +110,33 @@ void vtkDistancePolyDataFilter::GetPolyDataDistance(vtkPolyData* mesh, vtkPolyDa
   // Calculate distance from cell centers.
   if (this->ComputeCellCenterDistance)
   {
-    int numCells = mesh->GetNumberOfCells();
-
-    vtkDoubleArray* cellArray = vtkDoubleArray::New();
-    cellArray->SetName("Distance");
-    cellArray->SetNumberOfComponents(1);
-    cellArray->SetNumberOfTuples(numCells);
-
-    for (vtkIdType cellId = 0; cellId < numCells; cellId++)
-    {
-      vtkCell* cell = mesh->GetCell(cellId);
+    vtkIdType numCells = mesh->GetNumberOfCells();
+
+    // Compute the cell centers in parallel. The first cell is fetched
+    // serially to make sure the mesh is ready for threaded access.
+    vtkNew<vtkGenericCell> firstCell;
+    mesh->GetCell(0, firstCell);
+    vtkNew<vtkPoints> centers;
+    centers->SetDataTypeToDouble();
+    centers->SetNumberOfPoints(numCells);
+    vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+    vtkSMPTools::For(0, numCells, [&](vtkIdType cellId, vtkIdType endCellId) {
+      vtkGenericCell* cell = tlCell.Local();
       int subId;
       double pcoords[3], x[3], weights[VTK_MAXIMUM_NUMBER_OF_POINTS];
+      for (; cellId < endCellId; cellId++)
+      {
+        mesh->GetCell(cellId, cell);
+        cell->GetParametricCenter(pcoords);
+        cell->EvaluateLocation(subId, pcoords, x, weights);
+        centers->SetPoint(cellId, x);
+      }
+    });
 
-      cell->GetParametricCenter(pcoords);
-      cell->EvaluateLocation(subId, pcoords, x, weights);
-
-      double val = imp->EvaluateFunction(x);
-      double dist = SignedDistance ? (NegateDistance ? -val : val) : fabs(val);
-      cellArray->SetValue(cellId, dist);
-    }
+    vtkDoubleArray* cellArray = vtkDoubleArray::New();
+    cellArray->SetName("Distance");
+    imp->EvaluateFunctionAndGetClosestPoints(centers, cellArray);
+    this->ApplyDistanceSign(cellArray);
 
     mesh->GetCellData()->AddArray(cellArray);
     cellArray->Delete();
@@ -147,6 +148,23 @@ void vtkDistancePolyDataFilter::GetPolyDataDistance(vtkPolyData* mesh, vtkPolyDa
   vtkDebugMacro(<< "End vtkDistancePolyDataFilter::GetPolyDataDistance");
 }
 
+//------------------------------------------------------------------------------
+void vtkDistancePolyDataFilter::ApplyDistanceSign(vtkDoubleArray* distances)
+{
+  if (this->SignedDistance && !this->NegateDistance)
+  {
+    return;
+  }
+  double* values = distances->GetPointer(0);
+  const bool negate = (this->SignedDistance != 0);
+  vtkSMPTools::For(0, distances->GetNumberOfValues(), [=](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      values[i] = negate ? -values[i] : fabs(values[i]);
+    }
+  });
+}
+
 //------------------------------------------------------------------------------
 vtkPolyData* vtkDistancePolyDataFilter::GetSecondDistanceOutput()
 {
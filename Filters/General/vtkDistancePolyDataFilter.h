@@ -27,6 +27,9 @@
  * computed by calling SignedDistanceOff(). The signed distance field
  * may be negated by calling NegateDistanceOn();
  *
+ * The distances are evaluated in parallel, with the batch methods of
+ * vtkImplicitPolyDataDistance.
+ *
  * This code was contributed in the VTK Journal paper:
  * "Boolean Operations on Surfaces in VTK Without External Libraries"
  * by Cory Quammen, Chris Weigle C., Russ Taylor
@@ -40,6 +43,8 @@
 #include "vtkFiltersGeneralModule.h" // For export macro
 #include "vtkPolyDataAlgorithm.h"
 
+class vtkDoubleArray;
+
 class VTKFILTERSGENERAL_EXPORT vtkDistancePolyDataFilter : public vtkPolyDataAlgorithm
 {
 public:
@@ -105,6 +110,9 @@ protected:
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
   void GetPolyDataDistance(vtkPolyData*, vtkPolyData*);
 
+  // Turn the signed distances into the requested (negated or unsigned) ones.
+  void ApplyDistanceSign(vtkDoubleArray*);
+
 private:
   vtkDistancePolyDataFilter(const vtkDistancePolyDataFilter&) = delete;
   void operator=(const vtkDistancePolyDataFilter&) = delete;
@@ -25,6 +25,7 @@
 #include "vtkCellDataToPointData.h"
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
+#include "vtkGenericCell.h"
 #include "vtkIdList.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
@@ -35,11 +36,16 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
+#include "vtkStaticCellLinks.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStructuredGrid.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <limits>
 #include <vector>
 
@@ -87,15 +93,17 @@ void ComputeQCriterionFromGradient(data_type* gradients, data_type* qCriterion)
 template <class data_type>
 void ComputePointGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
   int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence,
-  int highestCellDimension, int contributingCellOption);
+  const unsigned char* cellDimensions, int highestCellDimension, int contributingCellOption);
 
-int GetCellParametricData(
-  vtkIdType pointId, double pointCoord[3], vtkCell* cell, int& subId, double parametricCoord[3]);
+int GetCellParametricData(vtkIdType pointId, double pointCoord[3], vtkCell* cell, int& subId,
+  double parametricCoord[3], double* weights);
 
 template <class data_type>
 void ComputeCellGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
   int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence);
 
+void ComputeCellDimensions(vtkDataSet* structure, unsigned char* cellDimensions);
+
 // Functions for image data and structured grids
 template <class Grid, class data_type>
 void ComputeGradientsSG(Grid output, vtkDataArray* array, data_type* gradients,
@@ -449,21 +457,19 @@ int vtkGradientFilter::ComputeUnstructuredGridGradient(vtkDataArray* array, int
     }
   }
 
+  // The cell dimensions are only needed when not all cells contribute to the
+  // point gradients. They are computed once, in parallel, rather than
+  // instantiating each cell again for every point using it.
+  std::vector<unsigned char> cellDimensions;
   int highestCellDimension = 0;
-  if (this->ContributingCellOption == vtkGradientFilter::DataSetMax)
+  if (this->ContributingCellOption != vtkGradientFilter::All &&
+    fieldAssociation == vtkDataObject::FIELD_ASSOCIATION_POINTS && !this->FasterApproximation)
   {
-    int maxDimension = input->IsA("vtkPolyData") == 1 ? 2 : 3;
-    for (vtkIdType i = 0; i < input->GetNumberOfCells(); i++)
+    cellDimensions.resize(input->GetNumberOfCells());
+    ComputeCellDimensions(input, cellDimensions.data());
+    if (this->ContributingCellOption == vtkGradientFilter::DataSetMax)
     {
-      int dim = input->GetCell(i)->GetCellDimension();
-      if (dim > highestCellDimension)
-      {
-        highestCellDimension = dim;
-        if (highestCellDimension == maxDimension)
-        {
-          break;
-        }
-      }
+      highestCellDimension = *std::max_element(cellDimensions.begin(), cellDimensions.end());
     }
   }
 
@@ -479,7 +485,8 @@ int vtkGradientFilter::ComputeUnstructuredGridGradient(vtkDataArray* array, int
           (vorticity == nullptr ? nullptr : static_cast<VTK_TT*>(vorticity->GetVoidPointer(0))),
           (qCriterion == nullptr ? nullptr : static_cast<VTK_TT*>(qCriterion->GetVoidPointer(0))),
           (divergence == nullptr ? nullptr : static_cast<VTK_TT*>(divergence->GetVoidPointer(0))),
-          highestCellDimension, this->ContributingCellOption));
+          (cellDimensions.empty() ? nullptr : cellDimensions.data()), highestCellDimension,
+          this->ContributingCellOption));
       }
       if (gradients)
       {
@@ -806,123 +813,204 @@ int vtkGradientFilter::GetOutputArrayType(vtkDataArray* array)
 namespace
 {
 //------------------------------------------------------------------------------
+// Threaded computation of point gradients for unstructured grids and
+// polydata. The point-to-cell links are built once up front and shared by all
+// threads; each thread uses its own cell and scratch buffers. The vorticity,
+// Q-criterion and divergence are derived from the averaged gradient in the
+// same pass.
 template <class data_type>
-void ComputePointGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
-  int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence,
-  int highestCellDimension, int contributingCellOption)
+struct PointGradientsUG
 {
-  vtkNew<vtkIdList> currentPoint;
-  currentPoint->SetNumberOfIds(1);
-  vtkNew<vtkIdList> cellsOnPoint;
-
-  vtkIdType numpts = structure->GetNumberOfPoints();
-
-  int numberOfOutputComponents = 3 * numberOfInputComponents;
-  std::vector<data_type> g(numberOfOutputComponents);
+  vtkDataSet* Structure;
+  vtkDataArray* Array;
+  vtkStaticCellLinks* Links;
+  const unsigned char* CellDimensions;
+  data_type* Gradients;
+  data_type* Vorticity;
+  data_type* QCriterion;
+  data_type* Divergence;
+  int NumberOfInputComponents;
+  int HighestCellDimension;
+  int ContributingCellOption;
+  int MaxCellDimension;
+
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double>> Values;
+  vtkSMPThreadLocal<std::vector<double>> Weights;
+  vtkSMPThreadLocal<std::vector<data_type>> G;
+
+  PointGradientsUG(vtkDataSet* structure, vtkDataArray* array, vtkStaticCellLinks* links,
+    const unsigned char* cellDimensions, data_type* gradients, data_type* vorticity,
+    data_type* qCriterion, data_type* divergence, int numberOfInputComponents,
+    int highestCellDimension, int contributingCellOption)
+    : Structure(structure)
+    , Array(array)
+    , Links(links)
+    , CellDimensions(cellDimensions)
+    , Gradients(gradients)
+    , Vorticity(vorticity)
+    , QCriterion(qCriterion)
+    , Divergence(divergence)
+    , NumberOfInputComponents(numberOfInputComponents)
+    , HighestCellDimension(highestCellDimension)
+    , ContributingCellOption(contributingCellOption)
+  {
+    // if we are doing patches for contributing cell dimensions we want to keep track of
+    // the maximum expected dimension so we can exit out of the check loop quicker
+    this->MaxCellDimension = structure->IsA("vtkPolyData") ? 2 : 3;
+  }
 
-  // if we are doing patches for contributing cell dimensions we want to keep track of
-  // the maximum expected dimension so we can exit out of the check loop quicker
-  const int maxCellDimension = structure->IsA("vtkPolyData") ? 2 : 3;
+  void Initialize()
+  {
+    this->Values.Local().resize(VTK_CELL_SIZE);
+    this->Weights.Local().resize(VTK_CELL_SIZE);
+    this->G.Local().resize(3 * this->NumberOfInputComponents);
+  }
 
-  for (vtkIdType point = 0; point < numpts; point++)
+  void operator()(vtkIdType point, vtkIdType endPoint)
   {
-    currentPoint->SetId(0, point);
-    double pointcoords[3];
-    structure->GetPoint(point, pointcoords);
-    // Get all cells touching this point.
-    structure->GetCellNeighbors(-1, currentPoint, cellsOnPoint);
-    vtkIdType numCellNeighbors = cellsOnPoint->GetNumberOfIds();
-
-    for (int i = 0; i < numberOfOutputComponents; i++)
+    vtkGenericCell* cell = this->Cell.Local();
+    std::vector<double>& values = this->Values.Local();
+    std::vector<double>& weights = this->Weights.Local();
+    std::vector<data_type>& g = this->G.Local();
+    const int numberOfInputComponents = this->NumberOfInputComponents;
+    const int numberOfOutputComponents = 3 * numberOfInputComponents;
+
+    for (; point < endPoint; point++)
     {
-      g[i] = 0;
-    }
+      double pointcoords[3];
+      this->Structure->GetPoint(point, pointcoords);
+      // Get all cells touching this point.
+      const vtkIdType numCellNeighbors = this->Links->GetNcells(point);
+      const vtkIdType* cellsOnPoint = this->Links->GetCells(point);
 
-    if (contributingCellOption == vtkGradientFilter::Patch)
-    {
-      highestCellDimension = 0;
-      for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
+      std::fill(g.begin(), g.end(), static_cast<data_type>(0));
+
+      int highestCellDimension = this->HighestCellDimension;
+      if (this->ContributingCellOption == vtkGradientFilter::Patch)
       {
-        int cellDimension = structure->GetCell(cellsOnPoint->GetId(neighbor))->GetCellDimension();
-        if (cellDimension > highestCellDimension)
+        highestCellDimension = 0;
+        for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
         {
-          highestCellDimension = cellDimension;
-          if (highestCellDimension == maxCellDimension)
+          int cellDimension = this->CellDimensions[cellsOnPoint[neighbor]];
+          if (cellDimension > highestCellDimension)
           {
-            break;
+            highestCellDimension = cellDimension;
+            if (highestCellDimension == this->MaxCellDimension)
+            {
+              break;
+            }
           }
         }
       }
-    }
-    vtkIdType numValidCellNeighbors = 0;
+      vtkIdType numValidCellNeighbors = 0;
 
-    // Iterate on all cells and find all points connected to current point
-    // by an edge.
-    for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
-    {
-      vtkCell* cell = structure->GetCell(cellsOnPoint->GetId(neighbor));
-      if (cell->GetCellDimension() >= highestCellDimension)
+      // Iterate on all cells and find all points connected to current point
+      // by an edge.
+      for (vtkIdType neighbor = 0; neighbor < numCellNeighbors; neighbor++)
       {
+        const vtkIdType cellId = cellsOnPoint[neighbor];
+        if (this->CellDimensions && this->CellDimensions[cellId] < highestCellDimension)
+        {
+          continue;
+        }
+        this->Structure->GetCell(cellId, cell);
+        const int numberOfCellPoints = cell->GetNumberOfPoints();
+        if (static_cast<size_t>(numberOfCellPoints) > values.size())
+        {
+          values.resize(numberOfCellPoints);
+          weights.resize(numberOfCellPoints);
+        }
+
         int subId;
         double parametricCoord[3];
-        if (GetCellParametricData(point, pointcoords, cell, subId, parametricCoord))
+        if (GetCellParametricData(
+              point, pointcoords, cell, subId, parametricCoord, weights.data()))
         {
           numValidCellNeighbors++;
           for (int inputComponent = 0; inputComponent < numberOfInputComponents; inputComponent++)
           {
-            int numberOfCellPoints = cell->GetNumberOfPoints();
-            std::vector<double> values(numberOfCellPoints);
             // Get values of Array at cell points.
             for (int i = 0; i < numberOfCellPoints; i++)
             {
-              values[i] = array->GetComponent(cell->GetPointId(i), inputComponent);
+              values[i] = this->Array->GetComponent(cell->GetPointId(i), inputComponent);
             }
 
             double derivative[3];
             // Get derivative of cell at point.
-            cell->Derivatives(subId, parametricCoord, &values[0], 1, derivative);
+            cell->Derivatives(subId, parametricCoord, values.data(), 1, derivative);
 
             g[inputComponent * 3] += static_cast<data_type>(derivative[0]);
             g[inputComponent * 3 + 1] += static_cast<data_type>(derivative[1]);
             g[inputComponent * 3 + 2] += static_cast<data_type>(derivative[2]);
           } // iterating over Components
         }   // if(GetCellParametricData())
-      }     // if(cell->GetCellDimension () >= highestCellDimension
-    }       // iterating over neighbors
+      }     // iterating over neighbors
 
-    if (numValidCellNeighbors > 0)
-    {
-      for (int i = 0; i < 3 * numberOfInputComponents; i++)
-      {
-        g[i] /= numValidCellNeighbors;
-      }
-
-      if (vorticity)
-      {
-        ComputeVorticityFromGradient(&g[0], vorticity + 3 * point);
-      }
-      if (qCriterion)
-      {
-        ComputeQCriterionFromGradient(&g[0], qCriterion + point);
-      }
-      if (divergence)
-      {
-        ComputeDivergenceFromGradient(&g[0], divergence + point);
-      }
-      if (gradients)
+      if (numValidCellNeighbors > 0)
       {
         for (int i = 0; i < numberOfOutputComponents; i++)
         {
-          gradients[point * numberOfOutputComponents + i] = g[i];
+          g[i] /= numValidCellNeighbors;
+        }
+
+        if (this->Vorticity)
+        {
+          ComputeVorticityFromGradient(g.data(), this->Vorticity + 3 * point);
+        }
+        if (this->QCriterion)
+        {
+          ComputeQCriterionFromGradient(g.data(), this->QCriterion + point);
+        }
+        if (this->Divergence)
+        {
+          ComputeDivergenceFromGradient(g.data(), this->Divergence + point);
+        }
+        if (this->Gradients)
+        {
+          std::copy(g.begin(), g.end(), this->Gradients + point * numberOfOutputComponents);
         }
       }
+    } // iterating over points in grid
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+template <class data_type>
+void ComputePointGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
+  int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence,
+  const unsigned char* cellDimensions, int highestCellDimension, int contributingCellOption)
+{
+  // The first call to GetCell() may build internal structures (e.g., the
+  // cells of a vtkPolyData) so it must be made before threading.
+  vtkNew<vtkGenericCell> cell;
+  structure->GetCell(0, cell);
+
+  // Build the point-to-cell links once. The cells using each point are sorted
+  // so that the gradient contributions are accumulated in the same order no
+  // matter how the links were built, keeping the results deterministic.
+  vtkNew<vtkStaticCellLinks> links;
+  links->BuildLinks(structure);
+  vtkIdType numpts = structure->GetNumberOfPoints();
+  vtkSMPTools::For(0, numpts, [&](vtkIdType ptId, vtkIdType endPtId) {
+    for (; ptId < endPtId; ++ptId)
+    {
+      vtkIdType* cells = links->GetCells(ptId);
+      std::sort(cells, cells + links->GetNcells(ptId));
     }
-  } // iterating over points in grid
+  });
+
+  PointGradientsUG<data_type> pointGradients(structure, array, links, cellDimensions, gradients,
+    vorticity, qCriterion, divergence, numberOfInputComponents, highestCellDimension,
+    contributingCellOption);
+  vtkSMPTools::For(0, numpts, pointGradients);
 }
 
 //------------------------------------------------------------------------------
-int GetCellParametricData(
-  vtkIdType pointId, double pointCoord[3], vtkCell* cell, int& subId, double parametricCoord[3])
+int GetCellParametricData(vtkIdType pointId, double pointCoord[3], vtkCell* cell, int& subId,
+  double parametricCoord[3], double* weights)
 {
   // Watch out for degenerate cells.  They make the derivative calculation
   // fail.
@@ -942,68 +1030,139 @@ int GetCellParametricData(
   }
 
   double dummy;
-  int numpoints = cell->GetNumberOfPoints();
-  std::vector<double> values(numpoints);
   // Get parametric position of point.
   cell->EvaluatePosition(
-    pointCoord, nullptr, subId, parametricCoord, dummy, &values[0] /*Really another dummy.*/);
+    pointCoord, nullptr, subId, parametricCoord, dummy, weights /*Really another dummy.*/);
 
   return 1;
 }
 
 //------------------------------------------------------------------------------
+// Threaded computation of cell gradients for unstructured grids and
+// polydata, evaluated at the parametric center of each cell.
 template <class data_type>
-void ComputeCellGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
-  int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence)
+struct CellGradientsUG
 {
-  vtkIdType numcells = structure->GetNumberOfCells();
-  std::vector<double> values(8);
-  std::vector<data_type> cellGradients(3 * numberOfInputComponents);
-  for (vtkIdType cellid = 0; cellid < numcells; cellid++)
+  vtkDataSet* Structure;
+  vtkDataArray* Array;
+  data_type* Gradients;
+  data_type* Vorticity;
+  data_type* QCriterion;
+  data_type* Divergence;
+  int NumberOfInputComponents;
+
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+  vtkSMPThreadLocal<std::vector<double>> Values;
+  vtkSMPThreadLocal<std::vector<data_type>> CellGradients;
+
+  CellGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
+    data_type* vorticity, data_type* qCriterion, data_type* divergence,
+    int numberOfInputComponents)
+    : Structure(structure)
+    , Array(array)
+    , Gradients(gradients)
+    , Vorticity(vorticity)
+    , QCriterion(qCriterion)
+    , Divergence(divergence)
+    , NumberOfInputComponents(numberOfInputComponents)
   {
-    vtkCell* cell = structure->GetCell(cellid);
-    int subId;
-    double cellCenter[3];
-    subId = cell->GetParametricCenter(cellCenter);
+  }
 
-    int numpoints = cell->GetNumberOfPoints();
-    if (static_cast<size_t>(numpoints) > values.size())
-    {
-      values.resize(numpoints);
-    }
-    double derivative[3];
-    for (int inputComponent = 0; inputComponent < numberOfInputComponents; inputComponent++)
+  void Initialize()
+  {
+    this->Values.Local().resize(VTK_CELL_SIZE);
+    this->CellGradients.Local().resize(3 * this->NumberOfInputComponents);
+  }
+
+  void operator()(vtkIdType cellid, vtkIdType endCellId)
+  {
+    vtkGenericCell* cell = this->Cell.Local();
+    std::vector<double>& values = this->Values.Local();
+    std::vector<data_type>& cellGradients = this->CellGradients.Local();
+    const int numberOfInputComponents = this->NumberOfInputComponents;
+
+    for (; cellid < endCellId; cellid++)
     {
-      for (int i = 0; i < numpoints; i++)
+      this->Structure->GetCell(cellid, cell);
+      int subId;
+      double cellCenter[3];
+      subId = cell->GetParametricCenter(cellCenter);
+
+      int numpoints = cell->GetNumberOfPoints();
+      if (static_cast<size_t>(numpoints) > values.size())
       {
-        values[i] = array->GetComponent(cell->GetPointId(i), inputComponent);
+        values.resize(numpoints);
       }
+      double derivative[3];
+      for (int inputComponent = 0; inputComponent < numberOfInputComponents; inputComponent++)
+      {
+        for (int i = 0; i < numpoints; i++)
+        {
+          values[i] = this->Array->GetComponent(cell->GetPointId(i), inputComponent);
+        }
 
-      cell->Derivatives(subId, cellCenter, &values[0], 1, derivative);
-      cellGradients[inputComponent * 3] = static_cast<data_type>(derivative[0]);
-      cellGradients[inputComponent * 3 + 1] = static_cast<data_type>(derivative[1]);
-      cellGradients[inputComponent * 3 + 2] = static_cast<data_type>(derivative[2]);
-    }
-    if (gradients)
-    {
-      for (int i = 0; i < 3 * numberOfInputComponents; i++)
+        cell->Derivatives(subId, cellCenter, values.data(), 1, derivative);
+        cellGradients[inputComponent * 3] = static_cast<data_type>(derivative[0]);
+        cellGradients[inputComponent * 3 + 1] = static_cast<data_type>(derivative[1]);
+        cellGradients[inputComponent * 3 + 2] = static_cast<data_type>(derivative[2]);
+      }
+      if (this->Gradients)
       {
-        gradients[cellid * 3 * numberOfInputComponents + i] = cellGradients[i];
+        std::copy(cellGradients.begin(), cellGradients.end(),
+          this->Gradients + cellid * 3 * numberOfInputComponents);
+      }
+      if (this->Vorticity)
+      {
+        ComputeVorticityFromGradient(cellGradients.data(), this->Vorticity + 3 * cellid);
+      }
+      if (this->QCriterion)
+      {
+        ComputeQCriterionFromGradient(cellGradients.data(), this->QCriterion + cellid);
+      }
+      if (this->Divergence)
+      {
+        ComputeDivergenceFromGradient(cellGradients.data(), this->Divergence + cellid);
       }
     }
-    if (vorticity)
-    {
-      ComputeVorticityFromGradient(&cellGradients[0], vorticity + 3 * cellid);
-    }
-    if (qCriterion)
-    {
-      ComputeQCriterionFromGradient(&cellGradients[0], qCriterion + cellid);
-    }
-    if (divergence)
+  }
+
+  void Reduce() {}
+};
+
+//------------------------------------------------------------------------------
+template <class data_type>
+void ComputeCellGradientsUG(vtkDataSet* structure, vtkDataArray* array, data_type* gradients,
+  int numberOfInputComponents, data_type* vorticity, data_type* qCriterion, data_type* divergence)
+{
+  // The first call to GetCell() may build internal structures so it must be
+  // made before threading.
+  vtkNew<vtkGenericCell> cell;
+  structure->GetCell(0, cell);
+
+  CellGradientsUG<data_type> cellGradients(
+    structure, array, gradients, vorticity, qCriterion, divergence, numberOfInputComponents);
+  vtkSMPTools::For(0, structure->GetNumberOfCells(), cellGradients);
+}
+
+//------------------------------------------------------------------------------
+// Determine the dimension of each cell. Only the cell type is needed, so the
+// cells are not fully instantiated.
+void ComputeCellDimensions(vtkDataSet* structure, unsigned char* cellDimensions)
+{
+  // The first call to GetCell() may build internal structures so it must be
+  // made before threading.
+  vtkNew<vtkGenericCell> cell;
+  structure->GetCell(0, cell);
+
+  vtkSMPThreadLocalObject<vtkGenericCell> tlCell;
+  vtkSMPTools::For(0, structure->GetNumberOfCells(), [&](vtkIdType cellId, vtkIdType endCellId) {
+    vtkGenericCell* genericCell = tlCell.Local();
+    for (; cellId < endCellId; ++cellId)
     {
-      ComputeDivergenceFromGradient(&cellGradients[0], divergence + cellid);
+      genericCell->SetCellType(structure->GetCellType(cellId));
+      cellDimensions[cellId] = static_cast<unsigned char>(genericCell->GetCellDimension());
     }
-  }
+  });
 }
 
 //------------------------------------------------------------------------------
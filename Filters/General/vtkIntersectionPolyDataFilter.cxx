@@ -32,6 +32,8 @@
 #include "vtkPoints.h"
 #include "vtkPolyDataNormals.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSortDataArray.h"
 #include "vtkTransform.h"
@@ -40,8 +42,12 @@
 #include "vtkTriangleFilter.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <list>
 #include <map>
+#include <set>
+#include <utility>
+#include <vector>
 
 //------------------------------------------------------------------------------
 // Helper typedefs and data structures.
@@ -75,6 +81,17 @@ typedef struct
 typedef std::multimap<vtkIdType, CellEdgeLineType> PointEdgeMapType;
 typedef PointEdgeMapType::iterator PointEdgeMapIteratorType;
 
+// A triangle-triangle intersection: the two cells and the end points of the
+// intersection line (and the surface each end point is on).
+typedef struct
+{
+  vtkIdType CellId0;
+  vtkIdType CellId1;
+  double Pt0[3];
+  double Pt1[3];
+  double SurfaceId[2];
+} TriangleIntersectionType;
+
 //------------------------------------------------------------------------------
 // Private implementation to hide STL.
 //------------------------------------------------------------------------------
@@ -84,14 +101,26 @@ public:
   Impl();
   virtual ~Impl();
 
-  // Finds all triangle triangle intersections between two input OOBTrees
+  // Collects the pairs of overlapping leaf nodes of the two input OBBTrees
   static int FindTriangleIntersections(
     vtkOBBNode* node0, vtkOBBNode* node1, vtkMatrix4x4* transform, void* arg);
 
+  // Finds all triangle triangle intersections between the collected node
+  // pairs (in parallel) and adds them to the intersection lines
+  void ComputeIntersections();
+
   // Runs the split mesh for the designated input surface
   int SplitMesh(int inputIndex, vtkPolyData* output, vtkPolyData* intersectionLines);
 
 protected:
+  // Intersects the triangles of two leaf nodes. ptIds is a list owned by
+  // the calling thread.
+  void IntersectNodes(vtkOBBNode* node0, vtkOBBNode* node1, vtkIdList* ptIds,
+    std::vector<TriangleIntersectionType>& intersections);
+
+  // Adds a triangle triangle intersection to the intersection lines
+  void AddIntersection(const TriangleIntersectionType& inter);
+
   // Split cells into polygons created by intersection lines
   vtkCellArray* SplitCell(vtkPolyData* input, vtkIdType cellId, const vtkIdType* cellPts,
     IntersectionMapType* map, vtkPolyData* interLines, int inputIndex, int numCurrCells);
@@ -137,6 +166,14 @@ public:
   vtkPolyData* Mesh[2];
   vtkOBBTree* OBBTree1;
 
+  // Pairs of overlapping leaf nodes, in traversal order, and the transform
+  // between the trees.
+  std::vector<std::pair<vtkOBBNode*, vtkOBBNode*>> NodePairs;
+  vtkMatrix4x4* Transform;
+
+  // The intersection lines added so far, as (smaller, larger) point ids.
+  std::set<std::pair<vtkIdType, vtkIdType>> LineSet;
+
   // Stores the intersection lines.
   vtkCellArray* IntersectionLines;
 
@@ -187,6 +224,7 @@ protected:
 //------------------------------------------------------------------------------
 vtkIntersectionPolyDataFilter::Impl::Impl()
   : OBBTree1(nullptr)
+  , Transform(nullptr)
   , IntersectionLines(nullptr)
   , SurfaceId(nullptr)
   , PointMerger(nullptr)
@@ -226,16 +264,20 @@ int vtkIntersectionPolyDataFilter::Impl ::FindTriangleIntersections(
   vtkIntersectionPolyDataFilter::Impl* info =
     reinterpret_cast<vtkIntersectionPolyDataFilter::Impl*>(arg);
 
-  // Set up local structures to hold Impl array information
-  vtkPolyData* mesh0 = info->Mesh[0];
-  vtkPolyData* mesh1 = info->Mesh[1];
-  vtkOBBTree* obbTree1 = info->OBBTree1;
-  vtkCellArray* intersectionLines = info->IntersectionLines;
-  vtkIdTypeArray* intersectionSurfaceId = info->SurfaceId;
-  vtkIdTypeArray* intersectionCellIds0 = info->CellIds[0];
-  vtkIdTypeArray* intersectionCellIds1 = info->CellIds[1];
-  vtkPointLocator* pointMerger = info->PointMerger;
-  double tolerance = info->Tolerance;
+  // Only record the pair of leaf nodes; the triangles are intersected later,
+  // in parallel, by ComputeIntersections().
+  info->NodePairs.push_back(std::make_pair(node0, node1));
+  info->Transform = transform;
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl::IntersectNodes(vtkOBBNode* node0, vtkOBBNode* node1,
+  vtkIdList* ptIds, std::vector<TriangleIntersectionType>& intersections)
+{
+  vtkPolyData* mesh0 = this->Mesh[0];
+  vtkPolyData* mesh1 = this->Mesh[1];
 
   // The number of cells in OBBTree
   int numCells0 = node0->Cells->GetNumberOfIds();
@@ -248,16 +290,16 @@ int vtkIntersectionPolyDataFilter::Impl ::FindTriangleIntersections(
     // Make sure the cell is a triangle
     if (type0 == VTK_TRIANGLE)
     {
-      vtkIdType npts0;
-      const vtkIdType* triPtIds0;
-      mesh0->GetCellPoints(cellId0, npts0, triPtIds0);
+      // the vtkIdList variant of GetCellPoints() is thread safe
+      mesh0->GetCellPoints(cellId0, ptIds);
       double triPts0[3][3];
-      for (vtkIdType id = 0; id < npts0; id++)
+      for (vtkIdType id = 0; id < 3; id++)
       {
-        mesh0->GetPoint(triPtIds0[id], triPts0[id]);
+        mesh0->GetPoint(ptIds->GetId(id), triPts0[id]);
       }
 
-      if (obbTree1->TriangleIntersectsNode(node1, triPts0[0], triPts0[1], triPts0[2], transform))
+      if (this->OBBTree1->TriangleIntersectsNode(
+            node1, triPts0[0], triPts0[1], triPts0[2], this->Transform))
       {
         int numCells1 = node1->Cells->GetNumberOfIds();
         for (vtkIdType id1 = 0; id1 < numCells1; id1++)
@@ -267,199 +309,243 @@ int vtkIntersectionPolyDataFilter::Impl ::FindTriangleIntersections(
           if (type1 == VTK_TRIANGLE)
           {
             // See if the two cells actually intersect. If they do,
-            // add an entry into the intersection maps and add an
-            // intersection line.
-            vtkIdType npts1;
-            const vtkIdType* triPtIds1;
-            mesh1->GetCellPoints(cellId1, npts1, triPtIds1);
+            // record the intersection line.
+            mesh1->GetCellPoints(cellId1, ptIds);
 
             double triPts1[3][3];
-            for (vtkIdType id = 0; id < npts1; id++)
+            for (vtkIdType id = 0; id < 3; id++)
             {
-              mesh1->GetPoint(triPtIds1[id], triPts1[id]);
+              mesh1->GetPoint(ptIds->GetId(id), triPts1[id]);
             }
 
             int coplanar = 0;
-            double outpt0[3], outpt1[3];
-            double surfaceid[2];
+            TriangleIntersectionType inter;
             int intersects = vtkIntersectionPolyDataFilter::TriangleTriangleIntersection(triPts0[0],
-              triPts0[1], triPts0[2], triPts1[0], triPts1[1], triPts1[2], coplanar, outpt0, outpt1,
-              surfaceid, tolerance);
+              triPts0[1], triPts0[2], triPts1[0], triPts1[1], triPts1[2], coplanar, inter.Pt0,
+              inter.Pt1, inter.SurfaceId, this->Tolerance);
 
-            if (coplanar)
+            // Coplanar triangle intersection is not handled.
+            // This intersection will not be included in the output. TODO
+            if (intersects && !coplanar)
             {
-              // Coplanar triangle intersection is not handled.
-              // This intersection will not be included in the output. TODO
-              // vtkDebugMacro(<<"Coplanar");
-              intersects = 0;
-              continue;
+              inter.CellId0 = cellId0;
+              inter.CellId1 = cellId1;
+              intersections.push_back(inter);
             }
+          }
+        }
+      }
+    }
+  }
+}
 
-            // If actual intersection, add point and cell to edge, line,
-            // and surface maps!
-            if (intersects)
-            {
-              vtkIdType lineId = intersectionLines->GetNumberOfCells();
+//------------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl::ComputeIntersections()
+{
+  // dummy calls required before multithreaded calls
+  static_cast<void>(this->Mesh[0]->GetCellType(0));
+  static_cast<void>(this->Mesh[1]->GetCellType(0));
+
+  // Intersect the triangles of each pair of leaf nodes in parallel, then add
+  // the intersections in the order of the tree traversal. This way the
+  // output (which depends on the order of point merging) is the same as if
+  // the triangles were intersected during the traversal.
+  const vtkIdType numPairs = static_cast<vtkIdType>(this->NodePairs.size());
+  std::vector<std::vector<TriangleIntersectionType>> intersections(numPairs);
+  vtkSMPThreadLocalObject<vtkIdList> ptIds;
+  vtkSMPTools::For(0, numPairs, [&](vtkIdType pairId, vtkIdType endPairId) {
+    vtkIdList* threadPtIds = ptIds.Local();
+    for (; pairId < endPairId; ++pairId)
+    {
+      this->IntersectNodes(this->NodePairs[pairId].first, this->NodePairs[pairId].second,
+        threadPtIds, intersections[pairId]);
+    }
+  });
 
-              vtkIdType ptId0, ptId1;
-              int unique[2];
-              unique[0] = pointMerger->InsertUniquePoint(outpt0, ptId0);
-              unique[1] = pointMerger->InsertUniquePoint(outpt1, ptId1);
+  for (const auto& nodeIntersections : intersections)
+  {
+    for (const auto& inter : nodeIntersections)
+    {
+      this->AddIntersection(inter);
+    }
+  }
+  this->NodePairs.clear();
+}
 
-              int addline = 1;
-              if (ptId0 == ptId1)
-              {
-                addline = 0;
-              }
+//------------------------------------------------------------------------------
+void vtkIntersectionPolyDataFilter::Impl::AddIntersection(const TriangleIntersectionType& inter)
+{
+  // Set up local structures to hold Impl array information
+  vtkPolyData* mesh0 = this->Mesh[0];
+  vtkPolyData* mesh1 = this->Mesh[1];
+  vtkCellArray* intersectionLines = this->IntersectionLines;
+  vtkIdTypeArray* intersectionSurfaceId = this->SurfaceId;
+  vtkIdTypeArray* intersectionCellIds0 = this->CellIds[0];
+  vtkIdTypeArray* intersectionCellIds1 = this->CellIds[1];
+  vtkPointLocator* pointMerger = this->PointMerger;
+
+  vtkIdType cellId0 = inter.CellId0;
+  vtkIdType cellId1 = inter.CellId1;
+  vtkIdType npts;
+  const vtkIdType* triPtIds0;
+  const vtkIdType* triPtIds1;
+  mesh0->GetCellPoints(cellId0, npts, triPtIds0);
+  mesh1->GetCellPoints(cellId1, npts, triPtIds1);
+  double outpt0[3] = { inter.Pt0[0], inter.Pt0[1], inter.Pt0[2] };
+  double outpt1[3] = { inter.Pt1[0], inter.Pt1[1], inter.Pt1[2] };
+  const double* surfaceid = inter.SurfaceId;
 
-              if (ptId0 == ptId1 && surfaceid[0] != surfaceid[1])
-              {
-                intersectionSurfaceId->InsertValue(ptId0, 3);
-              }
-              else
-              {
-                if (unique[0])
-                {
-                  intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
-                }
-                else
-                {
-                  if (intersectionSurfaceId->GetValue(ptId0) != 3)
-                  {
-                    intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
-                  }
-                }
-                if (unique[1])
-                {
-                  intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
-                }
-                else
-                {
-                  if (intersectionSurfaceId->GetValue(ptId1) != 3)
-                  {
-                    intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
-                  }
-                }
-              }
+  // Add point and cell to edge, line, and surface maps!
+  vtkIdType lineId = intersectionLines->GetNumberOfCells();
 
-              info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-              info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-              info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  vtkIdType ptId0, ptId1;
+  int unique[2];
+  unique[0] = pointMerger->InsertUniquePoint(outpt0, ptId0);
+  unique[1] = pointMerger->InsertUniquePoint(outpt1, ptId1);
 
-              // Check to see if duplicate line. Line can only be a duplicate
-              // line if both points are not unique and they don't
-              // equal each other
-              if (!unique[0] && !unique[1] && ptId0 != ptId1)
-              {
-                vtkSmartPointer<vtkPolyData> lineTest = vtkSmartPointer<vtkPolyData>::New();
-                lineTest->SetPoints(pointMerger->GetPoints());
-                lineTest->SetLines(intersectionLines);
-                lineTest->BuildLinks();
-                int newLine = info->CheckLine(lineTest, ptId0, ptId1);
-                if (newLine == 0)
-                {
-                  addline = 0;
-                }
-              }
-              if (addline)
-              {
-                // If the line is new and does not consist of two identical
-                // points, add the line to the intersection and update
-                // mapping information
-                intersectionLines->InsertNextCell(2);
-                intersectionLines->InsertCellPoint(ptId0);
-                intersectionLines->InsertCellPoint(ptId1);
-
-                intersectionCellIds0->InsertNextValue(cellId0);
-                intersectionCellIds1->InsertNextValue(cellId1);
-
-                info->PointCellIds[0]->InsertValue(ptId0, cellId0);
-                info->PointCellIds[0]->InsertValue(ptId1, cellId0);
-                info->PointCellIds[1]->InsertValue(ptId0, cellId1);
-                info->PointCellIds[1]->InsertValue(ptId1, cellId1);
-
-                info->IntersectionMap[0]->insert(std::make_pair(cellId0, lineId));
-                info->IntersectionMap[1]->insert(std::make_pair(cellId1, lineId));
-
-                // Check which edges of cellId0 and cellId1 outpt0 and
-                // outpt1 are on, if any.
-                int isOnEdge = 0;
-                int m0p0 = 0, m0p1 = 0, m1p0 = 0, m1p1 = 0;
-                for (vtkIdType edgeId = 0; edgeId < 3; edgeId++)
-                {
-                  isOnEdge = info->AddToPointEdgeMap(
-                    0, ptId0, outpt0, mesh0, cellId0, edgeId, lineId, triPtIds0);
-                  if (isOnEdge != -1)
-                  {
-                    m0p0++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    0, ptId1, outpt1, mesh0, cellId0, edgeId, lineId, triPtIds0);
-                  if (isOnEdge != -1)
-                  {
-                    m0p1++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    1, ptId0, outpt0, mesh1, cellId1, edgeId, lineId, triPtIds1);
-                  if (isOnEdge != -1)
-                  {
-                    m1p0++;
-                  }
-                  isOnEdge = info->AddToPointEdgeMap(
-                    1, ptId1, outpt1, mesh1, cellId1, edgeId, lineId, triPtIds1);
-                  if (isOnEdge != -1)
-                  {
-                    m1p1++;
-                  }
-                }
-                // Special cases caught by tolerance and not from the Point
-                // Merger
-                if (m0p0 > 0 && m1p0 > 0)
-                {
-                  intersectionSurfaceId->InsertValue(ptId0, 3);
-                }
-                if (m0p1 > 0 && m1p1 > 0)
-                {
-                  intersectionSurfaceId->InsertValue(ptId1, 3);
-                }
-              }
-              // Add information about origin surface to std::maps for
-              // checks later
-              if (intersectionSurfaceId->GetValue(ptId0) == 1)
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-              }
-              else if (intersectionSurfaceId->GetValue(ptId0) == 2)
-              {
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              }
-              else
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
-              }
-              if (intersectionSurfaceId->GetValue(ptId1) == 1)
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-              }
-              else if (intersectionSurfaceId->GetValue(ptId1) == 2)
-              {
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
-              }
-              else
-              {
-                info->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
-                info->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
-              }
-            }
-          }
-        }
+  int addline = 1;
+  if (ptId0 == ptId1)
+  {
+    addline = 0;
+  }
+
+  if (ptId0 == ptId1 && surfaceid[0] != surfaceid[1])
+  {
+    intersectionSurfaceId->InsertValue(ptId0, 3);
+  }
+  else
+  {
+    if (unique[0])
+    {
+      intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
+    }
+    else
+    {
+      if (intersectionSurfaceId->GetValue(ptId0) != 3)
+      {
+        intersectionSurfaceId->InsertValue(ptId0, surfaceid[0]);
+      }
+    }
+    if (unique[1])
+    {
+      intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
+    }
+    else
+    {
+      if (intersectionSurfaceId->GetValue(ptId1) != 3)
+      {
+        intersectionSurfaceId->InsertValue(ptId1, surfaceid[1]);
       }
     }
   }
 
-  return 1;
+  this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+  this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+  this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+
+  // Check to see if duplicate line. Line can only be a duplicate
+  // line if both points are not unique and they don't
+  // equal each other
+  if (!unique[0] && !unique[1] && ptId0 != ptId1)
+  {
+    if (this->LineSet.find(std::make_pair(std::min(ptId0, ptId1), std::max(ptId0, ptId1))) !=
+      this->LineSet.end())
+    {
+      addline = 0;
+    }
+  }
+  if (addline)
+  {
+    // If the line is new and does not consist of two identical
+    // points, add the line to the intersection and update
+    // mapping information
+    intersectionLines->InsertNextCell(2);
+    intersectionLines->InsertCellPoint(ptId0);
+    intersectionLines->InsertCellPoint(ptId1);
+    this->LineSet.insert(std::make_pair(std::min(ptId0, ptId1), std::max(ptId0, ptId1)));
+
+    intersectionCellIds0->InsertNextValue(cellId0);
+    intersectionCellIds1->InsertNextValue(cellId1);
+
+    this->PointCellIds[0]->InsertValue(ptId0, cellId0);
+    this->PointCellIds[0]->InsertValue(ptId1, cellId0);
+    this->PointCellIds[1]->InsertValue(ptId0, cellId1);
+    this->PointCellIds[1]->InsertValue(ptId1, cellId1);
+
+    this->IntersectionMap[0]->insert(std::make_pair(cellId0, lineId));
+    this->IntersectionMap[1]->insert(std::make_pair(cellId1, lineId));
+
+    // Check which edges of cellId0 and cellId1 outpt0 and
+    // outpt1 are on, if any.
+    int isOnEdge = 0;
+    int m0p0 = 0, m0p1 = 0, m1p0 = 0, m1p1 = 0;
+    for (vtkIdType edgeId = 0; edgeId < 3; edgeId++)
+    {
+      isOnEdge = this->AddToPointEdgeMap(
+        0, ptId0, outpt0, mesh0, cellId0, edgeId, lineId, triPtIds0);
+      if (isOnEdge != -1)
+      {
+        m0p0++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        0, ptId1, outpt1, mesh0, cellId0, edgeId, lineId, triPtIds0);
+      if (isOnEdge != -1)
+      {
+        m0p1++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        1, ptId0, outpt0, mesh1, cellId1, edgeId, lineId, triPtIds1);
+      if (isOnEdge != -1)
+      {
+        m1p0++;
+      }
+      isOnEdge = this->AddToPointEdgeMap(
+        1, ptId1, outpt1, mesh1, cellId1, edgeId, lineId, triPtIds1);
+      if (isOnEdge != -1)
+      {
+        m1p1++;
+      }
+    }
+    // Special cases caught by tolerance and not from the Point
+    // Merger
+    if (m0p0 > 0 && m1p0 > 0)
+    {
+      intersectionSurfaceId->InsertValue(ptId0, 3);
+    }
+    if (m0p1 > 0 && m1p1 > 0)
+    {
+      intersectionSurfaceId->InsertValue(ptId1, 3);
+    }
+  }
+  // Add information about origin surface to std::maps for
+  // checks later
+  if (intersectionSurfaceId->GetValue(ptId0) == 1)
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+  }
+  else if (intersectionSurfaceId->GetValue(ptId0) == 2)
+  {
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  }
+  else
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId0, cellId0));
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId0, cellId1));
+  }
+  if (intersectionSurfaceId->GetValue(ptId1) == 1)
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+  }
+  else if (intersectionSurfaceId->GetValue(ptId1) == 2)
+  {
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  }
+  else
+  {
+    this->IntersectionPtsMap[0]->insert(std::make_pair(ptId1, cellId0));
+    this->IntersectionPtsMap[1]->insert(std::make_pair(ptId1, cellId1));
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -538,10 +624,47 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
     newPolys->AllocateEstimate(cells->GetNumberOfCells(), 3);
     output->SetPolys(newPolys);
 
-    vtkSmartPointer<vtkIdList> edgeNeighbors = vtkSmartPointer<vtkIdList>::New();
+    // Collect the cells relevant for splitting. If a cell is in the
+    // intersection map, split. If not, one of its edges may be split by an
+    // intersection line that splits a neighbor cell. Mark the cell as needing
+    // a split if this is the case. The links are built and the intersection
+    // map is complete, so this is done in parallel.
+    std::vector<char> needsSplitCell(cells->GetNumberOfCells(), 0);
+    vtkSMPThreadLocalObject<vtkIdList> tlCellPts;
+    vtkSMPThreadLocalObject<vtkIdList> tlEdgeNeighbors;
+    vtkSMPTools::For(0, cells->GetNumberOfCells(), [&](vtkIdType cellId, vtkIdType endCellId) {
+      vtkIdList* cellPts = tlCellPts.Local();
+      vtkIdList* edgeNeighbors = tlEdgeNeighbors.Local();
+      for (; cellId < endCellId; ++cellId)
+      {
+        cells->GetCellAtId(cellId, cellPts);
+        const vtkIdType npts = cellPts->GetNumberOfIds();
+        if (npts != 3)
+        {
+          continue;
+        }
+        bool needsSplit = intersectionMap->find(cellId) != intersectionMap->end();
+        for (vtkIdType ptId = 0; ptId < npts && !needsSplit; ptId++)
+        {
+          vtkIdType pt0Id = cellPts->GetId(ptId);
+          vtkIdType pt1Id = cellPts->GetId((ptId + 1) % npts);
+          edgeNeighbors->Reset();
+          input->GetCellEdgeNeighbors(cellId, pt0Id, pt1Id, edgeNeighbors);
+          for (vtkIdType nbr = 0; nbr < edgeNeighbors->GetNumberOfIds(); nbr++)
+          {
+            if (intersectionMap->find(edgeNeighbors->GetId(nbr)) != intersectionMap->end())
+            {
+              needsSplit = true;
+              break;
+            }
+          } // for (vtkIdType nbr = 0; ...
+        }   // for (vtkIdType pt = 0; ...
+        needsSplitCell[cellId] = needsSplit;
+      }
+    });
+
     vtkIdType nptsX = 0;
     const vtkIdType* pts = nullptr;
-    vtkSmartPointer<vtkIdList> cellsToCheck = vtkSmartPointer<vtkIdList>::New();
     for (cells->InitTraversal(); cells->GetNextCell(nptsX, pts); cellIdX++)
     {
       if (nptsX != 3)
@@ -551,33 +674,7 @@ int vtkIntersectionPolyDataFilter::Impl ::SplitMesh(
         continue;
       }
 
-      cellsToCheck->Reset();
-      cellsToCheck->Allocate(nptsX + 1);
-      cellsToCheck->InsertNextId(cellIdX);
-
-      // Collect the cells relevant for splitting this cell.  If the
-      // cell is in the intersection map, split. If not, one of its
-      // edges may be split by an intersection line that splits a
-      // neighbor cell. Mark the cell as needing a split if this is
-      // the case.
-      bool needsSplit = intersectionMap->find(cellIdX) != intersectionMap->end();
-      for (vtkIdType ptId = 0; ptId < nptsX; ptId++)
-      {
-        vtkIdType pt0Id = pts[ptId];
-        vtkIdType pt1Id = pts[(ptId + 1) % nptsX];
-        edgeNeighbors->Reset();
-        input->GetCellEdgeNeighbors(cellIdX, pt0Id, pt1Id, edgeNeighbors);
-        for (vtkIdType nbr = 0; nbr < edgeNeighbors->GetNumberOfIds(); nbr++)
-        {
-          vtkIdType nbrId = edgeNeighbors->GetId(nbr);
-          cellsToCheck->InsertNextId(nbrId);
-
-          if (intersectionMap->find(nbrId) != intersectionMap->end())
-          {
-            needsSplit = true;
-          }
-        } // for (vtkIdType nbr = 0; ...
-      }   // for (vtkIdType pt = 0; ...
+      bool needsSplit = needsSplitCell[cellIdX] != 0;
 
       // Splitting occurs here
       if (!needsSplit)
@@ -2366,6 +2463,7 @@ int vtkIntersectionPolyDataFilter::RequestData(vtkInformation* vtkNotUsed(reques
   // This performs the triangle intersection search
   obbTree0->IntersectWithOBBTree(
     obbTree1, nullptr, vtkIntersectionPolyDataFilter::Impl::FindTriangleIntersections, impl);
+  impl->ComputeIntersections();
 
   int rawLines = outputIntersection->GetNumberOfLines();
 
@@ -726,15 +726,7 @@ vtkIdType* vtkMergeCells::MapPointsToIdsUsingLocator(vtkDataSet* set)
     this->Locator->InitPointInsertion(ptarray, bounds);
   }
 
-  vtkIdType newId;
-  double x[3];
-
-  for (vtkIdType ptId = 0; ptId < npoints1; ptId++)
-  {
-    points1->GetPoint(ptId, x);
-    this->Locator->InsertUniquePoint(x, newId);
-    idMap[ptId] = newId;
-  }
+  this->Locator->InsertUniquePoints(points1, idMap);
   return idMap;
 }
 
@@ -16,16 +16,23 @@
 
 #include "vtkCellArray.h"
 #include "vtkGenericCell.h"
+#include "vtkIdList.h"
 #include "vtkLine.h"
 #include "vtkMath.h"
 #include "vtkMatrix4x4.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPlane.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkTriangle.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <algorithm>
 #include <vector>
 
 vtkStandardNewMacro(vtkOBBTree);
@@ -51,6 +58,32 @@ vtkStandardNewMacro(vtkOBBTree);
     }                                                                                              \
   }
 
+// Nodes with fewer cells than this have their subtrees built concurrently,
+// and nodes with more cells than this have their cells classified in parallel.
+#define VTK_OBB_SUBTREE_SIZE 4096
+
+// The marks and the list used by ComputeOBB() to gather the points of the
+// cells, the number of OBBs computed and the deepest level reached by a
+// build, the nodes whose subtrees are deferred to be built concurrently
+// (each one owns its cell list), and the list ComputeOBB() gets the points
+// of a cell into.
+struct vtkOBBBuildState
+{
+  struct Task
+  {
+    vtkIdList* Cells;
+    vtkOBBNode* Node;
+    int Level;
+  };
+
+  int* InsertedPoints;
+  vtkPoints* PointsList;
+  int OBBCount;
+  int Level;
+  std::vector<Task>* Tasks;
+  vtkIdList* CellPoints;
+};
+
 vtkOBBNode::vtkOBBNode()
 {
   this->Cells = nullptr;
@@ -281,6 +314,16 @@ void vtkOBBTree::ComputeOBB(
 // a sorted list of relative "sizes" of axes for comparison purposes.
 void vtkOBBTree::ComputeOBB(
   vtkIdList* cells, double corner[3], double max[3], double mid[3], double min[3], double size[3])
+{
+  vtkNew<vtkIdList> cellPoints;
+  vtkOBBBuildState state = { this->InsertedPoints, this->PointsList, this->OBBCount, this->Level,
+    nullptr, cellPoints };
+  this->ComputeOBB(cells, corner, max, mid, min, size, state);
+  this->OBBCount = state.OBBCount;
+}
+
+void vtkOBBTree::ComputeOBB(vtkIdList* cells, double corner[3], double max[3], double mid[3],
+  double min[3], double size[3], vtkOBBBuildState& state)
 {
   vtkIdType numCells, i, j, cellId, ptId, pId, qId, rId;
   int k, type;
@@ -291,8 +334,8 @@ void vtkOBBTree::ComputeOBB(
   double tMin[3], tMax[3], closest[3], t;
   double dp0[3], dp1[3], tri_mass, tot_mass, c[3];
 
-  this->OBBCount++;
-  this->PointsList->Reset();
+  state.OBBCount++;
+  state.PointsList->Reset();
   //
   // Compute mean & moments
   //
@@ -312,13 +355,18 @@ void vtkOBBTree::ComputeOBB(
   {
     cellId = cells->GetId(i);
     type = this->DataSet->GetCellType(cellId);
+    // the vtkIdList variants of GetCellPoints() are thread safe
     switch (this->DataSet->GetDataObjectType())
     {
       case VTK_POLY_DATA:
-        ((vtkPolyData*)this->DataSet)->GetCellPoints(cellId, numPts, ptIds);
+        ((vtkPolyData*)this->DataSet)->GetCellPoints(cellId, state.CellPoints);
+        numPts = state.CellPoints->GetNumberOfIds();
+        ptIds = state.CellPoints->GetPointer(0);
         break;
       case VTK_UNSTRUCTURED_GRID:
-        ((vtkUnstructuredGrid*)this->DataSet)->GetCellPoints(cellId, numPts, ptIds);
+        ((vtkUnstructuredGrid*)this->DataSet)->GetCellPoints(cellId, state.CellPoints);
+        numPts = state.CellPoints->GetNumberOfIds();
+        ptIds = state.CellPoints->GetPointer(0);
         break;
       default:
         vtkErrorMacro(<< "DataSet " << this->DataSet->GetClassName() << " not supported.");
@@ -368,10 +416,11 @@ void vtkOBBTree::ComputeOBB(
     //
     for (j = 0; j < numPts; j++)
     {
-      if (this->InsertedPoints[ptIds[j]] != this->OBBCount)
+      if (state.InsertedPoints[ptIds[j]] != state.OBBCount)
       {
-        this->InsertedPoints[ptIds[j]] = this->OBBCount;
-        this->PointsList->InsertNextPoint(this->DataSet->GetPoint(ptIds[j]));
+        state.InsertedPoints[ptIds[j]] = state.OBBCount;
+        this->DataSet->GetPoint(ptIds[j], p);
+        state.PointsList->InsertNextPoint(p);
       }
     } // for all points of this cell
   }   // end foreach cell
@@ -426,10 +475,10 @@ void vtkOBBTree::ComputeOBB(
   tMin[0] = tMin[1] = tMin[2] = VTK_DOUBLE_MAX;
   tMax[0] = tMax[1] = tMax[2] = -VTK_DOUBLE_MAX;
 
-  numPts = this->PointsList->GetNumberOfPoints();
+  numPts = state.PointsList->GetNumberOfPoints();
   for (ptId = 0; ptId < numPts; ptId++)
   {
-    this->PointsList->GetPoint(ptId, p);
+    state.PointsList->GetPoint(ptId, p);
     for (i = 0; i < 3; i++)
     {
       vtkLine::DistanceToLine(p, mean, a[i], t, closest);
@@ -1090,7 +1139,49 @@ void vtkOBBTree::BuildLocator()
   }
   this->Tree = new vtkOBBNode;
   this->Level = 0;
-  this->BuildTree(cellList, this->Tree, 0);
+
+  // The nodes near the root are built first, then the subtrees below them
+  // are built concurrently, each thread with its own point marks and list.
+  // The OBB and the split of a node only depend on its own cells, so the
+  // tree is the same as the one of a serial build.
+  std::vector<vtkOBBBuildState::Task> tasks;
+  vtkNew<vtkIdList> cellPoints;
+  vtkOBBBuildState state = { this->InsertedPoints, this->PointsList, 0, 0, &tasks, cellPoints };
+  this->BuildTree(cellList, this->Tree, 0, state);
+
+  struct LocalState
+  {
+    std::vector<int> InsertedPoints;
+    vtkSmartPointer<vtkPoints> PointsList;
+    vtkSmartPointer<vtkIdList> CellPoints;
+    vtkOBBBuildState State;
+  };
+  vtkSMPThreadLocal<LocalState> localStates;
+  vtkSMPTools::For(0, static_cast<vtkIdType>(tasks.size()),
+    [this, numPts, &tasks, &localStates](vtkIdType taskId, vtkIdType endTaskId) {
+      LocalState& local = localStates.Local();
+      if (!local.PointsList)
+      {
+        local.InsertedPoints.assign(numPts, 0);
+        local.PointsList = vtkSmartPointer<vtkPoints>::New();
+        local.PointsList->Allocate(numPts);
+        local.CellPoints = vtkSmartPointer<vtkIdList>::New();
+        local.State = { local.InsertedPoints.data(), local.PointsList, 0, 0, nullptr,
+          local.CellPoints };
+      }
+      for (; taskId < endTaskId; ++taskId)
+      {
+        const vtkOBBBuildState::Task& task = tasks[taskId];
+        this->BuildTree(task.Cells, task.Node, task.Level, local.State);
+      }
+    });
+  for (auto iter = localStates.begin(); iter != localStates.end(); ++iter)
+  {
+    state.OBBCount += iter->State.OBBCount;
+    state.Level = std::max(state.Level, iter->State.Level);
+  }
+  this->OBBCount = state.OBBCount;
+  this->Level = state.Level;
 
   vtkDebugMacro(<< "# Cells: " << numCells << ", Deepest tree level: " << this->Level
                 << ", Created: " << this->OBBCount << " OBB nodes");
@@ -1117,20 +1208,28 @@ void vtkOBBTree::BuildLocator()
 // frees its first argument
 void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
 {
-  vtkIdType i, j, numCells = cells->GetNumberOfIds();
-  vtkIdType cellId;
-  vtkIdType ptId;
-  vtkIdList* cellPts = vtkIdList::New();
+  vtkNew<vtkIdList> cellPoints;
+  vtkOBBBuildState state = { this->InsertedPoints, this->PointsList, this->OBBCount, this->Level,
+    nullptr, cellPoints };
+  this->BuildTree(cells, OBBptr, level, state);
+  this->OBBCount = state.OBBCount;
+  this->Level = state.Level;
+}
+
+void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level, vtkOBBBuildState& state)
+{
+  vtkIdType i, numCells = cells->GetNumberOfIds();
   double size[3];
 
-  if (level > this->Level)
+  if (level > state.Level)
   {
-    this->Level = level;
+    state.Level = level;
   }
   //
   // Now compute the OBB
   //
-  this->ComputeOBB(cells, OBBptr->Corner, OBBptr->Axes[0], OBBptr->Axes[1], OBBptr->Axes[2], size);
+  this->ComputeOBB(
+    cells, OBBptr->Corner, OBBptr->Axes[0], OBBptr->Axes[1], OBBptr->Axes[2], size, state);
 
   //
   // Check whether to continue recursing; if so, create two children and
@@ -1142,10 +1241,12 @@ void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
     LHlist->Allocate(cells->GetNumberOfIds() / 2);
     vtkIdList* RHlist = vtkIdList::New();
     RHlist->Allocate(cells->GetNumberOfIds() / 2);
-    double n[3], p[3], c[3], x[3], val, ratio, bestRatio;
-    int negative, positive, splitAcceptable, splitPlane;
-    int foundBestSplit, bestPlane = 0, numPts;
+    double n[3], p[3], ratio, bestRatio;
+    int splitAcceptable, splitPlane;
+    int foundBestSplit, bestPlane = 0;
     int numInLHnode, numInRHnode;
+    std::vector<char> isLeft(numCells);
+    vtkSMPThreadLocalObject<vtkIdList> cellPts;
 
     // loop over three split planes to find acceptable one
     for (i = 0; i < 3; i++) // compute split point
@@ -1165,55 +1266,65 @@ void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
       }
       vtkMath::Normalize(n);
 
-      // traverse cells, assigning to appropriate child list as necessary
-      for (i = 0; i < numCells; i++)
-      {
-        cellId = cells->GetId(i);
-        this->DataSet->GetCellPoints(cellId, cellPts);
-        c[0] = c[1] = c[2] = 0.0;
-        numPts = cellPts->GetNumberOfIds();
-        for (negative = positive = j = 0; j < numPts; j++)
+      // traverse cells, assigning to appropriate child list as necessary.
+      // The cells of large nodes are classified in parallel.
+      auto classify = [this, cells, &n, &p, &isLeft, &cellPts](vtkIdType cellIdx, vtkIdType end) {
+        vtkIdList* ptIds = cellPts.Local();
+        double c[3], x[3], val;
+        for (; cellIdx < end; cellIdx++)
         {
-          ptId = cellPts->GetId(j);
-          this->DataSet->GetPoint(ptId, x);
-          val = n[0] * (x[0] - p[0]) + n[1] * (x[1] - p[1]) + n[2] * (x[2] - p[2]);
-          c[0] += x[0];
-          c[1] += x[1];
-          c[2] += x[2];
-          if (val < 0.0)
+          this->DataSet->GetCellPoints(cells->GetId(cellIdx), ptIds);
+          c[0] = c[1] = c[2] = 0.0;
+          vtkIdType j, numPts = ptIds->GetNumberOfIds();
+          int negative, positive;
+          for (negative = positive = j = 0; j < numPts; j++)
           {
-            negative = 1;
-          }
-          else
-          {
-            positive = 1;
+            this->DataSet->GetPoint(ptIds->GetId(j), x);
+            val = n[0] * (x[0] - p[0]) + n[1] * (x[1] - p[1]) + n[2] * (x[2] - p[2]);
+            c[0] += x[0];
+            c[1] += x[1];
+            c[2] += x[2];
+            if (val < 0.0)
+            {
+              negative = 1;
+            }
+            else
+            {
+              positive = 1;
+            }
           }
-        }
 
-        if (negative && positive)
-        { // Use centroid to decide straddle cases
-          c[0] /= numPts;
-          c[1] /= numPts;
-          c[2] /= numPts;
-          if (n[0] * (c[0] - p[0]) + n[1] * (c[1] - p[1]) + n[2] * (c[2] - p[2]) < 0.0)
-          {
-            LHlist->InsertNextId(cellId);
+          if (negative && positive)
+          { // Use centroid to decide straddle cases
+            c[0] /= numPts;
+            c[1] /= numPts;
+            c[2] /= numPts;
+            isLeft[cellIdx] =
+              (n[0] * (c[0] - p[0]) + n[1] * (c[1] - p[1]) + n[2] * (c[2] - p[2]) < 0.0);
           }
           else
           {
-            RHlist->InsertNextId(cellId);
+            isLeft[cellIdx] = negative;
           }
         }
+      };
+      if (numCells > VTK_OBB_SUBTREE_SIZE)
+      {
+        vtkSMPTools::For(0, numCells, classify);
+      }
+      else
+      {
+        classify(0, numCells);
+      }
+      for (i = 0; i < numCells; i++)
+      {
+        if (isLeft[i])
+        {
+          LHlist->InsertNextId(cells->GetId(i));
+        }
         else
         {
-          if (negative)
-          {
-            LHlist->InsertNextId(cellId);
-          }
-          else
-          {
-            RHlist->InsertNextId(cellId);
-          }
+          RHlist->InsertNextId(cells->GetId(i));
         }
       } // for all cells
 
@@ -1257,8 +1368,22 @@ void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
 
       cells->Delete();
       cells = nullptr; // don't need to keep anymore
-      this->BuildTree(LHlist, LHnode, level + 1);
-      this->BuildTree(RHlist, RHnode, level + 1);
+      if (state.Tasks && LHlist->GetNumberOfIds() <= VTK_OBB_SUBTREE_SIZE)
+      {
+        state.Tasks->push_back({ LHlist, LHnode, level + 1 });
+      }
+      else
+      {
+        this->BuildTree(LHlist, LHnode, level + 1, state);
+      }
+      if (state.Tasks && RHlist->GetNumberOfIds() <= VTK_OBB_SUBTREE_SIZE)
+      {
+        state.Tasks->push_back({ RHlist, RHnode, level + 1 });
+      }
+      else
+      {
+        this->BuildTree(RHlist, RHnode, level + 1, state);
+      }
     }
     else
     {
@@ -1277,7 +1402,6 @@ void vtkOBBTree::BuildTree(vtkIdList* cells, vtkOBBNode* OBBptr, int level)
   {
     cells->Delete();
   }
-  cellPts->Delete();
 }
 
 // Create polygonal representation for OBB tree at specified level. If
@@ -57,6 +57,7 @@
 #include "vtkFiltersGeneralModule.h" // For export macro
 
 class vtkMatrix4x4;
+struct vtkOBBBuildState;
 
 // Special class defines node for the OBB tree
 //
@@ -198,8 +199,19 @@ protected:
   void ComputeOBB(vtkIdList* cells, double corner[3], double max[3], double mid[3], double min[3],
     double size[3]);
 
+  // Same as above, with the points of the cells gathered using the point
+  // marks and list of the given state, so that OBBs can be computed
+  // concurrently.
+  void ComputeOBB(vtkIdList* cells, double corner[3], double max[3], double mid[3], double min[3],
+    double size[3], vtkOBBBuildState& state);
+
   vtkOBBNode* Tree;
   void BuildTree(vtkIdList* cells, vtkOBBNode* parent, int level);
+
+  // Build the subtree of parent using the given state. If the state has a
+  // task list, the subtrees of the small nodes are added to it rather than
+  // built (to be built concurrently).
+  void BuildTree(vtkIdList* cells, vtkOBBNode* parent, int level, vtkOBBBuildState& state);
   vtkPoints* PointsList;
   int* InsertedPoints;
   int OBBCount;
@@ -1712,7 +1712,6 @@ int vtkTableBasedClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
   theInput = nullptr;
   vtkDebugMacro(<< "Clipping dataset" << endl);
 
-  int i;
   vtkIdType numbPnts = cpyInput->GetNumberOfPoints();
 
   // handling exceptions
@@ -1747,11 +1746,7 @@ int vtkTableBasedClipDataSet::RequestData(vtkInformation* vtkNotUsed(request),
       cpyInput->GetPointData()->SetScalars(pScalars);
     }
 
-    for (i = 0; i < numbPnts; i++)
-    {
-      double s = this->ClipFunction->FunctionValue(cpyInput->GetPoint(i));
-      pScalars->SetTuple1(i, s);
-    }
+    this->ClipFunction->FunctionValue(cpyInput, pScalars);
 
     clipAray = pScalars;
   }
@@ -0,0 +1,123 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSelectEnclosedPointsVoxelCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Test that vtkSelectEnclosedPoints produces the same results with and
+// without the voxel cache, for a surface with a cavity.
+
+#include "vtkAppendPolyData.h"
+#include "vtkDataArray.h"
+#include "vtkInsideOutsideVoxelCache.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRandomPool.h"
+#include "vtkSelectEnclosedPoints.h"
+#include "vtkSphereSource.h"
+#include "vtkStaticCellLocator.h"
+
+#include <iostream>
+
+int TestSelectEnclosedPointsVoxelCache(int, char*[])
+{
+  // A hollow ball: the points between the two spheres are inside.
+  vtkNew<vtkSphereSource> outer;
+  outer->SetRadius(2.0);
+  outer->SetThetaResolution(40);
+  outer->SetPhiResolution(30);
+  vtkNew<vtkSphereSource> inner;
+  inner->SetRadius(1.0);
+  inner->SetCenter(0.2, 0.1, 0.0);
+  inner->SetThetaResolution(30);
+  inner->SetPhiResolution(20);
+  vtkNew<vtkAppendPolyData> append;
+  append->AddInputConnection(outer->GetOutputPort());
+  append->AddInputConnection(inner->GetOutputPort());
+  append->Update();
+  vtkPolyData* surface = append->GetOutput();
+
+  vtkNew<vtkPoints> points;
+  points->SetNumberOfPoints(20000);
+  vtkNew<vtkRandomPool> pool;
+  for (int i = 0; i < 3; ++i)
+  {
+    pool->PopulateDataArray(points->GetData(), i, -2.2, 2.2);
+  }
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(points);
+
+  vtkNew<vtkSelectEnclosedPoints> select;
+  select->SetInputData(cloud);
+  select->SetSurfaceData(surface);
+  select->Update();
+  vtkNew<vtkPolyData> reference;
+  reference->DeepCopy(select->GetOutput());
+
+  select->UseVoxelCacheOn();
+  select->SetVoxelCacheResolution(32);
+  select->Update();
+
+  vtkDataArray* refHits = reference->GetPointData()->GetArray("SelectedPoints");
+  vtkDataArray* hits = select->GetOutput()->GetPointData()->GetArray("SelectedPoints");
+  int numInside = 0;
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    if (hits->GetTuple1(i) != refHits->GetTuple1(i))
+    {
+      std::cerr << "Point " << i << " classified differently with the voxel cache" << std::endl;
+      return EXIT_FAILURE;
+    }
+    numInside += static_cast<int>(hits->GetTuple1(i));
+  }
+  if (numInside == 0 || numInside == points->GetNumberOfPoints())
+  {
+    std::cerr << "Unexpected number of inside points: " << numInside << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Most of the points are classified by the cache, including the ones in
+  // the cavity.
+  vtkNew<vtkStaticCellLocator> locator;
+  locator->SetDataSet(surface);
+  locator->BuildLocator();
+  vtkNew<vtkInsideOutsideVoxelCache> cache;
+  cache->SetResolution(32);
+  cache->Build(surface, locator, select->GetTolerance());
+  int numCached = 0;
+  for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i)
+  {
+    numCached += (cache->Classify(points->GetPoint(i)) != vtkInsideOutsideVoxelCache::BOUNDARY);
+  }
+  const double center[3] = { 0.2, 0.1, 0.0 };
+  if (numCached < points->GetNumberOfPoints() / 2 ||
+    cache->Classify(center) != vtkInsideOutsideVoxelCache::OUTSIDE)
+  {
+    std::cerr << "Unexpected voxel cache: " << numCached << " points classified" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The backdoor methods use the cache as well.
+  select->Initialize(surface);
+  for (vtkIdType i = 0; i < 1000; ++i)
+  {
+    if (select->IsInsideSurface(points->GetPoint(i)) != refHits->GetTuple1(i))
+    {
+      std::cerr << "IsInsideSurface() differs for point " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  select->Complete();
+
+  return EXIT_SUCCESS;
+}
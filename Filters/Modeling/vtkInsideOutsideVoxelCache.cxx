@@ -0,0 +1,279 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkInsideOutsideVoxelCache.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkInsideOutsideVoxelCache.h"
+
+#include "vtkAbstractCellLocator.h"
+#include "vtkGenericCell.h"
+#include "vtkIdList.h"
+#include "vtkIntersectionCounter.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkRandomPool.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPTools.h"
+#include "vtkSelectEnclosedPoints.h"
+
+#include <algorithm>
+#include <cmath>
+
+vtkStandardNewMacro(vtkInsideOutsideVoxelCache);
+
+//------------------------------------------------------------------------------
+// Classes support threading.
+namespace
+{
+
+// Classify the regions of voxels by casting rays from one voxel of each
+// region, in parallel.
+struct ClassifyRegions
+{
+  const std::vector<vtkIdType>& Seeds;
+  std::vector<unsigned char>& States;
+  const vtkIdType* Dims;
+  const double* Origin;
+  double Spacing;
+  vtkPolyData* Surface;
+  double Bounds[6];
+  double Length;
+  double Tolerance;
+  vtkAbstractCellLocator* Locator;
+  vtkRandomPool* Sequence;
+  vtkSMPThreadLocal<vtkIntersectionCounter> Counter;
+  vtkSMPThreadLocalObject<vtkIdList> CellIds;
+  vtkSMPThreadLocalObject<vtkGenericCell> Cell;
+
+  ClassifyRegions(const std::vector<vtkIdType>& seeds, std::vector<unsigned char>& states,
+    const vtkIdType* dims, const double* origin, double spacing, vtkPolyData* surface,
+    double tol, vtkAbstractCellLocator* loc)
+    : Seeds(seeds)
+    , States(states)
+    , Dims(dims)
+    , Origin(origin)
+    , Spacing(spacing)
+    , Surface(surface)
+    , Tolerance(tol)
+    , Locator(loc)
+  {
+    surface->GetBounds(this->Bounds);
+    this->Length = surface->GetLength();
+
+    // Precompute a sufficiently large enough random sequence
+    this->Sequence = vtkRandomPool::New();
+    this->Sequence->SetSize(std::max(static_cast<vtkIdType>(seeds.size()), vtkIdType{ 1500 }));
+    this->Sequence->GeneratePool();
+  }
+
+  ~ClassifyRegions() { this->Sequence->Delete(); }
+
+  void Initialize()
+  {
+    vtkIdList*& cellIds = this->CellIds.Local();
+    cellIds->Allocate(512);
+    vtkIntersectionCounter& counter = this->Counter.Local();
+    counter.SetTolerance(this->Tolerance);
+  }
+
+  void operator()(vtkIdType region, vtkIdType endRegion)
+  {
+    vtkGenericCell*& cell = this->Cell.Local();
+    vtkIdList*& cellIds = this->CellIds.Local();
+    vtkIntersectionCounter& counter = this->Counter.Local();
+    const vtkIdType* dims = this->Dims;
+
+    for (; region < endRegion; ++region)
+    {
+      // Use the center of the seed voxel of the region.
+      vtkIdType voxelId = this->Seeds[region];
+      vtkIdType ijk[3] = { voxelId % dims[0], (voxelId / dims[0]) % dims[1],
+        voxelId / (dims[0] * dims[1]) };
+      double x[3];
+      for (int i = 0; i < 3; ++i)
+      {
+        x[i] = this->Origin[i] + (ijk[i] + 0.5) * this->Spacing;
+      }
+      this->States[region] = vtkSelectEnclosedPoints::IsInsideSurface(x, this->Surface,
+                               this->Bounds, this->Length, this->Tolerance, this->Locator,
+                               cellIds, cell, counter, this->Sequence, region)
+        ? vtkInsideOutsideVoxelCache::INSIDE
+        : vtkInsideOutsideVoxelCache::OUTSIDE;
+    }
+  }
+
+  void Reduce() {}
+}; // ClassifyRegions
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+vtkInsideOutsideVoxelCache::vtkInsideOutsideVoxelCache()
+{
+  this->Resolution = 128;
+  for (int i = 0; i < 6; ++i)
+  {
+    this->Bounds[i] = 0.0;
+  }
+  this->Spacing = 0.0;
+  this->Dimensions[0] = this->Dimensions[1] = this->Dimensions[2] = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkInsideOutsideVoxelCache::~vtkInsideOutsideVoxelCache() = default;
+
+//------------------------------------------------------------------------------
+void vtkInsideOutsideVoxelCache::Free()
+{
+  std::vector<unsigned char>().swap(this->Voxels);
+  this->Dimensions[0] = this->Dimensions[1] = this->Dimensions[2] = 0;
+}
+
+//------------------------------------------------------------------------------
+void vtkInsideOutsideVoxelCache::Build(
+  vtkPolyData* surface, vtkAbstractCellLocator* locator, double tolerance)
+{
+  this->Free();
+
+  const vtkIdType numCells = surface->GetNumberOfCells();
+  surface->GetBounds(this->Bounds);
+  double maxLength = 0.0;
+  for (int i = 0; i < 3; ++i)
+  {
+    maxLength = std::max(maxLength, this->Bounds[2 * i + 1] - this->Bounds[2 * i]);
+  }
+  if (numCells < 1 || maxLength <= 0.0)
+  {
+    return; // every point is tested by ray casting
+  }
+
+  // Cubic voxels covering the bounding box.
+  this->Spacing = maxLength / this->Resolution;
+  for (int i = 0; i < 3; ++i)
+  {
+    double length = this->Bounds[2 * i + 1] - this->Bounds[2 * i];
+    this->Dimensions[i] = std::max<vtkIdType>(
+      static_cast<vtkIdType>(std::ceil(length / this->Spacing)), vtkIdType{ 1 });
+  }
+  const vtkIdType* dims = this->Dimensions;
+  const vtkIdType sliceSize = dims[0] * dims[1];
+  const vtkIdType numVoxels = sliceSize * dims[2];
+
+  // Mark the voxels overlapping the bounds of the cells, enlarged by the
+  // intersection tolerance, as boundary voxels. The voxel indices are
+  // computed exactly as in Classify(), so a point in any other voxel is
+  // further than the tolerance from all of the cells.
+  const double tol = tolerance * surface->GetLength();
+  std::vector<int> regions(numVoxels, 0);
+  double cellBounds[6];
+  for (vtkIdType cellId = 0; cellId < numCells; ++cellId)
+  {
+    surface->GetCellBounds(cellId, cellBounds);
+    vtkIdType lo[3], hi[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      lo[i] = this->VoxelIndex(cellBounds[2 * i] - tol, i);
+      hi[i] = this->VoxelIndex(cellBounds[2 * i + 1] + tol, i);
+    }
+    for (vtkIdType k = lo[2]; k <= hi[2]; ++k)
+    {
+      for (vtkIdType j = lo[1]; j <= hi[1]; ++j)
+      {
+        int* row = regions.data() + k * sliceSize + j * dims[0];
+        std::fill(row + lo[0], row + hi[0] + 1, -1);
+      }
+    }
+  }
+
+  // Label the connected (through faces) regions of the other voxels. The
+  // surface does not cross a region, so all of its points are on the same
+  // side. The regions touching the border of the bounding box are outside.
+  std::vector<unsigned char> states;
+  std::vector<vtkIdType> interiorSeeds;
+  std::vector<vtkIdType> interiorRegions;
+  std::vector<vtkIdType> stack;
+  for (vtkIdType voxelId = 0; voxelId < numVoxels; ++voxelId)
+  {
+    if (regions[voxelId] != 0)
+    {
+      continue;
+    }
+    const int label = static_cast<int>(states.size()) + 1;
+    bool border = false;
+    regions[voxelId] = label;
+    stack.push_back(voxelId);
+    while (!stack.empty())
+    {
+      const vtkIdType id = stack.back();
+      stack.pop_back();
+      const vtkIdType ijk[3] = { id % dims[0], (id / dims[0]) % dims[1], id / sliceSize };
+      const vtkIdType strides[3] = { 1, dims[0], sliceSize };
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        if (ijk[axis] == 0 || ijk[axis] == dims[axis] - 1)
+        {
+          border = true;
+        }
+        if (ijk[axis] > 0 && regions[id - strides[axis]] == 0)
+        {
+          regions[id - strides[axis]] = label;
+          stack.push_back(id - strides[axis]);
+        }
+        if (ijk[axis] < dims[axis] - 1 && regions[id + strides[axis]] == 0)
+        {
+          regions[id + strides[axis]] = label;
+          stack.push_back(id + strides[axis]);
+        }
+      }
+    }
+    states.push_back(OUTSIDE);
+    if (!border)
+    {
+      interiorSeeds.push_back(voxelId);
+      interiorRegions.push_back(label - 1);
+    }
+  }
+
+  // Classify the interior regions by ray casting.
+  std::vector<unsigned char> interiorStates(interiorSeeds.size());
+  const double origin[3] = { this->Bounds[0], this->Bounds[2], this->Bounds[4] };
+  ClassifyRegions classify(interiorSeeds, interiorStates, dims, origin, this->Spacing, surface,
+    tolerance, locator);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(interiorSeeds.size()), classify);
+  for (size_t i = 0; i < interiorRegions.size(); ++i)
+  {
+    states[interiorRegions[i]] = interiorStates[i];
+  }
+
+  // Store the state of each voxel.
+  this->Voxels.resize(numVoxels);
+  const int* labels = regions.data();
+  unsigned char* voxels = this->Voxels.data();
+  vtkSMPTools::For(0, numVoxels, [labels, voxels, &states](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType voxelId = begin; voxelId < end; ++voxelId)
+    {
+      const int label = labels[voxelId];
+      voxels[voxelId] = (label < 0 ? static_cast<unsigned char>(BOUNDARY) : states[label - 1]);
+    }
+  });
+}
+
+//------------------------------------------------------------------------------
+void vtkInsideOutsideVoxelCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "Resolution: " << this->Resolution << "\n";
+  os << indent << "Dimensions: (" << this->Dimensions[0] << ", " << this->Dimensions[1] << ", "
+     << this->Dimensions[2] << ")\n";
+}
@@ -0,0 +1,147 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkInsideOutsideVoxelCache.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkInsideOutsideVoxelCache
+ * @brief   voxelized inside/outside classification of a closed surface
+ *
+ * vtkInsideOutsideVoxelCache accelerates point containment tests against a
+ * closed, manifold surface (see vtkSelectEnclosedPoints and
+ * vtkExtractEnclosedPoints). The bounding box of the surface is divided into
+ * cubic voxels. The voxels which may be within the intersection tolerance
+ * of a cell of the surface are marked as boundary voxels. The remaining
+ * voxels form connected regions which the surface does not cross, so all of
+ * their points are either inside or outside of the surface: the regions
+ * touching the border of the bounding box are outside, and each other
+ * region is classified by casting rays from one of its voxels (in parallel,
+ * via vtkSMPTools). After that, Classify() answers the containment query in
+ * constant time for any point except the ones in boundary voxels, for which
+ * the caller falls back to ray casting. The results of both paths are the
+ * same for points away from the tolerance band of the surface.
+ *
+ * The resolution of the cache is the number of voxels along the longest
+ * axis of the bounding box of the surface. Higher resolutions answer more
+ * queries without ray casting, at the cost of memory (one byte per voxel,
+ * plus four bytes per voxel during Build()).
+ *
+ * @warning
+ * Once built, Classify() is thread safe.
+ *
+ * @sa
+ * vtkSelectEnclosedPoints vtkExtractEnclosedPoints
+ */
+
+#ifndef vtkInsideOutsideVoxelCache_h
+#define vtkInsideOutsideVoxelCache_h
+
+#include "vtkFiltersModelingModule.h" // For export macro
+#include "vtkObject.h"
+
+#include <vector> // For std::vector
+
+class vtkAbstractCellLocator;
+class vtkPolyData;
+
+class VTKFILTERSMODELING_EXPORT vtkInsideOutsideVoxelCache : public vtkObject
+{
+public:
+  //@{
+  /**
+   * Standard methods for instantiation, type information and printing.
+   */
+  static vtkInsideOutsideVoxelCache* New();
+  vtkTypeMacro(vtkInsideOutsideVoxelCache, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  //@}
+
+  /**
+   * The classification of a voxel.
+   */
+  enum VoxelState
+  {
+    OUTSIDE = 0,
+    INSIDE = 1,
+    BOUNDARY = 2
+  };
+
+  //@{
+  /**
+   * Specify the number of voxels along the longest axis of the bounding box
+   * of the surface. Default is 128.
+   */
+  vtkSetClampMacro(Resolution, int, 1, 1024);
+  vtkGetMacro(Resolution, int);
+  //@}
+
+  /**
+   * Build the cache for a closed surface. The tolerance is expressed as a
+   * fraction of the diagonal of the bounding box of the surface, as in
+   * vtkSelectEnclosedPoints, and the locator must have been built for the
+   * surface. It is used to classify the regions of voxels.
+   */
+  void Build(vtkPolyData* surface, vtkAbstractCellLocator* locator, double tolerance);
+
+  /**
+   * Release the memory of the cache.
+   */
+  void Free();
+
+  /**
+   * Return OUTSIDE or INSIDE if the point is known to be outside or inside
+   * of the surface, or BOUNDARY if it is in a boundary voxel (or if the
+   * cache has not been built), in which case the point must be tested by
+   * ray casting.
+   */
+  int Classify(const double x[3]) const
+  {
+    if (this->Voxels.empty())
+    {
+      return BOUNDARY;
+    }
+    if (x[0] < this->Bounds[0] || x[0] > this->Bounds[1] || x[1] < this->Bounds[2] ||
+      x[1] > this->Bounds[3] || x[2] < this->Bounds[4] || x[2] > this->Bounds[5])
+    {
+      return OUTSIDE;
+    }
+    vtkIdType ijk[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      ijk[i] = this->VoxelIndex(x[i], i);
+    }
+    return this->Voxels[ijk[0] + this->Dimensions[0] * (ijk[1] + this->Dimensions[1] * ijk[2])];
+  }
+
+protected:
+  vtkInsideOutsideVoxelCache();
+  ~vtkInsideOutsideVoxelCache() override;
+
+  // The index of the voxel containing coordinate x along the given axis.
+  vtkIdType VoxelIndex(double x, int axis) const
+  {
+    vtkIdType i = static_cast<vtkIdType>((x - this->Bounds[2 * axis]) / this->Spacing);
+    return (i < 0 ? 0 : (i >= this->Dimensions[axis] ? this->Dimensions[axis] - 1 : i));
+  }
+
+  int Resolution;
+  double Bounds[6];
+  double Spacing;
+  vtkIdType Dimensions[3];
+  std::vector<unsigned char> Voxels;
+
+private:
+  vtkInsideOutsideVoxelCache(const vtkInsideOutsideVoxelCache&) = delete;
+  void operator=(const vtkInsideOutsideVoxelCache&) = delete;
+};
+
+#endif
@@ -24,6 +24,7 @@
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkInsideOutsideVoxelCache.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
@@ -54,6 +55,7 @@ struct SelectInOutCheck
   double Length;
   double Tolerance;
   vtkStaticCellLocator* Locator;
+  vtkInsideOutsideVoxelCache* Cache;
   unsigned char* Hits;
   vtkSelectEnclosedPoints* Selector;
   vtkTypeBool InsideOut;
@@ -66,13 +68,14 @@ struct SelectInOutCheck
   vtkSMPThreadLocalObject<vtkGenericCell> Cell;
 
   SelectInOutCheck(vtkIdType numPts, vtkDataSet* ds, vtkPolyData* surface, double bds[6],
-    double tol, vtkStaticCellLocator* loc, unsigned char* hits, vtkSelectEnclosedPoints* sel,
-    vtkTypeBool io)
+    double tol, vtkStaticCellLocator* loc, vtkInsideOutsideVoxelCache* cache, unsigned char* hits,
+    vtkSelectEnclosedPoints* sel, vtkTypeBool io)
     : NumPts(numPts)
     , DataSet(ds)
     , Surface(surface)
     , Tolerance(tol)
     , Locator(loc)
+    , Cache(cache)
     , Hits(hits)
     , Selector(sel)
     , InsideOut(io)
@@ -109,13 +112,19 @@ struct SelectInOutCheck
     vtkGenericCell*& cell = this->Cell.Local();
     vtkIdList*& cellIds = this->CellIds.Local();
     vtkIntersectionCounter& counter = this->Counter.Local();
+    int state;
 
     for (; ptId < endPtId; ++ptId)
     {
       this->DataSet->GetPoint(ptId, x);
 
-      if (this->Selector->IsInsideSurface(x, this->Surface, this->Bounds, this->Length,
-            this->Tolerance, this->Locator, cellIds, cell, counter, this->Sequence, ptId))
+      // Only the points close to the surface need ray casting.
+      if ((state = this->Cache->Classify(x)) == vtkInsideOutsideVoxelCache::BOUNDARY)
+      {
+        state = this->Selector->IsInsideSurface(x, this->Surface, this->Bounds, this->Length,
+          this->Tolerance, this->Locator, cellIds, cell, counter, this->Sequence, ptId);
+      }
+      if (state)
       {
         *hits++ = (this->InsideOut ? 0 : 1);
       }
@@ -129,9 +138,11 @@ struct SelectInOutCheck
   void Reduce() {}
 
   static void Execute(vtkIdType numPts, vtkDataSet* ds, vtkPolyData* surface, double bds[6],
-    double tol, vtkStaticCellLocator* loc, unsigned char* hits, vtkSelectEnclosedPoints* sel)
+    double tol, vtkStaticCellLocator* loc, vtkInsideOutsideVoxelCache* cache, unsigned char* hits,
+    vtkSelectEnclosedPoints* sel)
   {
-    SelectInOutCheck inOut(numPts, ds, surface, bds, tol, loc, hits, sel, sel->GetInsideOut());
+    SelectInOutCheck inOut(
+      numPts, ds, surface, bds, tol, loc, cache, hits, sel, sel->GetInsideOut());
     vtkSMPTools::For(0, numPts, inOut);
   }
 }; // SelectInOutCheck
@@ -147,6 +158,8 @@ vtkSelectEnclosedPoints::vtkSelectEnclosedPoints()
   this->CheckSurface = false;
   this->InsideOut = 0;
   this->Tolerance = 0.0001;
+  this->UseVoxelCache = false;
+  this->VoxelCacheResolution = 128;
 
   this->InsideOutsideArray = nullptr;
 
@@ -154,6 +167,7 @@ vtkSelectEnclosedPoints::vtkSelectEnclosedPoints()
   this->CellLocator = vtkStaticCellLocator::New();
   this->CellIds = vtkIdList::New();
   this->Cell = vtkGenericCell::New();
+  this->VoxelCache = vtkInsideOutsideVoxelCache::New();
 }
 
 //------------------------------------------------------------------------------
@@ -173,6 +187,7 @@ vtkSelectEnclosedPoints::~vtkSelectEnclosedPoints()
 
   this->CellIds->Delete();
   this->Cell->Delete();
+  this->VoxelCache->Delete();
 }
 
 //------------------------------------------------------------------------------
@@ -214,8 +229,8 @@ int vtkSelectEnclosedPoints::RequestData(vtkInformation* vtkNotUsed(request),
   unsigned char* hitsPtr = static_cast<unsigned char*>(hits->GetVoidPointer(0));
 
   // Process the points in parallel
-  SelectInOutCheck::Execute(
-    numPts, input, surface, this->Bounds, this->Tolerance, this->CellLocator, hitsPtr, this);
+  SelectInOutCheck::Execute(numPts, input, surface, this->Bounds, this->Tolerance,
+    this->CellLocator, this->VoxelCache, hitsPtr, this);
 
   // Copy all the input geometry and data to the output.
   output->CopyStructure(input);
@@ -276,6 +291,17 @@ void vtkSelectEnclosedPoints::Initialize(vtkPolyData* surface)
   // Set up structures for acceleration ray casting
   this->CellLocator->SetDataSet(surface);
   this->CellLocator->BuildLocator();
+
+  // Classify the voxels away from the surface once and for all.
+  if (this->UseVoxelCache)
+  {
+    this->VoxelCache->SetResolution(this->VoxelCacheResolution);
+    this->VoxelCache->Build(surface, this->CellLocator, this->Tolerance);
+  }
+  else
+  {
+    this->VoxelCache->Free();
+  }
 }
 
 //------------------------------------------------------------------------------
@@ -306,6 +332,12 @@ int vtkSelectEnclosedPoints::IsInsideSurface(double x, double y, double z)
 // safe due to the use of the data member CellIds and Cell.
 int vtkSelectEnclosedPoints::IsInsideSurface(double x[3])
 {
+  int state = this->VoxelCache->Classify(x);
+  if (state != vtkInsideOutsideVoxelCache::BOUNDARY)
+  {
+    return state;
+  }
+
   vtkIntersectionCounter counter(this->Tolerance, this->Length);
 
   return this->IsInsideSurface(x, this->Surface, this->Bounds, this->Length, this->Tolerance,
@@ -486,6 +518,7 @@ int vtkSelectEnclosedPoints::FillInputPortInformation(int port, vtkInformation*
 void vtkSelectEnclosedPoints::Complete()
 {
   this->CellLocator->FreeSearchStructure();
+  this->VoxelCache->Free();
 }
 
 //------------------------------------------------------------------------------
@@ -507,4 +540,8 @@ void vtkSelectEnclosedPoints::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Inside Out: " << (this->InsideOut ? "On\n" : "Off\n");
 
   os << indent << "Tolerance: " << this->Tolerance << "\n";
+
+  os << indent << "Use Voxel Cache: " << (this->UseVoxelCache ? "On\n" : "Off\n");
+
+  os << indent << "Voxel Cache Resolution: " << this->VoxelCacheResolution << "\n";
 }
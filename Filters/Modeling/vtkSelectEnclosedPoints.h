@@ -37,13 +37,20 @@
  * are available (i.e., threshold the output array). Also, see the filter
  * vtkExtractEnclosedPoints which operates on point clouds.
  *
+ * When testing many points, UseVoxelCache can be enabled: a voxelized
+ * inside/outside classification of the surface is then built once (see
+ * vtkInsideOutsideVoxelCache), which answers the test in constant time for
+ * all of the points except the ones close to the surface, which are still
+ * tested by ray casting. The results are the same as without the cache for
+ * points away from the tolerance band of the surface.
+ *
  * @warning
  * This class has been threaded with vtkSMPTools. Using TBB or other
  * non-sequential type (set in the CMake variable
  * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
  *
  * @sa
- * vtkMaskPoints vtkExtractEnclosedPoints
+ * vtkMaskPoints vtkExtractEnclosedPoints vtkInsideOutsideVoxelCache
  */
 
 #ifndef vtkSelectEnclosedPoints_h
@@ -58,6 +65,7 @@ class vtkAbstractCellLocator;
 class vtkStaticCellLocator;
 class vtkIdList;
 class vtkGenericCell;
+class vtkInsideOutsideVoxelCache;
 class vtkRandomPool;
 
 class VTKFILTERSMODELING_EXPORT vtkSelectEnclosedPoints : public vtkDataSetAlgorithm
@@ -130,12 +138,34 @@ public:
   vtkGetMacro(Tolerance, double);
   //@}
 
+  //@{
+  /**
+   * Enable the voxelized inside/outside classification of the surface, which
+   * avoids ray casting for the points away from the surface. This assumes
+   * that the surface is closed and manifold. Default is off.
+   */
+  vtkSetMacro(UseVoxelCache, vtkTypeBool);
+  vtkBooleanMacro(UseVoxelCache, vtkTypeBool);
+  vtkGetMacro(UseVoxelCache, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Specify the number of voxels of the cache along the longest axis of the
+   * bounding box of the surface (see vtkInsideOutsideVoxelCache). Default
+   * is 128.
+   */
+  vtkSetClampMacro(VoxelCacheResolution, int, 1, 1024);
+  vtkGetMacro(VoxelCacheResolution, int);
+  //@}
+
   //@{
   /**
    * This is a backdoor that can be used to test many points for containment.
    * First initialize the instance, then repeated calls to IsInsideSurface()
-   * can be used without rebuilding the search structures. The Complete()
-   * method releases memory.
+   * can be used without rebuilding the search structures (including the
+   * voxel cache if UseVoxelCache is on). The Complete() method releases
+   * memory.
    */
   void Initialize(vtkPolyData* surface);
   int IsInsideSurface(double x[3]);
@@ -170,6 +200,8 @@ protected:
   vtkTypeBool CheckSurface;
   vtkTypeBool InsideOut;
   double Tolerance;
+  vtkTypeBool UseVoxelCache;
+  int VoxelCacheResolution;
 
   vtkUnsignedCharArray* InsideOutsideArray;
 
@@ -177,6 +209,7 @@ protected:
   vtkStaticCellLocator* CellLocator;
   vtkIdList* CellIds;
   vtkGenericCell* Cell;
+  vtkInsideOutsideVoxelCache* VoxelCache;
   vtkPolyData* Surface;
   double Bounds[6];
   double Length;
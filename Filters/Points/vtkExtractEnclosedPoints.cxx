@@ -26,8 +26,10 @@
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkInsideOutsideVoxelCache.h"
 #include "vtkIntersectionCounter.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
@@ -60,6 +62,7 @@ struct ExtractInOutCheck
   double Length;
   double Tolerance;
   vtkStaticCellLocator* Locator;
+  vtkInsideOutsideVoxelCache* Cache;
   vtkIdType* PointMap;
   vtkRandomPool* Sequence;
   vtkSMPThreadLocal<vtkIntersectionCounter> Counter;
@@ -70,11 +73,12 @@ struct ExtractInOutCheck
   vtkSMPThreadLocalObject<vtkGenericCell> Cell;
 
   ExtractInOutCheck(ArrayT* pts, vtkPolyData* surface, double bds[6], double tol,
-    vtkStaticCellLocator* loc, vtkIdType* map)
+    vtkStaticCellLocator* loc, vtkInsideOutsideVoxelCache* cache, vtkIdType* map)
     : Points(pts)
     , Surface(surface)
     , Tolerance(tol)
     , Locator(loc)
+    , Cache(cache)
     , PointMap(map)
   {
     const vtkIdType numPts = pts->GetNumberOfTuples();
@@ -122,8 +126,13 @@ struct ExtractInOutCheck
       x[1] = static_cast<double>(pt[1]);
       x[2] = static_cast<double>(pt[2]);
 
-      hit = vtkSelectEnclosedPoints::IsInsideSurface(x, this->Surface, this->Bounds, this->Length,
-        this->Tolerance, this->Locator, cellIds, cell, counter, this->Sequence, ptId);
+      // Only the points close to the surface need ray casting.
+      if ((hit = this->Cache->Classify(x)) == vtkInsideOutsideVoxelCache::BOUNDARY)
+      {
+        hit = vtkSelectEnclosedPoints::IsInsideSurface(x, this->Surface, this->Bounds,
+          this->Length, this->Tolerance, this->Locator, cellIds, cell, counter, this->Sequence,
+          ptId);
+      }
       *map++ = (hit ? 1 : -1);
     }
   }
@@ -135,9 +144,9 @@ struct ExtractLauncher
 {
   template <typename ArrayT>
   void operator()(ArrayT* pts, vtkPolyData* surface, double bds[6], double tol,
-    vtkStaticCellLocator* loc, vtkIdType* hits)
+    vtkStaticCellLocator* loc, vtkInsideOutsideVoxelCache* cache, vtkIdType* hits)
   {
-    ExtractInOutCheck<ArrayT> inOut(pts, surface, bds, tol, loc, hits);
+    ExtractInOutCheck<ArrayT> inOut(pts, surface, bds, tol, loc, cache, hits);
     vtkSMPTools::For(0, pts->GetNumberOfTuples(), inOut);
   }
 };
@@ -152,6 +161,8 @@ vtkExtractEnclosedPoints::vtkExtractEnclosedPoints()
 
   this->CheckSurface = false;
   this->Tolerance = 0.001;
+  this->UseVoxelCache = false;
+  this->VoxelCacheResolution = 128;
 }
 
 //------------------------------------------------------------------------------
@@ -203,15 +214,24 @@ int vtkExtractEnclosedPoints::FilterPoints(vtkPointSet* input)
   locator->SetDataSet(surface);
   locator->BuildLocator();
 
+  // Classify the voxels away from the surface once and for all.
+  vtkNew<vtkInsideOutsideVoxelCache> cache;
+  if (this->UseVoxelCache)
+  {
+    cache->SetResolution(this->VoxelCacheResolution);
+    cache->Build(surface, locator, this->Tolerance);
+  }
+
   // Loop over all input points determining inside/outside
   // Use fast path for float/double points:
   using vtkArrayDispatch::Reals;
   using Dispatcher = vtkArrayDispatch::DispatchByValueType<Reals>;
   ExtractLauncher worker;
   vtkDataArray* ptArray = input->GetPoints()->GetData();
-  if (!Dispatcher::Execute(ptArray, worker, surface, bds, this->Tolerance, locator, this->PointMap))
+  if (!Dispatcher::Execute(
+        ptArray, worker, surface, bds, this->Tolerance, locator, cache, this->PointMap))
   { // fallback for other arrays:
-    worker(ptArray, surface, bds, this->Tolerance, locator, this->PointMap);
+    worker(ptArray, surface, bds, this->Tolerance, locator, cache, this->PointMap);
   }
 
   // Clean up and get out
@@ -276,4 +296,8 @@ void vtkExtractEnclosedPoints::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Check Surface: " << (this->CheckSurface ? "On\n" : "Off\n");
 
   os << indent << "Tolerance: " << this->Tolerance << "\n";
+
+  os << indent << "Use Voxel Cache: " << (this->UseVoxelCache ? "On\n" : "Off\n");
+
+  os << indent << "Voxel Cache Resolution: " << this->VoxelCacheResolution << "\n";
 }
@@ -32,6 +32,11 @@
  * and the surface is not closed, the results are undefined.
  *
  * @warning
+ * For large point clouds, enable UseVoxelCache: only the points close to
+ * the surface are then tested by ray casting, the others are classified in
+ * constant time with a vtkInsideOutsideVoxelCache built from the surface.
+ *
+ * @warning
  * This class has been threaded with vtkSMPTools. Using TBB or other
  * non-sequential type (set in the CMake variable
  * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
@@ -47,7 +52,7 @@
  * its methods to vtkSelectEnclosedPoints.
  *
  * @sa
- * vtkSelectEnclosedPoints vtkExtractPoints
+ * vtkSelectEnclosedPoints vtkExtractPoints vtkInsideOutsideVoxelCache
  */
 
 #ifndef vtkExtractEnclosedPoints_h
@@ -105,12 +110,34 @@ public:
   vtkGetMacro(Tolerance, double);
   //@}
 
+  //@{
+  /**
+   * Enable the voxelized inside/outside classification of the surface, which
+   * avoids ray casting for the points away from the surface (see
+   * vtkSelectEnclosedPoints). Default is off.
+   */
+  vtkSetMacro(UseVoxelCache, vtkTypeBool);
+  vtkBooleanMacro(UseVoxelCache, vtkTypeBool);
+  vtkGetMacro(UseVoxelCache, vtkTypeBool);
+  //@}
+
+  //@{
+  /**
+   * Specify the number of voxels of the cache along the longest axis of the
+   * bounding box of the surface. Default is 128.
+   */
+  vtkSetClampMacro(VoxelCacheResolution, int, 1, 1024);
+  vtkGetMacro(VoxelCacheResolution, int);
+  //@}
+
 protected:
   vtkExtractEnclosedPoints();
   ~vtkExtractEnclosedPoints() override;
 
   vtkTypeBool CheckSurface;
   double Tolerance;
+  vtkTypeBool UseVoxelCache;
+  int VoxelCacheResolution;
 
   // Internal structures for managing the intersection testing
   vtkPolyData* Surface;
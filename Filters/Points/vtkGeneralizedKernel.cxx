@@ -17,6 +17,7 @@
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkMath.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
@@ -48,6 +49,19 @@ vtkIdType vtkGeneralizedKernel::ComputeBasis(double x[3], vtkIdList* pIds, vtkId
   return pIds->GetNumberOfIds();
 }
 
+//------------------------------------------------------------------------------
+void vtkGeneralizedKernel::ComputeBasisBatch(vtkPoints* x, vtkIdTypeArray* offsets, vtkIdList* pIds)
+{
+  if (this->KernelFootprint == vtkGeneralizedKernel::RADIUS)
+  {
+    this->Locator->FindPointsWithinRadiusBatch(this->Radius, x, offsets, pIds);
+  }
+  else
+  {
+    this->Locator->FindClosestNPointsBatch(this->NumberOfPoints, x, offsets, pIds);
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkGeneralizedKernel::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -66,6 +66,9 @@
 #include "vtkFiltersPointsModule.h" // For export macro
 #include "vtkInterpolationKernel.h"
 
+class vtkIdTypeArray;
+class vtkPoints;
+
 class VTKFILTERSPOINTS_EXPORT vtkGeneralizedKernel : public vtkInterpolationKernel
 {
 public:
@@ -89,6 +92,17 @@ public:
    */
   vtkIdType ComputeBasis(double x[3], vtkIdList* pIds, vtkIdType ptId = 0) override;
 
+  /**
+   * Compute the interpolation bases of all of the points x at once, using
+   * the batched (and possibly threaded) queries of the locator. The result
+   * is in compressed row form: the basis points of x[i] are the entries
+   * offsets[i] <= j < offsets[i+1] of pIds. The bases are the same as the
+   * ones returned by ComputeBasis(). vtkPointInterpolator only calls it for
+   * the kernels of this module; instances of other subclasses, which may
+   * override ComputeBasis(), are probed point by point.
+   */
+  virtual void ComputeBasisBatch(vtkPoints* x, vtkIdTypeArray* offsets, vtkIdList* pIds);
+
   /**
    * Given a point x, a list of basis points pIds, and a probability
    * weighting function prob, compute interpolation weights associated with
@@ -14,19 +14,27 @@
 =========================================================================*/
 #include "vtkPCANormalEstimation.h"
 
+#include "vtkAOSDataArrayTemplate.h"
 #include "vtkAbstractPointLocator.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
-#include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
 #include "vtkStaticPointLocator.h"
+#include "vtkTypeTraits.h"
+
+#include <algorithm>
+
+// Number of points whose neighborhoods are searched for at once
+#define VTK_PCA_BLOCK_SIZE 65536
 
 vtkStandardNewMacro(vtkPCANormalEstimation);
 vtkCxxSetObjectMacro(vtkPCANormalEstimation, Locator, vtkAbstractPointLocator);
@@ -35,7 +43,9 @@ namespace
 {
 
 //------------------------------------------------------------------------------
-// The threaded core of the algorithm.
+// The threaded core of the algorithm. The local neighborhoods are obtained
+// with the batched queries of the locator, by blocks of points to bound the
+// memory used by the results.
 template <typename T>
 struct GenerateNormals
 {
@@ -47,9 +57,10 @@ struct GenerateNormals
   double OPoint[3];
   bool Flip;
 
-  // Don't want to allocate working arrays on every thread invocation. Thread local
-  // storage lots of new/delete.
-  vtkSMPThreadLocalObject<vtkIdList> PIds;
+  // The current block of points and the neighborhoods of its points
+  vtkIdType BlockBegin;
+  vtkNew<vtkIdTypeArray> Offsets;
+  vtkNew<vtkIdList> PIds;
 
   GenerateNormals(T* points, vtkAbstractPointLocator* loc, int sample, float* normals, int orient,
     double opoint[3], bool flip)
@@ -59,26 +70,25 @@ struct GenerateNormals
     , Normals(normals)
     , Orient(orient)
     , Flip(flip)
+    , BlockBegin(0)
   {
     this->OPoint[0] = opoint[0];
     this->OPoint[1] = opoint[1];
     this->OPoint[2] = opoint[2];
   }
 
-  // Just allocate a little bit of memory to get started.
-  void Initialize()
-  {
-    vtkIdList*& pIds = this->PIds.Local();
-    pIds->Allocate(128); // allocate some memory
-  }
+  void Initialize() {}
 
-  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  void operator()(vtkIdType blockId, vtkIdType endBlockId)
   {
+    vtkIdType ptId = this->BlockBegin + blockId;
+    const vtkIdType endPtId = this->BlockBegin + endBlockId;
+    const vtkIdType* offsets = this->Offsets->GetPointer(0);
+    const vtkIdType* ids;
     const T* px = this->Points + 3 * ptId;
     const T* py;
     float* n = this->Normals + 3 * ptId;
     double x[3], mean[3], o[3];
-    vtkIdList*& pIds = this->PIds.Local();
     vtkIdType numPts, nei;
     int sample, i;
     double *a[3], a0[3], a1[3], a2[3], xp[3];
@@ -92,21 +102,21 @@ struct GenerateNormals
     double eVecMin[3], eVal[3];
     float flipVal = (this->Flip ? -1.0 : 1.0);
 
-    for (; ptId < endPtId; ++ptId)
+    for (; ptId < endPtId; ++ptId, ++blockId)
     {
       x[0] = static_cast<double>(*px++);
       x[1] = static_cast<double>(*px++);
       x[2] = static_cast<double>(*px++);
 
       // Retrieve the local neighborhood
-      this->Locator->FindClosestNPoints(this->SampleSize, x, pIds);
-      numPts = pIds->GetNumberOfIds();
+      ids = this->PIds->GetPointer(offsets[blockId]);
+      numPts = offsets[blockId + 1] - offsets[blockId];
 
       // First step: compute the mean position of the neighborhood.
       mean[0] = mean[1] = mean[2] = 0.0;
       for (sample = 0; sample < numPts; ++sample)
       {
-        nei = pIds->GetId(sample);
+        nei = ids[sample];
         py = this->Points + 3 * nei;
         mean[0] += static_cast<double>(*py++);
         mean[1] += static_cast<double>(*py++);
@@ -122,7 +132,7 @@ struct GenerateNormals
       a0[2] = a1[2] = a2[2] = 0.0;
       for (sample = 0; sample < numPts; ++sample)
       {
-        nei = pIds->GetId(sample);
+        nei = ids[sample];
         py = this->Points + 3 * nei;
         xp[0] = static_cast<double>(*py++) - mean[0];
         xp[1] = static_cast<double>(*py++) - mean[1];
@@ -178,7 +188,19 @@ struct GenerateNormals
   {
     GenerateNormals gen(
       points, self->GetLocator(), self->GetSampleSize(), normals, orient, opoint, flip);
-    vtkSMPTools::For(0, numPts, gen);
+    vtkNew<vtkPoints> blockPoints;
+    blockPoints->SetDataType(vtkTypeTraits<T>::VTK_TYPE_ID);
+    vtkNew<vtkAOSDataArrayTemplate<T>> blockData;
+    blockData->SetNumberOfComponents(3);
+    for (; gen.BlockBegin < numPts; gen.BlockBegin += VTK_PCA_BLOCK_SIZE)
+    {
+      const vtkIdType blockSize = std::min<vtkIdType>(VTK_PCA_BLOCK_SIZE, numPts - gen.BlockBegin);
+      blockData->SetArray(points + 3 * gen.BlockBegin, 3 * blockSize, 1);
+      blockPoints->SetData(blockData);
+      self->GetLocator()->FindClosestNPointsBatch(
+        self->GetSampleSize(), blockPoints, gen.Offsets, gen.PIds);
+      vtkSMPTools::For(0, blockSize, gen);
+    }
   }
 }; // GenerateNormals
 
@@ -21,24 +21,36 @@
 #include "vtkDataArray.h"
 #include "vtkDataSet.h"
 #include "vtkDoubleArray.h"
+#include "vtkEllipsoidalGaussianKernel.h"
 #include "vtkFloatArray.h"
+#include "vtkGaussianKernel.h"
+#include "vtkGeneralizedKernel.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkLinearKernel.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
+#include "vtkProbabilisticVoronoiKernel.h"
 #include "vtkPoints.h"
 #include "vtkSMPThreadLocalObject.h"
 #include "vtkSMPTools.h"
+#include "vtkShepardKernel.h"
 #include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
 #include <cassert>
+#include <typeinfo>
 #include <vector>
 
+// Number of points whose interpolation bases are computed at once
+#define VTK_POINT_INTERPOLATOR_BLOCK_SIZE 65536
+
 vtkStandardNewMacro(vtkPointInterpolator);
 vtkCxxSetObjectMacro(vtkPointInterpolator, Locator, vtkAbstractPointLocator);
 vtkCxxSetObjectMacro(vtkPointInterpolator, Kernel, vtkInterpolationKernel);
@@ -155,6 +167,92 @@ struct ProbePoints
 
 }; // ProbePoints
 
+// The batched probe finds the basis with ComputeBasisBatch(), so it is only
+// used for the generalized kernels of this module, which do not override
+// ComputeBasis(). Subclasses may do so and keep the per-point path.
+bool HasDefaultComputeBasis(vtkGeneralizedKernel* kernel)
+{
+  const std::type_info& type = typeid(*kernel);
+  return type == typeid(vtkGaussianKernel) || type == typeid(vtkEllipsoidalGaussianKernel) ||
+    type == typeid(vtkLinearKernel) || type == typeid(vtkProbabilisticVoronoiKernel) ||
+    type == typeid(vtkShepardKernel);
+}
+
+// Probe points with a generalized kernel, whose bases are computed with the
+// batched queries of the locator. The points are processed by blocks to
+// bound the memory used by the bases.
+struct BatchedProbePoints : public ProbePoints
+{
+  vtkGeneralizedKernel* GeneralizedKernel;
+  vtkNew<vtkPoints> BlockPoints;
+  vtkNew<vtkIdTypeArray> Offsets;
+  vtkNew<vtkIdList> BasisIds;
+  vtkIdType BlockBegin;
+
+  BatchedProbePoints(vtkPointInterpolator* ptInt, vtkGeneralizedKernel* kernel, vtkDataSet* input,
+    vtkPointData* inPD, vtkPointData* outPD, char* valid)
+    : ProbePoints(ptInt, input, inPD, outPD, valid)
+    , GeneralizedKernel(kernel)
+    , BlockBegin(0)
+  {
+    this->BlockPoints->SetDataTypeToDouble();
+  }
+
+  // Interpolate the points blockId <= i < endBlockId of the current block
+  void operator()(vtkIdType blockId, vtkIdType endBlockId)
+  {
+    double x[3];
+    vtkIdList*& pIds = this->PIds.Local();
+    vtkIdType numWeights;
+    vtkDoubleArray*& weights = this->Weights.Local();
+    const vtkIdType* offsets = this->Offsets->GetPointer(0);
+    const vtkIdType* basisIds = this->BasisIds->GetPointer(0);
+
+    for (; blockId < endBlockId; ++blockId)
+    {
+      const vtkIdType ptId = this->BlockBegin + blockId;
+      this->BlockPoints->GetPoint(blockId, x);
+      const vtkIdType numIds = offsets[blockId + 1] - offsets[blockId];
+      if (numIds > 0)
+      {
+        pIds->SetNumberOfIds(numIds);
+        std::copy(basisIds + offsets[blockId], basisIds + offsets[blockId + 1],
+          pIds->GetPointer(0));
+        numWeights = this->Kernel->ComputeWeights(x, pIds, weights);
+        this->Arrays.Interpolate(numWeights, pIds->GetPointer(0), weights->GetPointer(0), ptId);
+      }
+      else
+      {
+        this->AssignNullPoint(x, pIds, weights, ptId);
+      } // null point
+    }   // for all points in block
+  }
+
+  void Execute(vtkIdType numPts)
+  {
+    for (this->BlockBegin = 0; this->BlockBegin < numPts;
+         this->BlockBegin += VTK_POINT_INTERPOLATOR_BLOCK_SIZE)
+    {
+      const vtkIdType blockSize =
+        std::min<vtkIdType>(VTK_POINT_INTERPOLATOR_BLOCK_SIZE, numPts - this->BlockBegin);
+      this->BlockPoints->SetNumberOfPoints(blockSize);
+      vtkDataSet* input = this->Input;
+      vtkPoints* blockPoints = this->BlockPoints;
+      const vtkIdType blockBegin = this->BlockBegin;
+      vtkSMPTools::For(0, blockSize, [=](vtkIdType i, vtkIdType end) {
+        double x[3];
+        for (; i < end; ++i)
+        {
+          input->GetPoint(blockBegin + i, x);
+          blockPoints->SetPoint(i, x);
+        }
+      });
+      this->GeneralizedKernel->ComputeBasisBatch(this->BlockPoints, this->Offsets, this->BasisIds);
+      vtkSMPTools::For(0, blockSize, *this);
+    }
+  }
+}; // BatchedProbePoints
+
 // Probe points using an image. Uses a more efficient iteration scheme.
 struct ImageProbePoints : public ProbePoints
 {
@@ -340,8 +438,17 @@ void vtkPointInterpolator::Probe(vtkDataSet* input, vtkDataSet* source, vtkDataS
   }
   else
   {
-    ProbePoints probe(this, input, inPD, outPD, mask);
-    vtkSMPTools::For(0, numPts, probe);
+    vtkGeneralizedKernel* generalizedKernel = vtkGeneralizedKernel::SafeDownCast(this->Kernel);
+    if (generalizedKernel && HasDefaultComputeBasis(generalizedKernel))
+    {
+      BatchedProbePoints probe(this, generalizedKernel, input, inPD, outPD, mask);
+      probe.Execute(numPts);
+    }
+    else
+    {
+      ProbePoints probe(this, input, inPD, outPD, mask);
+      vtkSMPTools::For(0, numPts, probe);
+    }
   }
 
   // Clean up
@@ -29,6 +29,15 @@
 #include "vtkStaticPointLocator.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+// The volume is divided into blocks of BLOCK_SIZE^3 voxels, and the blocks
+// which are not within the radius of any input point are skipped.
+#define VTK_SIGNED_DISTANCE_BLOCK_SIZE 8
+
 vtkStandardNewMacro(vtkSignedDistance);
 vtkCxxSetObjectMacro(vtkSignedDistance, Locator, vtkAbstractPointLocator);
 
@@ -37,6 +46,77 @@ vtkCxxSetObjectMacro(vtkSignedDistance, Locator, vtkAbstractPointLocator);
 namespace
 {
 
+// Mark the blocks of voxels which may be within the radius of a point. Each
+// point marks the blocks covered by its range of voxels, which is enlarged
+// by one voxel on each side so that round-off can only add blocks, never
+// miss one. The points are processed in parallel; the marks are atomic
+// since several points may mark the same block.
+template <typename T>
+struct MarkBlocks
+{
+  const T* Pts;
+  const vtkIdType* Dims;
+  const vtkIdType* BlockDims;
+  const double* Origin;
+  const double* Spacing;
+  double Radius;
+  std::atomic<unsigned char>* Blocks;
+
+  void operator()(vtkIdType ptId, vtkIdType endPtId) const
+  {
+    for (; ptId < endPtId; ++ptId)
+    {
+      const T* p = this->Pts + 3 * ptId;
+      vtkIdType lo[3], hi[3];
+      bool outside = false;
+      for (int i = 0; i < 3 && !outside; ++i)
+      {
+        const double x = static_cast<double>(p[i]) - this->Origin[i];
+        lo[i] = static_cast<vtkIdType>(std::floor((x - this->Radius) / this->Spacing[i])) - 1;
+        hi[i] = static_cast<vtkIdType>(std::floor((x + this->Radius) / this->Spacing[i])) + 1;
+        outside = (hi[i] < 0 || lo[i] >= this->Dims[i]);
+        lo[i] = std::max<vtkIdType>(lo[i], 0) / VTK_SIGNED_DISTANCE_BLOCK_SIZE;
+        hi[i] = std::min<vtkIdType>(hi[i], this->Dims[i] - 1) / VTK_SIGNED_DISTANCE_BLOCK_SIZE;
+      }
+      if (outside)
+      {
+        continue;
+      }
+      for (vtkIdType k = lo[2]; k <= hi[2]; ++k)
+      {
+        for (vtkIdType j = lo[1]; j <= hi[1]; ++j)
+        {
+          std::atomic<unsigned char>* row =
+            this->Blocks + (k * this->BlockDims[1] + j) * this->BlockDims[0];
+          for (vtkIdType i = lo[0]; i <= hi[0]; ++i)
+          {
+            if (!row[i].load(std::memory_order_relaxed))
+            {
+              row[i].store(1, std::memory_order_relaxed);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  static void Execute(const T* pts, vtkIdType numPts, const vtkIdType dims[3],
+    const vtkIdType blockDims[3], const double origin[3], const double spacing[3], double radius,
+    std::vector<std::atomic<unsigned char>>& blocks)
+  {
+    if (spacing[0] <= 0.0 || spacing[1] <= 0.0 || spacing[2] <= 0.0)
+    {
+      for (std::atomic<unsigned char>& block : blocks)
+      {
+        block.store(1, std::memory_order_relaxed);
+      }
+      return;
+    }
+    MarkBlocks mark = { pts, dims, blockDims, origin, spacing, radius, blocks.data() };
+    vtkSMPTools::For(0, numPts, mark);
+  }
+};
+
 // The threaded core of the algorithm
 template <typename T>
 struct SignedDistance
@@ -49,6 +129,8 @@ struct SignedDistance
   double Radius;
   vtkAbstractPointLocator* Locator;
   float* Scalars;
+  vtkIdType BlockDims[3];
+  std::vector<std::atomic<unsigned char>> Blocks; // zero-initialized
 
   // Don't want to allocate these working arrays on every thread invocation,
   // so make them thread local.
@@ -67,7 +149,11 @@ struct SignedDistance
       this->Dims[i] = static_cast<vtkIdType>(dims[i]);
       this->Origin[i] = origin[i];
       this->Spacing[i] = spacing[i];
+      this->BlockDims[i] = (this->Dims[i] + VTK_SIGNED_DISTANCE_BLOCK_SIZE - 1) /
+        VTK_SIGNED_DISTANCE_BLOCK_SIZE;
     }
+    this->Blocks = std::vector<std::atomic<unsigned char>>(
+      this->BlockDims[0] * this->BlockDims[1] * this->BlockDims[2]);
   }
 
   // Just allocate a little bit of memory to get started.
@@ -90,6 +176,7 @@ struct SignedDistance
     vtkIdType* dims = this->Dims;
     vtkIdType ptId, jOffset, kOffset, sliceSize = dims[0] * dims[1];
     vtkIdList*& pIds = this->PIds.Local();
+    const vtkIdType* blockDims = this->BlockDims;
 
     for (; slice < sliceEnd; ++slice)
     {
@@ -100,9 +187,19 @@ struct SignedDistance
       {
         x[1] = origin[1] + j * spacing[1];
         jOffset = j * dims[0];
+        const std::atomic<unsigned char>* blocks = this->Blocks.data() +
+          ((slice / VTK_SIGNED_DISTANCE_BLOCK_SIZE) * blockDims[1] +
+            j / VTK_SIGNED_DISTANCE_BLOCK_SIZE) *
+            blockDims[0];
 
         for (vtkIdType i = 0; i < dims[0]; ++i)
         {
+          // Skip the blocks far from all of the points.
+          if (!blocks[i / VTK_SIGNED_DISTANCE_BLOCK_SIZE].load(std::memory_order_relaxed))
+          {
+            i += VTK_SIGNED_DISTANCE_BLOCK_SIZE - 1 - i % VTK_SIGNED_DISTANCE_BLOCK_SIZE;
+            continue;
+          }
           x[0] = origin[0] + i * spacing[0];
           ptId = i + jOffset + kOffset;
 
@@ -127,11 +224,13 @@ struct SignedDistance
 
   void Reduce() {}
 
-  static void Execute(vtkSignedDistance* self, T* pts, float* normals, int dims[3],
-    double origin[3], double spacing[3], float* scalars)
+  static void Execute(vtkSignedDistance* self, T* pts, vtkIdType numPts, float* normals,
+    int dims[3], double origin[3], double spacing[3], float* scalars)
   {
     SignedDistance dist(
       pts, normals, dims, origin, spacing, self->GetRadius(), self->GetLocator(), scalars);
+    MarkBlocks<T>::Execute(pts, numPts, dist.Dims, dist.BlockDims, dist.Origin, dist.Spacing,
+      dist.Radius, dist.Blocks);
     vtkSMPTools::For(0, dims[2], dist);
   }
 
@@ -271,8 +370,9 @@ void vtkSignedDistance::Append(vtkPolyData* input)
   void* inPtr = pts->GetVoidPointer(0);
   switch (pts->GetDataType())
   {
-    vtkTemplateMacro(SignedDistance<VTK_TT>::Execute(this, (VTK_TT*)inPtr, normals,
-      this->Dimensions, output->GetOrigin(), output->GetSpacing(), scalars));
+    vtkTemplateMacro(SignedDistance<VTK_TT>::Execute(this, (VTK_TT*)inPtr,
+      pts->GetNumberOfPoints(), normals, this->Dimensions, output->GetOrigin(),
+      output->GetSpacing(), scalars));
   }
 }
 
@@ -58,6 +58,9 @@
  * This class has been threaded with vtkSMPTools. Using TBB or other
  * non-sequential type (set in the CMake variable
  * VTK_SMP_IMPLEMENTATION_TYPE) may improve performance significantly.
+ * The blocks of voxels which are further than the radius from all of the
+ * input points are skipped without querying the locator, so sparse point
+ * clouds (e.g., scans of surfaces) in large volumes are processed quickly.
  *
  * @warning
  * Empty voxel values are set to -this->Radius.
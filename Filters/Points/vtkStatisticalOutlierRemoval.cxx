@@ -14,15 +14,25 @@
 =========================================================================*/
 #include "vtkStatisticalOutlierRemoval.h"
 
+#include "vtkAOSDataArrayTemplate.h"
 #include "vtkAbstractPointLocator.h"
+#include "vtkDoubleArray.h"
 #include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkMath.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointSet.h"
 #include "vtkPoints.h"
-#include "vtkSMPThreadLocalObject.h"
+#include "vtkSMPThreadLocal.h"
 #include "vtkSMPTools.h"
 #include "vtkStaticPointLocator.h"
+#include "vtkTypeTraits.h"
+
+#include <algorithm>
+
+// Number of points whose closest points are searched for at once
+#define VTK_SOR_BLOCK_SIZE 65536
 
 vtkStandardNewMacro(vtkStatisticalOutlierRemoval);
 vtkCxxSetObjectMacro(vtkStatisticalOutlierRemoval, Locator, vtkAbstractPointLocator);
@@ -33,7 +43,9 @@ namespace
 {
 
 //------------------------------------------------------------------------------
-// The threaded core of the algorithm (first pass)
+// The threaded core of the algorithm (first pass). The closest points are
+// obtained with the batched queries of the locator, by blocks of points to
+// bound the memory used by the results.
 template <typename T>
 struct ComputeMeanDistance
 {
@@ -43,9 +55,14 @@ struct ComputeMeanDistance
   float* Distance;
   double Mean;
 
-  // Don't want to allocate working arrays on every thread invocation. Thread local
-  // storage lots of new/delete.
-  vtkSMPThreadLocalObject<vtkIdList> PIds;
+  // The current block of points and the closest points (and their squared
+  // distances) of the points of the block
+  vtkIdType BlockBegin;
+  vtkNew<vtkIdTypeArray> Offsets;
+  vtkNew<vtkIdList> PIds;
+  vtkNew<vtkDoubleArray> Dist2;
+
+  // Accumulated over all of the blocks
   vtkSMPThreadLocal<double> ThreadMean;
   vtkSMPThreadLocal<vtkIdType> ThreadCount;
 
@@ -55,56 +72,36 @@ struct ComputeMeanDistance
     , SampleSize(size)
     , Distance(d)
     , Mean(0.0)
+    , BlockBegin(0)
+    , ThreadMean(0.0)
+    , ThreadCount(0)
   {
   }
 
-  // Just allocate a little bit of memory to get started.
-  void Initialize()
-  {
-    vtkIdList*& pIds = this->PIds.Local();
-    pIds->Allocate(128); // allocate some memory
-
-    double& threadMean = this->ThreadMean.Local();
-    threadMean = 0.0;
-
-    vtkIdType& threadCount = this->ThreadCount.Local();
-    threadCount = 0;
-  }
+  void Initialize() {}
 
-  // Compute average distance for each point, plus accumulate summation of
-  // mean distances and count (for averaging in the Reduce() method).
-  void operator()(vtkIdType ptId, vtkIdType endPtId)
+  // Compute average distance for each point of the block, plus accumulate
+  // summation of mean distances and count (for averaging in the Reduce()
+  // method).
+  void operator()(vtkIdType blockId, vtkIdType endBlockId)
   {
-    const T* px = this->Points + 3 * ptId;
-    const T* py;
-    double x[3], y[3];
-    vtkIdList*& pIds = this->PIds.Local();
+    const vtkIdType* offsets = this->Offsets->GetPointer(0);
+    const vtkIdType* pIds = this->PIds->GetPointer(0);
+    const double* dist2 = this->Dist2->GetPointer(0);
     double& threadMean = this->ThreadMean.Local();
     vtkIdType& threadCount = this->ThreadCount.Local();
 
-    for (; ptId < endPtId; ++ptId)
+    for (; blockId < endBlockId; ++blockId)
     {
-      x[0] = static_cast<double>(*px++);
-      x[1] = static_cast<double>(*px++);
-      x[2] = static_cast<double>(*px++);
-
-      // The method FindClosestNPoints will include the current point, so
-      // we increase the sample size by one.
-      this->Locator->FindClosestNPoints(this->SampleSize + 1, x, pIds);
-      vtkIdType numPts = pIds->GetNumberOfIds();
+      const vtkIdType ptId = this->BlockBegin + blockId;
+      const vtkIdType numPts = offsets[blockId + 1] - offsets[blockId];
 
       double sum = 0.0;
-      vtkIdType nei;
-      for (int sample = 0; sample < numPts; ++sample)
+      for (vtkIdType i = offsets[blockId]; i < offsets[blockId + 1]; ++i)
       {
-        nei = pIds->GetId(sample);
-        if (nei != ptId) // exclude ourselves
+        if (pIds[i] != ptId) // exclude ourselves
         {
-          py = this->Points + 3 * nei;
-          y[0] = static_cast<double>(*py++);
-          y[1] = static_cast<double>(*py++);
-          y[2] = static_cast<double>(*py);
-          sum += sqrt(vtkMath::Distance2BetweenPoints(x, y));
+          sum += sqrt(dist2[i]);
         }
       } // sum the lengths of all samples exclusing current point
 
@@ -150,7 +147,23 @@ struct ComputeMeanDistance
     vtkStatisticalOutlierRemoval* self, vtkIdType numPts, T* points, float* distances, double& mean)
   {
     ComputeMeanDistance compute(points, self->GetLocator(), self->GetSampleSize(), distances);
-    vtkSMPTools::For(0, numPts, compute);
+    vtkNew<vtkPoints> blockPoints;
+    blockPoints->SetDataType(vtkTypeTraits<T>::VTK_TYPE_ID);
+    vtkNew<vtkAOSDataArrayTemplate<T>> blockData;
+    blockData->SetNumberOfComponents(3);
+    for (; compute.BlockBegin < numPts; compute.BlockBegin += VTK_SOR_BLOCK_SIZE)
+    {
+      const vtkIdType blockSize =
+        std::min<vtkIdType>(VTK_SOR_BLOCK_SIZE, numPts - compute.BlockBegin);
+      blockData->SetArray(points + 3 * compute.BlockBegin, 3 * blockSize, 1);
+      blockPoints->SetData(blockData);
+
+      // The closest points include the current point, so we increase the
+      // sample size by one.
+      self->GetLocator()->FindClosestNPointsBatch(
+        self->GetSampleSize() + 1, blockPoints, compute.Offsets, compute.PIds, compute.Dist2);
+      vtkSMPTools::For(0, blockSize, compute);
+    }
     mean = compute.Mean;
   }
 
@@ -0,0 +1,64 @@
+#!/usr/bin/env python
+import sys
+
+import vtk
+from vtk.util.misc import vtkGetTempDir
+
+VTK_TEMP_DIR = vtkGetTempDir()
+
+# Generate Data
+source = vtk.vtkRTAnalyticSource()
+source.Update()
+image = source.GetOutput()
+blocks = vtk.vtkMultiBlockDataSet()
+blocks.SetBlock(0, image)
+blocks.SetBlock(1, image)
+
+# Initialize writer
+writer = vtk.vtkThreadedDataWriter()
+writer.SetMaxThreads(2)
+writer.SetMaxPendingWrites(2)
+writer.DeepCopyInputOn()
+
+completed = []
+def onEnd(obj, event, callData):
+    completed.append(callData.GetFileName())
+onEnd.CallDataType = vtk.VTK_OBJECT
+writer.AddObserver(vtk.vtkCommand.EndEvent, onEnd)
+
+# Write a few steps, cycling through writers that are not pending anymore
+fileNames = []
+imageWriters = [vtk.vtkXMLImageDataWriter() for i in range(3)]
+for i in range(10):
+    fileName = '%s/threaded-data-writer-%s.vti' % (VTK_TEMP_DIR, i)
+    fileNames.append(fileName)
+    stepWriter = imageWriters[i % len(imageWriters)]
+    stepWriter.SetFileName(fileName)
+    writer.Write(stepWriter, image)
+    if writer.GetNumberOfPendingWrites() > 2:
+        print('Too many pending writes')
+        sys.exit(1)
+
+# Any writer may be used, for instance with composite data
+fileName = '%s/threaded-data-writer-blocks.vtm' % VTK_TEMP_DIR
+fileNames.append(fileName)
+blocksWriter = vtk.vtkXMLMultiBlockDataWriter()
+blocksWriter.SetFileName(fileName)
+writer.Write(blocksWriter, blocks)
+
+# Wait for the work to be done
+writer.Finalize()
+
+if completed != fileNames:
+    print('Writes not reported in order: %s' % completed)
+    sys.exit(1)
+
+for fileName in fileNames[:10]:
+    reader = vtk.vtkXMLImageDataReader()
+    reader.SetFileName(fileName)
+    reader.Update()
+    if reader.GetOutput().GetNumberOfPoints() != image.GetNumberOfPoints():
+        print('Wrong number of points in %s' % fileName)
+        sys.exit(1)
+
+print("All good...")
@@ -0,0 +1,260 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkThreadedDataWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkThreadedDataWriter.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkCommand.h"
+#include "vtkDataObject.h"
+#include "vtkErrorCode.h"
+#include "vtkLogger.h"
+#include "vtkObjectFactory.h"
+#include "vtkSmartPointer.h"
+#include "vtkThreadedTaskQueue.h"
+
+#include <set>
+
+#define MAX_NUMBER_OF_THREADS_IN_POOL 32
+//****************************************************************************
+namespace
+{
+struct WriteResult
+{
+  vtkSmartPointer<vtkAlgorithm> Writer;
+  unsigned long ErrorCode = vtkErrorCode::NoError;
+};
+
+WriteResult WriteData(
+  const vtkSmartPointer<vtkAlgorithm>& writer, const vtkSmartPointer<vtkDataObject>& data)
+{
+  vtkLogF(TRACE, "writing: %s", writer->GetClassName());
+
+  WriteResult result;
+  result.Writer = writer;
+  writer->SetInputDataObject(data);
+
+  // always write, as vtkWriter::Write() and vtkXMLWriter::Write() do.
+  writer->Modified();
+  writer->Update();
+  result.ErrorCode = writer->GetErrorCode();
+
+  // release the snapshot as soon as it is written.
+  writer->SetInputDataObject(nullptr);
+  return result;
+}
+}
+
+//****************************************************************************
+class vtkThreadedDataWriter::vtkInternals
+{
+private:
+  using TaskQueueType = vtkThreadedTaskQueue<WriteResult, vtkSmartPointer<vtkAlgorithm>,
+    vtkSmartPointer<vtkDataObject>>;
+  std::unique_ptr<TaskQueueType> Queue;
+
+  // Writers pushed and not reported yet, only accessed by the caller thread.
+  std::set<vtkAlgorithm*> PendingWriters;
+
+public:
+  vtkInternals()
+    : Queue(nullptr)
+  {
+  }
+
+  ~vtkInternals() { this->TerminateAllWorkers(); }
+
+  bool HasWorkers() const { return this->Queue != nullptr; }
+
+  int GetNumberOfPendingWrites() const { return static_cast<int>(this->PendingWriters.size()); }
+
+  bool IsPending(vtkAlgorithm* writer) const
+  {
+    return this->PendingWriters.find(writer) != this->PendingWriters.end();
+  }
+
+  void TerminateAllWorkers()
+  {
+    if (this->Queue)
+    {
+      this->Queue->Flush();
+    }
+    this->Queue.reset(nullptr);
+    this->PendingWriters.clear();
+  }
+
+  void SpawnWorkers(vtkTypeUInt32 numberOfThreads)
+  {
+    this->Queue.reset(new TaskQueueType(::WriteData,
+      /*strict_ordering=*/true,
+      /*buffer_size=*/-1,
+      /*max_concurrent_tasks=*/static_cast<int>(numberOfThreads)));
+  }
+
+  void PushDataToQueue(
+    vtkSmartPointer<vtkAlgorithm>&& writer, vtkSmartPointer<vtkDataObject>&& data)
+  {
+    this->PendingWriters.insert(writer);
+    this->Queue->Push(std::move(writer), std::move(data));
+  }
+
+  // Results are popped in the order the writes were pushed.
+  bool PopResult(WriteResult& result, bool wait)
+  {
+    if (!this->Queue || this->PendingWriters.empty())
+    {
+      return false;
+    }
+    if (!(wait ? this->Queue->Pop(result) : this->Queue->TryPop(result)))
+    {
+      return false;
+    }
+    this->PendingWriters.erase(result.Writer);
+    return true;
+  }
+};
+
+vtkStandardNewMacro(vtkThreadedDataWriter);
+//------------------------------------------------------------------------------
+vtkThreadedDataWriter::vtkThreadedDataWriter()
+  : Internals(new vtkInternals())
+{
+  this->MaxThreads = 1;
+  this->MaxPendingWrites = 1;
+  this->DeepCopyInput = false;
+}
+
+//------------------------------------------------------------------------------
+vtkThreadedDataWriter::~vtkThreadedDataWriter()
+{
+  delete this->Internals;
+  this->Internals = nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::SetMaxThreads(vtkTypeUInt32 maxThreads)
+{
+  if (maxThreads <= MAX_NUMBER_OF_THREADS_IN_POOL && maxThreads > 0 &&
+    this->MaxThreads != maxThreads)
+  {
+    this->MaxThreads = maxThreads;
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::Initialize()
+{
+  // Report the pending writes and stop any started thread first
+  this->Flush();
+  this->Internals->TerminateAllWorkers();
+
+  this->Internals->SpawnWorkers(this->MaxThreads);
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::Write(vtkAlgorithm* writer, vtkDataObject* data)
+{
+  // Error checking
+  if (writer == nullptr || data == nullptr)
+  {
+    vtkErrorMacro(<< "Write:Please specify a writer and an input!");
+    return;
+  }
+  if (writer->GetNumberOfInputPorts() < 1)
+  {
+    vtkErrorMacro(<< "Write:" << writer->GetClassName() << " has no input port!");
+    return;
+  }
+
+  if (!this->Internals->HasWorkers())
+  {
+    this->Initialize();
+  }
+
+  // Report what is already written, then wait for the previous write of this
+  // writer and for the number of pending writes to go below the limit.
+  while (this->ReportWrite(false))
+  {
+  }
+  while ((this->Internals->IsPending(writer) ||
+           this->Internals->GetNumberOfPendingWrites() >= this->MaxPendingWrites) &&
+    this->ReportWrite(true))
+  {
+  }
+
+  // The snapshot shares the arrays of data unless DeepCopyInput is on, but
+  // not its structure, so that the caller may release or rebuild data.
+  vtkSmartPointer<vtkDataObject> snapshot;
+  snapshot.TakeReference(data->NewInstance());
+  if (this->DeepCopyInput)
+  {
+    snapshot->DeepCopy(data);
+  }
+  else
+  {
+    snapshot->ShallowCopy(data);
+  }
+  this->Internals->PushDataToQueue(vtkSmartPointer<vtkAlgorithm>(writer), std::move(snapshot));
+}
+
+//------------------------------------------------------------------------------
+bool vtkThreadedDataWriter::ReportWrite(bool wait)
+{
+  WriteResult result;
+  if (!this->Internals->PopResult(result, wait))
+  {
+    return false;
+  }
+
+  if (result.ErrorCode != vtkErrorCode::NoError)
+  {
+    vtkErrorMacro(<< "Error writing with " << result.Writer->GetClassName() << ": "
+                  << vtkErrorCode::GetStringFromErrorCode(result.ErrorCode));
+  }
+  this->InvokeEvent(vtkCommand::EndEvent, result.Writer.Get());
+  return true;
+}
+
+//------------------------------------------------------------------------------
+int vtkThreadedDataWriter::GetNumberOfPendingWrites()
+{
+  while (this->ReportWrite(false))
+  {
+  }
+  return this->Internals->GetNumberOfPendingWrites();
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::Flush()
+{
+  while (this->ReportWrite(true))
+  {
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::Finalize()
+{
+  this->Flush();
+  this->Internals->TerminateAllWorkers();
+}
+
+//------------------------------------------------------------------------------
+void vtkThreadedDataWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaxThreads: " << this->MaxThreads << endl;
+  os << indent << "MaxPendingWrites: " << this->MaxPendingWrites << endl;
+  os << indent << "DeepCopyInput: " << this->DeepCopyInput << endl;
+}
@@ -0,0 +1,132 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkThreadedDataWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class    vtkThreadedDataWriter
+ * @brief    run any writer in worker threads so that the caller does not
+ *           wait for serialization, compression and disk I/O.
+ *
+ * @details  A writer is any algorithm which writes its input when updated,
+ *           such as the vtkWriter and vtkXMLWriter subclasses. Write() takes
+ *           a snapshot of the data, a shallow copy by default or a deep copy
+ *           when DeepCopyInput is on, and hands it with the writer to a pool
+ *           of worker threads. At most MaxPendingWrites writes may be queued
+ *           or running: when this limit is reached, Write() waits for the
+ *           oldest one to complete. With the default of one pending write,
+ *           the caller can compute the next step while the previous one is
+ *           written, as with double buffering.
+ *
+ *           Completed writes are reported in the thread calling Write(),
+ *           GetNumberOfPendingWrites(), Flush() or Finalize(), in the order
+ *           they were pushed: an EndEvent is invoked with the writer as call
+ *           data, and an error is reported if the writer failed.
+ *
+ *           A writer must not be used nor modified by the caller until its
+ *           EndEvent was invoked; pushing the same writer again waits for its
+ *           previous write. A typical use cycles through a few writers or
+ *           creates one per output step.
+ *
+ * @sa vtkThreadedImageWriter
+ */
+
+#ifndef vtkThreadedDataWriter_h
+#define vtkThreadedDataWriter_h
+
+#include "vtkIOAsynchronousModule.h" // For export macro
+#include "vtkObject.h"
+
+class vtkDataObject;
+class vtkAlgorithm;
+
+class VTKIOASYNCHRONOUS_EXPORT vtkThreadedDataWriter : public vtkObject
+{
+public:
+  static vtkThreadedDataWriter* New();
+  vtkTypeMacro(vtkThreadedDataWriter, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /**
+   * Start a new pool of worker threads, after waiting for the pending writes.
+   * It is called by Write() if needed, and should be called again after any
+   * change on the thread count.
+   */
+  void Initialize();
+
+  /**
+   * Write a snapshot of data with the given writer in a worker thread. The
+   * writer input is set by the worker and released once written.
+   */
+  void Write(vtkAlgorithm* writer, vtkDataObject* data);
+
+  /**
+   * Define the number of worker threads to use.
+   * Initialize() needs to be called after any thread count change.
+   * Default is 1.
+   */
+  void SetMaxThreads(vtkTypeUInt32);
+  vtkGetMacro(MaxThreads, vtkTypeUInt32);
+
+  /**
+   * Maximum number of writes that may be queued or running. Write() waits
+   * for the oldest pending write when this number is reached. Default is 1.
+   */
+  vtkSetClampMacro(MaxPendingWrites, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaxPendingWrites, int);
+
+  /**
+   * When on, Write() deep copies the data, so that the caller may modify it
+   * in place right after. When off (the default), the data is shallow copied
+   * and its arrays must not be modified until the write completed.
+   */
+  vtkSetMacro(DeepCopyInput, bool);
+  vtkGetMacro(DeepCopyInput, bool);
+  vtkBooleanMacro(DeepCopyInput, bool);
+
+  /**
+   * Report the completed writes and return the number of writes that are
+   * still queued or running.
+   */
+  int GetNumberOfPendingWrites();
+
+  /**
+   * Wait for all the pending writes and report them.
+   */
+  void Flush();
+
+  /**
+   * Wait for all the pending writes, report them and terminate the worker
+   * threads.
+   */
+  void Finalize();
+
+protected:
+  vtkThreadedDataWriter();
+  ~vtkThreadedDataWriter() override;
+
+private:
+  vtkThreadedDataWriter(const vtkThreadedDataWriter&) = delete;
+  void operator=(const vtkThreadedDataWriter&) = delete;
+
+  // Report a completed write, waiting for it if wait is true. Returns false
+  // if there is no completed write.
+  bool ReportWrite(bool wait);
+
+  class vtkInternals;
+  vtkInternals* Internals;
+  vtkTypeUInt32 MaxThreads;
+  int MaxPendingWrites;
+  bool DeepCopyInput;
+};
+
+#endif
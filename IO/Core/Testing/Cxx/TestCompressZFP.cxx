@@ -0,0 +1,131 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestCompressZFP.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkZFPDataCompressor
+// .SECTION Description
+// Compress and uncompress floating-point data in the lossless and lossy
+// modes, and other data with the zlib fallback.
+
+#include "vtkNew.h"
+#include "vtkZFPDataCompressor.h"
+
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// Compress and uncompress the data, and return the compressed size, or 0.
+template <typename T>
+size_t RoundTrip(
+  vtkZFPDataCompressor* compressor, const std::vector<T>& values, std::vector<T>& result)
+{
+  const unsigned char* data = reinterpret_cast<const unsigned char*>(values.data());
+  size_t size = values.size() * sizeof(T);
+  std::vector<unsigned char> cbuffer(compressor->GetMaximumCompressionSpace(size));
+  size_t clen = compressor->Compress(data, size, cbuffer.data(), cbuffer.size());
+  if (clen == 0)
+  {
+    std::cerr << "Compression failed" << std::endl;
+    return 0;
+  }
+
+  // The uncompressing side does not know the data type.
+  vtkNew<vtkZFPDataCompressor> uncompressor;
+  result.assign(values.size(), T(0));
+  if (uncompressor->Uncompress(cbuffer.data(), clen, reinterpret_cast<unsigned char*>(result.data()),
+        size) != size)
+  {
+    std::cerr << "Uncompression failed" << std::endl;
+    return 0;
+  }
+  return clen;
+}
+}
+
+int TestCompressZFP(int, char*[])
+{
+  const size_t numValues = 10007;
+  std::vector<double> doubles(numValues);
+  std::vector<float> floats(numValues);
+  for (size_t i = 0; i < numValues; ++i)
+  {
+    doubles[i] = std::sin(i * 0.01) * 100.0;
+    floats[i] = static_cast<float>(doubles[i]);
+  }
+  std::vector<double> doublesResult;
+  std::vector<float> floatsResult;
+
+  vtkNew<vtkZFPDataCompressor> compressor;
+
+  // Lossless compression.
+  compressor->SetDataType(VTK_DOUBLE);
+  if (!RoundTrip(compressor.Get(), doubles, doublesResult) || doublesResult != doubles)
+  {
+    std::cerr << "Reversible compression of doubles changed the values" << std::endl;
+    return EXIT_FAILURE;
+  }
+  compressor->SetDataType(VTK_FLOAT);
+  if (!RoundTrip(compressor.Get(), floats, floatsResult) || floatsResult != floats)
+  {
+    std::cerr << "Reversible compression of floats changed the values" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Lossy compression, within the tolerance.
+  compressor->SetDataType(VTK_DOUBLE);
+  compressor->SetModeToFixedAccuracy();
+  compressor->SetTolerance(1e-3);
+  size_t clen = RoundTrip(compressor.Get(), doubles, doublesResult);
+  if (!clen || clen >= numValues * sizeof(double) / 2)
+  {
+    std::cerr << "Fixed accuracy compression is not effective: " << clen << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (size_t i = 0; i < numValues; ++i)
+  {
+    if (std::abs(doublesResult[i] - doubles[i]) > 1e-3)
+    {
+      std::cerr << "Error larger than the tolerance at " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Fixed rate compression, 8 bits per value.
+  compressor->SetModeToFixedRate();
+  compressor->SetRate(8);
+  clen = RoundTrip(compressor.Get(), doubles, doublesResult);
+  if (!clen || clen > numValues + 64)
+  {
+    std::cerr << "Unexpected size for fixed rate compression: " << clen << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Other data is compressed losslessly with zlib.
+  std::vector<unsigned char> bytes(numValues);
+  for (size_t i = 0; i < numValues; ++i)
+  {
+    bytes[i] = static_cast<unsigned char>(i % 7);
+  }
+  std::vector<unsigned char> bytesResult;
+  compressor->SetDataType(VTK_UNSIGNED_CHAR);
+  if (!RoundTrip(compressor.Get(), bytes, bytesResult) || bytesResult != bytes)
+  {
+    std::cerr << "Compression of bytes changed the values" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,284 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZFPDataCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkZFPDataCompressor.h"
+#include "vtkObjectFactory.h"
+#include "vtk_zfp.h"
+#include "vtk_zlib.h"
+
+#include <cstring>
+#include <vector>
+
+vtkStandardNewMacro(vtkZFPDataCompressor);
+
+//------------------------------------------------------------------------------
+namespace
+{
+// The first byte of the compressed data tells how it was compressed.
+enum BlockTypes
+{
+  ZLIB_BLOCK = 0,
+  ZFP_BLOCK = 1
+};
+
+// The ZFP bit streams are made of 64-bit words and must be aligned.
+typedef vtkTypeUInt64 StreamWord;
+
+// Find the ZFP type and the number of values of data of the given size.
+bool GetZFPField(int dataType, size_t size, zfp_type& type, size_t& numValues)
+{
+  size_t valueSize;
+  if (dataType == VTK_FLOAT)
+  {
+    type = zfp_type_float;
+    valueSize = sizeof(float);
+  }
+  else if (dataType == VTK_DOUBLE)
+  {
+    type = zfp_type_double;
+    valueSize = sizeof(double);
+  }
+  else
+  {
+    return false;
+  }
+  numValues = size / valueSize;
+  return size > 0 && size % valueSize == 0 && numValues <= VTK_UNSIGNED_INT_MAX;
+}
+
+size_t GetZLibCompressionSpace(size_t size)
+{
+  // ZLib specifies that destination buffer must be 0.1% larger + 12 bytes.
+  return size + (size + 999) / 1000 + 12;
+}
+
+// Open a ZFP stream using the compression mode of the compressor.
+zfp_stream* OpenStream(vtkZFPDataCompressor* self, zfp_type type)
+{
+  zfp_stream* zfp = zfp_stream_open(nullptr);
+  switch (self->GetMode())
+  {
+    case vtkZFPDataCompressor::FIXED_ACCURACY:
+      zfp_stream_set_accuracy(zfp, self->GetTolerance());
+      break;
+    case vtkZFPDataCompressor::FIXED_RATE:
+      zfp_stream_set_rate(zfp, self->GetRate(), type, 1, 0);
+      break;
+    case vtkZFPDataCompressor::FIXED_PRECISION:
+      zfp_stream_set_precision(zfp, static_cast<uint>(self->GetPrecision()));
+      break;
+    default:
+      zfp_stream_set_reversible(zfp);
+      break;
+  }
+  return zfp;
+}
+}
+
+//------------------------------------------------------------------------------
+vtkZFPDataCompressor::vtkZFPDataCompressor()
+{
+  this->CompressionLevel = Z_DEFAULT_COMPRESSION;
+  this->DataType = VTK_VOID;
+  this->Mode = REVERSIBLE;
+  this->Tolerance = 1e-6;
+  this->Rate = 16.0;
+  this->Precision = 32;
+}
+
+//------------------------------------------------------------------------------
+vtkZFPDataCompressor::~vtkZFPDataCompressor() = default;
+
+//------------------------------------------------------------------------------
+void vtkZFPDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "CompressionLevel: " << this->CompressionLevel << endl;
+  os << indent << "DataType: " << this->DataType << endl;
+  os << indent << "Mode: " << this->Mode << endl;
+  os << indent << "Tolerance: " << this->Tolerance << endl;
+  os << indent << "Rate: " << this->Rate << endl;
+  os << indent << "Precision: " << this->Precision << endl;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZFPDataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+  size_t uncompressedSize, unsigned char* compressedData, size_t compressionSpace)
+{
+  zfp_type type;
+  size_t numValues;
+  if (GetZFPField(this->DataType, uncompressedSize, type, numValues))
+  {
+    zfp_field* field = zfp_field_1d(
+      const_cast<unsigned char*>(uncompressedData), type, static_cast<uint>(numValues));
+    zfp_stream* zfp = OpenStream(this, type);
+
+    // Compress into an aligned buffer, after a header holding the
+    // compression mode and the type and number of values.
+    size_t maxSize = zfp_stream_maximum_size(zfp, field);
+    std::vector<StreamWord> buffer((maxSize + sizeof(StreamWord) - 1) / sizeof(StreamWord));
+    bitstream* stream = stream_open(buffer.data(), buffer.size() * sizeof(StreamWord));
+    zfp_stream_set_bit_stream(zfp, stream);
+    zfp_stream_rewind(zfp);
+    size_t size = 0;
+    if (zfp_write_header(zfp, field, ZFP_HEADER_FULL))
+    {
+      size = zfp_compress(zfp, field);
+    }
+
+    zfp_field_free(field);
+    zfp_stream_close(zfp);
+    stream_close(stream);
+
+    if (size == 0 || size + 1 > compressionSpace)
+    {
+      vtkErrorMacro("ZFP error while compressing data.");
+      return 0;
+    }
+    compressedData[0] = ZFP_BLOCK;
+    memcpy(compressedData + 1, buffer.data(), size);
+    return size + 1;
+  }
+
+  // Call zlib's compress function.
+  uLongf cs = static_cast<uLongf>(compressionSpace - 1);
+  compressedData[0] = ZLIB_BLOCK;
+  if (compress2(compressedData + 1, &cs, uncompressedData, static_cast<uLong>(uncompressedSize),
+        this->CompressionLevel) != Z_OK)
+  {
+    vtkErrorMacro("Zlib error while compressing data.");
+    return 0;
+  }
+  return static_cast<size_t>(cs) + 1;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZFPDataCompressor::UncompressBuffer(unsigned char const* compressedData,
+  size_t compressedSize, unsigned char* uncompressedData, size_t uncompressedSize)
+{
+  if (compressedSize < 1)
+  {
+    vtkErrorMacro("No compressed data.");
+    return 0;
+  }
+
+  if (compressedData[0] == ZLIB_BLOCK)
+  {
+    // Call zlib's uncompress function.
+    uLongf us = static_cast<uLongf>(uncompressedSize);
+    if (uncompress(uncompressedData, &us, compressedData + 1,
+          static_cast<uLong>(compressedSize - 1)) != Z_OK)
+    {
+      vtkErrorMacro("Zlib error while uncompressing data.");
+      return 0;
+    }
+    if (us != static_cast<uLongf>(uncompressedSize))
+    {
+      vtkErrorMacro("Decompression produced incorrect size.\n"
+                    "Expected "
+        << uncompressedSize << " and got " << us);
+      return 0;
+    }
+    return uncompressedSize;
+  }
+  else if (compressedData[0] != ZFP_BLOCK)
+  {
+    vtkErrorMacro("Unknown compressed data type " << static_cast<int>(compressedData[0]));
+    return 0;
+  }
+
+  // Copy the compressed data to an aligned buffer, with at least one
+  // extra word since the decoder reads whole words.
+  size_t size = compressedSize - 1;
+  std::vector<StreamWord> buffer(size / sizeof(StreamWord) + 2, 0);
+  memcpy(buffer.data(), compressedData + 1, size);
+  bitstream* stream = stream_open(buffer.data(), buffer.size() * sizeof(StreamWord));
+  zfp_stream* zfp = zfp_stream_open(stream);
+  zfp_field* field = zfp_field_alloc();
+  zfp_stream_rewind(zfp);
+
+  size_t result = 0;
+  if (!zfp_read_header(zfp, field, ZFP_HEADER_FULL))
+  {
+    vtkErrorMacro("Invalid ZFP header.");
+  }
+  else if (zfp_field_dimensionality(field) != 1 ||
+    zfp_field_size(field, nullptr) * zfp_type_size(field->type) != uncompressedSize)
+  {
+    vtkErrorMacro("Decompression produced incorrect size.\n"
+                  "Expected "
+      << uncompressedSize << " and got "
+      << zfp_field_size(field, nullptr) * zfp_type_size(field->type));
+  }
+  else
+  {
+    zfp_field_set_pointer(field, uncompressedData);
+    if (zfp_decompress(zfp, field))
+    {
+      result = uncompressedSize;
+    }
+    else
+    {
+      vtkErrorMacro("ZFP error while uncompressing data.");
+    }
+  }
+
+  zfp_field_free(field);
+  zfp_stream_close(zfp);
+  stream_close(stream);
+  return result;
+}
+
+//------------------------------------------------------------------------------
+int vtkZFPDataCompressor::GetCompressionLevel()
+{
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): returning CompressionLevel "
+                << this->CompressionLevel);
+  return this->CompressionLevel;
+}
+
+//------------------------------------------------------------------------------
+void vtkZFPDataCompressor::SetCompressionLevel(int compressionLevel)
+{
+  int min = 1;
+  int max = 9;
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting CompressionLevel to "
+                << compressionLevel);
+  if (this->CompressionLevel !=
+    (compressionLevel < min ? min : (compressionLevel > max ? max : compressionLevel)))
+  {
+    this->CompressionLevel =
+      (compressionLevel < min ? min : (compressionLevel > max ? max : compressionLevel));
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZFPDataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  // One byte for the type of block, then the zlib or ZFP data.
+  size_t space = GetZLibCompressionSpace(size);
+  zfp_type type;
+  size_t numValues;
+  if (GetZFPField(this->DataType, size, type, numValues))
+  {
+    zfp_field* field = zfp_field_1d(nullptr, type, static_cast<uint>(numValues));
+    zfp_stream* zfp = OpenStream(this, type);
+    space = zfp_stream_maximum_size(zfp, field);
+    zfp_field_free(field);
+    zfp_stream_close(zfp);
+  }
+  return space + 1;
+}
@@ -0,0 +1,152 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZFPDataCompressor.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkZFPDataCompressor
+ * @brief   Data compression of floating-point values using ZFP.
+ *
+ * vtkZFPDataCompressor provides a concrete vtkDataCompressor class using
+ * ZFP for compressing and uncompressing arrays of float or double values.
+ * Since a compressor only sees bytes, DataType must be set to the type of
+ * the values before compressing data (vtkXMLWriter does this for each
+ * array). Data of other types, or when DataType is not set, is compressed
+ * losslessly with zlib instead, so that any data can be compressed.
+ *
+ * ZFP is lossless in the REVERSIBLE mode (the default). The lossy
+ * FIXED_ACCURACY, FIXED_RATE and FIXED_PRECISION modes bound the absolute
+ * error (Tolerance), the number of compressed bits per value (Rate) or the
+ * number of uncompressed bits per value (Precision), and usually compress
+ * much better. The mode is stored with the compressed data, so the
+ * uncompressing side does not need any setting.
+ *
+ * @warning
+ * The values are compressed as a one dimensional sequence, so the
+ * correlation between the components of a tuple, or between neighboring
+ * points of a grid, is not exploited.
+ */
+
+#ifndef vtkZFPDataCompressor_h
+#define vtkZFPDataCompressor_h
+
+#include "vtkDataCompressor.h"
+#include "vtkIOCoreModule.h" // For export macro
+
+class VTKIOCORE_EXPORT vtkZFPDataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkZFPDataCompressor, vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  static vtkZFPDataCompressor* New();
+
+  /**
+   *  Get the maximum space that may be needed to store data of the
+   *  given uncompressed size after compression.  This is the minimum
+   *  size of the output buffer that can be passed to the four-argument
+   *  Compress method.
+   */
+  size_t GetMaximumCompressionSpace(size_t size) override;
+
+  //@{
+  /**
+   * Get/Set the compression level of the zlib compression used for the
+   * data which is not made of float or double values.
+   */
+  // Compression level getter required by vtkDataCompressor.
+  int GetCompressionLevel() override;
+
+  // Compression level setter required by vtkDataCompresor.
+  void SetCompressionLevel(int compressionLevel) override;
+  //@}
+
+  //@{
+  /**
+   * Set the type of the values of the data to compress (VTK_FLOAT or
+   * VTK_DOUBLE for ZFP compression). The default is VTK_VOID, which
+   * compresses the data with zlib.
+   */
+  vtkSetMacro(DataType, int);
+  vtkGetMacro(DataType, int);
+  //@}
+
+  enum Modes
+  {
+    REVERSIBLE = 0,
+    FIXED_ACCURACY,
+    FIXED_RATE,
+    FIXED_PRECISION
+  };
+
+  //@{
+  /**
+   * Set the ZFP compression mode. The default is REVERSIBLE (lossless).
+   */
+  vtkSetClampMacro(Mode, int, REVERSIBLE, FIXED_PRECISION);
+  vtkGetMacro(Mode, int);
+  void SetModeToReversible() { this->SetMode(REVERSIBLE); }
+  void SetModeToFixedAccuracy() { this->SetMode(FIXED_ACCURACY); }
+  void SetModeToFixedRate() { this->SetMode(FIXED_RATE); }
+  void SetModeToFixedPrecision() { this->SetMode(FIXED_PRECISION); }
+  //@}
+
+  //@{
+  /**
+   * Maximum absolute error of the values in the FIXED_ACCURACY mode.
+   * The default is 1e-6.
+   */
+  vtkSetClampMacro(Tolerance, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(Tolerance, double);
+  //@}
+
+  //@{
+  /**
+   * Number of compressed bits per value in the FIXED_RATE mode. The
+   * default is 16.
+   */
+  vtkSetClampMacro(Rate, double, 1.0, 64.0);
+  vtkGetMacro(Rate, double);
+  //@}
+
+  //@{
+  /**
+   * Number of uncompressed bits per value kept in the FIXED_PRECISION
+   * mode. The default is 32.
+   */
+  vtkSetClampMacro(Precision, int, 1, 64);
+  vtkGetMacro(Precision, int);
+  //@}
+
+protected:
+  vtkZFPDataCompressor();
+  ~vtkZFPDataCompressor() override;
+
+  int CompressionLevel;
+  int DataType;
+  int Mode;
+  double Tolerance;
+  double Rate;
+  int Precision;
+
+  // Compression method required by vtkDataCompressor.
+  size_t CompressBuffer(unsigned char const* uncompressedData, size_t uncompressedSize,
+    unsigned char* compressedData, size_t compressionSpace) override;
+  // Decompression method required by vtkDataCompressor.
+  size_t UncompressBuffer(unsigned char const* compressedData, size_t compressedSize,
+    unsigned char* uncompressedData, size_t uncompressedSize) override;
+
+private:
+  vtkZFPDataCompressor(const vtkZFPDataCompressor&) = delete;
+  void operator=(const vtkZFPDataCompressor&) = delete;
+};
+
+#endif
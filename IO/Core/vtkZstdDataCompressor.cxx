@@ -0,0 +1,104 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZstdDataCompressor.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkZstdDataCompressor.h"
+#include "vtkObjectFactory.h"
+
+#include <zstd.h>
+
+vtkStandardNewMacro(vtkZstdDataCompressor);
+
+//------------------------------------------------------------------------------
+vtkZstdDataCompressor::vtkZstdDataCompressor()
+{
+  this->CompressionLevel = 5;
+}
+
+//------------------------------------------------------------------------------
+vtkZstdDataCompressor::~vtkZstdDataCompressor() = default;
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "CompressionLevel: " << this->CompressionLevel << endl;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::CompressBuffer(unsigned char const* uncompressedData,
+  size_t uncompressedSize, unsigned char* compressedData, size_t compressionSpace)
+{
+  // Spread the levels 1..9 over the zstd levels 1..19.
+  const int level = 1 + ((this->CompressionLevel - 1) * 9) / 4;
+  size_t cs =
+    ZSTD_compress(compressedData, compressionSpace, uncompressedData, uncompressedSize, level);
+  if (ZSTD_isError(cs))
+  {
+    vtkErrorMacro("Zstd error while compressing data: " << ZSTD_getErrorName(cs));
+    return 0;
+  }
+  return cs;
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::UncompressBuffer(unsigned char const* compressedData,
+  size_t compressedSize, unsigned char* uncompressedData, size_t uncompressedSize)
+{
+  size_t us = ZSTD_decompress(uncompressedData, uncompressedSize, compressedData, compressedSize);
+  if (ZSTD_isError(us))
+  {
+    vtkErrorMacro("Zstd error while uncompressing data: " << ZSTD_getErrorName(us));
+    return 0;
+  }
+  // Make sure the output size matched that expected.
+  if (us != uncompressedSize)
+  {
+    vtkErrorMacro("Decompression produced incorrect size.\n"
+                  "Expected "
+      << uncompressedSize << " and got " << us);
+    return 0;
+  }
+  return us;
+}
+
+//------------------------------------------------------------------------------
+int vtkZstdDataCompressor::GetCompressionLevel()
+{
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): returning CompressionLevel "
+                << this->CompressionLevel);
+  return this->CompressionLevel;
+}
+
+//------------------------------------------------------------------------------
+void vtkZstdDataCompressor::SetCompressionLevel(int compressionLevel)
+{
+  int min = 1;
+  int max = 9;
+  vtkDebugMacro(<< this->GetClassName() << " (" << this << "): setting CompressionLevel to "
+                << compressionLevel);
+  if (this->CompressionLevel !=
+    (compressionLevel < min ? min : (compressionLevel > max ? max : compressionLevel)))
+  {
+    this->CompressionLevel =
+      (compressionLevel < min ? min : (compressionLevel > max ? max : compressionLevel));
+    this->Modified();
+  }
+}
+
+//------------------------------------------------------------------------------
+size_t vtkZstdDataCompressor::GetMaximumCompressionSpace(size_t size)
+{
+  return ZSTD_compressBound(size);
+}
@@ -0,0 +1,74 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkZstdDataCompressor.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkZstdDataCompressor
+ * @brief   Data compression using Zstandard.
+ *
+ * vtkZstdDataCompressor provides a concrete vtkDataCompressor class
+ * using zstd for compressing and uncompressing data. It is only built
+ * when VTK is configured with VTK_USE_ZSTD, against an external zstd
+ * library.
+ */
+
+#ifndef vtkZstdDataCompressor_h
+#define vtkZstdDataCompressor_h
+
+#include "vtkDataCompressor.h"
+#include "vtkIOCoreModule.h" // For export macro
+
+class VTKIOCORE_EXPORT vtkZstdDataCompressor : public vtkDataCompressor
+{
+public:
+  vtkTypeMacro(vtkZstdDataCompressor, vtkDataCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+  static vtkZstdDataCompressor* New();
+
+  /**
+   *  Get the maximum space that may be needed to store data of the
+   *  given uncompressed size after compression.  This is the minimum
+   *  size of the output buffer that can be passed to the four-argument
+   *  Compress method.
+   */
+  size_t GetMaximumCompressionSpace(size_t size) override;
+
+  /**
+   *  Get/Set the compression level, from 1 (fastest) to 9 (smallest).
+   *  The levels are spread over the zstd levels 1 to 19.
+   */
+  // Compression level getter required by vtkDataCompressor.
+  int GetCompressionLevel() override;
+
+  // Compression level setter required by vtkDataCompresor.
+  void SetCompressionLevel(int compressionLevel) override;
+
+protected:
+  vtkZstdDataCompressor();
+  ~vtkZstdDataCompressor() override;
+
+  int CompressionLevel;
+
+  // Compression method required by vtkDataCompressor.
+  size_t CompressBuffer(unsigned char const* uncompressedData, size_t uncompressedSize,
+    unsigned char* compressedData, size_t compressionSpace) override;
+  // Decompression method required by vtkDataCompressor.
+  size_t UncompressBuffer(unsigned char const* compressedData, size_t compressedSize,
+    unsigned char* uncompressedData, size_t uncompressedSize) override;
+
+private:
+  vtkZstdDataCompressor(const vtkZstdDataCompressor&) = delete;
+  void operator=(const vtkZstdDataCompressor&) = delete;
+};
+
+#endif
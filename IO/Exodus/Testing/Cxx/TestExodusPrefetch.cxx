@@ -0,0 +1,163 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestExodusPrefetch.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the time step prefetching of vtkExodusIIReader
+// .SECTION Description
+// Write a time varying data set, read its time steps forward and backward
+// with and without prefetching, and check that the outputs are the same and
+// that the prefetched arrays are found in the cache.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkExodusIIReader.h"
+#include "vtkExodusIIWriter.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+#include "vtkTimeSourceExample.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+// Flatten the point and cell arrays of the first element block.
+std::vector<double> GetValues(vtkExodusIIReader* reader)
+{
+  std::vector<double> values;
+  vtkMultiBlockDataSet* elementBlocks =
+    vtkMultiBlockDataSet::SafeDownCast(reader->GetOutput()->GetBlock(0));
+  vtkUnstructuredGrid* grid =
+    elementBlocks ? vtkUnstructuredGrid::SafeDownCast(elementBlocks->GetBlock(0)) : nullptr;
+  if (!grid)
+  {
+    return values;
+  }
+  vtkDataSetAttributes* attributes[2] = { grid->GetPointData(), grid->GetCellData() };
+  for (vtkDataSetAttributes* attribute : attributes)
+  {
+    for (int i = 0; i < attribute->GetNumberOfArrays(); ++i)
+    {
+      vtkDataArray* array = attribute->GetArray(i);
+      for (vtkIdType j = 0; j < array->GetNumberOfValues(); ++j)
+      {
+        values.push_back(array->GetComponent(j / array->GetNumberOfComponents(),
+          static_cast<int>(j % array->GetNumberOfComponents())));
+      }
+    }
+  }
+  return values;
+}
+
+// Read the given time steps and compare them with the expected values.
+// Return the number of cache misses, or -1 on error.
+vtkIdType ReadTimeSteps(const std::string& fileName, int prefetchTimeSteps, int policy,
+  const std::vector<int>& steps, std::vector<std::vector<double>>& values)
+{
+  vtkNew<vtkExodusIIReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetCacheSize(100);
+  reader->SetPrefetchTimeSteps(prefetchTimeSteps);
+  reader->SetPrefetchPolicy(policy);
+  reader->UpdateInformation();
+  reader->SetAllArrayStatus(vtkExodusIIReader::NODAL, 1);
+  reader->SetAllArrayStatus(vtkExodusIIReader::ELEM_BLOCK, 1);
+  for (int t : steps)
+  {
+    reader->SetTimeStep(t);
+    reader->Update();
+    std::vector<double> stepValues = GetValues(reader);
+    if (values[t].empty())
+    {
+      values[t] = stepValues;
+    }
+    if (stepValues.empty() || stepValues != values[t])
+    {
+      cerr << "Wrong values at time step " << t << " with policy " << policy << endl;
+      return -1;
+    }
+  }
+  return reader->GetNumberOfCacheMisses();
+}
+}
+
+int TestExodusPrefetch(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = std::string(tempDir) + "/TestExodusPrefetch.exo";
+  delete[] tempDir;
+
+  vtkNew<vtkTimeSourceExample> source;
+  vtkNew<vtkExodusIIWriter> writer;
+  writer->SetInputConnection(source->GetOutputPort());
+  writer->SetFileName(fileName.c_str());
+  writer->WriteAllTimeStepsOn();
+  writer->Write();
+
+  vtkNew<vtkExodusIIReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->UpdateInformation();
+  int numTimeSteps = reader->GetNumberOfTimeSteps();
+  if (numTimeSteps < 3)
+  {
+    cerr << "Expected several time steps, got " << numTimeSteps << endl;
+    return EXIT_FAILURE;
+  }
+  std::vector<int> forward;
+  std::vector<int> backward;
+  for (int t = 0; t < numTimeSteps; ++t)
+  {
+    forward.push_back(t);
+    backward.push_back(numTimeSteps - 1 - t);
+  }
+
+  // Read without prefetching first, to get the expected values.
+  std::vector<std::vector<double>> values(numTimeSteps);
+  vtkIdType forwardMisses = ReadTimeSteps(fileName, 0, 0, forward, values);
+  vtkIdType backwardMisses = ReadTimeSteps(fileName, 0, 0, backward, values);
+  if (forwardMisses < 0 || backwardMisses < 0)
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The result arrays of all the time steps but the first ones are prefetched.
+  struct
+  {
+    int Policy;
+    const std::vector<int>& Steps;
+    vtkIdType Misses;
+  } cases[4] = { { vtkExodusIIReader::PREFETCH_FORWARD, forward, forwardMisses },
+    { vtkExodusIIReader::PREFETCH_FOLLOW, forward, forwardMisses },
+    { vtkExodusIIReader::PREFETCH_BACKWARD, backward, backwardMisses },
+    { vtkExodusIIReader::PREFETCH_FOLLOW, backward, backwardMisses } };
+  for (const auto& c : cases)
+  {
+    vtkIdType misses = ReadTimeSteps(fileName, 2, c.Policy, c.Steps, values);
+    if (misses < 0)
+    {
+      return EXIT_FAILURE;
+    }
+    if (misses >= c.Misses)
+    {
+      cerr << "Prefetching with policy " << c.Policy << " did not fill the cache: " << misses
+           << " misses, versus " << c.Misses << " without prefetching" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -21,6 +21,7 @@
 #include "vtkCellData.h"
 #include "vtkDemandDrivenPipeline.h"
 #include "vtkDoubleArray.h"
+#include "vtkExodusIIIOMutex.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMultiBlockDataSet.h"
@@ -30,6 +31,8 @@
 
 #include "vtk_exodusII.h"
 
+#include <mutex>
+
 vtkStandardNewMacro(vtkCPExodusIIInSituReader);
 
 //------------------------------------------------------------------------------
@@ -95,6 +98,8 @@ int vtkCPExodusIIInSituReader::RequestData(
 
   bool success = false;
 
+  // Exodus is not thread safe, and vtkExodusIIReader may be reading ahead.
+  std::lock_guard<std::recursive_mutex> ioLock(vtkExodusIIIOMutex());
   if (!this->ExOpen())
   {
     return 0;
@@ -140,6 +145,7 @@ int vtkCPExodusIIInSituReader::RequestData(
 int vtkCPExodusIIInSituReader::RequestInformation(
   vtkInformation*, vtkInformationVector**, vtkInformationVector*)
 {
+  std::lock_guard<std::recursive_mutex> ioLock(vtkExodusIIIOMutex());
   if (!this->ExOpen())
   {
     return 0;
@@ -3,6 +3,11 @@
 #include "vtkDataArray.h"
 #include "vtkObjectFactory.h"
 
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
 // Define VTK_EXO_DBG_CACHE to print cache adds, drops, and replacements.
 //#undef VTK_EXO_DBG_CACHE
 
@@ -37,11 +42,15 @@ static void printCache( vtkExodusIICacheSet& cache, vtkExodusIICacheLRU& lru )
 vtkExodusIICacheEntry::vtkExodusIICacheEntry()
 {
   this->Value = nullptr;
+  this->Cost = 0.;
+  this->Priority = 0.;
 }
 
 vtkExodusIICacheEntry::vtkExodusIICacheEntry(vtkDataArray* arr)
 {
   this->Value = arr;
+  this->Cost = 0.;
+  this->Priority = 0.;
   if (arr)
     this->Value->Register(nullptr);
 }
@@ -54,6 +63,8 @@ vtkExodusIICacheEntry::~vtkExodusIICacheEntry()
 vtkExodusIICacheEntry::vtkExodusIICacheEntry(const vtkExodusIICacheEntry& other)
 {
   this->Value = other.Value;
+  this->Cost = other.Cost;
+  this->Priority = other.Priority;
   if (this->Value)
     this->Value->Register(nullptr);
 }
@@ -73,6 +84,9 @@ vtkExodusIICache::vtkExodusIICache()
 {
   this->Size = 0.;
   this->Capacity = 2.;
+  this->Inflation = 0.;
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
 }
 
 vtkExodusIICache::~vtkExodusIICache()
@@ -87,6 +101,9 @@ void vtkExodusIICache::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Size: " << this->Size << " MiB\n";
   os << indent << "Cache: " << &this->Cache << " (" << this->Cache.size() << ")\n";
   os << indent << "LRU: " << &this->LRU << "\n";
+  os << indent << "Inflation: " << this->Inflation << "\n";
+  os << indent << "NumberOfHits: " << this->NumberOfHits << "\n";
+  os << indent << "NumberOfMisses: " << this->NumberOfMisses << "\n";
 }
 
 void vtkExodusIICache::Clear()
@@ -111,9 +128,49 @@ void vtkExodusIICache::SetCacheCapacity(double sizeInMiB)
 int vtkExodusIICache::ReduceToSize(double newSize)
 {
   int deletedSomething = 0;
+
+  // Drop the entries with the lowest priority first, and the least recently used ones on ties.
+  // The priorities of the remaining entries do not change while dropping, so the candidates are
+  // ordered once in a heap. When emptying the cache, the LRU order is enough.
+  struct Candidate
+  {
+    double Priority;
+    size_t Age; // 0 for the least recently used entry
+    vtkExodusIICacheLRURef Entry;
+    bool operator<(const Candidate& other) const
+    {
+      // std::priority_queue pops the greatest element first.
+      return this->Priority > other.Priority ||
+        (this->Priority == other.Priority && this->Age > other.Age);
+    }
+  };
+  std::priority_queue<Candidate> candidates;
+  if (newSize > 0. && this->Size > newSize)
+  {
+    std::vector<Candidate> entries;
+    entries.reserve(this->LRU.size());
+    size_t age = 0;
+    for (vtkExodusIICacheLRURef lit = this->LRU.end(); lit != this->LRU.begin(); ++age)
+    {
+      --lit;
+      entries.push_back(Candidate{ (*lit)->second->Priority, age, lit });
+    }
+    candidates = std::priority_queue<Candidate>(std::less<Candidate>(), std::move(entries));
+  }
+
   while (this->Size > newSize && !this->LRU.empty())
   {
-    vtkExodusIICacheRef cit(this->LRU.back());
+    vtkExodusIICacheLRURef victim = --this->LRU.end();
+    if (newSize > 0.)
+    {
+      victim = candidates.top().Entry;
+      candidates.pop();
+    }
+    vtkExodusIICacheRef cit(*victim);
+    if (cit->second->Priority > this->Inflation)
+    {
+      this->Inflation = cit->second->Priority;
+    }
     vtkDataArray* arr = cit->second->Value;
     if (arr)
     {
@@ -140,7 +197,7 @@ int vtkExodusIICache::ReduceToSize(double newSize)
 
     delete cit->second;
     this->Cache.erase(cit);
-    this->LRU.pop_back();
+    this->LRU.erase(victim);
   }
 
   if (this->Cache.empty())
@@ -152,6 +209,11 @@ int vtkExodusIICache::ReduceToSize(double newSize)
 }
 
 void vtkExodusIICache::Insert(vtkExodusIICacheKey& key, vtkDataArray* value)
+{
+  this->Insert(key, value, 0.);
+}
+
+void vtkExodusIICache::Insert(vtkExodusIICacheKey& key, vtkDataArray* value, double cost)
 {
   double vsize = value ? value->GetActualMemorySize() / 1024. : 0.;
 
@@ -159,38 +221,31 @@ void vtkExodusIICache::Insert(vtkExodusIICacheKey& key, vtkDataArray* value)
   if (it != this->Cache.end())
   {
     if (it->second->Value == value)
-      return;
-
-    // Remove existing array and put in our new one.
-    this->Size -= vsize;
-    if (this->Size <= 0)
     {
-      this->RecomputeSize();
+      it->second->Cost = cost;
+      this->UpdatePriority(it->second);
+      return;
     }
-    this->ReduceToSize(this->Capacity - vsize);
-    it->second->Value->Delete();
-    it->second->Value = value;
-    it->second->Value->Register(
-      nullptr); // Since we re-use the cache entry, the constructor's Register won't get called.
-    this->Size += vsize;
+
+    // Remove the existing array before making space for our new one, so that the entry being
+    // replaced cannot be dropped while it is updated.
 #ifdef VTK_EXO_DBG_CACHE
     cout << "Replacing " << VTK_EXO_PRT_KEY(it->first) << VTK_EXO_PRT_ARR(value) << "\n";
 #endif // VTK_EXO_DBG_CACHE
-    this->LRU.erase(it->second->LRUEntry);
-    it->second->LRUEntry = this->LRU.insert(this->LRU.begin(), it);
+    this->Invalidate(key);
   }
-  else
-  {
-    this->ReduceToSize(this->Capacity - vsize);
-    std::pair<const vtkExodusIICacheKey, vtkExodusIICacheEntry*> entry(
-      key, new vtkExodusIICacheEntry(value));
-    std::pair<vtkExodusIICacheSet::iterator, bool> iret = this->Cache.insert(entry);
-    this->Size += vsize;
+
+  this->ReduceToSize(this->Capacity - vsize);
+  std::pair<const vtkExodusIICacheKey, vtkExodusIICacheEntry*> entry(
+    key, new vtkExodusIICacheEntry(value));
+  std::pair<vtkExodusIICacheSet::iterator, bool> iret = this->Cache.insert(entry);
+  this->Size += vsize;
+  iret.first->second->Cost = cost;
+  this->UpdatePriority(iret.first->second);
 #ifdef VTK_EXO_DBG_CACHE
-    cout << "Adding " << VTK_EXO_PRT_KEY(key) << VTK_EXO_PRT_ARR(value) << "\n";
+  cout << "Adding " << VTK_EXO_PRT_KEY(key) << VTK_EXO_PRT_ARR(value) << "\n";
 #endif // VTK_EXO_DBG_CACHE
-    iret.first->second->LRUEntry = this->LRU.insert(this->LRU.begin(), iret.first);
-  }
+  iret.first->second->LRUEntry = this->LRU.insert(this->LRU.begin(), iret.first);
   // printCache( this->Cache, this->LRU );
 }
 
@@ -201,15 +256,29 @@ vtkDataArray*& vtkExodusIICache::Find(const vtkExodusIICacheKey& key)
   vtkExodusIICacheRef it = this->Cache.find(key);
   if (it != this->Cache.end())
   {
+    ++this->NumberOfHits;
+    this->UpdatePriority(it->second);
     this->LRU.erase(it->second->LRUEntry);
     it->second->LRUEntry = this->LRU.insert(this->LRU.begin(), it);
     return it->second->Value;
   }
 
+  ++this->NumberOfMisses;
   dummy = nullptr;
   return dummy;
 }
 
+bool vtkExodusIICache::Contains(const vtkExodusIICacheKey& key) const
+{
+  return this->Cache.find(key) != this->Cache.end();
+}
+
+void vtkExodusIICache::ResetStatistics()
+{
+  this->NumberOfHits = 0;
+  this->NumberOfMisses = 0;
+}
+
 int vtkExodusIICache::Invalidate(const vtkExodusIICacheKey& key)
 {
   vtkExodusIICacheRef it = this->Cache.find(key);
@@ -289,3 +358,11 @@ void vtkExodusIICache::RecomputeSize()
     }
   }
 }
+
+void vtkExodusIICache::UpdatePriority(vtkExodusIICacheEntry* entry)
+{
+  // The cost is spread over the size in KiB, so that large arrays have to be
+  // proportionally more expensive to read to be kept as long as small ones.
+  double size = entry->Value ? static_cast<double>(entry->Value->GetActualMemorySize()) : 0.;
+  entry->Priority = this->Inflation + entry->Cost / (size > 1. ? size : 1.);
+}
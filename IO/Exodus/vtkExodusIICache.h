@@ -22,6 +22,15 @@
 // entries O(1). Each cache entry stores an iterator into
 // the list of references so that it can be located quickly for
 // removal.
+//
+// Entries may also be given the cost of reading them again (in seconds).
+// Eviction then follows the GreedyDual-Size policy: each entry has a priority
+// set to an inflation value plus its cost per KiB whenever it is inserted or
+// found, the entry with the lowest priority is dropped first and the
+// inflation value is raised to its priority. Arrays which are cheap to read
+// again for their size are thus dropped before expensive ones, while entries
+// not used for a long time eventually age out. Ties, and in particular
+// entries without a cost, are dropped in least-recently-used order.
 
 #include "vtkIOExodusModule.h" // For export macro
 #include "vtkObject.h"
@@ -113,6 +122,8 @@ public:
 protected:
   vtkDataArray* Value;
   vtkExodusIICacheLRURef LRUEntry;
+  double Cost;
+  double Priority;
 
   friend class vtkExodusIICache;
 };
@@ -145,11 +156,30 @@ public:
   /// Insert an entry into the cache (this can remove other cache entries to make space).
   void Insert(vtkExodusIICacheKey& key, vtkDataArray* value);
 
+  /** Insert an entry into the cache along with the time in seconds it took to read it.
+   * Entries which are cheaper to read again for their size are removed first.
+   */
+  void Insert(vtkExodusIICacheKey& key, vtkDataArray* value, double cost);
+
   /** Determine whether a cache entry exists. If it does, return it -- otherwise return nullptr.
    * If a cache entry exists, it is marked as most recently used.
    */
   vtkDataArray*& Find(const vtkExodusIICacheKey&);
 
+  /** Determine whether a cache entry exists without marking it as used nor counting it in
+   * the statistics.
+   */
+  bool Contains(const vtkExodusIICacheKey& key) const;
+
+  /// Number of calls to Find() which returned a cache entry.
+  vtkGetMacro(NumberOfHits, vtkIdType);
+
+  /// Number of calls to Find() which did not.
+  vtkGetMacro(NumberOfMisses, vtkIdType);
+
+  /// Reset the number of hits and misses.
+  void ResetStatistics();
+
   /** Invalidate a cache entry (drop it from the cache) if the key exists.
    * This does nothing if the cache entry does not exist.
    * Returns 1 if the cache entry existed prior to this call and 0 otherwise.
@@ -177,6 +207,16 @@ protected:
   /// Avoid (some) FP problems
   void RecomputeSize();
 
+  /// Update the priority of an entry which was just inserted or found.
+  void UpdatePriority(vtkExodusIICacheEntry* entry);
+
+  /// The inflation value of the GreedyDual-Size policy, i.e. the priority of the last entry
+  /// removed to make space.
+  double Inflation;
+
+  vtkIdType NumberOfHits;
+  vtkIdType NumberOfMisses;
+
   /// The capacity of the cache (i.e., the maximum size of all arrays it contains) in MiB.
   double Capacity;
 
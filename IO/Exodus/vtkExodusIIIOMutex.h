@@ -0,0 +1,28 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkExodusIIIOMutex.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#ifndef vtkExodusIIIOMutex_h
+#define vtkExodusIIIOMutex_h
+
+#include <mutex>
+
+// The Exodus, netCDF and HDF5 libraries are not thread safe, and
+// vtkExodusIIReader may read ahead in a background thread: the readers, their
+// prefetching threads and the writers of this module only call them while
+// holding this mutex.
+std::recursive_mutex& vtkExodusIIIOMutex();
+
+#endif
+// VTK-HeaderTest-Exclude: vtkExodusIIIOMutex.h
@@ -18,6 +18,7 @@
 ----------------------------------------------------------------------------*/
 #include "vtkExodusIIReader.h"
 #include "vtkExodusIICache.h"
+#include "vtkExodusIIIOMutex.h"
 
 #include "vtkCellArray.h"
 #include "vtkCellData.h"
@@ -52,8 +53,10 @@
 
 #include "vtksys/SystemTools.hxx"
 #include <algorithm>
+#include <chrono>
 #include <deque>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -134,6 +137,13 @@ extern "C"
   typedef int (*vtkExodusIIGetMapFunc)(int, int*);
 }
 
+// Shared by all the readers and writers of this module, see vtkExodusIIIOMutex.h
+std::recursive_mutex& vtkExodusIIIOMutex()
+{
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
 // --------------------------------------------------- PRIVATE CLASS DECLARATION
 #include "vtkExodusIIReaderPrivate.h"
 #include "vtkExodusIIReaderVariableCheck.h"
@@ -314,6 +324,12 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
   this->Cache = vtkExodusIICache::New();
   this->CacheSize = 0;
 
+  this->PrefetchTimeSteps = 0;
+  this->PrefetchPolicy = vtkExodusIIReader::PREFETCH_FORWARD;
+  this->PrefetchLastTimeStep = -1;
+  this->PrefetchDirection = 1;
+  this->PrefetchLimit = 0;
+
   this->HasModeShapes = 0;
   this->ModeShapeTime = -1.;
   this->AnimateModeShapes = 1;
@@ -344,6 +360,7 @@ vtkExodusIIReaderPrivate::vtkExodusIIReaderPrivate()
 //------------------------------------------------------------------------------
 vtkExodusIIReaderPrivate::~vtkExodusIIReaderPrivate()
 {
+  this->FinishPrefetch(false);
   this->CloseFile();
   this->Cache->Delete();
   this->CacheSize = 0;
@@ -1596,6 +1613,8 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
     return arr;
   }
 
+  // The time taken to read the array is its cost in the cache.
+  std::chrono::steady_clock::time_point readStart = std::chrono::steady_clock::now();
   int exoid = this->Exoid;
   int maxNameLength = this->Parent->GetMaxNameLength();
 
@@ -2886,7 +2905,8 @@ vtkDataArray* vtkExodusIIReaderPrivate::GetCacheOrRead(vtkExodusIICacheKey key)
   // GetCacheOrRead(), you better start running!
   if (arr)
   {
-    this->Cache->Insert(key, arr);
+    std::chrono::duration<double> cost = std::chrono::steady_clock::now() - readStart;
+    this->Cache->Insert(key, arr, cost.count());
     arr->FastDelete();
   }
   return arr;
@@ -3825,6 +3845,8 @@ void vtkExodusIIReaderPrivate::PrintData(ostream& os, vtkIndent indent)
 
   os << indent << "Array Cache:\n";
   this->Cache->PrintSelf(os, inden2);
+  os << indent << "PrefetchTimeSteps: " << this->PrefetchTimeSteps << "\n";
+  os << indent << "PrefetchPolicy: " << this->PrefetchPolicy << "\n";
 
   os << indent << "SqueezePoints: " << this->SqueezePoints << "\n";
   os << indent << "ApplyDisplacements: " << this->ApplyDisplacements << "\n";
@@ -3880,6 +3902,7 @@ int vtkExodusIIReaderPrivate::CloseFile()
 {
   if (this->Exoid >= 0)
   {
+    std::lock_guard<std::recursive_mutex> ioLock(vtkExodusIIIOMutex());
     VTK_EXO_FUNC(ex_close(this->Exoid), "Could not close an open file (" << this->Exoid << ")");
     this->Exoid = -1;
   }
@@ -4741,6 +4764,7 @@ int vtkExodusIIReaderPrivate::SetUpEmptyGrid(vtkMultiBlockDataSet* output)
 
 void vtkExodusIIReaderPrivate::Reset()
 {
+  this->FinishPrefetch(false);
   this->CloseFile();
   this->ResetCache(); // must come before BlockInfo and SetInfo are cleared.
   this->BlockInfo.clear();
@@ -4791,6 +4815,7 @@ void vtkExodusIIReaderPrivate::ResetCache()
   this->Cache->Clear();
   this->Cache->SetCacheCapacity(
     this->CacheSize); // FIXME: Perhaps Cache should have a Reset and a Clear method?
+  this->Cache->ResetStatistics();
   this->ClearConnectivityCaches();
 }
 
@@ -4804,6 +4829,261 @@ void vtkExodusIIReaderPrivate::SetCacheSize(double size)
   }
 }
 
+// ---------------------------------------------------------------- PREFETCHING
+namespace
+{
+// A result variable of one object at one time step, with all that is needed
+// to read it without accessing the reader.
+struct vtkExodusIIPrefetchJob
+{
+  vtkExodusIICacheKey Key;
+  vtkStdString Name;
+  int StorageType;
+  int NumberOfComponents;
+  vtkIdType NumberOfTuples;
+  ex_entity_id ObjectId;
+  std::vector<int> OriginalIndices;
+  int Ahead;
+};
+
+// Read a result variable the way GetCacheOrRead() does, or return nullptr.
+vtkDataArray* vtkExodusIIReadPrefetchJob(int exoid, const vtkExodusIIPrefetchJob& job)
+{
+  vtkDataArray* arr = vtkDataArray::CreateDataArray(job.StorageType);
+  arr->SetName(job.Name.c_str());
+  arr->SetNumberOfComponents(job.NumberOfComponents);
+  arr->SetNumberOfTuples(job.NumberOfTuples);
+  ex_entity_type type = static_cast<ex_entity_type>(job.Key.ObjectType);
+  int numVariables = static_cast<int>(job.OriginalIndices.size());
+  if (numVariables == 1 && job.NumberOfComponents == 1)
+  {
+    if (ex_get_var(exoid, job.Key.Time + 1, type, job.OriginalIndices[0], job.ObjectId,
+          job.NumberOfTuples, arr->GetVoidPointer(0)) < 0)
+    {
+      arr->Delete();
+      return nullptr;
+    }
+    return arr;
+  }
+
+  // Exodus doesn't support reading with a stride, so interleave the components.
+  std::vector<std::vector<double>> tmpVal(numVariables);
+  for (int c = 0; c < numVariables; ++c)
+  {
+    tmpVal[c].resize(job.NumberOfTuples + 1); // + 1 to avoid errors when N == 0.
+    if (ex_get_var(exoid, job.Key.Time + 1, type, job.OriginalIndices[c], job.ObjectId,
+          job.NumberOfTuples, &tmpVal[c][0]) < 0)
+    {
+      arr->Delete();
+      return nullptr;
+    }
+  }
+  // 2-D vectors are promoted to 3-D ones with a null last component.
+  std::vector<double> tmpTuple(job.NumberOfComponents, 0.);
+  for (vtkIdType t = 0; t < job.NumberOfTuples; ++t)
+  {
+    for (int c = 0; c < numVariables; ++c)
+    {
+      tmpTuple[c] = tmpVal[c][t];
+    }
+    arr->SetTuple(t, &tmpTuple[0]);
+  }
+  return arr;
+}
+}
+
+void vtkExodusIIReaderPrivate::StartPrefetch(vtkIdType timeStep)
+{
+  this->FinishPrefetch(true);
+
+  if (this->PrefetchPolicy == vtkExodusIIReader::PREFETCH_FORWARD)
+  {
+    this->PrefetchDirection = 1;
+  }
+  else if (this->PrefetchPolicy == vtkExodusIIReader::PREFETCH_BACKWARD)
+  {
+    this->PrefetchDirection = -1;
+  }
+  else if (this->PrefetchLastTimeStep >= 0 && timeStep != this->PrefetchLastTimeStep)
+  {
+    this->PrefetchDirection = timeStep > this->PrefetchLastTimeStep ? 1 : -1;
+  }
+  this->PrefetchLastTimeStep = timeStep;
+
+  // Mode shapes are not indexed by the time step, and without cache space
+  // prefetched arrays would be dropped right away.
+  const char* fileName = this->Parent->GetFileName();
+  int numTimeSteps = this->GetNumberOfTimeSteps();
+  if (this->PrefetchTimeSteps <= 0 || this->CacheSize <= 0. || this->HasModeShapes ||
+    !fileName || numTimeSteps < 2)
+  {
+    return;
+  }
+
+  // The displacements are read even when their array is disabled.
+  std::vector<ArrayInfoType>& nodalArrays = this->ArrayInfo[vtkExodusIIReader::NODAL];
+  int displacements = -1;
+  for (int i = 0; this->ApplyDisplacements && i < static_cast<int>(nodalArrays.size()); ++i)
+  {
+    std::string upperName = vtksys::SystemTools::UpperCase(nodalArrays[i].Name.substr(0, 3));
+    if (upperName == "DIS" && nodalArrays[i].Components == this->ModelParameters.num_dim)
+    {
+      displacements = i;
+      break;
+    }
+  }
+
+  // List the arrays RequestData() reads for each time step, nearest first.
+  std::vector<vtkExodusIIPrefetchJob> jobs;
+  vtkIdType step = timeStep;
+  int ahead = 0;
+  auto addJob = [&](int otyp, int obj, int aidx, const ArrayInfoType& ainfo, int id, int size) {
+    vtkExodusIICacheKey key(static_cast<int>(step), otyp, obj, aidx);
+    if (this->Cache->Contains(key))
+    {
+      return;
+    }
+    vtkExodusIIPrefetchJob job;
+    job.Key = key;
+    job.Name = ainfo.Name;
+    job.StorageType = ainfo.StorageType;
+    job.NumberOfComponents =
+      (ainfo.Components == 2 && this->ModelParameters.num_dim == 2) ? 3 : ainfo.Components;
+    job.NumberOfTuples = size;
+    job.ObjectId = id;
+    job.OriginalIndices.assign(
+      ainfo.OriginalIndices.begin(), ainfo.OriginalIndices.begin() + ainfo.Components);
+    job.Ahead = ahead;
+    jobs.push_back(job);
+  };
+  for (ahead = 1; ahead <= this->PrefetchTimeSteps; ++ahead)
+  {
+    step = timeStep + this->PrefetchDirection * ahead;
+    if (step < 0 || step >= numTimeSteps)
+    {
+      break;
+    }
+    for (int aidx = 0; aidx < static_cast<int>(nodalArrays.size()); ++aidx)
+    {
+      if (nodalArrays[aidx].Status || aidx == displacements)
+      {
+        addJob(vtkExodusIIReader::NODAL, 0, aidx, nodalArrays[aidx], 0,
+          static_cast<int>(this->ModelParameters.num_nodes));
+      }
+    }
+    // Blocks and sets come first in obj_types.
+    for (int otypidx = 0; otypidx < 8; ++otypidx)
+    {
+      int otyp = obj_types[otypidx];
+      std::map<int, std::vector<ArrayInfoType>>::iterator ami = this->ArrayInfo.find(otyp);
+      if (ami == this->ArrayInfo.end())
+      {
+        continue;
+      }
+      int numObj = this->GetNumberOfObjectsAtTypeIndex(otypidx);
+      for (int obj = 0; obj < numObj; ++obj)
+      {
+        ObjectInfoType* oinfop = this->GetObjectInfo(otypidx, obj);
+        if (!oinfop->Status)
+        {
+          continue;
+        }
+        for (int aidx = 0; aidx < static_cast<int>(ami->second.size()); ++aidx)
+        {
+          const ArrayInfoType& ainfo = ami->second[aidx];
+          if (ainfo.Status && ainfo.ObjectTruth[obj])
+          {
+            addJob(otyp, obj, aidx, ainfo, oinfop->Id, oinfop->Size);
+          }
+        }
+      }
+    }
+  }
+  if (jobs.empty())
+  {
+    return;
+  }
+
+  // The thread uses its own file handle, and stops reading once it has read
+  // as much as the cache holds.
+  this->PrefetchLimit = this->PrefetchTimeSteps;
+  double capacity = this->CacheSize;
+  int appWordSize = this->AppWordSize;
+  this->PrefetchThread = std::thread(
+    [this, capacity, appWordSize](
+      const std::string& name, const std::vector<vtkExodusIIPrefetchJob>& prefetchJobs) {
+      int exoid;
+      {
+        std::lock_guard<std::recursive_mutex> ioLock(vtkExodusIIIOMutex());
+        if (this->PrefetchLimit < 1)
+        {
+          return;
+        }
+        int cpuWordSize = appWordSize;
+        int ioWordSize = 0;
+        float version;
+        exoid = ex_open(name.c_str(), EX_READ, &cpuWordSize, &ioWordSize, &version);
+      }
+      if (exoid < 0)
+      {
+        return;
+      }
+
+      double size = 0.;
+      for (const vtkExodusIIPrefetchJob& job : prefetchJobs)
+      {
+        if (job.Ahead > this->PrefetchLimit || size >= capacity)
+        {
+          break;
+        }
+        std::lock_guard<std::recursive_mutex> ioLock(vtkExodusIIIOMutex());
+        if (job.Ahead > this->PrefetchLimit)
+        {
+          break;
+        }
+        std::chrono::steady_clock::time_point readStart = std::chrono::steady_clock::now();
+        vtkDataArray* arr = vtkExodusIIReadPrefetchJob(exoid, job);
+        if (arr)
+        {
+          std::chrono::duration<double> cost = std::chrono::steady_clock::now() - readStart;
+          PrefetchedArrayType& prefetched = this->PrefetchedArrays[job.Key];
+          prefetched.Array.TakeReference(arr);
+          prefetched.Cost = cost.count();
+          size += arr->GetActualMemorySize() / 1024.;
+        }
+      }
+
+      std::lock_guard<std::recursive_mutex> ioLock(vtkExodusIIIOMutex());
+      ex_close(exoid);
+    },
+    std::string(fileName), std::move(jobs));
+}
+
+void vtkExodusIIReaderPrivate::FinishPrefetch(bool keep, vtkIdType timeStep)
+{
+  if (this->PrefetchThread.joinable())
+  {
+    // Reading the requested time step in the thread is as fast as reading it
+    // here, so let the thread go on until it is read.
+    vtkIdType ahead = (timeStep - this->PrefetchLastTimeStep) * this->PrefetchDirection;
+    this->PrefetchLimit = (keep && timeStep >= 0 && ahead > 0 && ahead <= this->PrefetchLimit)
+      ? static_cast<int>(ahead)
+      : 0;
+    this->PrefetchThread.join();
+  }
+
+  if (keep)
+  {
+    std::map<vtkExodusIICacheKey, PrefetchedArrayType>::iterator it;
+    for (it = this->PrefetchedArrays.begin(); it != this->PrefetchedArrays.end(); ++it)
+    {
+      vtkExodusIICacheKey key = it->first;
+      this->Cache->Insert(key, it->second.Array, it->second.Cost);
+    }
+  }
+  this->PrefetchedArrays.clear();
+}
+
 bool vtkExodusIIReaderPrivate::IsXMLMetadataValid()
 {
   // Make sure that each block id referred to in the metadata arrays exist
@@ -5340,6 +5620,8 @@ int vtkExodusIIReader::CanReadFile(const char* fname)
   int diskWordSize = 8;
   float version;
 
+  // Other readers may be reading ahead in their prefetching thread.
+  std::lock_guard<std::recursive_mutex> ioLock(vtkExodusIIIOMutex());
   if ((exoid = ex_open(fname, EX_READ, &appWordSize, &diskWordSize, &version)) < 0)
   {
     return 0;
@@ -5461,6 +5743,9 @@ int vtkExodusIIReader::RequestInformation(vtkInformation* vtkNotUsed(request),
   // If the metadata is older than the filename
   if (this->GetMetadataMTime() < this->FileNameMTime)
   {
+    // Arrays read ahead do not match the new metadata.
+    this->Metadata->FinishPrefetch(false);
+    std::lock_guard<std::recursive_mutex> ioLock(vtkExodusIIIOMutex());
     if (this->Metadata->OpenFile(this->FileName))
     {
       // We need to initialize the XML parser before calling RequestInformation
@@ -5524,13 +5809,6 @@ int vtkExodusIIReader::RequestInformation(vtkInformation* vtkNotUsed(request),
 int vtkExodusIIReader::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
 {
-  if (!this->FileName || !this->Metadata->OpenFile(this->FileName))
-  {
-    vtkErrorMacro("Unable to open file \"" << (this->FileName ? this->FileName : "(null)")
-                                           << "\" to read data");
-    return 0;
-  }
-
   vtkInformation* outInfo = outputVector->GetInformationObject(0);
   vtkMultiBlockDataSet* output =
     vtkMultiBlockDataSet::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
@@ -5584,13 +5862,28 @@ int vtkExodusIIReader::RequestData(vtkInformation* vtkNotUsed(request),
     }
   }
 
+  // Use what was read ahead, then stop other threads from reading.
+  this->Metadata->FinishPrefetch(true, this->TimeStep);
+  std::unique_lock<std::recursive_mutex> ioLock(vtkExodusIIIOMutex());
+  if (!this->FileName || !this->Metadata->OpenFile(this->FileName))
+  {
+    vtkErrorMacro("Unable to open file \"" << (this->FileName ? this->FileName : "(null)")
+                                           << "\" to read data");
+    return 0;
+  }
+
   this->Metadata->RequestData(this->TimeStep, output);
+  ioLock.unlock();
+
+  // Read the next time steps while the output is processed.
+  this->Metadata->StartPrefetch(this->TimeStep);
 
   return 1;
 }
 
 int vtkExodusIIReader::GetMaxNameLength()
 {
+  std::lock_guard<std::recursive_mutex> ioLock(vtkExodusIIIOMutex());
   return ex_inquire_int(this->Metadata->Exoid, EX_INQ_DB_MAX_USED_NAME_LENGTH);
 }
 
@@ -6739,3 +7032,44 @@ void vtkExodusIIReader::ResetCache()
 {
   this->Metadata->ResetCache();
 }
+
+vtkIdType vtkExodusIIReader::GetNumberOfCacheHits()
+{
+  return this->Metadata->GetCache()->GetNumberOfHits();
+}
+
+vtkIdType vtkExodusIIReader::GetNumberOfCacheMisses()
+{
+  return this->Metadata->GetCache()->GetNumberOfMisses();
+}
+
+void vtkExodusIIReader::SetPrefetchTimeSteps(int n)
+{
+  n = n > 0 ? n : 0;
+  if (this->Metadata->GetPrefetchTimeSteps() != n)
+  {
+    this->Metadata->SetPrefetchTimeSteps(n);
+    this->Modified();
+  }
+}
+
+int vtkExodusIIReader::GetPrefetchTimeSteps()
+{
+  return this->Metadata->GetPrefetchTimeSteps();
+}
+
+void vtkExodusIIReader::SetPrefetchPolicy(int policy)
+{
+  policy = policy < PREFETCH_FORWARD ? PREFETCH_FORWARD
+                                     : (policy > PREFETCH_FOLLOW ? PREFETCH_FOLLOW : policy);
+  if (this->Metadata->GetPrefetchPolicy() != policy)
+  {
+    this->Metadata->SetPrefetchPolicy(policy);
+    this->Modified();
+  }
+}
+
+int vtkExodusIIReader::GetPrefetchPolicy()
+{
+  return this->Metadata->GetPrefetchPolicy();
+}
@@ -776,7 +776,7 @@ public:
   void ResetSettings();
 
   /**
-   * Clears out the cache entries.
+   * Clears out the cache entries and its statistics.
    */
   void ResetCache();
 
@@ -790,6 +790,52 @@ public:
    */
   double GetCacheSize();
 
+  //@{
+  /**
+   * Get the number of arrays found in the cache, and the number of arrays
+   * which had to be read from the file, since the cache was last reset.
+   */
+  vtkIdType GetNumberOfCacheHits();
+  vtkIdType GetNumberOfCacheMisses();
+  //@}
+
+  //@{
+  /**
+   * Set the number of time steps whose result variables are read in a
+   * background thread after each update, so that they are found in the cache
+   * when they are requested. Only the enabled arrays of the enabled blocks and
+   * sets are read ahead, and they count in the cache size, which must be large
+   * enough to hold them: nothing is read ahead while the cache size is 0.
+   * Since the Exodus and netCDF libraries are not thread safe, the background
+   * thread reads only while no vtkExodusIIReader reads metadata or data; it
+   * overlaps reading with the processing of the output. The next update waits
+   * for the thread when the requested time step is being read ahead, and stops
+   * it otherwise.
+   *
+   * By default, this is 0 and nothing is read ahead.
+   */
+  void SetPrefetchTimeSteps(int n);
+  int GetPrefetchTimeSteps();
+  //@}
+
+  enum PrefetchPolicyType
+  {
+    PREFETCH_FORWARD = 0,
+    PREFETCH_BACKWARD = 1,
+    PREFETCH_FOLLOW = 2
+  };
+
+  //@{
+  /**
+   * Set which time steps are read ahead: the ones following the requested
+   * time step (PREFETCH_FORWARD, the default), the ones preceding it
+   * (PREFETCH_BACKWARD), or the ones in the direction in which the requested
+   * time step last changed (PREFETCH_FOLLOW).
+   */
+  void SetPrefetchPolicy(int policy);
+  int GetPrefetchPolicy();
+  //@}
+
   //@{
   /**
    * Should the reader output only points used by elements in the output mesh,
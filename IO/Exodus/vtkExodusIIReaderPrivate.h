@@ -8,11 +8,14 @@
 
 #include "vtkExodusIICache.h"
 #include "vtkExodusIIReader.h"
+#include "vtkSmartPointer.h"
 #include "vtkStdString.h"
 #include "vtkToolkits.h" // make sure VTK_USE_PARALLEL is properly set
 #include "vtksys/RegularExpression.hxx"
 
+#include <atomic>
 #include <map>
+#include <thread>
 #include <vector>
 
 #include "vtkIOExodusModule.h" // For export macro
@@ -84,6 +87,28 @@ public:
   /// Get the size of the cache in MiB.
   vtkGetMacro(CacheSize, double);
 
+  /// Return the cache holding raw arrays.
+  vtkExodusIICache* GetCache() { return this->Cache; }
+
+  /// Set the number of time steps read ahead after RequestData().
+  void SetPrefetchTimeSteps(int n) { this->PrefetchTimeSteps = n > 0 ? n : 0; }
+  int GetPrefetchTimeSteps() { return this->PrefetchTimeSteps; }
+
+  /// Set which time steps are read ahead (one of vtkExodusIIReader::PrefetchPolicyType).
+  void SetPrefetchPolicy(int policy) { this->PrefetchPolicy = policy; }
+  int GetPrefetchPolicy() { return this->PrefetchPolicy; }
+
+  /** Start reading the result variables of the time steps following \a timeStep
+   * in a background thread. They are stored aside until FinishPrefetch() is called.
+   */
+  void StartPrefetch(vtkIdType timeStep);
+
+  /** Stop reading ahead, and insert the arrays read so far in the cache if \a keep
+   * is true or discard them otherwise. When \a timeStep is being read ahead, wait
+   * until its arrays are read first. This must be called before reading the file.
+   */
+  void FinishPrefetch(bool keep, vtkIdType timeStep = -1);
+
   /** Return the number of time steps in the open file.
    * You must have called RequestInformation() before
    * invoking this member function.
@@ -814,6 +839,27 @@ protected:
   /// The size of the cache in MiB.
   double CacheSize;
 
+  /// The number of time steps to read ahead and which ones.
+  int PrefetchTimeSteps;
+  int PrefetchPolicy;
+
+  /// The time step of the last call to StartPrefetch() and the direction it read ahead in.
+  vtkIdType PrefetchLastTimeStep;
+  int PrefetchDirection;
+
+  /// The thread reading ahead. It only accesses PrefetchedArrays and PrefetchLimit, the
+  /// number of time steps it may still read ahead.
+  std::thread PrefetchThread;
+  std::atomic<int> PrefetchLimit;
+
+  /// Arrays read ahead with the time it took to read them, until they are put in the cache.
+  struct PrefetchedArrayType
+  {
+    vtkSmartPointer<vtkDataArray> Array;
+    double Cost;
+  };
+  std::map<vtkExodusIICacheKey, PrefetchedArrayType> PrefetchedArrays;
+
   vtkTypeBool ApplyDisplacements;
   float DisplacementMagnitude;
   vtkTypeBool HasModeShapes;
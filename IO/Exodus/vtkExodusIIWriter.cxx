@@ -27,6 +27,7 @@
 #include "vtkDataObject.h"
 #include "vtkDataObjectTreeIterator.h"
 #include "vtkDoubleArray.h"
+#include "vtkExodusIIIOMutex.h"
 #include "vtkFieldData.h"
 #include "vtkFloatArray.h"
 #include "vtkIdList.h"
@@ -50,6 +51,7 @@
 #include <cctype>
 #include <ctime>
 #include <map>
+#include <mutex>
 #include <sstream>
 
 vtkObjectFactoryNewMacro(vtkExodusIIWriter);
@@ -219,24 +221,28 @@ int vtkExodusIIWriter::RequestData(vtkInformation* request, vtkInformationVector
     request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 1);
   }
 
-  this->WriteData();
-
-  this->CurrentTimeIndex++;
-  if (this->CurrentTimeIndex >= this->NumberOfTimeSteps || this->TopologyChanged)
   {
-    this->CloseExodusFile();
-    this->CurrentTimeIndex = 0;
-    if (this->WriteAllTimeSteps)
+    // Exodus is not thread safe, and the readers may be reading ahead.
+    std::lock_guard<std::recursive_mutex> ioLock(vtkExodusIIIOMutex());
+    this->WriteData();
+
+    this->CurrentTimeIndex++;
+    if (this->CurrentTimeIndex >= this->NumberOfTimeSteps || this->TopologyChanged)
+    {
+      this->CloseExodusFile();
+      this->CurrentTimeIndex = 0;
+      if (this->WriteAllTimeSteps)
+      {
+        // Tell the pipeline to stop looping.
+        request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 0);
+      }
+    }
+    // still close out the file after each step written.
+    if (!this->WriteAllTimeSteps)
     {
-      // Tell the pipeline to stop looping.
-      request->Set(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING(), 0);
+      this->CloseExodusFile();
     }
   }
-  // still close out the file after each step written.
-  if (!this->WriteAllTimeSteps)
-  {
-    this->CloseExodusFile();
-  }
 
   int localContinue = request->Get(vtkStreamingDemandDrivenPipeline::CONTINUE_EXECUTING());
   if (this->GlobalContinueExecuting(localContinue) != localContinue)
@@ -596,6 +602,7 @@ void vtkExodusIIWriter::CloseExodusFile()
 {
   if (this->fid >= 0)
   {
+    std::lock_guard<std::recursive_mutex> ioLock(vtkExodusIIIOMutex());
     ex_close(this->fid);
     this->fid = -1;
     return;
@@ -0,0 +1,278 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestHierarchicalBinsReaderWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write the output of vtkHierarchicalBinningFilter with
+// vtkHierarchicalBinsWriter, and read it back, in whole and in part, with
+// vtkHierarchicalBinsReader. Then check that corrupt copies of the file are
+// rejected.
+
+#include "vtkExecutive.h"
+#include "vtkFloatArray.h"
+#include "vtkHierarchicalBinningFilter.h"
+#include "vtkHierarchicalBinsReader.h"
+#include "vtkHierarchicalBinsWriter.h"
+#include "vtkIntArray.h"
+#include "vtkMinimalStandardRandomSequence.h"
+#include "vtkNew.h"
+#include "vtkPlanes.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestErrorObserver.h"
+#include "vtkTestUtilities.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Compare the points and point data of output with the points [begin,end)
+// of the binned points, starting at outputOffset.
+bool ComparePoints(vtkPolyData* output, vtkIdType outputOffset, vtkPolyData* binned,
+  vtkIdType begin, vtkIdType end)
+{
+  vtkDataArray* scalars = output->GetPointData()->GetArray("Scalars");
+  vtkDataArray* refScalars = binned->GetPointData()->GetArray("Scalars");
+  vtkDataArray* labels = output->GetPointData()->GetArray("Labels");
+  vtkDataArray* refLabels = binned->GetPointData()->GetArray("Labels");
+  if (!scalars || !labels || labels->GetNumberOfComponents() != 2)
+  {
+    std::cerr << "Missing point data" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = begin; i < end; ++i)
+  {
+    double x[3], y[3];
+    binned->GetPoint(i, x);
+    output->GetPoint(outputOffset + i - begin, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2] ||
+      scalars->GetTuple1(outputOffset + i - begin) != refScalars->GetTuple1(i) ||
+      labels->GetComponent(outputOffset + i - begin, 1) != refLabels->GetComponent(i, 1))
+    {
+      std::cerr << "Point " << i << " differs" << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Check the output of a partial read against the bins of the levels up to
+// maxLevel which intersect the bounds.
+bool CheckPartialRead(vtkPolyData* output, vtkHierarchicalBinningFilter* binning, int maxLevel,
+  const double bounds[6])
+{
+  vtkPolyData* binned = binning->GetOutput();
+  vtkIdType outputOffset = 0;
+  int globalBin = 0;
+  for (int level = 0; level <= maxLevel; ++level)
+  {
+    for (int bin = 0; bin < binning->GetNumberOfBins(level); ++bin, ++globalBin)
+    {
+      double b[6];
+      binning->GetLocalBinBounds(level, bin, b);
+      if (b[1] < bounds[0] || b[0] > bounds[1] || b[3] < bounds[2] || b[2] > bounds[3] ||
+        b[5] < bounds[4] || b[4] > bounds[5])
+      {
+        continue;
+      }
+      vtkIdType npts;
+      vtkIdType offset = binning->GetBinOffset(globalBin, npts);
+      if (!ComparePoints(output, outputOffset, binned, offset, offset + npts))
+      {
+        return false;
+      }
+      outputOffset += npts;
+    }
+  }
+  if (outputOffset != output->GetNumberOfPoints() || outputOffset == 0 ||
+    outputOffset == binned->GetNumberOfPoints())
+  {
+    std::cerr << "Read " << output->GetNumberOfPoints() << " points, expected " << outputOffset
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+
+template <typename T>
+void Overwrite(std::vector<char>& bytes, size_t position, T value)
+{
+  memcpy(bytes.data() + position, &value, sizeof(T));
+}
+
+// Write a corrupt copy of the file and check that reading it fails with an
+// error, and without output points.
+bool CheckCorruptFile(const std::string& filename, const std::vector<char>& bytes,
+  const char* description)
+{
+  {
+    std::ofstream os(filename, ios::out | ios::binary);
+    os.write(bytes.data(), bytes.size());
+  }
+  vtkNew<vtkTest::ErrorObserver> errorObserver;
+  vtkNew<vtkHierarchicalBinsReader> reader;
+  reader->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  reader->GetExecutive()->AddObserver(vtkCommand::ErrorEvent, errorObserver);
+  reader->SetFileName(filename.c_str());
+  reader->Update();
+  if (!errorObserver->GetError() || reader->GetOutput()->GetNumberOfPoints() != 0)
+  {
+    std::cerr << "The file with " << description << " was not rejected" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestHierarchicalBinsReaderWriter(int argc, char* argv[])
+{
+  char* temp_dir_c =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string filename = std::string(temp_dir_c) + "/TestHierarchicalBinsReaderWriter.bins";
+  delete[] temp_dir_c;
+
+  // A random point cloud, with point data.
+  const vtkIdType numPts = 50000;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(numPts);
+  vtkNew<vtkFloatArray> scalars;
+  scalars->SetName("Scalars");
+  scalars->SetNumberOfTuples(numPts);
+  vtkNew<vtkIntArray> labels;
+  labels->SetName("Labels");
+  labels->SetNumberOfComponents(2);
+  labels->SetNumberOfTuples(numPts);
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(3917);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    double x[3];
+    for (int j = 0; j < 3; ++j)
+    {
+      x[j] = random->GetRangeValue(-1.0, 1.0) * (j == 2 ? 0.25 : 1.0);
+      random->Next();
+    }
+    points->SetPoint(i, x);
+    scalars->SetValue(i, static_cast<float>(x[0] + x[1]));
+    labels->SetTypedComponent(i, 0, static_cast<int>(i % 7));
+    labels->SetTypedComponent(i, 1, static_cast<int>(i));
+  }
+  vtkNew<vtkPolyData> cloud;
+  cloud->SetPoints(points);
+  cloud->GetPointData()->AddArray(scalars);
+  cloud->GetPointData()->AddArray(labels);
+
+  vtkNew<vtkHierarchicalBinningFilter> binning;
+  binning->SetInputData(cloud);
+  binning->SetNumberOfLevels(4);
+  binning->Update();
+  vtkPolyData* binned = binning->GetOutput();
+
+  vtkNew<vtkHierarchicalBinsWriter> writer;
+  writer->SetInputData(binned);
+  writer->SetFileName(filename.c_str());
+  writer->Write();
+
+  // Read everything.
+  vtkNew<vtkHierarchicalBinsReader> reader;
+  reader->SetFileName(filename.c_str());
+  reader->Update();
+  if (reader->GetNumberOfLevels() != 4 || reader->GetOutput()->GetNumberOfPoints() != numPts ||
+    !ComparePoints(reader->GetOutput(), 0, binned, 0, numPts))
+  {
+    std::cerr << "Full read failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Read the first levels inside some bounds.
+  const double bounds[6] = { -0.3, 0.5, 0.1, 0.7, -1.0, 0.05 };
+  reader->SetMaximumLevel(2);
+  reader->LimitReadToBoundsOn();
+  reader->SetReadBounds(const_cast<double*>(bounds));
+  reader->Update();
+  if (!CheckPartialRead(reader->GetOutput(), binning, 2, bounds))
+  {
+    std::cerr << "Read within bounds failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The same region, described by planes.
+  vtkNew<vtkPlanes> frustum;
+  frustum->SetBounds(const_cast<double*>(bounds));
+  reader->LimitReadToBoundsOff();
+  reader->SetFrustum(frustum);
+  reader->Update();
+  if (!CheckPartialRead(reader->GetOutput(), binning, 2, bounds))
+  {
+    std::cerr << "Read within frustum failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Corrupt copies of the file. The header is made of the magic string, the
+  // version, the byte order and the number of levels (4 bytes each), the
+  // divisions (3 x 4 bytes), the bounds (6 doubles), the number of bins and
+  // of points (8 bytes each), the data type of the points, the number of
+  // arrays and their descriptions. The bin offsets follow.
+  std::vector<char> bytes;
+  {
+    std::ifstream is(filename, ios::in | ios::binary);
+    bytes.assign(std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>());
+  }
+  const size_t divisionsPosition = 20, numBinsPosition = 80, numPtsPosition = 88,
+               pointsTypePosition = 96, numArraysPosition = 100;
+  vtkTypeInt32 numArrays;
+  memcpy(&numArrays, bytes.data() + numArraysPosition, sizeof(numArrays));
+  size_t offsetsPosition = numArraysPosition + 4;
+  for (vtkTypeInt32 i = 0; i < numArrays; ++i)
+  {
+    vtkTypeInt32 nameLength;
+    memcpy(&nameLength, bytes.data() + offsetsPosition + 8, sizeof(nameLength));
+    offsetsPosition += 12 + nameLength;
+  }
+  const std::string corruptName = filename + ".corrupt";
+  std::vector<char> corrupt = bytes;
+  Overwrite<vtkTypeInt32>(corrupt, divisionsPosition + 4, 0);
+  bool success = CheckCorruptFile(corruptName, corrupt, "zero divisions");
+  corrupt = bytes;
+  Overwrite<vtkTypeInt32>(corrupt, pointsTypePosition, 1234);
+  success = CheckCorruptFile(corruptName, corrupt, "an invalid points type") && success;
+  corrupt = bytes;
+  Overwrite<vtkTypeInt64>(corrupt, numBinsPosition, static_cast<vtkTypeInt64>(1) << 60);
+  success = CheckCorruptFile(corruptName, corrupt, "a huge number of bins") && success;
+  corrupt = bytes;
+  Overwrite<vtkTypeInt64>(corrupt, numPtsPosition, -5);
+  success = CheckCorruptFile(corruptName, corrupt, "a negative number of points") && success;
+  corrupt = bytes;
+  Overwrite<vtkTypeInt64>(corrupt, numPtsPosition, 2 * numPts);
+  success = CheckCorruptFile(corruptName, corrupt, "too many points") && success;
+  corrupt = bytes;
+  Overwrite<vtkTypeInt32>(corrupt, numArraysPosition, 1 << 30);
+  success = CheckCorruptFile(corruptName, corrupt, "a huge number of arrays") && success;
+  corrupt = bytes;
+  Overwrite<vtkTypeInt64>(corrupt, offsetsPosition + 8, numPts + 1);
+  success = CheckCorruptFile(corruptName, corrupt, "decreasing offsets") && success;
+  corrupt.assign(bytes.begin(), bytes.end() - 1);
+  success = CheckCorruptFile(corruptName, corrupt, "missing points") && success;
+  if (!success)
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
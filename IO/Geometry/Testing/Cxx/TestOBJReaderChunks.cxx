@@ -0,0 +1,215 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOBJReaderChunks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of vtkOBJReader on a file parsed in several chunks
+// .SECTION Description
+// Write a grid of quads large enough to be split in several chunks, with
+// absolute and relative indices, groups, materials and continued lines, and
+// check the points, faces and attributes which are read.
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkFieldData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkOBJReader.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkStringArray.h"
+#include "vtkTestUtilities.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+const int NX = 400;
+const int NY = 250;
+
+// The values are exact in floats and in the file.
+void GetPoint(int i, int j, double x[3])
+{
+  x[0] = i * 0.5;
+  x[1] = j * 0.25;
+  x[2] = (i + j) % 7;
+}
+
+void GetNormal(int i, int j, double n[3])
+{
+  n[0] = i % 3;
+  n[1] = j % 3;
+  n[2] = 1.0;
+}
+
+void GetTCoord(int i, int j, double t[2])
+{
+  t[0] = i * 0.125;
+  t[1] = j * 0.0625;
+}
+
+// Each row of vertices is followed by the faces between it and the previous
+// row, which use relative indices on odd rows.
+bool WriteOBJ(const std::string& fileName)
+{
+  std::ofstream file(fileName.c_str());
+  file << "# A grid of quads\n# in several chunks\n";
+  for (int j = 0; j < NY; ++j)
+  {
+    for (int i = 0; i < NX; ++i)
+    {
+      double x[3], n[3], t[2];
+      GetPoint(i, j, x);
+      GetNormal(i, j, n);
+      GetTCoord(i, j, t);
+      file << "v " << x[0] << " " << x[1] << " " << x[2] << "\n";
+      file << "vt " << t[0] << " " << t[1] << "\n";
+      file << "vn " << n[0] << " " << n[1] << " " << n[2] << "\n";
+    }
+    if (j == 0)
+    {
+      continue;
+    }
+    file << "g row" << j << "\n";
+    file << "usemtl mat" << j % 2 << "\n";
+    for (int i = 0; i + 1 < NX; ++i)
+    {
+      const int ids[4] = { (j - 1) * NX + i, (j - 1) * NX + i + 1, j * NX + i + 1, j * NX + i };
+      file << "f";
+      for (int k = 0; k < 4; ++k)
+      {
+        const int id = (j % 2 ? ids[k] - (j + 1) * NX : ids[k] + 1);
+        file << " " << id << "/" << id << "/" << id;
+        if (k == 1 && i % 10 == 0)
+        {
+          file << " \\\n";
+        }
+      }
+      file << "\n";
+    }
+  }
+  return file.good();
+}
+}
+
+int TestOBJReaderChunks(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = std::string(tempDir) + "/TestOBJReaderChunks.obj";
+  delete[] tempDir;
+
+  if (!WriteOBJ(fileName))
+  {
+    std::cerr << "Cannot write " << fileName << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkOBJReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->Update();
+  vtkPolyData* output = reader->GetOutput();
+
+  if (std::string(reader->GetComment()) != "A grid of quads\nin several chunks")
+  {
+    std::cerr << "Wrong comment: " << reader->GetComment() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const vtkIdType numFaces = (NX - 1) * (NY - 1);
+  if (output->GetNumberOfPoints() != NX * NY || output->GetNumberOfPolys() != numFaces)
+  {
+    std::cerr << "Wrong number of points or faces: " << output->GetNumberOfPoints() << ", "
+              << output->GetNumberOfPolys() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkDataArray* normals = output->GetPointData()->GetNormals();
+  vtkDataArray* tcoords[2] = { output->GetPointData()->GetArray("mat0"),
+    output->GetPointData()->GetArray("mat1") };
+  if (!normals || !tcoords[0] || !tcoords[1])
+  {
+    std::cerr << "Missing normals or texture coordinates" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (int j = 0; j < NY; ++j)
+  {
+    for (int i = 0; i < NX; ++i)
+    {
+      const vtkIdType id = j * NX + i;
+      double x[3], n[3], y[3], m[3];
+      GetPoint(i, j, x);
+      GetNormal(i, j, n);
+      output->GetPoint(id, y);
+      normals->GetTuple(id, m);
+      if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2] || n[0] != m[0] || n[1] != m[1] ||
+        n[2] != m[2])
+      {
+        std::cerr << "Wrong point or normal " << id << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  vtkDataArray* groupIds = output->GetCellData()->GetArray("GroupIds");
+  vtkIntArray* materialIds =
+    vtkIntArray::SafeDownCast(output->GetCellData()->GetArray("MaterialIds"));
+  vtkStringArray* materialNames =
+    vtkStringArray::SafeDownCast(output->GetFieldData()->GetAbstractArray("MaterialNames"));
+  if (!groupIds || !materialIds || !materialNames || materialNames->GetNumberOfValues() != 2 ||
+    materialNames->GetValue(0) != "mat1" || materialNames->GetValue(1) != "mat0")
+  {
+    std::cerr << "Missing groups or materials" << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkIdType cellId = 0;
+  for (int j = 1; j < NY; ++j)
+  {
+    for (int i = 0; i + 1 < NX; ++i, ++cellId)
+    {
+      output->GetPolys()->GetCellAtId(cellId, npts, pts);
+      const vtkIdType ids[4] = { (j - 1) * NX + i, (j - 1) * NX + i + 1, j * NX + i + 1,
+        j * NX + i };
+      if (npts != 4 || pts[0] != ids[0] || pts[1] != ids[1] || pts[2] != ids[2] ||
+        pts[3] != ids[3])
+      {
+        std::cerr << "Wrong face " << cellId << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (groupIds->GetComponent(cellId, 0) != j - 1 || materialIds->GetValue(cellId) != 1 - j % 2)
+      {
+        std::cerr << "Wrong group or material of face " << cellId << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      // The texture coordinates are set in the array of the material.
+      for (int k = 0; k < 4; ++k)
+      {
+        double t[2], u[2];
+        GetTCoord(static_cast<int>(ids[k] % NX), static_cast<int>(ids[k] / NX), t);
+        tcoords[j % 2]->GetTuple(ids[k], u);
+        if (t[0] != u[0] || t[1] != u[1])
+        {
+          std::cerr << "Wrong texture coordinates of face " << cellId << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,266 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestOpenFOAMReaderPolyhedra.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the polyhedra and of the fields of vtkOpenFOAMReader
+// .SECTION Description
+// Write an ASCII case made of a hexahedron and of a polyhedron with split
+// faces, read its time steps with and without decomposing the polyhedra, and
+// check the cells, the face stream, the field values and that the static mesh
+// is reused. The fields are also read in batches of concurrently parsed files,
+// whatever the SMP backend, with and without a disabled field.
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDataArray.h"
+#include "vtkIdList.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkOpenFOAMReader.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtksys/SystemTools.hxx"
+
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Parses the field files of a time step two at a time.
+class vtkBatchedOpenFOAMReader : public vtkOpenFOAMReader
+{
+public:
+  static vtkBatchedOpenFOAMReader* New();
+  vtkTypeMacro(vtkBatchedOpenFOAMReader, vtkOpenFOAMReader);
+
+protected:
+  vtkBatchedOpenFOAMReader() { this->ConcurrentReads = 2; }
+  ~vtkBatchedOpenFOAMReader() override = default;
+};
+vtkStandardNewMacro(vtkBatchedOpenFOAMReader);
+
+// Point (i, j, k) of the 4 x 2 x 2 lattice.
+int P(int i, int j, int k)
+{
+  return i + 4 * (j + 2 * k);
+}
+
+void WriteFile(const std::string& dir, const std::string& object, const std::string& className,
+  const std::string& body)
+{
+  vtksys::SystemTools::MakeDirectory(dir);
+  std::ofstream file(dir + "/" + object);
+  file << "FoamFile\n{\n  version 2.0;\n  format ascii;\n  class " << className
+       << ";\n  object " << object << ";\n}\n\n"
+       << body;
+}
+
+std::string FaceList(const std::vector<std::vector<int>>& faces)
+{
+  std::string list = std::to_string(faces.size()) + "\n(\n";
+  for (const auto& face : faces)
+  {
+    list += std::to_string(face.size()) + "(";
+    for (size_t i = 0; i < face.size(); ++i)
+    {
+      list += (i ? " " : "") + std::to_string(face[i]);
+    }
+    list += ")\n";
+  }
+  return list + ")\n";
+}
+
+// Cell 0 is the unit cube, cell 1 spans two cubes along x and its y and z
+// sides are made of two faces each, so that it is a polyhedron of 10 faces.
+void WriteCase(const std::string& caseDir)
+{
+  const std::string meshDir = caseDir + "/constant/polyMesh";
+  std::string points = "16\n(\n";
+  for (int k = 0; k < 2; ++k)
+  {
+    for (int j = 0; j < 2; ++j)
+    {
+      for (int i = 0; i < 4; ++i)
+      {
+        points +=
+          "(" + std::to_string(i) + " " + std::to_string(j) + " " + std::to_string(k) + ")\n";
+      }
+    }
+  }
+  WriteFile(meshDir, "points", "vectorField", points + ")\n");
+
+  // the internal face first, then the boundary faces pointing outwards
+  std::vector<std::vector<int>> faces = { { P(1, 0, 0), P(1, 1, 0), P(1, 1, 1), P(1, 0, 1) },
+    { P(0, 0, 1), P(0, 1, 1), P(0, 1, 0), P(0, 0, 0) },
+    { P(3, 0, 0), P(3, 1, 0), P(3, 1, 1), P(3, 0, 1) } };
+  std::vector<int> owner = { 0, 0, 1 };
+  for (int i = 0; i < 3; ++i)
+  {
+    const int cell = (i == 0 ? 0 : 1);
+    faces.push_back({ P(i + 1, 0, 0), P(i + 1, 0, 1), P(i, 0, 1), P(i, 0, 0) });
+    faces.push_back({ P(i, 1, 0), P(i, 1, 1), P(i + 1, 1, 1), P(i + 1, 1, 0) });
+    faces.push_back({ P(i, 1, 0), P(i + 1, 1, 0), P(i + 1, 0, 0), P(i, 0, 0) });
+    faces.push_back({ P(i, 0, 1), P(i + 1, 0, 1), P(i + 1, 1, 1), P(i, 1, 1) });
+    owner.insert(owner.end(), 4, cell);
+  }
+  WriteFile(meshDir, "faces", "faceList", FaceList(faces));
+  std::string ownerList = std::to_string(owner.size()) + "\n(\n";
+  for (int cell : owner)
+  {
+    ownerList += std::to_string(cell) + "\n";
+  }
+  WriteFile(meshDir, "owner", "labelList", ownerList + ")\n");
+  WriteFile(meshDir, "neighbour", "labelList", "1\n(\n1\n)\n");
+  WriteFile(meshDir, "boundary", "polyBoundaryMesh",
+    "1\n(\n  walls\n  {\n    type wall;\n    nFaces 14;\n    startFace 1;\n  }\n)\n");
+
+  WriteFile(caseDir + "/system", "controlDict", "dictionary",
+    "startTime 0;\nendTime 1;\ndeltaT 1;\nwriteInterval 1;\n");
+  const char* times[2] = { "0", "1" };
+  for (const char* time : times)
+  {
+    const std::string timeDir = caseDir + "/" + time;
+    WriteFile(timeDir, "p", "volScalarField",
+      std::string("dimensions [0 2 -2 0 0 0 0];\n"
+                  "internalField nonuniform List<scalar> 2(") +
+        time + ".1234567890123456789 -25e-1);\n" +
+        "boundaryField\n{\n  walls\n  {\n    type zeroGradient;\n  }\n}\n");
+    WriteFile(timeDir, "U", "volVectorField",
+      std::string("dimensions [0 1 -1 0 0 0 0];\n"
+                  "internalField uniform (1 ") +
+        time + " 3);\n" +
+        "boundaryField\n{\n  walls\n  {\n    type fixedValue;\n    value uniform (0 0 0);\n"
+        "  }\n}\n");
+  }
+  std::ofstream(caseDir + "/case.foam");
+}
+
+vtkUnstructuredGrid* GetInternalMesh(vtkOpenFOAMReader* reader)
+{
+  return vtkUnstructuredGrid::SafeDownCast(reader->GetOutput()->GetBlock(0));
+}
+
+bool CheckFields(vtkUnstructuredGrid* mesh, double time)
+{
+  vtkDataArray* p = mesh->GetCellData()->GetArray("p");
+  vtkDataArray* u = mesh->GetCellData()->GetArray("U");
+  if (!p || !u || u->GetNumberOfComponents() != 3)
+  {
+    cerr << "Missing fields at time " << time << endl;
+    return false;
+  }
+  // the decomposed cells of the polyhedron get its values
+  for (vtkIdType i = 0; i < mesh->GetNumberOfCells(); ++i)
+  {
+    const double expected = (i == 0 ? time + 0.1234567890123456789 : -2.5);
+    if (std::abs(p->GetComponent(i, 0) - expected) > 1e-6 || u->GetComponent(i, 0) != 1.0 ||
+      u->GetComponent(i, 1) != time || u->GetComponent(i, 2) != 3.0)
+    {
+      cerr << "Wrong field values of cell " << i << " at time " << time << endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestOpenFOAMReaderPolyhedra(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string caseDir = std::string(tempDir) + "/TestOpenFOAMReaderPolyhedra";
+  delete[] tempDir;
+  WriteCase(caseDir);
+
+  for (int decompose = 0; decompose < 2; ++decompose)
+  {
+    vtkNew<vtkOpenFOAMReader> reader;
+    reader->SetFileName((caseDir + "/case.foam").c_str());
+    reader->SetDecomposePolyhedra(decompose);
+    reader->UpdateInformation();
+    reader->EnableAllCellArrays();
+
+    reader->UpdateTimeStep(0.0);
+    vtkUnstructuredGrid* mesh = GetInternalMesh(reader);
+    if (!mesh || !CheckFields(mesh, 0.0))
+    {
+      return EXIT_FAILURE;
+    }
+    vtkPoints* points = mesh->GetPoints();
+
+    if (!decompose)
+    {
+      vtkNew<vtkIdList> faceStream;
+      if (mesh->GetNumberOfCells() != 2 || mesh->GetCellType(0) != VTK_HEXAHEDRON ||
+        mesh->GetCellType(1) != VTK_POLYHEDRON || mesh->GetCell(1)->GetNumberOfPoints() != 12)
+      {
+        cerr << "Wrong cells without decomposition" << endl;
+        return EXIT_FAILURE;
+      }
+      mesh->GetFaceStream(1, faceStream);
+      if (faceStream->GetNumberOfIds() != 1 + 10 * 5 || faceStream->GetId(0) != 10)
+      {
+        cerr << "Wrong face stream of the polyhedron" << endl;
+        return EXIT_FAILURE;
+      }
+    }
+    else if (mesh->GetNumberOfCells() <= 2 || mesh->GetNumberOfPoints() != 17)
+    {
+      cerr << "The polyhedron was not decomposed" << endl;
+      return EXIT_FAILURE;
+    }
+
+    // the mesh is static, only the fields are read again
+    reader->UpdateTimeStep(1.0);
+    mesh = GetInternalMesh(reader);
+    if (!mesh || !CheckFields(mesh, 1.0))
+    {
+      return EXIT_FAILURE;
+    }
+    if (mesh->GetPoints() != points)
+    {
+      cerr << "The static mesh was not reused" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  vtkNew<vtkBatchedOpenFOAMReader> batched;
+  batched->SetFileName((caseDir + "/case.foam").c_str());
+  batched->UpdateInformation();
+  batched->EnableAllCellArrays();
+  for (double time = 0.0; time <= 1.0; time += 1.0)
+  {
+    batched->UpdateTimeStep(time);
+    vtkUnstructuredGrid* mesh = GetInternalMesh(batched);
+    if (!mesh || !CheckFields(mesh, time))
+    {
+      cerr << "Wrong batched read" << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // a disabled field is skipped by the batch and not read afterwards
+  batched->SetCellArrayStatus("U", 0);
+  batched->UpdateTimeStep(0.0);
+  vtkUnstructuredGrid* mesh = GetInternalMesh(batched);
+  if (!mesh || !mesh->GetCellData()->GetArray("p") || mesh->GetCellData()->GetArray("U"))
+  {
+    cerr << "Wrong batched read with a disabled field" << endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,174 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestSTLReaderMerging.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the binary vtkSTLReader
+// .SECTION Description
+// Read a binary file made of several blocks of facets, with and without
+// merging of the points, and check the points and triangles against the
+// facets and against the points merged one by one.
+
+#include "vtkCellArray.h"
+#include "vtkMergePoints.h"
+#include "vtkNew.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSTLReader.h"
+#include "vtkSTLWriter.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+bool SamePolyData(vtkPolyData* expected, vtkPolyData* actual)
+{
+  if (expected->GetNumberOfPoints() != actual->GetNumberOfPoints() ||
+    expected->GetNumberOfPolys() != actual->GetNumberOfPolys())
+  {
+    std::cerr << "Wrong number of points or triangles: " << actual->GetNumberOfPoints() << ", "
+              << actual->GetNumberOfPolys() << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfPoints(); ++i)
+  {
+    double x[3], y[3];
+    expected->GetPoint(i, x);
+    actual->GetPoint(i, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+    {
+      std::cerr << "Wrong point " << i << std::endl;
+      return false;
+    }
+  }
+  vtkIdType npts1, npts2;
+  const vtkIdType *pts1, *pts2;
+  for (vtkIdType i = 0; i < expected->GetNumberOfPolys(); ++i)
+  {
+    expected->GetCellPoints(i, npts1, pts1);
+    actual->GetCellPoints(i, npts2, pts2);
+    if (npts1 != 3 || npts2 != 3 || pts1[0] != pts2[0] || pts1[1] != pts2[1] ||
+      pts1[2] != pts2[2])
+    {
+      std::cerr << "Wrong triangle " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestSTLReaderMerging(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = std::string(tempDir) + "/TestSTLReaderMerging.stl";
+  delete[] tempDir;
+
+  // A sphere with a degenerate triangle, which is removed when merging.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(300);
+  sphere->SetPhiResolution(200);
+  sphere->Update();
+  vtkNew<vtkPolyData> mesh;
+  mesh->DeepCopy(sphere->GetOutput());
+  vtkIdType degenerate[3] = { 0, 0, 5 };
+  mesh->GetPolys()->InsertNextCell(3, degenerate);
+
+  vtkNew<vtkSTLWriter> writer;
+  writer->SetInputData(mesh);
+  writer->SetFileTypeToBinary();
+  writer->SetFileName(fileName.c_str());
+  if (!writer->Write())
+  {
+    std::cerr << "Cannot write " << fileName << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Without merging, each facet has its own points.
+  vtkNew<vtkSTLReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->MergingOff();
+  reader->Update();
+  vtkPolyData* facets = reader->GetOutput();
+  const vtkIdType numFacets = mesh->GetNumberOfPolys();
+  if (facets->GetNumberOfPolys() != numFacets || facets->GetNumberOfPoints() != 3 * numFacets)
+  {
+    std::cerr << "Wrong number of facets: " << facets->GetNumberOfPolys() << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkIdType npts;
+  const vtkIdType* pts;
+  vtkIdType cellId = 0;
+  for (mesh->GetPolys()->InitTraversal(); mesh->GetPolys()->GetNextCell(npts, pts); ++cellId)
+  {
+    for (vtkIdType i = 0; i < npts; ++i)
+    {
+      double x[3], y[3];
+      mesh->GetPoint(pts[i], x);
+      facets->GetPoint(3 * cellId + i, y);
+      for (int j = 0; j < 3; ++j)
+      {
+        if (static_cast<float>(x[j]) != y[j])
+        {
+          std::cerr << "Wrong point " << i << " of facet " << cellId << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  // The points merged one by one.
+  vtkNew<vtkPolyData> expected;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> polys;
+  vtkNew<vtkMergePoints> merger;
+  merger->InitPointInsertion(points, facets->GetBounds());
+  for (cellId = 0; cellId < numFacets; ++cellId)
+  {
+    vtkIdType nodes[3];
+    for (int i = 0; i < 3; ++i)
+    {
+      merger->InsertUniquePoint(facets->GetPoint(3 * cellId + i), nodes[i]);
+    }
+    if (nodes[0] != nodes[1] && nodes[0] != nodes[2] && nodes[1] != nodes[2])
+    {
+      polys->InsertNextCell(3, nodes);
+    }
+  }
+  expected->SetPoints(points);
+  expected->SetPolys(polys);
+
+  // With the default locator and with a given one.
+  for (int i = 0; i < 2; ++i)
+  {
+    vtkNew<vtkSTLReader> mergingReader;
+    mergingReader->SetFileName(fileName.c_str());
+    if (i)
+    {
+      vtkNew<vtkMergePoints> locator;
+      mergingReader->SetLocator(locator);
+    }
+    mergingReader->Update();
+    if (!SamePolyData(expected, mergingReader->GetOutput()))
+    {
+      std::cerr << "The points were not merged correctly" << (i ? " with a locator" : "")
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,625 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHierarchicalBinsReader.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkHierarchicalBinsReader.h"
+
+#include "vtkDataArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPlane.h"
+#include "vtkPlanes.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
+#include "vtksys/FStream.hxx"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+vtkStandardNewMacro(vtkHierarchicalBinsReader);
+vtkCxxSetObjectMacro(vtkHierarchicalBinsReader, Frustum, vtkPlanes);
+
+//------------------------------------------------------------------------------
+// Helper classes to support reading the file, and threaded execution.
+namespace
+{
+// Must match the values in vtkHierarchicalBinsWriter.
+const char vtkHierarchicalBinsMagic[8] = { 'V', 'T', 'K', 'H', 'B', 'I', 'N', 'S' };
+const vtkTypeInt32 vtkHierarchicalBinsVersion = 1;
+
+template <typename T>
+bool ReadValue(istream& is, T& value)
+{
+  return static_cast<bool>(is.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+// Whether the values of a file may be of this type.
+bool IsNumericType(int dataType)
+{
+  switch (dataType)
+  {
+    case VTK_CHAR:
+    case VTK_SIGNED_CHAR:
+    case VTK_UNSIGNED_CHAR:
+    case VTK_SHORT:
+    case VTK_UNSIGNED_SHORT:
+    case VTK_INT:
+    case VTK_UNSIGNED_INT:
+    case VTK_LONG:
+    case VTK_UNSIGNED_LONG:
+    case VTK_LONG_LONG:
+    case VTK_UNSIGNED_LONG_LONG:
+    case VTK_ID_TYPE:
+    case VTK_FLOAT:
+    case VTK_DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// The metadata at the beginning of the file, and the offsets of the bins.
+// Everything is checked against the file size before any allocation, so
+// that a corrupt file is rejected rather than read out of bounds.
+struct BinsHeader
+{
+  struct ArrayInfo
+  {
+    std::string Name;
+    int DataType;
+    int NumberOfComponents;
+  };
+
+  int NumberOfLevels;
+  int Divisions[3];
+  double Bounds[6];
+  vtkIdType NumberOfBins;
+  vtkIdType NumberOfPoints;
+  int PointsDataType;
+  std::vector<ArrayInfo> Arrays;
+  const char* Error = nullptr;
+
+  bool Fail(const char* error)
+  {
+    this->Error = error;
+    return false;
+  }
+
+  bool Read(istream& is)
+  {
+    is.seekg(0, ios::end);
+    const vtkTypeInt64 fileSize = static_cast<vtkTypeInt64>(is.tellg());
+    is.seekg(0, ios::beg);
+    auto remaining = [&is, fileSize]() { return fileSize - static_cast<vtkTypeInt64>(is.tellg()); };
+
+    char magic[sizeof(vtkHierarchicalBinsMagic)];
+    vtkTypeInt32 version, byteOrder, numLevels, divs[3], pointsType, numArrays;
+    vtkTypeInt64 numBins, numPts;
+    if (fileSize <= 0 || !is.read(magic, sizeof(magic)) ||
+      memcmp(magic, vtkHierarchicalBinsMagic, sizeof(magic)) != 0)
+    {
+      return this->Fail("not a hierarchical bins file");
+    }
+    if (!ReadValue(is, version) || version != vtkHierarchicalBinsVersion ||
+      !ReadValue(is, byteOrder) || byteOrder != 1)
+    {
+      return this->Fail("unsupported version or byte order");
+    }
+    if (!ReadValue(is, numLevels) || !ReadValue(is, divs[0]) || !ReadValue(is, divs[1]) ||
+      !ReadValue(is, divs[2]))
+    {
+      return this->Fail("truncated header");
+    }
+    for (int i = 0; i < 6; ++i)
+    {
+      if (!ReadValue(is, this->Bounds[i]))
+      {
+        return this->Fail("truncated header");
+      }
+    }
+    if (!ReadValue(is, numBins) || !ReadValue(is, numPts) || !ReadValue(is, pointsType) ||
+      !ReadValue(is, numArrays))
+    {
+      return this->Fail("truncated header");
+    }
+    for (int i = 0; i < 3; ++i)
+    {
+      if (!(this->Bounds[2 * i] <= this->Bounds[2 * i + 1]) ||
+        !std::isfinite(this->Bounds[2 * i]) || !std::isfinite(this->Bounds[2 * i + 1]))
+      {
+        return this->Fail("invalid bounds");
+      }
+    }
+    if (!IsNumericType(pointsType))
+    {
+      return this->Fail("invalid data type of the points");
+    }
+
+    // The offsets of the bins follow the header, so that the number of bins
+    // is bounded by the size of the file. The bins of each level subdivide
+    // those of the previous one.
+    if (numLevels < 1 || numBins < 1 || numBins >= fileSize / 8 || divs[0] < 1 || divs[1] < 1 ||
+      divs[2] < 1)
+    {
+      return this->Fail("invalid number of levels, bins or divisions");
+    }
+    vtkTypeInt64 block = 1;
+    for (int i = 0; i < 3 && numLevels > 1; ++i)
+    {
+      if (divs[i] > numBins / block)
+      {
+        return this->Fail("inconsistent number of bins");
+      }
+      block *= divs[i];
+    }
+    vtkTypeInt64 total = 0;
+    vtkTypeInt64 levelBins = 1;
+    for (int level = 0; level < numLevels; ++level)
+    {
+      if (level > 0)
+      {
+        if (levelBins > numBins / block)
+        {
+          return this->Fail("inconsistent number of bins");
+        }
+        levelBins *= block;
+      }
+      if (levelBins > numBins - total)
+      {
+        return this->Fail("inconsistent number of bins");
+      }
+      total += levelBins;
+    }
+    if (total != numBins)
+    {
+      return this->Fail("inconsistent number of bins");
+    }
+
+    // Each array is described by 12 bytes at least.
+    if (numArrays < 0 || numArrays > remaining() / 12)
+    {
+      return this->Fail("invalid number of arrays");
+    }
+    this->NumberOfLevels = numLevels;
+    this->Divisions[0] = divs[0];
+    this->Divisions[1] = divs[1];
+    this->Divisions[2] = divs[2];
+    this->NumberOfBins = static_cast<vtkIdType>(numBins);
+    this->PointsDataType = pointsType;
+
+    vtkTypeInt64 pointSize = 3 * vtkDataArray::GetDataTypeSize(pointsType);
+    this->Arrays.resize(numArrays);
+    for (ArrayInfo& info : this->Arrays)
+    {
+      vtkTypeInt32 dataType, numComps, nameLength;
+      if (!ReadValue(is, dataType) || !ReadValue(is, numComps) || !ReadValue(is, nameLength))
+      {
+        return this->Fail("truncated header");
+      }
+      if (!IsNumericType(dataType) || numComps < 1 || nameLength < 0 ||
+        nameLength > remaining())
+      {
+        return this->Fail("invalid array description");
+      }
+      info.DataType = dataType;
+      info.NumberOfComponents = numComps;
+      info.Name.resize(nameLength);
+      if (nameLength > 0 && !is.read(&info.Name[0], nameLength))
+      {
+        return this->Fail("truncated header");
+      }
+      pointSize += static_cast<vtkTypeInt64>(numComps) * vtkDataArray::GetDataTypeSize(dataType);
+    }
+
+    // The offsets, then the points and the arrays, must fit in the file.
+    const vtkTypeInt64 dataSize = remaining() - 8 * (numBins + 1);
+    if (dataSize < 0 || numPts < 0 || numPts > dataSize / pointSize)
+    {
+      return this->Fail("invalid number of points");
+    }
+    this->NumberOfPoints = static_cast<vtkIdType>(numPts);
+    return true;
+  }
+
+  // Read the offsets of the bins, which must start at 0, increase, and end
+  // at the number of points.
+  bool ReadOffsets(istream& is, std::vector<vtkTypeInt64>& offsets)
+  {
+    offsets.resize(this->NumberOfBins + 1);
+    if (!is.read(reinterpret_cast<char*>(offsets.data()), offsets.size() * sizeof(vtkTypeInt64)))
+    {
+      return this->Fail("truncated bin offsets");
+    }
+    if (offsets.front() != 0 || offsets.back() != this->NumberOfPoints ||
+      std::adjacent_find(offsets.begin(), offsets.end(), std::greater<vtkTypeInt64>()) !=
+        offsets.end())
+    {
+      return this->Fail("invalid bin offsets");
+    }
+    return true;
+  }
+};
+
+// A run of adjacent bins to read, and where to put its points.
+struct BinRun
+{
+  vtkIdType FirstPoint; // in the file
+  vtkIdType NumberOfPoints;
+  vtkIdType OutputOffset;
+};
+
+// A block of values, one tuple per point, stored contiguously in the file.
+struct DataBlock
+{
+  std::streamoff Start;
+  size_t TupleSize;
+  char* Output;
+};
+
+// Read the runs of bins in parallel. Each thread has its own stream.
+struct ReadRuns
+{
+  const char* FileName;
+  const std::vector<BinRun>& Runs;
+  const std::vector<DataBlock>& Blocks;
+  vtkSMPThreadLocal<vtksys::ifstream*> Stream;
+  vtkSMPThreadLocal<unsigned char> Failed;
+
+  ReadRuns(const char* fileName, const std::vector<BinRun>& runs,
+    const std::vector<DataBlock>& blocks)
+    : FileName(fileName)
+    , Runs(runs)
+    , Blocks(blocks)
+    , Stream(nullptr)
+    , Failed(0)
+  {
+  }
+
+  void Initialize()
+  {
+    this->Stream.Local() = new vtksys::ifstream(this->FileName, ios::in | ios::binary);
+  }
+
+  void operator()(vtkIdType runId, vtkIdType endRunId)
+  {
+    vtksys::ifstream& is = *this->Stream.Local();
+    unsigned char& failed = this->Failed.Local();
+    for (; runId < endRunId && !failed; ++runId)
+    {
+      const BinRun& run = this->Runs[runId];
+      for (const DataBlock& block : this->Blocks)
+      {
+        is.seekg(block.Start + static_cast<std::streamoff>(run.FirstPoint * block.TupleSize));
+        if (!is.read(block.Output + run.OutputOffset * block.TupleSize,
+              run.NumberOfPoints * block.TupleSize))
+        {
+          failed = 1;
+          break;
+        }
+      }
+    }
+  }
+
+  // Close the streams, and return whether all of the reads succeeded.
+  bool Finish()
+  {
+    bool success = true;
+    for (auto iter = this->Stream.begin(); iter != this->Stream.end(); ++iter)
+    {
+      delete *iter;
+    }
+    for (auto iter = this->Failed.begin(); iter != this->Failed.end(); ++iter)
+    {
+      success = success && !*iter;
+    }
+    return success;
+  }
+
+  void Reduce() {}
+};
+
+} // anonymous namespace
+
+//------------------------------------------------------------------------------
+vtkHierarchicalBinsReader::vtkHierarchicalBinsReader()
+{
+  this->SetNumberOfInputPorts(0);
+
+  this->FileName = nullptr;
+  this->MaximumLevel = VTK_INT_MAX;
+  this->LimitReadToBounds = false;
+  this->ReadBounds[0] = this->ReadBounds[2] = this->ReadBounds[4] = VTK_DOUBLE_MAX;
+  this->ReadBounds[1] = this->ReadBounds[3] = this->ReadBounds[5] = VTK_DOUBLE_MIN;
+  this->Frustum = nullptr;
+  this->NumberOfLevels = 0;
+}
+
+//------------------------------------------------------------------------------
+vtkHierarchicalBinsReader::~vtkHierarchicalBinsReader()
+{
+  this->SetFileName(nullptr);
+  this->SetFrustum(nullptr);
+}
+
+//------------------------------------------------------------------------------
+vtkMTimeType vtkHierarchicalBinsReader::GetMTime()
+{
+  vtkMTimeType mTime = this->Superclass::GetMTime();
+  if (this->Frustum)
+  {
+    vtkMTimeType time = this->Frustum->GetMTime();
+    mTime = (time > mTime ? time : mTime);
+  }
+  return mTime;
+}
+
+//------------------------------------------------------------------------------
+int vtkHierarchicalBinsReader::RequestInformation(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector*)
+{
+  if (!this->FileName)
+  {
+    vtkErrorMacro(<< "A FileName must be specified.");
+    return 0;
+  }
+
+  vtksys::ifstream is(this->FileName, ios::in | ios::binary);
+  BinsHeader header;
+  if (!is)
+  {
+    vtkErrorMacro(<< "Could not open " << this->FileName);
+    return 0;
+  }
+  if (!header.Read(is))
+  {
+    vtkErrorMacro(<< "Could not read the header of " << this->FileName << ": " << header.Error);
+    return 0;
+  }
+  this->NumberOfLevels = header.NumberOfLevels;
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+int vtkHierarchicalBinsReader::RequestData(
+  vtkInformation*, vtkInformationVector**, vtkInformationVector* outputVector)
+{
+  vtkInformation* outInfo = outputVector->GetInformationObject(0);
+  vtkPolyData* output = vtkPolyData::SafeDownCast(outInfo->Get(vtkDataObject::DATA_OBJECT()));
+
+  if (!this->FileName)
+  {
+    vtkErrorMacro(<< "A FileName must be specified.");
+    return 0;
+  }
+
+  // Read the header and the offsets of the bins.
+  vtksys::ifstream is(this->FileName, ios::in | ios::binary);
+  BinsHeader header;
+  if (!is)
+  {
+    vtkErrorMacro(<< "Could not open " << this->FileName);
+    return 0;
+  }
+  if (!header.Read(is))
+  {
+    vtkErrorMacro(<< "Could not read the header of " << this->FileName << ": " << header.Error);
+    return 0;
+  }
+  std::vector<vtkTypeInt64> offsets;
+  if (!header.ReadOffsets(is, offsets))
+  {
+    vtkErrorMacro(<< "Could not read the bin offsets of " << this->FileName << ": "
+                  << header.Error);
+    return 0;
+  }
+  const std::streamoff dataStart = is.tellg();
+  is.close();
+
+  // The region of interest: the read bounds, and the planes of the frustum.
+  std::vector<double> planes;
+  if (this->Frustum)
+  {
+    vtkNew<vtkPlane> plane;
+    for (int i = 0; i < this->Frustum->GetNumberOfPlanes(); ++i)
+    {
+      this->Frustum->GetPlane(i, plane);
+      planes.insert(planes.end(), plane->GetNormal(), plane->GetNormal() + 3);
+      planes.insert(planes.end(), plane->GetOrigin(), plane->GetOrigin() + 3);
+    }
+  }
+  auto selected = [this, &planes](const double bounds[6]) -> bool {
+    if (this->LimitReadToBounds &&
+      (bounds[1] < this->ReadBounds[0] || bounds[0] > this->ReadBounds[1] ||
+        bounds[3] < this->ReadBounds[2] || bounds[2] > this->ReadBounds[3] ||
+        bounds[5] < this->ReadBounds[4] || bounds[4] > this->ReadBounds[5]))
+    {
+      return false;
+    }
+    // The bin is outside of a plane if its corner furthest from the plane
+    // (against the normal) is outside.
+    for (size_t i = 0; i < planes.size(); i += 6)
+    {
+      const double* n = planes.data() + i;
+      const double* o = n + 3;
+      double value = 0.0;
+      for (int j = 0; j < 3; ++j)
+      {
+        value += n[j] * ((n[j] > 0.0 ? bounds[2 * j] : bounds[2 * j + 1]) - o[j]);
+      }
+      if (value > 0.0)
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  // Select the bins by descending the hierarchy from the root bin: each bin
+  // of a level is subdivided into Divisions[0]*Divisions[1]*Divisions[2]
+  // bins in the next level.
+  const int* divs = header.Divisions;
+  const int maxLevel =
+    (this->MaximumLevel < header.NumberOfLevels ? this->MaximumLevel : header.NumberOfLevels - 1);
+  std::vector<vtkIdType> levelOffsets(maxLevel + 1, 0);
+  std::vector<vtkIdType> levelDivs(3 * (maxLevel + 1), 1);
+  for (int level = 1; level <= maxLevel; ++level)
+  {
+    levelOffsets[level] = levelOffsets[level - 1] +
+      levelDivs[3 * level - 3] * levelDivs[3 * level - 2] * levelDivs[3 * level - 1];
+    for (int i = 0; i < 3; ++i)
+    {
+      levelDivs[3 * level + i] = levelDivs[3 * level - 3 + i] * divs[i];
+    }
+  }
+
+  struct StackEntry
+  {
+    int Level;
+    vtkIdType IJK[3];
+  };
+  std::vector<vtkIdType> bins;
+  std::vector<StackEntry> stack(1, StackEntry{ 0, { 0, 0, 0 } });
+  while (!stack.empty())
+  {
+    const StackEntry entry = stack.back();
+    stack.pop_back();
+    const vtkIdType* ld = levelDivs.data() + 3 * entry.Level;
+    double bounds[6];
+    for (int i = 0; i < 3; ++i)
+    {
+      const double h = (header.Bounds[2 * i + 1] - header.Bounds[2 * i]) / ld[i];
+      bounds[2 * i] = header.Bounds[2 * i] + entry.IJK[i] * h;
+      bounds[2 * i + 1] = bounds[2 * i] + h;
+    }
+    if (!selected(bounds))
+    {
+      continue;
+    }
+    const vtkIdType bin = levelOffsets[entry.Level] + entry.IJK[0] +
+      ld[0] * (entry.IJK[1] + ld[1] * entry.IJK[2]);
+    if (bin >= header.NumberOfBins)
+    {
+      vtkErrorMacro(<< "Inconsistent number of bins in " << this->FileName);
+      return 0;
+    }
+    bins.push_back(bin);
+    if (entry.Level < maxLevel)
+    {
+      for (int k = 0; k < divs[2]; ++k)
+      {
+        for (int j = 0; j < divs[1]; ++j)
+        {
+          for (int i = 0; i < divs[0]; ++i)
+          {
+            stack.push_back(StackEntry{ entry.Level + 1,
+              { entry.IJK[0] * divs[0] + i, entry.IJK[1] * divs[1] + j,
+                entry.IJK[2] * divs[2] + k } });
+          }
+        }
+      }
+    }
+  }
+
+  // Merge the adjacent bins (in the order of the file) into runs.
+  vtkSMPTools::Sort(bins.begin(), bins.end());
+  std::vector<BinRun> runs;
+  vtkIdType numOutPts = 0;
+  for (size_t i = 0; i < bins.size();)
+  {
+    size_t j = i + 1;
+    while (j < bins.size() && bins[j] == bins[j - 1] + 1)
+    {
+      ++j;
+    }
+    BinRun run;
+    run.FirstPoint = static_cast<vtkIdType>(offsets[bins[i]]);
+    run.NumberOfPoints = static_cast<vtkIdType>(offsets[bins[j - 1] + 1]) - run.FirstPoint;
+    run.OutputOffset = numOutPts;
+    if (run.NumberOfPoints > 0)
+    {
+      runs.push_back(run);
+      numOutPts += run.NumberOfPoints;
+    }
+    i = j;
+  }
+
+  // Allocate the output, and the blocks of the file to read into it.
+  vtkNew<vtkPoints> points;
+  points->SetDataType(header.PointsDataType);
+  points->SetNumberOfPoints(numOutPts);
+  output->SetPoints(points);
+
+  std::vector<DataBlock> blocks;
+  std::streamoff blockStart = dataStart;
+  const size_t pointSize = 3 * static_cast<size_t>(points->GetData()->GetDataTypeSize());
+  blocks.push_back(
+    DataBlock{ blockStart, pointSize, static_cast<char*>(points->GetVoidPointer(0)) });
+  blockStart += static_cast<std::streamoff>(header.NumberOfPoints * pointSize);
+
+  vtkPointData* outPD = output->GetPointData();
+  for (const BinsHeader::ArrayInfo& info : header.Arrays)
+  {
+    auto array = vtkSmartPointer<vtkDataArray>::Take(vtkDataArray::CreateDataArray(info.DataType));
+    if (!array)
+    {
+      vtkErrorMacro(<< "Unsupported data type for array " << info.Name);
+      return 0;
+    }
+    array->SetName(info.Name.c_str());
+    array->SetNumberOfComponents(info.NumberOfComponents);
+    array->SetNumberOfTuples(numOutPts);
+    outPD->AddArray(array);
+    const size_t tupleSize =
+      info.NumberOfComponents * static_cast<size_t>(array->GetDataTypeSize());
+    blocks.push_back(
+      DataBlock{ blockStart, tupleSize, static_cast<char*>(array->GetVoidPointer(0)) });
+    blockStart += static_cast<std::streamoff>(header.NumberOfPoints * tupleSize);
+  }
+
+  // Now read the runs, in parallel.
+  ReadRuns read(this->FileName, runs, blocks);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(runs.size()), read);
+  if (!read.Finish())
+  {
+    vtkErrorMacro(<< "Could not read the points of " << this->FileName);
+    output->Initialize();
+    return 0;
+  }
+
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkHierarchicalBinsReader::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "File Name: " << (this->FileName ? this->FileName : "(none)") << "\n";
+  os << indent << "Maximum Level: " << this->MaximumLevel << "\n";
+  os << indent << "Limit Read To Bounds: " << (this->LimitReadToBounds ? "On\n" : "Off\n");
+  os << indent << "Read Bounds: (" << this->ReadBounds[0] << "," << this->ReadBounds[1] << ", "
+     << this->ReadBounds[2] << "," << this->ReadBounds[3] << ", " << this->ReadBounds[4] << ","
+     << this->ReadBounds[5] << ")\n";
+  os << indent << "Frustum: " << this->Frustum << "\n";
+  os << indent << "Number Of Levels: " << this->NumberOfLevels << "\n";
+}
@@ -0,0 +1,130 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHierarchicalBinsReader.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkHierarchicalBinsReader
+ * @brief   read selected bins of a hierarchically binned point cloud
+ *
+ * vtkHierarchicalBinsReader reads the files written by
+ * vtkHierarchicalBinsWriter. Rather than loading the whole point cloud, it
+ * reads only the bins of the levels up to MaximumLevel (which controls the
+ * density of the output, since each level adds a random subset of the
+ * points) whose bounds intersect the ReadBounds (if LimitReadToBounds is on)
+ * and the Frustum (if set). Since the bins of a level subdivide the bins of
+ * the previous level, only the children of the selected bins are tested.
+ * Whole bins are read, so some of the output points may be slightly outside
+ * of the region of interest.
+ *
+ * The selected bins are read in parallel (each thread uses its own file
+ * stream), with adjacent bins read as a single run. The output is a
+ * vtkPolyData with points and point data arrays, sorted by bin, and no
+ * cells.
+ *
+ * @sa
+ * vtkHierarchicalBinsWriter vtkHierarchicalBinningFilter
+ * vtkExtractHierarchicalBins
+ */
+
+#ifndef vtkHierarchicalBinsReader_h
+#define vtkHierarchicalBinsReader_h
+
+#include "vtkIOGeometryModule.h" // For export macro
+#include "vtkPolyDataAlgorithm.h"
+
+class vtkPlanes;
+
+class VTKIOGEOMETRY_EXPORT vtkHierarchicalBinsReader : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkHierarchicalBinsReader* New();
+  vtkTypeMacro(vtkHierarchicalBinsReader, vtkPolyDataAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Specify file name.
+   */
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+  //@}
+
+  //@{
+  /**
+   * Specify the deepest level of the hierarchy to read (level 0 is the
+   * root bin). By default all of the levels are read.
+   */
+  vtkSetClampMacro(MaximumLevel, int, 0, VTK_INT_MAX);
+  vtkGetMacro(MaximumLevel, int);
+  //@}
+
+  //@{
+  /**
+   * Boolean value indicates whether or not to limit the bins read to the
+   * ones intersecting the ReadBounds.
+   */
+  vtkBooleanMacro(LimitReadToBounds, bool);
+  vtkSetMacro(LimitReadToBounds, bool);
+  vtkGetMacro(LimitReadToBounds, bool);
+  //@}
+
+  //@{
+  /**
+   * Bounds to use if LimitReadToBounds is On.
+   */
+  vtkSetVector6Macro(ReadBounds, double);
+  vtkGetVector6Macro(ReadBounds, double);
+  //@}
+
+  //@{
+  /**
+   * Specify a convex region, such as a view frustum (see
+   * vtkCamera::GetFrustumPlanes() and vtkPlanes::SetFrustumPlanes()), with
+   * the normals of the planes pointing outwards. If set, only the bins
+   * which are not completely outside of the region are read.
+   */
+  virtual void SetFrustum(vtkPlanes*);
+  vtkGetObjectMacro(Frustum, vtkPlanes);
+  //@}
+
+  /**
+   * Return the number of levels of the hierarchy in the file. This is
+   * available after the information pass (e.g. UpdateInformation()).
+   */
+  vtkGetMacro(NumberOfLevels, int);
+
+  /**
+   * Overload standard modified time function, since the frustum may change.
+   */
+  vtkMTimeType GetMTime() override;
+
+protected:
+  vtkHierarchicalBinsReader();
+  ~vtkHierarchicalBinsReader() override;
+
+  int RequestInformation(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+  int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
+
+  char* FileName;
+  int MaximumLevel;
+  bool LimitReadToBounds;
+  double ReadBounds[6];
+  vtkPlanes* Frustum;
+  int NumberOfLevels;
+
+private:
+  vtkHierarchicalBinsReader(const vtkHierarchicalBinsReader&) = delete;
+  void operator=(const vtkHierarchicalBinsReader&) = delete;
+};
+
+#endif
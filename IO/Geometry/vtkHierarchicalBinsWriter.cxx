@@ -0,0 +1,215 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHierarchicalBinsWriter.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkHierarchicalBinsWriter.h"
+
+#include "vtkDataArray.h"
+#include "vtkErrorCode.h"
+#include "vtkFieldData.h"
+#include "vtkInformation.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtksys/FStream.hxx"
+#include "vtksys/SystemTools.hxx"
+
+#include <string>
+#include <vector>
+
+vtkStandardNewMacro(vtkHierarchicalBinsWriter);
+
+//------------------------------------------------------------------------------
+namespace
+{
+// Must match the values in vtkHierarchicalBinsReader.
+const char vtkHierarchicalBinsMagic[8] = { 'V', 'T', 'K', 'H', 'B', 'I', 'N', 'S' };
+const vtkTypeInt32 vtkHierarchicalBinsVersion = 1;
+
+template <typename T>
+void WriteValue(ostream& os, T value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+}
+
+//------------------------------------------------------------------------------
+vtkHierarchicalBinsWriter::vtkHierarchicalBinsWriter()
+{
+  this->FileName = nullptr;
+}
+
+//------------------------------------------------------------------------------
+vtkHierarchicalBinsWriter::~vtkHierarchicalBinsWriter()
+{
+  this->SetFileName(nullptr);
+}
+
+//------------------------------------------------------------------------------
+void vtkHierarchicalBinsWriter::WriteData()
+{
+  vtkPolyData* input = this->GetInput();
+  vtkPoints* pts = input->GetPoints();
+  vtkFieldData* fd = input->GetFieldData();
+  vtkDataArray* offsets = fd->GetArray("BinOffsets");
+  vtkDataArray* bounds = fd->GetArray("BinBounds");
+  vtkDataArray* divisions = fd->GetArray("BinDivisions");
+  if (pts == nullptr || offsets == nullptr || bounds == nullptr || divisions == nullptr ||
+    bounds->GetNumberOfTuples() != 6 || divisions->GetNumberOfTuples() != 3)
+  {
+    vtkErrorMacro(<< "Input is not the output of vtkHierarchicalBinningFilter");
+    this->SetErrorCode(vtkErrorCode::UnknownError);
+    return;
+  }
+
+  if (this->FileName == nullptr)
+  {
+    vtkErrorMacro(<< "Please specify FileName to write");
+    this->SetErrorCode(vtkErrorCode::NoFileNameError);
+    return;
+  }
+
+  // Recover the number of levels from the number of bins.
+  const vtkIdType numBins = offsets->GetNumberOfTuples() - 1;
+  vtkTypeInt32 divs[3];
+  for (int i = 0; i < 3; ++i)
+  {
+    divs[i] = static_cast<vtkTypeInt32>(divisions->GetComponent(i, 0));
+  }
+  const vtkIdType block = divs[0] * divs[1] * divs[2];
+  vtkTypeInt32 numLevels = 0;
+  for (vtkIdType levelBins = 1, total = 0; total < numBins; levelBins *= block)
+  {
+    total += levelBins;
+    ++numLevels;
+    if (total > numBins)
+    {
+      numLevels = 0;
+      break;
+    }
+  }
+  const vtkIdType numPts = pts->GetNumberOfPoints();
+  vtkDataArray* ptsData = pts->GetData();
+  if (numLevels < 1 || !ptsData->HasStandardMemoryLayout() ||
+    static_cast<vtkIdType>(offsets->GetComponent(numBins, 0)) != numPts)
+  {
+    vtkErrorMacro(<< "Inconsistent bin offsets");
+    this->SetErrorCode(vtkErrorCode::UnknownError);
+    return;
+  }
+
+  // Gather the point data arrays which can be written as a block.
+  vtkPointData* pd = input->GetPointData();
+  std::vector<vtkDataArray*> arrays;
+  for (int i = 0; i < pd->GetNumberOfArrays(); ++i)
+  {
+    vtkDataArray* array = pd->GetArray(i);
+    if (array && array->GetName() && array->HasStandardMemoryLayout())
+    {
+      arrays.push_back(array);
+    }
+    else
+    {
+      vtkWarningMacro(<< "Skipping point data array " << i);
+    }
+  }
+
+  vtksys::ofstream os(this->FileName, ios::out | ios::binary);
+  if (!os)
+  {
+    vtkErrorMacro(<< "Couldn't open file: " << this->FileName
+                  << " Reason: " << vtksys::SystemTools::GetLastSystemError());
+    this->SetErrorCode(vtkErrorCode::CannotOpenFileError);
+    return;
+  }
+
+  // Header
+  os.write(vtkHierarchicalBinsMagic, sizeof(vtkHierarchicalBinsMagic));
+  WriteValue<vtkTypeInt32>(os, vtkHierarchicalBinsVersion);
+  WriteValue<vtkTypeInt32>(os, 1); // to detect the byte order
+  WriteValue<vtkTypeInt32>(os, numLevels);
+  for (int i = 0; i < 3; ++i)
+  {
+    WriteValue<vtkTypeInt32>(os, divs[i]);
+  }
+  for (int i = 0; i < 6; ++i)
+  {
+    WriteValue<double>(os, bounds->GetComponent(i, 0));
+  }
+  WriteValue<vtkTypeInt64>(os, numBins);
+  WriteValue<vtkTypeInt64>(os, numPts);
+  WriteValue<vtkTypeInt32>(os, ptsData->GetDataType());
+  WriteValue<vtkTypeInt32>(os, static_cast<vtkTypeInt32>(arrays.size()));
+  for (vtkDataArray* array : arrays)
+  {
+    const std::string name = array->GetName();
+    WriteValue<vtkTypeInt32>(os, array->GetDataType());
+    WriteValue<vtkTypeInt32>(os, array->GetNumberOfComponents());
+    WriteValue<vtkTypeInt32>(os, static_cast<vtkTypeInt32>(name.size()));
+    os.write(name.data(), name.size());
+  }
+
+  // Bin offsets
+  std::vector<vtkTypeInt64> binOffsets(numBins + 1);
+  for (vtkIdType i = 0; i <= numBins; ++i)
+  {
+    binOffsets[i] = static_cast<vtkTypeInt64>(offsets->GetComponent(i, 0));
+  }
+  os.write(reinterpret_cast<const char*>(binOffsets.data()),
+    binOffsets.size() * sizeof(vtkTypeInt64));
+
+  // Points and point data, already sorted by bin
+  os.write(static_cast<const char*>(ptsData->GetVoidPointer(0)),
+    numPts * 3 * ptsData->GetDataTypeSize());
+  for (vtkDataArray* array : arrays)
+  {
+    os.write(static_cast<const char*>(array->GetVoidPointer(0)),
+      numPts * array->GetNumberOfComponents() * array->GetDataTypeSize());
+  }
+
+  os.close();
+  if (os.fail())
+  {
+    vtkErrorMacro("Ran out of disk space; deleting file: " << this->FileName);
+    this->SetErrorCode(vtkErrorCode::OutOfDiskSpaceError);
+    vtksys::SystemTools::RemoveFile(this->FileName);
+  }
+}
+
+//------------------------------------------------------------------------------
+vtkPolyData* vtkHierarchicalBinsWriter::GetInput()
+{
+  return vtkPolyData::SafeDownCast(this->GetInput(0));
+}
+
+//------------------------------------------------------------------------------
+vtkPolyData* vtkHierarchicalBinsWriter::GetInput(int port)
+{
+  return vtkPolyData::SafeDownCast(this->Superclass::GetInput(port));
+}
+
+//------------------------------------------------------------------------------
+int vtkHierarchicalBinsWriter::FillInputPortInformation(int, vtkInformation* info)
+{
+  info->Set(vtkAlgorithm::INPUT_REQUIRED_DATA_TYPE(), "vtkPolyData");
+  return 1;
+}
+
+//------------------------------------------------------------------------------
+void vtkHierarchicalBinsWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+
+  os << indent << "File Name: " << (this->FileName ? this->FileName : "(none)") << "\n";
+}
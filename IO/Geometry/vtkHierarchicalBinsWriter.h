@@ -0,0 +1,88 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    vtkHierarchicalBinsWriter.h
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkHierarchicalBinsWriter
+ * @brief   write a hierarchically binned point cloud as a persistent index
+ *
+ * vtkHierarchicalBinsWriter writes the output of vtkHierarchicalBinningFilter
+ * (points sorted by bin, and the BinOffsets, BinBounds and BinDivisions
+ * field data arrays) to a binary file, so that the hierarchy does not have to
+ * be rebuilt on every run and so that vtkHierarchicalBinsReader can read
+ * only the bins it needs. Since the points of the coarse levels of the
+ * hierarchy are a random subset of the point cloud, each bin stores a
+ * decimated representation of the points in its bounds.
+ *
+ * The file contains a header (the number of levels, the divisions, the
+ * bounds, the number of bins and points, and the type, number of components
+ * and name of the point data arrays), the offsets of the bins, and then the
+ * coordinates of the points followed by the values of each point data array,
+ * each in one contiguous block sorted by bin. Point data arrays which are not
+ * stored contiguously in memory are not written.
+ *
+ * @warning
+ * Files are written in the byte order of the machine, and cannot be read on
+ * machines with a different byte order.
+ *
+ * @sa
+ * vtkHierarchicalBinsReader vtkHierarchicalBinningFilter
+ */
+
+#ifndef vtkHierarchicalBinsWriter_h
+#define vtkHierarchicalBinsWriter_h
+
+#include "vtkIOGeometryModule.h" // For export macro
+#include "vtkWriter.h"
+
+class vtkPolyData;
+
+class VTKIOGEOMETRY_EXPORT vtkHierarchicalBinsWriter : public vtkWriter
+{
+public:
+  static vtkHierarchicalBinsWriter* New();
+  vtkTypeMacro(vtkHierarchicalBinsWriter, vtkWriter);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Get the input to this writer.
+   */
+  vtkPolyData* GetInput();
+  vtkPolyData* GetInput(int port);
+  //@}
+
+  //@{
+  /**
+   * Specify the name of the file to write.
+   */
+  vtkSetStringMacro(FileName);
+  vtkGetStringMacro(FileName);
+  //@}
+
+protected:
+  vtkHierarchicalBinsWriter();
+  ~vtkHierarchicalBinsWriter() override;
+
+  void WriteData() override;
+
+  int FillInputPortInformation(int port, vtkInformation* info) override;
+
+  char* FileName;
+
+private:
+  vtkHierarchicalBinsWriter(const vtkHierarchicalBinsWriter&) = delete;
+  void operator=(const vtkHierarchicalBinsWriter&) = delete;
+};
+
+#endif
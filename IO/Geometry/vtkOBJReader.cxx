@@ -15,19 +15,790 @@
 #include "vtkOBJReader.h"
 
 #include "vtkCellArray.h"
+#include "vtkCellData.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
-#include <cctype>
+#include "vtkSMPTools.h"
+#include "vtkStringArray.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
 #include <sstream>
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
-#include "vtkCellData.h"
-#include "vtkStringArray.h"
+// The file is read in blocks of lines, which are split in chunks parsed
+// concurrently.
+#define VTK_OBJ_READER_BLOCK_SIZE (static_cast<size_t>(1) << 26)
+#define VTK_OBJ_READER_CHUNK_SIZE (static_cast<size_t>(1) << 20)
+
+namespace
+{
+// Lines longer than this are errors.
+const int MAX_LINE = 1024 * 256;
+
+// The white space of the "C" locale.
+inline bool IsSpace(char c)
+{
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline bool IsCommand(const char* cmd, const char* cmdEnd, const char* name)
+{
+  const size_t length = strlen(name);
+  return static_cast<size_t>(cmdEnd - cmd) == length && strncmp(cmd, name, length) == 0;
+}
+
+// Get the next line of a chunk, as read by fgets, and the end of its
+// content, which is at its first null character as with strlen.
+const char* NextLine(const char*& pos, const char* end, const char*& contentEnd)
+{
+  const char* line = pos;
+  const char* newline = static_cast<const char*>(memchr(pos, '\n', end - pos));
+  pos = newline ? newline + 1 : end;
+  const char* null = static_cast<const char*>(memchr(line, '\0', pos - line));
+  contentEnd = null ? null : pos;
+  return line;
+}
+
+// Get the end of what fgets reads of a line in a buffer of MAX_LINE, and
+// whether the whole line is read with a newline or the end of the file.
+bool GetFirstLoopLine(
+  const char* line, const char* lineEnd, const char* contentEnd, const char*& pieceEnd)
+{
+  const size_t length = lineEnd - line;
+  pieceEnd = std::min(contentEnd, line + (MAX_LINE - 1));
+  if (contentEnd == line)
+  {
+    return false;
+  }
+  if (lineEnd[-1] == '\n')
+  {
+    return length <= MAX_LINE - 1 && contentEnd == lineEnd;
+  }
+  // The last line of the file, without a newline.
+  return length < MAX_LINE - 1;
+}
+
+// Find the end of the first line ending in [pos, end) which is not
+// continued on the next line with a backslash, or nullptr.
+const char* FindLineEnd(const char* begin, const char* pos, const char* end)
+{
+  while (pos < end)
+  {
+    const char* newline = static_cast<const char*>(memchr(pos, '\n', end - pos));
+    if (!newline)
+    {
+      return nullptr;
+    }
+    if (newline == begin || newline[-1] != '\\')
+    {
+      return newline + 1;
+    }
+    pos = newline + 1;
+  }
+  return nullptr;
+}
+
+// Find the end of the last line in [begin, end) which is not continued on
+// the next line, or nullptr.
+const char* FindLastLineEnd(const char* begin, const char* end)
+{
+  for (const char* pos = end; pos > begin; --pos)
+  {
+    if (pos[-1] == '\n' && (pos - 1 == begin || pos[-2] != '\\'))
+    {
+      return pos;
+    }
+  }
+  return nullptr;
+}
+
+// Convert the characters of a number with strtof, as operator>> does: the
+// whole number must be converted, and overflows give the largest float.
+bool ConvertFloat(const char* begin, const char* end, float& value)
+{
+  const size_t length = end - begin;
+  if (length == 0)
+  {
+    value = 0.0f;
+    return false;
+  }
+  char buffer[64];
+  std::string longNumber;
+  const char* number = buffer;
+  if (length < sizeof(buffer))
+  {
+    memcpy(buffer, begin, length);
+    buffer[length] = '\0';
+  }
+  else
+  {
+    longNumber.assign(begin, end);
+    number = longNumber.c_str();
+  }
+  char* last;
+  value = strtof(number, &last);
+  if (last != number + length)
+  {
+    // Not a number, or another decimal point in the current locale.
+    std::istringstream stream(std::string(begin, end));
+    stream.imbue(std::locale::classic());
+    stream >> value;
+    return !stream.fail();
+  }
+  if (value > std::numeric_limits<float>::max())
+  {
+    value = std::numeric_limits<float>::max();
+    return false;
+  }
+  if (value < -std::numeric_limits<float>::max())
+  {
+    value = -std::numeric_limits<float>::max();
+    return false;
+  }
+  return true;
+}
+
+// Extract floats like operator>> does on a stream with the classic locale:
+// a value which cannot be read is set to 0, and the values after it are
+// left unchanged.  Returns the mask of the values which were assigned.
+int ExtractFloats(const char* pos, const char* end, int count, float* values)
+{
+  int assigned = 0;
+  for (int i = 0; i < count; ++i)
+  {
+    while (pos < end && IsSpace(*pos))
+    {
+      ++pos;
+    }
+    if (pos == end)
+    {
+      break;
+    }
+
+    // Gather the characters of a decimal number.
+    const char* start = pos;
+    if (*pos == '+' || *pos == '-')
+    {
+      ++pos;
+    }
+    bool foundMantissa = false;
+    bool foundDecimalPoint = false;
+    bool foundExponent = false;
+    for (; pos < end; ++pos)
+    {
+      if (*pos >= '0' && *pos <= '9')
+      {
+        foundMantissa = true;
+      }
+      else if (*pos == '.' && !foundDecimalPoint && !foundExponent)
+      {
+        foundDecimalPoint = true;
+      }
+      else if ((*pos == 'e' || *pos == 'E') && !foundExponent && foundMantissa)
+      {
+        foundExponent = true;
+        if (pos + 1 < end && (pos[1] == '+' || pos[1] == '-'))
+        {
+          ++pos;
+        }
+      }
+      else
+      {
+        break;
+      }
+    }
+
+    assigned |= 1 << i;
+    if (!ConvertFloat(start, pos, values[i]))
+    {
+      break;
+    }
+  }
+  return assigned;
+}
+
+// Scan an integer like the %d conversion of sscanf.
+bool ScanInt(const char*& pos, const char* end, int& value)
+{
+  while (pos < end && IsSpace(*pos))
+  {
+    ++pos;
+  }
+  const char* digits = pos;
+  const bool negative = (digits < end && *digits == '-');
+  if (digits < end && (*digits == '+' || *digits == '-'))
+  {
+    ++digits;
+  }
+  if (digits == end || *digits < '0' || *digits > '9')
+  {
+    return false;
+  }
+  // The digits are converted to a long, saturating as strtol does.
+  const unsigned long limit =
+    static_cast<unsigned long>(std::numeric_limits<long>::max()) + (negative ? 1 : 0);
+  unsigned long magnitude = 0;
+  bool overflow = false;
+  for (; digits < end && *digits >= '0' && *digits <= '9'; ++digits)
+  {
+    const unsigned int digit = *digits - '0';
+    if (overflow || magnitude > (limit - digit) / 10)
+    {
+      overflow = true;
+    }
+    else
+    {
+      magnitude = magnitude * 10 + digit;
+    }
+  }
+  if (overflow)
+  {
+    magnitude = limit;
+  }
+  value = static_cast<int>(static_cast<long>(negative ? 0UL - magnitude : magnitude));
+  pos = digits;
+  return true;
+}
+
+// Scan the indices of a vertex like sscanf does with a format made of %d
+// conversions and other characters, and return the number of indices read.
+int ScanIndices(const char* pos, const char* end, const char* format, int* values)
+{
+  int count = 0;
+  for (; *format; ++format)
+  {
+    if (format[0] == '%' && format[1] == 'd')
+    {
+      if (!ScanInt(pos, end, values[count]))
+      {
+        return count;
+      }
+      ++count;
+      ++format;
+    }
+    else if (pos == end || *pos++ != *format)
+    {
+      return count;
+    }
+  }
+  return count;
+}
+
+// An error message, with the line number relative to the chunk, if any.
+struct ErrorMessage
+{
+  std::string Text;
+  vtkIdType Line;
+  std::string Suffix;
+};
+
+// The cells of a chunk.  The indices are relative to the file, except the
+// negative indices of the file which are relative to the chunk and listed
+// in Relative, to be shifted when the chunks are concatenated.
+struct CellBuffer
+{
+  std::vector<vtkIdType> Offsets; // the end of each cell
+  std::vector<vtkIdType> Connectivity;
+  std::vector<vtkIdType> Relative;
+
+  void InsertNextCell() { this->Offsets.push_back(this->Connectivity.size()); }
+
+  void InsertCellPoint(vtkIdType id)
+  {
+    this->Connectivity.push_back(id);
+    ++this->Offsets.back();
+  }
+
+  // Insert a 1-based index, or a negative index relative to the count of
+  // items in the chunk.
+  void InsertCellPoint(int index, vtkIdType count)
+  {
+    if (index < 0)
+    {
+      this->Relative.push_back(this->Connectivity.size());
+      this->InsertCellPoint(count + index);
+    }
+    else
+    {
+      this->InsertCellPoint(index - 1);
+    }
+  }
+};
+
+// What is read from a chunk of lines of the file.  The first loop over the
+// lines finds the materials and the texture coordinates, which the faces of
+// the whole file refer to, and the second loop reads the rest.
+struct Chunk
+{
+  const char* Begin = nullptr; // the text, while it is parsed
+  const char* End = nullptr;
+  vtkIdType NumberOfLines = 0;
+
+  // First loop
+  std::vector<std::string> TCoordsNames; // in order of first appearance
+  std::string LastTCoordsName;
+  std::vector<float> TCoords;
+  std::vector<vtkIdType> TCoordsCarried; // values carried from the previous chunks
+  float TCoordsCarry[2] = { 0.0f, 0.0f };
+  int TCoordsCarryMask = 0;
+  std::vector<ErrorMessage> FirstLoopErrors;
+
+  // Second loop
+  std::vector<float> Points;
+  std::vector<float> Normals;
+  std::vector<vtkIdType> PointsCarried;
+  std::vector<vtkIdType> NormalsCarried;
+  float Carry[3] = { 0.0f, 0.0f, 0.0f };
+  int CarryMask = 0;
+  vtkIdType NumberOfTCoords = 0;
+  CellBuffer Verts;
+  CellBuffer Lines;
+  CellBuffer Polys;
+  CellBuffer TCoordPolys;
+  CellBuffer NormalPolys;
+  std::vector<std::pair<vtkIdType, std::string>> Materials; // first face, name
+  std::vector<int> FaceGroups;                               // "g" lines before each face
+  int NumberOfGroups = 0;
+  bool FaceBeforeGroup = false;
+  bool HasTCoords = false;
+  bool HasNormals = false;
+  bool TCoordsSameAsVerts = true;
+  bool NormalsSameAsVerts = true;
+  std::vector<ErrorMessage> SecondLoopErrors;
+};
+
+// Read values carried over from the previous lines: the values which are
+// not read are the previous ones, possibly in a previous chunk.
+void ExtractCarriedFloats(const char* pos, const char* end, int count, float* carry,
+  int& carryMask, std::vector<float>& values, std::vector<vtkIdType>& carried)
+{
+  const int assigned = ExtractFloats(pos, end, count, carry);
+  for (int i = 0; i < count; ++i)
+  {
+    if (!((assigned | carryMask) & (1 << i)))
+    {
+      carried.push_back(values.size() + i);
+    }
+  }
+  values.insert(values.end(), carry, carry + count);
+  carryMask |= assigned;
+}
+
+void ParseFirstLoop(Chunk& chunk)
+{
+  std::unordered_set<std::string> names;
+  const char* pos = chunk.Begin;
+  while (pos < chunk.End)
+  {
+    const char* pEnd;
+    const char* line = NextLine(pos, chunk.End, pEnd);
+    ++chunk.NumberOfLines;
+    if (!chunk.FirstLoopErrors.empty())
+    {
+      continue;
+    }
+    if (!GetFirstLoopLine(line, pos, pEnd, pEnd))
+    {
+      chunk.FirstLoopErrors.push_back(
+        { "Line longer than " + std::to_string(MAX_LINE) + ": " + std::string(line, pEnd), -1,
+          "" });
+      continue;
+    }
+
+    // find the first non-whitespace character, which starts the command
+    const char* pLine = line;
+    while (pLine < pEnd && IsSpace(*pLine))
+    {
+      pLine++;
+    }
+    const char* cmd = pLine;
+    while (pLine < pEnd && !IsSpace(*pLine))
+    {
+      pLine++;
+    }
+    const char* cmdEnd = pLine;
+    if (pLine < pEnd)
+    {
+      pLine++;
+    }
+
+    // if line starts by "usemtl", we're listing a new set of texture coordinates
+    if (IsCommand(cmd, cmdEnd, "usemtl"))
+    {
+      // Read name of texture coordinate
+      while (pLine < pEnd && IsSpace(*pLine))
+      {
+        pLine++;
+      }
+      const char* name = pLine;
+      while (pLine < pEnd && !IsSpace(*pLine))
+      {
+        pLine++;
+      }
+      if (pLine > name)
+      {
+        chunk.LastTCoordsName.assign(name, pLine);
+        if (names.insert(chunk.LastTCoordsName).second)
+        {
+          chunk.TCoordsNames.push_back(chunk.LastTCoordsName);
+        }
+      }
+      else
+      {
+        chunk.FirstLoopErrors.push_back(
+          { "Error reading 'usemtl' at line ", chunk.NumberOfLines, "" });
+      }
+    }
+    else if (IsCommand(cmd, cmdEnd, "vt"))
+    {
+      // this is a tcoord, expect two floats, separated by whitespace:
+      ExtractCarriedFloats(pLine, pEnd, 2, chunk.TCoordsCarry, chunk.TCoordsCarryMask,
+        chunk.TCoords, chunk.TCoordsCarried);
+    }
+  }
+}
+
+// Parse the indices of a "p" or "l" element.
+void ParseElement(Chunk& chunk, CellBuffer& cells, const char* command, int minVerts,
+  const char*& pos, const char* pLine, const char* pEnd, vtkIdType& lineNr, bool& everything_ok)
+{
+  const vtkIdType numPoints = static_cast<vtkIdType>(chunk.Points.size() / 3);
+  const bool isLine = (minVerts == 2);
+  cells.InsertNextCell();
+  int nVerts = 0; // keep a count of how many there are
+
+  while (everything_ok && pLine < pEnd)
+  {
+    // find next non-whitespace character
+    while (pLine < pEnd && IsSpace(*pLine))
+    {
+      pLine++;
+    }
+
+    if (pLine < pEnd) // there is still data left on this line
+    {
+      int indices[2];
+      if ((isLine && ScanIndices(pLine, pEnd, "%d/%d", indices) == 2) ||
+        ScanIndices(pLine, pEnd, "%d", indices) == 1)
+      {
+        // we simply ignore texture information
+        cells.InsertCellPoint(indices[0], numPoints);
+        nVerts++;
+      }
+      else if (pEnd - pLine == 2 && pLine[0] == '\\' && pLine[1] == '\n')
+      {
+        // handle backslash-newline continuation
+        if (pos < chunk.End)
+        {
+          lineNr++;
+          pLine = NextLine(pos, chunk.End, pEnd);
+          continue;
+        }
+        else
+        {
+          chunk.SecondLoopErrors.push_back(
+            { "Error reading continuation line at line ", lineNr, "" });
+          everything_ok = false;
+        }
+      }
+      else
+      {
+        chunk.SecondLoopErrors.push_back(
+          { std::string("Error reading '") + command + "' at line ", lineNr, "" });
+        everything_ok = false;
+      }
+      // skip over what we just read
+      // (find the first whitespace character)
+      while (pLine < pEnd && !IsSpace(*pLine))
+      {
+        pLine++;
+      }
+    }
+  }
+
+  if (nVerts < minVerts)
+  {
+    chunk.SecondLoopErrors.push_back({ "Error reading file near line ", lineNr,
+      std::string(" while processing the '") + command + "' command" });
+    everything_ok = false;
+  }
+}
+
+// Parse a face, whose tcoords and normals are stored in separate cells.
+void ParseFace(Chunk& chunk, const char*& pos, const char* pLine, const char* pEnd,
+  vtkIdType& lineNr, bool& everything_ok)
+{
+  const vtkIdType numPoints = static_cast<vtkIdType>(chunk.Points.size() / 3);
+  const vtkIdType numNormals = static_cast<vtkIdType>(chunk.Normals.size() / 3);
+  chunk.Polys.InsertNextCell();
+  chunk.TCoordPolys.InsertNextCell();
+  chunk.NormalPolys.InsertNextCell();
+
+  int nVerts = 0, nTCoords = 0, nNormals = 0; // keep a count of how many of each there are
+
+  while (everything_ok && pLine < pEnd)
+  {
+    // find the first non-whitespace character
+    while (pLine < pEnd && IsSpace(*pLine))
+    {
+      pLine++;
+    }
+
+    if (pLine < pEnd) // there is still data left on this line
+    {
+      int indices[3];
+      int nIndices = ScanIndices(pLine, pEnd, "%d/%d/%d", indices);
+      bool hasTCoord = (nIndices == 3);
+      bool hasNormal = (nIndices == 3);
+      if (nIndices != 3)
+      {
+        nIndices = ScanIndices(pLine, pEnd, "%d//%d", indices);
+        if (nIndices == 2)
+        {
+          indices[2] = indices[1];
+          hasNormal = true;
+        }
+        else
+        {
+          nIndices = ScanIndices(pLine, pEnd, "%d/%d", indices);
+          hasTCoord = (nIndices == 2);
+          if (!hasTCoord)
+          {
+            nIndices = ScanIndices(pLine, pEnd, "%d", indices);
+          }
+        }
+      }
+
+      if (nIndices > 0)
+      {
+        const int iVert = indices[0];
+        chunk.Polys.InsertCellPoint(iVert, numPoints);
+        nVerts++;
+
+        if (hasTCoord)
+        {
+          // Current index is relative to last texture index. The texture
+          // arrays are set when the chunks are concatenated.
+          chunk.TCoordPolys.InsertCellPoint(indices[1], chunk.NumberOfTCoords);
+          nTCoords++;
+          if (indices[1] != iVert)
+          {
+            chunk.TCoordsSameAsVerts = false;
+          }
+        }
+        if (hasNormal)
+        {
+          // Current index is relative to last normal index
+          chunk.NormalPolys.InsertCellPoint(indices[2], numNormals);
+          nNormals++;
+          if (indices[2] != iVert)
+          {
+            chunk.NormalsSameAsVerts = false;
+          }
+        }
+      }
+      else if (pEnd - pLine == 2 && pLine[0] == '\\' && pLine[1] == '\n')
+      {
+        // handle backslash-newline continuation
+        if (pos < chunk.End)
+        {
+          lineNr++;
+          pLine = NextLine(pos, chunk.End, pEnd);
+          continue;
+        }
+        else
+        {
+          chunk.SecondLoopErrors.push_back(
+            { "Error reading continuation line at line ", lineNr, "" });
+          everything_ok = false;
+        }
+      }
+      else
+      {
+        chunk.SecondLoopErrors.push_back({ "Error reading 'f' at line ", lineNr, "" });
+        everything_ok = false;
+      }
+      // skip over what we just read
+      // (find the first whitespace character)
+      while (pLine < pEnd && !IsSpace(*pLine))
+      {
+        pLine++;
+      }
+    }
+  }
+
+  // count of tcoords and normals must be equal to number of vertices or zero
+  if (nVerts < 3 || (nTCoords > 0 && nTCoords != nVerts) || (nNormals > 0 && nNormals != nVerts))
+  {
+    chunk.SecondLoopErrors.push_back(
+      { "Error reading file near line ", lineNr, " while processing the 'f' command" });
+    everything_ok = false;
+  }
+
+  // also make a note of whether any cells have tcoords, and whether any have normals
+  if (nTCoords > 0)
+  {
+    chunk.HasTCoords = true;
+  }
+  if (nNormals > 0)
+  {
+    chunk.HasNormals = true;
+  }
+
+  if (nVerts)
+  {
+    if (chunk.NumberOfGroups == 0)
+    {
+      chunk.FaceBeforeGroup = true;
+    }
+    chunk.FaceGroups.push_back(chunk.NumberOfGroups);
+  }
+}
+
+void ParseSecondLoop(Chunk& chunk)
+{
+  bool everything_ok = true;
+  vtkIdType lineNr = 0;
+  const char* pos = chunk.Begin;
+  while (everything_ok && pos < chunk.End)
+  {
+    ++lineNr;
+    const char* pEnd;
+    const char* pLine = NextLine(pos, chunk.End, pEnd);
+
+    // find the first non-whitespace character, which starts the command
+    while (pLine < pEnd && IsSpace(*pLine))
+    {
+      pLine++;
+    }
+    const char* cmd = pLine;
+    while (pLine < pEnd && !IsSpace(*pLine))
+    {
+      pLine++;
+    }
+    const char* cmdEnd = pLine;
+    if (pLine < pEnd)
+    {
+      pLine++;
+    }
+
+    if (IsCommand(cmd, cmdEnd, "g"))
+    {
+      // group definition, expect 0 or more words separated by whitespace.
+      // But here we simply note its existence, without a name
+      ++chunk.NumberOfGroups;
+    }
+    else if (IsCommand(cmd, cmdEnd, "v"))
+    {
+      // vertex definition, expect three floats, separated by whitespace:
+      ExtractCarriedFloats(
+        pLine, pEnd, 3, chunk.Carry, chunk.CarryMask, chunk.Points, chunk.PointsCarried);
+    }
+    else if (IsCommand(cmd, cmdEnd, "usemtl"))
+    {
+      // material name (for texture coordinates), expect one string, which
+      // the first loop has checked:
+      while (pLine < pEnd && IsSpace(*pLine))
+      {
+        pLine++;
+      }
+      const char* name = pLine;
+      while (pLine < pEnd && !IsSpace(*pLine))
+      {
+        pLine++;
+      }
+      // remember that starting with current cell, we should draw with it
+      chunk.Materials.emplace_back(
+        static_cast<vtkIdType>(chunk.Polys.Offsets.size()), std::string(name, pLine));
+    }
+    else if (IsCommand(cmd, cmdEnd, "vt"))
+    {
+      chunk.NumberOfTCoords++;
+    }
+    else if (IsCommand(cmd, cmdEnd, "vn"))
+    {
+      // vertex normal, expect three floats, separated by whitespace:
+      ExtractCarriedFloats(
+        pLine, pEnd, 3, chunk.Carry, chunk.CarryMask, chunk.Normals, chunk.NormalsCarried);
+      chunk.HasNormals = true;
+    }
+    else if (IsCommand(cmd, cmdEnd, "p"))
+    {
+      // point definition, consisting of 1-based indices separated by whitespace and /
+      ParseElement(chunk, chunk.Verts, "p", 1, pos, pLine, pEnd, lineNr, everything_ok);
+    }
+    else if (IsCommand(cmd, cmdEnd, "l"))
+    {
+      // line definition, consisting of 1-based indices separated by whitespace and /
+      ParseElement(chunk, chunk.Lines, "l", 2, pos, pLine, pEnd, lineNr, everything_ok);
+    }
+    else if (IsCommand(cmd, cmdEnd, "f"))
+    {
+      // face definition, consisting of 1-based indices separated by whitespace and /
+      ParseFace(chunk, pos, pLine, pEnd, lineNr, everything_ok);
+    }
+  }
+}
+
+void ParseChunk(Chunk& chunk)
+{
+  ParseFirstLoop(chunk);
+  if (chunk.FirstLoopErrors.empty())
+  {
+    ParseSecondLoop(chunk);
+  }
+}
+
+// Read the first comment of the file, in the lines of a block.  Returns
+// whether the comment may continue in the next block.
+bool ReadFirstComment(const char* pos, const char* end, std::string& comment)
+{
+  while (pos < end)
+  {
+    const char* pEnd;
+    const char* line = NextLine(pos, end, pEnd);
+    const bool complete = GetFirstLoopLine(line, pos, pEnd, pEnd);
+
+    const char* cmd = line;
+    while (cmd < pEnd && IsSpace(*cmd))
+    {
+      cmd++;
+    }
+    if (cmd == pEnd || *cmd != '#')
+    {
+      // This is not a comment line, real file content is started.
+      // There may be more comments in the file but we ignore those.
+      return false;
+    }
+    cmd++; // skip #
+    while (cmd < pEnd && IsSpace(*cmd))
+    {
+      cmd++;
+    } // skip whitespace at comment start
+    comment.append(cmd, pEnd);
+    if (!complete)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+}
 
 vtkStandardNewMacro(vtkOBJReader);
 
@@ -135,7 +906,6 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
   // initialize some structures to store the file contents in
   vtkPoints* points = vtkPoints::New();
   std::unordered_map<std::string, vtkFloatArray*> tcoords_map;
-  std::vector<std::pair<float, float>> verticesTextureList;
   vtkFloatArray* normals = vtkFloatArray::New();
   normals->SetNumberOfComponents(3);
   normals->SetName("Normals");
@@ -171,113 +941,75 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
 
   bool everything_ok = true; // (use of this flag avoids early return and associated memory leak)
 
-  // -- work through the file line by line, assigning into the above 7 structures as appropriate --
+  // -- read the file in blocks of lines, which are split in chunks parsed concurrently --
 
+  std::vector<Chunk> chunks;
   { // (make a local scope section to emphasise that the variables below are only used here)
 
-    const int MAX_LINE = 1024 * 256;
-    char rawLine[MAX_LINE];
-    char tcoordsName[100];
-    float xyz[3];
-    int numPoints = 0;
-    int numTCoords = 0;
-    int numNormals = 0;
-
-    // First loop to initialize the data arrays for the different set of texture coordinates
+    // The buffer is not initialized, and not larger than the file (plus one
+    // byte to find its end in the first read) for small files.
+    size_t capacity = std::min(
+      static_cast<size_t>(vtksys::SystemTools::FileLength(this->FileName)) + 1,
+      VTK_OBJ_READER_BLOCK_SIZE);
+    std::unique_ptr<char[]> buffer(new char[capacity]);
+    size_t size = 0;
+    bool atEnd = false;
     bool readingFirstComment = true;
     std::string firstComment;
-    int lineNr = 0;
-    while (everything_ok && fgets(rawLine, MAX_LINE, in) != nullptr)
+    while (!atEnd)
     {
-      ++lineNr;
-      char* pLine = rawLine;
-      char* pEnd = rawLine + strlen(rawLine);
-
-      if (*(pEnd - 1) != '\n' && !feof(in))
+      if (size == capacity)
       {
-        vtkErrorMacro(<< "Line longer than " << MAX_LINE << ": " << pLine);
-        everything_ok = false;
+        // a line does not fit in the block
+        std::unique_ptr<char[]> larger(new char[2 * capacity]);
+        memcpy(larger.get(), buffer.get(), size);
+        buffer = std::move(larger);
+        capacity *= 2;
       }
-
-      // find the first non-whitespace character
-      while (isspace(*pLine) && pLine < pEnd)
+      const size_t numRead = fread(buffer.get() + size, 1, capacity - size, in);
+      size += numRead;
+      atEnd = (size < capacity);
+
+      // Parse the complete lines of the block, and keep the rest for the
+      // next block. The lines continued with a backslash are kept together.
+      const char* begin = buffer.get();
+      const char* end = begin + size;
+      const char* blockEnd = atEnd ? end : FindLastLineEnd(begin, end);
+      if (!blockEnd)
       {
-        pLine++;
+        continue;
       }
 
-      // this first non-whitespace is the command
-      const char* cmd = pLine;
-
       if (readingFirstComment)
       {
-        if (cmd[0] == '#')
-        {
-          cmd++; // skip #
-          while (isspace(*cmd) && cmd < pEnd)
-          {
-            cmd++;
-          } // skip whitespace at comment start
-          firstComment += cmd;
-        }
-        else
-        {
-          // This is not a comment line, real file content is started.
-          // There may be more comments in the file but we ignore those.
-          readingFirstComment = false;
-        }
-      }
-
-      // skip over non-whitespace
-      while (!isspace(*pLine) && pLine < pEnd)
-      {
-        pLine++;
-      }
-
-      // terminate command
-      if (pLine < pEnd)
-      {
-        *pLine = '\0';
-        pLine++;
+        readingFirstComment = ReadFirstComment(begin, blockEnd, firstComment);
       }
 
-      // if line starts by "usemtl", we're listing a new set of texture coordinates
-      if (strcmp(cmd, "usemtl") == 0)
+      const size_t firstChunk = chunks.size();
+      for (const char* pos = begin; pos < blockEnd;)
       {
-        // Read name of texture coordinate
-        if (sscanf(pLine, "%s", tcoordsName) == 1)
-        {
-          if (tcoords_map.find(tcoordsName) == tcoords_map.end())
-          {
-            vtkFloatArray* tcoords = vtkFloatArray::New();
-            tcoords->SetNumberOfComponents(2);
-            tcoords->SetName(tcoordsName);
-            tcoords_map.emplace(tcoordsName, tcoords);
-          }
-        }
-        else
+        const char* chunkEnd = nullptr;
+        if (static_cast<size_t>(blockEnd - pos) > VTK_OBJ_READER_CHUNK_SIZE)
         {
-          vtkErrorMacro(<< "Error reading 'usemtl' at line " << lineNr);
-          everything_ok = false;
+          chunkEnd = FindLineEnd(begin, pos + VTK_OBJ_READER_CHUNK_SIZE - 1, blockEnd);
         }
+        chunks.emplace_back();
+        chunks.back().Begin = pos;
+        chunks.back().End = chunkEnd ? chunkEnd : blockEnd;
+        pos = chunks.back().End;
       }
-      else if (strcmp(cmd, "vt") == 0)
-      {
-        // this is a tcoord, expect two floats, separated by whitespace:
-        std::stringstream dataStream;
-        dataStream.imbue(std::locale::classic());
-        dataStream << pLine;
+      vtkSMPTools::For(static_cast<vtkIdType>(firstChunk), static_cast<vtkIdType>(chunks.size()), 1,
+        [&](vtkIdType first, vtkIdType last) {
+          for (vtkIdType i = first; i < last; ++i)
+          {
+            ParseChunk(chunks[i]);
+            chunks[i].Begin = chunks[i].End = nullptr;
+          }
+        });
 
-        try
-        {
-          dataStream >> xyz[0] >> xyz[1];
-          verticesTextureList.emplace_back(xyz[0], xyz[1]);
-        }
-        catch (const std::exception&)
-        {
-          vtkErrorMacro(<< "Error reading 'vt' at line " << lineNr);
-        }
-      }
-    } // (end of first while loop)
+      size = end - blockEnd;
+      memmove(buffer.get(), blockEnd, size);
+    }
 
     // Comment lines include newline characters.
     // Keep newlines between lines of multi-line comment, but
@@ -287,488 +1019,265 @@ int vtkOBJReader::RequestData(vtkInformation* vtkNotUsed(request),
       firstComment.pop_back();
     }
     this->SetComment(firstComment.c_str());
+  } // (end of local scope section)
 
-    // If no material texture coordinates are found, add default TCoords
-    if (tcoords_map.empty())
-    {
-      vtkFloatArray* tcoords = vtkFloatArray::New();
-      tcoords->SetNumberOfComponents(2);
-      strcpy(tcoordsName, "TCoords");
-      tcoords->SetName(tcoordsName);
-      tcoords_map.emplace(tcoordsName, tcoords);
-    }
+  // we have finished with the file
+  fclose(in);
 
-    // Initialize every texture array with (-1, -1)
+  // The errors are those of the first loop over the lines if any, which
+  // reads the materials and texture coordinates, then those of the second.
+  for (int loop = 0; loop < 2 && everything_ok; ++loop)
+  {
+    vtkIdType lineNr = 0;
+    for (const Chunk& chunk : chunks)
     {
-      const vtkIdType nTuples = static_cast<vtkIdType>(verticesTextureList.size());
-
-      for (const auto& iter : tcoords_map)
+      const std::vector<ErrorMessage>& errors =
+        (loop == 0 ? chunk.FirstLoopErrors : chunk.SecondLoopErrors);
+      for (const ErrorMessage& error : errors)
       {
-        vtkFloatArray* tcoords = iter.second;
-        tcoords->SetNumberOfTuples(nTuples);
-
-        for (vtkIdType i = 0; i < nTuples; ++i)
+        if (error.Line < 0)
         {
-          tcoords->SetTuple2(i, -1.0, -1.0);
+          vtkErrorMacro(<< error.Text);
         }
+        else
+        {
+          vtkErrorMacro(<< error.Text << lineNr + error.Line << error.Suffix);
+        }
+        everything_ok = false;
       }
-    }
-
-    // Second loop to parse points, faces, texture coordinates, normals...
-    lineNr = 0;
-    fseek(in, 0, SEEK_SET);
-    while (everything_ok && fgets(rawLine, MAX_LINE, in) != nullptr)
-    {
-      ++lineNr;
-      char* pLine = rawLine;
-      char* pEnd = rawLine + strlen(rawLine);
-
-      // find the first non-whitespace character
-      while (isspace(*pLine) && pLine < pEnd)
-      {
-        pLine++;
-      }
-
-      // this first non-whitespace is the command
-      const char* cmd = pLine;
-
-      // skip over non-whitespace
-      while (!isspace(*pLine) && pLine < pEnd)
+      if (!everything_ok)
       {
-        pLine++;
+        break;
       }
+      lineNr += chunk.NumberOfLines;
+    }
+  }
 
-      // terminate command
-      if (pLine < pEnd)
-      {
-        *pLine = '\0';
-        pLine++;
-      }
+  // -- concatenate the chunks into the above 7 structures --
 
-      if (strcmp(cmd, "g") == 0)
+  if (everything_ok)
+  {
+    // The offsets of the chunks in the structures.
+    struct ChunkOffsets
+    {
+      vtkIdType Points, Normals, TCoords, Faces, GroupId;
+      vtkIdType Cells[5], Connectivity[5];
+    };
+    std::vector<ChunkOffsets> offsets(chunks.size() + 1);
+    offsets[0] = ChunkOffsets();
+    offsets[0].GroupId = -1;
+    std::vector<float> tcoordValues;
+    float xyz[3] = { 0.0f, 0.0f, 0.0f };
+    std::string tcoordsName;
+
+    // The values not read on a line are those of the previous lines, and
+    // the texture coordinates are read first.
+    for (Chunk& chunk : chunks)
+    {
+      for (vtkIdType i : chunk.TCoordsCarried)
       {
-        // group definition, expect 0 or more words separated by whitespace.
-        // But here we simply note its existence, without a name
-        ++groupId;
+        chunk.TCoords[i] = xyz[i % 2];
       }
-      else if (strcmp(cmd, "v") == 0)
+      for (int i = 0; i < 2; ++i)
       {
-        // vertex definition, expect three floats, separated by whitespace:
-        std::stringstream dataStream;
-        dataStream.imbue(std::locale::classic());
-        dataStream << pLine;
-
-        try
-        {
-          dataStream >> xyz[0] >> xyz[1] >> xyz[2];
-          points->InsertNextPoint(xyz);
-          numPoints++;
-        }
-        catch (const std::exception&)
+        if (chunk.TCoordsCarryMask & (1 << i))
         {
-          vtkErrorMacro(<< "Error reading 'v' at line " << lineNr);
-          everything_ok = false;
+          xyz[i] = chunk.TCoordsCarry[i];
         }
       }
-      else if (strcmp(cmd, "usemtl") == 0)
+      tcoordValues.insert(tcoordValues.end(), chunk.TCoords.begin(), chunk.TCoords.end());
+      std::vector<float>().swap(chunk.TCoords);
+      for (const std::string& name : chunk.TCoordsNames)
       {
-        // material name (for texture coordinates), expect one string:
-        if (sscanf(pLine, "%s", tcoordsName) != 1)
-        {
-          vtkErrorMacro(<< "Error reading 'usemtl' at line " << lineNr);
-          everything_ok = false;
-        }
-        if (matNameToId.find(tcoordsName) == matNameToId.end())
+        if (tcoords_map.find(name) == tcoords_map.end())
         {
-          // haven't seen this material yet, keep a record of it
-          matNameToId.emplace(tcoordsName, matcnt);
-          matNames->InsertNextValue(tcoordsName);
-          matcnt++;
+          vtkFloatArray* tcoords = vtkFloatArray::New();
+          tcoords->SetNumberOfComponents(2);
+          tcoords->SetName(name.c_str());
+          tcoords_map.emplace(name, tcoords);
         }
-        // remember that starting with current cell, we should draw with it
-        startCellToMatName[polys->GetNumberOfCells()] = tcoordsName;
       }
-      else if (strcmp(cmd, "vt") == 0)
+      if (!chunk.LastTCoordsName.empty())
       {
-        numTCoords++;
+        tcoordsName = chunk.LastTCoordsName;
       }
-      else if (strcmp(cmd, "vn") == 0)
+    }
+    const vtkIdType numTCoordsValues = static_cast<vtkIdType>(tcoordValues.size() / 2);
+    xyz[2] = 0.0f;
+    for (size_t c = 0; c < chunks.size(); ++c)
+    {
+      Chunk& chunk = chunks[c];
+      for (vtkIdType i : chunk.PointsCarried)
       {
-        // vertex normal, expect three floats, separated by whitespace:
-        std::stringstream dataStream;
-        dataStream.imbue(std::locale::classic());
-        dataStream << pLine;
-
-        try
-        {
-          dataStream >> xyz[0] >> xyz[1] >> xyz[2];
-          normals->InsertNextTuple(xyz);
-          hasNormals = true;
-          numNormals++;
-        }
-        catch (const std::exception&)
-        {
-          vtkErrorMacro(<< "Error reading 'vn' at line " << lineNr);
-          everything_ok = false;
-        }
+        chunk.Points[i] = xyz[i % 3];
       }
-      else if (strcmp(cmd, "p") == 0)
+      for (vtkIdType i : chunk.NormalsCarried)
       {
-        // point definition, consisting of 1-based indices separated by whitespace and /
-        pointElems->InsertNextCell(0); // we don't yet know how many points are to come
-
-        int nVerts = 0; // keep a count of how many there are
-
-        while (everything_ok && pLine < pEnd)
-        {
-          // find next non-whitespace character
-          while (isspace(*pLine) && pLine < pEnd)
-          {
-            pLine++;
-          }
-
-          if (pLine < pEnd) // there is still data left on this line
-          {
-            int iVert;
-            if (sscanf(pLine, "%d", &iVert) == 1)
-            {
-              if (iVert < 0)
-              {
-                pointElems->InsertCellPoint(numPoints + iVert);
-              }
-              else
-              {
-                pointElems->InsertCellPoint(iVert - 1);
-              }
-              nVerts++;
-            }
-            else if (strcmp(pLine, "\\\n") == 0)
-            {
-              // handle backslash-newline continuation
-              if (fgets(rawLine, MAX_LINE, in) != nullptr)
-              {
-                lineNr++;
-                pLine = rawLine;
-                pEnd = rawLine + strlen(rawLine);
-                continue;
-              }
-              else
-              {
-                vtkErrorMacro(<< "Error reading continuation line at line " << lineNr);
-                everything_ok = false;
-              }
-            }
-            else
-            {
-              vtkErrorMacro(<< "Error reading 'p' at line " << lineNr);
-              everything_ok = false;
-            }
-            // skip over what we just sscanf'd
-            // (find the first whitespace character)
-            while (!isspace(*pLine) && pLine < pEnd)
-            {
-              pLine++;
-            }
-          }
-        }
-
-        if (nVerts < 1)
+        chunk.Normals[i] = xyz[i % 3];
+      }
+      for (int i = 0; i < 3; ++i)
+      {
+        if (chunk.CarryMask & (1 << i))
         {
-          vtkErrorMacro(<< "Error reading file near line " << lineNr
-                        << " while processing the 'p' command");
-          everything_ok = false;
+          xyz[i] = chunk.Carry[i];
         }
+      }
 
-        // now we know how many points there were in this cell
-        pointElems->UpdateCellCount(nVerts);
+      // The group of the faces before any "g" line is 0.
+      ChunkOffsets& previous = offsets[c];
+      ChunkOffsets& next = offsets[c + 1];
+      if (previous.GroupId < 0 && chunk.FaceBeforeGroup)
+      {
+        previous.GroupId = 0;
       }
-      else if (strcmp(cmd, "l") == 0)
+      next.GroupId = previous.GroupId + chunk.NumberOfGroups;
+
+      next.Points = previous.Points + static_cast<vtkIdType>(chunk.Points.size() / 3);
+      next.Normals = previous.Normals + static_cast<vtkIdType>(chunk.Normals.size() / 3);
+      next.TCoords = previous.TCoords + chunk.NumberOfTCoords;
+      next.Faces = previous.Faces + static_cast<vtkIdType>(chunk.FaceGroups.size());
+      CellBuffer* cells[5] = { &chunk.Verts, &chunk.Lines, &chunk.Polys, &chunk.TCoordPolys,
+        &chunk.NormalPolys };
+      for (int k = 0; k < 5; ++k)
       {
-        // line definition, consisting of 1-based indices separated by whitespace and /
-        lineElems->InsertNextCell(0); // we don't yet know how many points are to come
-
-        int nVerts = 0; // keep a count of how many there are
-
-        while (everything_ok && pLine < pEnd)
-        {
-          // find next non-whitespace character
-          while (isspace(*pLine) && pLine < pEnd)
-          {
-            pLine++;
-          }
+        next.Cells[k] = previous.Cells[k] + static_cast<vtkIdType>(cells[k]->Offsets.size());
+        next.Connectivity[k] =
+          previous.Connectivity[k] + static_cast<vtkIdType>(cells[k]->Connectivity.size());
+      }
 
-          if (pLine < pEnd) // there is still data left on this line
-          {
-            int iVert, dummyInt;
-            if (sscanf(pLine, "%d/%d", &iVert, &dummyInt) == 2)
-            {
-              // we simply ignore texture information
-              if (iVert < 0)
-              {
-                lineElems->InsertCellPoint(numPoints + iVert);
-              }
-              else
-              {
-                lineElems->InsertCellPoint(iVert - 1);
-              }
-              nVerts++;
-            }
-            else if (sscanf(pLine, "%d", &iVert) == 1)
-            {
-              if (iVert < 0)
-              {
-                lineElems->InsertCellPoint(numPoints + iVert);
-              }
-              else
-              {
-                lineElems->InsertCellPoint(iVert - 1);
-              }
-              nVerts++;
-            }
-            else if (strcmp(pLine, "\\\n") == 0)
-            {
-              // handle backslash-newline continuation
-              if (fgets(rawLine, MAX_LINE, in) != nullptr)
-              {
-                lineNr++;
-                pLine = rawLine;
-                pEnd = rawLine + strlen(rawLine);
-                continue;
-              }
-              else
-              {
-                vtkErrorMacro(<< "Error reading continuation line at line " << lineNr);
-                everything_ok = false;
-              }
-            }
-            else
-            {
-              vtkErrorMacro(<< "Error reading 'l' at line " << lineNr);
-              everything_ok = false;
-            }
-            // skip over what we just sscanf'd
-            // (find the first whitespace character)
-            while (!isspace(*pLine) && pLine < pEnd)
-            {
-              pLine++;
-            }
-          }
-        }
+      hasTCoords |= chunk.HasTCoords;
+      hasNormals |= chunk.HasNormals;
+      tcoords_same_as_verts &= chunk.TCoordsSameAsVerts;
+      normals_same_as_verts &= chunk.NormalsSameAsVerts;
 
-        if (nVerts < 2)
+      // keep a record of the materials
+      for (const auto& material : chunk.Materials)
+      {
+        if (matNameToId.find(material.second) == matNameToId.end())
         {
-          vtkErrorMacro(<< "Error reading file near line " << lineNr
-                        << " while processing the 'l' command");
-          everything_ok = false;
+          // haven't seen this material yet, keep a record of it
+          matNameToId.emplace(material.second, matcnt);
+          matNames->InsertNextValue(material.second);
+          matcnt++;
         }
-
-        // now we know how many points there were in this cell
-        lineElems->UpdateCellCount(nVerts);
+        // remember that starting with current cell, we should draw with it
+        startCellToMatName[previous.Cells[2] + material.first] = material.second;
       }
-      else if (strcmp(cmd, "f") == 0)
-      {
-        // face definition, consisting of 1-based indices separated by whitespace and /
+    }
+    groupId = static_cast<int>(offsets.back().GroupId);
+
+    // If no material texture coordinates are found, add default TCoords
+    if (tcoords_map.empty())
+    {
+      vtkFloatArray* tcoords = vtkFloatArray::New();
+      tcoords->SetNumberOfComponents(2);
+      tcoordsName = "TCoords";
+      tcoords->SetName(tcoordsName.c_str());
+      tcoords_map.emplace(tcoordsName, tcoords);
+    }
 
-        polys->InsertNextCell(0); // we don't yet know how many points are to come
-        tcoord_polys->InsertNextCell(0);
-        normal_polys->InsertNextCell(0);
+    // Initialize every texture array with (-1, -1)
+    for (const auto& iter : tcoords_map)
+    {
+      vtkFloatArray* tcoords = iter.second;
+      tcoords->SetNumberOfTuples(numTCoordsValues);
+      tcoords->FillValue(-1.0f);
+    }
 
-        int nVerts = 0, nTCoords = 0, nNormals = 0; // keep a count of how many of each there are
+    // Copy the chunks concurrently.
+    const ChunkOffsets& total = offsets.back();
+    points->SetNumberOfPoints(total.Points);
+    normals->SetNumberOfTuples(total.Normals);
+    faceScalars->SetNumberOfTuples(total.Faces);
+    vtkCellArray* cellArrays[5] = { pointElems, lineElems, polys, tcoord_polys, normal_polys };
+    vtkNew<vtkIdTypeArray> cellOffsets[5];
+    vtkNew<vtkIdTypeArray> cellConnectivity[5];
+    for (int k = 0; k < 5; ++k)
+    {
+      cellOffsets[k]->SetNumberOfValues(total.Cells[k] + 1);
+      cellOffsets[k]->SetValue(0, 0);
+      cellConnectivity[k]->SetNumberOfValues(total.Connectivity[k]);
+    }
+    float* pointsData = vtkFloatArray::SafeDownCast(points->GetData())->GetPointer(0);
+    const vtkIdType numChunks = static_cast<vtkIdType>(chunks.size());
+    vtkSMPTools::For(0, numChunks, 1, [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType c = first; c < last; ++c)
+      {
+        Chunk& chunk = chunks[c];
+        const ChunkOffsets& chunkOffsets = offsets[c];
+        std::copy(chunk.Points.begin(), chunk.Points.end(), pointsData + 3 * chunkOffsets.Points);
+        std::copy(chunk.Normals.begin(), chunk.Normals.end(),
+          normals->GetPointer(3 * chunkOffsets.Normals));
+        float* groups = faceScalars->GetPointer(chunkOffsets.Faces);
+        for (int group : chunk.FaceGroups)
+        {
+          *groups++ = static_cast<float>(chunkOffsets.GroupId + group);
+        }
 
-        while (everything_ok && pLine < pEnd)
+        // The relative indices are shifted by the points, tcoords or normals
+        // of the previous chunks.
+        CellBuffer* cells[5] = { &chunk.Verts, &chunk.Lines, &chunk.Polys, &chunk.TCoordPolys,
+          &chunk.NormalPolys };
+        const vtkIdType shifts[5] = { chunkOffsets.Points, chunkOffsets.Points,
+          chunkOffsets.Points, chunkOffsets.TCoords, chunkOffsets.Normals };
+        for (int k = 0; k < 5; ++k)
         {
-          // find the first non-whitespace character
-          while (isspace(*pLine) && pLine < pEnd)
+          vtkIdType* cellOffset = cellOffsets[k]->GetPointer(chunkOffsets.Cells[k] + 1);
+          for (vtkIdType offset : cells[k]->Offsets)
           {
-            pLine++;
+            *cellOffset++ = chunkOffsets.Connectivity[k] + offset;
           }
-
-          if (pLine < pEnd) // there is still data left on this line
+          vtkIdType* connectivity = cellConnectivity[k]->GetPointer(chunkOffsets.Connectivity[k]);
+          std::copy(cells[k]->Connectivity.begin(), cells[k]->Connectivity.end(), connectivity);
+          for (vtkIdType i : cells[k]->Relative)
           {
-            int iVert, iTCoord, iNormal;
-            if (sscanf(pLine, "%d/%d/%d", &iVert, &iTCoord, &iNormal) == 3)
-            {
-              if (iVert < 0)
-              {
-                polys->InsertCellPoint(numPoints + iVert);
-              }
-              else
-              {
-                polys->InsertCellPoint(iVert - 1);
-              }
-              nVerts++;
-
-              // Current index is relative to last texture index
-              int iTCoordAbs = (iTCoord < 0) ? numTCoords + iTCoord : iTCoord - 1;
-              tcoord_polys->InsertCellPoint(iTCoordAbs);
-
-              // Set the current texture array with the value corresponding to the
-              // iTcoords read
-              const auto& currentTCoord = verticesTextureList[iTCoordAbs];
-              auto iter = tcoords_map.find(tcoordsName);
-              vtkFloatArray* tcArray = iter->second;
-              tcArray->SetTuple2(iTCoordAbs, currentTCoord.first, currentTCoord.second);
-
-              nTCoords++;
-
-              // Current index is relative to last normal index
-              if (iNormal < 0)
-              {
-                normal_polys->InsertCellPoint(numNormals + iNormal);
-              }
-              else
-              {
-                normal_polys->InsertCellPoint(iNormal - 1);
-              }
-              nNormals++;
-              if (iTCoord != iVert)
-              {
-                tcoords_same_as_verts = false;
-              }
-              if (iNormal != iVert)
-              {
-                normals_same_as_verts = false;
-              }
-            }
-            else if (sscanf(pLine, "%d//%d", &iVert, &iNormal) == 2)
-            {
-              if (iVert < 0)
-              {
-                polys->InsertCellPoint(numPoints + iVert);
-              }
-              else
-              {
-                polys->InsertCellPoint(iVert - 1);
-              }
-              nVerts++;
-
-              // Current index is relative to last normal index
-              if (iNormal < 0)
-              {
-                normal_polys->InsertCellPoint(numNormals + iNormal);
-              }
-              else
-              {
-                normal_polys->InsertCellPoint(iNormal - 1);
-              }
-              nNormals++;
-              if (iNormal != iVert)
-                normals_same_as_verts = false;
-            }
-            else if (sscanf(pLine, "%d/%d", &iVert, &iTCoord) == 2)
-            {
-              if (iVert < 0)
-              {
-                polys->InsertCellPoint(numPoints + iVert);
-              }
-              else
-              {
-                polys->InsertCellPoint(iVert - 1);
-              }
-              nVerts++;
-
-              // Current index is relative to last texture index
-              int iTCoordAbs = (iTCoord < 0) ? numTCoords + iTCoord : iTCoord - 1;
-              tcoord_polys->InsertCellPoint(iTCoordAbs);
-
-              // Set the current texture array with the value corresponding to the
-              // iTcoords read
-              const auto& currentTCoord = verticesTextureList[iTCoordAbs];
-              tcoords_map[tcoordsName]->SetTuple2(
-                iTCoordAbs, currentTCoord.first, currentTCoord.second);
-
-              nTCoords++;
-              if (iTCoord != iVert)
-              {
-                tcoords_same_as_verts = false;
-              }
-            }
-            else if (sscanf(pLine, "%d", &iVert) == 1)
-            {
-              if (iVert < 0)
-              {
-                polys->InsertCellPoint(numPoints + iVert);
-              }
-              else
-              {
-                polys->InsertCellPoint(iVert - 1);
-              }
-              nVerts++;
-            }
-            else if (strcmp(pLine, "\\\n") == 0)
-            {
-              // handle backslash-newline continuation
-              if (fgets(rawLine, MAX_LINE, in) != nullptr)
-              {
-                lineNr++;
-                pLine = rawLine;
-                pEnd = rawLine + strlen(rawLine);
-                continue;
-              }
-              else
-              {
-                vtkErrorMacro(<< "Error reading continuation line at line " << lineNr);
-                everything_ok = false;
-              }
-            }
-            else
-            {
-              vtkErrorMacro(<< "Error reading 'f' at line " << lineNr);
-              everything_ok = false;
-            }
-            // skip over what we just read
-            // (find the first whitespace character)
-            while (!isspace(*pLine) && pLine < pEnd)
-            {
-              pLine++;
-            }
+            connectivity[i] += shifts[k];
           }
         }
+      }
+    });
+    for (int k = 0; k < 5; ++k)
+    {
+      cellArrays[k]->SetData(cellOffsets[k], cellConnectivity[k]);
+    }
 
-        // count of tcoords and normals must be equal to number of vertices or zero
-        if (nVerts < 3 || (nTCoords > 0 && nTCoords != nVerts) ||
-          (nNormals > 0 && nNormals != nVerts))
-        {
-          vtkErrorMacro(<< "Error reading file near line " << lineNr
-                        << " while processing the 'f' command");
-          everything_ok = false;
-        }
-
-        // now we know how many points there were in this cell
-        polys->UpdateCellCount(nVerts);
-        tcoord_polys->UpdateCellCount(nTCoords);
-        normal_polys->UpdateCellCount(nNormals);
-
-        // also make a note of whether any cells have tcoords, and whether any have normals
-        if (nTCoords > 0)
+    // Set the texture arrays of the materials with the texture coordinates
+    // of the faces.
+    auto textureArray = [&](const std::string& name) {
+      auto iter = tcoords_map.find(name);
+      return iter == tcoords_map.end() ? nullptr : iter->second;
+    };
+    vtkFloatArray* tcArray = textureArray(tcoordsName);
+    const vtkIdType* tcoordOffsets = cellOffsets[3]->GetPointer(0);
+    const vtkIdType* tcoordIds = cellConnectivity[3]->GetPointer(0);
+    for (size_t c = 0; c < chunks.size(); ++c)
+    {
+      const Chunk& chunk = chunks[c];
+      const vtkIdType firstFace = offsets[c].Cells[3];
+      const vtkIdType numFaces = offsets[c + 1].Cells[3] - firstFace;
+      auto material = chunk.Materials.begin();
+      for (vtkIdType face = 0; face <= numFaces; ++face)
+      {
+        for (; material != chunk.Materials.end() && material->first <= face; ++material)
         {
-          hasTCoords = true;
+          tcArray = textureArray(material->second);
         }
-        if (nNormals > 0)
+        if (face == numFaces || !tcArray)
         {
-          hasNormals = true;
+          continue;
         }
-
-        if (faceScalars && nVerts)
+        for (vtkIdType i = tcoordOffsets[firstFace + face];
+             i < tcoordOffsets[firstFace + face + 1]; ++i)
         {
-          if (groupId < 0)
+          const vtkIdType iTCoordAbs = tcoordIds[i];
+          if (iTCoordAbs >= 0 && iTCoordAbs < numTCoordsValues)
           {
-            groupId = 0;
+            tcArray->SetTypedTuple(iTCoordAbs, &tcoordValues[2 * iTCoordAbs]);
           }
-          faceScalars->InsertNextValue(groupId);
         }
       }
-      else
-      {
-        // vtkDebugMacro(<<"Ignoring line: "<<rawLine);
-      }
-
-    } // (end of while loop)
-
-  } // (end of local scope section)
-
-  // we have finished with the file
-  fclose(in);
+    }
+  }
 
   const bool hasGroups = (groupId >= 0);
   const bool hasMaterials = (matcnt > 0);
@@ -69,6 +69,8 @@
 #include "vtk_zlib.h"
 #include "vtksys/RegularExpression.hxx"
 #include "vtksys/SystemTools.hxx"
+#include <algorithm>
+#include <memory>
 #include <sstream>
 #include <vector>
 
@@ -94,6 +96,7 @@
 #include "vtkPolygon.h"
 #include "vtkPyramid.h"
 #include "vtkQuad.h"
+#include "vtkSMPTools.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -275,6 +278,7 @@ struct vtkFoamReadValue;
 struct vtkFoamEntryValue;
 struct vtkFoamEntry;
 struct vtkFoamDict;
+struct vtkFoamFieldFile;
 
 //------------------------------------------------------------------------------
 // class vtkOpenFOAMReaderPrivate
@@ -449,11 +453,14 @@ private:
 
   // read and create cell/point fields
   void ConstructDimensions(vtkStdString*, vtkFoamDict*);
-  bool ReadFieldFile(vtkFoamIOobject*, vtkFoamDict*, const vtkStdString&, vtkDataArraySelection*);
+  bool ReadFieldFile(vtkFoamIOobject*, vtkFoamDict*, const vtkStdString&, vtkDataArraySelection*,
+    bool reportErrors = true, bool* isSkipped = nullptr);
+  void ReadFieldFiles(vtkIdType, vtkIdType, std::vector<std::unique_ptr<vtkFoamFieldFile>>&);
   vtkFloatArray* FillField(vtkFoamEntry*, vtkIdType, vtkFoamIOobject*, const vtkStdString&);
   void GetVolFieldAtTimeStep(vtkUnstructuredGrid*, vtkMultiBlockDataSet*, const vtkStdString&,
-    const bool isInternalField = false);
-  void GetPointFieldAtTimeStep(vtkUnstructuredGrid*, vtkMultiBlockDataSet*, const vtkStdString&);
+    const bool isInternalField = false, vtkFoamFieldFile* file = nullptr);
+  void GetPointFieldAtTimeStep(vtkUnstructuredGrid*, vtkMultiBlockDataSet*, const vtkStdString&,
+    vtkFoamFieldFile* file = nullptr);
   void AddArrayToFieldData(vtkDataSetAttributes*, vtkDataArray*, const vtkStdString&);
 
   // create lagrangian mesh/fields
@@ -479,7 +486,9 @@ struct vtkFoamLabelVectorVector
   // the array on the heap.
   //
   // Unlike std::vector, the array is not default initialized
-  // and behaves more like std::array in that manner.
+  // and behaves more like std::array in that manner. The heap
+  // array is kept when shrinking, so that reusing the same
+  // vector for all the cells allocates only a few times.
   template <typename T, size_t s = 2 * 64 / sizeof(T)>
   struct StackVector
   {
@@ -493,7 +502,7 @@ struct vtkFoamLabelVectorVector
 
     void resize(const size_t n)
     {
-      if (n > s)
+      if (n > capacity)
       {
         if (ptr != stck)
         {
@@ -501,6 +510,7 @@ struct vtkFoamLabelVectorVector
         }
 
         ptr = new T[n];
+        capacity = n;
       }
 
       internal_size = n;
@@ -524,6 +534,7 @@ struct vtkFoamLabelVectorVector
     T stck[s];
     T* ptr = stck;
     std::size_t internal_size = 0;
+    std::size_t capacity = s;
   };
 
   using CellType = StackVector<vtkTypeInt64>;
@@ -1127,6 +1138,19 @@ public:
   vtkOpenFOAMReader* GetReader() const { return this->Reader; }
 };
 
+//------------------------------------------------------------------------------
+// locale independent isspace() and isdigit(), which are inlined in the
+// number parsers and return false for EOF
+inline bool vtkFoamIsSpace(int c)
+{
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline bool vtkFoamIsDigit(int c)
+{
+  return static_cast<unsigned int>(c - '0') < 10U;
+}
+
 //------------------------------------------------------------------------------
 // class vtkFoamFile
 // read and tokenize the input.
@@ -1956,7 +1980,7 @@ vtkTypeInt64 vtkFoamFile::ReadIntValue()
   // skip prepending invalid chars
   // expanded the outermost loop in nextTokenHead() for performance
   int c;
-  while (isspace(c = this->Getc())) // isspace() accepts -1 as EOF
+  while (vtkFoamIsSpace(c = this->Getc()))
   {
     if (c == '\n')
     {
@@ -1986,7 +2010,7 @@ vtkTypeInt64 vtkFoamFile::ReadIntValue()
     }
   }
 
-  if (!isdigit(c)) // isdigit() accepts -1 as EOF
+  if (!vtkFoamIsDigit(c))
   {
     if (c == EOF)
     {
@@ -1999,7 +2023,7 @@ vtkTypeInt64 vtkFoamFile::ReadIntValue()
   }
 
   vtkTypeInt64 num = c - '0';
-  while (isdigit(c = this->Getc()))
+  while (vtkFoamIsDigit(c = this->Getc()))
   {
     num = 10 * num + c - '0';
   }
@@ -2022,7 +2046,7 @@ FloatType vtkFoamFile::ReadFloatValue()
   // skip prepending invalid chars
   // expanded the outermost loop in nextTokenHead() for performance
   int c;
-  while (isspace(c = this->Getc())) // isspace() accepts -1 as EOF
+  while (vtkFoamIsSpace(c = this->Getc()))
   {
     if (c == '\n')
     {
@@ -2052,35 +2076,57 @@ FloatType vtkFoamFile::ReadFloatValue()
     }
   }
 
-  if (!isdigit(c) && c != '.') // Attention: isdigit() accepts EOF
+  if (!vtkFoamIsDigit(c) && c != '.')
   {
     this->ThrowUnexpectedNondigitCharExecption(c);
   }
 
+  // accumulate the digits in an integer as long as it is exact, which is
+  // faster than accumulating them in a double and gives the same value
+  // for up to 15 digits, and a more accurate one for up to 19 digits
+  vtkTypeUInt64 digits = 0;
+  int nDigits = 0;
   double num = 0;
+  auto addDigit = [&](int digit) {
+    if (nDigits < 19)
+    {
+      digits = digits * 10 + static_cast<vtkTypeUInt64>(digit);
+      if (++nDigits == 19)
+      {
+        num = static_cast<double>(digits);
+      }
+    }
+    else
+    {
+      num = num * 10.0 + digit;
+    }
+  };
 
   // read integer part (before '.')
   if (c != '.')
   {
-    num = c - '0';
-    while (isdigit(c = this->Getc()))
+    addDigit(c - '0');
+    while (vtkFoamIsDigit(c = this->Getc()))
     {
-      num = num * 10.0 + (c - '0');
+      addDigit(c - '0');
     }
   }
 
   // read decimal part (after '.')
+  double divisor = 1.0;
   if (c == '.')
   {
-    double divisor = 1.0;
-
-    while (isdigit(c = this->Getc()))
+    while (vtkFoamIsDigit(c = this->Getc()))
     {
-      num = num * 10.0 + (c - '0');
+      addDigit(c - '0');
       divisor *= 10.0;
     }
-    num /= divisor;
   }
+  if (nDigits < 19)
+  {
+    num = static_cast<double>(digits);
+  }
+  num /= divisor;
 
   // read exponent part
   if (c == 'E' || c == 'e')
@@ -2100,7 +2146,7 @@ FloatType vtkFoamFile::ReadFloatValue()
       c = this->Getc();
     }
 
-    while (isdigit(c))
+    while (vtkFoamIsDigit(c))
     {
       eval = eval * 10 + (c - '0');
       c = this->Getc();
@@ -3490,6 +3536,27 @@ public:
   }
 };
 
+//------------------------------------------------------------------------------
+// class vtkFoamFieldFile
+// a field file read ahead of its conversion, possibly in another thread.
+// IsSkipped is set for a field disabled on the selection panel, which is not
+// converted; a file which could not be read is read again to report errors.
+struct vtkFoamFieldFile
+{
+  vtkFoamIOobject IO;
+  vtkFoamDict Dict;
+  bool IsRead;
+  bool IsSkipped;
+
+  vtkFoamFieldFile(const vtkStdString& casePath, vtkOpenFOAMReader* reader)
+    : IO(casePath, reader)
+    , Dict()
+    , IsRead(false)
+    , IsSkipped(false)
+  {
+  }
+};
+
 void vtkFoamIOobject::ReadHeader()
 {
   vtkFoamToken firstToken;
@@ -5688,14 +5755,17 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(vtkUnstructuredGrid* internalMe
 {
   bool use64BitLabels = this->Parent->Use64BitLabels;
 
-  constexpr vtkIdType maxNPoints = 256; // assume max number of points per cell
+  // initial number of points per cell, grown for larger polyhedra
   vtkIdList* cellPoints = vtkIdList::New();
-  cellPoints->SetNumberOfIds(maxNPoints);
+  cellPoints->SetNumberOfIds(256);
 
-  // assume max number of nPoints per face + points per cell
-  constexpr vtkIdType maxNPolyPoints = 1024;
+  // initial length of a polyhedron face stream, grown as well
   vtkIdList* polyPoints = vtkIdList::New();
-  polyPoints->SetNumberOfIds(maxNPolyPoints);
+  polyPoints->SetNumberOfIds(1024);
+
+  // buffers reused by all the polyhedra
+  vtkFoamLabelVectorVector::CellType faceJPoints;
+  std::vector<vtkTypeInt64> uniquePoints;
 
   vtkIdType nCells = (cellList == nullptr ? this->NumCells : cellList->GetNumberOfTuples());
   int nAdditionalPoints = 0;
@@ -6239,28 +6309,18 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(vtkUnstructuredGrid* internalMe
         this->AdditionalCellPoints->push_back(polyCellPoints);
         float centroid[3];
         centroid[0] = centroid[1] = centroid[2] = 0.0F;
+        uniquePoints.clear();
         for (size_t j = 0; j < cellFaces.size(); j++)
         {
           // remove duplicate points from faces
-          vtkTypeInt64 cellFacesJ = cellFaces[j];
-          vtkFoamLabelVectorVector::CellType faceJPoints;
-          facePoints.GetCell(cellFacesJ, faceJPoints);
+          facePoints.GetCell(cellFaces[j], faceJPoints);
           for (size_t k = 0; k < faceJPoints.size(); k++)
           {
             vtkTypeInt64 faceJPointK = faceJPoints[k];
-            bool foundDup = false;
-            for (vtkIdType l = 0; l < polyCellPoints->GetDataSize(); l++)
-            {
-              vtkTypeInt64 polyCellPoint = GetLabelValue(polyCellPoints, l, use64BitLabels);
-              if (polyCellPoint == faceJPointK)
-              {
-                foundDup = true;
-                break; // look no more
-              }
-            }
-            if (!foundDup)
+            if (std::find(uniquePoints.begin(), uniquePoints.end(), faceJPointK) ==
+              uniquePoints.end())
             {
-              AppendLabelValue(polyCellPoints, faceJPointK, use64BitLabels);
+              uniquePoints.push_back(faceJPointK);
               float* pointK = pointArray->GetPointer(3 * faceJPointK);
               centroid[0] += pointK[0];
               centroid[1] += pointK[1];
@@ -6268,7 +6328,12 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(vtkUnstructuredGrid* internalMe
             }
           }
         }
-        polyCellPoints->Squeeze();
+        // allocate the points of the cell once
+        polyCellPoints->SetNumberOfValues(static_cast<vtkIdType>(uniquePoints.size()));
+        for (size_t j = 0; j < uniquePoints.size(); j++)
+        {
+          SetLabelValue(polyCellPoints, static_cast<vtkIdType>(j), uniquePoints[j], use64BitLabels);
+        }
         const float weight = 1.0F / static_cast<float>(polyCellPoints->GetDataSize());
         centroid[0] *= weight;
         centroid[1] *= weight;
@@ -6384,62 +6449,34 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(vtkUnstructuredGrid* internalMe
       }
       else // don't decompose; use VTK_POLYHEDRON
       {
-        // get first face
-        vtkTypeInt64 cellFaces0 = cellFaces[0];
-        vtkFoamLabelVectorVector::CellType baseFacePoints;
-        facePoints.GetCell(cellFaces0, baseFacePoints);
-        size_t nPoints = baseFacePoints.size();
-        size_t nPolyPoints = baseFacePoints.size() + 1;
-        if (nPoints > static_cast<size_t>(maxNPoints) ||
-          nPolyPoints > static_cast<size_t>(maxNPolyPoints))
-        {
-          vtkErrorMacro(<< "Too large polyhedron at cellId = " << cellId);
-          cellPoints->Delete();
-          polyPoints->Delete();
-          return;
+        // size the point list and the face stream for all the face points
+        vtkIdType nFacePoints = 0;
+        for (size_t j = 0; j < cellFaces.size(); j++)
+        {
+          nFacePoints += facePoints.GetSize(cellFaces[j]);
         }
-        polyPoints->SetId(0, static_cast<vtkIdType>(baseFacePoints.size()));
-        vtkTypeInt64 faceOwnerValue = GetLabelValue(this->FaceOwner, cellFaces0, use64BitLabels);
-        if (faceOwnerValue == cellId)
+        if (cellPoints->GetNumberOfIds() < nFacePoints)
         {
-          // add first face to cell points
-          for (size_t j = 0; j < baseFacePoints.size(); j++)
-          {
-            vtkTypeInt64 pointJ = baseFacePoints[j];
-            cellPoints->SetId(static_cast<vtkIdType>(j), static_cast<vtkIdType>(pointJ));
-            polyPoints->SetId(static_cast<vtkIdType>(j + 1), static_cast<vtkIdType>(pointJ));
-          }
+          cellPoints->SetNumberOfIds(nFacePoints);
         }
-        else
+        const vtkIdType nStream = nFacePoints + static_cast<vtkIdType>(cellFaces.size());
+        if (polyPoints->GetNumberOfIds() < nStream)
         {
-          // if it is a _neighbor_ face flip the points
-          for (size_t j = 0; j < baseFacePoints.size(); j++)
-          {
-            vtkTypeInt64 pointJ = baseFacePoints[baseFacePoints.size() - 1 - j];
-            cellPoints->SetId(static_cast<vtkIdType>(j), static_cast<vtkIdType>(pointJ));
-            polyPoints->SetId(static_cast<vtkIdType>(j + 1), static_cast<vtkIdType>(pointJ));
-          }
+          polyPoints->SetNumberOfIds(nStream);
         }
+        vtkIdType* cellPointIds = cellPoints->GetPointer(0);
+        vtkIdType* faceStream = polyPoints->GetPointer(0);
 
         // loop through faces and create a list of all points
-        // j = 1 skip baseFace
-        for (size_t j = 1; j < cellFaces.size(); j++)
+        // all the points of the first face are unique
+        vtkIdType nPoints = 0;
+        for (size_t j = 0; j < cellFaces.size(); j++)
         {
-          // remove duplicate points from faces
           vtkTypeInt64 cellFacesJ = cellFaces[j];
-          vtkFoamLabelVectorVector::CellType faceJPoints;
           facePoints.GetCell(cellFacesJ, faceJPoints);
-          if (nPolyPoints >= static_cast<size_t>(maxNPolyPoints))
-          {
-            vtkErrorMacro(<< "Too large polyhedron at cellId = " << cellId);
-            cellPoints->Delete();
-            polyPoints->Delete();
-            return;
-          }
-          polyPoints->SetId(
-            static_cast<vtkIdType>(nPolyPoints++), static_cast<vtkIdType>(faceJPoints.size()));
+          *faceStream++ = static_cast<vtkIdType>(faceJPoints.size());
           int pointI, delta; // must be signed
-          faceOwnerValue = GetLabelValue(this->FaceOwner, cellFacesJ, use64BitLabels);
+          vtkTypeInt64 faceOwnerValue = GetLabelValue(this->FaceOwner, cellFacesJ, use64BitLabels);
           if (faceOwnerValue == cellId)
           {
             pointI = 0;
@@ -6453,44 +6490,21 @@ void vtkOpenFOAMReaderPrivate::InsertCellsToGrid(vtkUnstructuredGrid* internalMe
           }
           for (size_t k = 0; k < faceJPoints.size(); k++, pointI += delta)
           {
-            vtkTypeInt64 faceJPointK = faceJPoints[pointI];
-            bool foundDup = false;
-            for (vtkIdType l = 0; l < static_cast<vtkIdType>(nPoints); l++)
+            const vtkIdType faceJPointK = static_cast<vtkIdType>(faceJPoints[pointI]);
+            // remove duplicate points from faces
+            if (j == 0 ||
+              std::find(cellPointIds, cellPointIds + nPoints, faceJPointK) ==
+                cellPointIds + nPoints)
             {
-              if (cellPoints->GetId(l) == faceJPointK)
-              {
-                foundDup = true;
-                break; // look no more
-              }
+              cellPointIds[nPoints++] = faceJPointK;
             }
-            if (!foundDup)
-            {
-              if (nPoints >= static_cast<size_t>(maxNPoints))
-              {
-                vtkErrorMacro(<< "Too large polyhedron at cellId = " << cellId);
-                cellPoints->Delete();
-                polyPoints->Delete();
-                return;
-              }
-              cellPoints->SetId(
-                static_cast<vtkIdType>(nPoints++), static_cast<vtkIdType>(faceJPointK));
-            }
-            if (nPolyPoints >= static_cast<size_t>(maxNPolyPoints))
-            {
-              vtkErrorMacro(<< "Too large polyhedron at cellId = " << cellId);
-              cellPoints->Delete();
-              polyPoints->Delete();
-              return;
-            }
-            polyPoints->SetId(
-              static_cast<vtkIdType>(nPolyPoints++), static_cast<vtkIdType>(faceJPointK));
+            *faceStream++ = faceJPointK;
           }
         }
 
         // create the poly cell and insert it into the mesh
-        internalMesh->InsertNextCell(VTK_POLYHEDRON, static_cast<vtkIdType>(nPoints),
-          cellPoints->GetPointer(0), static_cast<vtkIdType>(cellFaces.size()),
-          polyPoints->GetPointer(0));
+        internalMesh->InsertNextCell(VTK_POLYHEDRON, nPoints, cellPointIds,
+          static_cast<vtkIdType>(cellFaces.size()), polyPoints->GetPointer(0));
       }
     }
   }
@@ -7224,7 +7238,8 @@ void vtkOpenFOAMReaderPrivate::InterpolateCellToPoint(vtkFloatArray* pData, vtkF
 
 //------------------------------------------------------------------------------
 bool vtkOpenFOAMReaderPrivate::ReadFieldFile(vtkFoamIOobject* ioPtr, vtkFoamDict* dictPtr,
-  const vtkStdString& varName, vtkDataArraySelection* selection)
+  const vtkStdString& varName, vtkDataArraySelection* selection, bool reportErrors,
+  bool* isSkipped)
 {
   const vtkStdString varPath(this->CurrentTimeRegionPath() + "/" + varName);
 
@@ -7232,7 +7247,11 @@ bool vtkOpenFOAMReaderPrivate::ReadFieldFile(vtkFoamIOobject* ioPtr, vtkFoamDict
   vtkFoamIOobject& io = *ioPtr;
   if (!io.Open(varPath))
   {
-    vtkErrorMacro(<< "Error opening " << io.GetFileName().c_str() << ": " << io.GetError().c_str());
+    if (reportErrors)
+    {
+      vtkErrorMacro(<< "Error opening " << io.GetFileName().c_str() << ": "
+                    << io.GetError().c_str());
+    }
     return false;
   }
 
@@ -7240,6 +7259,10 @@ bool vtkOpenFOAMReaderPrivate::ReadFieldFile(vtkFoamIOobject* ioPtr, vtkFoamDict
   if (selection->ArrayExists(io.GetObjectName().c_str()) &&
     !selection->ArrayIsEnabled(io.GetObjectName().c_str()))
   {
+    if (isSkipped)
+    {
+      *isSkipped = true;
+    }
     return false;
   }
 
@@ -7247,19 +7270,66 @@ bool vtkOpenFOAMReaderPrivate::ReadFieldFile(vtkFoamIOobject* ioPtr, vtkFoamDict
   vtkFoamDict& dict = *dictPtr;
   if (!dict.Read(io))
   {
-    vtkErrorMacro(<< "Error reading line " << io.GetLineNumber() << " of "
-                  << io.GetFileName().c_str() << ": " << io.GetError().c_str());
+    if (reportErrors)
+    {
+      vtkErrorMacro(<< "Error reading line " << io.GetLineNumber() << " of "
+                    << io.GetFileName().c_str() << ": " << io.GetError().c_str());
+    }
     return false;
   }
 
   if (dict.GetType() != vtkFoamToken::DICTIONARY)
   {
-    vtkErrorMacro(<< "File " << io.GetFileName().c_str() << "is not valid as a field file");
+    if (reportErrors)
+    {
+      vtkErrorMacro(<< "File " << io.GetFileName().c_str() << "is not valid as a field file");
+    }
     return false;
   }
   return true;
 }
 
+//------------------------------------------------------------------------------
+// read the field files first to last - 1 of the vol, dimensioned and point
+// fields concurrently. Errors are not reported here: the files which could
+// not be read, but were not skipped, are read again by
+// GetVolFieldAtTimeStep() and GetPointFieldAtTimeStep(), which report them.
+void vtkOpenFOAMReaderPrivate::ReadFieldFiles(
+  vtkIdType first, vtkIdType last, std::vector<std::unique_ptr<vtkFoamFieldFile>>& files)
+{
+  files.clear();
+  for (vtkIdType i = first; i < last; ++i)
+  {
+    files.emplace_back(new vtkFoamFieldFile(this->CasePath, this->Parent));
+  }
+
+  const vtkIdType nVolFields = this->VolFieldFiles->GetNumberOfValues();
+  const vtkIdType nCellFields = nVolFields + this->DimFieldFiles->GetNumberOfValues();
+  vtkSMPTools::For(first, last, 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      vtkFoamFieldFile& file = *files[i - first];
+      if (i < nVolFields)
+      {
+        file.IsRead = this->ReadFieldFile(&file.IO, &file.Dict, this->VolFieldFiles->GetValue(i),
+          this->Parent->CellDataArraySelection, false, &file.IsSkipped);
+      }
+      else if (i < nCellFields)
+      {
+        file.IsRead = this->ReadFieldFile(&file.IO, &file.Dict,
+          this->DimFieldFiles->GetValue(i - nVolFields), this->Parent->CellDataArraySelection,
+          false, &file.IsSkipped);
+      }
+      else
+      {
+        file.IsRead = this->ReadFieldFile(&file.IO, &file.Dict,
+          this->PointFieldFiles->GetValue(i - nCellFields),
+          this->Parent->PointDataArraySelection, false, &file.IsSkipped);
+      }
+    }
+  });
+}
+
 //------------------------------------------------------------------------------
 vtkFloatArray* vtkOpenFOAMReaderPrivate::FillField(vtkFoamEntry* entryPtr, vtkIdType nElements,
   vtkFoamIOobject* ioPtr, const vtkStdString& fieldType)
@@ -7493,15 +7563,24 @@ void vtkOpenFOAMReaderPrivate::ConstructDimensions(vtkStdString* dimString, vtkF
 //------------------------------------------------------------------------------
 // read volume or internal field at a timestep
 void vtkOpenFOAMReaderPrivate::GetVolFieldAtTimeStep(vtkUnstructuredGrid* internalMesh,
-  vtkMultiBlockDataSet* boundaryMesh, const vtkStdString& varName, const bool isInternalField)
+  vtkMultiBlockDataSet* boundaryMesh, const vtkStdString& varName, const bool isInternalField,
+  vtkFoamFieldFile* file)
 {
   bool use64BitLabels = this->Parent->GetUse64BitLabels();
-  vtkFoamIOobject io(this->CasePath, this->Parent);
-  vtkFoamDict dict;
-  if (!this->ReadFieldFile(&io, &dict, varName, this->Parent->CellDataArraySelection))
+  vtkFoamIOobject ownIO(this->CasePath, this->Parent);
+  vtkFoamDict ownDict;
+  if (file != nullptr && file->IsSkipped)
+  {
+    return;
+  }
+  const bool isRead = (file != nullptr && file->IsRead);
+  if (!isRead &&
+    !this->ReadFieldFile(&ownIO, &ownDict, varName, this->Parent->CellDataArraySelection))
   {
     return;
   }
+  vtkFoamIOobject& io = (isRead ? file->IO : ownIO);
+  vtkFoamDict& dict = (isRead ? file->Dict : ownDict);
 
   // For internal field (eg, volScalarField::Internal)
   const auto colons = io.GetClassName().find("::Internal");
@@ -7822,15 +7901,23 @@ void vtkOpenFOAMReaderPrivate::GetVolFieldAtTimeStep(vtkUnstructuredGrid* intern
 //------------------------------------------------------------------------------
 // read point field at a timestep
 void vtkOpenFOAMReaderPrivate::GetPointFieldAtTimeStep(vtkUnstructuredGrid* internalMesh,
-  vtkMultiBlockDataSet* boundaryMesh, const vtkStdString& varName)
+  vtkMultiBlockDataSet* boundaryMesh, const vtkStdString& varName, vtkFoamFieldFile* file)
 {
   bool use64BitLabels = this->Parent->GetUse64BitLabels();
-  vtkFoamIOobject io(this->CasePath, this->Parent);
-  vtkFoamDict dict;
-  if (!this->ReadFieldFile(&io, &dict, varName, this->Parent->PointDataArraySelection))
+  vtkFoamIOobject ownIO(this->CasePath, this->Parent);
+  vtkFoamDict ownDict;
+  if (file != nullptr && file->IsSkipped)
+  {
+    return;
+  }
+  const bool isRead = (file != nullptr && file->IsRead);
+  if (!isRead &&
+    !this->ReadFieldFile(&ownIO, &ownDict, varName, this->Parent->PointDataArraySelection))
   {
     return;
   }
+  vtkFoamIOobject& io = (isRead ? file->IO : ownIO);
+  vtkFoamDict& dict = (isRead ? file->Dict : ownDict);
 
   if (io.GetClassName().substr(0, 5) != "point")
   {
@@ -8726,25 +8813,45 @@ int vtkOpenFOAMReaderPrivate::RequestData(vtkMultiBlockDataSet* output, bool rec
       const vtkIdType nFieldsToRead = (this->VolFieldFiles->GetNumberOfValues() +
         this->DimFieldFiles->GetNumberOfValues() + this->PointFieldFiles->GetNumberOfValues());
 
-      for (vtkIdType i = 0; i < this->VolFieldFiles->GetNumberOfValues(); ++i)
-      {
-        this->GetVolFieldAtTimeStep(
-          this->InternalMesh, this->BoundaryMesh, this->VolFieldFiles->GetValue(i));
-        this->Parent->UpdateProgress(0.5 + (0.5 * ++nFieldsRead) / nFieldsToRead);
-      }
-      for (vtkIdType i = 0; i < this->DimFieldFiles->GetNumberOfValues(); ++i)
+      // with several threads, parse as many files concurrently, and
+      // convert them in order. Parsing a batch at a time bounds the memory
+      // used by the dictionaries.
+      const vtkIdType nVolFields = this->VolFieldFiles->GetNumberOfValues();
+      const vtkIdType nCellFields = nVolFields + this->DimFieldFiles->GetNumberOfValues();
+      const vtkIdType batchSize = (this->Parent->ConcurrentReads > 0
+          ? this->Parent->ConcurrentReads
+          : vtkSMPTools::GetEstimatedNumberOfThreads());
+      std::vector<std::unique_ptr<vtkFoamFieldFile>> files;
+      for (vtkIdType first = 0; first < nFieldsToRead; first += batchSize)
       {
-        this->GetVolFieldAtTimeStep(
-          this->InternalMesh, this->BoundaryMesh, this->DimFieldFiles->GetValue(i),
-          true // Internal field
-        );
-        this->Parent->UpdateProgress(0.5 + (0.5 * ++nFieldsRead) / nFieldsToRead);
-      }
-      for (vtkIdType i = 0; i < this->PointFieldFiles->GetNumberOfValues(); ++i)
-      {
-        this->GetPointFieldAtTimeStep(
-          this->InternalMesh, this->BoundaryMesh, this->PointFieldFiles->GetValue(i));
-        this->Parent->UpdateProgress(0.5 + (0.5 * ++nFieldsRead) / nFieldsToRead);
+        const vtkIdType last = std::min(first + batchSize, nFieldsToRead);
+        if (batchSize > 1)
+        {
+          this->ReadFieldFiles(first, last, files);
+        }
+        for (vtkIdType i = first; i < last; ++i)
+        {
+          vtkFoamFieldFile* file = (batchSize > 1 ? files[i - first].get() : nullptr);
+          if (i < nVolFields)
+          {
+            this->GetVolFieldAtTimeStep(this->InternalMesh, this->BoundaryMesh,
+              this->VolFieldFiles->GetValue(i), false, file);
+          }
+          else if (i < nCellFields)
+          {
+            this->GetVolFieldAtTimeStep(this->InternalMesh, this->BoundaryMesh,
+              this->DimFieldFiles->GetValue(i - nVolFields),
+              true, // Internal field
+              file);
+          }
+          else
+          {
+            this->GetPointFieldAtTimeStep(this->InternalMesh, this->BoundaryMesh,
+              this->PointFieldFiles->GetValue(i - nCellFields), file);
+          }
+          this->Parent->UpdateProgress(0.5 + (0.5 * ++nFieldsRead) / nFieldsToRead);
+        }
+        files.clear();
       }
     }
     // read lagrangian mesh and fields
@@ -8926,6 +9033,8 @@ vtkOpenFOAMReader::vtkOpenFOAMReader()
 
   this->CurrentReaderIndex = 0;
   this->NumberOfReaders = 0;
+  this->UpdatingReadersConcurrently = false;
+  this->ConcurrentReads = 0;
   this->Use64BitLabels = false;
   this->Use64BitFloats = true;
   this->Use64BitLabelsOld = false;
@@ -9176,7 +9285,10 @@ int vtkOpenFOAMReader::RequestData(vtkInformation* vtkNotUsed(request),
       .empty())
   {
     ret = reader->RequestData(output, recreateInternalMesh, recreateBoundaryMesh, updateVariables);
-    this->Parent->CurrentReaderIndex++;
+    if (!this->Parent->UpdatingReadersConcurrently)
+    {
+      this->Parent->CurrentReaderIndex++;
+    }
   }
   else
   {
@@ -9202,7 +9314,10 @@ int vtkOpenFOAMReader::RequestData(vtkInformation* vtkNotUsed(request),
         ret = 0;
       }
       subOutput->Delete();
-      this->Parent->CurrentReaderIndex++;
+      if (!this->Parent->UpdatingReadersConcurrently)
+      {
+        this->Parent->CurrentReaderIndex++;
+      }
     }
   }
 
@@ -9456,6 +9571,10 @@ void vtkOpenFOAMReader::UpdateStatus()
 //------------------------------------------------------------------------------
 void vtkOpenFOAMReader::UpdateProgress(double amount)
 {
+  if (this->Parent->UpdatingReadersConcurrently)
+  {
+    return;
+  }
   this->vtkAlgorithm::UpdateProgress(
     (static_cast<double>(this->Parent->CurrentReaderIndex) + amount) /
     static_cast<double>(this->Parent->NumberOfReaders));
@@ -422,6 +422,13 @@ protected:
   int NumberOfReaders;
   // index of the active reader
   int CurrentReaderIndex;
+  // set while the reader instances are updated concurrently, which then
+  // neither report progress nor change the active reader index
+  bool UpdatingReadersConcurrently;
+  // the number of field files, or of processor subdirectories for
+  // vtkPOpenFOAMReader, read concurrently. 0, the default, uses the number
+  // of threads of vtkSMPTools.
+  int ConcurrentReads;
 
   vtkOpenFOAMReader();
   ~vtkOpenFOAMReader() override;
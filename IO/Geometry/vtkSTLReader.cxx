@@ -19,6 +19,7 @@
 #include "vtkCellData.h"
 #include "vtkErrorCode.h"
 #include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
 #include "vtkIncrementalPointLocator.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
@@ -26,6 +27,7 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPolyData.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
@@ -33,7 +35,9 @@
 #include <algorithm>
 #include <cctype>
 #include <cstdlib>
+#include <cstring>
 #include <string>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 vtkStandardNewMacro(vtkSTLReader);
@@ -41,6 +45,9 @@ vtkStandardNewMacro(vtkSTLReader);
 #define VTK_ASCII 0
 #define VTK_BINARY 1
 
+// Binary files are read by blocks of this many facets.
+#define VTK_STL_BLOCK_SIZE 65536
+
 vtkCxxSetObjectMacro(vtkSTLReader, Locator, vtkIncrementalPointLocator);
 vtkCxxSetObjectMacro(vtkSTLReader, BinaryHeader, vtkUnsignedCharArray);
 
@@ -175,6 +182,12 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
     }
     locator->InitPointInsertion(mergedPts, newPts->GetBounds());
 
+    // Insert all the points at once, which vtkMergePoints does in parallel.
+    // The points of the triangles are in order, so the merged points are
+    // numbered as if they were inserted triangle by triangle.
+    std::vector<vtkIdType> pointMap(newPts->GetNumberOfPoints());
+    locator->InsertUniquePoints(newPts, pointMap.data());
+
     int nextCell = 0;
     const vtkIdType* pts = nullptr;
     vtkIdType npts;
@@ -183,9 +196,7 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
       vtkIdType nodes[3];
       for (int i = 0; i < 3; i++)
       {
-        double x[3];
-        newPts->GetPoint(pts[i], x);
-        locator->InsertUniquePoint(x, nodes[i]);
+        nodes[i] = pointMap[pts[i]];
       }
 
       if (nodes[0] != nodes[1] && nodes[0] != nodes[2] && nodes[1] != nodes[2])
@@ -225,13 +236,6 @@ int vtkSTLReader::RequestData(vtkInformation* vtkNotUsed(request),
 //------------------------------------------------------------------------------
 bool vtkSTLReader::ReadBinarySTL(FILE* fp, vtkPoints* newPts, vtkCellArray* newPolys)
 {
-  struct facet_t_t
-  {
-    float n[3], v1[3], v2[3], v3[3];
-    unsigned short junk;
-  };
-  using facet_t = struct facet_t_t;
-
   vtkDebugMacro(<< "Reading BINARY STL file");
 
   //  File is read to obtain raw information as well as bounding box
@@ -284,42 +288,54 @@ bool vtkSTLReader::ReadBinarySTL(FILE* fp, vtkPoints* newPts, vtkCellArray* newP
   }
 
   // now we can allocate the memory we need for this STL file
+  newPts->SetDataTypeToFloat();
   newPts->Allocate(numTris * 3);
-  newPolys->AllocateEstimate(numTris, 3);
-
-  facet_t facet;
-  for (int i = 0; fread(&facet, 50, 1, fp) > 0; i++)
+  vtkFloatArray* coords = vtkFloatArray::FastDownCast(newPts->GetData());
+
+  // Read the facets by blocks, and copy their vertices concurrently. A facet
+  // is made of the normal and the three vertices (twelve little endian
+  // floats), and of the 2-byte attribute.
+  const size_t facetSize = 50;
+  std::vector<char> facets(facetSize * VTK_STL_BLOCK_SIZE);
+  vtkIdType numFacets = 0;
+  size_t numRead;
+  while ((numRead = fread(facets.data(), facetSize, VTK_STL_BLOCK_SIZE, fp)) > 0)
   {
-    vtkByteSwap::Swap4LE(facet.n);
-    vtkByteSwap::Swap4LE(facet.n + 1);
-    vtkByteSwap::Swap4LE(facet.n + 2);
-
-    vtkByteSwap::Swap4LE(facet.v1);
-    vtkByteSwap::Swap4LE(facet.v1 + 1);
-    vtkByteSwap::Swap4LE(facet.v1 + 2);
-
-    vtkByteSwap::Swap4LE(facet.v2);
-    vtkByteSwap::Swap4LE(facet.v2 + 1);
-    vtkByteSwap::Swap4LE(facet.v2 + 2);
-
-    vtkByteSwap::Swap4LE(facet.v3);
-    vtkByteSwap::Swap4LE(facet.v3 + 1);
-    vtkByteSwap::Swap4LE(facet.v3 + 2);
-
-    vtkIdType pts[3];
-    pts[0] = newPts->InsertNextPoint(facet.v1);
-    pts[1] = newPts->InsertNextPoint(facet.v2);
-    pts[2] = newPts->InsertNextPoint(facet.v3);
-
-    newPolys->InsertNextCell(3, pts);
+    float* vertices = coords->WritePointer(9 * numFacets, 9 * static_cast<vtkIdType>(numRead));
+    vtkSMPTools::For(0, static_cast<vtkIdType>(numRead), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        memcpy(vertices + 9 * i, facets.data() + facetSize * i + 3 * sizeof(float),
+          9 * sizeof(float));
+      }
+      vtkByteSwap::Swap4LERange(vertices + 9 * begin, 9 * (end - begin));
+    });
+    numFacets += static_cast<vtkIdType>(numRead);
 
-    if ((i % 100000) == 0 && i != 0)
+    vtkDebugMacro(<< "triangle# " << numFacets);
+    if (numTris > 0)
     {
-      vtkDebugMacro(<< "triangle# " << i);
-      this->UpdateProgress(static_cast<double>(i) / numTris);
+      this->UpdateProgress(std::min(1.0, static_cast<double>(numFacets) / numTris));
     }
   }
 
+  // Each facet is a triangle made of its own three points.
+  vtkNew<vtkIdTypeArray> offsets;
+  offsets->SetNumberOfValues(numFacets + 1);
+  vtkNew<vtkIdTypeArray> connectivity;
+  connectivity->SetNumberOfValues(3 * numFacets);
+  vtkSMPTools::For(0, numFacets + 1, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType i = begin; i < end; ++i)
+    {
+      offsets->SetValue(i, 3 * i);
+    }
+    for (vtkIdType i = 3 * begin; i < 3 * std::min(end, numFacets); ++i)
+    {
+      connectivity->SetValue(i, i);
+    }
+  });
+  newPolys->SetData(offsets, connectivity);
+
   return true;
 }
 
@@ -25,7 +25,12 @@
  * definitions. By setting the Merging boolean you can control whether the
  * point data is merged after reading. Merging is performed by default,
  * however, merging requires a large amount of temporary storage since a
- * 3D hash table must be constructed.
+ * 3D hash table must be constructed. The points are merged all at once with
+ * vtkIncrementalPointLocator::InsertUniquePoints(), which the default
+ * vtkMergePoints locator does in parallel.
+ *
+ * Binary files are read by large blocks of facets, which are decoded in
+ * parallel.
  *
  * @warning
  * Binary files written on one system may not be readable on other systems.
@@ -0,0 +1,99 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestDelimitedTextReaderChunks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include <vtkDelimitedTextReader.h>
+#include <vtkDoubleArray.h>
+#include <vtkIntArray.h>
+#include <vtkNew.h>
+#include <vtkStringArray.h>
+#include <vtkTable.h>
+
+#include <sstream>
+#include <string>
+
+// This test reads a text large enough to be parsed in several chunks, with
+// quoted and escaped fields and numeric columns, then the same text with a
+// byte which is neither US-ASCII nor UTF-8, which is not read.
+int TestDelimitedTextReaderChunks(int, char*[])
+{
+  const int numRows = 100000;
+  std::ostringstream text;
+  text << "id,name,value,note\n";
+  for (int i = 0; i < numRows; ++i)
+  {
+    text << i << ",\"name, " << i << "\"," << i * 0.5 << ",";
+    if (i % 3 == 0)
+    {
+      text << "tab\\t" << i;
+    }
+    else
+    {
+      text << "note " << i;
+    }
+    text << (i % 2 ? "\r\n" : "\n");
+  }
+
+  vtkNew<vtkDelimitedTextReader> reader;
+  reader->SetHaveHeaders(true);
+  reader->SetReadFromInputString(1);
+  reader->SetInputString(text.str().c_str());
+  reader->SetDetectNumericColumns(true);
+  reader->Update();
+
+  vtkTable* table = reader->GetOutput();
+  if (table->GetNumberOfRows() != numRows || table->GetNumberOfColumns() != 4)
+  {
+    cout << "ERROR: Wrong number of rows or columns: " << table->GetNumberOfRows() << ", "
+         << table->GetNumberOfColumns() << endl;
+    return 1;
+  }
+
+  vtkIntArray* ids = vtkArrayDownCast<vtkIntArray>(table->GetColumnByName("id"));
+  vtkStringArray* names = vtkArrayDownCast<vtkStringArray>(table->GetColumnByName("name"));
+  vtkDoubleArray* values = vtkArrayDownCast<vtkDoubleArray>(table->GetColumnByName("value"));
+  vtkStringArray* notes = vtkArrayDownCast<vtkStringArray>(table->GetColumnByName("note"));
+  if (!ids || !names || !values || !notes)
+  {
+    cout << "ERROR: Wrong column names or types" << endl;
+    return 1;
+  }
+  for (int i = 0; i < numRows; ++i)
+  {
+    std::ostringstream name;
+    name << "name, " << i;
+    std::ostringstream note;
+    note << (i % 3 == 0 ? "tab\t" : "note ") << i;
+    if (ids->GetValue(i) != i || names->GetValue(i) != name.str() ||
+      values->GetValue(i) != i * 0.5 || notes->GetValue(i) != note.str())
+    {
+      cout << "ERROR: Wrong row " << i << endl;
+      return 1;
+    }
+  }
+
+  const std::string invalidText = text.str() + "invalid,\xff\n";
+  vtkNew<vtkDelimitedTextReader> invalidReader;
+  invalidReader->SetHaveHeaders(true);
+  invalidReader->SetReadFromInputString(1);
+  invalidReader->SetInputString(invalidText.c_str());
+  invalidReader->Update();
+  if (invalidReader->GetOutput()->GetNumberOfRows() != 0)
+  {
+    cout << "ERROR: Invalid text was read" << endl;
+    return 1;
+  }
+
+  return 0;
+}
@@ -25,6 +25,7 @@
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -36,6 +37,8 @@
 #include "vtkTextCodecFactory.h"
 #include "vtksys/FStream.hxx"
 
+#include <vtk_utf8.h>
+
 #include <algorithm>
 #include <iostream>
 #include <iterator>
@@ -47,6 +50,9 @@
 
 #include <cctype>
 
+// The text is parsed concurrently in chunks of records of about this size.
+#define VTK_DELIMITED_TEXT_READER_CHUNK_SIZE (1 << 20)
+
 ////////////////////////////////////////////////////////////////////////////////
 // DelimitedTextIterator
 
@@ -343,6 +349,388 @@ private:
   vtkUnicodeString::value_type WithinString;
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// DelimitedTextChunks
+
+/// Parses US-ASCII or UTF-8 text into records and fields like
+/// DelimitedTextIterator, when all the delimiters are US-ASCII characters.
+/// The text is split into chunks of records, which are validated and parsed
+/// concurrently, and the fields of the chunks are then inserted into the
+/// vtkTable. Invalid text throws the exceptions of the text codecs.
+
+class DelimitedTextChunks
+{
+public:
+  DelimitedTextChunks(
+    bool utf8_text, bool have_headers, bool merg_cons_delimiters, bool use_string_delimeter)
+    : UTF8Text(utf8_text)
+    , HaveHeaders(have_headers)
+    , MergeConsDelims(merg_cons_delimiters)
+    , UseStringDelimiter(use_string_delimeter)
+  {
+    std::fill(this->Types, this->Types + 256, 0);
+  }
+
+  // Returns false if the delimiters are not all US-ASCII characters.
+  bool SetDelimiters(const vtkUnicodeString& record_delimiters,
+    const vtkUnicodeString& field_delimiters, const vtkUnicodeString& string_delimiters,
+    const vtkUnicodeString& whitespace, const vtkUnicodeString& escape)
+  {
+    return this->AddType(record_delimiters, RecordDelimiter) &&
+      this->AddType(field_delimiters, FieldDelimiter) &&
+      this->AddType(string_delimiters, StringDelimiter) &&
+      this->AddType(whitespace, Whitespace) && this->AddType(escape, EscapeDelimiter);
+  }
+
+  void Parse(const std::string& text, vtkTable* const output_table)
+  {
+    // Split the text after record delimiters which follow a character that
+    // leaves no escape sequence or adjacent delimiters pending, so that each
+    // chunk starts in the same state as the text.
+    std::vector<Chunk> chunks(1);
+    const char* const begin = text.data();
+    const char* const end = begin + text.size();
+    const unsigned char pending = RecordDelimiter | FieldDelimiter | Whitespace | EscapeDelimiter;
+    chunks[0].Begin = begin;
+    for (const char* pos = begin + VTK_DELIMITED_TEXT_READER_CHUNK_SIZE; pos < end; ++pos)
+    {
+      if ((this->GetType(pos[-1]) & RecordDelimiter) && !(this->GetType(pos[-2]) & pending))
+      {
+        chunks.back().End = pos;
+        chunks.emplace_back();
+        chunks.back().Begin = pos;
+        pos += VTK_DELIMITED_TEXT_READER_CHUNK_SIZE - 1;
+      }
+    }
+    chunks.back().End = end;
+
+    const vtkIdType numChunks = static_cast<vtkIdType>(chunks.size());
+    vtkSMPTools::For(0, numChunks, [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType i = first; i < last; ++i)
+      {
+        this->ParseChunk(chunks[i], i == numChunks - 1);
+      }
+    });
+
+    // Report the first invalid character, as the codecs do. The chunks start
+    // after a US-ASCII record delimiter, so no UTF-8 sequence spans two chunks.
+    for (const Chunk& chunk : chunks)
+    {
+      if (chunk.Invalid && this->UTF8Text)
+      {
+        throw utf8::invalid_utf8(static_cast<uint8_t>(*chunk.Invalid));
+      }
+      else if (chunk.Invalid)
+      {
+        throw std::runtime_error("Detected a character that isn't valid US-ASCII.");
+      }
+    }
+
+    // The fields of the first record create the columns, which replace the
+    // previous ones with the same name.
+    for (const Field& field : chunks[0].Fields)
+    {
+      if (field.Record != 0)
+      {
+        break;
+      }
+      if (field.Index >= output_table->GetNumberOfColumns())
+      {
+        vtkStringArray* array = vtkStringArray::New();
+        if (this->HaveHeaders)
+        {
+          array->SetName(field.Value.c_str());
+        }
+        else
+        {
+          std::stringstream buffer;
+          buffer << "Field " << field.Index;
+          array->SetName(buffer.str().c_str());
+        }
+        output_table->AddColumn(array);
+        array->Delete();
+      }
+    }
+    std::vector<vtkStringArray*> columns;
+    for (vtkIdType i = 0; i != output_table->GetNumberOfColumns(); ++i)
+    {
+      columns.push_back(vtkArrayDownCast<vtkStringArray>(output_table->GetColumn(i)));
+    }
+
+    // Number the records of the chunks, and size the columns to their last
+    // value.
+    const vtkIdType firstRecord = this->HaveHeaders ? 1 : 0;
+    const size_t numColumns = columns.size();
+    std::vector<vtkIdType> sizes(numColumns, 0);
+    vtkIdType numRecords = 0;
+    for (Chunk& chunk : chunks)
+    {
+      chunk.FirstRecord = numRecords - firstRecord;
+      for (size_t i = 0; i < chunk.Sizes.size() && i < numColumns; ++i)
+      {
+        if (chunk.Sizes[i] > 0)
+        {
+          sizes[i] = std::max(sizes[i], chunk.FirstRecord + chunk.Sizes[i]);
+        }
+      }
+      numRecords += chunk.NumberOfRecords;
+    }
+
+    // When it is destroyed, DelimitedTextIterator calls Resize(n) on the
+    // columns whose length differs from the length n of the first one. That
+    // only reallocates them: a column allocated with more than n values is
+    // truncated to n values, but a shorter one keeps its length, and one
+    // allocated with exactly n values is left as is. The result depends on
+    // the growth of the columns by InsertValue(), from s to s + id + 2 values
+    // when inserting at id >= s, so the columns of these lengths are grown
+    // the same way here, and then resized by the iterator of RequestData.
+    std::vector<vtkIdType> allocated(numColumns, -1);
+    for (size_t i = 0; i < numColumns; ++i)
+    {
+      if (sizes[i] != sizes[0])
+      {
+        allocated[i] = 0;
+      }
+    }
+    if (std::count(allocated.begin(), allocated.end(), 0) > 0)
+    {
+      for (const Chunk& chunk : chunks)
+      {
+        for (const Field& field : chunk.Fields)
+        {
+          const vtkIdType rec_index = chunk.FirstRecord + field.Record;
+          if (rec_index >= 0 && field.Index < static_cast<vtkIdType>(numColumns) &&
+            allocated[field.Index] >= 0 && rec_index >= allocated[field.Index])
+          {
+            allocated[field.Index] += rec_index + 2;
+          }
+        }
+      }
+    }
+    for (size_t i = 0; i < numColumns; ++i)
+    {
+      if (!columns[i])
+      {
+        continue;
+      }
+      if (allocated[i] < 0)
+      {
+        columns[i]->SetNumberOfValues(sizes[i]);
+      }
+      else if (sizes[i] > 0)
+      {
+        columns[i]->Resize(allocated[i]);
+        columns[i]->InsertValue(sizes[i] - 1, vtkStdString());
+      }
+    }
+
+    vtkSMPTools::For(0, numChunks, [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType i = first; i < last; ++i)
+      {
+        Chunk& chunk = chunks[i];
+        for (Field& field : chunk.Fields)
+        {
+          const vtkIdType rec_index = chunk.FirstRecord + field.Record;
+          if (rec_index >= 0 && field.Index < static_cast<vtkIdType>(numColumns) &&
+            columns[field.Index])
+          {
+            columns[field.Index]->GetPointer(rec_index)->swap(field.Value);
+          }
+        }
+        std::vector<Field>().swap(chunk.Fields);
+      }
+    });
+  }
+
+private:
+  enum
+  {
+    RecordDelimiter = 1,
+    FieldDelimiter = 2,
+    StringDelimiter = 4,
+    Whitespace = 8,
+    EscapeDelimiter = 16
+  };
+
+  struct Field
+  {
+    vtkIdType Record; // in the chunk
+    vtkIdType Index;
+    std::string Value;
+  };
+
+  struct Chunk
+  {
+    const char* Begin = nullptr;
+    const char* End = nullptr;
+    const char* Invalid = nullptr; // the first character not valid in the encoding
+    std::vector<Field> Fields;
+    vtkIdType NumberOfRecords = 0;
+    vtkIdType FirstRecord = 0;     // the index in the columns of the first record
+    std::vector<vtkIdType> Sizes; // one past the last record of each field index
+  };
+
+  bool AddType(const vtkUnicodeString& characters, unsigned char type)
+  {
+    for (vtkUnicodeString::const_iterator it = characters.begin(); it != characters.end(); ++it)
+    {
+      if (*it > 0x7f)
+      {
+        return false;
+      }
+      this->Types[*it] |= type;
+    }
+    return true;
+  }
+
+  unsigned char GetType(char c) const { return this->Types[static_cast<unsigned char>(c)]; }
+
+  // The same state machine as DelimitedTextIterator, on the bytes of the
+  // text, which are the characters or parts of multi-byte characters which
+  // are not delimiters.
+  void ParseChunk(Chunk& chunk, bool last) const
+  {
+    // Validate the text as the codec would.
+    const char* invalid = this->UTF8Text
+      ? utf8::find_invalid(chunk.Begin, chunk.End)
+      : std::find_if(chunk.Begin, chunk.End, [](char c) { return (c & 0x80) != 0; });
+    if (invalid != chunk.End)
+    {
+      chunk.Invalid = invalid;
+      return;
+    }
+
+    vtkIdType record = 0;
+    vtkIdType index = 0;
+    std::string field;
+    bool recordAdjacent = true;
+    bool processEscapeSequence = false;
+    char withinString = 0;
+    bool inString = false;
+
+    auto insertField = [&]() {
+      chunk.Fields.push_back(Field{ record, index, field });
+      if (static_cast<vtkIdType>(chunk.Sizes.size()) <= index)
+      {
+        chunk.Sizes.resize(index + 1, 0);
+      }
+      chunk.Sizes[index] = record + 1;
+    };
+
+    for (const char* pos = chunk.Begin; pos != chunk.End; ++pos)
+    {
+      const char value = *pos;
+      const unsigned char type = this->GetType(value);
+
+      // Strip adjacent record delimiters and whitespace...
+      if (recordAdjacent && (type & (RecordDelimiter | Whitespace)))
+      {
+        continue;
+      }
+      recordAdjacent = false;
+
+      // Look for record delimiters ...
+      if (type & RecordDelimiter)
+      {
+        insertField();
+        record += 1;
+        index = 0;
+        field.clear();
+        recordAdjacent = true;
+        inString = false;
+        continue;
+      }
+
+      // Look for field delimiters unless we're in a string ...
+      if (!inString && (type & FieldDelimiter))
+      {
+        // Handle special case of merging consective delimiters ...
+        if (!(field.empty() && this->MergeConsDelims))
+        {
+          insertField();
+          index += 1;
+          field.clear();
+        }
+        continue;
+      }
+
+      // Check for start of escape sequence ...
+      if (!processEscapeSequence && (type & EscapeDelimiter))
+      {
+        processEscapeSequence = true;
+        continue;
+      }
+
+      // Process escape sequence ...
+      if (processEscapeSequence)
+      {
+        switch (value)
+        {
+          case '0':
+            break;
+          case 'a':
+            field += '\a';
+            break;
+          case 'b':
+            field += '\b';
+            break;
+          case 't':
+            field += '\t';
+            break;
+          case 'n':
+            field += '\n';
+            break;
+          case 'v':
+            field += '\v';
+            break;
+          case 'f':
+            field += '\f';
+            break;
+          case 'r':
+            field += '\r';
+            break;
+          default:
+            field += value;
+        }
+        processEscapeSequence = false;
+        continue;
+      }
+
+      // Start a string ...
+      if (!inString && (type & StringDelimiter) && this->UseStringDelimiter)
+      {
+        inString = true;
+        withinString = value;
+        field.clear();
+        continue;
+      }
+
+      // End a string ...
+      if (inString && withinString == value && this->UseStringDelimiter)
+      {
+        inString = false;
+        continue;
+      }
+
+      // Keep growing the current field ...
+      field += value;
+    }
+    chunk.NumberOfRecords = record;
+
+    // Handle files that do not end with a record delimiter ...
+    if (last && !field.empty() && !(this->GetType(field.back()) & (RecordDelimiter | Whitespace)))
+    {
+      insertField();
+    }
+  }
+
+  bool UTF8Text;
+  bool HaveHeaders;
+  bool MergeConsDelims;
+  bool UseStringDelimiter;
+  unsigned char Types[256];
+};
+
 } // End anonymous namespace
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -646,10 +1034,31 @@ int vtkDelimitedTextReader::ReadData(vtkTable* const output_table)
       this->UnicodeEscapeCharacter, this->HaveHeaders, this->UnicodeOutputArrays,
       this->MergeConsecutiveDelimiters, this->UseStringDelimiter, output_table);
 
-    vtkTextCodec::OutputIterator& outIter = iterator;
+    // US-ASCII or UTF-8 text whose delimiters are US-ASCII characters is read
+    // at once and parsed in chunks of records, unless only the first records
+    // are read. The iterator still gives the columns the same length when it
+    // is destroyed.
+    DelimitedTextChunks chunks(transCodec->IsA("vtkUTF8TextCodec") != 0, this->HaveHeaders,
+      this->MergeConsecutiveDelimiters, this->UseStringDelimiter);
+    if (!this->UnicodeOutputArrays && this->MaxRecords == 0 &&
+      (transCodec->IsA("vtkASCIITextCodec") || transCodec->IsA("vtkUTF8TextCodec")) &&
+      chunks.SetDelimiters(this->UnicodeRecordDelimiters, this->UnicodeFieldDelimiters,
+        this->UnicodeStringDelimiters, this->UnicodeWhitespace, this->UnicodeEscapeCharacter))
+    {
+      std::string text;
+      input_stream_pt->seekg(0, ios::end);
+      text.resize(static_cast<size_t>(input_stream_pt->tellg()));
+      input_stream_pt->seekg(0, ios::beg);
+      input_stream_pt->read(&text[0], text.size());
+      chunks.Parse(text, output_table);
+    }
+    else
+    {
+      vtkTextCodec::OutputIterator& outIter = iterator;
 
-    transCodec->ToUnicode(*input_stream_pt, outIter);
-    iterator.ReachedEndOfInput();
+      transCodec->ToUnicode(*input_stream_pt, outIter);
+      iterator.ReachedEndOfInput();
+    }
     transCodec->Delete();
 
     if (this->OutputPedigreeIds)
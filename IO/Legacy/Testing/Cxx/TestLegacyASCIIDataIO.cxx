@@ -0,0 +1,164 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestLegacyASCIIDataIO.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+// Roundtrip test for large arrays of various types in ascii legacy files,
+// which are read and written by chunks of values.
+
+#include "vtkCellArray.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkShortArray.h"
+#include "vtkSignedCharArray.h"
+#include "vtkTypeInt64Array.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkUnstructuredGridReader.h"
+#include "vtkUnstructuredGridWriter.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+// Enough points for the coordinates to span several chunks when read.
+const vtkIdType NumberOfPoints = 100003;
+
+template <typename ArrayT>
+ArrayT* AddArray(vtkUnstructuredGrid* grid, const char* name, int numComp)
+{
+  vtkNew<ArrayT> array;
+  array->SetName(name);
+  array->SetNumberOfComponents(numComp);
+  array->SetNumberOfTuples(NumberOfPoints);
+  grid->GetPointData()->AddArray(array);
+  return array;
+}
+
+// The signed char arrays are read as char arrays, so only the size of the
+// types is compared.
+bool CompareArrays(vtkDataArray* expected, vtkDataArray* actual)
+{
+  if (!actual || actual->GetDataTypeSize() != expected->GetDataTypeSize() ||
+    actual->GetNumberOfTuples() != expected->GetNumberOfTuples() ||
+    actual->GetNumberOfComponents() != expected->GetNumberOfComponents())
+  {
+    std::cerr << "Array " << expected->GetName() << " was not read back" << std::endl;
+    return false;
+  }
+  const int numComp = expected->GetNumberOfComponents();
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+  {
+    for (int j = 0; j < numComp; ++j)
+    {
+      if (actual->GetComponent(i, j) != expected->GetComponent(i, j))
+      {
+        std::cerr << "Array " << expected->GetName() << ": wrong value at " << i << ", " << j
+                  << ": " << actual->GetComponent(i, j) << " instead of "
+                  << expected->GetComponent(i, j) << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestLegacyASCIIDataIO(int, char*[])
+{
+  // Values which are written exactly in ascii.
+  vtkNew<vtkUnstructuredGrid> grid;
+  vtkNew<vtkPoints> points;
+  points->SetDataTypeToDouble();
+  points->SetNumberOfPoints(NumberOfPoints);
+  vtkIntArray* ints = AddArray<vtkIntArray>(grid, "Ints", 1);
+  vtkShortArray* shorts = AddArray<vtkShortArray>(grid, "Shorts", 2);
+  vtkSignedCharArray* chars = AddArray<vtkSignedCharArray>(grid, "Chars", 1);
+  vtkUnsignedCharArray* bytes = AddArray<vtkUnsignedCharArray>(grid, "Bytes", 3);
+  vtkTypeInt64Array* longs = AddArray<vtkTypeInt64Array>(grid, "Longs", 1);
+  vtkFloatArray* floats = AddArray<vtkFloatArray>(grid, "Floats", 1);
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    points->SetPoint(i, i * 0.25, -i * 1024.0, (i % 977) * 1e-3 + 1e300);
+    ints->SetValue(i, static_cast<int>((i * 104729) % 2000003 - 1000001));
+    shorts->SetTypedComponent(i, 0, static_cast<short>(i % 65536 - 32768));
+    shorts->SetTypedComponent(i, 1, static_cast<short>(-i % 32768));
+    chars->SetValue(i, static_cast<signed char>(i % 256 - 128));
+    for (int j = 0; j < 3; ++j)
+    {
+      bytes->SetTypedComponent(i, j, static_cast<unsigned char>((i + j) % 256));
+    }
+    longs->SetValue(i, (i % 2 ? -1 : 1) * i * 1000000007LL);
+    floats->SetValue(i, (i % 20000) * 0.5f - 5000.0f);
+  }
+  grid->SetPoints(points);
+  vtkIdType numCells = NumberOfPoints / 2;
+  grid->Allocate(numCells);
+  for (vtkIdType i = 0; i < numCells; ++i)
+  {
+    vtkIdType ids[2] = { 2 * i, 2 * i + 1 };
+    grid->InsertNextCell(i % 3 ? VTK_LINE : VTK_POLY_VERTEX, 2, ids);
+  }
+
+  vtkNew<vtkUnstructuredGridWriter> writer;
+  writer->SetFileTypeToASCII();
+  writer->WriteToOutputStringOn();
+  writer->SetInputData(grid);
+  writer->Write();
+  const std::string text = writer->GetOutputStdString();
+
+  vtkNew<vtkUnstructuredGridReader> reader;
+  reader->ReadFromInputStringOn();
+  reader->SetInputString(text);
+  reader->ReadAllScalarsOn();
+  reader->Update();
+  vtkUnstructuredGrid* output = reader->GetOutput();
+
+  if (!CompareArrays(points->GetData(), output->GetPoints()->GetData()))
+  {
+    return EXIT_FAILURE;
+  }
+  for (int a = 0; a < grid->GetPointData()->GetNumberOfArrays(); ++a)
+  {
+    vtkDataArray* array = grid->GetPointData()->GetArray(a);
+    if (!CompareArrays(array, output->GetPointData()->GetArray(array->GetName())))
+    {
+      return EXIT_FAILURE;
+    }
+  }
+  if (output->GetNumberOfCells() != numCells)
+  {
+    std::cerr << "Wrong number of cells: " << output->GetNumberOfCells() << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < numCells; ++i)
+  {
+    vtkIdType npts;
+    const vtkIdType* ids;
+    output->GetCellPoints(i, npts, ids);
+    if (output->GetCellType(i) != grid->GetCellType(i) || npts != 2 || ids[0] != 2 * i ||
+      ids[1] != 2 * i + 1)
+    {
+      std::cerr << "Wrong cell " << i << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
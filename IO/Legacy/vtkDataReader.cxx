@@ -45,6 +45,7 @@
 #include "vtkPointData.h"
 #include "vtkPointSet.h"
 #include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkShortArray.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -62,10 +63,18 @@
 #include <vtksys/SystemTools.hxx>
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cstdlib>
+#include <limits>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
+// The ASCII values are read in chunks of at most this size, and the
+// values in a chunk are parsed concurrently.
+#define VTK_DATA_READER_ASCII_CHUNK_SIZE (static_cast<size_t>(1) << 22)
+
 // I need a safe way to read a line of arbitrary length.  It exists on
 // some platforms but not others so I'm afraid I have to write it
 // myself.
@@ -1483,27 +1492,224 @@ int vtkReadBinaryData(istream* IS, T* data, vtkIdType numTuples, vtkIdType numCo
   return 1;
 }
 
-// General templated function to read data of various types.
+namespace
+{
+// The characters skipped by operator>> with the classic locale.
+inline bool vtkIsASCIISpace(char c)
+{
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// The type operator>> reads for each type of value: the characters are
+// read as integers.
 template <class T>
-int vtkReadASCIIData(vtkDataReader* self, T* data, vtkIdType numTuples, vtkIdType numComp)
+struct vtkASCIIReadType
+{
+  typedef T Type;
+};
+template <>
+struct vtkASCIIReadType<char>
+{
+  typedef int Type;
+};
+template <>
+struct vtkASCIIReadType<unsigned char>
 {
-  vtkIdType i, j;
+  typedef int Type;
+};
 
-  for (i = 0; i < numTuples; i++)
+// Parse an integer token like operator>> does: the magnitude must fit in
+// the type, and negative unsigned values wrap around.
+template <class T>
+bool vtkParseASCIIValue(const char* begin, const char* end, T& value, std::true_type)
+{
+  typedef typename std::make_unsigned<T>::type UnsignedType;
+  bool negative = false;
+  if (*begin == '+' || *begin == '-')
   {
-    for (j = 0; j < numComp; j++)
+    negative = (*begin == '-');
+    ++begin;
+  }
+  if (begin == end)
+  {
+    return false;
+  }
+  UnsignedType limit = static_cast<UnsignedType>(std::numeric_limits<T>::max());
+  if (negative && std::numeric_limits<T>::is_signed)
+  {
+    ++limit;
+  }
+  UnsignedType magnitude = 0;
+  for (; begin != end; ++begin)
+  {
+    unsigned int digit = static_cast<unsigned char>(*begin) - '0';
+    if (digit > 9 || magnitude > (limit - digit) / 10)
     {
-      if (!self->Read(data++))
+      return false;
+    }
+    magnitude = magnitude * 10 + digit;
+  }
+  value = static_cast<T>(negative ? UnsignedType(0) - magnitude : magnitude);
+  return true;
+}
+
+// Parse a floating point token like operator>> does, which gathers the
+// characters of a decimal number and converts them with strtof or strtod.
+// The classic locale is set while reading.
+inline double vtkStringToFloatingPoint(const char* str, char** end, double)
+{
+  return strtod(str, end);
+}
+inline float vtkStringToFloatingPoint(const char* str, char** end, float)
+{
+  return strtof(str, end);
+}
+
+template <class T>
+bool vtkParseASCIIValue(const char* begin, const char* end, T& value, std::false_type)
+{
+  for (const char* c = begin; c != end; ++c)
+  {
+    if (!((*c >= '0' && *c <= '9') || *c == '.' || *c == 'e' || *c == 'E' || *c == '+' ||
+          *c == '-'))
+    {
+      return false;
+    }
+  }
+  char* last;
+  value = vtkStringToFloatingPoint(begin, &last, T());
+  // Values out of range are errors, as with operator>>.
+  return last == end && value <= std::numeric_limits<T>::max() &&
+    value >= -std::numeric_limits<T>::max();
+}
+}
+
+// General templated function to read data of various types.  The stream
+// is read in chunks, which are split in tokens, and the tokens are parsed
+// concurrently.  The stream is then positioned right after the last value
+// read, as when reading the values one by one.  From an invalid value on,
+// the values are read one by one, so that errors are handled as before.
+template <class T>
+int vtkReadASCIIData(vtkDataReader* self, T* data, vtkIdType numTuples, vtkIdType numComp)
+{
+  typedef typename vtkASCIIReadType<T>::Type ReadType;
+  istream* is = self->GetIStream();
+  const vtkIdType numValues = numTuples * numComp;
+  std::vector<char> chunk;
+  std::vector<size_t> starts;
+  std::vector<size_t> ends;
+  size_t minChunkSize = 0;
+  vtkIdType numRead = 0;
+  while (numRead < numValues && is->good())
+  {
+    // Read about what the remaining values need, allowing for long values.
+    const vtkIdType numWanted = numValues - numRead;
+    size_t chunkSize = std::max(minChunkSize,
+      std::min(VTK_DATA_READER_ASCII_CHUNK_SIZE, static_cast<size_t>(numWanted) * 32 + 256));
+    std::streampos chunkPosition = is->tellg();
+    chunk.resize(chunkSize + 1);
+    is->read(chunk.data(), chunkSize);
+    const size_t size = static_cast<size_t>(is->gcount());
+    const bool atEnd = size < chunkSize;
+    chunk[size] = '\0';
+
+    // Find the tokens.  A token reaching the end of the chunk may continue
+    // in the next chunk, so it is left for later.
+    starts.clear();
+    ends.clear();
+    size_t pos = 0;
+    size_t start = 0;
+    while (static_cast<vtkIdType>(starts.size()) < numWanted)
+    {
+      while (pos < size && vtkIsASCIISpace(chunk[pos]))
       {
-        vtkGenericWarningMacro(<< "Error reading ascii data. Possible mismatch of "
-                                  "datasize with declaration.");
-        return 0;
+        ++pos;
+      }
+      start = pos;
+      while (pos < size && !vtkIsASCIISpace(chunk[pos]))
+      {
+        ++pos;
+      }
+      if (start == size || (pos == size && !atEnd))
+      {
+        break;
       }
+      starts.push_back(start);
+      ends.push_back(pos);
+    }
+    if (starts.empty() && !atEnd)
+    {
+      // Only white space, or a value longer than the chunk: skip the white
+      // space, or read a larger chunk.
+      if (start == 0)
+      {
+        minChunkSize = 2 * chunkSize;
+      }
+      is->clear();
+      is->seekg(chunkPosition + static_cast<std::streamoff>(start));
+      continue;
+    }
+
+    // Find the first token which is not a valid value, if any.
+    const vtkIdType numTokens = static_cast<vtkIdType>(starts.size());
+    std::atomic<vtkIdType> firstInvalid(numTokens);
+    T* values = data + numRead;
+    vtkSMPTools::For(0, numTokens, [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end && i < firstInvalid; ++i)
+      {
+        ReadType value;
+        if (!vtkParseASCIIValue(chunk.data() + starts[i], chunk.data() + ends[i], value,
+              std::integral_constant<bool, std::numeric_limits<ReadType>::is_integer>()))
+        {
+          vtkIdType first = firstInvalid;
+          while (i < first && !firstInvalid.compare_exchange_weak(first, i))
+          {
+          }
+          return;
+        }
+        values[i] = static_cast<T>(value);
+      }
+    });
+
+    is->clear();
+    if (firstInvalid < numTokens || numTokens == 0)
+    {
+      // Read the rest of the values one by one, to report the error as
+      // before and leave the stream in the same state.
+      numRead += firstInvalid;
+      if (numTokens > 0)
+      {
+        is->seekg(chunkPosition + static_cast<std::streamoff>(starts[firstInvalid]));
+      }
+      else
+      {
+        is->seekg(chunkPosition);
+      }
+      break;
+    }
+
+    // Continue reading after the last value parsed.
+    numRead += numTokens;
+    is->seekg(chunkPosition + static_cast<std::streamoff>(ends.back()));
+  }
+
+  for (data += numRead; numRead < numValues; ++numRead)
+  {
+    if (!self->Read(data++))
+    {
+      vtkGenericWarningMacro(<< "Error reading ascii data. Possible mismatch of "
+                                "datasize with declaration.");
+      return 0;
     }
   }
   return 1;
 }
 
+int vtkDataReader::ReadASCIIValues(int* data, vtkIdType numValues)
+{
+  return vtkReadASCIIData(this, data, numValues, 1);
+}
+
 // Description:
 // Read data array. Return pointer to array object if successful read;
 // otherwise return nullptr. Note: this method instantiates a reference counted
@@ -3198,7 +3404,6 @@ int vtkDataReader::ReadCells(vtkSmartPointer<vtkCellArray>& cellArray)
 int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
 {
   char line[256];
-  int i;
 
   if (this->FileType == VTK_BINARY)
   {
@@ -3216,15 +3421,12 @@ int vtkDataReader::ReadCellsLegacy(vtkIdType size, int* data)
   }
   else // ascii
   {
-    for (i = 0; i < size; i++)
+    if (!this->ReadASCIIValues(data, size))
     {
-      if (!this->Read(data + i))
-      {
-        const char* fname = this->CurrentFileName.c_str();
-        vtkErrorMacro(<< "Error reading ascii cell data!"
-                      << " for file: " << (fname ? fname : "(Null FileName)"));
-        return 0;
-      }
+      const char* fname = this->CurrentFileName.c_str();
+      vtkErrorMacro(<< "Error reading ascii cell data!"
+                    << " for file: " << (fname ? fname : "(Null FileName)"));
+      return 0;
     }
   }
 
@@ -436,6 +436,13 @@ public:
   int Read(double*);
   //@}
 
+  /**
+   * Internal function to read in many ASCII values at once, which is much
+   * faster than reading them one by one.  Returns zero if there was an
+   * error.
+   */
+  int ReadASCIIValues(int* data, vtkIdType numValues);
+
   /**
    * Read @a n character from the stream into @a str, then reset the stream
    * position. Returns the number of characters actually read.
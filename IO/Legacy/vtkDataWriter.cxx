@@ -47,6 +47,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #ifdef VTK_USE_SCALED_SOA_ARRAYS
 #include "vtkScaledSOADataArrayTemplate.h"
 #endif
@@ -66,8 +67,11 @@
 #include "vtkVariantArray.h"
 #include "vtksys/FStream.hxx"
 
+#include <algorithm>
 #include <cstdio>
 #include <sstream>
+#include <string>
+#include <vector>
 
 vtkStandardNewMacro(vtkDataWriter);
 
@@ -966,28 +970,48 @@ namespace
 {
 // Template to handle writing data in ascii or binary
 // We could change the format into C++ io standard ...
+// The values written in ascii are formatted concurrently, by blocks of
+// this many lines of 9 values, and a batch of blocks is written at once.
+const vtkIdType vtkASCIIBlockSize = 9 * 4096;
+const vtkIdType vtkASCIIBatchSize = 64;
+
 template <class T>
 void vtkWriteDataArray(
   ostream* fp, T* data, int fileType, const char* format, vtkIdType num, vtkIdType numComp)
 {
-  vtkIdType i, j, idx, sizeT;
-  char str[1024];
+  vtkIdType sizeT;
 
   sizeT = sizeof(T);
 
   if (fileType == VTK_ASCII)
   {
-    for (j = 0; j < num; j++)
+    const vtkIdType numValues = num * numComp;
+    const vtkIdType numBlocks = (numValues + vtkASCIIBlockSize - 1) / vtkASCIIBlockSize;
+    std::vector<std::string> blocks(std::min(numBlocks, vtkASCIIBatchSize));
+    for (vtkIdType batch = 0; batch < numBlocks; batch += vtkASCIIBatchSize)
     {
-      for (i = 0; i < numComp; i++)
-      {
-        idx = i + j * numComp;
-        snprintf(str, sizeof(str), format, *data++);
-        *fp << str;
-        if (!((idx + 1) % 9))
+      const vtkIdType batchEnd = std::min(numBlocks, batch + vtkASCIIBatchSize);
+      vtkSMPTools::For(batch, batchEnd, [&](vtkIdType begin, vtkIdType end) {
+        char str[1024];
+        for (vtkIdType block = begin; block < end; ++block)
         {
-          *fp << "\n";
+          std::string& text = blocks[block - batch];
+          text.clear();
+          const vtkIdType last = std::min(numValues, (block + 1) * vtkASCIIBlockSize);
+          for (vtkIdType idx = block * vtkASCIIBlockSize; idx < last; ++idx)
+          {
+            snprintf(str, sizeof(str), format, data[idx]);
+            text += str;
+            if (!((idx + 1) % 9))
+            {
+              text += '\n';
+            }
+          }
         }
+      });
+      for (vtkIdType block = batch; block < batchEnd; ++block)
+      {
+        fp->write(blocks[block - batch].data(), blocks[block - batch].size());
       }
     }
   }
@@ -0,0 +1,139 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPLYReaderBinary.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the binary vtkPLYReader
+// .SECTION Description
+// Write a mesh large enough to be read in several blocks in ascii and in
+// both binary byte orders, and check that the binary files, which are read
+// by blocks, give the same data as the ascii file.
+
+#include "vtkCellArray.h"
+#include "vtkDataArray.h"
+#include "vtkNew.h"
+#include "vtkPLYReader.h"
+#include "vtkPLYWriter.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <iostream>
+#include <string>
+
+namespace
+{
+bool WritePLY(vtkPolyData* mesh, const std::string& fileName, int fileType, int byteOrder)
+{
+  vtkNew<vtkPLYWriter> writer;
+  writer->SetFileName(fileName.c_str());
+  writer->SetFileType(fileType);
+  writer->SetDataByteOrder(byteOrder);
+  writer->SetArrayName("RGBA");
+  writer->EnableAlphaOn();
+  writer->SetInputData(mesh);
+  return writer->Write() != 0;
+}
+
+bool SameArrays(vtkDataArray* expected, vtkDataArray* actual, const char* name)
+{
+  if (!expected || !actual || expected->GetNumberOfTuples() != actual->GetNumberOfTuples() ||
+    expected->GetNumberOfComponents() != actual->GetNumberOfComponents())
+  {
+    std::cerr << name << " were not read" << std::endl;
+    return false;
+  }
+  for (vtkIdType i = 0; i < expected->GetNumberOfTuples(); ++i)
+  {
+    for (int j = 0; j < expected->GetNumberOfComponents(); ++j)
+    {
+      if (expected->GetComponent(i, j) != actual->GetComponent(i, j))
+      {
+        std::cerr << name << " differ at " << i << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestPLYReaderBinary(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = std::string(tempDir) + "/TestPLYReaderBinary.ply";
+  delete[] tempDir;
+
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(400);
+  sphere->SetPhiResolution(300);
+  sphere->Update();
+  vtkPolyData* mesh = sphere->GetOutput();
+  vtkNew<vtkUnsignedCharArray> colors;
+  colors->SetName("RGBA");
+  colors->SetNumberOfComponents(4);
+  colors->SetNumberOfTuples(mesh->GetNumberOfPoints());
+  for (vtkIdType i = 0; i < mesh->GetNumberOfPoints(); ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+    {
+      colors->SetTypedComponent(i, j, static_cast<unsigned char>((i * (j + 3)) % 256));
+    }
+  }
+  mesh->GetPointData()->SetScalars(colors);
+
+  if (!WritePLY(mesh, fileName, VTK_ASCII, VTK_LITTLE_ENDIAN))
+  {
+    std::cerr << "Cannot write " << fileName << std::endl;
+    return EXIT_FAILURE;
+  }
+  vtkNew<vtkPLYReader> asciiReader;
+  asciiReader->SetFileName(fileName.c_str());
+  asciiReader->Update();
+  vtkPolyData* expected = asciiReader->GetOutput();
+  if (expected->GetNumberOfPoints() != mesh->GetNumberOfPoints() ||
+    expected->GetNumberOfPolys() != mesh->GetNumberOfPolys())
+  {
+    std::cerr << "The ascii file was not read" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const int byteOrders[2] = { VTK_LITTLE_ENDIAN, VTK_BIG_ENDIAN };
+  for (int byteOrder : byteOrders)
+  {
+    if (!WritePLY(mesh, fileName, VTK_BINARY, byteOrder))
+    {
+      std::cerr << "Cannot write " << fileName << std::endl;
+      return EXIT_FAILURE;
+    }
+    vtkNew<vtkPLYReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    vtkPolyData* actual = reader->GetOutput();
+    if (!SameArrays(expected->GetPoints()->GetData(), actual->GetPoints()->GetData(), "Points") ||
+      !SameArrays(expected->GetPointData()->GetScalars(), actual->GetPointData()->GetScalars(),
+        "Colors") ||
+      !SameArrays(expected->GetPolys()->GetOffsetsArray(), actual->GetPolys()->GetOffsetsArray(),
+        "Cell offsets") ||
+      !SameArrays(expected->GetPolys()->GetConnectivityArray(),
+        actual->GetPolys()->GetConnectivityArray(), "Cell connectivities"))
+    {
+      std::cerr << "Wrong binary file with byte order " << byteOrder << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
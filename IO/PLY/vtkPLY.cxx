@@ -50,9 +50,11 @@ WARRANTY OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE.
 #include "vtkByteSwap.h"
 #include "vtkHeap.h"
 #include "vtkMath.h"
+#include "vtkSMPTools.h"
 #include <vtksys/FStream.hxx>
 #include <vtksys/SystemTools.hxx>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstring>
@@ -91,7 +93,10 @@ static void* plyAllocateMemory(size_t n)
 static const char* type_names[] = { "invalid", "char", "short", "int", "int8", "int16", "int32",
   "uchar", "ushort", "uint", "uint8", "uint16", "uint32", "float", "float32", "double", "float64" };
 
-static const int ply_type_size[] = { 0, 1, 2, 4, 1, 2, 4, 1, 2, 4, 1, 2, 4, 4, 4, 8 };
+static const int ply_type_size[] = { 0, 1, 2, 4, 1, 2, 4, 1, 2, 4, 1, 2, 4, 4, 4, 8, 8 };
+
+// Binary elements are read by blocks of at most this many bytes.
+const size_t PLY_BLOCK_SIZE = static_cast<size_t>(1) << 22;
 }
 
 #define NO_OTHER_PROPS (-1)
@@ -1019,6 +1024,34 @@ void vtkPLY::ply_get_element(PlyFile* plyfile, void* elem_ptr)
     binary_get_element(plyfile, (char*)elem_ptr);
 }
 
+/******************************************************************************
+Read several elements from the file into an array of structures, as if
+ply_get_element() was called for each of them.  Binary elements are read in
+large blocks and decoded concurrently, which is much faster.
+
+Entry:
+  plyfile   - file identifier
+  elem_ptr  - pointer to the first structure
+  elem_size - size of the structures, in bytes
+  count     - number of elements to read
+******************************************************************************/
+
+void vtkPLY::ply_get_elements(PlyFile* plyfile, void* elem_ptr, int elem_size, int count)
+{
+  char* elems = static_cast<char*>(elem_ptr);
+  int done = 0;
+  if (plyfile->file_type != PLY_ASCII && plyfile->which_elem->other_offset == NO_OTHER_PROPS)
+  {
+    done = binary_get_elements(plyfile, elems, elem_size, count);
+  }
+
+  /* read what is left, if any, one element at a time */
+  for (; done < count; done++)
+  {
+    ply_get_element(plyfile, elems + static_cast<size_t>(done) * elem_size);
+  }
+}
+
 /******************************************************************************
 Extract the comments from the header information of a PLY file.
 
@@ -1764,6 +1797,199 @@ bool vtkPLY::binary_get_element(PlyFile* plyfile, char* elem_ptr)
   return true;
 }
 
+/******************************************************************************
+Read elements from a binary file by blocks, and decode them concurrently.
+The stream is left after the last element read.
+
+Entry:
+  plyfile   - file identifier
+  elem_ptr  - pointer to the first element
+  elem_size - size of the elements, in bytes
+  count     - number of elements to read
+
+Exit:
+  returns the number of elements read, which is smaller than count only if
+  the file ends before, or if the size of a list is invalid
+******************************************************************************/
+
+int vtkPLY::binary_get_elements(PlyFile* plyfile, char* elem_ptr, int elem_size, int count)
+{
+  PlyElement* elem = plyfile->which_elem;
+  std::istream* is = plyfile->is;
+  std::streampos position = is->tellg(); /* position of the buffer in the file */
+  if (position < 0)
+    return 0;
+
+  /* the smallest size of an element, to not read too far after the last one */
+  size_t min_size = 0;
+  for (int j = 0; j < elem->nprops; j++)
+  {
+    PlyProperty* prop = elem->props[j];
+    min_size += ply_type_size[prop->is_list ? prop->count_external : prop->external_type];
+  }
+
+  std::vector<char> buffer;
+  std::vector<size_t> records;
+  size_t used = 0; /* number of bytes in the buffer */
+  int done = 0;
+  bool at_end = false;
+  while (done < count && !at_end)
+  {
+    /* append a block to what is left of the previous one */
+    size_t block_size = std::max(static_cast<size_t>(1),
+      std::min(PLY_BLOCK_SIZE, static_cast<size_t>(count - done) * min_size));
+    buffer.resize(used + block_size);
+    is->read(buffer.data() + used, block_size);
+    used += static_cast<size_t>(is->gcount());
+    at_end = !is->good();
+
+    /* find the complete elements in the buffer */
+    records.clear();
+    size_t pos = 0;
+    bool complete = true;
+    while (complete && done + static_cast<int>(records.size()) < count)
+    {
+      size_t end = pos;
+      for (int j = 0; j < elem->nprops && complete; j++)
+      {
+        PlyProperty* prop = elem->props[j];
+        if (prop->is_list)
+        {
+          int list_count;
+          unsigned int uint_val;
+          double double_val;
+          end += ply_type_size[prop->count_external];
+          if (end > used)
+          {
+            complete = false;
+            break;
+          }
+          get_binary_item_value(buffer.data() + end - ply_type_size[prop->count_external],
+            prop->count_external, plyfile->file_type, &list_count, &uint_val, &double_val);
+          if (list_count < 0)
+          {
+            /* let binary_get_element() deal with it */
+            complete = false;
+            at_end = true;
+            break;
+          }
+          end += static_cast<size_t>(list_count) * ply_type_size[prop->external_type];
+        }
+        else
+        {
+          end += ply_type_size[prop->external_type];
+        }
+        complete = (end <= used);
+      }
+      if (complete)
+      {
+        records.push_back(pos);
+        pos = end;
+      }
+    }
+    records.push_back(pos);
+
+    /* decode the elements */
+    const char* data = buffer.data();
+    char* elems = elem_ptr + static_cast<size_t>(done) * elem_size;
+    vtkSMPTools::For(0, static_cast<vtkIdType>(records.size() - 1),
+      [&](vtkIdType begin, vtkIdType end) {
+        for (vtkIdType i = begin; i < end; i++)
+        {
+          binary_decode_element(plyfile, data + records[i], elems + i * elem_size);
+        }
+      });
+    done += static_cast<int>(records.size() - 1);
+
+    /* keep the incomplete element for the next block */
+    position += static_cast<std::streamoff>(pos);
+    memmove(buffer.data(), buffer.data() + pos, used - pos);
+    used -= pos;
+  }
+
+  /* go back to the end of the last element read */
+  is->clear();
+  is->seekg(position);
+  return done;
+}
+
+/******************************************************************************
+Decode an element read from a binary file into memory.  The element must not
+have other_props.
+
+Entry:
+  plyfile  - file identifier
+  data     - pointer to the element in the file
+  elem_ptr - pointer to the element
+******************************************************************************/
+
+void vtkPLY::binary_decode_element(PlyFile* plyfile, const char* data, char* elem_ptr)
+{
+  PlyElement* elem = plyfile->which_elem;
+  int file_type = plyfile->file_type;
+  int int_val;
+  unsigned int uint_val;
+  double double_val;
+
+  for (int j = 0; j < elem->nprops; j++)
+  {
+    PlyProperty* prop = elem->props[j];
+    int store_it = elem->store_prop[j];
+
+    if (prop->is_list)
+    { /* a list */
+
+      /* get and store the number of items in the list */
+      get_binary_item_value(
+        data, prop->count_external, file_type, &int_val, &uint_val, &double_val);
+      data += ply_type_size[prop->count_external];
+      if (store_it)
+      {
+        store_item(elem_ptr + prop->count_offset, prop->count_internal, int_val, uint_val,
+          double_val);
+      }
+
+      /* allocate space for an array of items and store a ptr to the array */
+      int list_count = int_val;
+      int external_size = ply_type_size[prop->external_type];
+      if (store_it)
+      {
+        char** store_array = (char**)(elem_ptr + prop->offset);
+        if (list_count == 0)
+        {
+          *store_array = nullptr;
+        }
+        else
+        {
+          int item_size = ply_type_size[prop->internal_type];
+          char* item = (char*)myalloc(sizeof(char) * item_size * list_count);
+          *store_array = item;
+
+          /* decode items and store them into the array */
+          for (int k = 0; k < list_count; k++)
+          {
+            get_binary_item_value(data + k * external_size, prop->external_type, file_type,
+              &int_val, &uint_val, &double_val);
+            store_item(item, prop->internal_type, int_val, uint_val, double_val);
+            item += item_size;
+          }
+        }
+      }
+      data += static_cast<size_t>(list_count) * external_size;
+    }
+    else
+    { /* not a list */
+      if (store_it)
+      {
+        get_binary_item_value(
+          data, prop->external_type, file_type, &int_val, &uint_val, &double_val);
+        store_item(elem_ptr + prop->offset, prop->internal_type, int_val, uint_val, double_val);
+      }
+      data += ply_type_size[prop->external_type];
+    }
+  }
+}
+
 /******************************************************************************
 Write to a file the word that represents a PLY data type.
 
@@ -2287,20 +2513,51 @@ Exit:
 
 bool vtkPLY::get_binary_item(
   PlyFile* plyfile, int type, int* int_val, unsigned int* uint_val, double* double_val)
+{
+  if (type <= PLY_START_TYPE || type >= PLY_END_TYPE)
+  {
+    fprintf(stderr, "get_binary_item: bad type = %d\n", type);
+    assert(0);
+    return false;
+  }
+
+  char value[8];
+  plyfile->is->read(value, ply_type_size[type]);
+  if (!plyfile->is->good())
+  {
+    vtkGenericWarningMacro("PLY error reading file."
+      << " Premature EOF while reading " << type_names[type] << ".");
+    return false;
+  }
+  get_binary_item_value(value, type, plyfile->file_type, int_val, uint_val, double_val);
+  return true;
+}
+
+/******************************************************************************
+Get the value of an item read from a binary file, and place the result
+into an integer, an unsigned integer and a double.
+
+Entry:
+  ptr       - pointer to the item as read from the file
+  type      - data type supposedly in the item
+  file_type - byte order of the file
+
+Exit:
+  int_val    - integer value
+  uint_val   - unsigned integer value
+  double_val - double-precision floating point value
+******************************************************************************/
+
+void vtkPLY::get_binary_item_value(const char* ptr, int type, int file_type, int* int_val,
+  unsigned int* uint_val, double* double_val)
 {
   switch (type)
   {
     case PLY_CHAR:
     case PLY_INT8:
     {
-      vtkTypeInt8 value = 0;
-      plyfile->is->read(reinterpret_cast<char*>(&value), sizeof(value));
-      if (!plyfile->is->good())
-      {
-        vtkGenericWarningMacro("PLY error reading file."
-          << " Premature EOF while reading char.");
-        return false;
-      }
+      vtkTypeInt8 value;
+      memcpy(&value, ptr, sizeof(value));
 
       // Here value can always fit in int, unsigned int, and double.
       *int_val = static_cast<int>(value);
@@ -2311,14 +2568,8 @@ bool vtkPLY::get_binary_item(
     case PLY_UCHAR:
     case PLY_UINT8:
     {
-      vtkTypeUInt8 value = 0;
-      plyfile->is->read(reinterpret_cast<char*>(&value), sizeof(value));
-      if (!plyfile->is->good())
-      {
-        vtkGenericWarningMacro("PLY error reading file."
-          << " Premature EOF while reading uchar or uint8.");
-        return false;
-      }
+      vtkTypeUInt8 value;
+      memcpy(&value, ptr, sizeof(value));
 
       // Here value can always fit in int, unsigned int, and double.
       *int_val = static_cast<int>(value);
@@ -2329,16 +2580,9 @@ bool vtkPLY::get_binary_item(
     case PLY_SHORT:
     case PLY_INT16:
     {
-      vtkTypeInt16 value = 0;
-      plyfile->is->read(reinterpret_cast<char*>(&value), sizeof(value));
-      if (!plyfile->is->good())
-      {
-        vtkGenericWarningMacro("PLY error reading file."
-          << " Premature EOF while reading short.");
-        return false;
-      }
-      plyfile->file_type == PLY_BINARY_BE ? vtkByteSwap::Swap2BE(&value)
-                                          : vtkByteSwap::Swap2LE(&value);
+      vtkTypeInt16 value;
+      memcpy(&value, ptr, sizeof(value));
+      file_type == PLY_BINARY_BE ? vtkByteSwap::Swap2BE(&value) : vtkByteSwap::Swap2LE(&value);
 
       // Here value can always fit in int, unsigned int, and double.
       *int_val = static_cast<int>(value);
@@ -2349,16 +2593,9 @@ bool vtkPLY::get_binary_item(
     case PLY_USHORT:
     case PLY_UINT16:
     {
-      vtkTypeUInt16 value = 0;
-      plyfile->is->read(reinterpret_cast<char*>(&value), sizeof(value));
-      if (!plyfile->is->good())
-      {
-        vtkGenericWarningMacro("PLY error reading file."
-          << " Premature EOF while reading ushort.");
-        return false;
-      }
-      plyfile->file_type == PLY_BINARY_BE ? vtkByteSwap::Swap2BE(&value)
-                                          : vtkByteSwap::Swap2LE(&value);
+      vtkTypeUInt16 value;
+      memcpy(&value, ptr, sizeof(value));
+      file_type == PLY_BINARY_BE ? vtkByteSwap::Swap2BE(&value) : vtkByteSwap::Swap2LE(&value);
 
       // Here value can always fit in int, unsigned int, and double.
       *int_val = static_cast<int>(value);
@@ -2369,16 +2606,9 @@ bool vtkPLY::get_binary_item(
     case PLY_INT:
     case PLY_INT32:
     {
-      vtkTypeInt32 value = 0;
-      plyfile->is->read(reinterpret_cast<char*>(&value), sizeof(value));
-      if (!plyfile->is->good())
-      {
-        vtkGenericWarningMacro("PLY error reading file."
-          << " Premature EOF while reading int or int32.");
-        return false;
-      }
-      plyfile->file_type == PLY_BINARY_BE ? vtkByteSwap::Swap4BE(&value)
-                                          : vtkByteSwap::Swap4LE(&value);
+      vtkTypeInt32 value;
+      memcpy(&value, ptr, sizeof(value));
+      file_type == PLY_BINARY_BE ? vtkByteSwap::Swap4BE(&value) : vtkByteSwap::Swap4LE(&value);
 
       // Here value can always fit in int, unsigned int, and double.
       *int_val = static_cast<int>(value);
@@ -2389,16 +2619,9 @@ bool vtkPLY::get_binary_item(
     case PLY_UINT:
     case PLY_UINT32:
     {
-      vtkTypeUInt32 value = 0;
-      plyfile->is->read(reinterpret_cast<char*>(&value), sizeof(value));
-      if (!plyfile->is->good())
-      {
-        vtkGenericWarningMacro("PLY error reading file."
-          << " Premature EOF while reading uint");
-        return false;
-      }
-      plyfile->file_type == PLY_BINARY_BE ? vtkByteSwap::Swap4BE(&value)
-                                          : vtkByteSwap::Swap4LE(&value);
+      vtkTypeUInt32 value;
+      memcpy(&value, ptr, sizeof(value));
+      file_type == PLY_BINARY_BE ? vtkByteSwap::Swap4BE(&value) : vtkByteSwap::Swap4LE(&value);
 
       // Here value can always fit in int, unsigned int, and double.
       *int_val = static_cast<int>(value);
@@ -2409,16 +2632,9 @@ bool vtkPLY::get_binary_item(
     case PLY_FLOAT:
     case PLY_FLOAT32:
     {
-      vtkTypeFloat32 value = 0.0;
-      plyfile->is->read(reinterpret_cast<char*>(&value), sizeof(value));
-      if (!plyfile->is->good())
-      {
-        vtkGenericWarningMacro("PLY error reading file."
-          << " Premature EOF while reading float of float32.");
-        return false;
-      }
-      plyfile->file_type == PLY_BINARY_BE ? vtkByteSwap::Swap4BE(&value)
-                                          : vtkByteSwap::Swap4LE(&value);
+      vtkTypeFloat32 value;
+      memcpy(&value, ptr, sizeof(value));
+      file_type == PLY_BINARY_BE ? vtkByteSwap::Swap4BE(&value) : vtkByteSwap::Swap4LE(&value);
 
       // INT32_MIN (-2^31) is a power of 2 and thus exactly representable as float.
       // INT32_MAX (2^31 - 1) is not exactly representable as float; closest smaller integer is 2^31
@@ -2432,16 +2648,9 @@ bool vtkPLY::get_binary_item(
     case PLY_DOUBLE:
     case PLY_FLOAT64:
     {
-      vtkTypeFloat64 value = 0.0;
-      plyfile->is->read(reinterpret_cast<char*>(&value), sizeof(value));
-      if (!plyfile->is->good())
-      {
-        vtkGenericWarningMacro("PLY error reading file."
-          << " Premature EOF while reading double.");
-        return false;
-      }
-      plyfile->file_type == PLY_BINARY_BE ? vtkByteSwap::Swap8BE(&value)
-                                          : vtkByteSwap::Swap8LE(&value);
+      vtkTypeFloat64 value;
+      memcpy(&value, ptr, sizeof(value));
+      file_type == PLY_BINARY_BE ? vtkByteSwap::Swap8BE(&value) : vtkByteSwap::Swap8LE(&value);
 
       // Here we can just clamp and cast, all int32s can be exactly represented as doubles.
       *int_val =
@@ -2452,11 +2661,9 @@ bool vtkPLY::get_binary_item(
     }
     break;
     default:
-      fprintf(stderr, "get_binary_item: bad type = %d\n", type);
+      fprintf(stderr, "get_binary_item_value: bad type = %d\n", type);
       assert(0);
-      return false;
   }
-  return true;
 }
 
 /******************************************************************************
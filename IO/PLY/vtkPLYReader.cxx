@@ -29,6 +29,7 @@
 #include "vtkPoints.h"
 #include "vtkPolyData.h"
 #include "vtkPolygon.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 #include "vtkUnsignedCharArray.h"
@@ -40,6 +41,9 @@
 #include <cstddef>
 #include <vector>
 
+// The elements of the PLY files are read by batches of this many elements.
+#define VTK_PLY_BATCH_SIZE 65536
+
 vtkStandardNewMacro(vtkPLYReader);
 
 namespace
@@ -395,30 +399,41 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
         rgbPoints->SetNumberOfTuples(numPts);
       }
 
-      plyVertex vertex;
-      for (int j = 0; j < numPts; j++)
+      // Read the vertices by batches, and copy them to the arrays
+      // concurrently.
+      std::vector<plyVertex> vertices(std::min(numPts, VTK_PLY_BATCH_SIZE));
+      for (int batch = 0; batch < numPts; batch += VTK_PLY_BATCH_SIZE)
       {
-        vtkPLY::ply_get_element(ply, (void*)&vertex);
-        pts->SetPoint(j, vertex.x);
-        if (texCoordsPointsAvailable)
-        {
-          texCoordsPoints->SetTuple2(j, vertex.tex[0], vertex.tex[1]);
-        }
-        if (normalPointsAvailable)
-        {
-          normals->SetTuple3(j, vertex.normal[0], vertex.normal[1], vertex.normal[2]);
-        }
-        if (rgbPointsAvailable)
-        {
-          if (rgbPointsHaveAlpha)
-          {
-            rgbPoints->SetTuple4(j, vertex.red, vertex.green, vertex.blue, vertex.alpha);
-          }
-          else
+        const int batchSize = std::min(numPts - batch, VTK_PLY_BATCH_SIZE);
+        vtkPLY::ply_get_elements(ply, vertices.data(), sizeof(plyVertex), batchSize);
+        vtkSMPTools::For(0, batchSize, [&](vtkIdType begin, vtkIdType end) {
+          for (vtkIdType k = begin; k < end; k++)
           {
-            rgbPoints->SetTuple3(j, vertex.red, vertex.green, vertex.blue);
+            const plyVertex& vertex = vertices[k];
+            vtkIdType j = batch + k;
+            pts->SetPoint(j, vertex.x);
+            if (texCoordsPointsAvailable)
+            {
+              texCoordsPoints->SetTuple2(j, vertex.tex[0], vertex.tex[1]);
+            }
+            if (normalPointsAvailable)
+            {
+              normals->SetTuple3(j, vertex.normal[0], vertex.normal[1], vertex.normal[2]);
+            }
+            if (rgbPointsAvailable)
+            {
+              if (rgbPointsHaveAlpha)
+              {
+                rgbPoints->SetTuple4(j, vertex.red, vertex.green, vertex.blue, vertex.alpha);
+              }
+              else
+              {
+                rgbPoints->SetTuple3(j, vertex.red, vertex.green, vertex.blue);
+              }
+            }
           }
-        }
+        });
+        this->UpdateProgress(0.5 * (batch + batchSize) / numPts);
       }
       output->SetPoints(pts);
       pts->Delete();
@@ -442,7 +457,6 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
       numPolys = numElems;
       vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
       polys->AllocateEstimate(numPolys, 3);
-      plyFace face;
       vtkIdType vtkVerts[256];
 
       // Get the face properties
@@ -479,19 +493,39 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
         }
       }
 
-      // grab all the face elements
+      // grab all the face elements, by batches
       vtkNew<vtkPolygon> cell;
+      std::vector<plyFace> faces(std::min(numPolys, VTK_PLY_BATCH_SIZE));
       for (int j = 0; j < numPolys; j++)
       {
-        // grab and element from the file
-        vtkPLY::ply_get_element(ply, (void*)&face);
+        const int batchIndex = j % VTK_PLY_BATCH_SIZE;
+        if (batchIndex == 0)
+        {
+          // Faces which cannot be read, in truncated files, are left empty.
+          std::fill(faces.begin(), faces.end(), plyFace());
+          vtkPLY::ply_get_elements(ply, faces.data(), sizeof(plyFace),
+            std::min(numPolys - j, VTK_PLY_BATCH_SIZE));
+          if (j > 0)
+          {
+            this->UpdateProgress(0.5 + 0.5 * j / numPolys);
+          }
+        }
+        plyFace& face = faces[batchIndex];
         for (int k = 0; k < face.nverts; k++)
         {
           vtkVerts[k] = face.verts[k];
         }
-        free(face.verts); // allocated in vtkPLY::ascii/binary_get_element
+        free(face.verts); // allocated in vtkPLY::ascii/binary_get_element(s)
 
-        cell->Initialize(face.nverts, vtkVerts, output->GetPoints());
+        if (!texCoordsFaceAvailable)
+        {
+          // The polygon is only needed to duplicate points for the texture.
+          polys->InsertNextCell(face.nverts, vtkVerts);
+        }
+        else
+        {
+          cell->Initialize(face.nverts, vtkVerts, output->GetPoints());
+        }
         if (intensityAvailable)
         {
           intensity->SetValue(j, face.intensity);
@@ -609,8 +643,8 @@ int vtkPLYReader::RequestData(vtkInformation* vtkNotUsed(request),
                             << " different than number of points " << face.nverts);
           }
           free(face.texcoord);
+          polys->InsertNextCell(cell);
         }
-        polys->InsertNextCell(cell);
       }
       output->SetPolys(polys);
     }
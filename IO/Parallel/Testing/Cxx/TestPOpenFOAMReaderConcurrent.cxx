@@ -0,0 +1,145 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestPOpenFOAMReaderConcurrent.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME Test of the concurrent reads of vtkPOpenFOAMReader
+// .SECTION Description
+// Write an ASCII case decomposed into two processor subdirectories of one
+// hexahedron each, read it with the processor subdirectories and the field
+// files read concurrently, whatever the SMP backend, and check the appended
+// cells and fields.
+
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkDummyController.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPOpenFOAMReader.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtksys/SystemTools.hxx"
+
+#include <fstream>
+#include <string>
+
+namespace
+{
+// Reads two processor subdirectories, and two field files, at a time.
+class vtkConcurrentPOpenFOAMReader : public vtkPOpenFOAMReader
+{
+public:
+  static vtkConcurrentPOpenFOAMReader* New();
+  vtkTypeMacro(vtkConcurrentPOpenFOAMReader, vtkPOpenFOAMReader);
+
+protected:
+  vtkConcurrentPOpenFOAMReader() { this->ConcurrentReads = 2; }
+  ~vtkConcurrentPOpenFOAMReader() override = default;
+};
+vtkStandardNewMacro(vtkConcurrentPOpenFOAMReader);
+
+void WriteFile(const std::string& dir, const std::string& object, const std::string& className,
+  const std::string& body)
+{
+  vtksys::SystemTools::MakeDirectory(dir);
+  std::ofstream file(dir + "/" + object);
+  file << "FoamFile\n{\n  version 2.0;\n  format ascii;\n  class " << className
+       << ";\n  object " << object << ";\n}\n\n"
+       << body;
+}
+
+// Processor i holds the unit cube shifted by i along x, with p = i and
+// U = (1 i 3).
+void WriteProcessor(const std::string& caseDir, int i)
+{
+  const std::string procDir = caseDir + "/processor" + std::to_string(i);
+  const std::string meshDir = procDir + "/constant/polyMesh";
+  std::string points = "8\n(\n";
+  for (int k = 0; k < 2; ++k)
+  {
+    for (int j = 0; j < 2; ++j)
+    {
+      for (int l = 0; l < 2; ++l)
+      {
+        points += "(" + std::to_string(i + l) + " " + std::to_string(j) + " " +
+          std::to_string(k) + ")\n";
+      }
+    }
+  }
+  WriteFile(meshDir, "points", "vectorField", points + ")\n");
+  WriteFile(meshDir, "faces", "faceList",
+    "6\n(\n4(0 2 3 1)\n4(4 5 7 6)\n4(0 1 5 4)\n4(2 6 7 3)\n4(0 4 6 2)\n4(1 3 7 5)\n)\n");
+  WriteFile(meshDir, "owner", "labelList", "6\n(\n0\n0\n0\n0\n0\n0\n)\n");
+  WriteFile(meshDir, "neighbour", "labelList", "0\n(\n)\n");
+  WriteFile(meshDir, "boundary", "polyBoundaryMesh",
+    "1\n(\n  walls\n  {\n    type wall;\n    nFaces 6;\n    startFace 0;\n  }\n)\n");
+
+  WriteFile(procDir + "/0", "p", "volScalarField",
+    "dimensions [0 2 -2 0 0 0 0];\ninternalField uniform " + std::to_string(i) +
+      ";\nboundaryField\n{\n  walls\n  {\n    type zeroGradient;\n  }\n}\n");
+  WriteFile(procDir + "/0", "U", "volVectorField",
+    "dimensions [0 1 -1 0 0 0 0];\ninternalField uniform (1 " + std::to_string(i) +
+      " 3);\nboundaryField\n{\n  walls\n  {\n    type fixedValue;\n"
+      "    value uniform (0 0 0);\n  }\n}\n");
+}
+}
+
+int TestPOpenFOAMReaderConcurrent(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  const std::string caseDir = std::string(tempDir) + "/TestPOpenFOAMReaderConcurrent";
+  delete[] tempDir;
+  WriteFile(caseDir + "/system", "controlDict", "dictionary",
+    "startTime 0;\nendTime 0;\ndeltaT 1;\nwriteInterval 1;\n");
+  WriteProcessor(caseDir, 0);
+  WriteProcessor(caseDir, 1);
+  std::ofstream(caseDir + "/case.foam");
+
+  vtkNew<vtkDummyController> controller;
+  vtkMultiProcessController::SetGlobalController(controller);
+
+  int status = EXIT_SUCCESS;
+  {
+    vtkNew<vtkConcurrentPOpenFOAMReader> reader;
+    reader->SetCaseType(vtkPOpenFOAMReader::DECOMPOSED_CASE);
+    reader->SetFileName((caseDir + "/case.foam").c_str());
+    reader->UpdateInformation();
+    reader->EnableAllCellArrays();
+    reader->Update();
+
+    vtkUnstructuredGrid* mesh = vtkUnstructuredGrid::SafeDownCast(reader->GetOutput()->GetBlock(0));
+    vtkDataArray* p = mesh ? mesh->GetCellData()->GetArray("p") : nullptr;
+    vtkDataArray* u = mesh ? mesh->GetCellData()->GetArray("U") : nullptr;
+    if (!p || !u || mesh->GetNumberOfCells() != 2 || mesh->GetNumberOfPoints() != 16)
+    {
+      cerr << "Wrong cells or missing fields of the decomposed case" << endl;
+      status = EXIT_FAILURE;
+    }
+    else
+    {
+      // the processor subdirectories are appended in order
+      for (vtkIdType i = 0; i < 2; ++i)
+      {
+        if (p->GetComponent(i, 0) != i || u->GetComponent(i, 1) != i)
+        {
+          cerr << "Wrong field values of processor " << i << endl;
+          status = EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  return status;
+}
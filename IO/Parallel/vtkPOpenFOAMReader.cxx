@@ -30,11 +30,14 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkSortDataArray.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 
+#include <vector>
+
 vtkStandardNewMacro(vtkPOpenFOAMReader);
 vtkCxxSetObjectMacro(vtkPOpenFOAMReader, Controller, vtkMultiProcessController);
 
@@ -333,6 +336,7 @@ int vtkPOpenFOAMReader::RequestData(
     // append->AppendFieldDataOn();
 
     vtkOpenFOAMReader* reader;
+    std::vector<vtkOpenFOAMReader*> readers;
     this->Superclass::CurrentReaderIndex = 0;
     this->Superclass::Readers->InitTraversal();
     while ((reader = vtkOpenFOAMReader::SafeDownCast(
@@ -349,6 +353,7 @@ int vtkPOpenFOAMReader::RequestData(
       if (reader->MakeMetaDataAtTimeStep(false))
       {
         append->AddInputConnection(reader->GetOutputPort());
+        readers.push_back(reader);
       }
     }
 
@@ -362,7 +367,24 @@ int vtkPOpenFOAMReader::RequestData(
     else
     {
       // reader->RequestInformation() and RequestData() are called
-      // for all reader instances without setting UPDATE_TIME_STEPS
+      // for all reader instances without setting UPDATE_TIME_STEPS.
+      // The processor subdirectories are independent, so read them
+      // concurrently first, without reporting progress meanwhile.
+      const int concurrentReads = (this->Superclass::ConcurrentReads > 0
+          ? this->Superclass::ConcurrentReads
+          : vtkSMPTools::GetEstimatedNumberOfThreads());
+      if (readers.size() > 1 && concurrentReads > 1)
+      {
+        this->Superclass::UpdatingReadersConcurrently = true;
+        vtkSMPTools::For(0, static_cast<vtkIdType>(readers.size()), 1,
+          [&readers](vtkIdType begin, vtkIdType end) {
+            for (vtkIdType i = begin; i < end; ++i)
+            {
+              readers[i]->Update();
+            }
+          });
+        this->Superclass::UpdatingReadersConcurrently = false;
+      }
       append->Update();
       output->ShallowCopy(append->GetOutput());
     }
@@ -22,6 +22,9 @@
  * transient data for the cells. Each folder can contain any number of
  * data files.
  *
+ * The processor subdirectories assigned to a process are read concurrently
+ * by the threads of vtkSMPTools, when its backend is multithreaded.
+ *
  * @par Thanks:
  * This class was developed by Takuya Oshima at Niigata University,
  * Japan (oshima@eng.niigata-u.ac.jp).
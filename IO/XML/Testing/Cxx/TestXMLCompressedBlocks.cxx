@@ -0,0 +1,198 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLCompressedBlocks.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write arrays made of many compressed blocks with each compressor, check
+// that the files are the same as the ones written by compressing the blocks
+// one at a time, and that they are read back, completely or partially,
+// unchanged.
+
+#include "vtkDoubleArray.h"
+#include "vtkFeatures.h"
+#include "vtkImageData.h"
+#include "vtkIntArray.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLImageDataReader.h"
+#include "vtkXMLImageDataWriter.h"
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+const int Dimensions[3] = { 60, 50, 40 };
+
+// Compresses each block and writes it before compressing the next one,
+// without the batches compressed in parallel.
+class vtkSerialImageDataWriter : public vtkXMLImageDataWriter
+{
+public:
+  static vtkSerialImageDataWriter* New();
+  vtkTypeMacro(vtkSerialImageDataWriter, vtkXMLImageDataWriter);
+
+protected:
+  vtkSerialImageDataWriter() { this->CompressionBatchSize = 0; }
+};
+vtkStandardNewMacro(vtkSerialImageDataWriter);
+
+std::string ReadFile(const std::string& fileName)
+{
+  std::ifstream file(fileName.c_str(), std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+bool CheckArrays(vtkImageData* image, const int extent[6])
+{
+  vtkIntArray* ints = vtkIntArray::SafeDownCast(image->GetPointData()->GetArray("Ints"));
+  vtkDoubleArray* doubles =
+    vtkDoubleArray::SafeDownCast(image->GetPointData()->GetArray("Doubles"));
+  if (!ints || !doubles)
+  {
+    std::cerr << "Missing arrays" << std::endl;
+    return false;
+  }
+
+  vtkIdType id = 0;
+  for (int k = extent[4]; k <= extent[5]; ++k)
+  {
+    for (int j = extent[2]; j <= extent[3]; ++j)
+    {
+      for (int i = extent[0]; i <= extent[1]; ++i, ++id)
+      {
+        vtkIdType index = i + Dimensions[0] * (j + Dimensions[1] * k);
+        if (ints->GetValue(id) != static_cast<int>((index * 7) % 1013) ||
+          doubles->GetValue(id) != std::sin(index * 0.001))
+        {
+          std::cerr << "Wrong value at point " << index << std::endl;
+          return false;
+        }
+      }
+    }
+  }
+  if (id != ints->GetNumberOfTuples() || id != doubles->GetNumberOfTuples())
+  {
+    std::cerr << "Wrong number of values" << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int TestXMLCompressedBlocks(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = std::string(tempDir) + "/TestXMLCompressedBlocks.vti";
+  std::string serialFileName = std::string(tempDir) + "/TestXMLCompressedBlocksSerial.vti";
+  delete[] tempDir;
+
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(Dimensions[0], Dimensions[1], Dimensions[2]);
+  const vtkIdType numPts = image->GetNumberOfPoints();
+  vtkNew<vtkIntArray> ints;
+  ints->SetName("Ints");
+  ints->SetNumberOfTuples(numPts);
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetName("Doubles");
+  doubles->SetNumberOfTuples(numPts);
+  for (vtkIdType i = 0; i < numPts; ++i)
+  {
+    ints->SetValue(i, static_cast<int>((i * 7) % 1013));
+    doubles->SetValue(i, std::sin(i * 0.001));
+  }
+  image->GetPointData()->AddArray(ints);
+  image->GetPointData()->AddArray(doubles);
+
+  // Compute the ranges first: they are cached in the information of the
+  // arrays, which changes the XML written for them.
+  ints->GetRange();
+  doubles->GetRange();
+
+  std::vector<int> compressors = { vtkXMLWriter::ZLIB, vtkXMLWriter::LZ4, vtkXMLWriter::LZMA,
+    vtkXMLWriter::ZFP };
+#ifdef VTK_USE_ZSTD
+  compressors.push_back(vtkXMLWriter::ZSTD);
+#endif
+  const int dataModes[2] = { vtkXMLWriter::Appended, vtkXMLWriter::Binary };
+  for (int compressor : compressors)
+  {
+    for (int dataMode : dataModes)
+    {
+      // Small blocks, so that the arrays are made of many blocks and the
+      // last block is partial.
+      vtkNew<vtkXMLImageDataWriter> writer;
+      writer->SetInputData(image);
+      writer->SetFileName(fileName.c_str());
+      writer->SetCompressorType(compressor);
+      writer->SetDataMode(dataMode);
+      writer->SetBlockSize(1000);
+      if (!writer->Write())
+      {
+        std::cerr << "Cannot write " << fileName << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      vtkNew<vtkSerialImageDataWriter> serialWriter;
+      serialWriter->SetInputData(image);
+      serialWriter->SetFileName(serialFileName.c_str());
+      serialWriter->SetCompressorType(compressor);
+      serialWriter->SetDataMode(dataMode);
+      serialWriter->SetBlockSize(1000);
+      if (!serialWriter->Write())
+      {
+        std::cerr << "Cannot write " << serialFileName << std::endl;
+        return EXIT_FAILURE;
+      }
+      const std::string bytes = ReadFile(fileName);
+      if (bytes.empty() || bytes != ReadFile(serialFileName))
+      {
+        std::cerr << "Compressor " << compressor << ", data mode " << dataMode
+                  << ": the file differs from the one compressed serially" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      vtkNew<vtkXMLImageDataReader> reader;
+      reader->SetFileName(fileName.c_str());
+      reader->Update();
+      if (!CheckArrays(reader->GetOutput(), reader->GetOutput()->GetExtent()))
+      {
+        std::cerr << "Compressor " << compressor << ", data mode " << dataMode
+                  << ": the arrays were not read back correctly" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      // Read a sub-extent, which reads ranges of values starting and
+      // ending inside of blocks. The reader has an UpdateExtent ivar which
+      // hides vtkAlgorithm::UpdateExtent.
+      const int extent[6] = { 3, 57, 10, 45, 5, 30 };
+      vtkNew<vtkXMLImageDataReader> subReader;
+      subReader->SetFileName(fileName.c_str());
+      static_cast<vtkAlgorithm*>(subReader)->UpdateExtent(extent);
+      if (!CheckArrays(subReader->GetOutput(), extent))
+      {
+        std::cerr << "Compressor " << compressor << ", data mode " << dataMode
+                  << ": the sub-extent was not read back correctly" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
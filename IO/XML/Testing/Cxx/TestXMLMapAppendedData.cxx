@@ -0,0 +1,157 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLMapAppendedData.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Write raw appended data with and without alignment, read it back with
+// memory mapping, and check that the values are right, that the aligned
+// arrays are actually mapped, and that modifying the mapped arrays does not
+// modify the file.
+
+#include "vtkCellArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkTestUtilities.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkXMLPolyDataReader.h"
+#include "vtkXMLPolyDataWriter.h"
+#include "vtkXMLReader.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+namespace
+{
+const vtkIdType NumberOfPoints = 10007;
+
+bool CheckPolyData(vtkPolyData* polyData)
+{
+  vtkUnsignedCharArray* bytes =
+    vtkUnsignedCharArray::SafeDownCast(polyData->GetPointData()->GetArray("Bytes"));
+  vtkDoubleArray* doubles =
+    vtkDoubleArray::SafeDownCast(polyData->GetPointData()->GetArray("Doubles"));
+  if (!bytes || !doubles || polyData->GetNumberOfPoints() != NumberOfPoints ||
+    polyData->GetNumberOfVerts() != NumberOfPoints ||
+    bytes->GetNumberOfTuples() != NumberOfPoints ||
+    doubles->GetNumberOfTuples() != NumberOfPoints)
+  {
+    std::cerr << "Missing or incomplete data" << std::endl;
+    return false;
+  }
+
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    double p[3];
+    polyData->GetPoint(i, p);
+    if (bytes->GetValue(i) != static_cast<unsigned char>(i % 251) ||
+      doubles->GetValue(i) != std::sin(i * 0.01) || p[0] != static_cast<float>(i) ||
+      p[1] != static_cast<float>(2 * i) || p[2] != 0.5f)
+    {
+      std::cerr << "Wrong value at point " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestXMLMapAppendedData(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string fileName = std::string(tempDir) + "/TestXMLMapAppendedData.vtp";
+  delete[] tempDir;
+
+  // The array of bytes makes the following arrays unaligned, unless the
+  // writer pads them.
+  vtkNew<vtkPolyData> polyData;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> verts;
+  vtkNew<vtkUnsignedCharArray> bytes;
+  bytes->SetName("Bytes");
+  vtkNew<vtkDoubleArray> doubles;
+  doubles->SetName("Doubles");
+  for (vtkIdType i = 0; i < NumberOfPoints; ++i)
+  {
+    points->InsertNextPoint(i, 2 * i, 0.5);
+    verts->InsertNextCell(1, &i);
+    bytes->InsertNextValue(static_cast<unsigned char>(i % 251));
+    doubles->InsertNextValue(std::sin(i * 0.01));
+  }
+  polyData->SetPoints(points);
+  polyData->SetVerts(verts);
+  polyData->GetPointData()->AddArray(bytes);
+  polyData->GetPointData()->AddArray(doubles);
+
+  for (int align = 0; align < 2; ++align)
+  {
+    vtkNew<vtkXMLPolyDataWriter> writer;
+    writer->SetInputData(polyData);
+    writer->SetFileName(fileName.c_str());
+    writer->SetDataModeToAppended();
+    writer->EncodeAppendedDataOff();
+    writer->SetCompressorTypeToNone();
+    writer->SetAlignAppendedData(align != 0);
+    if (!writer->Write())
+    {
+      std::cerr << "Cannot write " << fileName << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    for (int map = 0; map < 2; ++map)
+    {
+      vtkNew<vtkXMLPolyDataReader> reader;
+      reader->SetFileName(fileName.c_str());
+      reader->SetMapAppendedData(map != 0);
+      reader->Update();
+      vtkPolyData* output = reader->GetOutput();
+      if (!CheckPolyData(output))
+      {
+        std::cerr << "Align " << align << ", map " << map
+                  << ": the data was not read back correctly" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      // The arrays of doubles and points are mapped only when they are
+      // aligned; the array of bytes always is.
+      const bool mapBytes = (map != 0);
+      const bool mapOthers = (map != 0 && align != 0);
+      if (vtkXMLReader::IsArrayMapped(output->GetPointData()->GetArray("Bytes")) != mapBytes ||
+        vtkXMLReader::IsArrayMapped(output->GetPointData()->GetArray("Doubles")) != mapOthers ||
+        vtkXMLReader::IsArrayMapped(output->GetPoints()->GetData()) != mapOthers)
+      {
+        std::cerr << "Align " << align << ", map " << map
+                  << ": the arrays were not mapped as expected" << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      // The mapped arrays are private copies of the file.
+      vtkDoubleArray::SafeDownCast(output->GetPointData()->GetArray("Doubles"))->SetValue(0, 3.0);
+      output->GetPoints()->SetPoint(0, 1.0, 1.0, 1.0);
+    }
+
+    vtkNew<vtkXMLPolyDataReader> reader;
+    reader->SetFileName(fileName.c_str());
+    reader->Update();
+    if (!CheckPolyData(reader->GetOutput()))
+    {
+      std::cerr << "Align " << align << ": the file was modified" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,225 @@
+/*=========================================================================
+
+  Program:   Visualization Toolkit
+  Module:    TestXMLParallelPieceReading.cxx
+
+  Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+  All rights reserved.
+  See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Read a multi-piece polydata file and a multi-block file with several
+// threads, and check that the output is the same as with one thread. Also
+// check that the errors of the leaves are reported by the calling thread.
+
+#include "vtkCellArray.h"
+#include "vtkCommand.h"
+#include "vtkDataArray.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkMultiPieceDataSet.h"
+#include "vtkNew.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSphereSource.h"
+#include "vtkTestUtilities.h"
+#include "vtkXMLMultiBlockDataReader.h"
+#include "vtkXMLMultiBlockDataWriter.h"
+#include "vtkXMLPPolyDataReader.h"
+#include "vtkXMLPPolyDataWriter.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace
+{
+bool SameArrays(vtkDataArray* a1, vtkDataArray* a2)
+{
+  if (!a1 || !a2)
+  {
+    return a1 == a2;
+  }
+  return a1->GetDataType() == a2->GetDataType() &&
+    a1->GetNumberOfValues() == a2->GetNumberOfValues() &&
+    memcmp(a1->GetVoidPointer(0), a2->GetVoidPointer(0),
+      a1->GetNumberOfValues() * a1->GetDataTypeSize()) == 0;
+}
+
+bool SamePolyData(vtkDataObject* do1, vtkDataObject* do2)
+{
+  vtkPolyData* pd1 = vtkPolyData::SafeDownCast(do1);
+  vtkPolyData* pd2 = vtkPolyData::SafeDownCast(do2);
+  if (!pd1 || !pd2)
+  {
+    return pd1 == pd2;
+  }
+  return pd1->GetNumberOfCells() == pd2->GetNumberOfCells() &&
+    SameArrays(pd1->GetPoints()->GetData(), pd2->GetPoints()->GetData()) &&
+    SameArrays(
+      pd1->GetPointData()->GetArray("Normals"), pd2->GetPointData()->GetArray("Normals")) &&
+    SameArrays(pd1->GetPolys()->GetConnectivityArray(), pd2->GetPolys()->GetConnectivityArray());
+}
+
+vtkSmartPointer<vtkPolyData> MakeSphere(double radius, int resolution)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(radius);
+  sphere->SetThetaResolution(resolution);
+  sphere->SetPhiResolution(resolution);
+  sphere->Update();
+  return sphere->GetOutput();
+}
+
+// Count the error events, and whether any was invoked by another thread.
+class ErrorRecorder : public vtkCommand
+{
+public:
+  static ErrorRecorder* New() { return new ErrorRecorder; }
+
+  void Execute(vtkObject*, unsigned long, void*) override
+  {
+    ++this->NumberOfErrors;
+    this->OtherThread = this->OtherThread || std::this_thread::get_id() != this->ThreadId;
+  }
+
+  std::thread::id ThreadId = std::this_thread::get_id();
+  int NumberOfErrors = 0;
+  bool OtherThread = false;
+};
+
+vtkSmartPointer<vtkMultiBlockDataSet> ReadMultiBlock(const std::string& fileName, int numThreads)
+{
+  vtkNew<vtkXMLMultiBlockDataReader> reader;
+  reader->SetFileName(fileName.c_str());
+  reader->SetNumberOfThreads(numThreads);
+  reader->Update();
+  return vtkMultiBlockDataSet::SafeDownCast(reader->GetOutput());
+}
+}
+
+int TestXMLParallelPieceReading(int argc, char* argv[])
+{
+  char* tempDir =
+    vtkTestUtilities::GetArgOrEnvOrDefault("-T", argc, argv, "VTK_TEMP_DIR", "Testing/Temporary");
+  std::string pieceFileName = std::string(tempDir) + "/TestXMLParallelPieceReading.pvtp";
+  std::string blockFileName = std::string(tempDir) + "/TestXMLParallelPieceReading.vtm";
+  std::string leafFilePrefix =
+    std::string(tempDir) + "/TestXMLParallelPieceReading/TestXMLParallelPieceReading_";
+  delete[] tempDir;
+
+  // A polydata made of many pieces.
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetThetaResolution(64);
+  sphere->SetPhiResolution(64);
+  vtkNew<vtkXMLPPolyDataWriter> pieceWriter;
+  pieceWriter->SetInputConnection(sphere->GetOutputPort());
+  pieceWriter->SetFileName(pieceFileName.c_str());
+  pieceWriter->SetNumberOfPieces(12);
+  pieceWriter->SetStartPiece(0);
+  pieceWriter->SetEndPiece(11);
+  if (!pieceWriter->Write())
+  {
+    std::cerr << "Cannot write " << pieceFileName << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkNew<vtkXMLPPolyDataReader> serialPieceReader;
+  serialPieceReader->SetFileName(pieceFileName.c_str());
+  serialPieceReader->Update();
+  for (int numThreads : { 4, 0 })
+  {
+    vtkNew<vtkXMLPPolyDataReader> pieceReader;
+    pieceReader->SetFileName(pieceFileName.c_str());
+    pieceReader->SetNumberOfThreads(numThreads);
+    pieceReader->Update();
+    if (serialPieceReader->GetOutput()->GetNumberOfPoints() == 0 ||
+      !SamePolyData(serialPieceReader->GetOutput(), pieceReader->GetOutput()))
+    {
+      std::cerr << "The pieces read with " << numThreads << " threads are different" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A multi-block dataset with nested blocks and pieces.
+  vtkNew<vtkMultiBlockDataSet> blocks;
+  vtkNew<vtkMultiBlockDataSet> nestedBlocks;
+  vtkNew<vtkMultiPieceDataSet> pieces;
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    blocks->SetBlock(i, MakeSphere(1.0 + i, 8 + 4 * i));
+    nestedBlocks->SetBlock(i, MakeSphere(0.5 + i, 10 + 2 * i));
+    pieces->SetPiece(i, MakeSphere(2.0 + i, 6 + 3 * i));
+  }
+  blocks->SetBlock(4, nestedBlocks);
+  blocks->SetBlock(5, pieces);
+  vtkNew<vtkXMLMultiBlockDataWriter> blockWriter;
+  blockWriter->SetInputData(blocks);
+  blockWriter->SetFileName(blockFileName.c_str());
+  if (!blockWriter->Write())
+  {
+    std::cerr << "Cannot write " << blockFileName << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  vtkSmartPointer<vtkMultiBlockDataSet> serialBlocks = ReadMultiBlock(blockFileName, 1);
+  vtkSmartPointer<vtkMultiBlockDataSet> threadedBlocks = ReadMultiBlock(blockFileName, 3);
+  vtkMultiBlockDataSet* serialNested =
+    vtkMultiBlockDataSet::SafeDownCast(serialBlocks->GetBlock(4));
+  vtkMultiBlockDataSet* threadedNested =
+    vtkMultiBlockDataSet::SafeDownCast(threadedBlocks->GetBlock(4));
+  vtkMultiPieceDataSet* serialPieces =
+    vtkMultiPieceDataSet::SafeDownCast(serialBlocks->GetBlock(5));
+  vtkMultiPieceDataSet* threadedPieces =
+    vtkMultiPieceDataSet::SafeDownCast(threadedBlocks->GetBlock(5));
+  if (!serialNested || !threadedNested || !serialPieces || !threadedPieces ||
+    threadedBlocks->GetNumberOfBlocks() != 6 || threadedNested->GetNumberOfBlocks() != 4 ||
+    threadedPieces->GetNumberOfPieces() != 4)
+  {
+    std::cerr << "Wrong structure of the multi-block dataset" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    if (!serialBlocks->GetBlock(i) ||
+      !SamePolyData(serialBlocks->GetBlock(i), threadedBlocks->GetBlock(i)) ||
+      !SamePolyData(serialNested->GetBlock(i), threadedNested->GetBlock(i)) ||
+      !SamePolyData(serialPieces->GetPiece(i), threadedPieces->GetPiece(i)))
+    {
+      std::cerr << "The blocks read with 3 threads are different" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Corrupt a few leaves, whose errors must be reported to the observers of
+  // the multi-block reader by this thread only.
+  for (int i = 0; i < 4; ++i)
+  {
+    std::ofstream(leafFilePrefix + std::to_string(i) + ".vtp") << "<VTKFile type=";
+  }
+  vtkNew<ErrorRecorder> readerErrors;
+  vtkNew<ErrorRecorder> parserErrors;
+  vtkNew<vtkXMLMultiBlockDataReader> corruptReader;
+  corruptReader->SetFileName(blockFileName.c_str());
+  corruptReader->SetNumberOfThreads(3);
+  corruptReader->AddObserver(vtkCommand::ErrorEvent, readerErrors);
+  corruptReader->SetParserErrorObserver(parserErrors);
+  corruptReader->Update();
+  if (readerErrors->NumberOfErrors == 0 || parserErrors->NumberOfErrors == 0 ||
+    readerErrors->OtherThread || parserErrors->OtherThread)
+  {
+    std::cerr << "Wrong errors of the corrupt leaves: " << readerErrors->NumberOfErrors
+              << " reader errors, " << parserErrors->NumberOfErrors << " parser errors, "
+              << (readerErrors->OtherThread || parserErrors->OtherThread ? "not " : "")
+              << "all reported by the calling thread" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -14,6 +14,7 @@
 =========================================================================*/
 #include "vtkXMLCompositeDataReader.h"
 
+#include "vtkCommand.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataArraySelection.h"
@@ -26,8 +27,10 @@
 #include "vtkInformationVector.h"
 #include "vtkLogger.h"
 #include "vtkMultiBlockDataSet.h"
+#include "vtkMultiThreader.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
+#include "vtkPartitionedDataSet.h"
 #include "vtkSmartPointer.h"
 #include "vtkStringArray.h"
 #include "vtkUniformGrid.h"
@@ -42,8 +45,11 @@
 #include "vtkXMLUnstructuredGridReader.h"
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <set>
+#include <string>
+#include <vector>
 #include <vtksys/SystemTools.hxx>
 
 struct vtkXMLCompositeDataReaderEntry
@@ -52,6 +58,21 @@ struct vtkXMLCompositeDataReaderEntry
   const char* name;
 };
 
+// Collects the error messages of a leaf reader updated by a worker thread,
+// so that the calling thread reports them once all of the leaves are read.
+class vtkXMLCompositeDataReaderErrors : public vtkCommand
+{
+public:
+  static vtkXMLCompositeDataReaderErrors* New() { return new vtkXMLCompositeDataReaderErrors; }
+
+  void Execute(vtkObject*, unsigned long, void* callData) override
+  {
+    this->Messages.push_back(callData ? static_cast<const char*>(callData) : "");
+  }
+
+  std::vector<std::string> Messages;
+};
+
 struct vtkXMLCompositeDataReaderInternals
 {
   vtkXMLCompositeDataReaderInternals() { this->ResetUpdateInformation(); }
@@ -64,9 +85,25 @@ struct vtkXMLCompositeDataReaderInternals
     this->HasUpdateRestriction = false;
   }
 
+  // Get the name of the reader class for the given file, or nullptr.
+  static const char* GetReaderType(const std::string& fileName);
+
+  // A leaf to read concurrently with the others, with its own reader.
+  struct PendingDataObject
+  {
+    vtkSmartPointer<vtkXMLReader> Reader;
+    vtkSmartPointer<vtkCompositeDataSet> Parent;
+    unsigned int Index;
+    vtkSmartPointer<vtkDataObject> Output;
+    // The errors of the reader and of its parser, if observed.
+    vtkSmartPointer<vtkXMLCompositeDataReaderErrors> ReaderErrors;
+    vtkSmartPointer<vtkXMLCompositeDataReaderErrors> ParserErrors;
+  };
+
   vtkSmartPointer<vtkXMLDataElement> Root;
   typedef std::map<std::string, vtkSmartPointer<vtkXMLReader>> ReadersType;
   ReadersType Readers;
+  std::vector<PendingDataObject> PendingDataObjects;
   static const vtkXMLCompositeDataReaderEntry ReaderList[];
   int UpdatePiece;
   int UpdateNumberOfPieces;
@@ -75,9 +112,50 @@ struct vtkXMLCompositeDataReaderInternals
   bool HasUpdateRestriction;
 };
 
+namespace
+{
+// The leaves shared by the threads reading them.
+struct vtkXMLCompositeDataReaderThreadData
+{
+  vtkXMLCompositeDataReader* Self;
+  std::vector<vtkXMLCompositeDataReaderInternals::PendingDataObject>* Pending;
+  std::atomic<size_t> Next;
+  std::atomic<size_t> Done;
+};
+
+// Each thread reads the next leaf not read yet, until all are read.
+VTK_THREAD_RETURN_TYPE vtkXMLCompositeDataReaderReadPending(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info = static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkXMLCompositeDataReaderThreadData* data =
+    static_cast<vtkXMLCompositeDataReaderThreadData*>(info->UserData);
+  const size_t size = data->Pending->size();
+  for (size_t i = data->Next++; i < size && !data->Self->GetAbortExecute(); i = data->Next++)
+  {
+    vtkXMLCompositeDataReaderInternals::PendingDataObject& pending = (*data->Pending)[i];
+    pending.Reader->Update();
+    vtkDataObject* output = pending.Reader->GetOutputDataObject(0);
+    if (output)
+    {
+      pending.Output.TakeReference(output->NewInstance());
+      pending.Output->ShallowCopy(output);
+    }
+
+    // Only the calling thread reports the progress.
+    size_t done = ++data->Done;
+    if (info->ThreadID == 0)
+    {
+      data->Self->UpdateProgress(static_cast<double>(done) / size);
+    }
+  }
+  return VTK_THREAD_RETURN_VALUE;
+}
+}
+
 //------------------------------------------------------------------------------
 vtkXMLCompositeDataReader::vtkXMLCompositeDataReader()
   : PieceDistribution(Block)
+  , NumberOfThreads(1)
 {
   this->Internal = new vtkXMLCompositeDataReaderInternals;
 }
@@ -106,6 +184,7 @@ void vtkXMLCompositeDataReader::PrintSelf(ostream& os, vtkIndent indent)
       os << "Invalid (!!)\n";
       break;
   }
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
 
   this->Superclass::PrintSelf(os, indent);
 }
@@ -236,6 +315,33 @@ vtkXMLReader* vtkXMLCompositeDataReader::GetReaderOfType(const char* type)
     return iter->second;
   }
 
+  vtkXMLReader* reader = this->NewReaderOfType(type);
+  if (reader)
+  {
+    if (this->GetParserErrorObserver())
+    {
+      reader->SetParserErrorObserver(this->GetParserErrorObserver());
+    }
+    if (this->HasObserver("ErrorEvent"))
+    {
+      vtkNew<vtkEventForwarderCommand> fwd;
+      fwd->SetTarget(this);
+      reader->AddObserver("ErrorEvent", fwd);
+    }
+    this->Internal->Readers[type] = reader;
+    reader->Delete();
+  }
+  return reader;
+}
+
+//------------------------------------------------------------------------------
+vtkXMLReader* vtkXMLCompositeDataReader::NewReaderOfType(const char* type)
+{
+  if (!type)
+  {
+    return nullptr;
+  }
+
   vtkXMLReader* reader = nullptr;
   if (strcmp(type, "vtkXMLImageDataReader") == 0)
   {
@@ -265,26 +371,17 @@ vtkXMLReader* vtkXMLCompositeDataReader::GetReaderOfType(const char* type)
   {
     reader = vtkXMLHyperTreeGridReader::New();
   }
-  if (reader)
-  {
-    if (this->GetParserErrorObserver())
-    {
-      reader->SetParserErrorObserver(this->GetParserErrorObserver());
-    }
-    if (this->HasObserver("ErrorEvent"))
-    {
-      vtkNew<vtkEventForwarderCommand> fwd;
-      fwd->SetTarget(this);
-      reader->AddObserver("ErrorEvent", fwd);
-    }
-    this->Internal->Readers[type] = reader;
-    reader->Delete();
-  }
   return reader;
 }
 
 //------------------------------------------------------------------------------
 vtkXMLReader* vtkXMLCompositeDataReader::GetReaderForFile(const std::string& fileName)
+{
+  return this->GetReaderOfType(vtkXMLCompositeDataReaderInternals::GetReaderType(fileName));
+}
+
+//------------------------------------------------------------------------------
+const char* vtkXMLCompositeDataReaderInternals::GetReaderType(const std::string& fileName)
 {
   // Get the file extension.
   std::string ext = vtksys::SystemTools::GetFilenameLastExtension(fileName);
@@ -296,7 +393,7 @@ vtkXMLReader* vtkXMLCompositeDataReader::GetReaderForFile(const std::string& fil
 
   // Search for the reader matching this extension.
   const char* rname = nullptr;
-  for (const vtkXMLCompositeDataReaderEntry* readerEntry = this->Internal->ReaderList;
+  for (const vtkXMLCompositeDataReaderEntry* readerEntry = ReaderList;
        !rname && readerEntry->extension; ++readerEntry)
   {
     if (ext == readerEntry->extension)
@@ -305,7 +402,7 @@ vtkXMLReader* vtkXMLCompositeDataReader::GetReaderForFile(const std::string& fil
     }
   }
 
-  return this->GetReaderOfType(rname);
+  return rname;
 }
 
 //------------------------------------------------------------------------------
@@ -384,7 +481,9 @@ void vtkXMLCompositeDataReader::ReadXMLData()
   // All processes create the entire tree structure however, but each one only
   // reads the datasets assigned to it.
   unsigned int dataSetIndex = 0;
+  this->Internal->PendingDataObjects.clear();
   this->ReadComposite(this->GetPrimaryElement(), composite, filePath.c_str(), dataSetIndex);
+  this->ReadPendingDataObjects();
 }
 
 //------------------------------------------------------------------------------
@@ -499,6 +598,110 @@ vtkDataObject* vtkXMLCompositeDataReader::ReadDataObject(
   return outputCopy;
 }
 
+//------------------------------------------------------------------------------
+vtkDataObject* vtkXMLCompositeDataReader::ReadChildDataObject(
+  vtkXMLDataElement* xmlElem, const char* filePath, vtkCompositeDataSet* parent, unsigned int index)
+{
+  if (this->NumberOfThreads == 1)
+  {
+    return this->ReadDataObject(xmlElem, filePath);
+  }
+
+  // Setup a reader for this file only, it is updated later.
+  std::string fileName = this->GetFileNameFromXML(xmlElem, filePath);
+  if (fileName.empty())
+  { // No filename in XML element. Not necessarily an error.
+    return nullptr;
+  }
+  vtkSmartPointer<vtkXMLReader> reader;
+  reader.TakeReference(
+    this->NewReaderOfType(vtkXMLCompositeDataReaderInternals::GetReaderType(fileName)));
+  if (!reader)
+  {
+    vtkErrorMacro("Could not create reader for " << fileName);
+    return nullptr;
+  }
+  reader->SetFileName(fileName.c_str());
+  reader->GetPointDataArraySelection()->CopySelections(this->PointDataArraySelection);
+  reader->GetCellDataArraySelection()->CopySelections(this->CellDataArraySelection);
+  reader->GetColumnArraySelection()->CopySelections(this->ColumnArraySelection);
+
+  vtkXMLCompositeDataReaderInternals::PendingDataObject pending;
+  pending.Reader = reader;
+  pending.Parent = parent;
+  pending.Index = index;
+
+  // The reader is updated by a worker thread, so its errors are collected
+  // rather than forwarded to the observers of this reader.
+  if (this->GetParserErrorObserver())
+  {
+    pending.ParserErrors = vtkSmartPointer<vtkXMLCompositeDataReaderErrors>::New();
+    reader->SetParserErrorObserver(pending.ParserErrors);
+  }
+  if (this->HasObserver("ErrorEvent"))
+  {
+    pending.ReaderErrors = vtkSmartPointer<vtkXMLCompositeDataReaderErrors>::New();
+    reader->AddObserver("ErrorEvent", pending.ReaderErrors);
+  }
+  this->Internal->PendingDataObjects.push_back(pending);
+  return nullptr;
+}
+
+//------------------------------------------------------------------------------
+void vtkXMLCompositeDataReader::ReadPendingDataObjects()
+{
+  std::vector<vtkXMLCompositeDataReaderInternals::PendingDataObject>& pending =
+    this->Internal->PendingDataObjects;
+  if (pending.empty())
+  {
+    return;
+  }
+
+  int numThreads = this->NumberOfThreads > 0 ? this->NumberOfThreads
+                                             : vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  numThreads = static_cast<int>(std::min(static_cast<size_t>(numThreads), pending.size()));
+
+  vtkXMLCompositeDataReaderThreadData data;
+  data.Self = this;
+  data.Pending = &pending;
+  data.Next = 0;
+  data.Done = 0;
+  vtkNew<vtkMultiThreader> threader;
+  threader->SetNumberOfThreads(numThreads);
+  threader->SetSingleMethod(vtkXMLCompositeDataReaderReadPending, &data);
+  threader->SingleMethodExecute();
+
+  // Report the errors and insert the leaves in the main thread, at the
+  // indices they were given.
+  for (auto& item : pending)
+  {
+    if (item.ParserErrors)
+    {
+      for (const std::string& message : item.ParserErrors->Messages)
+      {
+        this->GetParserErrorObserver()->Execute(
+          this, vtkCommand::ErrorEvent, const_cast<char*>(message.c_str()));
+      }
+    }
+    if (item.ReaderErrors)
+    {
+      for (const std::string& message : item.ReaderErrors->Messages)
+      {
+        this->InvokeEvent(vtkCommand::ErrorEvent, const_cast<char*>(message.c_str()));
+      }
+    }
+    if (vtkMultiBlockDataSet* mblock = vtkMultiBlockDataSet::SafeDownCast(item.Parent))
+    {
+      mblock->SetBlock(item.Index, item.Output);
+    }
+    else if (vtkPartitionedDataSet* pds = vtkPartitionedDataSet::SafeDownCast(item.Parent))
+    {
+      pds->SetPartition(item.Index, item.Output);
+    }
+  }
+  pending.clear();
+}
+
 //------------------------------------------------------------------------------
 vtkDataSet* vtkXMLCompositeDataReader::ReadDataset(vtkXMLDataElement* xmlElem, const char* filePath)
 {
@@ -68,6 +68,17 @@ public:
   vtkGetMacro(PieceDistribution, int);
   /**@}*/
 
+  //@{
+  /**
+   * Set the number of threads reading the datasets of the composite
+   * dataset concurrently. The datasets are still assembled in the order of
+   * the file. The default is 1, which reads the datasets one after
+   * another, and 0 uses vtkMultiThreader::GetGlobalDefaultNumberOfThreads().
+   */
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfThreads, int);
+  //@}
+
   //@{
   /**
    * Get the output data object for a port on this algorithm.
@@ -128,6 +139,21 @@ protected:
   // Read the vtkDataObject (a leaf) in the composite dataset.
   virtual vtkDataObject* ReadDataObject(vtkXMLDataElement* xmlElem, const char* filePath);
 
+  /**
+   * Read the vtkDataObject (a leaf) at the given index of the parent, which
+   * is a vtkMultiBlockDataSet or a vtkPartitionedDataSet. When several
+   * threads are used, the leaf is only read by ReadPendingDataObjects, which
+   * sets it in the parent, and nullptr is returned.
+   */
+  vtkDataObject* ReadChildDataObject(vtkXMLDataElement* xmlElem, const char* filePath,
+    vtkCompositeDataSet* parent, unsigned int index);
+
+  /**
+   * Read the leaves delayed by ReadChildDataObject concurrently, and set
+   * them in their parent.
+   */
+  void ReadPendingDataObjects();
+
   /**
    * Given the inorder index for a leaf node, this method tells if the current
    * process should read the dataset.
@@ -166,7 +192,12 @@ private:
     unsigned int datasetIndex, unsigned int numDatasets, int numPieces);
   //@}
 
+  // Create a reader of the given type, not shared with other files. Unlike
+  // GetReaderOfType, the error observers of this reader are not set on it.
+  vtkXMLReader* NewReaderOfType(const char* type);
+
   int PieceDistribution;
+  int NumberOfThreads;
 
   vtkXMLCompositeDataReaderInternals* Internal;
 };
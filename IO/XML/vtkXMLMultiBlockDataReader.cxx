@@ -148,7 +148,7 @@ void vtkXMLMultiBlockDataReader::ReadComposite(vtkXMLDataElement* element,
       if (this->ShouldReadDataSet(dataSetIndex, index, numPieces))
       {
         // Read
-        childDS.TakeReference(this->ReadDataObject(childXML, filePath));
+        childDS.TakeReference(this->ReadChildDataObject(childXML, filePath, composite, index));
         name = childXML->GetAttribute("name");
       }
       // insert
@@ -15,21 +15,59 @@
 #include "vtkXMLPUnstructuredDataReader.h"
 
 #include "vtkAbstractArray.h"
+#include "vtkCallbackCommand.h"
 #include "vtkCellArray.h"
+#include "vtkDataArraySelection.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
+#include "vtkMultiThreader.h"
+#include "vtkNew.h"
 #include "vtkPointSet.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
 #include "vtkXMLDataElement.h"
 #include "vtkXMLUnstructuredDataReader.h"
 
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+// The pieces shared by the threads reading them.
+struct vtkXMLPUnstructuredDataReaderThreadData
+{
+  vtkAlgorithm* Self;
+  vtkXMLDataReader** PieceReaders;
+  std::atomic<int> Next;
+  int EndPiece;
+  int GhostLevel;
+};
+
+// Each thread reads the next piece not read yet, until all are read.
+VTK_THREAD_RETURN_TYPE vtkXMLPUnstructuredDataReaderUpdatePieces(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info = static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkXMLPUnstructuredDataReaderThreadData* data =
+    static_cast<vtkXMLPUnstructuredDataReaderThreadData*>(info->UserData);
+  for (int i = data->Next++; i < data->EndPiece && !data->Self->GetAbortExecute();
+       i = data->Next++)
+  {
+    if (data->PieceReaders[i])
+    {
+      data->PieceReaders[i]->UpdatePiece(0, 1, data->GhostLevel);
+    }
+  }
+  return VTK_THREAD_RETURN_VALUE;
+}
+}
+
 //------------------------------------------------------------------------------
 vtkXMLPUnstructuredDataReader::vtkXMLPUnstructuredDataReader()
 {
   this->TotalNumberOfPoints = 0;
   this->TotalNumberOfCells = 0;
+  this->NumberOfThreads = 1;
 }
 
 //------------------------------------------------------------------------------
@@ -39,6 +77,7 @@ vtkXMLPUnstructuredDataReader::~vtkXMLPUnstructuredDataReader() = default;
 void vtkXMLPUnstructuredDataReader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << "\n";
 }
 
 //------------------------------------------------------------------------------
@@ -303,6 +342,13 @@ void vtkXMLPUnstructuredDataReader::ReadXMLData()
     fractions[index + 1] = fractions[index + 1] / fractions[this->EndPiece - this->StartPiece];
   }
 
+  // Read the pieces concurrently.  The piece readers are then up to date,
+  // and the loop below only copies their data.
+  if (this->NumberOfThreads != 1 && this->EndPiece - this->StartPiece > 1)
+  {
+    this->UpdatePieceReaders();
+  }
+
   // Read the data needed from each piece.
   for (int i = this->StartPiece; (i < this->EndPiece && !this->AbortExecute && !this->DataError);
        ++i)
@@ -350,6 +396,48 @@ int vtkXMLPUnstructuredDataReader::ReadPieceData()
   return this->Superclass::ReadPieceData();
 }
 
+//------------------------------------------------------------------------------
+void vtkXMLPUnstructuredDataReader::UpdatePieceReaders()
+{
+  // Setup the readers like ReadPieceData(index) does.  The progress
+  // observer uses the current piece, so it is removed while the pieces are
+  // read concurrently.
+  for (int i = this->StartPiece; i < this->EndPiece; ++i)
+  {
+    if (this->CanReadPiece(i))
+    {
+      vtkXMLDataReader* reader = this->PieceReaders[i];
+      reader->SetAbortExecute(0);
+      reader->GetPointDataArraySelection()->CopySelections(this->PointDataArraySelection);
+      reader->GetCellDataArraySelection()->CopySelections(this->CellDataArraySelection);
+      reader->RemoveObserver(this->PieceProgressObserver);
+    }
+  }
+
+  int numThreads = this->NumberOfThreads > 0 ? this->NumberOfThreads
+                                             : vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  numThreads = std::min(numThreads, this->EndPiece - this->StartPiece);
+
+  vtkXMLPUnstructuredDataReaderThreadData data;
+  data.Self = this;
+  data.PieceReaders = this->PieceReaders;
+  data.Next = this->StartPiece;
+  data.EndPiece = this->EndPiece;
+  data.GhostLevel = this->UpdateGhostLevel;
+  vtkNew<vtkMultiThreader> threader;
+  threader->SetNumberOfThreads(numThreads);
+  threader->SetSingleMethod(vtkXMLPUnstructuredDataReaderUpdatePieces, &data);
+  threader->SingleMethodExecute();
+
+  for (int i = this->StartPiece; i < this->EndPiece; ++i)
+  {
+    if (this->PieceReaders[i])
+    {
+      this->PieceReaders[i]->AddObserver(vtkCommand::ProgressEvent, this->PieceProgressObserver);
+    }
+  }
+}
+
 //------------------------------------------------------------------------------
 void vtkXMLPUnstructuredDataReader::CopyArrayForPoints(
   vtkAbstractArray* inArray, vtkAbstractArray* outArray)
@@ -44,6 +44,17 @@ public:
   // SetupOutputInformation to outInfo
   void CopyOutputInformation(vtkInformation* outInfo, int port) override;
 
+  //@{
+  /**
+   * Set the number of threads reading the pieces concurrently. The pieces
+   * are still appended to the output in the order of the file. The default
+   * is 1, which reads the pieces one after another, and 0 uses
+   * vtkMultiThreader::GetGlobalDefaultNumberOfThreads().
+   */
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfThreads, int);
+  //@}
+
 protected:
   vtkXMLPUnstructuredDataReader();
   ~vtkXMLPUnstructuredDataReader() override;
@@ -73,6 +84,10 @@ protected:
   void SetupUpdateExtent(int piece, int numberOfPieces, int ghostLevel);
 
   int ReadPieceData() override;
+
+  // Update the readers of the pieces to read concurrently, before their
+  // data is copied to the output.
+  void UpdatePieceReaders();
   void CopyCellArray(vtkIdType totalNumberOfCells, vtkCellArray* inCells, vtkCellArray* outCells);
 
   // Get the number of points/cells in the given piece.  Valid after
@@ -95,6 +110,8 @@ protected:
   // The PPoints element with point information.
   vtkXMLDataElement* PPointsElement;
 
+  int NumberOfThreads;
+
 private:
   vtkXMLPUnstructuredDataReader(const vtkXMLPUnstructuredDataReader&) = delete;
   void operator=(const vtkXMLPUnstructuredDataReader&) = delete;
@@ -127,7 +127,7 @@ void vtkXMLPartitionedDataSetCollectionReader::ReadComposite(vtkXMLDataElement*
       if (this->ShouldReadDataSet(dataSetIndex, index, numberOfParitions))
       {
         // Read
-        childDS.TakeReference(this->ReadDataObject(childXML, filePath));
+        childDS.TakeReference(this->ReadChildDataObject(childXML, filePath, ds, index));
       }
       // insert
       ds->SetPartition(index, childDS);
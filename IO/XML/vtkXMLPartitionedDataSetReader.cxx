@@ -84,7 +84,7 @@ void vtkXMLPartitionedDataSetReader::ReadComposite(vtkXMLDataElement* element,
       if (this->ShouldReadDataSet(dataSetIndex, index, numberOfParitions))
       {
         // Read
-        childDS.TakeReference(this->ReadDataObject(childXML, filePath));
+        childDS.TakeReference(this->ReadChildDataObject(childXML, filePath, pds, index));
       }
       pds->SetPartition(index, childDS);
       dataSetIndex++;
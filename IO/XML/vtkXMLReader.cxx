@@ -21,6 +21,7 @@
 #include "vtkDataCompressor.h"
 #include "vtkDataSet.h"
 #include "vtkDataSetAttributes.h"
+#include "vtkFeatures.h"
 #include "vtkInformation.h"
 #include "vtkInformationDoubleKey.h"
 #include "vtkInformationDoubleVectorKey.h"
@@ -43,7 +44,11 @@
 #include "vtkXMLDataParser.h"
 #include "vtkXMLFileReadTester.h"
 #include "vtkXMLReaderVersion.h"
+#include "vtkZFPDataCompressor.h"
 #include "vtkZLibDataCompressor.h"
+#ifdef VTK_USE_ZSTD
+#include "vtkZstdDataCompressor.h"
+#endif
 
 #include "vtksys/Encoding.hxx"
 #include "vtksys/FStream.hxx"
@@ -54,10 +59,21 @@
 #include <cctype>
 #include <functional>
 #include <locale> // C++ locale
+#include <map>
+#include <mutex>
 #include <numeric>
 #include <sstream>
 #include <vector>
 
+#if defined(_WIN32) && !defined(__CYGWIN__)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h> /* CreateFileMapping */
+#else
+#include <fcntl.h>    /* open */
+#include <sys/mman.h> /* mmap */
+#include <unistd.h>   /* close */
+#endif
+
 vtkCxxSetObjectMacro(vtkXMLReader, ReaderErrorObserver, vtkCommand);
 vtkCxxSetObjectMacro(vtkXMLReader, ParserErrorObserver, vtkCommand);
 
@@ -139,6 +155,7 @@ vtkXMLReader::vtkXMLReader()
   this->StringStream = nullptr;
   this->ReadFromInputString = 0;
   this->InputString = "";
+  this->MapAppendedData = false;
   this->XMLParser = nullptr;
   this->ReaderErrorObserver = nullptr;
   this->ParserErrorObserver = nullptr;
@@ -226,6 +243,7 @@ void vtkXMLReader::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "PointDataArraySelection: " << this->PointDataArraySelection << "\n";
   os << indent << "ColumnArraySelection: " << this->PointDataArraySelection << "\n";
   os << indent << "TimeDataStringArray: " << this->TimeDataStringArray << "\n";
+  os << indent << "MapAppendedData: " << (this->MapAppendedData ? "On" : "Off") << "\n";
   if (this->Stream)
   {
     os << indent << "Stream: " << this->Stream << "\n";
@@ -459,6 +477,16 @@ void vtkXMLReader::SetupCompressor(const char* type)
     {
       compressor = vtkLZMADataCompressor::New();
     }
+    else if (strcmp(type, "vtkZFPDataCompressor") == 0)
+    {
+      compressor = vtkZFPDataCompressor::New();
+    }
+#ifdef VTK_USE_ZSTD
+    else if (strcmp(type, "vtkZstdDataCompressor") == 0)
+    {
+      compressor = vtkZstdDataCompressor::New();
+    }
+#endif
   }
 
   if (!compressor)
@@ -857,6 +885,149 @@ int vtkXMLDataReaderReadArrayValues(vtkXMLDataElement* da, vtkXMLDataParser* xml
 
 }
 
+//------------------------------------------------------------------------------
+namespace
+{
+// A memory mapped region of a file.
+struct MappedRegion
+{
+  void* Start;
+  size_t Length;
+};
+
+// The regions mapped for the arrays, by array pointer, so that they can be
+// unmapped when the arrays release them. They are never destroyed, since
+// arrays may be released during the static destruction.
+std::mutex& GetMappedRegionsMutex()
+{
+  static std::mutex* mutex = new std::mutex;
+  return *mutex;
+}
+
+std::map<void*, MappedRegion>& GetMappedRegions()
+{
+  static std::map<void*, MappedRegion>* regions = new std::map<void*, MappedRegion>;
+  return *regions;
+}
+
+// Free function of the arrays referencing a mapped region.
+void UnmapArrayValues(void* values)
+{
+  std::lock_guard<std::mutex> lock(GetMappedRegionsMutex());
+  std::map<void*, MappedRegion>& regions = GetMappedRegions();
+  auto it = regions.find(values);
+  if (it == regions.end())
+  {
+    return;
+  }
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  UnmapViewOfFile(it->second.Start);
+#else
+  munmap(it->second.Start, it->second.Length);
+#endif
+  regions.erase(it);
+}
+
+// Map the given region of a file privately (copy on write), and return
+// the address of its first byte, or nullptr.
+void* MapFileRegion(const char* fileName, vtkTypeInt64 position, size_t length)
+{
+  void* start = nullptr;
+  vtkTypeInt64 mapPosition;
+  size_t mapLength;
+#if defined(_WIN32) && !defined(__CYGWIN__)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  mapPosition = position - position % info.dwAllocationGranularity;
+  mapLength = static_cast<size_t>(position - mapPosition) + length;
+  HANDLE file = CreateFileW(vtksys::Encoding::ToWindowsExtendedPath(fileName).c_str(),
+    GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return nullptr;
+  }
+  HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  if (mapping)
+  {
+    start = MapViewOfFile(mapping, FILE_MAP_COPY, static_cast<DWORD>(mapPosition >> 32),
+      static_cast<DWORD>(mapPosition & 0xffffffff), mapLength);
+    CloseHandle(mapping);
+  }
+  CloseHandle(file);
+#else
+  vtkTypeInt64 pageSize = static_cast<vtkTypeInt64>(sysconf(_SC_PAGESIZE));
+  mapPosition = position - position % pageSize;
+  mapLength = static_cast<size_t>(position - mapPosition) + length;
+  int fd = open(fileName, O_RDONLY);
+  if (fd < 0)
+  {
+    return nullptr;
+  }
+  start = mmap(nullptr, mapLength, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd,
+    static_cast<off_t>(mapPosition));
+  close(fd);
+  if (start == MAP_FAILED)
+  {
+    start = nullptr;
+  }
+#endif
+  if (!start)
+  {
+    return nullptr;
+  }
+
+  void* values = static_cast<char*>(start) + (position - mapPosition);
+  std::lock_guard<std::mutex> lock(GetMappedRegionsMutex());
+  GetMappedRegions()[values] = MappedRegion{ start, mapLength };
+  return values;
+}
+}
+
+//------------------------------------------------------------------------------
+bool vtkXMLReader::IsArrayMapped(vtkAbstractArray* array)
+{
+  if (!array || array->GetNumberOfValues() == 0)
+  {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(GetMappedRegionsMutex());
+  std::map<void*, MappedRegion>& regions = GetMappedRegions();
+  return regions.find(array->GetVoidPointer(0)) != regions.end();
+}
+
+//------------------------------------------------------------------------------
+int vtkXMLReader::MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array)
+{
+  // Only arrays stored contiguously in memory, in a file, can be mapped.
+  vtkDataArray* dataArray = vtkArrayDownCast<vtkDataArray>(array);
+  if (!this->MapAppendedData || !dataArray || !dataArray->HasStandardMemoryLayout() ||
+    dataArray->GetDataType() == VTK_BIT || !this->FileName || this->Stream != this->FileStream ||
+    !da->GetAttribute("offset"))
+  {
+    return 0;
+  }
+
+  vtkTypeInt64 offset = 0;
+  da->GetScalarAttribute("offset", offset);
+  vtkIdType numValues = dataArray->GetNumberOfValues();
+  size_t wordSize = static_cast<size_t>(dataArray->GetDataTypeSize());
+  vtkTypeInt64 position = this->XMLParser->FindRawAppendedDataPosition(
+    offset, static_cast<size_t>(numValues), dataArray->GetDataType());
+  if (numValues == 0 || position < 0 || position % static_cast<vtkTypeInt64>(wordSize) != 0)
+  {
+    return 0;
+  }
+
+  void* values = MapFileRegion(this->FileName, position, numValues * wordSize);
+  if (!values)
+  {
+    return 0;
+  }
+  dataArray->SetVoidArray(values, numValues, 0, vtkAbstractArray::VTK_DATA_ARRAY_USER_DEFINED);
+  dataArray->SetArrayFreeFunction(UnmapArrayValues);
+  return 1;
+}
+
 //------------------------------------------------------------------------------
 int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
   vtkAbstractArray* array, vtkIdType startIndex, vtkIdType numValues, FieldType fieldType)
@@ -875,12 +1046,21 @@ int vtkXMLReader::ReadArrayValues(vtkXMLDataElement* da, vtkIdType arrayIndex,
                                << arrayIndex + numValues << " were requested to be read");
     return 0;
   }
-  switch (array->GetDataType())
+  if (arrayIndex == 0 && startIndex == 0 && numValues == array->GetNumberOfValues() &&
+    this->MapArrayValues(da, array))
   {
-    vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
-                                    arrayIndex, static_cast<VTK_TT*>(iter), startIndex, numValues));
-    default:
-      result = 0;
+    result = 1;
+  }
+  else
+  {
+    switch (array->GetDataType())
+    {
+      vtkArrayIteratorTemplateMacro(result = vtkXMLDataReaderReadArrayValues(da, this->XMLParser,
+                                      arrayIndex, static_cast<VTK_TT*>(iter), startIndex,
+                                      numValues));
+      default:
+        result = 0;
+    }
   }
   if (iter)
   {
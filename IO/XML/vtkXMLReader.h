@@ -84,6 +84,35 @@ public:
    */
   virtual int CanReadFile(const char* name);
 
+  //@{
+  /**
+   * Whether to memory map the file rather than read arrays stored as raw
+   * (not encoded, not compressed) appended data, in the native byte order.
+   * The arrays then reference the mapped file directly, which makes loading
+   * large files almost instantaneous, and shares their memory between the
+   * processes reading the same file. The mapping is private: the pages
+   * modified by a filter are copied, and the file is never changed. This
+   * is done only for arrays read completely (e.g. not for a sub-extent)
+   * from a file, whose values start at a multiple of their size in the
+   * file (see vtkXMLWriter::AlignAppendedData). Other arrays are read as
+   * usual. The default is off.
+   *
+   * The file must not be truncated or overwritten in place while the arrays
+   * read from it are in use (e.g. by writing again to the same file name
+   * without first deleting the file): accessing their values may then crash
+   * the process with SIGBUS, or silently return the new contents of the file.
+   */
+  vtkSetMacro(MapAppendedData, bool);
+  vtkGetMacro(MapAppendedData, bool);
+  vtkBooleanMacro(MapAppendedData, bool);
+  //@}
+
+  /**
+   * Return true if the values of the given array are memory mapped from a
+   * file by a reader (see MapAppendedData), false if they are in memory.
+   */
+  static bool IsArrayMapped(vtkAbstractArray* array);
+
   //@{
   /**
    * Get the output as a vtkDataSet pointer.
@@ -347,6 +376,15 @@ protected:
   // The input string.
   std::string InputString;
 
+  // Whether to memory map raw appended data.
+  bool MapAppendedData;
+
+  // Make the array reference the memory mapped values of the given data
+  // element, if possible.  Returns 1 for success, 0 if the array must be
+  // read instead.  The mapping lives as long as the array, which reads the
+  // file directly: see SetMapAppendedData for the files changed meanwhile.
+  int MapArrayValues(vtkXMLDataElement* da, vtkAbstractArray* array);
+
   // The array selections.
   vtkDataArraySelection* PointDataArraySelection;
   vtkDataArraySelection* CellDataArraySelection;
@@ -27,6 +27,7 @@
 #include "vtkDoubleArray.h"
 #include "vtkEndian.h"
 #include "vtkErrorCode.h"
+#include "vtkFeatures.h"
 #include "vtkInformation.h"
 #include "vtkInformationDoubleKey.h"
 #include "vtkInformationDoubleVectorKey.h"
@@ -45,10 +46,15 @@
 #include "vtkOutputStream.h"
 #include "vtkPointData.h"
 #include "vtkPoints.h"
+#include "vtkSMPTools.h"
 #include "vtkStdString.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkUnsignedCharArray.h"
+#include "vtkZFPDataCompressor.h"
 #include "vtkZLibDataCompressor.h"
+#ifdef VTK_USE_ZSTD
+#include "vtkZstdDataCompressor.h"
+#endif
 #define vtkXMLOffsetsManager_DoNotInclude
 #include "vtkXMLOffsetsManager.h"
 #undef vtkXMLOffsetsManager_DoNotInclude
@@ -65,6 +71,7 @@
 #include "vtksys/FStream.hxx"
 #include <memory>
 
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 #include <string>
@@ -470,13 +477,15 @@ vtkXMLWriter::vtkXMLWriter()
 #endif
 
   // Initialize compression data.
-  this->BlockSize = 32768; // 2^15
+  this->BlockSize = 32768;               // 2^15
+  this->CompressionBatchSize = 16777216; // 2^24
   this->Compressor = vtkZLibDataCompressor::New();
   this->CompressionHeader = nullptr;
   this->Int32IdTypeBuffer = nullptr;
   this->ByteSwapBuffer = nullptr;
 
   this->EncodeAppendedData = 1;
+  this->AlignAppendedData = false;
   this->AppendedDataPosition = 0;
   this->DataMode = vtkXMLWriter::Appended;
   this->ProgressRange[0] = 0;
@@ -553,6 +562,30 @@ void vtkXMLWriter::SetCompressorType(int compressorType)
     this->Compressor->SetCompressionLevel(this->CompressionLevel);
     this->Modified();
   }
+  else if (compressorType == ZFP)
+  {
+    if (this->Compressor && !this->Compressor->IsTypeOf("vtkZFPDataCompressor"))
+    {
+      this->Compressor->Delete();
+    }
+    this->Compressor = vtkZFPDataCompressor::New();
+    this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    this->Modified();
+  }
+  else if (compressorType == ZSTD)
+  {
+#ifdef VTK_USE_ZSTD
+    if (this->Compressor && !this->Compressor->IsTypeOf("vtkZstdDataCompressor"))
+    {
+      this->Compressor->Delete();
+    }
+    this->Compressor = vtkZstdDataCompressor::New();
+    this->Compressor->SetCompressionLevel(this->CompressionLevel);
+    this->Modified();
+#else
+    vtkErrorMacro("VTK was built without zstd, set VTK_USE_ZSTD to use the ZSTD compressor.");
+#endif
+  }
   else
   {
     vtkWarningMacro("Invalid compressorType:" << compressorType);
@@ -619,6 +652,7 @@ void vtkXMLWriter::PrintSelf(ostream& os, vtkIndent indent)
     os << indent << "Compressor: (none)\n";
   }
   os << indent << "EncodeAppendedData: " << this->EncodeAppendedData << "\n";
+  os << indent << "AlignAppendedData: " << (this->AlignAppendedData ? "On" : "Off") << "\n";
   os << indent << "BlockSize: " << this->BlockSize << "\n";
   if (this->Stream)
   {
@@ -1295,6 +1329,18 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
 
   if (this->Compressor)
   {
+    // A floating-point compressor needs the type of the values, which
+    // it can only use if they are not byte swapped.
+    if (vtkZFPDataCompressor* zfp = vtkZFPDataCompressor::SafeDownCast(this->Compressor))
+    {
+#ifdef VTK_WORDS_BIGENDIAN
+      bool swap = (this->ByteOrder != vtkXMLWriter::BigEndian);
+#else
+      bool swap = (this->ByteOrder != vtkXMLWriter::LittleEndian);
+#endif
+      zfp->SetDataType(swap ? VTK_VOID : wordType);
+    }
+
     // Need to compress the data.  Create compression header.  This
     // reserves enough space in the output.
     if (!this->CreateCompressionHeader(dataSize))
@@ -1310,6 +1356,14 @@ int vtkXMLWriter::WriteBinaryData(vtkAbstractArray* a)
       result = 0;
     }
 
+    // Compress and write the blocks which are still pending.
+    if (result && !this->FlushCompressionBlocks())
+    {
+      result = 0;
+    }
+    this->PendingBlocks.clear();
+    this->PendingBlockSizes.clear();
+
     // Finish writing the data.
     if (result && !this->DataStream->EndWriting())
     {
@@ -1672,25 +1726,83 @@ int vtkXMLWriter::CreateCompressionHeader(size_t size)
 //------------------------------------------------------------------------------
 int vtkXMLWriter::WriteCompressionBlock(unsigned char* data, size_t size)
 {
-  // Compress the data.
-  vtkUnsignedCharArray* outputArray = this->Compressor->Compress(data, size);
+  // The blocks are independent, so they are queued and compressed in
+  // parallel. The number of queued blocks is bounded to limit the memory
+  // used by the copies of the blocks and by their compressed versions.
+  this->PendingBlocks.insert(this->PendingBlocks.end(), data, data + size);
+  this->PendingBlockSizes.push_back(size);
+
+  size_t maxPendingBlocks =
+    std::max(this->CompressionBatchSize / this->BlockSize, static_cast<size_t>(1));
+  if (this->PendingBlockSizes.size() < maxPendingBlocks)
+  {
+    return 1;
+  }
+  return this->FlushCompressionBlocks();
+}
+
+//------------------------------------------------------------------------------
+int vtkXMLWriter::FlushCompressionBlocks()
+{
+  size_t numBlocks = this->PendingBlockSizes.size();
+  if (numBlocks == 0)
+  {
+    return 1;
+  }
+
+  // Compress the data. The compressors only read their settings, so the
+  // blocks can be compressed concurrently.
+  std::vector<size_t> offsets(numBlocks, 0);
+  for (size_t i = 1; i < numBlocks; ++i)
+  {
+    offsets[i] = offsets[i - 1] + this->PendingBlockSizes[i - 1];
+  }
+  std::vector<vtkUnsignedCharArray*> outputArrays(numBlocks, nullptr);
+  vtkDataCompressor* compressor = this->Compressor;
+  unsigned char* blocks = this->PendingBlocks.data();
+  const size_t* sizes = this->PendingBlockSizes.data();
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numBlocks),
+    [compressor, blocks, sizes, &offsets, &outputArrays](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        outputArrays[i] = compressor->Compress(blocks + offsets[i], sizes[i]);
+      }
+    });
+
+  // Write the compressed data in order.
+  int result = 1;
+  for (size_t i = 0; i < numBlocks; ++i)
+  {
+    vtkUnsignedCharArray* outputArray = outputArrays[i];
+    if (!outputArray)
+    {
+      result = 0;
+      continue;
+    }
+
+    // Find the compressed size.
+    size_t outputSize = outputArray->GetNumberOfTuples();
+    unsigned char* outputPointer = outputArray->GetPointer(0);
+
+    // Write the compressed data.
+    if (result && !this->DataStream->Write(outputPointer, outputSize))
+    {
+      result = 0;
+    }
 
-  // Find the compressed size.
-  size_t outputSize = outputArray->GetNumberOfTuples();
-  unsigned char* outputPointer = outputArray->GetPointer(0);
+    // Store the resulting compressed size in the compression header.
+    this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
 
-  // Write the compressed data.
-  int result = this->DataStream->Write(outputPointer, outputSize);
+    outputArray->Delete();
+  }
   this->Stream->flush();
   if (this->Stream->fail())
   {
     this->SetErrorCode(vtkErrorCode::GetLastSystemError());
   }
 
-  // Store the resulting compressed size in the compression header.
-  this->CompressionHeader->Set(3 + this->CompressionBlockNumber++, outputSize);
-
-  outputArray->Delete();
+  this->PendingBlocks.clear();
+  this->PendingBlockSizes.clear();
 
   return result;
 }
@@ -2332,6 +2444,24 @@ void vtkXMLWriter::WriteArrayAppended(vtkAbstractArray* a, vtkIndent indent, Off
 void vtkXMLWriter::WriteArrayAppendedData(
   vtkAbstractArray* a, vtkTypeInt64 pos, vtkTypeInt64& lastoffset)
 {
+  // Pad the raw data so that the values start at a multiple of their size
+  // in the file.  The readers find the data from their offset, so they
+  // skip the padding.
+  if (this->AlignAppendedData && !this->EncodeAppendedData && !this->Compressor &&
+    a->GetDataType() != VTK_BIT && a->GetDataType() != VTK_STRING)
+  {
+    ostream& os = *(this->Stream);
+    vtkTypeInt64 headerSize = (this->HeaderType == vtkXMLWriter::UInt64 ? 8 : 4);
+    vtkTypeInt64 wordSize =
+      static_cast<vtkTypeInt64>(this->GetOutputWordTypeSize(a->GetDataType()));
+    vtkTypeInt64 padding =
+      (wordSize - (static_cast<vtkTypeInt64>(os.tellp()) + headerSize) % wordSize) % wordSize;
+    for (vtkTypeInt64 i = 0; i < padding; ++i)
+    {
+      os.put('\0');
+    }
+  }
+
   this->WriteAppendedDataOffset(pos, lastoffset, "offset");
   this->WriteBinaryData(a);
 }
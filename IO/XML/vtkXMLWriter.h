@@ -34,6 +34,7 @@
 #include "vtkIOXMLModule.h" // For export macro
 
 #include <sstream> // For ostringstream ivar
+#include <vector>  // For std::vector ivar
 
 class vtkAbstractArray;
 class vtkArrayIterator;
@@ -163,6 +164,8 @@ public:
   /**
    * Get/Set the compressor used to compress binary and appended data
    * before writing to the file.  Default is a vtkZLibDataCompressor.
+   * A vtkZFPDataCompressor is told the type of each array before it is
+   * compressed, when the data are written in the native byte order.
    */
   virtual void SetCompressor(vtkDataCompressor*);
   vtkGetObjectMacro(Compressor, vtkDataCompressor);
@@ -173,18 +176,23 @@ public:
     NONE,
     ZLIB,
     LZ4,
-    LZMA
+    LZMA,
+    ZFP,
+    ZSTD
   };
 
   //@{
   /**
    * Convenience functions to set the compressor to certain known types.
+   * ZSTD is only available when VTK is built with VTK_USE_ZSTD.
    */
   void SetCompressorType(int compressorType);
   void SetCompressorTypeToNone() { this->SetCompressorType(NONE); }
   void SetCompressorTypeToLZ4() { this->SetCompressorType(LZ4); }
   void SetCompressorTypeToZLib() { this->SetCompressorType(ZLIB); }
   void SetCompressorTypeToLZMA() { this->SetCompressorType(LZMA); }
+  void SetCompressorTypeToZFP() { this->SetCompressorType(ZFP); }
+  void SetCompressorTypeToZstd() { this->SetCompressorType(ZSTD); }
 
   void SetCompressionLevel(int compressorLevel);
   vtkGetMacro(CompressionLevel, int);
@@ -227,6 +235,19 @@ public:
   vtkBooleanMacro(EncodeAppendedData, vtkTypeBool);
   //@}
 
+  //@{
+  /**
+   * Whether to pad the raw (not encoded, not compressed) appended data so
+   * that the values of each array start at a multiple of their size in the
+   * file. The files are still read by any reader, and allow
+   * vtkXMLReader::MapAppendedData to memory map all of the arrays. The
+   * default is off.
+   */
+  vtkSetMacro(AlignAppendedData, bool);
+  vtkGetMacro(AlignAppendedData, bool);
+  vtkBooleanMacro(AlignAppendedData, bool);
+  //@}
+
   //@{
   /**
    * Assign a data object as input. Note that this method does not
@@ -308,6 +329,9 @@ protected:
   // Whether to base64-encode the appended data section.
   vtkTypeBool EncodeAppendedData;
 
+  // Whether to align the values in the raw appended data section.
+  bool AlignAppendedData;
+
   // The stream position at which appended data starts.
   vtkTypeInt64 AppendedDataPosition;
 
@@ -339,6 +363,13 @@ protected:
   size_t CompressionBlockNumber;
   vtkXMLDataHeader* CompressionHeader;
   vtkTypeInt64 CompressionHeaderPosition;
+  // Uncompressed blocks waiting to be compressed in parallel, and their sizes.
+  std::vector<unsigned char> PendingBlocks;
+  std::vector<size_t> PendingBlockSizes;
+  // The amount of uncompressed data compressed in parallel before it is
+  // written. With a size smaller than BlockSize, each block is compressed
+  // and written in turn by the calling thread.
+  size_t CompressionBatchSize;
   // Compression Level for vtkDataCompressor objects
   // 1 (worst compression, fastest) ... 9 (best compression, slowest)
   int CompressionLevel = 5;
@@ -462,6 +493,7 @@ protected:
   void PerformByteSwap(void* data, size_t numWords, size_t wordSize);
   int CreateCompressionHeader(size_t size);
   int WriteCompressionBlock(unsigned char* data, size_t size);
+  int FlushCompressionBlocks();
   int WriteCompressionHeader();
   size_t GetWordTypeSize(int dataType);
   const char* GetWordTypeName(int dataType);
@@ -21,6 +21,7 @@
 #include "vtkEndian.h"
 #include "vtkInputStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkXMLDataElement.h"
 #define vtkXMLDataHeaderPrivate_DoNotInclude
 #include "vtkXMLDataHeaderPrivate.h"
@@ -35,6 +36,9 @@
 
 #include "vtkXMLUtilities.h"
 
+// The amount of uncompressed data decompressed in parallel at once.
+#define VTK_XML_DATA_PARSER_DECOMPRESSION_BATCH_SIZE (static_cast<size_t>(1) << 24)
+
 vtkStandardNewMacro(vtkXMLDataParser);
 vtkCxxSetObjectMacro(vtkXMLDataParser, Compressor, vtkDataCompressor);
 
@@ -639,6 +643,46 @@ unsigned char* vtkXMLDataParser::ReadBlock(vtkTypeUInt64 block)
   return decompressBuffer;
 }
 
+//------------------------------------------------------------------------------
+int vtkXMLDataParser::ReadBlocks(
+  vtkTypeUInt64 firstBlock, vtkTypeUInt64 endBlock, unsigned char* buffer, size_t wordSize)
+{
+  // The blocks are stored contiguously, so read them all at once.
+  vtkTypeInt64 startOffset = this->BlockStartOffsets[firstBlock];
+  size_t compressedSize = static_cast<size_t>(this->BlockStartOffsets[endBlock - 1] +
+    this->BlockCompressedSizes[endBlock - 1] - startOffset);
+  if (!this->DataStream->Seek(startOffset))
+  {
+    return 0;
+  }
+  std::vector<unsigned char> readBuffer(compressedSize);
+  if (this->DataStream->Read(readBuffer.data(), compressedSize) < compressedSize)
+  {
+    return 0;
+  }
+
+  // The blocks are independent, so uncompress and byte swap them in
+  // parallel, directly into the output buffer.
+  std::vector<unsigned char> results(endBlock - firstBlock, 0);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(endBlock - firstBlock),
+    [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType i = begin; i < end; ++i)
+      {
+        vtkTypeUInt64 block = firstBlock + i;
+        unsigned char* input = readBuffer.data() + (this->BlockStartOffsets[block] - startOffset);
+        unsigned char* output = buffer + i * this->BlockUncompressedSize;
+        size_t uncompressedSize = this->FindBlockSize(block);
+        results[i] = this->Compressor->Uncompress(
+                       input, this->BlockCompressedSizes[block], output, uncompressedSize) > 0;
+        if (results[i])
+        {
+          this->PerformByteSwap(output, uncompressedSize / wordSize, wordSize);
+        }
+      }
+    });
+  return std::find(results.begin(), results.end(), 0) == results.end();
+}
+
 //------------------------------------------------------------------------------
 size_t vtkXMLDataParser::ReadUncompressedData(
   unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize)
@@ -811,21 +855,23 @@ size_t vtkXMLDataParser::ReadCompressedData(
     // Report progress.
     this->UpdateProgress(float(outputPointer - data) / length);
 
-    unsigned int currentBlock = firstBlock + 1;
-    for (; currentBlock != lastBlock && !this->Abort; ++currentBlock)
+    // Read the complete blocks in batches, which are uncompressed in
+    // parallel.  Note that blockSize will always be an integer multiple of
+    // the word size.
+    vtkTypeUInt64 batchBlocks = std::max(
+      VTK_XML_DATA_PARSER_DECOMPRESSION_BATCH_SIZE / blockSize, static_cast<size_t>(1));
+    vtkTypeUInt64 currentBlock = firstBlock + 1;
+    while (currentBlock < lastBlock && !this->Abort)
     {
-      // Read this block.
-      if (!this->ReadBlock(currentBlock, outputPointer))
+      vtkTypeUInt64 endBlock = std::min(currentBlock + batchBlocks, lastBlock);
+      if (!this->ReadBlocks(currentBlock, endBlock, outputPointer, wordSize))
       {
         return 0;
       }
 
-      // Byte swap this block.  Note that blockSize will always be an
-      // integer multiple of the word size.
-      this->PerformByteSwap(outputPointer, blockSize / wordSize, wordSize);
-
       // Advance the pointer to the beginning of the next block.
-      outputPointer += this->FindBlockSize(currentBlock);
+      outputPointer += (endBlock - currentBlock) * blockSize;
+      currentBlock = endBlock;
 
       // Report progress.
       this->UpdateProgress(float(outputPointer - data) / length);
@@ -973,6 +1019,42 @@ size_t vtkXMLDataParser::ReadAppendedData(
   return this->ReadBinaryData(buffer, startWord, numWords, wordType);
 }
 
+//------------------------------------------------------------------------------
+vtkTypeInt64 vtkXMLDataParser::FindRawAppendedDataPosition(
+  vtkTypeInt64 offset, size_t numWords, int wordType)
+{
+  size_t wordSize = this->GetWordTypeSize(wordType);
+#ifdef VTK_WORDS_BIGENDIAN
+  bool swap = (wordSize > 1 && this->ByteOrder != vtkXMLDataParser::BigEndian);
+#else
+  bool swap = (wordSize > 1 && this->ByteOrder != vtkXMLDataParser::LittleEndian);
+#endif
+  if (this->Compressor || this->AppendedDataStream->IsA("vtkBase64InputStream") || swap ||
+    !this->AppendedDataPosition)
+  {
+    return -1;
+  }
+
+  // Read the length of the data.
+  std::unique_ptr<vtkXMLDataHeader> uh(vtkXMLDataHeader::New(this->HeaderType, 1));
+  size_t const headerSize = uh->DataSize();
+  vtkTypeInt64 position = this->AppendedDataPosition + offset;
+  this->SeekG(position);
+  istream* stream = this->GetStream();
+  stream->read(reinterpret_cast<char*>(uh->Data()), headerSize);
+  if (static_cast<size_t>(stream->gcount()) < headerSize)
+  {
+    stream->clear();
+    return -1;
+  }
+  this->PerformByteSwap(uh->Data(), uh->WordCount(), uh->WordSize());
+  if (uh->Get(0) < static_cast<vtkTypeUInt64>(numWords) * wordSize)
+  {
+    return -1;
+  }
+  return position + static_cast<vtkTypeInt64>(headerSize);
+}
+
 //------------------------------------------------------------------------------
 //------------------------------------------------------------------------------
 // Define a parsing function template.  The extra "long" argument is used
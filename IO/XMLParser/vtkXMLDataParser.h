@@ -81,6 +81,16 @@ public:
     return this->ReadAppendedData(offset, buffer, startWord, numWords, VTK_CHAR);
   }
 
+  /**
+   * Find the position in the stream of the values of the appended data
+   * starting at the given appended data offset, so that they can be used in
+   * place (e.g. memory mapped) instead of being read.  This is possible only
+   * if the appended data are raw (neither encoded nor compressed), in the
+   * native byte order, and hold at least numWords words.  Returns -1
+   * otherwise.
+   */
+  vtkTypeInt64 FindRawAppendedDataPosition(vtkTypeInt64 offset, size_t numWords, int wordType);
+
   /**
    * Read from an ascii data section starting at the current position in
    * the stream.  Returns the number of words read.
@@ -186,6 +196,8 @@ protected:
   size_t FindBlockSize(vtkTypeUInt64 block);
   int ReadBlock(vtkTypeUInt64 block, unsigned char* buffer);
   unsigned char* ReadBlock(vtkTypeUInt64 block);
+  int ReadBlocks(
+    vtkTypeUInt64 firstBlock, vtkTypeUInt64 endBlock, unsigned char* buffer, size_t wordSize);
   size_t ReadUncompressedData(
     unsigned char* data, vtkTypeUInt64 startWord, size_t numWords, size_t wordSize);
   size_t ReadCompressedData(